@@ -0,0 +1,4 @@
+--
+DELETE FROM `command` WHERE `name` = 'server savestats';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server savestats', 3, 'Syntax: .server savestats\r\n\r\nShow how many times every section of character save wrote changes or was skipped as unchanged, and number of database statements it appended.');
@@ -286,6 +286,6 @@ public:
 // Group all custom scripts
 void AddSC_AntiAD()
 {
-    new AntiAD_Player();
+    RegisterHookedScript<AntiAD_Player>();
     new AntiAD_World();
 }
\ No newline at end of file
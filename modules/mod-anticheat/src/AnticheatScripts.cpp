@@ -68,6 +68,6 @@ public:
 void AddSC_Anticheat()
 {
     new AnticheatWorldScript();
-    new AnticheatPlayerScript();
+    RegisterHookedScript<AnticheatPlayerScript>();
     new AnticheatMovementHandlerScript();
 }
@@ -100,6 +100,6 @@ void AddSC_Arena1v1()
 {
     new Arena1v1_ArenaTeam();
     new Arena1v1_Creature();
-    new Arena1v1_Player();
+    RegisterHookedScript<Arena1v1_Player>();
     new Arena1v1_World();
 }
@@ -88,5 +88,5 @@ private:
 // Group all custom scripts
 void AddSC_BossAnnouncer()
 {
-    new Boss_Announcer_Player();
+    RegisterHookedScript<Boss_Announcer_Player>();
 }
\ No newline at end of file
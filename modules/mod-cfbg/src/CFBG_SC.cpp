@@ -209,6 +209,6 @@ public:
 void AddSC_CFBG()
 {
     new CFBG_BG();
-    new CFBG_Player();
+    RegisterHookedScript<CFBG_Player>();
     new CFBG_World();
 }
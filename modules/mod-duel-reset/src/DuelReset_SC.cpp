@@ -90,5 +90,5 @@ public:
 // Group all custom scripts
 void AddSC_DuelReset()
 {
-    new DuelReset_Player();
+    RegisterHookedScript<DuelReset_Player>();
 }
\ No newline at end of file
@@ -54,5 +54,5 @@ public:
 // Group all custom scripts
 void AddSC_FactionsIconsChannel()
 {
-    new FactionsIconsChannel_Player();
+    RegisterHookedScript<FactionsIconsChannel_Player>();
 }
\ No newline at end of file
@@ -74,5 +74,5 @@ private:
 // Group all custom scripts
 void AddSC_GMChatColor()
 {
-    new GMChatColor_Player();
+    RegisterHookedScript<GMChatColor_Player>();
 }
\ No newline at end of file
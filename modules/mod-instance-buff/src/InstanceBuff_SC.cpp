@@ -373,6 +373,6 @@ public:
 void AddSC_InstanceBuff()
 {
     new InstanceBuff_World();
-    new InstanceBuff_Player();
+    RegisterHookedScript<InstanceBuff_Player>();
     new InstanceBuff_Pet();
 }
\ No newline at end of file
@@ -40,5 +40,5 @@ public:
 // Group all custom scripts
 void AddSC_NewPlayerAnnounce()
 {
-    new NewPlayerAnnounce_Player();
+    RegisterHookedScript<NewPlayerAnnounce_Player>();
 }
@@ -45,5 +45,5 @@ public:
 // Group all custom scripts
 void AddSC_NotifyMuted()
 {
-    new NotifyMuted_Player();
+    RegisterHookedScript<NotifyMuted_Player>();
 }
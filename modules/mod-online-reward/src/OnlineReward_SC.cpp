@@ -174,6 +174,6 @@ public:
 void AddSC_OnlineReward()
 {
     new OnlineReward_CS();
-    new OnlineReward_Player();
+    RegisterHookedScript<OnlineReward_Player>();
     new OnlineReward_World();
 }
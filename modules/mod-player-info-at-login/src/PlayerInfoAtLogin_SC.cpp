@@ -63,5 +63,5 @@ public:
 // Group all custom scripts
 void AddSC_PlayerInfoAtLogin()
 {
-    new PlayerInfoAtLogin_Player();
+    RegisterHookedScript<PlayerInfoAtLogin_Player>();
 }
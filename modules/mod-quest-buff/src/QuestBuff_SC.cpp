@@ -48,6 +48,6 @@ public:
 // Group all custom scripts
 void AddSC_QuestBuff()
 {
-    new QuestBuff_Player();
+    RegisterHookedScript<QuestBuff_Player>();
     new QuestBuff_World();
 }
\ No newline at end of file
@@ -140,6 +140,6 @@ void AddSC_QuestConditions()
 {
     new QuestConditions_CS();
     new QuestConditions_BG();
-    new QuestConditions_Player();
+    RegisterHookedScript<QuestConditions_Player>();
     new QuestConditions_World();
 }
@@ -86,6 +86,6 @@ public:
 // Group all custom scripts
 void AddSC_StatControl()
 {
-    new StatControl_Player();
+    RegisterHookedScript<StatControl_Player>();
     new StatControl_World();
 }
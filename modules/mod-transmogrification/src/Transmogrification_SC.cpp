@@ -109,6 +109,6 @@ void AddSC_Transmogrification()
 {
     new Transmogrification_Global();
     new Transmogrification_NPC();
-    new Transmogrification_Player();
+    RegisterHookedScript<Transmogrification_Player>();
     new Transmogrification_World();
 }
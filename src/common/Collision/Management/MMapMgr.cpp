@@ -341,4 +341,38 @@ namespace MMAP
 
         return mmap->navMeshQueries[instanceId];
     }
+
+    dtNavMeshQuery const* MMapMgr::GetThreadNavMeshQuery(uint32 mapId)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+        {
+            return nullptr;
+        }
+
+        MMapData* mmap = itr->second;
+        std::thread::id threadId = std::this_thread::get_id();
+
+        std::lock_guard<std::mutex> guard(mmap->threadNavMeshQueriesLock);
+
+        auto queryItr = mmap->threadNavMeshQueries.find(threadId);
+        if (queryItr != mmap->threadNavMeshQueries.end())
+        {
+            return queryItr->second;
+        }
+
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+
+        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            LOG_ERROR("maps", "MMAP:GetThreadNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId {:03}", mapId);
+            return nullptr;
+        }
+
+        LOG_DEBUG("maps", "MMAP:GetThreadNavMeshQuery: created dtNavMeshQuery for mapId {:03}", mapId);
+        mmap->threadNavMeshQueries.emplace(threadId, query);
+        return query;
+    }
 }
@@ -22,6 +22,8 @@
 #include "DetourAlloc.h"
 #include "DetourExtended.h"
 #include "DetourNavMesh.h"
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -41,6 +43,7 @@ namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
     typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> ThreadNavMeshQuerySet;
 
     // dummy struct to hold map's mmap data
     struct MMapData
@@ -54,6 +57,9 @@ namespace MMAP
                 dtFreeNavMeshQuery(navMeshQuerie.second);
             }
 
+            for (auto& [threadId, query] : threadNavMeshQueries)
+                dtFreeNavMeshQuery(query);
+
             if (navMesh)
             {
                 dtFreeNavMesh(navMesh);
@@ -62,6 +68,8 @@ namespace MMAP
 
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries; // instanceId to query
+        ThreadNavMeshQuerySet threadNavMeshQueries; // queries of threads calculating paths of several instances or regions at once
+        std::mutex threadNavMeshQueriesLock;
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs; // maps [map grid coords] to [dtTile]
     };
@@ -84,6 +92,9 @@ namespace MMAP
 
         // the returned [dtNavMeshQuery const*] is NOT threadsafe
         dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+
+        // query owned by calling thread, safe to use for any instance of the map while it's only used from this thread
+        dtNavMeshQuery const* GetThreadNavMeshQuery(uint32 mapId);
         dtNavMesh const* GetNavMesh(uint32 mapId);
 
         [[nodiscard]] uint32 getLoadedTilesCount() const { return loadedTiles; }
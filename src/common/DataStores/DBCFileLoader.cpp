@@ -19,17 +19,22 @@
 // PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 
 #include "DBCFileLoader.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <cstdio>
 #include <cstring>
 
 DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(nullptr), data(nullptr), stringTable(nullptr) { }
 
-bool DBCFileLoader::Load(char const* filename, char const* fmt)
+bool DBCFileLoader::Load(char const* filename, char const* fmt, bool memoryMapped /*= false*/)
 {
     uint32 header;
     if (data)
     {
-        delete [] data;
+        if (!region)
+            delete [] data;
+
+        region.reset();
         data = nullptr;
     }
 
@@ -101,10 +106,39 @@ bool DBCFileLoader::Load(char const* filename, char const* fmt)
         }
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    std::size_t const headerSize = 5 * sizeof(uint32);
+    std::size_t const dataSize = std::size_t(recordSize) * recordCount + stringSize;
+
+    if (memoryMapped)
+    {
+        fseek(f, 0, SEEK_END);
+        long fileSize = ftell(f);
+        fclose(f);
+
+        // Pages behind end of file can't be read
+        if (fileSize < 0 || std::size_t(fileSize) < headerSize + dataSize)
+            return false;
+
+        try
+        {
+            // Corrections of records after load are written to private copies of changed pages only
+            boost::interprocess::file_mapping mapping(filename, boost::interprocess::read_only);
+            region = std::make_unique<boost::interprocess::mapped_region>(mapping, boost::interprocess::copy_on_write, 0, headerSize + dataSize);
+        }
+        catch (boost::interprocess::interprocess_exception const&)
+        {
+            return false;
+        }
+
+        data = static_cast<unsigned char*>(region->get_address()) + headerSize;
+        stringTable = data + recordSize * recordCount;
+        return true;
+    }
+
+    data = new unsigned char[dataSize];
     stringTable = data + recordSize * recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
+    if (fread(data, dataSize, 1, f) != 1)
     {
         fclose(f);
         return false;
@@ -117,7 +151,8 @@ bool DBCFileLoader::Load(char const* filename, char const* fmt)
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
+    if (!region)
+        delete[] data;
 
     delete[] fieldsOffset;
 }
@@ -176,6 +211,82 @@ uint32 DBCFileLoader::GetFormatRecordSize(char const* format, int32* index_pos)
     return recordsize;
 }
 
+bool DBCFileLoader::CanUseRecordsInPlace(char const* format) const
+{
+#if WARHEAD_ENDIAN == WARHEAD_BIGENDIAN
+    return false;
+#else
+    // Records must stay in mapped file, heap copy would be used otherwise
+    if (!region || strlen(format) != fieldCount)
+        return false;
+
+    // Strings are pointers in structures but offsets in file, skipped fields are not in structures
+    for (uint32 x = 0; format[x]; ++x)
+    {
+        switch (format[x])
+        {
+            case FT_FLOAT:
+            case FT_IND:
+            case FT_INT:
+            case FT_BYTE:
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return GetFormatRecordSize(format) == recordSize;
+#endif
+}
+
+void DBCFileLoader::AutoProduceIndex(char const* format, uint32& records, char**& indexTable)
+{
+    ASSERT(CanUseRecordsInPlace(format));
+
+    typedef char* ptr;
+
+    int32 i;
+    GetFormatRecordSize(format, &i);
+
+    if (i >= 0)
+    {
+        uint32 maxi = 0;
+        //find max index
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            uint32 ind = getRecord(y).getUInt(i);
+            if (ind > maxi)
+            {
+                maxi = ind;
+            }
+        }
+
+        ++maxi;
+        records = maxi;
+        indexTable = new ptr[maxi];
+        memset(indexTable, 0, maxi * sizeof(ptr));
+    }
+    else
+    {
+        records = recordCount;
+        indexTable = new ptr[recordCount];
+    }
+
+    for (uint32 y = 0; y < recordCount; ++y)
+    {
+        char* record = reinterpret_cast<char*>(data + y * recordSize);
+
+        if (i >= 0)
+        {
+            indexTable[getRecord(y).getUInt(i)] = record;
+        }
+        else
+        {
+            indexTable[y] = record;
+        }
+    }
+}
+
 char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**& indexTable)
 {
     /*
@@ -283,8 +394,15 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
         return nullptr;
     }
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    // Mapped string table is used in place, file must be kept loaded then
+    char* stringPool = nullptr;
+    char* strings = reinterpret_cast<char*>(stringTable);
+    if (!region)
+    {
+        stringPool = new char[stringSize];
+        memcpy(stringPool, stringTable, stringSize);
+        strings = stringPool;
+    }
 
     uint32 offset = 0;
 
@@ -311,7 +429,7 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
                     if (!*slot || !** slot)
                     {
                         const char* st = getRecord(y).getString(x);
-                        *slot = stringPool + (st - (char const*)stringTable);
+                        *slot = strings + (st - (char const*)stringTable);
                     }
                     offset += sizeof(char*);
                     break;
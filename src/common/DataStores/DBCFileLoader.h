@@ -20,6 +20,12 @@
 
 #include "ByteConverter.h"
 #include "Errors.h"
+#include <memory>
+
+namespace boost::interprocess
+{
+    class mapped_region;
+}
 
 enum DbcFieldFormat
 {
@@ -40,7 +46,8 @@ public:
     DBCFileLoader();
     ~DBCFileLoader();
 
-    bool Load(const char* filename, const char* fmt);
+    // memoryMapped - file is mapped copy-on-write, untouched pages are shared with other processes through page cache
+    bool Load(const char* filename, const char* fmt, bool memoryMapped = false);
 
     class Record
     {
@@ -91,7 +98,10 @@ public:
     [[nodiscard]] uint32 GetCols() const { return fieldCount; }
     [[nodiscard]] uint32 GetOffset(size_t id) const { return (fieldsOffset != nullptr && id < fieldCount) ? fieldsOffset[id] : 0; }
     [[nodiscard]] bool IsLoaded() const { return data != nullptr; }
+    [[nodiscard]] bool IsMemoryMapped() const { return region != nullptr; }
+    [[nodiscard]] bool CanUseRecordsInPlace(char const* fmt) const;
     char* AutoProduceData(char const* fmt, uint32& count, char**& indexTable);
+    void AutoProduceIndex(char const* fmt, uint32& count, char**& indexTable);
     char* AutoProduceStrings(char const* fmt, char* dataTable);
     static uint32 GetFormatRecordSize(const char* format, int32* index_pos = nullptr);
 
@@ -103,6 +113,7 @@ private:
     uint32* fieldsOffset;
     unsigned char* data;
     unsigned char* stringTable;
+    std::unique_ptr<boost::interprocess::mapped_region> region;
 
     DBCFileLoader(DBCFileLoader const& right) = delete;
     DBCFileLoader& operator=(DBCFileLoader const& right) = delete;
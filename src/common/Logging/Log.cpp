@@ -22,6 +22,7 @@
 #include "StringConvert.h"
 #include "Timer.h"
 #include "Tokenize.h"
+#include <array>
 #include <filesystem>
 #include <fmt/std.h>
 #include <spdlog/sinks/basic_file_sink.h>
@@ -50,8 +51,27 @@ namespace
     constexpr auto PREFIX_SINK_LENGTH = 5;
 
     constexpr auto LOG_TIMESTAMP_FMT = "%Y_%m_%d_%H_%M_%S";
+
+    // Slots in filter cache, power of two. Number of different filters is much less
+    constexpr std::size_t FILTER_CACHE_SIZE = 4096;
 }
 
+struct Warhead::Log::FilterCache
+{
+    struct Entry
+    {
+        Entry(std::string_view filter, spdlog::logger* logger) :
+            Filter(filter), Logger(logger) { }
+
+        std::string Filter;
+        spdlog::logger* Logger;
+    };
+
+    // Open addressing with linear probing. Slots are only filled, never changed
+    std::array<std::atomic<Entry*>, FILTER_CACHE_SIZE> Slots{};
+    std::vector<std::unique_ptr<Entry>> Entries;
+};
+
 Warhead::Log::Log()
 {
 #if WARHEAD_PLATFORM == WARHEAD_PLATFORM_WINDOWS
@@ -81,6 +101,8 @@ Warhead::Log* Warhead::Log::instance()
 
 void Warhead::Log::Clear()
 {
+    ResetFilterCache();
+
     auto defaultLogger{ spdlog::default_logger() };
 
     spdlog::shutdown();
@@ -104,6 +126,9 @@ void Warhead::Log::LoadFromConfig()
     Clear();
     ReadSinksFromConfig();
     ReadLoggersFromConfig();
+
+    // Filters resolved while loggers were created could be cached without logger
+    ResetFilterCache();
 }
 
 bool Warhead::Log::ShouldLog(std::string_view filter, spdlog::level::level_enum level)
@@ -112,7 +137,7 @@ bool Warhead::Log::ShouldLog(std::string_view filter, spdlog::level::level_enum
     if (level < _lowestLogLevel)
         return false;
 
-    auto logger = GetLoggerByType(filter);
+    auto logger = GetCachedLogger(filter);
     if (!logger)
         return false;
 
@@ -300,6 +325,67 @@ spdlog::logger* Warhead::Log::GetLoggerByType(std::string_view type)
     return GetLoggerByType(parentLogger);
 }
 
+spdlog::logger* Warhead::Log::GetCachedLogger(std::string_view filter)
+{
+    std::size_t hash = std::hash<std::string_view>{}(filter);
+
+    if (FilterCache* cache = _filterCache.load(std::memory_order_acquire))
+    {
+        for (std::size_t i = 0; i < FILTER_CACHE_SIZE; ++i)
+        {
+            FilterCache::Entry* entry = cache->Slots[(hash + i) & (FILTER_CACHE_SIZE - 1)].load(std::memory_order_acquire);
+            if (!entry)
+                break;
+
+            if (entry->Filter == filter)
+                return entry->Logger;
+        }
+    }
+
+    return CacheLogger(filter, hash);
+}
+
+spdlog::logger* Warhead::Log::CacheLogger(std::string_view filter, std::size_t hash)
+{
+    std::lock_guard<std::mutex> guard(_filterCacheLock);
+
+    FilterCache* cache = _filterCache.load(std::memory_order_relaxed);
+    if (!cache)
+    {
+        cache = _filterCaches.emplace_back(std::make_unique<FilterCache>()).get();
+        _filterCache.store(cache, std::memory_order_release);
+    }
+
+    for (std::size_t i = 0; i < FILTER_CACHE_SIZE; ++i)
+    {
+        auto& slot = cache->Slots[(hash + i) & (FILTER_CACHE_SIZE - 1)];
+
+        // Added by other thread while we waited for lock
+        if (FilterCache::Entry* entry = slot.load(std::memory_order_relaxed))
+        {
+            if (entry->Filter == filter)
+                return entry->Logger;
+
+            continue;
+        }
+
+        auto& entry = cache->Entries.emplace_back(std::make_unique<FilterCache::Entry>(filter, GetLoggerByType(filter)));
+        slot.store(entry.get(), std::memory_order_release);
+        return entry->Logger;
+    }
+
+    // Cache is full, resolve without cache
+    return GetLoggerByType(filter);
+}
+
+void Warhead::Log::ResetFilterCache()
+{
+    std::lock_guard<std::mutex> guard(_filterCacheLock);
+
+    // Old caches stay allocated, other threads can still read them. Only happens on log config load
+    _filterCache.store(nullptr, std::memory_order_release);
+}
+
 spdlog::logger* Warhead::Log::GetLogger(std::string_view loggerName)
 {
     if (auto logger = spdlog::get(std::string{ loggerName }))
@@ -374,7 +460,7 @@ void Warhead::Log::SetSinkLevel(std::string_view sinkName, int level)
 
 void Warhead::Log::Write(std::string_view filter, spdlog::source_loc source, spdlog::level::level_enum level, std::string_view message)
 {
-    auto logger{ GetLoggerByType(filter) };
+    auto logger{ GetCachedLogger(filter) };
     if (!logger)
         return;
 
@@ -21,6 +21,9 @@
 #include "StringFormat.h"
 #include <spdlog/common.h>
 #include <spdlog/fwd.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -106,6 +109,13 @@ namespace Warhead
         void Write(std::string_view filter, spdlog::source_loc source, spdlog::level::level_enum level, std::string_view message);
         void WriteCommand(uint32 accountID, std::string_view message);
 
+        // Filter -> logger resolve cache, lock free for readers. Reset at config load
+        struct FilterCache;
+
+        spdlog::logger* GetCachedLogger(std::string_view filter);
+        spdlog::logger* CacheLogger(std::string_view filter, std::size_t hash);
+        void ResetFilterCache();
+
         void CreateLoggerFromConfig(std::string_view configLoggerName);
         void CreateSinksFromConfig(std::string_view configSinkName);
         void ReadLoggersFromConfig();
@@ -114,6 +124,10 @@ namespace Warhead
         std::string _logsDir;
         spdlog::level::level_enum _lowestLogLevel{spdlog::level::critical };
         std::unordered_map<std::string, spdlog::sink_ptr> _sinks;
+
+        std::atomic<FilterCache*> _filterCache{ nullptr };
+        std::vector<std::unique_ptr<FilterCache>> _filterCaches; // current and reset caches, readers can still use old ones
+        std::mutex _filterCacheLock;
     };
 }
 
@@ -27,8 +27,39 @@
 #include "Tokenize.h"
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <array>
+#include <atomic>
 #include <utility>
 
+// Single producer (owner thread) single consumer (batch sender) ring of samples
+struct MetricSampleBuffer
+{
+    static constexpr std::size_t Capacity = 1 << 12;
+
+    std::array<MetricSample, Capacity> Samples;
+    std::atomic<std::size_t> Head{ 0 };
+    std::atomic<std::size_t> Tail{ 0 };
+    std::atomic<uint64> Dropped{ 0 };
+    std::atomic<bool> Orphaned{ false };
+};
+
+namespace
+{
+    // Buffer is owned by Metric, owner thread only marks it for removal on exit
+    struct ThreadSampleBuffer
+    {
+        ~ThreadSampleBuffer()
+        {
+            if (Buffer)
+                Buffer->Orphaned.store(true, std::memory_order_release);
+        }
+
+        MetricSampleBuffer* Buffer = nullptr;
+    };
+
+    thread_local ThreadSampleBuffer _threadSampleBuffer;
+}
+
 Metric* Metric::instance()
 {
     static Metric instance;
@@ -141,6 +172,192 @@ bool Metric::ShouldLog(std::string const& category, int64 value) const
     return value >= threshold->second;
 }
 
+MetricSeriesId Metric::RegisterSeries(std::string const& category, std::vector<MetricTag> const& tags)
+{
+    std::string renderedTags;
+
+    for (MetricTag const& tag : tags)
+        renderedTags += "," + tag.first + "=" + FormatInfluxDBTagValue(tag.second);
+
+    std::string key = category + renderedTags;
+
+    std::lock_guard<std::mutex> guard(_seriesLock);
+
+    auto itr = _seriesIds.find(key);
+    if (itr != _seriesIds.end())
+    {
+        ++_series[itr->second - 1].References;
+        return itr->second;
+    }
+
+    MetricSeriesId series;
+
+    if (!_freeSeries.empty())
+    {
+        series = _freeSeries.back();
+        _freeSeries.pop_back();
+        _series[series - 1] = { category, std::move(renderedTags), 1 };
+    }
+    else if (_series.size() < MAX_SERIES)
+    {
+        _series.push_back({ category, std::move(renderedTags), 1 });
+        series = MetricSeriesId(_series.size());
+    }
+    else
+    {
+        if (!_seriesFullReported)
+            LOG_ERROR("metric", "Metric series table is full ({} series), samples of '{}' are dropped. Don't tag values by unbounded ids.", MAX_SERIES, key);
+
+        _seriesFullReported = true;
+        return 0;
+    }
+
+    _seriesIds.emplace(std::move(key), series);
+    return series;
+}
+
+void Metric::ReleaseSeries(MetricSeriesId& series)
+{
+    if (!series)
+        return;
+
+    std::lock_guard<std::mutex> guard(_seriesLock);
+
+    MetricSeries& releasedSeries = _series[series - 1];
+    if (!--releasedSeries.References)
+    {
+        _seriesIds.erase(releasedSeries.Category + releasedSeries.Tags);
+        _releasedSeries.push_back(series);
+    }
+
+    series = 0;
+}
+
+void Metric::FreeReleasedSeries()
+{
+    if (_releasedSeries.empty())
+        return;
+
+    // All samples logged before release are drained or cleared now
+    _freeSeries.insert(_freeSeries.end(), _releasedSeries.begin(), _releasedSeries.end());
+    _releasedSeries.clear();
+    _seriesFullReported = false;
+}
+
+MetricSampleBuffer* Metric::GetThreadSampleBuffer()
+{
+    if (!_threadSampleBuffer.Buffer)
+    {
+        auto buffer = std::make_unique<MetricSampleBuffer>();
+        _threadSampleBuffer.Buffer = buffer.get();
+
+        std::lock_guard<std::mutex> guard(_sampleBuffersLock);
+        _sampleBuffers.push_back(std::move(buffer));
+    }
+
+    return _threadSampleBuffer.Buffer;
+}
+
+void Metric::EnqueueSample(MetricSample const& sample)
+{
+    MetricSampleBuffer* buffer = GetThreadSampleBuffer();
+
+    std::size_t head = buffer->Head.load(std::memory_order_relaxed);
+    if (head - buffer->Tail.load(std::memory_order_acquire) >= MetricSampleBuffer::Capacity)
+    {
+        buffer->Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer->Samples[head & (MetricSampleBuffer::Capacity - 1)] = sample;
+    buffer->Head.store(head + 1, std::memory_order_release);
+}
+
+void Metric::DrainSamples(std::ostream& batchedData, bool& firstLoop)
+{
+    std::lock_guard<std::mutex> buffersGuard(_sampleBuffersLock);
+    std::lock_guard<std::mutex> seriesGuard(_seriesLock);
+
+    for (auto itr = _sampleBuffers.begin(); itr != _sampleBuffers.end();)
+    {
+        MetricSampleBuffer& buffer = **itr;
+
+        // Read before head, all samples of exited thread are then visible
+        bool orphaned = buffer.Orphaned.load(std::memory_order_acquire);
+
+        std::size_t tail = buffer.Tail.load(std::memory_order_relaxed);
+        std::size_t head = buffer.Head.load(std::memory_order_acquire);
+
+        for (; tail != head; ++tail)
+        {
+            MetricSample const& sample = buffer.Samples[tail & (MetricSampleBuffer::Capacity - 1)];
+            MetricSeries const& series = _series[sample.Series - 1];
+
+            if (!firstLoop)
+                batchedData << "\n";
+
+            batchedData << series.Category;
+            if (!_realmName.empty())
+                batchedData << ",realm=" << _realmName;
+
+            batchedData << series.Tags << " value=";
+
+            switch (sample.Type)
+            {
+                case METRIC_SAMPLE_INT:
+                    batchedData << FormatInfluxDBValue(sample.Value.Int);
+                    break;
+                case METRIC_SAMPLE_UINT:
+                    batchedData << FormatInfluxDBValue(sample.Value.UInt);
+                    break;
+                case METRIC_SAMPLE_DOUBLE:
+                    batchedData << FormatInfluxDBValue(sample.Value.Double);
+                    break;
+                case METRIC_SAMPLE_BOOL:
+                    batchedData << FormatInfluxDBValue(sample.Value.Bool);
+                    break;
+            }
+
+            batchedData << " " << sample.Timestamp;
+            firstLoop = false;
+        }
+
+        buffer.Tail.store(tail, std::memory_order_release);
+
+        if (uint64 dropped = buffer.Dropped.exchange(0, std::memory_order_relaxed))
+            LOG_WARN("metric", "Thread sample buffer was full, dropped {} samples. Consider lower 'Metric.Interval'.", dropped);
+
+        if (orphaned)
+            itr = _sampleBuffers.erase(itr);
+        else
+            ++itr;
+    }
+
+    FreeReleasedSeries();
+}
+
+void Metric::ClearSamples()
+{
+    std::lock_guard<std::mutex> guard(_sampleBuffersLock);
+    std::lock_guard<std::mutex> seriesGuard(_seriesLock);
+
+    for (auto itr = _sampleBuffers.begin(); itr != _sampleBuffers.end();)
+    {
+        MetricSampleBuffer& buffer = **itr;
+        bool orphaned = buffer.Orphaned.load(std::memory_order_acquire);
+
+        buffer.Tail.store(buffer.Head.load(std::memory_order_acquire), std::memory_order_release);
+        buffer.Dropped.store(0, std::memory_order_relaxed);
+
+        if (orphaned)
+            itr = _sampleBuffers.erase(itr);
+        else
+            ++itr;
+    }
+
+    FreeReleasedSeries();
+}
+
 void Metric::LogEvent(std::string const& category, std::string const& title, std::string const& description)
 {
     using namespace std::chrono;
@@ -193,6 +410,8 @@ void Metric::SendBatch()
         delete data;
     }
 
+    DrainSamples(batchedData, firstLoop);
+
     // Check if there's any data to send
     if (batchedData.tellp() == std::streampos(0))
     {
@@ -257,6 +476,8 @@ void Metric::ScheduleSend()
         {
             delete data;
         }
+
+        ClearSamples();
     }
 }
 
@@ -25,6 +25,8 @@
 #include <functional>
 #include <iosfwd>
 #include <memory>
+#include <mutex>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -37,6 +39,36 @@ enum MetricDataType
 
 typedef std::pair<std::string, std::string> MetricTag;
 
+// Id of interned "category + tags" series, 0 is returned by RegisterSeries only when series table is full
+typedef uint32 MetricSeriesId;
+
+enum MetricSampleType : uint8
+{
+    METRIC_SAMPLE_INT,
+    METRIC_SAMPLE_UINT,
+    METRIC_SAMPLE_DOUBLE,
+    METRIC_SAMPLE_BOOL
+};
+
+// Fixed-size value sample, rendered to line protocol only by batch sender
+struct MetricSample
+{
+    MetricSeriesId Series;
+    MetricSampleType Type;
+
+    union
+    {
+        int64 Int;
+        uint64 UInt;
+        double Double;
+        bool Bool;
+    } Value;
+
+    int64 Timestamp; // nanoseconds since epoch
+};
+
+struct MetricSampleBuffer;
+
 struct MetricData
 {
     std::string Category;
@@ -58,6 +90,25 @@ private:
     std::iostream& GetDataStream() { return *_dataStream; }
     std::unique_ptr<std::iostream> _dataStream;
     MPSCQueue<MetricData> _queuedData;
+
+    struct MetricSeries
+    {
+        std::string Category;
+        std::string Tags; // already rendered as ",key=value,..."
+        uint32 References = 0;
+    };
+
+    static constexpr std::size_t MAX_SERIES = 4096;
+
+    std::mutex _seriesLock;
+    std::vector<MetricSeries> _series;
+    std::unordered_map<std::string, MetricSeriesId> _seriesIds;
+    std::vector<MetricSeriesId> _releasedSeries; // may still have samples in thread buffers, reused after next drain
+    std::vector<MetricSeriesId> _freeSeries;
+    bool _seriesFullReported = false;
+
+    std::mutex _sampleBuffersLock;
+    std::vector<std::unique_ptr<MetricSampleBuffer>> _sampleBuffers;
     std::unique_ptr<Warhead::Asio::DeadlineTimer> _batchTimer;
     std::unique_ptr<Warhead::Asio::DeadlineTimer> _overallStatusTimer;
     int32 _updateInterval = 0;
@@ -73,6 +124,11 @@ private:
 
     bool Connect();
     void SendBatch();
+    void DrainSamples(std::ostream& batchedData, bool& firstLoop);
+    void ClearSamples();
+    void FreeReleasedSeries();
+    void EnqueueSample(MetricSample const& sample);
+    MetricSampleBuffer* GetThreadSampleBuffer();
     void ScheduleSend();
     void ScheduleOverallStatusLog();
 
@@ -89,6 +145,45 @@ private:
 
     static std::string FormatInfluxDBTagValue(std::string const& value);
 
+    template<class T>
+    static constexpr bool IsSampleType = std::is_arithmetic_v<T> || std::is_same_v<T, std::chrono::nanoseconds>;
+
+    template<class T>
+    static MetricSample MakeSample(MetricSeriesId series, T value)
+    {
+        MetricSample sample;
+        sample.Series = series;
+        sample.Timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            sample.Type = METRIC_SAMPLE_BOOL;
+            sample.Value.Bool = value;
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            sample.Type = METRIC_SAMPLE_DOUBLE;
+            sample.Value.Double = double(value);
+        }
+        else if constexpr (std::is_same_v<T, std::chrono::nanoseconds>)
+        {
+            sample.Type = METRIC_SAMPLE_INT;
+            sample.Value.Int = int64(std::chrono::duration_cast<Milliseconds>(value).count());
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            sample.Type = METRIC_SAMPLE_INT;
+            sample.Value.Int = int64(value);
+        }
+        else
+        {
+            sample.Type = METRIC_SAMPLE_UINT;
+            sample.Value.UInt = uint64(value);
+        }
+
+        return sample;
+    }
+
     /// @todo: should format TagKey and FieldKey too in the same way as TagValue
 
 public:
@@ -102,11 +197,28 @@ public:
     void Update();
     bool ShouldLog(std::string const& category, int64 value) const;
 
+    // Interns series, returns same id for same category and tags. Not meant for hot path, cache returned id.
+    // Series with runtime tags (like map instance id) must be released by owner of the id
+    MetricSeriesId RegisterSeries(std::string const& category, std::vector<MetricTag> const& tags);
+    void ReleaseSeries(MetricSeriesId& series);
+
+    // Hot path: no allocation, sample goes to ring buffer of calling thread
+    template<class T>
+    void LogValue(MetricSeriesId series, T value)
+    {
+        static_assert(IsSampleType<T>, "Only arithmetic and duration values can be logged to series");
+
+        if (series)
+            EnqueueSample(MakeSample(series, value));
+    }
+
     template<class T>
     void LogValue(std::string const& category, T value, std::vector<MetricTag> tags)
     {
         using namespace std::chrono;
 
+        static_assert(!IsSampleType<T>, "Arithmetic and duration values are logged to registered series, see METRIC_SERIES");
+
         MetricData* data = new MetricData;
         data->Category = category;
         data->Timestamp = system_clock::now();
@@ -158,12 +270,21 @@ MetricStopWatch<LoggerType> MakeMetricStopWatch(LoggerType&& loggerFunc)
 #define METRIC_CONCAT(a, b) METRIC_DO_CONCAT(a, b)
 #define METRIC_UNIQUE_NAME(name) METRIC_CONCAT(name, __LINE__)
 
+// Series registered once per call site, category and tags must be constant.
+// For tags known only at runtime use METRIC_SERIES_VALUE / METRIC_SERIES_TIMER with caller owned
+// MetricSeriesId (0 until registered), tags are then built only once on registration
+#define METRIC_SERIES(category, ...)                                                                  \
+        [] { static MetricSeriesId const series = sMetric->RegisterSeries(category, { __VA_ARGS__ }); return series; }()
+
 #if defined PERFORMANCE_PROFILING || defined WITHOUT_METRICS
 #define METRIC_EVENT(category, title, description) ((void)0)
 #define METRIC_VALUE(category, value, ...) ((void)0)
 #define METRIC_TIMER(category, ...) ((void)0)
+#define METRIC_SERIES_VALUE(series, category, value, ...) ((void)0)
+#define METRIC_SERIES_TIMER(series, category, ...) ((void)0)
 #define METRIC_DETAILED_EVENT(category, title, description) ((void)0)
 #define METRIC_DETAILED_TIMER(category, ...) ((void)0)
+#define METRIC_DETAILED_SERIES_TIMER(series, category, ...) ((void)0)
 #define METRIC_DETAILED_NO_THRESHOLD_TIMER(category, ...) ((void)0)
 #else
 #if WARHEAD_PLATFORM != WARHEAD_PLATFORM_WINDOWS
@@ -175,7 +296,17 @@ MetricStopWatch<LoggerType> MakeMetricStopWatch(LoggerType&& loggerFunc)
 #define METRIC_VALUE(category, value, ...)                          \
         do {                                                           \
             if (sMetric->IsEnabled())                                  \
-                sMetric->LogValue(category, value, { __VA_ARGS__ });   \
+                sMetric->LogValue(METRIC_SERIES(category, __VA_ARGS__), value); \
+        } while (0)
+#define METRIC_SERIES_VALUE(series, category, value, ...)           \
+        do {                                                           \
+            if (sMetric->IsEnabled())                                  \
+            {                                                          \
+                MetricSeriesId& metricSeries = series;                 \
+                if (!metricSeries)                                     \
+                    metricSeries = sMetric->RegisterSeries(category, { __VA_ARGS__ }); \
+                sMetric->LogValue(metricSeries, value);                \
+            }                                                          \
         } while (0)
 #else
 #define METRIC_EVENT(category, title, description)                  \
@@ -191,14 +322,35 @@ MetricStopWatch<LoggerType> MakeMetricStopWatch(LoggerType&& loggerFunc)
         __pragma(warning(disable:4127))                                \
         do {                                                           \
             if (sMetric->IsEnabled())                                  \
-                sMetric->LogValue(category, value, { __VA_ARGS__ });   \
+                sMetric->LogValue(METRIC_SERIES(category, __VA_ARGS__), value); \
+        } while (0)                                                    \
+        __pragma(warning(pop))
+#define METRIC_SERIES_VALUE(series, category, value, ...)           \
+        __pragma(warning(push))                                        \
+        __pragma(warning(disable:4127))                                \
+        do {                                                           \
+            if (sMetric->IsEnabled())                                  \
+            {                                                          \
+                MetricSeriesId& metricSeries = series;                 \
+                if (!metricSeries)                                     \
+                    metricSeries = sMetric->RegisterSeries(category, { __VA_ARGS__ }); \
+                sMetric->LogValue(metricSeries, value);                \
+            }                                                          \
         } while (0)                                                    \
         __pragma(warning(pop))
 #endif
 #define METRIC_TIMER(category, ...)                                                                           \
         MetricStopWatch METRIC_UNIQUE_NAME(__ac_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start) \
         {                                                                                                        \
-            sMetric->LogValue(category, std::chrono::steady_clock::now() - start, { __VA_ARGS__ });              \
+            sMetric->LogValue(METRIC_SERIES(category, __VA_ARGS__), std::chrono::steady_clock::now() - start);   \
+        });
+#define METRIC_SERIES_TIMER(series, category, ...)                                                            \
+        MetricStopWatch METRIC_UNIQUE_NAME(__ac_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start) \
+        {                                                                                                        \
+            MetricSeriesId& metricSeries = series;                                                               \
+            if (!metricSeries)                                                                                   \
+                metricSeries = sMetric->RegisterSeries(category, { __VA_ARGS__ });                               \
+            sMetric->LogValue(metricSeries, std::chrono::steady_clock::now() - start);                           \
         });
 #if defined WITH_DETAILED_METRICS
 #define METRIC_DETAILED_TIMER(category, ...)                                                                  \
@@ -206,13 +358,27 @@ MetricStopWatch<LoggerType> MakeMetricStopWatch(LoggerType&& loggerFunc)
         {                                                                                                        \
             int64 duration = int64(std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - start).count()); \
             if (sMetric->ShouldLog(category, duration))                                                          \
-                sMetric->LogValue(category, duration, { __VA_ARGS__ });                                          \
+                sMetric->LogValue(METRIC_SERIES(category, __VA_ARGS__), duration);                               \
+        });
+// Series may be shared between threads (std::atomic<MetricSeriesId>), it's read once and written only on registration
+#define METRIC_DETAILED_SERIES_TIMER(series, category, ...)                                                   \
+        MetricStopWatch METRIC_UNIQUE_NAME(__ac_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start) \
+        {                                                                                                        \
+            int64 duration = int64(std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - start).count()); \
+            if (sMetric->ShouldLog(category, duration))                                                          \
+            {                                                                                                    \
+                MetricSeriesId metricSeries = series;                                                            \
+                if (!metricSeries)                                                                               \
+                    series = metricSeries = sMetric->RegisterSeries(category, { __VA_ARGS__ });                  \
+                sMetric->LogValue(metricSeries, duration);                                                       \
+            }                                                                                                    \
         });
 #define METRIC_DETAILED_NO_THRESHOLD_TIMER(category, ...) METRIC_TIMER(category, __VA_ARGS__)
 #define METRIC_DETAILED_EVENT(category, title, description) METRIC_EVENT(category, title, description)
 #else
 #define METRIC_DETAILED_EVENT(category, title, description) ((void)0)
 #define METRIC_DETAILED_TIMER(category, ...) ((void)0)
+#define METRIC_DETAILED_SERIES_TIMER(series, category, ...) ((void)0)
 #define METRIC_DETAILED_NO_THRESHOLD_TIMER(category, ...) ((void)0)
 #endif
 
@@ -0,0 +1,172 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskGraph.h"
+#include "Errors.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+void Warhead::TaskGraph::AddTask(std::string_view name, std::initializer_list<std::string_view> dependencies, Task&& task)
+{
+    std::size_t index = _nodes.size();
+    [[maybe_unused]] bool inserted = _nodeIndexes.emplace(std::string(name), index).second;
+    ASSERT(inserted, "Task {} added twice", name);
+
+    std::vector<std::size_t> dependencyIndexes;
+
+    for (std::string_view dependency : dependencies)
+    {
+        auto itr = _nodeIndexes.find(std::string(dependency));
+        ASSERT(itr != _nodeIndexes.end() && itr->second != index, "Task {} depends on not added task {}", name, dependency);
+        dependencyIndexes.emplace_back(itr->second);
+    }
+
+    if (_lastBarrier != std::size_t(-1))
+        dependencyIndexes.emplace_back(_lastBarrier);
+
+    std::sort(dependencyIndexes.begin(), dependencyIndexes.end());
+    dependencyIndexes.erase(std::unique(dependencyIndexes.begin(), dependencyIndexes.end()), dependencyIndexes.end());
+
+    Node& node = _nodes.emplace_back();
+    node.Name = name;
+    node.Execute = std::move(task);
+    node.DependencyCount = dependencyIndexes.size();
+
+    for (std::size_t dependency : dependencyIndexes)
+        _nodes[dependency].Dependents.emplace_back(index);
+}
+
+void Warhead::TaskGraph::AddBarrier(std::string_view name, Task&& task)
+{
+    std::size_t index = _nodes.size();
+    [[maybe_unused]] bool inserted = _nodeIndexes.emplace(std::string(name), index).second;
+    ASSERT(inserted, "Task {} added twice", name);
+
+    std::size_t first = _lastBarrier == std::size_t(-1) ? 0 : _lastBarrier;
+
+    Node& node = _nodes.emplace_back();
+    node.Name = name;
+    node.Execute = std::move(task);
+
+    // tasks after previous barrier already depend on it
+    for (std::size_t i = first; i < index; ++i)
+    {
+        if (i != _lastBarrier || i + 1 == index)
+        {
+            _nodes[i].Dependents.emplace_back(index);
+            ++node.DependencyCount;
+        }
+    }
+
+    _lastBarrier = index;
+}
+
+void Warhead::TaskGraph::Run(std::size_t threads)
+{
+    _timings.clear();
+    _timings.resize(_nodes.size());
+
+    if (threads <= 1 || _nodes.size() <= 1)
+        RunSequential();
+    else
+        RunParallel(threads);
+}
+
+void Warhead::TaskGraph::RunSequential()
+{
+    for (std::size_t i = 0; i < _nodes.size(); ++i)
+        ExecuteNode(i);
+}
+
+void Warhead::TaskGraph::RunParallel(std::size_t threads)
+{
+    std::vector<std::size_t> remaining;
+    remaining.reserve(_nodes.size());
+
+    for (Node const& node : _nodes)
+        remaining.emplace_back(node.DependencyCount);
+
+    ThreadPool pool(threads);
+
+    std::mutex lock;
+    std::condition_variable allDone;
+    std::size_t running{ 0 };
+    std::exception_ptr error;
+
+    // called with lock held
+    std::function<void(std::size_t)> post = [&](std::size_t index)
+    {
+        ++running;
+
+        pool.PostWork([&, index]()
+        {
+            std::exception_ptr taskError;
+
+            try
+            {
+                ExecuteNode(index);
+            }
+            catch (...)
+            {
+                taskError = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> guard(lock);
+            --running;
+
+            if (taskError && !error)
+                error = taskError;
+
+            if (!error)
+                for (std::size_t dependent : _nodes[index].Dependents)
+                    if (!--remaining[dependent])
+                        post(dependent);
+
+            if (!running)
+                allDone.notify_one();
+        });
+    };
+
+    {
+        std::unique_lock<std::mutex> guard(lock);
+
+        for (std::size_t i = 0; i < _nodes.size(); ++i)
+            if (!remaining[i])
+                post(i);
+
+        allDone.wait(guard, [&running]() { return !running; });
+    }
+
+    pool.Wait();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void Warhead::TaskGraph::ExecuteNode(std::size_t index)
+{
+    Node& node = _nodes[index];
+    auto start = std::chrono::steady_clock::now();
+
+    node.Execute();
+
+    _timings[index].Name = node.Name;
+    _timings[index].Elapsed = std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start);
+}
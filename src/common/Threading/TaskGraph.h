@@ -0,0 +1,78 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WARHEAD_TASK_GRAPH_H_
+#define _WARHEAD_TASK_GRAPH_H_
+
+#include "Define.h"
+#include "Duration.h"
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Warhead
+{
+    // Set of named tasks with explicit dependencies between them.
+    // Dependencies must be added before the task which uses them, so added order is always a valid run order.
+    // With one thread tasks are executed in added order, else every task whose dependencies are done is executed on a thread pool.
+    class WH_COMMON_API TaskGraph
+    {
+    public:
+        using Task = std::function<void()>;
+
+        struct TaskTiming
+        {
+            std::string Name;
+            Microseconds Elapsed{};
+        };
+
+        void AddTask(std::string_view name, std::initializer_list<std::string_view> dependencies, Task&& task);
+
+        // Task which depends on all tasks added before it, all tasks added after it depend on it.
+        // For tasks that change data other tasks can read at same time.
+        void AddBarrier(std::string_view name, Task&& task);
+
+        // Exception of task is thrown again after running tasks are finished, tasks not started yet are skipped
+        void Run(std::size_t threads);
+
+        [[nodiscard]] std::vector<TaskTiming> const& GetTimings() const { return _timings; }
+        [[nodiscard]] std::size_t GetSize() const { return _nodes.size(); }
+
+    private:
+        struct Node
+        {
+            std::string Name;
+            Task Execute;
+            std::vector<std::size_t> Dependents;
+            std::size_t DependencyCount{};
+        };
+
+        void RunSequential();
+        void RunParallel(std::size_t threads);
+        void ExecuteNode(std::size_t index);
+
+        std::vector<Node> _nodes;
+        std::unordered_map<std::string, std::size_t> _nodeIndexes;
+        std::size_t _lastBarrier{ std::size_t(-1) };
+        std::vector<TaskTiming> _timings;
+    };
+}
+
+#endif
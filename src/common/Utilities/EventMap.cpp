@@ -68,7 +68,7 @@ void EventMap::ScheduleEvent(uint32 eventId, uint32 time, uint32 group /*= 0*/,
         eventId |= (1 << (phase + 23));
     }
 
-    _eventMap.emplace(_time + time, eventId);
+    InsertEvent(_time + time, eventId);
 }
 
 void EventMap::ScheduleEvent(uint32 eventId, Milliseconds time, uint32 group /*= 0*/, uint8 phase /* = 0*/)
@@ -101,7 +101,7 @@ void EventMap::RescheduleEvent(uint32 eventId, Milliseconds minTime, Millisecond
 
 void EventMap::RepeatEvent(uint32 time)
 {
-    _eventMap.emplace(_time + time, _lastEvent);
+    InsertEvent(_time + time, _lastEvent);
 }
 
 void EventMap::Repeat(Milliseconds time)
@@ -118,22 +118,19 @@ uint32 EventMap::ExecuteEvent()
 {
     while (!Empty())
     {
-        auto const& itr = _eventMap.begin();
+        EventEntry const next = _eventMap.back();
 
-        if (itr->first > _time)
+        if (next.Time > _time)
         {
             return 0;
         }
-        else if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
-        {
-            _eventMap.erase(itr);
-        }
-        else
+
+        _eventMap.pop_back();
+
+        if (!_phase || !(next.Data & 0xFF000000) || ((next.Data >> 24) & _phase))
         {
-            uint32 eventId = (itr->second & 0x0000FFFF);
-            _lastEvent = itr->second;
-            _eventMap.erase(itr);
-            return eventId;
+            _lastEvent = next.Data;
+            return (next.Data & 0x0000FFFF);
         }
     }
 
@@ -150,19 +147,39 @@ void EventMap::DelayEvents(Milliseconds delay)
     DelayEvents(delay.count());
 }
 
+void EventMap::DelayEvents(uint32 delay, uint32 group)
+{
+    if (group > 8 || Empty())
+    {
+        return;
+    }
+
+    EventStore delayed;
+    ExtractEvents(delayed, [group](EventEntry const& event)
+    {
+        return !group || (event.Data & (1 << (group + 15)));
+    });
+
+    // delayed events are executed after events already scheduled at same time
+    for (EventEntry const& event : delayed)
+    {
+        InsertEvent(event.Time + delay, event.Data);
+    }
+}
+
 void EventMap::DelayEventsToMax(uint32 delay, uint32 group)
 {
-    for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+    uint32 const maxTime = _time + delay;
+
+    EventStore delayed;
+    ExtractEvents(delayed, [maxTime, group](EventEntry const& event)
     {
-        if (itr->first < _time + delay && (group == 0 || ((1 << (group + 15)) & itr->second)))
-        {
-            ScheduleEvent(itr->second, delay);
-            _eventMap.erase(itr);
-            itr = _eventMap.begin();
-            continue;
-        }
+        return event.Time < maxTime && (group == 0 || ((1 << (group + 15)) & event.Data));
+    });
 
-        ++itr;
+    for (EventEntry const& event : delayed)
+    {
+        InsertEvent(maxTime, event.Data);
     }
 }
 
@@ -173,16 +190,10 @@ void EventMap::CancelEvent(uint32 eventId)
         return;
     }
 
-    for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.erase(std::remove_if(_eventMap.begin(), _eventMap.end(), [eventId](EventEntry const& event)
     {
-        if (eventId == (itr->second & 0x0000FFFF))
-        {
-            itr = _eventMap.erase(itr);
-            continue;
-        }
-
-        ++itr;
-    }
+        return eventId == (event.Data & 0x0000FFFF);
+    }), _eventMap.end());
 }
 
 void EventMap::CancelEventGroup(uint32 group)
@@ -193,17 +204,10 @@ void EventMap::CancelEventGroup(uint32 group)
     }
 
     uint32 groupMask = (1 << (group + 15));
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.erase(std::remove_if(_eventMap.begin(), _eventMap.end(), [groupMask](EventEntry const& event)
     {
-        if (itr->second & groupMask)
-        {
-            _eventMap.erase(itr);
-            itr = _eventMap.begin();
-            continue;
-        }
-
-        ++itr;
-    }
+        return event.Data & groupMask;
+    }), _eventMap.end());
 }
 
 uint32 EventMap::GetNextEventTime(uint32 eventId) const
@@ -213,11 +217,11 @@ uint32 EventMap::GetNextEventTime(uint32 eventId) const
         return 0;
     }
 
-    for (auto const& itr : _eventMap)
+    for (auto itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
     {
-        if (eventId == (itr.second & 0x0000FFFF))
+        if (eventId == (itr->Data & 0x0000FFFF))
         {
-            return itr.first;
+            return itr->Time;
         }
     }
 
@@ -226,7 +230,7 @@ uint32 EventMap::GetNextEventTime(uint32 eventId) const
 
 uint32 EventMap::GetNextEventTime() const
 {
-    return Empty() ? 0 : _eventMap.begin()->first;
+    return Empty() ? 0 : _eventMap.back().Time;
 }
 
 bool EventMap::IsInPhase(uint8 phase)
@@ -236,9 +240,20 @@ bool EventMap::IsInPhase(uint8 phase)
 
 Milliseconds EventMap::GetTimeUntilEvent(uint32 eventId) const
 {
-    for (std::pair<uint32 const, uint32> const& itr : _eventMap)
-        if (eventId == (itr.second & 0x0000FFFF))
-            return std::chrono::duration_cast<Milliseconds>(Milliseconds(itr.first) - Milliseconds(_time));
+    for (auto itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
+        if (eventId == (itr->Data & 0x0000FFFF))
+            return std::chrono::duration_cast<Milliseconds>(Milliseconds(itr->Time) - Milliseconds(_time));
 
     return Milliseconds::max();
 }
+
+void EventMap::InsertEvent(uint32 time, uint32 data)
+{
+    // events with same time were scheduled before, they stay closer to the end and are executed first
+    auto itr = std::partition_point(_eventMap.begin(), _eventMap.end(), [time](EventEntry const& event)
+    {
+        return event.Time > time;
+    });
+
+    _eventMap.insert(itr, EventEntry{ time, data });
+}
@@ -20,14 +20,15 @@
 
 #include "Define.h"
 #include "Duration.h"
-#include <map>
+#include <algorithm>
+#include <boost/container/small_vector.hpp>
 
 class WH_COMMON_API EventMap
 {
     /**
-    * Internal storage type.
-    * Key: Time as TimePoint when the event should occur.
-    * Value: The event data as uint32.
+    * Internal storage entry.
+    * Time: Time as TimePoint when the event should occur.
+    * Data: The event data as uint32.
     *
     * Structure of event data:
     * - Bit  0 - 15: Event Id.
@@ -35,7 +36,19 @@ class WH_COMMON_API EventMap
     * - Bit 24 - 31: Phase
     * - Pattern: 0xPPGGEEEE
     */
-    typedef std::multimap<uint32, uint32> EventStore;
+    struct EventEntry
+    {
+        uint32 Time;
+        uint32 Data;
+    };
+
+    /**
+    * Internal storage type.
+    * Sorted by time in descending order, next event is the last element.
+    * Events with same time are executed in order of scheduling.
+    * Boss scripts rarely have more than few events, they are stored inline without allocation.
+    */
+    typedef boost::container::small_vector<EventEntry, 8> EventStore;
 
 public:
     EventMap() { }
@@ -231,29 +244,7 @@ public:
     * @param delay Amount of delay.
     * @param group Group of the events.
     */
-    void DelayEvents(uint32 delay, uint32 group)
-    {
-        if (group > 8 || Empty())
-        {
-            return;
-        }
-
-        EventStore delayed;
-
-        for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
-        {
-            if (!group || (itr->second & (1 << (group + 15))))
-            {
-                delayed.insert(EventStore::value_type(itr->first + delay, itr->second));
-                itr = _eventMap.erase(itr);
-                continue;
-            }
-
-            ++itr;
-        }
-
-        _eventMap.insert(delayed.begin(), delayed.end());
-    }
+    void DelayEvents(uint32 delay, uint32 group);
 
     // DelayEventsToMax
     void DelayEventsToMax(uint32 delay, uint32 group);
@@ -303,6 +294,28 @@ public:
     Milliseconds GetTimeUntilEvent(uint32 eventId) const;
 
 private:
+    /**
+    * @name InsertEvent
+    * @brief Inserts event, it is executed after all events with lower or same time.
+    * @param time Time when the event should occur.
+    * @param data Event data.
+    */
+    void InsertEvent(uint32 time, uint32 data);
+
+    /**
+    * @name ExtractEvents
+    * @brief Moves events matching predicate to result in order of execution.
+    */
+    template<typename Predicate>
+    void ExtractEvents(EventStore& result, Predicate&& predicate)
+    {
+        for (auto itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
+            if (predicate(*itr))
+                result.push_back(*itr);
+
+        _eventMap.erase(std::remove_if(_eventMap.begin(), _eventMap.end(), predicate), _eventMap.end());
+    }
+
     /**
     * @name _time
     * @brief Internal timer.
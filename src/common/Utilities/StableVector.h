@@ -0,0 +1,172 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _STABLE_VECTOR_H_
+#define _STABLE_VECTOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Warhead
+{
+    /**
+     * @class StableVector
+     *
+     * @brief Contiguous replacement of std::list<T*> for lists which are iterated much more often than changed.
+     *
+     * Removed pointers leave empty slots, so iterators stay valid when elements are added or removed
+     * during iteration, same as std::list iterators of not removed elements. Iterators skip empty slots.
+     * Compact() drops empty slots and must not be called while the container is iterated.
+     * Unlike std::list, end iterator kept during push_back points to the new element.
+     */
+    template<class T>
+    class StableVector
+    {
+        static_assert(std::is_pointer_v<T>, "StableVector holds pointers, nullptr marks removed element");
+
+    public:
+        template<bool IsConst>
+        class Iterator
+        {
+            using Storage = std::conditional_t<IsConst, std::vector<T> const, std::vector<T>>;
+
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<IsConst, T const*, T*>;
+            using reference = std::conditional_t<IsConst, T const&, T&>;
+
+            Iterator() = default;
+            Iterator(Storage* storage, std::size_t index) : _storage(storage), _index(index) { }
+
+            // iterator converts to const_iterator
+            template<bool C = IsConst, std::enable_if_t<!C, int> = 0>
+            operator Iterator<true>() const { return Iterator<true>(_storage, _index); }
+
+            reference operator*() const { return (*_storage)[_index]; }
+            pointer operator->() const { return &(*_storage)[_index]; }
+
+            Iterator& operator++()
+            {
+                while (++_index < _storage->size() && !(*_storage)[_index]) { }
+                return *this;
+            }
+
+            Iterator operator++(int) { Iterator itr = *this; ++*this; return itr; }
+
+            Iterator& operator--()
+            {
+                while (!(*_storage)[--_index]) { }
+                return *this;
+            }
+
+            Iterator operator--(int) { Iterator itr = *this; --*this; return itr; }
+
+            bool operator==(Iterator const& right) const { return _index == right._index; }
+            bool operator!=(Iterator const& right) const { return _index != right._index; }
+
+        private:
+            Storage* _storage = nullptr;
+            std::size_t _index = 0;
+        };
+
+        using value_type = T;
+        using size_type = std::size_t;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        StableVector() = default;
+        StableVector(StableVector const& right) : _size(right._size)
+        {
+            _slots.reserve(right._size);
+            std::copy_if(right._slots.begin(), right._slots.end(), std::back_inserter(_slots), [](T value) { return value != nullptr; });
+        }
+
+        StableVector(StableVector&& right) noexcept : _slots(std::move(right._slots)), _size(std::exchange(right._size, 0)) { right._slots.clear(); }
+        StableVector& operator=(StableVector const& right) { StableVector copy(right); swap(copy); return *this; }
+        StableVector& operator=(StableVector&& right) noexcept { StableVector moved(std::move(right)); swap(moved); return *this; }
+
+        iterator begin() { return iterator(&_slots, FirstSlot()); }
+        iterator end() { return iterator(&_slots, _slots.size()); }
+        const_iterator begin() const { return const_iterator(&_slots, FirstSlot()); }
+        const_iterator end() const { return const_iterator(&_slots, _slots.size()); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+        [[nodiscard]] bool empty() const { return !_size; }
+        [[nodiscard]] size_type size() const { return _size; }
+
+        T front() const { return *begin(); }
+        T back() const { return *rbegin(); }
+
+        void push_back(T value) { _slots.push_back(value); ++_size; }
+
+        // Returns true when slot was emptied, container should be compacted later then
+        bool remove(T value)
+        {
+            bool removed = false;
+            for (T& slot : _slots)
+            {
+                if (slot == value)
+                {
+                    slot = nullptr;
+                    --_size;
+                    removed = true;
+                }
+            }
+
+            return removed;
+        }
+
+        template<class Pred>
+        void sort(Pred pred)
+        {
+            Compact();
+            std::stable_sort(_slots.begin(), _slots.end(), pred);
+        }
+
+        void clear() { _slots.clear(); _size = 0; }
+
+        void swap(StableVector& right) noexcept { _slots.swap(right._slots); std::swap(_size, right._size); }
+
+        void Compact() { _slots.erase(std::remove(_slots.begin(), _slots.end(), nullptr), _slots.end()); }
+
+    private:
+        [[nodiscard]] std::size_t FirstSlot() const
+        {
+            std::size_t i = 0;
+            while (i < _slots.size() && !_slots[i])
+                ++i;
+
+            return i;
+        }
+
+        std::vector<T> _slots;
+        std::size_t _size = 0; // not empty slots
+    };
+}
+
+#endif // _STABLE_VECTOR_H_
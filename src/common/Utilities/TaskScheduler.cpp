@@ -20,6 +20,7 @@
 
 #include "TaskScheduler.h"
 #include "Errors.h"
+#include <algorithm>
 
 TaskScheduler& TaskScheduler::ClearValidator()
 {
@@ -127,21 +128,63 @@ bool TaskScheduler::IsGroupScheduled(group_t const group)
     return _task_holder.IsGroupQueued(group);
 }
 
+TaskScheduler::TaskPool::~TaskPool()
+{
+    while (_free)
+    {
+        FreeBlock* block = _free;
+        _free = block->Next;
+        ::operator delete(block);
+    }
+}
+
+void* TaskScheduler::TaskPool::Allocate(std::size_t size)
+{
+    // Only task with its control block is allocated through the pool, all blocks have same size
+    if (!_blockSize)
+    {
+        _blockSize = std::max(size, sizeof(FreeBlock));
+    }
+
+    if (size > _blockSize || !_free)
+    {
+        return ::operator new(std::max(size, _blockSize));
+    }
+
+    FreeBlock* block = _free;
+    _free = block->Next;
+    return block;
+}
+
+void TaskScheduler::TaskPool::Deallocate(void* block, std::size_t size)
+{
+    if (size > _blockSize)
+    {
+        ::operator delete(block);
+        return;
+    }
+
+    _free = new (block) FreeBlock{ _free };
+}
+
 void TaskScheduler::TaskQueue::Push(TaskContainer&& task)
 {
-    container.insert(task);
+    task->_sequence = _sequence++;
+    container.push_back(std::move(task));
+    std::push_heap(container.begin(), container.end(), Compare());
 }
 
 auto TaskScheduler::TaskQueue::Pop() -> TaskContainer
 {
-    TaskContainer result = *container.begin();
-    container.erase(container.begin());
+    std::pop_heap(container.begin(), container.end(), Compare());
+    TaskContainer result = std::move(container.back());
+    container.pop_back();
     return result;
 }
 
 auto TaskScheduler::TaskQueue::First() const -> TaskContainer const&
 {
-    return *container.begin();
+    return container.front();
 }
 
 void TaskScheduler::TaskQueue::Clear()
@@ -151,32 +194,36 @@ void TaskScheduler::TaskQueue::Clear()
 
 void TaskScheduler::TaskQueue::RemoveIf(std::function<bool(TaskContainer const&)> const& filter)
 {
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-        {
-            itr = container.erase(itr);
-        }
-        else
-        {
-            ++itr;
-        }
+    auto const itr = std::remove_if(container.begin(), container.end(), filter);
+    if (itr == container.end())
+    {
+        return;
+    }
+
+    container.erase(itr, container.end());
+    std::make_heap(container.begin(), container.end(), Compare());
 }
 
 void TaskScheduler::TaskQueue::ModifyIf(std::function<bool(TaskContainer const&)> const& filter)
 {
-    std::vector<TaskContainer> cache;
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-        {
-            cache.push_back(*itr);
-            itr = container.erase(itr);
-        }
-        else
-        {
-            ++itr;
-        }
+    // Sorted vector is valid heap, modified tasks are queued again in their previous order
+    // after tasks with same end, like on removal and insertion
+    std::sort(container.begin(), container.end(), [](TaskContainer const& left, TaskContainer const& right)
+    {
+        return *left < *right;
+    });
+
+    auto const itr = std::stable_partition(container.begin(), container.end(), [&filter](TaskContainer const& task)
+    {
+        return !filter(task);
+    });
+
+    for (auto modified = itr; modified != container.end(); ++modified)
+    {
+        (*modified)->_sequence = _sequence++;
+    }
 
-    container.insert(cache.begin(), cache.end());
+    std::make_heap(container.begin(), container.end(), Compare());
 }
 
 bool TaskScheduler::TaskQueue::IsGroupQueued(group_t const group)
@@ -197,16 +244,6 @@ bool TaskScheduler::TaskQueue::IsEmpty() const
     return container.empty();
 }
 
-TaskContext& TaskContext::Dispatch(std::function<TaskScheduler&(TaskScheduler&)> const& apply)
-{
-    if (auto const owner = _owner.lock())
-    {
-        apply(*owner);
-    }
-
-    return *this;
-}
-
 bool TaskContext::IsExpired() const
 {
     return _owner.expired();
@@ -258,7 +295,7 @@ void TaskContext::AssertOnConsumed() const
 {
     // This was adapted to TC to prevent static analysis tools from complaining.
     // If you encounter this assertion check if you repeat a TaskContext more then 1 time!
-    ASSERT(!(*_consumed) && "Bad task logic, task context was consumed already!");
+    ASSERT(_task && _task->_invocation == _invocation && !_task->_consumed && "Bad task logic, task context was consumed already!");
 }
 
 void TaskContext::Invoke()
@@ -20,11 +20,13 @@
 
 #include "Util.h"
 #include <chrono>
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <new>
 #include <optional>
 #include <queue>
-#include <set>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -56,8 +58,100 @@ class WH_COMMON_API TaskScheduler
     typedef uint32 group_t;
     // Task repeated type
     typedef uint32 repeated_t;
+    /// Callable with signature void(TaskContext), callables up to INLINE_SIZE bytes
+    /// are stored in the task itself instead of separate allocation like in std::function.
+    class WH_COMMON_API TaskHandler
+    {
+        static constexpr std::size_t INLINE_SIZE = 48;
+
+        struct Operations
+        {
+            void(*Invoke)(void* callable, TaskContext& context);
+            void(*Move)(void* from, void* to);
+            void(*Destroy)(void* callable);
+        };
+
+        template<typename F>
+        static constexpr bool IsInline = sizeof(F) <= INLINE_SIZE && alignof(F) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible_v<F>;
+
+        template<typename F>
+        static Operations const* GetOperations()
+        {
+            static Operations const operations =
+            {
+                [](void* callable, TaskContext& context) { (*Get<F>(callable))(context); },
+                [](void* from, void* to)
+                {
+                    if constexpr (IsInline<F>)
+                    {
+                        new (to) F(std::move(*Get<F>(from)));
+                        Get<F>(from)->~F();
+                    }
+                    else
+                        *static_cast<F**>(to) = *static_cast<F**>(from);
+                },
+                [](void* callable)
+                {
+                    if constexpr (IsInline<F>)
+                        Get<F>(callable)->~F();
+                    else
+                        delete Get<F>(callable);
+                }
+            };
+
+            return &operations;
+        }
+
+        template<typename F>
+        static F* Get(void* storage)
+        {
+            if constexpr (IsInline<F>)
+                return std::launder(static_cast<F*>(storage));
+            else
+                return *static_cast<F**>(storage);
+        }
+
+        alignas(std::max_align_t) unsigned char _storage[INLINE_SIZE];
+        Operations const* _operations;
+
+    public:
+        template<typename Callable, typename F = std::decay_t<Callable>,
+                 typename = std::enable_if_t<!std::is_same_v<F, TaskHandler>>>
+        TaskHandler(Callable&& callable) : _operations(GetOperations<F>())
+        {
+            if constexpr (IsInline<F>)
+                new (_storage) F(std::forward<Callable>(callable));
+            else
+                *reinterpret_cast<F**>(_storage) = new F(std::forward<Callable>(callable));
+        }
+
+        TaskHandler(TaskHandler&& right) noexcept : _operations(right._operations)
+        {
+            if (_operations)
+                _operations->Move(right._storage, _storage);
+
+            right._operations = nullptr;
+        }
+
+        TaskHandler(TaskHandler const&) = delete;
+        TaskHandler& operator= (TaskHandler const&) = delete;
+        TaskHandler& operator= (TaskHandler&&) = delete;
+
+        ~TaskHandler()
+        {
+            if (_operations)
+                _operations->Destroy(_storage);
+        }
+
+        void operator()(TaskContext& context)
+        {
+            _operations->Invoke(_storage, context);
+        }
+    };
+
     // Task handle type
-    typedef std::function<void(TaskContext)> task_handler_t;
+    typedef TaskHandler task_handler_t;
     // Predicate type
     typedef std::function<bool()> predicate_t;
     // Success handle type
@@ -72,36 +166,44 @@ class WH_COMMON_API TaskScheduler
         duration_t _duration;
         std::optional<group_t> _group;
         repeated_t _repeated;
+        // Order of tasks with same end, set when the task is queued
+        uint64 _sequence;
+        // Counts invocations, contexts of previous invocations are consumed
+        uint32 _invocation;
+        // Context of current invocation was consumed
+        bool _consumed;
         task_handler_t _task;
 
     public:
         // All Argument construct
         Task(timepoint_t const& end, duration_t const& duration, std::optional<group_t> const& group,
-             repeated_t const repeated, task_handler_t const& task)
-            : _end(end), _duration(duration), _group(group), _repeated(repeated), _task(task) { }
+             repeated_t const repeated, task_handler_t&& task)
+            : _end(end), _duration(duration), _group(group), _repeated(repeated), _sequence(0),
+              _invocation(0), _consumed(true), _task(std::move(task)) { }
 
         // Minimal Argument construct
-        Task(timepoint_t const& end, duration_t const& duration, task_handler_t const& task)
-            : _end(end), _duration(duration), _group(std::nullopt), _repeated(0), _task(task) { }
+        Task(timepoint_t const& end, duration_t const& duration, task_handler_t&& task)
+            : _end(end), _duration(duration), _group(std::nullopt), _repeated(0), _sequence(0),
+              _invocation(0), _consumed(true), _task(std::move(task)) { }
 
         // Copy construct
         Task(Task const&) = delete;
         // Move construct
         Task(Task&&) = delete;
         // Copy Assign
-        Task& operator= (Task const&) = default;
+        Task& operator= (Task const&) = delete;
         // Move Assign
         Task& operator= (Task&& right) = delete;
 
-        // Order tasks by its end
+        // Order tasks by its end, tasks with same end are ordered by time of queueing
         inline bool operator< (Task const& other) const
         {
-            return _end < other._end;
+            return _end < other._end || (_end == other._end && _sequence < other._sequence);
         }
 
         inline bool operator> (Task const& other) const
         {
-            return _end > other._end;
+            return other < *this;
         }
 
         // Compare tasks with its end
@@ -119,18 +221,81 @@ class WH_COMMON_API TaskScheduler
 
     typedef std::shared_ptr<Task> TaskContainer;
 
+    /// Free list of task blocks, owned by the scheduler and by all allocated tasks,
+    /// so tasks held by TaskContext can outlive the scheduler. Not thread safe, like the scheduler itself.
+    class WH_COMMON_API TaskPool
+    {
+        struct FreeBlock
+        {
+            FreeBlock* Next;
+        };
+
+        FreeBlock* _free{ nullptr };
+        std::size_t _blockSize{ 0 };
+
+    public:
+        TaskPool() = default;
+        ~TaskPool();
+
+        TaskPool(TaskPool const&) = delete;
+        TaskPool& operator= (TaskPool const&) = delete;
+
+        void* Allocate(std::size_t size);
+        void Deallocate(void* block, std::size_t size);
+    };
+
+    /// Allocator used for std::allocate_shared of tasks, task and its control block share one pooled block.
+    template<typename T>
+    struct TaskAllocator
+    {
+        typedef T value_type;
+
+        std::shared_ptr<TaskPool> Pool;
+
+        explicit TaskAllocator(std::shared_ptr<TaskPool> pool) : Pool(std::move(pool)) { }
+
+        template<typename U>
+        TaskAllocator(TaskAllocator<U> const& right) : Pool(right.Pool) { }
+
+        T* allocate(std::size_t count)
+        {
+            return static_cast<T*>(Pool->Allocate(count * sizeof(T)));
+        }
+
+        void deallocate(T* block, std::size_t count)
+        {
+            Pool->Deallocate(block, count * sizeof(T));
+        }
+
+        template<typename U>
+        bool operator== (TaskAllocator<U> const& right) const
+        {
+            return Pool == right.Pool;
+        }
+
+        template<typename U>
+        bool operator!= (TaskAllocator<U> const& right) const
+        {
+            return Pool != right.Pool;
+        }
+    };
+
     /// Container which provides Task order, insert and reschedule operations.
+    /// Binary min heap on vector, heap front is the next task.
     struct Compare
     {
         bool operator() (TaskContainer const& left, TaskContainer const& right) const
         {
-            return (*left.get()) < (*right.get());
+            return (*left.get()) > (*right.get());
         };
     };
 
     class WH_COMMON_API TaskQueue
     {
-        std::multiset<TaskContainer, Compare> container;
+        std::vector<TaskContainer> container;
+
+        /// Sequence of next queued task
+        uint64 _sequence{ 0 };
 
     public:
         // Pushes the task in the container
@@ -162,6 +327,9 @@ class WH_COMMON_API TaskScheduler
     /// The Task Queue which contains all task objects.
     TaskQueue _task_holder;
 
+    /// Memory of tasks
+    std::shared_ptr<TaskPool> _pool;
+
     typedef std::queue<std::function<void()>> AsyncHolder;
 
     /// Contains all asynchronous tasks which will be invoked at
@@ -181,10 +349,12 @@ class WH_COMMON_API TaskScheduler
 
 public:
     TaskScheduler()
-        : self_reference(this, [](TaskScheduler const*) { }), _now(clock_t::now()), _predicate(EmptyValidator) { }
+        : self_reference(this, [](TaskScheduler const*) { }), _now(clock_t::now()), _pool(std::make_shared<TaskPool>()),
+          _predicate(EmptyValidator) { }
 
     template<typename P> TaskScheduler(P&& predicate)
-        : self_reference(this, [](TaskScheduler const*) { }), _now(clock_t::now()), _predicate(std::forward<P>(predicate)) { }
+        : self_reference(this, [](TaskScheduler const*) { }), _now(clock_t::now()), _pool(std::make_shared<TaskPool>()),
+          _predicate(std::forward<P>(predicate)) { }
 
     TaskScheduler(TaskScheduler const&) = delete;
     TaskScheduler(TaskScheduler&&) = delete;
@@ -229,27 +399,27 @@ public:
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
     template<class _Rep, class _Period>
     TaskScheduler& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-                            task_handler_t const& task)
+                            task_handler_t task)
     {
-        return ScheduleAt(_now, time, task);
+        return ScheduleAt(_now, time, std::move(task));
     }
 
     /// Schedule an event with a fixed rate.
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
     template<class _Rep, class _Period>
     TaskScheduler& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-                            group_t const group, task_handler_t const& task)
+                            group_t const group, task_handler_t task)
     {
-        return ScheduleAt(_now, time, group, task);
+        return ScheduleAt(_now, time, group, std::move(task));
     }
 
     /// Schedule an event with a randomized rate between min and max rate.
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
     template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
     TaskScheduler& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
-                            std::chrono::duration<_RepRight, _PeriodRight> const& max, task_handler_t const& task)
+                            std::chrono::duration<_RepRight, _PeriodRight> const& max, task_handler_t task)
     {
-        return Schedule(RandomDurationBetween(min, max), task);
+        return Schedule(RandomDurationBetween(min, max), std::move(task));
     }
 
     /// Schedule an event with a fixed rate.
@@ -257,9 +427,9 @@ public:
     template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
     TaskScheduler& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
                             std::chrono::duration<_RepRight, _PeriodRight> const& max, group_t const group,
-                            task_handler_t const& task)
+                            task_handler_t task)
     {
-        return Schedule(RandomDurationBetween(min, max), group, task);
+        return Schedule(RandomDurationBetween(min, max), group, std::move(task));
     }
 
     /// Cancels all tasks.
@@ -381,9 +551,9 @@ private:
 
     template<class _Rep, class _Period>
     TaskScheduler& ScheduleAt(timepoint_t const& end,
-                              std::chrono::duration<_Rep, _Period> const& time, task_handler_t const& task)
+                              std::chrono::duration<_Rep, _Period> const& time, task_handler_t task)
     {
-        return InsertTask(TaskContainer(new Task(end + time, time, task)));
+        return InsertTask(std::allocate_shared<Task>(TaskAllocator<Task>(_pool), end + time, time, std::move(task)));
     }
 
     /// Schedule an event with a fixed rate.
@@ -391,10 +561,10 @@ private:
     template<class _Rep, class _Period>
     TaskScheduler& ScheduleAt(timepoint_t const& end,
                               std::chrono::duration<_Rep, _Period> const& time,
-                              group_t const group, task_handler_t const& task)
+                              group_t const group, task_handler_t task)
     {
         static repeated_t const DEFAULT_REPEATED = 0;
-        return InsertTask(TaskContainer(new Task(end + time, time, group, DEFAULT_REPEATED, task)));
+        return InsertTask(std::allocate_shared<Task>(TaskAllocator<Task>(_pool), end + time, time, group, DEFAULT_REPEATED, std::move(task)));
     }
 
     // Returns a random duration between min and max
@@ -423,35 +593,48 @@ class WH_COMMON_API TaskContext
     /// Owner
     std::weak_ptr<TaskScheduler> _owner;
 
-    /// Marks the task as consumed
-    std::shared_ptr<bool> _consumed;
+    /// Invocation of the task this context belongs to,
+    /// the context is consumed when the task was repeated or invoked again.
+    uint32 _invocation;
 
     /// Dispatches an action safe on the TaskScheduler
-    TaskContext& Dispatch(std::function<TaskScheduler&(TaskScheduler&)> const& apply);
+    template<typename Apply>
+    TaskContext& Dispatch(Apply&& apply)
+    {
+        if (auto const owner = _owner.lock())
+        {
+            apply(*owner);
+        }
+
+        return *this;
+    }
 
 public:
     // Empty constructor
     TaskContext()
-        : _task(), _owner(), _consumed(std::make_shared<bool>(true)) { }
+        : _task(), _owner(), _invocation(0) { }
 
     // Construct from task and owner
     explicit TaskContext(TaskScheduler::TaskContainer&& task, std::weak_ptr<TaskScheduler>&& owner)
-        : _task(task), _owner(owner), _consumed(std::make_shared<bool>(false)) { }
+        : _task(std::move(task)), _owner(std::move(owner)), _invocation(++_task->_invocation)
+    {
+        _task->_consumed = false;
+    }
 
     // Copy construct
     TaskContext(TaskContext const& right)
-        : _task(right._task), _owner(right._owner), _consumed(right._consumed) { }
+        : _task(right._task), _owner(right._owner), _invocation(right._invocation) { }
 
     // Move construct
     TaskContext(TaskContext&& right)
-        : _task(std::move(right._task)), _owner(std::move(right._owner)), _consumed(std::move(right._consumed)) { }
+        : _task(std::move(right._task)), _owner(std::move(right._owner)), _invocation(right._invocation) { }
 
     // Copy assign
     TaskContext& operator= (TaskContext const& right)
     {
         _task = right._task;
         _owner = right._owner;
-        _consumed = right._consumed;
+        _invocation = right._invocation;
         return *this;
     }
 
@@ -460,7 +643,7 @@ public:
     {
         _task = std::move(right._task);
         _owner = std::move(right._owner);
-        _consumed = std::move(right._consumed);
+        _invocation = right._invocation;
         return *this;
     }
 
@@ -492,8 +675,11 @@ public:
         _task->_duration = duration;
         _task->_end += duration;
         _task->_repeated += 1;
-        (*_consumed) = true;
-        return Dispatch(std::bind(&TaskScheduler::InsertTask, std::placeholders::_1, _task));
+        _task->_consumed = true;
+        return Dispatch([this](TaskScheduler& scheduler) -> TaskScheduler&
+        {
+            return scheduler.InsertTask(_task);
+        });
     }
 
     /// Repeats the event with the same duration.
@@ -525,12 +711,12 @@ public:
     /// which will be called at the next update tick.
     template<class _Rep, class _Period>
     TaskContext& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-                          TaskScheduler::task_handler_t const& task)
+                          TaskScheduler::task_handler_t task)
     {
         auto const end = _task->_end;
-        return Dispatch([end, time, task](TaskScheduler & scheduler) -> TaskScheduler &
+        return Dispatch([end, &time, &task](TaskScheduler & scheduler) -> TaskScheduler &
         {
-            return scheduler.ScheduleAt<_Rep, _Period>(end, time, task);
+            return scheduler.ScheduleAt<_Rep, _Period>(end, time, std::move(task));
         });
     }
 
@@ -540,12 +726,12 @@ public:
     /// which will be called at the next update tick.
     template<class _Rep, class _Period>
     TaskContext& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-                          TaskScheduler::group_t const group, TaskScheduler::task_handler_t const& task)
+                          TaskScheduler::group_t const group, TaskScheduler::task_handler_t task)
     {
         auto const end = _task->_end;
-        return Dispatch([end, time, group, task](TaskScheduler & scheduler) -> TaskScheduler &
+        return Dispatch([end, &time, group, &task](TaskScheduler & scheduler) -> TaskScheduler &
         {
-            return scheduler.ScheduleAt<_Rep, _Period>(end, time, group, task);
+            return scheduler.ScheduleAt<_Rep, _Period>(end, time, group, std::move(task));
         });
     }
 
@@ -555,9 +741,9 @@ public:
     /// which will be called at the next update tick.
     template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
     TaskContext& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
-                          std::chrono::duration<_RepRight, _PeriodRight> const& max, TaskScheduler::task_handler_t const& task)
+                          std::chrono::duration<_RepRight, _PeriodRight> const& max, TaskScheduler::task_handler_t task)
     {
-        return Schedule(TaskScheduler::RandomDurationBetween(min, max), task);
+        return Schedule(TaskScheduler::RandomDurationBetween(min, max), std::move(task));
     }
 
     /// Schedule an event with a randomized rate between min and max rate from within the context.
@@ -567,9 +753,9 @@ public:
     template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
     TaskContext& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
                           std::chrono::duration<_RepRight, _PeriodRight> const& max, TaskScheduler::group_t const group,
-                          TaskScheduler::task_handler_t const& task)
+                          TaskScheduler::task_handler_t task)
     {
-        return Schedule(TaskScheduler::RandomDurationBetween(min, max), group, task);
+        return Schedule(TaskScheduler::RandomDurationBetween(min, max), group, std::move(task));
     }
 
     /// Cancels all tasks from within the context.
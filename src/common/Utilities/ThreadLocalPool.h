@@ -0,0 +1,192 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _THREAD_LOCAL_POOL_H_
+#define _THREAD_LOCAL_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Warhead
+{
+    /**
+     * @class ThreadLocalPool
+     *
+     * @brief Per thread free list of memory blocks for objects of type T, meant for class specific operator new/delete.
+     *
+     * Objects created and destroyed by map update threads reuse the same blocks instead of going through the heap.
+     * Block freed on another thread than it was allocated on is cached by the freeing thread.
+     * Allocations of other size than sizeof(T) (derived classes) are passed to global operator new.
+     */
+    template<class T, std::size_t MaxCachedBlocks = 256>
+    class ThreadLocalPool
+    {
+    public:
+        static void* Allocate(std::size_t size)
+        {
+            if (size == sizeof(T))
+            {
+                if (Cache* cache = GetCache(); cache && !cache->Blocks.empty())
+                {
+                    void* block = cache->Blocks.back();
+                    cache->Blocks.pop_back();
+                    return block;
+                }
+            }
+
+            return ::operator new(size);
+        }
+
+        static void Deallocate(void* block, std::size_t size)
+        {
+            if (!block)
+                return;
+
+            if (size == sizeof(T))
+            {
+                if (Cache* cache = GetCache(); cache && cache->Blocks.size() < MaxCachedBlocks)
+                {
+                    cache->Blocks.push_back(block);
+                    return;
+                }
+            }
+
+            ::operator delete(block);
+        }
+
+        static std::size_t GetCachedBlocks()
+        {
+            Cache* cache = GetCache();
+            return cache ? cache->Blocks.size() : 0;
+        }
+
+    private:
+        struct Cache
+        {
+            Cache() { Blocks.reserve(MaxCachedBlocks); }
+
+            ~Cache()
+            {
+                for (void* block : Blocks)
+                    ::operator delete(block);
+
+                Destroyed() = true;
+            }
+
+            std::vector<void*> Blocks;
+        };
+
+        // Objects destroyed after the cache of exiting thread was destroyed go straight to the heap
+        static bool& Destroyed()
+        {
+            thread_local bool destroyed = false;
+            return destroyed;
+        }
+
+        static Cache* GetCache()
+        {
+            if (Destroyed())
+                return nullptr;
+
+            thread_local Cache cache;
+            return &cache;
+        }
+    };
+
+    /**
+     * @class ScratchVector
+     *
+     * @brief Empty std::vector<T> borrowed from per thread pool, returned to the pool with its capacity on destruction.
+     *
+     * Replaces temporary containers of hot paths which are filled and thrown away many times per update,
+     * and containers of short lived objects like spell target lists.
+     * Nested scratch vectors of the same type are different vectors, so borrowing is reentrant.
+     */
+    template<class T, std::size_t MaxKeptCapacity = 1024, class Allocator = std::allocator<T>>
+    class ScratchVector
+    {
+    public:
+        using VectorType = std::vector<T, Allocator>;
+
+        ScratchVector() : _vector(Acquire()) { }
+        ~ScratchVector() { Release(std::move(_vector)); }
+
+        ScratchVector(ScratchVector const&) = delete;
+        ScratchVector& operator=(ScratchVector const&) = delete;
+
+        VectorType& operator*() { return _vector; }
+        VectorType* operator->() { return &_vector; }
+        VectorType const& operator*() const { return _vector; }
+        VectorType const* operator->() const { return &_vector; }
+
+    private:
+        struct Pool
+        {
+            ~Pool() { Destroyed() = true; }
+
+            std::vector<VectorType> Vectors;
+        };
+
+        // Vectors released after the pool of exiting thread was destroyed are freed
+        static bool& Destroyed()
+        {
+            thread_local bool destroyed = false;
+            return destroyed;
+        }
+
+        static Pool* GetPool()
+        {
+            if (Destroyed())
+                return nullptr;
+
+            thread_local Pool pool;
+            return &pool;
+        }
+
+        static VectorType Acquire()
+        {
+            Pool* pool = GetPool();
+            if (!pool || pool->Vectors.empty())
+                return {};
+
+            VectorType vector = std::move(pool->Vectors.back());
+            pool->Vectors.pop_back();
+            return vector;
+        }
+
+        static void Release(VectorType&& vector)
+        {
+            // don't keep memory of one huge search forever
+            if (vector.capacity() > MaxKeptCapacity)
+                return;
+
+            Pool* pool = GetPool();
+            if (!pool)
+                return;
+
+            vector.clear();
+            pool->Vectors.push_back(std::move(vector));
+        }
+
+        VectorType _vector;
+    };
+}
+
+#endif // _THREAD_LOCAL_POOL_H_
@@ -23,16 +23,14 @@
 
 namespace AuthHelper
 {
-    constexpr static uint32 MAX_PRE_BC_CLIENT_BUILD = 6141;
-
     bool IsPreBCAcceptedClientBuild(uint32 build)
     {
-        return build <= MAX_PRE_BC_CLIENT_BUILD && sRealmList->GetBuildInfo(build);
+        return build <= RealmList::MAX_PRE_BC_CLIENT_BUILD && sRealmList->GetBuildInfo(build);
     }
 
     bool IsPostBCAcceptedClientBuild(uint32 build)
     {
-        return build > MAX_PRE_BC_CLIENT_BUILD && sRealmList->GetBuildInfo(build);
+        return build > RealmList::MAX_PRE_BC_CLIENT_BUILD && sRealmList->GetBuildInfo(build);
     }
 
     bool IsAcceptedClientBuild(uint32 build)
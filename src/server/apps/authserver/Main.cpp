@@ -26,6 +26,7 @@
 * authentication server
 */
 
+#include "AuthCryptoPool.h"
 #include "AuthSocketMgr.h"
 #include "Config.h"
 #include "DatabaseEnv.h"
@@ -149,7 +150,7 @@ int main(int argc, char** argv)
 
     std::shared_ptr<void> sRealmListHandle(nullptr, [](void*) { sRealmList->Close(); });
 
-    if (sRealmList->GetRealms().empty())
+    if (sRealmList->GetRealms()->empty())
     {
         LOG_ERROR("server.authserver", "No valid realms specified.");
         return 1;
@@ -162,6 +163,25 @@ int main(int argc, char** argv)
         return 0;
     }
 
+    // Start threads for SRP6 math of logons
+    int32 cryptoThreads = sConfigMgr->GetOption<int32>("CryptoWorkerThreads", 2);
+    if (cryptoThreads < 0 || cryptoThreads > 64)
+    {
+        LOG_ERROR("server.authserver", "CryptoWorkerThreads ({}) must be in range 0..64. Using 2 instead", cryptoThreads);
+        cryptoThreads = 2;
+    }
+
+    int32 cryptoMaxQueue = sConfigMgr->GetOption<int32>("CryptoWorkerMaxQueue", 1000);
+    if (cryptoMaxQueue < 0)
+    {
+        LOG_ERROR("server.authserver", "CryptoWorkerMaxQueue ({}) must be >= 0. Using 1000 instead", cryptoMaxQueue);
+        cryptoMaxQueue = 1000;
+    }
+
+    sAuthCryptoPool->Initialize(uint32(cryptoThreads), uint32(cryptoMaxQueue));
+
+    std::shared_ptr<void> sAuthCryptoPoolHandle(nullptr, [](void*) { sAuthCryptoPool->Close(); });
+
     // Start the listening port (acceptor) for auth connections
     auto port = sConfigMgr->GetOption<int32>("RealmServerPort", 3724);
     if (port < 0 || port > 0xFFFF)
@@ -0,0 +1,86 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuthCryptoPool.h"
+#include "Log.h"
+#include "ThreadPool.h"
+
+bool AuthCryptoCallback::InvokeIfReady()
+{
+    if (_future.valid() && _future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        _future.get();
+        _callback();
+        return true;
+    }
+
+    return false;
+}
+
+AuthCryptoPool* AuthCryptoPool::instance()
+{
+    static AuthCryptoPool instance;
+    return &instance;
+}
+
+AuthCryptoPool::~AuthCryptoPool() = default;
+
+void AuthCryptoPool::Initialize(uint32 threads, uint32 maxQueued)
+{
+    _maxQueued = maxQueued;
+
+    if (threads)
+        _pool = std::make_unique<Warhead::ThreadPool>(threads);
+
+    LOG_INFO("server.authserver", "Using {} crypto threads for logons, at most {} logons queued", threads, maxQueued);
+}
+
+void AuthCryptoPool::Close()
+{
+    if (_pool)
+        _pool->Wait();
+
+    _pool.reset();
+}
+
+Optional<AuthCryptoCallback> AuthCryptoPool::Post(std::function<void()>&& work, std::function<void()>&& callback)
+{
+    if (!_pool)
+    {
+        std::promise<void> done;
+        work();
+        done.set_value();
+        return AuthCryptoCallback(done.get_future(), std::move(callback));
+    }
+
+    if (_queued.fetch_add(1, std::memory_order_relaxed) >= _maxQueued && _maxQueued)
+    {
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    auto task = std::make_shared<std::packaged_task<void()>>([this, work = std::move(work)]()
+    {
+        work();
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+    });
+
+    std::future<void> future = task->get_future();
+    _pool->PostWork([task]() { (*task)(); });
+
+    return AuthCryptoCallback(std::move(future), std::move(callback));
+}
@@ -0,0 +1,79 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _AUTH_CRYPTO_POOL_H_
+#define _AUTH_CRYPTO_POOL_H_
+
+#include "Define.h"
+#include "Optional.h"
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace Warhead
+{
+    class ThreadPool;
+}
+
+// Callback of work posted to AuthCryptoPool, invoked by session update after work is done
+class AuthCryptoCallback
+{
+public:
+    AuthCryptoCallback(std::future<void>&& future, std::function<void()>&& callback) :
+        _future(std::move(future)), _callback(std::move(callback)) { }
+
+    AuthCryptoCallback(AuthCryptoCallback&&) = default;
+    AuthCryptoCallback& operator=(AuthCryptoCallback&&) = default;
+
+    bool InvokeIfReady();
+
+private:
+    AuthCryptoCallback(AuthCryptoCallback const&) = delete;
+    AuthCryptoCallback& operator=(AuthCryptoCallback const&) = delete;
+
+    std::future<void> _future;
+    std::function<void()> _callback;
+};
+
+// Threads for SRP6 math of logons, so network threads are not blocked by BigNumber operations during login storms
+class AuthCryptoPool
+{
+public:
+    static AuthCryptoPool* instance();
+
+    void Initialize(uint32 threads, uint32 maxQueued);
+    void Close();
+
+    // Work must not use session, it may be closed before work is done.
+    // Returns nothing when too many logons are queued, work is done at once when pool has no threads
+    Optional<AuthCryptoCallback> Post(std::function<void()>&& work, std::function<void()>&& callback);
+
+    [[nodiscard]] uint32 GetQueuedCount() const { return _queued.load(std::memory_order_relaxed); }
+
+private:
+    AuthCryptoPool() = default;
+    ~AuthCryptoPool();
+
+    std::unique_ptr<Warhead::ThreadPool> _pool;
+    std::atomic<uint32> _queued{};
+    uint32 _maxQueued{};
+};
+
+#define sAuthCryptoPool AuthCryptoPool::instance()
+
+#endif // _AUTH_CRYPTO_POOL_H_
@@ -34,7 +34,6 @@
 #include "TOTP.h"
 #include "Timer.h"
 #include "Util.h"
-#include <boost/lexical_cast.hpp>
 
 using boost::asio::ip::tcp;
 
@@ -167,7 +166,7 @@ void AccountInfo::LoadResult(Field* fields)
 }
 
 AuthSession::AuthSession(tcp::socket&& socket) :
-    Socket(std::move(socket)), _status(STATUS_CHALLENGE), _build(0), _expversion(0) { }
+    Socket(std::move(socket)), _status(STATUS_CHALLENGE), _build(0), _expversion(0), _characterCountsQueried(false) { }
 
 void AuthSession::Start()
 {
@@ -204,6 +203,7 @@ bool AuthSession::Update()
         return false;
 
     _queryProcessor.ProcessReadyCallbacks();
+    _cryptoProcessor.ProcessReadyCallbacks();
     return true;
 }
 
@@ -434,50 +434,78 @@ void AuthSession::LogonChallengeCallback(PreparedQueryResult result)
         }
     }
 
-    _srp6.emplace(_accountInfo.Login,
-        fields[12].Get<Binary, Warhead::Crypto::SRP6::SALT_LENGTH>(),
-        fields[13].Get<Binary, Warhead::Crypto::SRP6::VERIFIER_LENGTH>());
+    if (!AuthHelper::IsAcceptedClientBuild(_build))
+    {
+        pkt << uint8(WOW_FAIL_VERSION_INVALID);
+        SendPacket(pkt);
+        return;
+    }
 
-    // Fill the response packet with the result
-    if (AuthHelper::IsAcceptedClientBuild(_build))
+    // B = 3v + g^b is calculated by crypto thread
+    auto srp6 = std::make_shared<std::shared_ptr<Warhead::Crypto::SRP6>>();
+    auto work = [srp6, login = _accountInfo.Login, salt = fields[12].Get<Binary, Warhead::Crypto::SRP6::SALT_LENGTH>(),
+        verifier = fields[13].Get<Binary, Warhead::Crypto::SRP6::VERIFIER_LENGTH>()]()
     {
-        pkt << uint8(WOW_SUCCESS);
+        *srp6 = std::make_shared<Warhead::Crypto::SRP6>(login, salt, verifier);
+    };
 
-        pkt.append(_srp6->B);
-        pkt << uint8(1);
-        pkt.append(_srp6->g);
-        pkt << uint8(32);
-        pkt.append(_srp6->N);
-        pkt.append(_srp6->s);
-        pkt.append(VersionChallenge.data(), VersionChallenge.size());
-        pkt << uint8(securityFlags);            // security flags (0x0...0x04)
-
-        if (securityFlags & 0x01)               // PIN input
-        {
-            pkt << uint32(0);
-            pkt << uint64(0) << uint64(0);      // 16 bytes hash?
-        }
+    Optional<AuthCryptoCallback> callback = sAuthCryptoPool->Post(std::move(work), [this, srp6, securityFlags]()
+    {
+        LogonChallengeCryptoCallback(*srp6, securityFlags);
+    });
 
-        if (securityFlags & 0x02)               // Matrix input
-        {
-            pkt << uint8(0);
-            pkt << uint8(0);
-            pkt << uint8(0);
-            pkt << uint8(0);
-            pkt << uint64(0);
-        }
+    if (!callback)
+    {
+        pkt << uint8(WOW_FAIL_DB_BUSY);
+        SendPacket(pkt);
+        LOG_DEBUG("server.authserver", "'{}:{}' [AuthChallenge] account {} rejected, too many logons are queued", ipAddress, port, _accountInfo.Login);
+        return;
+    }
+
+    _cryptoProcessor.AddCallback(std::move(*callback));
+}
 
-        if (securityFlags & 0x04)               // Security token input
-            pkt << uint8(1);
+void AuthSession::LogonChallengeCryptoCallback(std::shared_ptr<Warhead::Crypto::SRP6> srp6, uint8 securityFlags)
+{
+    _srp6 = std::move(srp6);
 
-        LOG_DEBUG("server.authserver", "'{}:{}' [AuthChallenge] account {} is using '{}' locale ({})",
-            ipAddress, port, _accountInfo.Login, _localizationName, GetLocaleByName(_localizationName));
+    // Fill the response packet with the result
+    ByteBuffer pkt;
+    pkt << uint8(AUTH_LOGON_CHALLENGE);
+    pkt << uint8(0x00);
+    pkt << uint8(WOW_SUCCESS);
 
-        _status = STATUS_LOGON_PROOF;
+    pkt.append(_srp6->B);
+    pkt << uint8(1);
+    pkt.append(_srp6->g);
+    pkt << uint8(32);
+    pkt.append(_srp6->N);
+    pkt.append(_srp6->s);
+    pkt.append(VersionChallenge.data(), VersionChallenge.size());
+    pkt << uint8(securityFlags);            // security flags (0x0...0x04)
+
+    if (securityFlags & 0x01)               // PIN input
+    {
+        pkt << uint32(0);
+        pkt << uint64(0) << uint64(0);      // 16 bytes hash?
     }
-    else
-        pkt << uint8(WOW_FAIL_VERSION_INVALID);
 
+    if (securityFlags & 0x02)               // Matrix input
+    {
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint64(0);
+    }
+
+    if (securityFlags & 0x04)               // Security token input
+        pkt << uint8(1);
+
+    LOG_DEBUG("server.authserver", "'{}:{}' [AuthChallenge] account {} is using '{}' locale ({})",
+        GetRemoteIpAddress().to_string(), GetRemotePort(), _accountInfo.Login, _localizationName, GetLocaleByName(_localizationName));
+
+    _status = STATUS_LOGON_PROOF;
     SendPacket(pkt);
 }
 
@@ -498,20 +526,56 @@ bool AuthSession::HandleLogonProof()
         return false;
     }
 
+    // Packet is copied, read buffer is reused before crypto thread is done
+    auto proof = std::make_shared<LogonProofInfo>();
+    proof->A = logonProof->A;
+    proof->ClientM = logonProof->clientM;
+    proof->CrcHash = logonProof->crc_hash;
+    proof->SecurityFlags = logonProof->securityFlags;
+
+    if ((proof->SecurityFlags & 0x04) && _totpSecret)
+    {
+        uint8 size = *(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C));
+        proof->Token.emplace(reinterpret_cast<char*>(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C) + sizeof(size)), size);
+        GetReadBuffer().ReadCompleted(sizeof(size) + size);
+    }
+
+    // Check if SRP6 results match (password is correct) in crypto thread
+    Optional<AuthCryptoCallback> callback = sAuthCryptoPool->Post([proof, srp6 = _srp6]()
+    {
+        proof->Key = srp6->VerifyChallengeResponse(proof->A, proof->ClientM);
+    },
+    [this, proof]()
+    {
+        LogonProofCryptoCallback(*proof);
+    });
+
+    if (!callback)
+    {
+        ByteBuffer packet;
+        packet << uint8(AUTH_LOGON_PROOF);
+        packet << uint8(WOW_FAIL_DB_BUSY);
+        packet << uint16(0);    // LoginFlags, 1 has account message
+        SendPacket(packet);
+        return true;
+    }
+
+    _cryptoProcessor.AddCallback(std::move(*callback));
+    return true;
+}
+
+void AuthSession::LogonProofCryptoCallback(LogonProofInfo const& logonProof)
+{
     // Check if SRP6 results match (password is correct), else send an error
-    if (Optional<SessionKey> K = _srp6->VerifyChallengeResponse(logonProof->A, logonProof->clientM))
+    if (logonProof.Key)
     {
-        _sessionKey = *K;
+        _sessionKey = *logonProof.Key;
         // Check auth token
         bool tokenSuccess = false;
-        bool sentToken = (logonProof->securityFlags & 0x04);
+        bool sentToken = (logonProof.SecurityFlags & 0x04);
         if (sentToken && _totpSecret)
         {
-            uint8 size = *(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C));
-            std::string token(reinterpret_cast<char*>(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C) + sizeof(size)), size);
-            GetReadBuffer().ReadCompleted(sizeof(size) + size);
-
-            uint32 incomingToken = *Warhead::StringTo<uint32>(token);
+            uint32 incomingToken = Warhead::StringTo<uint32>(logonProof.Token.value_or("")).value_or(0);
             tokenSuccess = Warhead::Crypto::TOTP::ValidateToken(*_totpSecret, incomingToken);
             memset(_totpSecret->data(), 0, _totpSecret->size());
         }
@@ -525,16 +589,16 @@ bool AuthSession::HandleLogonProof()
             packet << uint8(WOW_FAIL_UNKNOWN_ACCOUNT);
             packet << uint16(0);    // LoginFlags, 1 has account message
             SendPacket(packet);
-            return true;
+            return;
         }
 
-        if (!VerifyVersion(logonProof->A.data(), logonProof->A.size(), logonProof->crc_hash, false))
+        if (!VerifyVersion(logonProof.A.data(), logonProof.A.size(), logonProof.CrcHash, false))
         {
             ByteBuffer packet;
             packet << uint8(AUTH_LOGON_PROOF);
             packet << uint8(WOW_FAIL_VERSION_INVALID);
             SendPacket(packet);
-            return true;
+            return;
         }
 
         LOG_DEBUG("server.authserver", "'{}:{}' User '{}' successfully authenticated", GetRemoteIpAddress().to_string(), GetRemotePort(), _accountInfo.Login);
@@ -548,7 +612,7 @@ bool AuthSession::HandleLogonProof()
         AuthDatabase.DirectExecute(stmt);
 
         // Finish SRP6 and send the final result to the client
-        Warhead::Crypto::SHA1::Digest M2 = Warhead::Crypto::SRP6::GetSessionVerifier(logonProof->A, logonProof->clientM, _sessionKey);
+        Warhead::Crypto::SHA1::Digest M2 = Warhead::Crypto::SRP6::GetSessionVerifier(logonProof.A, logonProof.ClientM, _sessionKey);
 
         ByteBuffer packet;
         if (_expversion & POST_BC_EXP_FLAG)                 // 2.x and 3.x clients
@@ -578,6 +642,8 @@ bool AuthSession::HandleLogonProof()
 
         SendPacket(packet);
         _status = STATUS_AUTHED;
+
+        QueryCharacterCounts();
     }
     else
     {
@@ -633,8 +699,6 @@ bool AuthSession::HandleLogonProof()
             }
         }
     }
-
-    return true;
 }
 
 bool AuthSession::HandleReconnectChallenge()
@@ -735,6 +799,8 @@ bool AuthSession::HandleReconnectProof()
         pkt << uint16(0);    // LoginFlags, 1 has account message
         SendPacket(pkt);
         _status = STATUS_AUTHED;
+
+        QueryCharacterCounts();
         return true;
     }
     else
@@ -749,87 +815,77 @@ bool AuthSession::HandleRealmList()
 {
     LOG_DEBUG("server.authserver", "Entering _HandleRealmList");
 
+    // Character counts are queried right after authentication and again for every later realm list,
+    // characters may be created or deleted on world servers between client refreshes
+    if (!_characterCounts)
+    {
+        _status = STATUS_WAITING_FOR_REALM_LIST;
+
+        if (!_characterCountsQueried)
+            QueryCharacterCounts();
+
+        return true;
+    }
+
+    SendRealmList();
+    return true;
+}
+
+void AuthSession::QueryCharacterCounts()
+{
     AuthDatabasePreparedStatement stmt = AuthDatabase.GetPreparedStatement(LOGIN_SEL_REALM_CHARACTER_COUNTS);
     stmt->SetArguments(_accountInfo.Id);
 
-    _queryProcessor.AddCallback(AuthDatabase.AsyncQuery(stmt).WithPreparedCallback(std::bind(&AuthSession::RealmListCallback, this, std::placeholders::_1)));
-    _status = STATUS_WAITING_FOR_REALM_LIST;
-    return true;
+    _characterCountsQueried = true;
+    _queryProcessor.AddCallback(AuthDatabase.AsyncQuery(stmt).WithPreparedCallback(std::bind(&AuthSession::CharacterCountsCallback, this, std::placeholders::_1)));
 }
 
-void AuthSession::RealmListCallback(PreparedQueryResult result)
+void AuthSession::CharacterCountsCallback(PreparedQueryResult result)
 {
-    std::map<uint32, uint8> characterCounts;
+    _characterCountsQueried = false;
+    _characterCounts.emplace();
+
     if (result)
     {
         do
         {
-            auto const& [_accID, _count] = result->FetchTuple<uint32, uint8>();
-            characterCounts[_accID] = _count;
+            auto const& [_realmID, _count] = result->FetchTuple<uint32, uint8>();
+            (*_characterCounts)[_realmID] = _count;
         } while (result->NextRow());
     }
 
-    // Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
-    ByteBuffer pkt;
-
-    size_t RealmListSize = 0;
-    for (auto const& [realmHandle, realm] : sRealmList->GetRealms())
-    {
-        // don't work with realms which not compatible with the client
-        bool okBuild = ((_expversion & POST_BC_EXP_FLAG) && realm.Build == _build) || ((_expversion & PRE_BC_EXP_FLAG) && !AuthHelper::IsPreBCAcceptedClientBuild(realm.Build));
-
-        // No SQL injection. id of realm is controlled by the database.
-        uint32 flag = realm.Flags;
-        RealmBuildInfo const* buildInfo = sRealmList->GetBuildInfo(realm.Build);
-        if (!okBuild)
-        {
-            if (!buildInfo)
-                continue;
+    if (_status == STATUS_WAITING_FOR_REALM_LIST)
+        SendRealmList();
+}
 
-            flag |= REALM_FLAG_OFFLINE | REALM_FLAG_SPECIFYBUILD;   // tell the client what build the realm is for
-        }
+void AuthSession::SendRealmList()
+{
+    bool postBC = _expversion & POST_BC_EXP_FLAG;
 
-        if (!buildInfo)
-            flag &= ~REALM_FLAG_SPECIFYBUILD;
+    // Realm parts which don't depend on account are built once per client build by RealmList
+    std::shared_ptr<RealmListPacket const> realmList = sRealmList->GetRealmListPacket(_build, postBC);
 
-        std::string name = realm.Name;
-        if (_expversion & PRE_BC_EXP_FLAG && flag & REALM_FLAG_SPECIFYBUILD)
-        {
-            std::ostringstream ss;
-            ss << name << " (" << buildInfo->MajorVersion << '.' << buildInfo->MinorVersion << '.' << buildInfo->BugfixVersion << ')';
-            name = ss.str();
-        }
+    ByteBuffer pkt;
 
+    for (RealmListPacketEntry const& realm : realmList->Realms)
+    {
         uint8 lock = (realm.AllowedSecurityLevel > _accountInfo.SecurityLevel) ? 1 : 0;
 
+        auto itr = _characterCounts->find(realm.Id.Realm);
+        uint8 characterCount = itr != _characterCounts->end() ? itr->second : 0;
+
         pkt << uint8(realm.Type);                           // realm type
-        if (_expversion & POST_BC_EXP_FLAG)                 // only 2.x and 3.x clients
+        if (postBC)                                         // only 2.x and 3.x clients
             pkt << uint8(lock);                             // if 1, then realm locked
 
-        pkt << uint8(flag);                                 // RealmFlags
-        pkt << name;
-        pkt << boost::lexical_cast<std::string>(realm.GetAddressForClient(GetRemoteIpAddress()));
-        pkt << float(realm.PopulationLevel);
-        pkt << uint8(characterCounts[realm.Id.Realm]);
-        pkt << uint8(realm.Timezone);                       // realm category
-
-        if (_expversion & POST_BC_EXP_FLAG)                 // 2.x and 3.x clients
-            pkt << uint8(realm.Id.Realm);
-        else
-            pkt << uint8(0x0);                              // 1.12.1 and 1.12.2 clients
-
-        if (_expversion & POST_BC_EXP_FLAG && flag & REALM_FLAG_SPECIFYBUILD)
-        {
-            pkt << uint8(buildInfo->MajorVersion);
-            pkt << uint8(buildInfo->MinorVersion);
-            pkt << uint8(buildInfo->BugfixVersion);
-            pkt << uint16(buildInfo->Build);
-        }
-
-        ++RealmListSize;
+        pkt.append(realm.FlagsAndName);                     // RealmFlags and name
+        pkt << realm.GetAddressForClient(GetRemoteIpAddress());
+        pkt.append(realm.Population);
+        pkt << uint8(characterCount);
+        pkt.append(realm.Tail);                             // realm category, id and build info
     }
 
-    if (_expversion & POST_BC_EXP_FLAG)                     // 2.x and 3.x clients
+    if (postBC)                                             // 2.x and 3.x clients
     {
         pkt << uint8(0x10);
         pkt << uint8(0x00);
@@ -844,10 +900,10 @@ void AuthSession::RealmListCallback(PreparedQueryResult result)
     ByteBuffer RealmListSizeBuffer;
     RealmListSizeBuffer << uint32(0);
 
-    if (_expversion & POST_BC_EXP_FLAG)                     // only 2.x and 3.x clients
-        RealmListSizeBuffer << uint16(RealmListSize);
+    if (postBC)                                             // only 2.x and 3.x clients
+        RealmListSizeBuffer << uint16(realmList->Realms.size());
     else
-        RealmListSizeBuffer << uint32(RealmListSize);
+        RealmListSizeBuffer << uint32(realmList->Realms.size());
 
     ByteBuffer hdr;
     hdr << uint8(REALM_LIST);
@@ -856,6 +912,8 @@ void AuthSession::RealmListCallback(PreparedQueryResult result)
     hdr.append(pkt);                                        // append realms in the realmlist
     SendPacket(hdr);
 
+    // Next realm list queries counts again
+    _characterCounts.reset();
     _status = STATUS_AUTHED;
 }
 
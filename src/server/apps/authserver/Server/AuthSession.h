@@ -19,6 +19,7 @@
 #define __AUTHSESSION_H__
 
 #include "AsyncCallbackProcessor.h"
+#include "AuthCryptoPool.h"
 #include "ByteBuffer.h"
 #include "Common.h"
 #include "DatabaseEnvFwd.h"
@@ -26,6 +27,7 @@
 #include "SRP6.h"
 #include "Socket.h"
 #include <boost/asio/ip/tcp.hpp>
+#include <map>
 #include <memory>
 
 using boost::asio::ip::tcp;
@@ -58,6 +60,17 @@ struct AccountInfo
     AccountTypes SecurityLevel = SEC_PLAYER;
 };
 
+// Logon proof data kept until crypto thread verified it
+struct LogonProofInfo
+{
+    Warhead::Crypto::SRP6::EphemeralKey A;
+    Warhead::Crypto::SHA1::Digest ClientM;
+    Warhead::Crypto::SHA1::Digest CrcHash;
+    uint8 SecurityFlags;
+    Optional<std::string> Token;
+    Optional<SessionKey> Key;   // set by crypto thread when password is correct
+};
+
 class AuthSession : public Socket<AuthSession>
 {
     typedef Socket<AuthSession> AuthSocket;
@@ -84,12 +97,17 @@ private:
 
     void CheckIpCallback(PreparedQueryResult result);
     void LogonChallengeCallback(PreparedQueryResult result);
+    void LogonChallengeCryptoCallback(std::shared_ptr<Warhead::Crypto::SRP6> srp6, uint8 securityFlags);
+    void LogonProofCryptoCallback(LogonProofInfo const& logonProof);
     void ReconnectChallengeCallback(PreparedQueryResult result);
-    void RealmListCallback(PreparedQueryResult result);
+    void CharacterCountsCallback(PreparedQueryResult result);
+
+    void QueryCharacterCounts();
+    void SendRealmList();
 
     bool VerifyVersion(uint8 const* a, int32 aLength, Warhead::Crypto::SHA1::Digest const& versionProof, bool isReconnect);
 
-    Optional<Warhead::Crypto::SRP6> _srp6;
+    std::shared_ptr<Warhead::Crypto::SRP6> _srp6;
     SessionKey _sessionKey = {};
     std::array<uint8, 16> _reconnectProof = {};
 
@@ -102,7 +120,12 @@ private:
     uint16 _build;
     uint8 _expversion;
 
+    // Queried when authed and for each later realm list, used by one realm list only
+    Optional<std::map<uint32, uint8>> _characterCounts;
+    bool _characterCountsQueried;
+
     QueryCallbackProcessor _queryProcessor;
+    AsyncCallbackProcessor<AuthCryptoCallback> _cryptoProcessor;
 };
 
 #pragma pack(push, 1)
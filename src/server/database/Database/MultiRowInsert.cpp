@@ -0,0 +1,44 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MultiRowInsert.h"
+#include "Errors.h"
+#include "Transaction.h"
+
+MultiRowInsert::MultiRowInsert(SQLTransaction trans, std::string_view statement, uint32 maxRows /*= DEFAULT_MAX_ROWS*/)
+    : _trans(std::move(trans)), _statement(statement), _maxRows(maxRows ? maxRows : 1)
+{
+    ASSERT(_trans);
+    _query = _statement;
+}
+
+MultiRowInsert::~MultiRowInsert()
+{
+    Flush();
+}
+
+void MultiRowInsert::Flush()
+{
+    if (!_rows)
+        return;
+
+    _trans->Append(std::string_view(_query));
+    ++_queries;
+
+    _rows = 0;
+    _query = _statement;
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MULTI_ROW_INSERT_H
+#define _MULTI_ROW_INSERT_H
+
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+#include <fmt/format.h>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/// Coalesces rows into "INSERT INTO table (columns) VALUES (...), (...)" raw queries of a transaction.
+/// Values are written without escaping, so only numeric values are allowed.
+/// Pending rows are appended to the transaction when row limit is reached, on Flush and on destruction,
+/// statements appended before and after keep their order relative to the coalesced query.
+class WH_DATABASE_API MultiRowInsert
+{
+public:
+    static constexpr uint32 DEFAULT_MAX_ROWS = 256;
+
+    /// statement: "INSERT INTO table (columns)", also REPLACE and INSERT IGNORE can be used
+    MultiRowInsert(SQLTransaction trans, std::string_view statement, uint32 maxRows = DEFAULT_MAX_ROWS);
+    ~MultiRowInsert();
+
+    MultiRowInsert(MultiRowInsert const&) = delete;
+    MultiRowInsert& operator=(MultiRowInsert const&) = delete;
+
+    template<typename... Args>
+    void AddRow(Args... values)
+    {
+        static_assert(sizeof...(Args) > 0 && (std::is_arithmetic_v<Args> && ...), "Only numeric values can be inserted without escaping");
+
+        _query += _rows ? ",(" : " VALUES (";
+
+        bool first = true;
+        ((AppendValue(values, first)), ...);
+
+        _query += ')';
+
+        if (++_rows >= _maxRows)
+            Flush();
+    }
+
+    /// Appends pending rows to the transaction as single query
+    void Flush();
+
+    /// Number of queries appended to the transaction
+    [[nodiscard]] uint32 GetQueryCount() const { return _queries; }
+
+private:
+    template<typename T>
+    void AppendValue(T value, bool& first)
+    {
+        if (!first)
+            _query += ',';
+
+        first = false;
+
+        if constexpr (std::is_same_v<T, bool>)
+            _query += value ? '1' : '0';
+        else
+            fmt::format_to(std::back_inserter(_query), "{}", value);
+    }
+
+    SQLTransaction _trans;
+    std::string _statement;
+    std::string _query;
+    uint32 _maxRows;
+    uint32 _rows{ 0 };
+    uint32 _queries{ 0 };
+};
+
+#endif
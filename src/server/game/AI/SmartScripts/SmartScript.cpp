@@ -35,6 +35,8 @@
 #include "SmartAI.h"
 #include "SpellMgr.h"
 #include "Vehicle.h"
+#include <algorithm>
+#include <functional>
 
 /// @todo: this import is not necessary for compilation and marked as unused by the IDE
 //  however, for some reasons removing it would cause a damn linking issue
@@ -57,6 +59,10 @@ SmartScript::SmartScript()
     mScriptType = SMART_SCRIPT_TYPE_CREATURE;
     isProcessingTimedActionList = false;
 
+    mTimerClock = 0;
+    mTimerPhase = 0;
+    mTimerEngaged = false;
+
     // Xinef: Fix Combat Movement
     mActualCombatDist = 0;
     mMaxCombatDist = 0;
@@ -84,8 +90,8 @@ void SmartScript::OnReset()
     {
         if (!((*i).event.event_flags & SMART_EVENT_FLAG_DONT_RESET))
         {
-            InitTimer((*i));
             (*i).runOnce = false;
+            InitTimer((*i));
         }
     }
     ProcessEventsFor(SMART_EVENT_RESET);
@@ -1841,13 +1847,12 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             ac.type = (SMART_ACTION)SMART_ACTION_TRIGGER_TIMED_EVENT;
             ac.timeEvent.id = e.action.timeEvent.id;
 
-            SmartScriptHolder ev = SmartScriptHolder();
+            SmartScriptDefinition ev = SmartScriptDefinition();
             ev.event = ne;
             ev.event_id = e.action.timeEvent.id;
             ev.target = e.target;
             ev.action = ac;
-            InitTimer(ev);
-            mStoredEvents.push_back(ev);
+            InitTimer(mStoredEvents.emplace_back(ev).Holder);
             break;
         }
         case SMART_ACTION_TRIGGER_TIMED_EVENT:
@@ -1960,7 +1965,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 break;
 
             ObjectVector casters;
-            GetTargets(casters, CreateSmartEvent(SMART_EVENT_UPDATE_IC, 0, 0, 0, 0, 0, 0, 0, SMART_ACTION_NONE, 0, 0, 0, 0, 0, 0, (SMARTAI_TARGETS)e.action.crossCast.targetType, e.action.crossCast.targetParam1, e.action.crossCast.targetParam2, e.action.crossCast.targetParam3, 0, 0), unit);
+            GetTargets(casters, SmartScriptHolder(CreateSmartEvent(SMART_EVENT_UPDATE_IC, 0, 0, 0, 0, 0, 0, 0, SMART_ACTION_NONE, 0, 0, 0, 0, 0, 0, (SMARTAI_TARGETS)e.action.crossCast.targetType, e.action.crossCast.targetParam1, e.action.crossCast.targetParam2, e.action.crossCast.targetParam3, 0, 0)), unit);
 
             for (WorldObject* caster : casters)
             {
@@ -3013,7 +3018,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 case 3: // Target parameters
                 {
                     ObjectVector facingTargets;
-                    GetTargets(facingTargets, CreateSmartEvent(SMART_EVENT_UPDATE_IC, 0, 0, 0, 0, 0, 0, 0, SMART_ACTION_NONE, 0, 0, 0, 0, 0, 0, (SMARTAI_TARGETS)e.action.orientationTarget.targetType, e.action.orientationTarget.targetParam1, e.action.orientationTarget.targetParam2, e.action.orientationTarget.targetParam3, e.action.orientationTarget.targetParam4, 0), unit);
+                    GetTargets(facingTargets, SmartScriptHolder(CreateSmartEvent(SMART_EVENT_UPDATE_IC, 0, 0, 0, 0, 0, 0, 0, SMART_ACTION_NONE, 0, 0, 0, 0, 0, 0, (SMARTAI_TARGETS)e.action.orientationTarget.targetType, e.action.orientationTarget.targetParam1, e.action.orientationTarget.targetParam2, e.action.orientationTarget.targetParam3, e.action.orientationTarget.targetParam4, 0)), unit);
 
                     for (WorldObject* facingTarget : facingTargets)
                         for (WorldObject* target : targets)
@@ -3033,9 +3038,14 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
     if (e.link && e.link != e.event_id)
     {
-        SmartScriptHolder linked = FindLinkedEvent(e.link);
-        if (linked.GetActionType() && linked.GetEventType() == SMART_EVENT_LINK)
+        SmartScriptHolder const* linkedEvent = FindLinkedEvent(e.link);
+        if (linkedEvent && linkedEvent->GetActionType() && linkedEvent->GetEventType() == SMART_EVENT_LINK)
+        {
+            // linked event is processed on copy, its state is not kept
+            SmartScriptHolder linked = *linkedEvent;
+            linked.timerSlot = SmartScriptHolder::NO_TIMER_SLOT;
             ProcessEvent(linked, unit, var0, var1, bvar, spell, gob);
+        }
         else
             LOG_ERROR("db.query", "SmartScript::ProcessAction: Entry {} SourceType {}, Event {}, Link Event {} not found or invalid, skipped.", e.entryOrGuid, e.GetScriptType(), e.event_id, e.link);
     }
@@ -3132,12 +3142,13 @@ void SmartScript::InstallTemplate(SmartScriptHolder const& e)
 
 void SmartScript::AddEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, uint32 event_param5, uint32 event_param6, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 target_param4, uint32 phaseMask)
 {
-    mInstallEvents.push_back(CreateSmartEvent(e, event_flags, event_param1, event_param2, event_param3, event_param4, event_param5, event_param6, action, action_param1, action_param2, action_param3, action_param4, action_param5, action_param6, t, target_param1, target_param2, target_param3, target_param4, phaseMask));
+    mInstalledDefinitions.push_back(CreateSmartEvent(e, event_flags, event_param1, event_param2, event_param3, event_param4, event_param5, event_param6, action, action_param1, action_param2, action_param3, action_param4, action_param5, action_param6, t, target_param1, target_param2, target_param3, target_param4, phaseMask));
+    InitTimer(mInstallEvents.emplace_back(mInstalledDefinitions.back()));
 }
 
-SmartScriptHolder SmartScript::CreateSmartEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, uint32 event_param5, uint32 event_param6, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 target_param4, uint32 phaseMask)
+SmartScriptDefinition SmartScript::CreateSmartEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, uint32 event_param5, uint32 event_param6, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 target_param4, uint32 phaseMask)
 {
-    SmartScriptHolder script;
+    SmartScriptDefinition script;
     script.event.type = e;
     script.event.raw.param1 = event_param1;
     script.event.raw.param2 = event_param2;
@@ -3164,7 +3175,6 @@ SmartScriptHolder SmartScript::CreateSmartEvent(SMART_EVENT e, uint32 event_flag
     script.target.raw.param4 = target_param4;
 
     script.source_type = SMART_SCRIPT_TYPE_CREATURE;
-    InitTimer(script);
     return script;
 }
 
@@ -4540,6 +4550,7 @@ void SmartScript::InitTimer(SmartScriptHolder& e)
             break;
         default:
             e.active = true;
+            ScheduleTimer(e);
             break;
     }
 }
@@ -4548,6 +4559,7 @@ void SmartScript::RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max)
     // min/max was checked at loading!
     e.timer = urand(uint32(min), uint32(max));
     e.active = e.timer ? false : true;
+    ScheduleTimer(e);
 }
 
 void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
@@ -4555,85 +4567,209 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
     if (e.GetEventType() == SMART_EVENT_LINK)
         return;
 
-    if (e.event.event_phase_mask && !IsInPhase(e.event.event_phase_mask))
+    if (!IsTimerRunning(e, mEventPhase, me && me->IsEngaged()))//can be used with me=nullptr (go script)
         return;
 
-    if (e.GetEventType() == SMART_EVENT_UPDATE_IC && (!me || !me->IsEngaged()))
+    if (e.timer < diff)
+        ProcessTimer(e);
+    else
+        e.timer -= diff;
+}
+
+void SmartScript::ProcessTimer(SmartScriptHolder& e)
+{
+    // delay spell cast for another AI tick if another spell is being cast
+    if (e.GetActionType() == SMART_ACTION_CAST)
+    {
+        if (!(e.action.cast.castFlags & SMARTCAST_INTERRUPT_PREVIOUS))
+        {
+            if (me && me->HasUnitState(UNIT_STATE_CASTING))
+            {
+                e.timer = 1200;
+                ScheduleTimer(e);
+                return;
+            }
+        }
+    }
+
+    // Delay flee for assist event if casting
+    if (e.GetActionType() == SMART_ACTION_FLEE_FOR_ASSIST && me && me->HasUnitState(UNIT_STATE_CASTING))
+    {
+        e.timer = 1200;
+        ScheduleTimer(e);
         return;
+    } // @TODO: Can't these be handled by the action themselves instead? Less expensive
 
-    if (e.GetEventType() == SMART_EVENT_UPDATE_OOC && (me && me->IsEngaged()))//can be used with me=nullptr (go script)
+    e.active = true;//activate events with cooldown
+    if (!IsTimedEvent(e.GetEventType()))//process ONLY timed events
         return;
 
-    if (e.timer < diff)
+    ProcessEvent(e);
+    if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
     {
-        // delay spell cast for another AI tick if another spell is being cast
-        if (e.GetActionType() == SMART_ACTION_CAST)
+        e.enableTimed = false;//disable event if it is in an ActionList and was processed once
+        for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
         {
-            if (!(e.action.cast.castFlags & SMARTCAST_INTERRUPT_PREVIOUS))
+            //find the first event which is not the current one and enable it
+            if (i->event_id > e.event_id)
             {
-                if (me && me->HasUnitState(UNIT_STATE_CASTING))
-                {
-                    e.timer = 1200;
-                    return;
-                }
+                i->enableTimed = true;
+                break;
             }
         }
+    }
+}
+
+/*static*/ bool SmartScript::IsTimedEvent(uint32 eventType)
+{
+    switch (eventType)
+    {
+        case SMART_EVENT_NEAR_PLAYERS:
+        case SMART_EVENT_NEAR_PLAYERS_NEGATION:
+        case SMART_EVENT_NEAR_UNIT:
+        case SMART_EVENT_NEAR_UNIT_NEGATION:
+        case SMART_EVENT_UPDATE:
+        case SMART_EVENT_UPDATE_OOC:
+        case SMART_EVENT_UPDATE_IC:
+        case SMART_EVENT_HEALTH_PCT:
+        case SMART_EVENT_TARGET_HEALTH_PCT:
+        case SMART_EVENT_MANA_PCT:
+        case SMART_EVENT_TARGET_MANA_PCT:
+        case SMART_EVENT_RANGE:
+        case SMART_EVENT_AREA_RANGE:
+        case SMART_EVENT_VICTIM_CASTING:
+        case SMART_EVENT_AREA_CASTING:
+        case SMART_EVENT_FRIENDLY_HEALTH:
+        case SMART_EVENT_FRIENDLY_IS_CC:
+        case SMART_EVENT_FRIENDLY_MISSING_BUFF:
+        case SMART_EVENT_HAS_AURA:
+        case SMART_EVENT_TARGET_BUFFED:
+        case SMART_EVENT_IS_BEHIND_TARGET:
+        case SMART_EVENT_FRIENDLY_HEALTH_PCT:
+        case SMART_EVENT_DISTANCE_CREATURE:
+        case SMART_EVENT_DISTANCE_GAMEOBJECT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*static*/ bool SmartScript::IsTimerRunning(SmartScriptHolder const& e, uint32 phase, bool engaged)
+{
+    if (e.event.event_phase_mask && (!phase || !((1 << (phase - 1)) & e.event.event_phase_mask)))
+        return false;
+
+    if (e.GetEventType() == SMART_EVENT_UPDATE_IC && !engaged)
+        return false;
+
+    if (e.GetEventType() == SMART_EVENT_UPDATE_OOC && engaged)
+        return false;
+
+    return true;
+}
+
+/*static*/ bool SmartScript::NeedsTimerUpdate(SmartScriptHolder const& e)
+{
+    if (e.GetEventType() == SMART_EVENT_LINK)
+        return false;
+
+    // not repeatable timed event is never processed again, until reset
+    if (IsTimedEvent(e.GetEventType()))
+        return !((e.event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE) && e.runOnce);
+
+    // other events only wait for end of cooldown
+    return !e.active;
+}
+
+void SmartScript::ScheduleTimer(SmartScriptHolder& e)
+{
+    if (e.timerSlot == SmartScriptHolder::NO_TIMER_SLOT)
+        return;
+
+    // entries already in queue are skipped by generation
+    ++e.timerGeneration;
+    e.timerQueued = false;
+
+    if (!NeedsTimerUpdate(e) || !IsTimerRunning(e, mTimerPhase, mTimerEngaged))
+        return;
+
+    e.timerQueued = true;
+    e.timerDueTime = mTimerClock + e.timer;
+
+    mTimerQueue.push_back({ e.timerDueTime, e.timerSlot, e.timerGeneration });
+    std::push_heap(mTimerQueue.begin(), mTimerQueue.end(), std::greater<>());
+}
+
+void SmartScript::UpdateTimerRunState()
+{
+    bool engaged = me && me->IsEngaged();
+    if (mEventPhase == mTimerPhase && engaged == mTimerEngaged)
+        return;
+
+    mTimerPhase = mEventPhase;
+    mTimerEngaged = engaged;
+
+    for (SmartScriptHolder& e : mEvents)
+    {
+        bool running = IsTimerRunning(e, mTimerPhase, mTimerEngaged);
+
+        if (e.timerQueued && !running)
+        {
+            // keep remaining time until timer runs again
+            e.timer = e.timerDueTime > mTimerClock ? uint32(e.timerDueTime - mTimerClock) : 0;
+            ScheduleTimer(e);
+        }
+        else if (!e.timerQueued && running && NeedsTimerUpdate(e))
+            ScheduleTimer(e);
+    }
+}
+
+void SmartScript::UpdateDueTimers()
+{
+    // due timers are processed in order of events, same as they are stored in database
+    mDueTimers.clear();
+
+    while (!mTimerQueue.empty() && mTimerQueue.front().DueTime < mTimerClock)
+    {
+        std::pop_heap(mTimerQueue.begin(), mTimerQueue.end(), std::greater<>());
+        TimerQueueEntry entry = mTimerQueue.back();
+        mTimerQueue.pop_back();
+
+        if (entry.Generation == mEvents[entry.Slot].timerGeneration)
+            mDueTimers.emplace_back(entry.Slot, entry.Generation);
+    }
+
+    if (mDueTimers.empty())
+        return;
+
+    std::sort(mDueTimers.begin(), mDueTimers.end());
+
+    for (auto const& [slot, generation] : mDueTimers)
+    {
+        SmartScriptHolder& e = mEvents[slot];
+
+        // rescheduled by event processed before
+        if (e.timerGeneration != generation)
+            continue;
+
+        // phase or combat state changed by event processed before, queue is updated at next update
+        if (!IsTimerRunning(e, mEventPhase, me && me->IsEngaged()))
+        {
+            mTimerQueue.push_back({ e.timerDueTime, e.timerSlot, e.timerGeneration });
+            std::push_heap(mTimerQueue.begin(), mTimerQueue.end(), std::greater<>());
+            continue;
+        }
+
+        e.timerQueued = false;
+        ProcessTimer(e);
 
-        // Delay flee for assist event if casting
-        if (e.GetActionType() == SMART_ACTION_FLEE_FOR_ASSIST && me && me->HasUnitState(UNIT_STATE_CASTING))
+        // not rescheduled, e.g. condition of event is not met, check it again at next update
+        if (e.timerGeneration == generation && NeedsTimerUpdate(e))
         {
-            e.timer = 1200;
-            return;
-        } // @TODO: Can't these be handled by the action themselves instead? Less expensive
-
-        e.active = true;//activate events with cooldown
-        switch (e.GetEventType())//process ONLY timed events
-        {
-            case SMART_EVENT_NEAR_PLAYERS:
-            case SMART_EVENT_NEAR_PLAYERS_NEGATION:
-            case SMART_EVENT_NEAR_UNIT:
-            case SMART_EVENT_NEAR_UNIT_NEGATION:
-            case SMART_EVENT_UPDATE:
-            case SMART_EVENT_UPDATE_OOC:
-            case SMART_EVENT_UPDATE_IC:
-            case SMART_EVENT_HEALTH_PCT:
-            case SMART_EVENT_TARGET_HEALTH_PCT:
-            case SMART_EVENT_MANA_PCT:
-            case SMART_EVENT_TARGET_MANA_PCT:
-            case SMART_EVENT_RANGE:
-            case SMART_EVENT_AREA_RANGE:
-            case SMART_EVENT_VICTIM_CASTING:
-            case SMART_EVENT_AREA_CASTING:
-            case SMART_EVENT_FRIENDLY_HEALTH:
-            case SMART_EVENT_FRIENDLY_IS_CC:
-            case SMART_EVENT_FRIENDLY_MISSING_BUFF:
-            case SMART_EVENT_HAS_AURA:
-            case SMART_EVENT_TARGET_BUFFED:
-            case SMART_EVENT_IS_BEHIND_TARGET:
-            case SMART_EVENT_FRIENDLY_HEALTH_PCT:
-            case SMART_EVENT_DISTANCE_CREATURE:
-            case SMART_EVENT_DISTANCE_GAMEOBJECT:
-                {
-                    ProcessEvent(e);
-                    if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
-                    {
-                        e.enableTimed = false;//disable event if it is in an ActionList and was processed once
-                        for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
-                        {
-                            //find the first event which is not the current one and enable it
-                            if (i->event_id > e.event_id)
-                            {
-                                i->enableTimed = true;
-                                break;
-                            }
-                        }
-                    }
-                    break;
-                }
+            e.timer = 0;
+            ScheduleTimer(e);
         }
     }
-    else
-        e.timer -= diff;
 }
 
 bool SmartScript::CheckTimer(SmartScriptHolder const& e) const
@@ -4646,7 +4782,11 @@ void SmartScript::InstallEvents()
     if (!mInstallEvents.empty())
     {
         for (SmartAIEventList::iterator i = mInstallEvents.begin(); i != mInstallEvents.end(); ++i)
-            mEvents.push_back(*i);//must be before UpdateTimers
+        {
+            SmartScriptHolder& e = mEvents.emplace_back(*i);//must be before UpdateTimers
+            e.timerSlot = mEvents.size() - 1;
+            ScheduleTimer(e);
+        }
 
         mInstallEvents.clear();
     }
@@ -4659,8 +4799,9 @@ void SmartScript::OnUpdate(uint32 const diff)
 
     InstallEvents();//before UpdateTimers
 
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-        UpdateTimer(*i, diff);
+    UpdateTimerRunState();
+    mTimerClock += diff;
+    UpdateDueTimers();
 
     if (!mStoredEvents.empty())
     {
@@ -4668,7 +4809,7 @@ void SmartScript::OnUpdate(uint32 const diff)
         for (i = mStoredEvents.begin(); i != mStoredEvents.end();)
         {
             icurr = i++;
-            UpdateTimer(*icurr, diff);
+            UpdateTimer(icurr->Holder, diff);
         }
     }
 
@@ -4688,7 +4829,10 @@ void SmartScript::OnUpdate(uint32 const diff)
         isProcessingTimedActionList = false;
     }
     if (needCleanup)
+    {
         mTimedActionList.clear();
+        mTimedActionListProgram.reset();
+    }
 
     if (!mRemIDs.empty())
     {
@@ -4714,11 +4858,11 @@ void SmartScript::OnUpdate(uint32 const diff)
     }
 }
 
-void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger const* at)
+void SmartScript::FillScript(SmartScriptProgramPtr const& program, WorldObject* obj, AreaTrigger const* at)
 {
     (void)at; // ensure that the variable is referenced even if extra logs are disabled in order to pass compiler checks
 
-    if (e.empty())
+    if (!program || program->empty())
     {
         if (obj)
             LOG_DEBUG("db.query", "SmartScript: EventMap for Entry {} is empty but is using SmartScript.", obj->GetEntry());
@@ -4727,35 +4871,36 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger c
             LOG_DEBUG("db.query", "SmartScript: EventMap for AreaTrigger {} is empty but is using SmartScript.", at->entry);
         return;
     }
-    for (SmartAIEventList::iterator i = e.begin(); i != e.end(); ++i)
+
+    mPrograms.push_back(program);
+    mEvents.reserve(mEvents.size() + program->size());
+
+    for (SmartScriptDefinition const& definition : *program)
     {
 #ifndef WARHEAD_DEBUG
-        if ((*i).event.event_flags & SMART_EVENT_FLAG_DEBUG_ONLY)
+        if (definition.event.event_flags & SMART_EVENT_FLAG_DEBUG_ONLY)
             continue;
 #endif
 
-        if ((*i).event.event_flags & SMART_EVENT_FLAG_DIFFICULTY_ALL)//if has instance flag add only if in it
+        if (definition.event.event_flags & SMART_EVENT_FLAG_DIFFICULTY_ALL)//if has instance flag add only if in it
         {
-            if (obj && obj->GetMap()->IsDungeon())
-            {
-                if ((1 << (obj->GetMap()->GetSpawnMode() + 1)) & (*i).event.event_flags)
-                {
-                    mEvents.push_back((*i));
-                }
-            }
-            continue;
+            if (!obj || !obj->GetMap()->IsDungeon() || !((1 << (obj->GetMap()->GetSpawnMode() + 1)) & definition.event.event_flags))
+                continue;
         }
-        mEvents.push_back((*i));//NOTE: 'world(0)' events still get processed in ANY instance mode
+
+        //NOTE: 'world(0)' events still get processed in ANY instance mode
+        SmartScriptHolder& e = mEvents.emplace_back(definition);
+        e.timerSlot = mEvents.size() - 1;
     }
 }
 
 void SmartScript::GetScript()
 {
-    SmartAIEventList e;
+    SmartScriptProgramPtr e;
     if (me)
     {
         e = sSmartScriptMgr->GetScript(-((int32)me->GetSpawnId()), mScriptType);
-        if (e.empty())
+        if (!e)
             e = sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
 
         FillScript(e, me, nullptr);
@@ -4772,7 +4917,7 @@ void SmartScript::GetScript()
     else if (go)
     {
         e = sSmartScriptMgr->GetScript(-((int32)go->GetSpawnId()), mScriptType);
-        if (e.empty())
+        if (!e)
             e = sSmartScriptMgr->GetScript((int32)go->GetEntry(), mScriptType);
         FillScript(e, go, nullptr);
     }
@@ -4984,21 +5129,18 @@ void SmartScript::SetScript9(SmartScriptHolder& e, uint32 entry)
     }
 
     mTimedActionList.clear();
-    mTimedActionList = sSmartScriptMgr->GetScript(entry, SMART_SCRIPT_TYPE_TIMED_ACTIONLIST);
-    if (mTimedActionList.empty())
+    mTimedActionListProgram = sSmartScriptMgr->GetTimedActionList(entry, e.action.timedActionList.timerType);
+    if (!mTimedActionListProgram)
         return;
-    for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
-    {
-        i->enableTimed = i == mTimedActionList.begin();//enable processing only for the first action
 
-        if (e.action.timedActionList.timerType == 0)
-            i->event.type = SMART_EVENT_UPDATE_OOC;
-        else if (e.action.timedActionList.timerType == 1)
-            i->event.type = SMART_EVENT_UPDATE_IC;
-        else if (e.action.timedActionList.timerType > 1)
-            i->event.type = SMART_EVENT_UPDATE;
+    mTimedActionList.reserve(mTimedActionListProgram->size());
+
+    for (SmartScriptDefinition const& definition : *mTimedActionListProgram)
+    {
+        SmartScriptHolder& action = mTimedActionList.emplace_back(definition);
+        action.enableTimed = mTimedActionList.size() == 1;//enable processing only for the first action
 
-        InitTimer((*i));
+        InitTimer(action);
     }
 }
 
@@ -29,20 +29,20 @@ public:
 
     void OnInitialize(WorldObject* obj, AreaTrigger const* at = nullptr);
     void GetScript();
-    void FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger const* at);
+    void FillScript(SmartScriptProgramPtr const& program, WorldObject* obj, AreaTrigger const* at);
 
     void ProcessEventsFor(SMART_EVENT e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
     void ProcessEvent(SmartScriptHolder& e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
     bool CheckTimer(SmartScriptHolder const& e) const;
-    static void RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max);
+    void RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max);
     void UpdateTimer(SmartScriptHolder& e, uint32 diff);
-    static void InitTimer(SmartScriptHolder& e);
+    void InitTimer(SmartScriptHolder& e);
     void ProcessAction(SmartScriptHolder& e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
     void ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
     void GetTargets(ObjectVector& targets, SmartScriptHolder const& e, Unit* invoker = nullptr) const;
     void GetWorldObjectsInDist(ObjectVector& objects, float dist) const;
     void InstallTemplate(SmartScriptHolder const& e);
-    static SmartScriptHolder CreateSmartEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, uint32 event_param5, uint32 event_param6, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 target_param4, uint32 phaseMask);
+    static SmartScriptDefinition CreateSmartEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, uint32 event_param5, uint32 event_param6, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 target_param4, uint32 phaseMask);
     void AddEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, uint32 event_param5, uint32 event_param6, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 target_param4, uint32 phaseMask);
     void SetPathId(uint32 id) { mPathId = id; }
     uint32 GetPathId() const { return mPathId; }
@@ -138,6 +138,11 @@ private:
     void SetPhase(uint32 p);
     bool IsInPhase(uint32 p) const;
 
+    // scripts used by mEvents, kept alive after reload of smart scripts
+    std::vector<SmartScriptProgramPtr> mPrograms;
+    std::list<SmartScriptDefinition> mInstalledDefinitions;
+    SmartScriptProgramPtr mTimedActionListProgram;
+
     SmartAIEventList mEvents;
     SmartAIEventList mInstallEvents;
     SmartAIEventList mTimedActionList;
@@ -177,13 +182,42 @@ private:
     SMARTAI_TEMPLATE mTemplate;
     void InstallEvents();
 
+    // Timers of mEvents are kept in queue ordered by due time, so only due events are touched every update.
+    // Timers stop in wrong phase and for update ic / ooc events in wrong combat state, queue is updated
+    // when phase or combat state differs from the one seen at last update.
+    struct TimerQueueEntry
+    {
+        uint64 DueTime;
+        uint32 Slot;
+        uint32 Generation;
+
+        bool operator>(TimerQueueEntry const& right) const
+        {
+            return DueTime != right.DueTime ? DueTime > right.DueTime : Slot > right.Slot;
+        }
+    };
+
+    static bool IsTimedEvent(uint32 eventType);
+    static bool IsTimerRunning(SmartScriptHolder const& e, uint32 phase, bool engaged);
+    static bool NeedsTimerUpdate(SmartScriptHolder const& e);
+    void ScheduleTimer(SmartScriptHolder& e);
+    void UpdateTimerRunState();
+    void UpdateDueTimers();
+    void ProcessTimer(SmartScriptHolder& e);
+
+    std::vector<TimerQueueEntry> mTimerQueue;
+    std::vector<std::pair<uint32, uint32>> mDueTimers;
+    uint64 mTimerClock;
+    uint32 mTimerPhase;
+    bool mTimerEngaged;
+
     void RemoveStoredEvent(uint32 id)
     {
         if (!mStoredEvents.empty())
         {
             for (SmartAIEventStoredList::iterator i = mStoredEvents.begin(); i != mStoredEvents.end(); ++i)
             {
-                if (i->event_id == id)
+                if (i->Holder.event_id == id)
                 {
                     mStoredEvents.erase(i);
                     return;
@@ -192,21 +226,13 @@ private:
         }
     }
 
-    SmartScriptHolder FindLinkedEvent (uint32 link)
+    SmartScriptHolder const* FindLinkedEvent(uint32 link) const
     {
-        if (!mEvents.empty())
-        {
-            for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-            {
-                if (i->event_id == link)
-                {
-                    return (*i);
-                }
-            }
-        }
+        for (SmartScriptHolder const& e : mEvents)
+            if (e.event_id == link)
+                return &e;
 
-        SmartScriptHolder s;
-        return s;
+        return nullptr;
     }
 
     GuidUnorderedSet _summonList;
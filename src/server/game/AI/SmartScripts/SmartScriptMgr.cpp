@@ -131,7 +131,9 @@ void SmartAIMgr::LoadSmartAIFromDB()
     StopWatch sw;
 
     for (uint8 i = 0; i < SMART_SCRIPT_TYPE_MAX; i++)
-        mEventMap[i].clear();  //Drop Existing SmartAI List
+        mEventMap[i].clear();  //Drop Existing SmartAI List, objects running old scripts keep them
+
+    mTimedActionLists.clear();
 
     WorldDatabasePreparedStatement stmt = WorldDatabase.GetPreparedStatement(WORLD_SEL_SMART_SCRIPTS);
     PreparedQueryResult result = WorldDatabase.Query(stmt);
@@ -144,12 +146,13 @@ void SmartAIMgr::LoadSmartAIFromDB()
     }
 
     uint32 count = 0;
+    std::unordered_map<int32, SmartScriptProgram> programs[SMART_SCRIPT_TYPE_MAX];
 
     do
     {
         auto fields = result->Fetch();
 
-        SmartScriptHolder temp;
+        SmartScriptDefinition temp;
 
         temp.entryOrGuid = fields[0].Get<int32>();
         if (!temp.entryOrGuid)
@@ -288,16 +291,41 @@ void SmartAIMgr::LoadSmartAIFromDB()
                 temp.target.type = SMART_TARGET_POSITION;
 
         // creature entry / guid not found in storage, create empty event list for it and increase counters
-        if (mEventMap[source_type].find(temp.entryOrGuid) == mEventMap[source_type].end())
-        {
+        auto [program, inserted] = programs[source_type].try_emplace(temp.entryOrGuid);
+        if (inserted)
             ++count;
-            SmartAIEventList eventList;
-            mEventMap[source_type][temp.entryOrGuid] = eventList;
-        }
+
         // store the new event
-        mEventMap[source_type][temp.entryOrGuid].push_back(temp);
+        program->second.push_back(temp);
     } while (result->NextRow());
 
+    for (uint8 i = 0; i < SMART_SCRIPT_TYPE_MAX; i++)
+        for (auto& [entryOrGuid, program] : programs[i])
+            mEventMap[i].emplace(entryOrGuid, std::make_shared<SmartScriptProgram const>(std::move(program)));
+
+    // timed action lists are always started with same event type, so they are prepared once for every timer type
+    for (auto const& [entry, program] : mEventMap[SMART_SCRIPT_TYPE_TIMED_ACTIONLIST])
+    {
+        std::array<SmartScriptProgramPtr, 3>& timedActionLists = mTimedActionLists[entry];
+
+        for (uint32 timerType = 0; timerType < timedActionLists.size(); ++timerType)
+        {
+            SmartScriptProgram timedActionList = *program;
+
+            for (SmartScriptDefinition& e : timedActionList)
+            {
+                if (timerType == 0)
+                    e.event.type = SMART_EVENT_UPDATE_OOC;
+                else if (timerType == 1)
+                    e.event.type = SMART_EVENT_UPDATE_IC;
+                else
+                    e.event.type = SMART_EVENT_UPDATE;
+            }
+
+            timedActionLists[timerType] = std::make_shared<SmartScriptProgram const>(std::move(timedActionList));
+        }
+    }
+
     LOG_INFO("server.loading", ">> Loaded {} SmartAI scripts in {}", count, sw);
     LOG_INFO("server.loading", " ");
 }
@@ -354,7 +382,7 @@ void SmartAIMgr::LoadSmartAIFromDB()
     }
 }
 
-bool SmartAIMgr::IsTargetValid(SmartScriptHolder const& e)
+bool SmartAIMgr::IsTargetValid(SmartScriptDefinition const& e)
 {
     if (e.GetActionType() == SMART_ACTION_INSTALL_AI_TEMPLATE)
         return true; // AI template has special handling
@@ -478,7 +506,7 @@ bool SmartAIMgr::IsTargetValid(SmartScriptHolder const& e)
     return true;
 }
 
-bool SmartAIMgr::CheckUnusedEventParams(SmartScriptHolder const& e)
+bool SmartAIMgr::CheckUnusedEventParams(SmartScriptDefinition const& e)
 {
     size_t paramsStructSize = [&]() -> size_t
     {
@@ -599,7 +627,7 @@ bool SmartAIMgr::CheckUnusedEventParams(SmartScriptHolder const& e)
     return valid;
 }
 
-bool SmartAIMgr::CheckUnusedActionParams(SmartScriptHolder const& e)
+bool SmartAIMgr::CheckUnusedActionParams(SmartScriptDefinition const& e)
 {
     size_t paramsStructSize = [&]() -> size_t
     {
@@ -795,7 +823,7 @@ bool SmartAIMgr::CheckUnusedActionParams(SmartScriptHolder const& e)
     return valid;
 }
 
-bool SmartAIMgr::CheckUnusedTargetParams(SmartScriptHolder const& e)
+bool SmartAIMgr::CheckUnusedTargetParams(SmartScriptDefinition const& e)
 {
     size_t paramsStructSize = [&]() -> size_t
     {
@@ -859,7 +887,7 @@ bool SmartAIMgr::CheckUnusedTargetParams(SmartScriptHolder const& e)
     return valid;
 }
 
-bool SmartAIMgr::IsEventValid(SmartScriptHolder& e)
+bool SmartAIMgr::IsEventValid(SmartScriptDefinition& e)
 {
     if ((e.event.type >= SMART_EVENT_TC_END && e.event.type <= SMART_EVENT_AC_START) || e.event.type >= SMART_EVENT_AC_END)
     {
@@ -1958,7 +1986,7 @@ bool SmartAIMgr::IsEventValid(SmartScriptHolder& e)
     return true;
 }
 
-bool SmartAIMgr::IsTextValid(SmartScriptHolder const& e, uint32 id)
+bool SmartAIMgr::IsTextValid(SmartScriptDefinition const& e, uint32 id)
 {
     if (e.GetScriptType() != SMART_SCRIPT_TYPE_CREATURE)
         return true;
@@ -26,6 +26,8 @@
 #include "Spell.h"
 #include "SpellMgr.h"
 #include "Unit.h"
+#include <array>
+#include <memory>
 
 typedef uint32 SAIBool;
 
@@ -1883,11 +1885,11 @@ enum SmartFollowType
 };
 
 // one line in DB is one event
-struct SmartScriptHolder
+// Event as loaded from `smart_scripts`, shared by all objects running the script
+struct SmartScriptDefinition
 {
-    SmartScriptHolder() : entryOrGuid(0), source_type(SMART_SCRIPT_TYPE_CREATURE)
-        , event_id(0), link(0), event(), action(), target(), timer(0), active(false), runOnce(false)
-        , enableTimed(false) {}
+    SmartScriptDefinition() : entryOrGuid(0), source_type(SMART_SCRIPT_TYPE_CREATURE)
+        , event_id(0), link(0), event(), action(), target() {}
 
     int32 entryOrGuid;
     SmartScriptType source_type;
@@ -1898,6 +1900,31 @@ struct SmartScriptHolder
     SmartAction action;
     SmartTarget target;
 
+public:
+    uint32 GetScriptType() const { return (uint32)source_type; }
+    uint32 GetEventType() const { return (uint32)event.type; }
+    uint32 GetActionType() const { return (uint32)action.type; }
+    uint32 GetTargetType() const { return (uint32)target.type; }
+};
+
+// Event of single object, only timer and repeat state are stored per object
+struct SmartScriptHolder
+{
+    static constexpr uint32 NO_TIMER_SLOT = uint32(-1);
+
+    explicit SmartScriptHolder(SmartScriptDefinition const& definition) : entryOrGuid(definition.entryOrGuid), source_type(definition.source_type)
+        , event_id(definition.event_id), link(definition.link), event(definition.event), action(definition.action), target(definition.target)
+        , timer(0), active(false), runOnce(false), enableTimed(false), timerQueued(false), timerSlot(NO_TIMER_SLOT), timerGeneration(0), timerDueTime(0) {}
+
+    int32 entryOrGuid;
+    SmartScriptType source_type;
+    uint32 event_id;
+    uint32 link;
+
+    SmartEvent const& event;
+    SmartAction const& action;
+    SmartTarget const& target;
+
 public:
     uint32 GetScriptType() const { return (uint32)source_type; }
     uint32 GetEventType() const { return (uint32)event.type; }
@@ -1908,6 +1935,24 @@ public:
     bool active;
     bool runOnce;
     bool enableTimed;
+
+    // timer queue of SmartScript, only events of main event list have slot
+    bool timerQueued;
+    uint32 timerSlot;
+    uint32 timerGeneration;
+    uint64 timerDueTime;
+};
+
+// Event created by SMART_ACTION_CREATE_TIMED_EVENT, owns its definition
+struct SmartScriptStoredEvent
+{
+    explicit SmartScriptStoredEvent(SmartScriptDefinition const& definition) : Definition(definition), Holder(Definition) {}
+
+    SmartScriptStoredEvent(SmartScriptStoredEvent const&) = delete;
+    SmartScriptStoredEvent& operator=(SmartScriptStoredEvent const&) = delete;
+
+    SmartScriptDefinition Definition;
+    SmartScriptHolder Holder;
 };
 
 typedef std::unordered_map<uint32, WayPoint*> WPPath;
@@ -1962,12 +2007,19 @@ private:
     std::unordered_map<uint32, WPPath*> waypoint_map;
 };
 
-// all events for a single entry
+// all events for a single entry, shared by all objects using it and kept alive by them after reload
+typedef std::vector<SmartScriptDefinition> SmartScriptProgram;
+typedef std::shared_ptr<SmartScriptProgram const> SmartScriptProgramPtr;
+
+// events of single object
 typedef std::vector<SmartScriptHolder> SmartAIEventList;
-typedef std::list<SmartScriptHolder> SmartAIEventStoredList;
+typedef std::list<SmartScriptStoredEvent> SmartAIEventStoredList;
 
 // all events for all entries / guids
-typedef std::unordered_map<int32, SmartAIEventList> SmartAIEventMap;
+typedef std::unordered_map<int32, SmartScriptProgramPtr> SmartAIEventMap;
+
+// timed action list with event type set for every timer type of SMART_ACTION_CALL_TIMED_ACTIONLIST
+typedef std::unordered_map<int32, std::array<SmartScriptProgramPtr, 3>> SmartAITimedActionListMap;
 
 class WH_GAME_API SmartAIMgr
 {
@@ -1979,29 +2031,40 @@ public:
 
     void LoadSmartAIFromDB();
 
-    SmartAIEventList GetScript(int32 entry, SmartScriptType type)
+    SmartScriptProgramPtr GetScript(int32 entry, SmartScriptType type) const
     {
-        SmartAIEventList temp;
-        if (mEventMap[uint32(type)].find(entry) != mEventMap[uint32(type)].end())
-            return mEventMap[uint32(type)][entry];
-        else
-        {
-            if (entry > 0) //first search is for guid (negative), do not drop error if not found
-                LOG_DEBUG("db.query", "SmartAIMgr::GetScript: Could not load Script for Entry {} ScriptType {}.", entry, uint32(type));
-            return temp;
-        }
+        auto itr = mEventMap[uint32(type)].find(entry);
+        if (itr != mEventMap[uint32(type)].end())
+            return itr->second;
+
+        if (entry > 0) //first search is for guid (negative), do not drop error if not found
+            LOG_DEBUG("db.query", "SmartAIMgr::GetScript: Could not load Script for Entry {} ScriptType {}.", entry, uint32(type));
+
+        return nullptr;
+    }
+
+    // timerType: 0 - out of combat, 1 - in combat, 2 and more - always
+    SmartScriptProgramPtr GetTimedActionList(int32 entry, uint32 timerType) const
+    {
+        auto itr = mTimedActionLists.find(entry);
+        if (itr != mTimedActionLists.end())
+            return itr->second[std::min<uint32>(timerType, 2)];
+
+        LOG_DEBUG("db.query", "SmartAIMgr::GetTimedActionList: Could not load Script for Entry {}.", entry);
+        return nullptr;
     }
 
 private:
     //event stores
     SmartAIEventMap mEventMap[SMART_SCRIPT_TYPE_MAX];
+    SmartAITimedActionListMap mTimedActionLists;
 
     static bool EventHasInvoker(SMART_EVENT event);
 
-    bool IsEventValid(SmartScriptHolder& e);
-    bool IsTargetValid(SmartScriptHolder const& e);
+    bool IsEventValid(SmartScriptDefinition& e);
+    bool IsTargetValid(SmartScriptDefinition const& e);
 
-    /*inline bool IsTargetValid(SmartScriptHolder e, int32 target)
+    /*inline bool IsTargetValid(SmartScriptDefinition e, int32 target)
     {
         if (target < SMART_TARGET_NONE || target >= SMART_TARGET_END)
         {
@@ -2011,7 +2074,7 @@ private:
         return true;
     }*/
 
-    bool IsMinMaxValid(SmartScriptHolder const& e, uint32 min, uint32 max)
+    bool IsMinMaxValid(SmartScriptDefinition const& e, uint32 min, uint32 max)
     {
         if (max < min)
         {
@@ -2021,7 +2084,7 @@ private:
         return true;
     }
 
-    /*inline bool IsPercentValid(SmartScriptHolder e, int32 pct)
+    /*inline bool IsPercentValid(SmartScriptDefinition e, int32 pct)
     {
         if (pct < -100 || pct > 100)
         {
@@ -2031,7 +2094,7 @@ private:
         return true;
     }*/
 
-    bool NotNULL(SmartScriptHolder const& e, uint32 data)
+    bool NotNULL(SmartScriptDefinition const& e, uint32 data)
     {
         if (!data)
         {
@@ -2041,7 +2104,7 @@ private:
         return true;
     }
 
-    bool IsCreatureValid(SmartScriptHolder const& e, uint32 entry)
+    bool IsCreatureValid(SmartScriptDefinition const& e, uint32 entry)
     {
         if (!sObjectMgr->GetCreatureTemplate(entry))
         {
@@ -2051,7 +2114,7 @@ private:
         return true;
     }
 
-    bool IsQuestValid(SmartScriptHolder const& e, uint32 entry)
+    bool IsQuestValid(SmartScriptDefinition const& e, uint32 entry)
     {
         if (!sObjectMgr->GetQuestTemplate(entry))
         {
@@ -2061,7 +2124,7 @@ private:
         return true;
     }
 
-    bool IsGameObjectValid(SmartScriptHolder const& e, uint32 entry)
+    bool IsGameObjectValid(SmartScriptDefinition const& e, uint32 entry)
     {
         if (!sObjectMgr->GetGameObjectTemplate(entry))
         {
@@ -2071,7 +2134,7 @@ private:
         return true;
     }
 
-    bool IsSpellValid(SmartScriptHolder const& e, uint32 entry)
+    bool IsSpellValid(SmartScriptDefinition const& e, uint32 entry)
     {
         if (!sSpellMgr->GetSpellInfo(entry))
         {
@@ -2081,7 +2144,7 @@ private:
         return true;
     }
 
-    bool IsItemValid(SmartScriptHolder const& e, uint32 entry)
+    bool IsItemValid(SmartScriptDefinition const& e, uint32 entry)
     {
         if (!sItemStore.LookupEntry(entry))
         {
@@ -2091,7 +2154,7 @@ private:
         return true;
     }
 
-    bool IsTextEmoteValid(SmartScriptHolder const& e, uint32 entry)
+    bool IsTextEmoteValid(SmartScriptDefinition const& e, uint32 entry)
     {
         if (!sEmotesTextStore.LookupEntry(entry))
         {
@@ -2101,7 +2164,7 @@ private:
         return true;
     }
 
-    bool IsEmoteValid(SmartScriptHolder const& e, uint32 entry)
+    bool IsEmoteValid(SmartScriptDefinition const& e, uint32 entry)
     {
         if (!sEmotesStore.LookupEntry(entry))
         {
@@ -2111,7 +2174,7 @@ private:
         return true;
     }
 
-    bool IsAreaTriggerValid(SmartScriptHolder const& e, uint32 entry)
+    bool IsAreaTriggerValid(SmartScriptDefinition const& e, uint32 entry)
     {
         if (!sObjectMgr->GetAreaTrigger(entry))
         {
@@ -2121,7 +2184,7 @@ private:
         return true;
     }
 
-    bool IsSoundValid(SmartScriptHolder const& e, uint32 entry)
+    bool IsSoundValid(SmartScriptDefinition const& e, uint32 entry)
     {
         if (!sSoundEntriesStore.LookupEntry(entry))
         {
@@ -2131,10 +2194,10 @@ private:
         return true;
     }
 
-    static bool IsTextValid(SmartScriptHolder const& e, uint32 id);
-    static bool CheckUnusedEventParams(SmartScriptHolder const& e);
-    static bool CheckUnusedActionParams(SmartScriptHolder const& e);
-    static bool CheckUnusedTargetParams(SmartScriptHolder const& e);
+    static bool IsTextValid(SmartScriptDefinition const& e, uint32 id);
+    static bool CheckUnusedEventParams(SmartScriptDefinition const& e);
+    static bool CheckUnusedActionParams(SmartScriptDefinition const& e);
+    static bool CheckUnusedTargetParams(SmartScriptDefinition const& e);
 };
 
 #define sSmartScriptMgr SmartAIMgr::instance()
@@ -35,10 +35,12 @@
 #include "StopWatch.h"
 #include "UpdateTime.h"
 #include "WorldPacket.h"
+#include <algorithm>
 #include <sstream>
 #include <vector>
 
 constexpr auto AH_MINIMUM_DEPOSIT = 100;
+constexpr auto AUCTION_SEARCH_RESULT_CACHE_TIME = 30s; // max time to list next page of search
 
 // Proof of concept, we should shift the info we're obtaining in here into AuctionEntry probably
 static bool SortAuction(AuctionEntry* left, AuctionEntry* right, AuctionSortOrderVector& sortOrder, Player* player, bool checkMinBidBuyout)
@@ -185,6 +187,89 @@ static bool SortAuction(AuctionEntry* left, AuctionEntry* right, AuctionSortOrde
     return false;
 }
 
+static AuctionSearchItemInfo BuildSearchItemInfo(Item* item)
+{
+    ItemTemplate const* proto = item->GetTemplate();
+
+    AuctionSearchItemInfo info;
+    info.ItemId = proto->ItemId;
+    info.RandomPropertyId = item->GetItemRandomPropertyId();
+    info.ItemClass = uint8(proto->Class);
+    info.ItemSubClass = uint8(proto->SubClass);
+    info.InventoryType = uint8(proto->InventoryType);
+    info.Quality = uint8(proto->Quality);
+    info.RequiredLevel = uint8(std::min<uint32>(proto->RequiredLevel, 0xFF));
+    return info;
+}
+
+// Lowercase name with suffix (ie: of the Monkey) searched by players of this locale
+static std::wstring BuildSearchItemName(uint32 itemId, int32 randomPropertyId, int loc_idx, int locdbc_idx)
+{
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(itemId);
+    if (!proto || proto->Name1.empty())
+        return {};
+
+    std::string name = proto->Name1;
+
+    // local name
+    if (loc_idx > 0)
+        if (ItemLocale const* il = sGameLocale->GetItemLocale(proto->ItemId))
+            GameLocale::GetLocaleString(il->Name, loc_idx, name);
+
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+    //  that matches the search, but it may not equal item->GetItemRandomPropertyId()
+    //  used in BuildAuctionInfo() which then causes wrong items to be listed
+    if (randomPropertyId)
+    {
+        // Append the suffix to the name (ie: of the Monkey) if one exists
+        // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
+        // even though the DBC name seems misleading
+        std::array<char const*, 16> const* suffix = nullptr;
+
+        if (randomPropertyId < 0)
+        {
+            ItemRandomSuffixEntry const* itemRandEntry = sItemRandomSuffixStore.LookupEntry(-randomPropertyId);
+            if (itemRandEntry)
+                suffix = &itemRandEntry->Name;
+        }
+        else
+        {
+            ItemRandomPropertiesEntry const* itemRandEntry = sItemRandomPropertiesStore.LookupEntry(randomPropertyId);
+            if (itemRandEntry)
+                suffix = &itemRandEntry->Name;
+        }
+
+        // dbc local name
+        if (suffix)
+        {
+            // Append the suffix (i.e.: of the Monkey) to the name using localization
+            // or default enUS if localization is invalid
+            name += ' ';
+            name += (*suffix)[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
+        }
+    }
+
+    std::wstring wname;
+    if (!Utf8toWStr(name, wname))
+        return {};
+
+    wstrToLower(wname);
+    return wname;
+}
+
+static bool IsSameSearch(AuctionListItems const& left, AuctionListItems const& right)
+{
+    if (left.SearchedName != right.SearchedName || left.LevelMin != right.LevelMin || left.LevelMax != right.LevelMax ||
+        left.Usable != right.Usable || left.InventoryType != right.InventoryType || left.ItemClass != right.ItemClass ||
+        left.ItemSubClass != right.ItemSubClass || left.Quality != right.Quality || left.SortOrder.size() != right.SortOrder.size())
+        return false;
+
+    return std::equal(left.SortOrder.begin(), left.SortOrder.end(), right.SortOrder.begin(), [](AuctionSortInfo const& leftInfo, AuctionSortInfo const& rightInfo)
+    {
+        return leftInfo.SortOrder == rightInfo.SortOrder && leftInfo.IsDesc == rightInfo.IsDesc;
+    });
+}
+
 AuctionHouseObject* AuctionHouseMgr::GetAuctionsMap(uint32 factionTemplateId)
 {
     if (CONF_GET_BOOL("AllowTwoSide.Interaction.Auction"))
@@ -232,6 +317,11 @@ void AuctionHouseObject::AddAuction(std::unique_ptr<AuctionEntry>&& auction)
 
     ASSERT(auction);
     auto const [itr, isEmplace] = _auctions.emplace(auction->Id, std::move(auction));
+
+    // auctions without item are never listed by search
+    if (Item* item = sAuctionMgr->GetAuctionItem(itr->second->ItemGuid))
+        _searchIndex.Insert(itr->second.get(), BuildSearchItemInfo(item));
+
     sScriptMgr->OnAuctionAdd(this, itr->second.get());
 }
 
@@ -240,6 +330,7 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
     std::unique_lock guard(_mutex);
 
     sScriptMgr->OnAuctionRemove(this, auction);
+    _searchIndex.Remove(auction);
     return _auctions.erase(auction->Id) > 0;
 }
 
@@ -249,22 +340,32 @@ void AuctionHouseObject::Update()
 
     auto checkTime{ GameTime::GetGameTime() + 1min };
 
+    {
+        std::lock_guard<std::mutex> resultsGuard(_searchResultsLock);
+        std::erase_if(_searchResults, [now = GameTime::GetGameTime()](auto const& pair) { return pair.second.Time + AUCTION_SEARCH_RESULT_CACHE_TIME < now; });
+    }
+
     // If storage is empty, no need to update. Next == nullptr in this case.
     if (_auctions.empty())
         return;
 
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
 
-    for (auto const& [auctionID, auction] : _auctions)
+    for (auto itr = _auctions.begin(); itr != _auctions.end();)
     {
+        AuctionEntry* auction = itr->second.get();
+
         if (auction->ExpireTime > checkTime)
+        {
+            ++itr;
             continue;
+        }
 
         ///- Either cancel the auction if there was no bidder
         if (!auction->Bidder)
         {
-            sAuctionMgr->SendAuctionExpiredMail(auction.get(), trans);
-            sScriptMgr->OnAuctionExpire(this, auction.get());
+            sAuctionMgr->SendAuctionExpiredMail(auction, trans);
+            sScriptMgr->OnAuctionExpire(this, auction);
         }
         ///- Or perform the transaction
         else
@@ -272,17 +373,18 @@ void AuctionHouseObject::Update()
             //we should send an "item sold" message if the seller is online
             //we send the item to the winner
             //we send the money to the seller
-            sAuctionMgr->SendAuctionSuccessfulMail(auction.get(), trans);
-            sAuctionMgr->SendAuctionWonMail(auction.get(), trans);
-            sScriptMgr->OnAuctionSuccessful(this, auction.get());
+            sAuctionMgr->SendAuctionSuccessfulMail(auction, trans);
+            sAuctionMgr->SendAuctionWonMail(auction, trans);
+            sScriptMgr->OnAuctionSuccessful(this, auction);
         }
 
         ///- In any case clear the auction
         auction->DeleteFromDB(trans);
 
         sAuctionMgr->RemoveAItem(auction->ItemGuid);
-        sScriptMgr->OnAuctionRemove(this, auction.get());
-        _auctions.erase(auction->Id);
+        sScriptMgr->OnAuctionRemove(this, auction);
+        _searchIndex.Remove(auction);
+        itr = _auctions.erase(itr);
     }
 
     CharacterDatabase.CommitTransaction(trans);
@@ -295,6 +397,33 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPackets::AuctionHouse::ListR
     packet.ListFrom = listItems->ListFrom;
     packet.IsGetAll = listItems->GetAll == 1;
 
+    // Check if sort enabled, and the first sort column is valid, if not don't sort
+    bool sortEnabled = false;
+    bool sortByBid = false;
+
+    if (!listItems->SortOrder.empty())
+    {
+        AuctionSortInfo const& sortInfo = *listItems->SortOrder.begin();
+        sortEnabled = sortInfo.SortOrder >= AuctionSortOrder::MinLevel && sortInfo.SortOrder < AuctionSortOrder::Max && sortInfo.SortOrder != AuctionSortOrder::Unk4;
+        sortByBid = sortInfo.SortOrder == AuctionSortOrder::Bid;
+    }
+
+    auto sortAuction = std::bind(SortAuction, std::placeholders::_1, std::placeholders::_2, listItems->SortOrder, player, sortByBid);
+
+    // Next pages of the same search are listed from result sorted for first one
+    bool sorted = true;
+    if (!listItems->GetAll && listItems->ListFrom && GetCachedSearchResult(player->GetGUID(), *listItems, packet.AuctionShortlist, sorted))
+    {
+        // First page was sorted partially, sort all once player goes to next pages
+        if (sortEnabled && !sorted)
+        {
+            std::sort(packet.AuctionShortlist.begin(), packet.AuctionShortlist.end(), sortAuction);
+            CacheSearchResult(player->GetGUID(), *listItems, packet.AuctionShortlist, true);
+        }
+
+        return;
+    }
+
     if (listItems->GetAll || (listItems->IsNoFilter() && packet.WSearchedName.empty()))
     {
         ForEachAuctions([&packet](AuctionEntry* auction)
@@ -310,122 +439,105 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPackets::AuctionHouse::ListR
 
         wstrToLower(packet.WSearchedName);
 
-        ForEachAuctions([&packet, player, &listItems, curTime, loc_idx, locdbc_idx](AuctionEntry* auction)
+        std::shared_lock guard(_mutex);
+
+        // Class, subclass, inventory type, quality, level and name filters
+        _searchIndex.Search(*listItems, packet.WSearchedName, uint32(uint8(loc_idx)) | (uint32(uint8(locdbc_idx)) << 8),
+            [loc_idx, locdbc_idx](uint32 itemId, int32 randomPropertyId)
+        {
+            return BuildSearchItemName(itemId, randomPropertyId, loc_idx, locdbc_idx);
+        }, packet.AuctionShortlist);
+
+        std::erase_if(packet.AuctionShortlist, [player, &listItems, curTime](AuctionEntry* auction)
         {
             // Skip expired auctions
             if (auction->ExpireTime < curTime)
-                return;
+                return true;
 
             Item* item = sAuctionMgr->GetAuctionItem(auction->ItemGuid);
             if (!item)
-                return;
-
-            ItemTemplate const* proto = item->GetTemplate();
-            if (listItems->ItemClass != 0xffffffff && proto->Class != listItems->ItemClass)
-                return;
-
-            if (listItems->ItemSubClass != 0xffffffff && proto->SubClass != listItems->ItemSubClass)
-                return;
-
-            if (listItems->InventoryType != 0xffffffff && proto->InventoryType != listItems->InventoryType)
-            {
-                // xinef: exception, robes are counted as chests
-                if (listItems->InventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
-                    return;
-            }
-
-            if (listItems->Quality != 0xffffffff && proto->Quality < listItems->Quality)
-                return;
-
-            if (listItems->LevelMin != 0x00 && (proto->RequiredLevel < listItems->LevelMin ||
-                (listItems->LevelMax != 0x00 && proto->RequiredLevel > listItems->LevelMax)))
-                return;
+                return true;
 
             if (listItems->Usable != 0x00)
             {
                 if (player->CanUseItem(item) != EQUIP_ERR_OK)
-                    return;
+                    return true;
 
                 // xinef: check already learded recipes and pets
+                ItemTemplate const* proto = item->GetTemplate();
                 if (proto->Spells[1].SpellTrigger == ITEM_SPELLTRIGGER_LEARN_SPELL_ID && player->HasSpell(proto->Spells[1].SpellId))
-                    return;
+                    return true;
             }
 
-            // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-            // No need to do any of this if no search term was entered
-            if (!packet.WSearchedName.empty())
-            {
-                std::string name = proto->Name1;
-                if (name.empty())
-                    return;
-
-                // local name
-                if (loc_idx > 0)
-                    if (ItemLocale const* il = sGameLocale->GetItemLocale(proto->ItemId))
-                        GameLocale::GetLocaleString(il->Name, loc_idx, name);
-
-                // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-                //  that matches the search, but it may not equal item->GetItemRandomPropertyId()
-                //  used in BuildAuctionInfo() which then causes wrong items to be listed
-                int32 propRefID = item->GetItemRandomPropertyId();
-
-                if (propRefID)
-                {
-                    // Append the suffix to the name (ie: of the Monkey) if one exists
-                    // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
-                    // even though the DBC name seems misleading
-                    std::array<char const*, 16> const* suffix = nullptr;
-
-                    if (propRefID < 0)
-                    {
-                        ItemRandomSuffixEntry const* itemRandEntry = sItemRandomSuffixStore.LookupEntry(-item->GetItemRandomPropertyId());
-                        if (itemRandEntry)
-                            suffix = &itemRandEntry->Name;
-                    }
-                    else
-                    {
-                        ItemRandomPropertiesEntry const* itemRandEntry = sItemRandomPropertiesStore.LookupEntry(item->GetItemRandomPropertyId());
-                        if (itemRandEntry)
-                            suffix = &itemRandEntry->Name;
-                    }
-
-                    // dbc local name
-                    if (suffix)
-                    {
-                        // Append the suffix (i.e.: of the Monkey) to the name using localization
-                        // or default enUS if localization is invalid
-                        name += ' ';
-                        name += (*suffix)[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                    }
-                }
-
-                // Perform the search (with or without a suffix)
-                if (!Utf8FitTo(name, packet.WSearchedName))
-                    return;
-            }
-
-            packet.AuctionShortlist.emplace_back(auction);
+            return false;
         });
     }
 
     if (packet.AuctionShortlist.empty())
         return;
 
-    // Check if sort enabled, and the first sort column is valid, if not don't sort
-    if (!listItems->SortOrder.empty())
+    sorted = !sortEnabled;
+
+    if (sortEnabled)
     {
-        AuctionSortInfo const& sortInfo = *listItems->SortOrder.begin();
-        if (sortInfo.SortOrder >= AuctionSortOrder::MinLevel && sortInfo.SortOrder < AuctionSortOrder::Max && sortInfo.SortOrder != AuctionSortOrder::Unk4)
+        // Partial sort to improve performance a bit, the rest is sorted if next pages are listed from cache
+        if (listItems->ListFrom + 50 < packet.AuctionShortlist.size())
+            std::partial_sort(packet.AuctionShortlist.begin(), packet.AuctionShortlist.begin() + listItems->ListFrom + 50, packet.AuctionShortlist.end(), sortAuction);
+        else
         {
-            // Partial sort to improve performance a bit, but the last pages will burn
-            if (listItems->ListFrom + 50 <= packet.AuctionShortlist.size())
-                std::partial_sort(packet.AuctionShortlist.begin(), packet.AuctionShortlist.begin() + listItems->ListFrom + 50, packet.AuctionShortlist.end(),
-                    std::bind(SortAuction, std::placeholders::_1, std::placeholders::_2, listItems->SortOrder, player, sortInfo.SortOrder == AuctionSortOrder::Bid));
-            else
-                std::sort(packet.AuctionShortlist.begin(), packet.AuctionShortlist.end(), std::bind(SortAuction, std::placeholders::_1, std::placeholders::_2, listItems->SortOrder,
-                    player, sortInfo.SortOrder == AuctionSortOrder::Bid));
+            std::sort(packet.AuctionShortlist.begin(), packet.AuctionShortlist.end(), sortAuction);
+            sorted = true;
         }
     }
+
+    if (!packet.IsGetAll)
+        CacheSearchResult(player->GetGUID(), *listItems, packet.AuctionShortlist, sorted);
+}
+
+bool AuctionHouseObject::GetCachedSearchResult(ObjectGuid playerGuid, AuctionListItems const& search, std::vector<AuctionEntry*>& auctions, bool& sorted)
+{
+    std::vector<uint32> auctionIds;
+
+    {
+        std::lock_guard<std::mutex> resultsGuard(_searchResultsLock);
+
+        auto itr = _searchResults.find(playerGuid);
+        if (itr == _searchResults.end())
+            return false;
+
+        SearchResult const& result = itr->second;
+        if (result.Time + AUCTION_SEARCH_RESULT_CACHE_TIME < GameTime::GetGameTime() || !IsSameSearch(result.Search, search))
+            return false;
+
+        auctionIds = result.AuctionIds;
+        sorted = result.Sorted;
+    }
+
+    std::shared_lock guard(_mutex);
+
+    // auctions removed meanwhile are skipped, new ones are listed by next search
+    auctions.reserve(auctionIds.size());
+
+    for (uint32 auctionId : auctionIds)
+        if (auto auction = Warhead::Containers::MapGetValuePtr(_auctions, auctionId))
+            auctions.emplace_back(auction->get());
+
+    return true;
+}
+
+void AuctionHouseObject::CacheSearchResult(ObjectGuid playerGuid, AuctionListItems const& search, std::vector<AuctionEntry*> const& auctions, bool sorted)
+{
+    std::lock_guard<std::mutex> resultsGuard(_searchResultsLock);
+
+    SearchResult& result = _searchResults[playerGuid];
+    result.Search = search;
+    result.Time = GameTime::GetGameTime();
+    result.Sorted = sorted;
+    result.AuctionIds.clear();
+    result.AuctionIds.reserve(auctions.size());
+
+    for (AuctionEntry const* auction : auctions)
+        result.AuctionIds.emplace_back(auction->Id);
 }
 
 std::size_t AuctionHouseObject::GetCount()
@@ -587,7 +699,7 @@ void AuctionHouseMgr::SendAuctionSuccessfulMail(AuctionEntry* auction, Character
                 std::string owner_name;
                 uint8 owner_level = 0;
 
-                if (CharacterCacheEntry const *gpd_owner = sCharacterCache->GetCharacterCacheByGuid(auction->PlayerOwner))
+                if (Optional<CharacterCacheEntry> gpd_owner = sCharacterCache->GetCharacterCacheByGuid(auction->PlayerOwner))
                 {
                     owner_name = gpd_owner->Name;
                     owner_level = gpd_owner->Level;
@@ -19,11 +19,13 @@
 #define WARHEAD_AUCTION_HOUSE_MGR_H_
 
 #include "AuctionFwd.h"
+#include "AuctionSearchIndex.h"
 #include "DBCStructure.h"
 #include "DatabaseEnvFwd.h"
 #include "EventProcessor.h"
 #include "ObjectGuid.h"
 #include <functional>
+#include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
 
@@ -85,8 +87,24 @@ public:
     void BuildListAuctionItems(WorldPackets::AuctionHouse::ListResult& packet, Player* player, std::shared_ptr<AuctionListItems> listItems);
 
 private:
+    // Sorted result of last search of player, next pages of it are listed from here
+    struct SearchResult
+    {
+        AuctionListItems Search;
+        std::vector<uint32> AuctionIds;
+        Seconds Time{};
+        bool Sorted{}; // only first page is sorted until next one is listed
+    };
+
+    bool GetCachedSearchResult(ObjectGuid playerGuid, AuctionListItems const& search, std::vector<AuctionEntry*>& auctions, bool& sorted);
+    void CacheSearchResult(ObjectGuid playerGuid, AuctionListItems const& search, std::vector<AuctionEntry*> const& auctions, bool sorted);
+
     std::shared_mutex _mutex;
     std::unordered_map<uint32, std::unique_ptr<AuctionEntry>> _auctions;
+    AuctionSearchIndex _searchIndex;
+
+    std::mutex _searchResultsLock;
+    std::unordered_map<ObjectGuid, SearchResult> _searchResults;
 };
 
 class WH_GAME_API AuctionHouseMgr
@@ -0,0 +1,409 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuctionSearchIndex.h"
+#include "AuctionHouseMgr.h"
+#include "Errors.h"
+#include "ItemTemplate.h"
+#include <algorithm>
+
+namespace
+{
+    constexpr uint32 ANY_FILTER = 0xffffffff;
+    constexpr std::size_t TRIGRAM_LENGTH = 3;
+
+    uint64 MakeTrigram(wchar_t const* chars)
+    {
+        return (uint64(uint32(chars[0]) & 0x1FFFFF) << 42) | (uint64(uint32(chars[1]) & 0x1FFFFF) << 21) | uint64(uint32(chars[2]) & 0x1FFFFF);
+    }
+
+    uint64 MakeNameKey(uint32 itemId, int32 randomPropertyId)
+    {
+        return (uint64(itemId) << 32) | uint32(randomPropertyId);
+    }
+
+    std::vector<uint32>& GetList(std::vector<std::vector<uint32>>& lists, uint8 key)
+    {
+        if (key >= lists.size())
+            lists.resize(key + 1);
+
+        return lists[key];
+    }
+}
+
+void AuctionSearchIndex::Insert(AuctionEntry* auction, AuctionSearchItemInfo const& info)
+{
+    ASSERT(auction);
+
+    // re-added with other item data
+    if (_slots.contains(auction->Id))
+        Remove(auction);
+
+    uint32 slot;
+    if (!_freeEntries.empty())
+    {
+        slot = _freeEntries.back();
+        _freeEntries.pop_back();
+    }
+    else
+    {
+        slot = uint32(_entries.size());
+        _entries.emplace_back();
+    }
+
+    IndexedAuction& entry = _entries[slot];
+    entry.Auction = auction;
+    entry.Info = info;
+    entry.NameSlot = AddName(MakeNameKey(info.ItemId, info.RandomPropertyId), info.ItemId, info.RandomPropertyId);
+
+    AddToList(GetList(_byClass, info.ItemClass), slot, INDEX_CLASS);
+    AddToList(_bySubClass[uint16(info.ItemClass) << 8 | info.ItemSubClass], slot, INDEX_SUBCLASS);
+    AddToList(GetList(_byInventoryType, info.InventoryType), slot, INDEX_INVENTORY_TYPE);
+    AddToList(GetList(_byQuality, info.Quality), slot, INDEX_QUALITY);
+    AddToList(GetList(_byRequiredLevel, info.RequiredLevel), slot, INDEX_REQUIRED_LEVEL);
+    AddToList(_names[entry.NameSlot].Auctions, slot, INDEX_NAME);
+
+    _slots.emplace(auction->Id, slot);
+}
+
+void AuctionSearchIndex::Remove(AuctionEntry const* auction)
+{
+    auto itr = _slots.find(auction->Id);
+    if (itr == _slots.end())
+        return;
+
+    uint32 slot = itr->second;
+    _slots.erase(itr);
+
+    IndexedAuction& entry = _entries[slot];
+    AuctionSearchItemInfo const& info = entry.Info;
+
+    RemoveFromList(_byClass[info.ItemClass], slot, INDEX_CLASS);
+    RemoveFromList(_bySubClass[uint16(info.ItemClass) << 8 | info.ItemSubClass], slot, INDEX_SUBCLASS);
+    RemoveFromList(_byInventoryType[info.InventoryType], slot, INDEX_INVENTORY_TYPE);
+    RemoveFromList(_byQuality[info.Quality], slot, INDEX_QUALITY);
+    RemoveFromList(_byRequiredLevel[info.RequiredLevel], slot, INDEX_REQUIRED_LEVEL);
+    RemoveFromList(_names[entry.NameSlot].Auctions, slot, INDEX_NAME);
+
+    // last auction with this name
+    if (_names[entry.NameSlot].Auctions.empty())
+        RemoveName(entry.NameSlot);
+
+    entry.Auction = nullptr;
+    _freeEntries.emplace_back(slot);
+}
+
+void AuctionSearchIndex::Search(AuctionListItems const& filter, std::wstring const& lowerName, uint32 localeKey, NameBuilder const& nameBuilder, std::vector<AuctionEntry*>& result)
+{
+    // Every active filter gives lists of auctions passing it, iterate the shortest ones and check other filters per auction
+    std::vector<std::vector<uint32> const*> lists;
+    std::vector<std::vector<uint32> const*> shortestLists;
+    std::size_t shortestSize = 0;
+    bool hasIndexedFilter = false;
+
+    auto useLists = [&]()
+    {
+        std::size_t size = 0;
+        for (std::vector<uint32> const* list : lists)
+            size += list->size();
+
+        if (!hasIndexedFilter || size < shortestSize)
+        {
+            shortestLists.swap(lists);
+            shortestSize = size;
+        }
+
+        hasIndexedFilter = true;
+        lists.clear();
+    };
+
+    if (filter.ItemClass != ANY_FILTER)
+    {
+        if (filter.ItemClass >= _byClass.size())
+            return;
+
+        if (filter.ItemSubClass != ANY_FILTER)
+        {
+            auto itr = _bySubClass.find(uint16(filter.ItemClass) << 8 | uint16(filter.ItemSubClass));
+            if (filter.ItemSubClass > 0xFF || itr == _bySubClass.end())
+                return;
+
+            lists.emplace_back(&itr->second);
+        }
+        else
+            lists.emplace_back(&_byClass[filter.ItemClass]);
+
+        useLists();
+    }
+
+    if (filter.InventoryType != ANY_FILTER)
+    {
+        if (filter.InventoryType < _byInventoryType.size())
+            lists.emplace_back(&_byInventoryType[filter.InventoryType]);
+
+        // xinef: exception, robes are counted as chests
+        if (filter.InventoryType == INVTYPE_CHEST && INVTYPE_ROBE < _byInventoryType.size())
+            lists.emplace_back(&_byInventoryType[INVTYPE_ROBE]);
+
+        useLists();
+    }
+
+    if (filter.Quality != ANY_FILTER)
+    {
+        for (std::size_t quality = filter.Quality; quality < _byQuality.size(); ++quality)
+            lists.emplace_back(&_byQuality[quality]);
+
+        useLists();
+    }
+
+    if (filter.LevelMin != 0x00)
+    {
+        std::size_t levelMax = filter.LevelMax != 0x00 ? std::size_t(filter.LevelMax) : _byRequiredLevel.size();
+
+        for (std::size_t level = filter.LevelMin; level <= levelMax && level < _byRequiredLevel.size(); ++level)
+            lists.emplace_back(&_byRequiredLevel[level]);
+
+        useLists();
+    }
+
+    std::vector<bool> matchedNames;
+
+    if (!lowerName.empty())
+    {
+        std::vector<uint32> nameSlots;
+        MatchNames(lowerName, localeKey, nameBuilder, nameSlots);
+
+        matchedNames.resize(_names.size());
+
+        for (uint32 nameSlot : nameSlots)
+        {
+            matchedNames[nameSlot] = true;
+            lists.emplace_back(&_names[nameSlot].Auctions);
+        }
+
+        useLists();
+    }
+
+    auto matches = [&filter, &lowerName, &matchedNames](IndexedAuction const& entry)
+    {
+        AuctionSearchItemInfo const& info = entry.Info;
+
+        if (filter.ItemClass != ANY_FILTER && info.ItemClass != filter.ItemClass)
+            return false;
+
+        if (filter.ItemSubClass != ANY_FILTER && info.ItemSubClass != filter.ItemSubClass)
+            return false;
+
+        if (filter.InventoryType != ANY_FILTER && info.InventoryType != filter.InventoryType)
+        {
+            if (filter.InventoryType != INVTYPE_CHEST || info.InventoryType != INVTYPE_ROBE)
+                return false;
+        }
+
+        if (filter.Quality != ANY_FILTER && info.Quality < filter.Quality)
+            return false;
+
+        if (filter.LevelMin != 0x00 && (info.RequiredLevel < filter.LevelMin ||
+            (filter.LevelMax != 0x00 && info.RequiredLevel > filter.LevelMax)))
+            return false;
+
+        if (!lowerName.empty() && !matchedNames[entry.NameSlot])
+            return false;
+
+        return true;
+    };
+
+    // subclass without class, or filters checked by caller like usable items
+    if (!hasIndexedFilter)
+    {
+        result.reserve(result.size() + _slots.size());
+
+        for (IndexedAuction const& entry : _entries)
+            if (entry.Auction && matches(entry))
+                result.emplace_back(entry.Auction);
+
+        return;
+    }
+
+    result.reserve(result.size() + shortestSize);
+
+    for (std::vector<uint32> const* list : shortestLists)
+    {
+        for (uint32 slot : *list)
+        {
+            IndexedAuction const& entry = _entries[slot];
+            if (matches(entry))
+                result.emplace_back(entry.Auction);
+        }
+    }
+}
+
+void AuctionSearchIndex::AddToList(std::vector<uint32>& list, uint32 slot, IndexList index)
+{
+    _entries[slot].Positions[index] = uint32(list.size());
+    list.emplace_back(slot);
+}
+
+void AuctionSearchIndex::RemoveFromList(std::vector<uint32>& list, uint32 slot, IndexList index)
+{
+    uint32 position = _entries[slot].Positions[index];
+    uint32 lastSlot = list.back();
+
+    list[position] = lastSlot;
+    _entries[lastSlot].Positions[index] = position;
+    list.pop_back();
+}
+
+uint32 AuctionSearchIndex::AddName(uint64 key, uint32 itemId, int32 randomPropertyId)
+{
+    auto itr = _nameSlots.find(key);
+    if (itr != _nameSlots.end())
+        return itr->second;
+
+    uint32 nameSlot;
+    if (!_freeNames.empty())
+    {
+        nameSlot = _freeNames.back();
+        _freeNames.pop_back();
+    }
+    else
+    {
+        nameSlot = uint32(_names.size());
+        _names.emplace_back();
+    }
+
+    _names[nameSlot].Key = key;
+    _nameSlots.emplace(key, nameSlot);
+
+    // locales already searched in are kept up to date
+    for (auto& [localeKey, locale] : _locales)
+        AddLocaleName(locale, nameSlot, locale.Builder(itemId, randomPropertyId));
+
+    return nameSlot;
+}
+
+void AuctionSearchIndex::RemoveName(uint32 nameSlot)
+{
+    for (auto& [localeKey, locale] : _locales)
+    {
+        std::wstring& name = locale.Names[nameSlot];
+
+        for (std::size_t i = 0; i + TRIGRAM_LENGTH <= name.size(); ++i)
+        {
+            auto itr = locale.Trigrams.find(MakeTrigram(name.data() + i));
+            if (itr == locale.Trigrams.end())
+                continue;
+
+            std::vector<uint32>& nameSlots = itr->second;
+
+            auto slotItr = std::find(nameSlots.begin(), nameSlots.end(), nameSlot);
+            if (slotItr == nameSlots.end())
+                continue;
+
+            *slotItr = nameSlots.back();
+            nameSlots.pop_back();
+
+            if (nameSlots.empty())
+                locale.Trigrams.erase(itr);
+        }
+
+        name.clear();
+    }
+
+    _nameSlots.erase(_names[nameSlot].Key);
+    _freeNames.emplace_back(nameSlot);
+}
+
+void AuctionSearchIndex::AddLocaleName(LocaleNames& locale, uint32 nameSlot, std::wstring&& name)
+{
+    if (nameSlot >= locale.Names.size())
+        locale.Names.resize(nameSlot + 1);
+
+    std::vector<uint64> trigrams;
+
+    for (std::size_t i = 0; i + TRIGRAM_LENGTH <= name.size(); ++i)
+        trigrams.emplace_back(MakeTrigram(name.data() + i));
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+    for (uint64 trigram : trigrams)
+        locale.Trigrams[trigram].emplace_back(nameSlot);
+
+    locale.Names[nameSlot] = std::move(name);
+}
+
+AuctionSearchIndex::LocaleNames& AuctionSearchIndex::GetLocaleNames(uint32 localeKey, NameBuilder const& nameBuilder)
+{
+    auto [itr, inserted] = _locales.try_emplace(localeKey);
+    LocaleNames& locale = itr->second;
+
+    if (!inserted)
+        return locale;
+
+    locale.Builder = nameBuilder;
+    locale.Names.resize(_names.size());
+
+    for (uint32 nameSlot = 0; nameSlot < _names.size(); ++nameSlot)
+    {
+        IndexedName const& name = _names[nameSlot];
+        if (name.Auctions.empty())
+            continue;
+
+        AddLocaleName(locale, nameSlot, nameBuilder(uint32(name.Key >> 32), int32(uint32(name.Key))));
+    }
+
+    return locale;
+}
+
+void AuctionSearchIndex::MatchNames(std::wstring const& lowerName, uint32 localeKey, NameBuilder const& nameBuilder, std::vector<uint32>& nameSlots)
+{
+    std::lock_guard<std::mutex> guard(_localesLock);
+
+    LocaleNames& locale = GetLocaleNames(localeKey, nameBuilder);
+
+    auto matchName = [&locale, &lowerName, &nameSlots](uint32 nameSlot)
+    {
+        if (locale.Names[nameSlot].find(lowerName) != std::wstring::npos)
+            nameSlots.emplace_back(nameSlot);
+    };
+
+    // too short for trigrams, check every name
+    if (lowerName.size() < TRIGRAM_LENGTH)
+    {
+        for (uint32 nameSlot = 0; nameSlot < locale.Names.size(); ++nameSlot)
+            matchName(nameSlot);
+
+        return;
+    }
+
+    // names containing searched text contain all its trigrams, check the ones of rarest trigram
+    std::vector<uint32> const* candidates = nullptr;
+
+    for (std::size_t i = 0; i + TRIGRAM_LENGTH <= lowerName.size(); ++i)
+    {
+        auto itr = locale.Trigrams.find(MakeTrigram(lowerName.data() + i));
+        if (itr == locale.Trigrams.end())
+            return;
+
+        if (!candidates || itr->second.size() < candidates->size())
+            candidates = &itr->second;
+    }
+
+    for (uint32 nameSlot : *candidates)
+        matchName(nameSlot);
+}
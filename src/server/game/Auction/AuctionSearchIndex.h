@@ -0,0 +1,121 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WARHEAD_AUCTION_SEARCH_INDEX_H_
+#define WARHEAD_AUCTION_SEARCH_INDEX_H_
+
+#include "AuctionFwd.h"
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct AuctionEntry;
+
+// Item data of auction used by search filters
+struct AuctionSearchItemInfo
+{
+    uint32 ItemId{};
+    int32 RandomPropertyId{};
+    uint8 ItemClass{};
+    uint8 ItemSubClass{};
+    uint8 InventoryType{};
+    uint8 Quality{};
+    uint8 RequiredLevel{};
+};
+
+// Secondary indexes of auction house for CMSG_AUCTION_LIST_ITEMS filters.
+// Insert and Remove need exclusive access, Search can be called by several threads at once.
+class WH_GAME_API AuctionSearchIndex
+{
+public:
+    // lowercase name of item with random property suffix, in locale of search
+    typedef std::function<std::wstring(uint32 itemId, int32 randomPropertyId)> NameBuilder;
+
+    void Insert(AuctionEntry* auction, AuctionSearchItemInfo const& info);
+    void Remove(AuctionEntry const* auction);
+
+    // Auctions matching class, subclass, inventory type, quality, level and name filters, in no particular order.
+    // Names of localeKey are built by nameBuilder on first search in this locale.
+    void Search(AuctionListItems const& filter, std::wstring const& lowerName, uint32 localeKey, NameBuilder const& nameBuilder, std::vector<AuctionEntry*>& result);
+
+    [[nodiscard]] std::size_t GetSize() const { return _slots.size(); }
+
+private:
+    enum IndexList : uint8
+    {
+        INDEX_CLASS,
+        INDEX_SUBCLASS,
+        INDEX_INVENTORY_TYPE,
+        INDEX_QUALITY,
+        INDEX_REQUIRED_LEVEL,
+        INDEX_NAME,
+
+        INDEX_MAX
+    };
+
+    struct IndexedAuction
+    {
+        AuctionEntry* Auction{};
+        AuctionSearchItemInfo Info;
+        uint32 NameSlot{};
+        uint32 Positions[INDEX_MAX]{}; // position of auction in each list it's added to
+    };
+
+    struct IndexedName
+    {
+        uint64 Key{};
+        std::vector<uint32> Auctions;
+    };
+
+    // names in one locale and trigrams of them
+    struct LocaleNames
+    {
+        NameBuilder Builder;
+        std::vector<std::wstring> Names; // by name slot, empty for free slots
+        std::unordered_map<uint64, std::vector<uint32>> Trigrams;
+    };
+
+    void AddToList(std::vector<uint32>& list, uint32 slot, IndexList index);
+    void RemoveFromList(std::vector<uint32>& list, uint32 slot, IndexList index);
+
+    uint32 AddName(uint64 key, uint32 itemId, int32 randomPropertyId);
+    void RemoveName(uint32 nameSlot);
+    void AddLocaleName(LocaleNames& locale, uint32 nameSlot, std::wstring&& name);
+    LocaleNames& GetLocaleNames(uint32 localeKey, NameBuilder const& nameBuilder);
+    void MatchNames(std::wstring const& lowerName, uint32 localeKey, NameBuilder const& nameBuilder, std::vector<uint32>& nameSlots);
+
+    std::vector<IndexedAuction> _entries;
+    std::vector<uint32> _freeEntries;
+    std::unordered_map<uint32, uint32> _slots; // auction id to entry slot
+
+    std::vector<std::vector<uint32>> _byClass;
+    std::unordered_map<uint16, std::vector<uint32>> _bySubClass; // class << 8 | subclass
+    std::vector<std::vector<uint32>> _byInventoryType;
+    std::vector<std::vector<uint32>> _byQuality;
+    std::vector<std::vector<uint32>> _byRequiredLevel;
+
+    std::vector<IndexedName> _names;
+    std::vector<uint32> _freeNames;
+    std::unordered_map<uint64, uint32> _nameSlots; // item id and random property to name slot
+
+    std::mutex _localesLock;
+    std::unordered_map<uint32, LocaleNames> _locales;
+};
+
+#endif
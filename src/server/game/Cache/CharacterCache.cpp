@@ -19,18 +19,123 @@
 // PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 
 #include "CharacterCache.h"
-#include "ArenaTeam.h"
+#include "AsyncCallbackProcessor.h"
 #include "DatabaseEnv.h"
+#include "GameConfig.h"
+#include "GameTime.h"
 #include "Log.h"
+#include "Mail.h"
 #include "Player.h"
 #include "StopWatch.h"
 #include "World.h"
-#include <unordered_map>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
 
 namespace
 {
-    std::unordered_map<ObjectGuid, CharacterCacheEntry> _characterCacheStore;
-    std::unordered_map<std::string, CharacterCacheEntry*> _characterCacheByNameStore;
+    // Queried characters are remembered to not query missing ones again, until this count is reached
+    constexpr std::size_t MAX_REQUESTED_CHARACTERS = 10000;
+    constexpr std::size_t MAX_CHARACTERS_PER_QUERY = 100;
+
+    constexpr std::string_view CHARACTER_CACHE_QUERY = "SELECT c.guid, c.name, c.account, c.race, c.gender, c.class, c.level, "
+        "(SELECT COUNT(m.id) FROM mail m WHERE m.receiver = c.guid) FROM characters c";
+
+    CharacterCacheStore _characterCacheStore;
+    std::shared_mutex _characterCacheLock;
+
+    // Lazy mode, characters which weren't loaded at startup are queried on first lookup
+    std::atomic<bool> _lazyLoad{ false };
+    std::mutex _requestLock;
+    std::unordered_set<ObjectGuid::LowType> _requestedGuids;
+    std::unordered_set<std::string> _requestedNames;
+    std::vector<ObjectGuid::LowType> _pendingGuids;
+    std::vector<std::string> _pendingNames;
+    QueryCallbackProcessor _queryProcessor;
+
+    void RequestCharacter(ObjectGuid::LowType guid)
+    {
+        if (!_lazyLoad.load(std::memory_order_relaxed))
+            return;
+
+        std::lock_guard<std::mutex> guard(_requestLock);
+
+        if (_requestedGuids.emplace(guid).second)
+            _pendingGuids.emplace_back(guid);
+    }
+
+    void RequestCharacter(std::string const& name)
+    {
+        if (!_lazyLoad.load(std::memory_order_relaxed) || name.empty())
+            return;
+
+        std::lock_guard<std::mutex> guard(_requestLock);
+
+        if (_requestedNames.emplace(name).second)
+            _pendingNames.emplace_back(name);
+    }
+
+    // Adds character with mail count from row of CHARACTER_CACHE_QUERY, returns row in store
+    uint32 AddCharacter(ResultSet const& fields, bool replace)
+    {
+        ObjectGuid::LowType guid = fields[0].Get<uint32>();
+
+        uint32 row = _characterCacheStore.Find(guid);
+        if (row != CharacterCacheStore::NOT_FOUND && !replace)
+            return row;
+
+        row = _characterCacheStore.Add(guid, fields[1].Get<std::string_view>() /*name*/, fields[2].Get<uint32>() /*account*/,
+            fields[4].Get<uint8>() /*gender*/, fields[3].Get<uint8>() /*race*/, fields[5].Get<uint8>() /*class*/, fields[6].Get<uint8>() /*level*/);
+
+        _characterCacheStore.SetMailCount(row, uint8(fields[7].Get<uint64>()));
+        return row;
+    }
+
+    void AddRequestedCharacters(QueryResult result)
+    {
+        if (!result)
+            return;
+
+        std::unique_lock<std::shared_mutex> lock(_characterCacheLock);
+
+        for (auto const& fields : *result)
+            AddCharacter(fields, false);
+    }
+
+    std::string GetGuidList(std::vector<ObjectGuid::LowType> const& guids, std::size_t begin, std::size_t end)
+    {
+        std::string list;
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            if (!list.empty())
+                list += ',';
+
+            list += std::to_string(guids[i]);
+        }
+
+        return list;
+    }
+
+    std::string GetNameList(std::vector<std::string>& names, std::size_t begin, std::size_t end)
+    {
+        std::string list;
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            CharacterDatabase.EscapeString(names[i]);
+
+            if (!list.empty())
+                list += ',';
+
+            list += '\'';
+            list += names[i];
+            list += '\'';
+        }
+
+        return list;
+    }
 }
 
 CharacterCache* CharacterCache::instance()
@@ -48,7 +153,7 @@ CharacterCache* CharacterCache::instance()
 * @return Name, Gender, Race, Class and Level of player character
 * Example Usage:
 * @code
-*    CharacterCacheEntry const* characterInfo = sCharacterCache->GetCharacterCacheByGuid(GUID);
+*    Optional<CharacterCacheEntry> characterInfo = sCharacterCache->GetCharacterCacheByGuid(GUID);
 *    if (!characterInfo)
 *        return;
 *
@@ -63,178 +168,235 @@ CharacterCache* CharacterCache::instance()
 void CharacterCache::LoadCharacterCacheStorage()
 {
     StopWatch sw;
-    _characterCacheStore.clear();
 
-    QueryResult result = CharacterDatabase.Query("SELECT guid, name, account, race, gender, class, level FROM characters");
+    std::unique_lock<std::shared_mutex> lock(_characterCacheLock);
+    _characterCacheStore.Clear();
+
+    // Lazy mode loads characters active in last days and all which other startup loading expects in cache,
+    // because groups, guilds, arena teams and corpses of characters missing in cache are deleted
+    uint32 lazyLoadDays = CONF_GET_UINT("CharacterCache.LazyLoad.Days");
+    _lazyLoad = lazyLoadDays > 0;
+
+    QueryResult result;
+
+    if (lazyLoadDays)
+        result = CharacterDatabase.Query("{} WHERE c.online <> 0 OR c.logout_time >= {} OR c.guid IN (SELECT guid FROM guild_member) OR c.guid IN (SELECT memberGuid FROM group_member) "
+            "OR c.guid IN (SELECT guid FROM arena_team_member) OR c.guid IN (SELECT guid FROM corpse) "
+            "OR c.guid IN (SELECT itemowner FROM auctionhouse) OR c.guid IN (SELECT buyguid FROM auctionhouse) "
+            "OR c.guid IN (SELECT sender FROM mail WHERE messageType = {}) OR c.guid IN (SELECT receiver FROM mail)",
+            CHARACTER_CACHE_QUERY, GameTime::GetGameTime().count() - lazyLoadDays * DAY, uint32(MAIL_NORMAL));
+    else
+        result = CharacterDatabase.Query(CHARACTER_CACHE_QUERY);
+
     if (!result)
     {
         LOG_INFO("server.loading", "No character name data loaded, empty query!");
         return;
     }
 
-    for (auto const& fields : *result)
-        AddCharacterCacheEntry(ObjectGuid::Create<HighGuid::Player>(fields[0].Get<uint32>()) /*guid*/, fields[2].Get<uint32>() /*account*/, fields[1].Get<std::string>() /*name*/,
-                               fields[4].Get<uint8>() /*gender*/, fields[3].Get<uint8>() /*race*/, fields[5].Get<uint8>() /*class*/, fields[6].Get<uint8>() /*level*/);
+    _characterCacheStore.Reserve(result->GetRowCount());
 
-    if (QueryResult mailCountResult = CharacterDatabase.Query("SELECT receiver, COUNT(receiver) FROM mail GROUP BY receiver"))
-        for (auto const& fields : *mailCountResult)
-            UpdateCharacterMailCount(ObjectGuid(HighGuid::Player, fields[0].Get<uint32>()), static_cast<int8>(fields[1].Get<uint64>()), true);
+    for (auto const& fields : *result)
+        AddCharacter(fields, true);
 
-    LOG_INFO("server.loading", ">> Loaded Character Infos For {} Characters in {}", _characterCacheStore.size(), sw);
+    LOG_INFO("server.loading", ">> Loaded Character Infos For {} Characters ({} KB) in {}", _characterCacheStore.size(), _characterCacheStore.GetMemoryUsage() / 1024, sw);
     LOG_INFO("server.loading", " ");
 }
 
 void CharacterCache::RefreshCacheEntry(uint32 lowGuid)
 {
-    QueryResult result = CharacterDatabase.Query("SELECT guid, name, account, race, gender, class, level FROM characters WHERE guid = {}", lowGuid);
+    QueryResult result = CharacterDatabase.Query("{} WHERE c.guid = {}", CHARACTER_CACHE_QUERY, lowGuid);
     if (!result)
         return;
 
+    std::unique_lock<std::shared_mutex> lock(_characterCacheLock);
+
     for (auto const& fields : *result)
+        AddCharacter(fields, true);
+}
+
+void CharacterCache::Update()
+{
+    if (!_lazyLoad.load(std::memory_order_relaxed))
+        return;
+
+    std::vector<ObjectGuid::LowType> guids;
+    std::vector<std::string> names;
+
+    {
+        std::lock_guard<std::mutex> guard(_requestLock);
+
+        guids.swap(_pendingGuids);
+        names.swap(_pendingNames);
+
+        if (_requestedGuids.size() + _requestedNames.size() > MAX_REQUESTED_CHARACTERS)
+        {
+            _requestedGuids.clear();
+            _requestedNames.clear();
+        }
+    }
+
+    for (std::size_t i = 0; i < guids.size(); i += MAX_CHARACTERS_PER_QUERY)
     {
-        DeleteCharacterCacheEntry(ObjectGuid::Create<HighGuid::Player>(lowGuid), fields[1].Get<std::string>());
-        AddCharacterCacheEntry(ObjectGuid::Create<HighGuid::Player>(fields[0].Get<uint32>()) /*guid*/, fields[2].Get<uint32>() /*account*/,
-            fields[1].Get<std::string>() /*name*/, fields[4].Get<uint8>() /*gender*/, fields[3].Get<uint8>() /*race*/, fields[5].Get<uint8>() /*class*/, fields[6].Get<uint8>() /*level*/);
+        std::string sql = Warhead::StringFormat("{} WHERE c.guid IN ({})", CHARACTER_CACHE_QUERY, GetGuidList(guids, i, std::min(guids.size(), i + MAX_CHARACTERS_PER_QUERY)));
+        _queryProcessor.AddCallback(CharacterDatabase.AsyncQuery(sql).WithCallback(&AddRequestedCharacters));
     }
 
-    if (QueryResult mailCountResult = CharacterDatabase.Query("SELECT receiver, COUNT(receiver) FROM mail WHERE receiver = {} GROUP BY receiver", lowGuid))
-        for (auto const& fields : *mailCountResult)
-            UpdateCharacterMailCount(ObjectGuid(HighGuid::Player, fields[0].Get<uint32>()), static_cast<int8>(fields[1].Get<uint64>()), true);
+    for (std::size_t i = 0; i < names.size(); i += MAX_CHARACTERS_PER_QUERY)
+    {
+        std::string sql = Warhead::StringFormat("{} WHERE c.name IN ({})", CHARACTER_CACHE_QUERY, GetNameList(names, i, std::min(names.size(), i + MAX_CHARACTERS_PER_QUERY)));
+        _queryProcessor.AddCallback(CharacterDatabase.AsyncQuery(sql).WithCallback(&AddRequestedCharacters));
+    }
+
+    _queryProcessor.ProcessReadyCallbacks();
 }
 
-/*
-    Modifying functions
-*/
-void CharacterCache::AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level)
+void CharacterCache::RequestCharacterCacheEntry(ObjectGuid const& guid)
 {
-    CharacterCacheEntry& data = _characterCacheStore[guid];
-    data.Guid = guid;
-    data.Name = name;
-    data.AccountId = accountId;
-    data.Race = race;
-    data.Sex = gender;
-    data.Class = playerClass;
-    data.Level = level;
-    data.GuildId = 0;                           // Will be set in guild loading or guild setting
+    if (!_lazyLoad.load(std::memory_order_relaxed))
+        return;
 
-    for (uint8 i = 0; i < MAX_ARENA_SLOT; ++i)
     {
-        data.ArenaTeamId[i] = 0; // Will be set in arena teams loading
+        std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+        if (_characterCacheStore.Find(guid.GetCounter()) != CharacterCacheStore::NOT_FOUND)
+            return;
     }
 
-    // Fill Name to Guid Store
-    _characterCacheByNameStore[name] = &data;
+    RequestCharacter(guid.GetCounter());
+}
+
+/*
+    Modifying functions
+*/
+void CharacterCache::AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level)
+{
+    std::unique_lock<std::shared_mutex> lock(_characterCacheLock);
+    _characterCacheStore.Add(guid.GetCounter(), name, accountId, gender, race, playerClass, level);
 }
 
-void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid const& guid, std::string const& name)
+void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid const& guid, std::string const& /*name*/)
 {
-    _characterCacheStore.erase(guid);
-    _characterCacheByNameStore.erase(name);
+    std::unique_lock<std::shared_mutex> lock(_characterCacheLock);
+
+    uint32 row = _characterCacheStore.Find(guid.GetCounter());
+    if (row != CharacterCacheStore::NOT_FOUND)
+        _characterCacheStore.Remove(row);
 }
 
 void CharacterCache::UpdateCharacterData(ObjectGuid const& guid, std::string const& name, Optional<uint8> gender /*= {}*/, Optional<uint8> race /*= {}*/)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    std::unique_lock<std::shared_mutex> lock(_characterCacheLock);
+
+    uint32 row = _characterCacheStore.Find(guid.GetCounter());
+    if (row == CharacterCacheStore::NOT_FOUND)
         return;
 
-    std::string oldName = itr->second.Name;
-    itr->second.Name = name;
+    _characterCacheStore.Rename(row, name);
 
     if (gender)
     {
-        itr->second.Sex = *gender;
+        _characterCacheStore.SetGender(row, *gender);
     }
 
     if (race)
     {
-        itr->second.Race = *race;
+        _characterCacheStore.SetRace(row, *race);
     }
 
     //WorldPackets::Misc::InvalidatePlayer packet(guid);
     //sWorld->SendGlobalMessage(packet.Write());
-
-    // Correct name -> pointer storage
-    _characterCacheByNameStore.erase(oldName);
-    _characterCacheByNameStore[name] = &itr->second;
 }
 
 void CharacterCache::UpdateCharacterLevel(ObjectGuid const& guid, uint8 level)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    std::unique_lock<std::shared_mutex> lock(_characterCacheLock);
+
+    uint32 row = _characterCacheStore.Find(guid.GetCounter());
+    if (row == CharacterCacheStore::NOT_FOUND)
     {
         return;
     }
 
-    itr->second.Level = level;
+    _characterCacheStore.SetLevel(row, level);
 }
 
 void CharacterCache::UpdateCharacterAccountId(ObjectGuid const& guid, uint32 accountId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    std::unique_lock<std::shared_mutex> lock(_characterCacheLock);
+
+    uint32 row = _characterCacheStore.Find(guid.GetCounter());
+    if (row == CharacterCacheStore::NOT_FOUND)
     {
         return;
     }
 
-    itr->second.AccountId = accountId;
+    _characterCacheStore.SetAccountId(row, accountId);
 }
 
 void CharacterCache::UpdateCharacterGuildId(ObjectGuid const& guid, ObjectGuid::LowType guildId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    std::unique_lock<std::shared_mutex> lock(_characterCacheLock);
+
+    uint32 row = _characterCacheStore.Find(guid.GetCounter());
+    if (row == CharacterCacheStore::NOT_FOUND)
     {
         return;
     }
 
-    itr->second.GuildId = guildId;
+    _characterCacheStore.SetGuildId(row, guildId);
 }
 
 void CharacterCache::UpdateCharacterArenaTeamId(ObjectGuid const& guid, uint8 slot, uint32 arenaTeamId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    std::unique_lock<std::shared_mutex> lock(_characterCacheLock);
+
+    uint32 row = _characterCacheStore.Find(guid.GetCounter());
+    if (row == CharacterCacheStore::NOT_FOUND)
     {
         return;
     }
 
-    itr->second.ArenaTeamId[slot] = arenaTeamId;
+    _characterCacheStore.SetArenaTeamId(row, slot, arenaTeamId);
 }
 
 void CharacterCache::UpdateCharacterMailCount(ObjectGuid const& guid, int8 count, bool update)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    std::unique_lock<std::shared_mutex> lock(_characterCacheLock);
+
+    uint32 row = _characterCacheStore.Find(guid.GetCounter());
+    if (row == CharacterCacheStore::NOT_FOUND)
     {
         return;
     }
 
     if (update)
     {
-        itr->second.MailCount = count;
+        _characterCacheStore.SetMailCount(row, count);
         return;
     }
 
+    uint8 mailCount = _characterCacheStore.GetMailCount(row);
+
     // Let's be safe and prevent overflow
-    if (!itr->second.MailCount && count < 0)
+    if (!mailCount && count < 0)
     {
         return;
     }
 
-    itr->second.MailCount += count;
+    _characterCacheStore.SetMailCount(row, mailCount + count);
 }
 
 void CharacterCache::UpdateCharacterGroup(ObjectGuid const& guid, ObjectGuid groupGUID)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    std::unique_lock<std::shared_mutex> lock(_characterCacheLock);
+
+    uint32 row = _characterCacheStore.Find(guid.GetCounter());
+    if (row == CharacterCacheStore::NOT_FOUND)
     {
         return;
     }
 
-    itr->second.GroupGuid = groupGUID;
+    _characterCacheStore.SetGroupId(row, groupGUID.GetCounter());
 }
 
 /*
@@ -242,127 +404,204 @@ Getters
 */
 bool CharacterCache::HasCharacterCacheEntry(ObjectGuid const& guid) const
 {
-    return _characterCacheStore.find(guid) != _characterCacheStore.end();
+    {
+        std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+        if (_characterCacheStore.Find(guid.GetCounter()) != CharacterCacheStore::NOT_FOUND)
+            return true;
+    }
+
+    RequestCharacter(guid.GetCounter());
+    return false;
 }
 
-CharacterCacheEntry const* CharacterCache::GetCharacterCacheByGuid(ObjectGuid const& guid) const
+Optional<CharacterCacheEntry> CharacterCache::GetCharacterCacheByGuid(ObjectGuid const& guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr != _characterCacheStore.end())
     {
-        return &itr->second;
+        std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+
+        uint32 row = _characterCacheStore.Find(guid.GetCounter());
+        if (row != CharacterCacheStore::NOT_FOUND)
+        {
+            return _characterCacheStore.GetEntry(row);
+        }
     }
 
-    return nullptr;
+    RequestCharacter(guid.GetCounter());
+    return std::nullopt;
 }
 
-CharacterCacheEntry const* CharacterCache::GetCharacterCacheByName(std::string const& name) const
+Optional<CharacterCacheEntry> CharacterCache::GetCharacterCacheByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
     {
-        return itr->second;
+        std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+
+        uint32 row = _characterCacheStore.FindByName(name);
+        if (row != CharacterCacheStore::NOT_FOUND)
+        {
+            return _characterCacheStore.GetEntry(row);
+        }
     }
 
-    return nullptr;
+    RequestCharacter(name);
+    return std::nullopt;
 }
 
 ObjectGuid CharacterCache::GetCharacterGuidByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
     {
-        return itr->second->Guid;
+        std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+
+        uint32 row = _characterCacheStore.FindByName(name);
+        if (row != CharacterCacheStore::NOT_FOUND)
+        {
+            return ObjectGuid::Create<HighGuid::Player>(_characterCacheStore.GetGuid(row));
+        }
     }
 
+    RequestCharacter(name);
     return ObjectGuid::Empty;
 }
 
 bool CharacterCache::GetCharacterNameByGuid(ObjectGuid guid, std::string& name) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
     {
-        return false;
+        std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+
+        uint32 row = _characterCacheStore.Find(guid.GetCounter());
+        if (row != CharacterCacheStore::NOT_FOUND)
+        {
+            name = _characterCacheStore.GetName(row);
+            return true;
+        }
     }
 
-    name = itr->second.Name;
-    return true;
+    RequestCharacter(guid.GetCounter());
+    return false;
 }
 
 uint32 CharacterCache::GetCharacterTeamByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
     {
-        return 0;
+        std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+
+        uint32 row = _characterCacheStore.Find(guid.GetCounter());
+        if (row != CharacterCacheStore::NOT_FOUND)
+        {
+            return Player::TeamIdForRace(_characterCacheStore.GetRace(row));
+        }
     }
 
-    return Player::TeamIdForRace(itr->second.Race);
+    RequestCharacter(guid.GetCounter());
+    return 0;
 }
 
 uint32 CharacterCache::GetCharacterAccountIdByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
     {
-        return 0;
+        std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+
+        uint32 row = _characterCacheStore.Find(guid.GetCounter());
+        if (row != CharacterCacheStore::NOT_FOUND)
+        {
+            return _characterCacheStore.GetAccountId(row);
+        }
     }
 
-    return itr->second.AccountId;
+    RequestCharacter(guid.GetCounter());
+    return 0;
 }
 
 uint32 CharacterCache::GetCharacterAccountIdByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
     {
-        return itr->second->AccountId;
+        std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+
+        uint32 row = _characterCacheStore.FindByName(name);
+        if (row != CharacterCacheStore::NOT_FOUND)
+        {
+            return _characterCacheStore.GetAccountId(row);
+        }
     }
 
+    RequestCharacter(name);
     return 0;
 }
 
 uint8 CharacterCache::GetCharacterLevelByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
     {
-        return 0;
+        std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+
+        uint32 row = _characterCacheStore.Find(guid.GetCounter());
+        if (row != CharacterCacheStore::NOT_FOUND)
+        {
+            return _characterCacheStore.GetLevel(row);
+        }
     }
 
-    return itr->second.Level;
+    RequestCharacter(guid.GetCounter());
+    return 0;
 }
 
 ObjectGuid::LowType CharacterCache::GetCharacterGuildIdByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
     {
-        return 0;
+        std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+
+        uint32 row = _characterCacheStore.Find(guid.GetCounter());
+        if (row != CharacterCacheStore::NOT_FOUND)
+        {
+            return _characterCacheStore.GetGuildId(row);
+        }
     }
 
-    return itr->second.GuildId;
+    RequestCharacter(guid.GetCounter());
+    return 0;
 }
 
 uint32 CharacterCache::GetCharacterArenaTeamIdByGuid(ObjectGuid guid, uint8 type) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
     {
-        return 0;
+        std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+
+        uint32 row = _characterCacheStore.Find(guid.GetCounter());
+        if (row != CharacterCacheStore::NOT_FOUND)
+        {
+            return _characterCacheStore.GetArenaTeamId(row, type);
+        }
     }
 
-    return itr->second.ArenaTeamId[type];
+    RequestCharacter(guid.GetCounter());
+    return 0;
 }
 
 ObjectGuid CharacterCache::GetCharacterGroupGuidByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
     {
-        return ObjectGuid::Empty;
+        std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+
+        uint32 row = _characterCacheStore.Find(guid.GetCounter());
+        if (row != CharacterCacheStore::NOT_FOUND)
+        {
+            if (ObjectGuid::LowType groupId = _characterCacheStore.GetGroupId(row))
+                return ObjectGuid::Create<HighGuid::Group>(groupId);
+
+            return ObjectGuid::Empty;
+        }
     }
 
-    return itr->second.GroupGuid;
+    RequestCharacter(guid.GetCounter());
+    return ObjectGuid::Empty;
+}
+
+std::size_t CharacterCache::GetCharacterCacheSize() const
+{
+    std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+    return _characterCacheStore.size();
+}
+
+std::size_t CharacterCache::GetCharacterCacheMemoryUsage() const
+{
+    std::shared_lock<std::shared_mutex> lock(_characterCacheLock);
+    return _characterCacheStore.GetMemoryUsage();
 }
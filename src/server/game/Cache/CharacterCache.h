@@ -18,26 +18,10 @@
 #ifndef CharacterCache_h__
 #define CharacterCache_h__
 
-#include "ArenaTeam.h"
-#include "ObjectGuid.h"
+#include "CharacterCacheStore.h"
 #include "Optional.h"
 #include <string>
 
-struct CharacterCacheEntry
-{
-    ObjectGuid Guid;
-    std::string Name;
-    uint32 AccountId;
-    uint8 Class;
-    uint8 Race;
-    uint8 Sex;
-    uint8 Level;
-    uint8 MailCount;
-    ObjectGuid::LowType GuildId;
-    std::array<uint32, MAX_ARENA_SLOT> ArenaTeamId;
-    ObjectGuid GroupGuid;
-};
-
 class WH_GAME_API CharacterCache
 {
 public:
@@ -48,6 +32,12 @@ public:
     void LoadCharacterCacheStorage();
     void RefreshCacheEntry(uint32 lowGuid);
 
+    // Sends queries for characters which were not found in lazy mode and adds their results
+    void Update();
+
+    // Queues query of character in lazy mode if it isn't cached yet
+    void RequestCharacterCacheEntry(ObjectGuid const& guid);
+
     void AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level);
     void DeleteCharacterCacheEntry(ObjectGuid const& guid, std::string const& name);
 
@@ -62,8 +52,8 @@ public:
     void IncreaseCharacterMailCount(ObjectGuid const& guid) { UpdateCharacterMailCount(guid, 1); };
 
     [[nodiscard]] bool HasCharacterCacheEntry(ObjectGuid const& guid) const;
-    [[nodiscard]] CharacterCacheEntry const* GetCharacterCacheByGuid(ObjectGuid const& guid) const;
-    [[nodiscard]] CharacterCacheEntry const* GetCharacterCacheByName(std::string const& name) const;
+    [[nodiscard]] Optional<CharacterCacheEntry> GetCharacterCacheByGuid(ObjectGuid const& guid) const;
+    [[nodiscard]] Optional<CharacterCacheEntry> GetCharacterCacheByName(std::string const& name) const;
 
     void UpdateCharacterGroup(ObjectGuid const& guid, ObjectGuid groupGUID);
     void ClearCharacterGroup(ObjectGuid const& guid) { UpdateCharacterGroup(guid, ObjectGuid::Empty); };
@@ -77,6 +67,9 @@ public:
     [[nodiscard]] ObjectGuid::LowType GetCharacterGuildIdByGuid(ObjectGuid guid) const;
     [[nodiscard]] uint32 GetCharacterArenaTeamIdByGuid(ObjectGuid guid, uint8 type) const;
     [[nodiscard]] ObjectGuid GetCharacterGroupGuidByGuid(ObjectGuid guid) const;
+
+    [[nodiscard]] std::size_t GetCharacterCacheSize() const;
+    [[nodiscard]] std::size_t GetCharacterCacheMemoryUsage() const;
 };
 
 #define sCharacterCache CharacterCache::instance()
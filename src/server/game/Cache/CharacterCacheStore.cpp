@@ -0,0 +1,402 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterCacheStore.h"
+#include "Util.h"
+#include <utf8.h>
+
+namespace
+{
+    constexpr std::size_t MIN_INDEX_CAPACITY = 64;
+    constexpr std::size_t MIN_UNUSED_NAME_BYTES = 4096;
+
+    // Returns lowercase characters of utf8 name one by one and 0 at end, invalid bytes are returned as is
+    class NameReader
+    {
+    public:
+        explicit NameReader(std::string_view name) : _itr(name.data()), _end(name.data() + name.size()) { }
+
+        uint32 Next()
+        {
+            if (_itr == _end)
+                return 0;
+
+            uint8 byte = uint8(*_itr);
+            if (byte < 0x80)
+            {
+                ++_itr;
+                return byte >= 'A' && byte <= 'Z' ? byte + ('a' - 'A') : byte;
+            }
+
+            try
+            {
+                return uint32(wcharToLower(wchar_t(utf8::next(_itr, _end))));
+            }
+            catch (utf8::exception const&)
+            {
+                ++_itr;
+                return byte;
+            }
+        }
+
+    private:
+        char const* _itr;
+        char const* _end;
+    };
+}
+
+uint32 CharacterCacheStore::Add(ObjectGuid::LowType guid, std::string_view name, uint32 accountId, uint8 gender, uint8 race, uint8 playerClass, uint8 level)
+{
+    uint32 row = Find(guid);
+    if (row == NOT_FOUND)
+    {
+        row = uint32(_guids.size());
+
+        _guids.emplace_back(guid);
+        _nameOffsets.emplace_back();
+        _nameLengths.emplace_back();
+        _accountIds.emplace_back();
+        _classes.emplace_back();
+        _races.emplace_back();
+        _genders.emplace_back();
+        _levels.emplace_back();
+        _mailCounts.emplace_back();
+        _guildIds.emplace_back();
+        _arenaTeamIds.emplace_back();
+        _groupIds.emplace_back();
+
+        _guidIndex.Insert(HashGuid(guid), row);
+    }
+    else
+    {
+        _nameIndex.Erase(HashName(GetName(row)), row);
+        _unusedNameBytes += _nameLengths[row];
+    }
+
+    SetName(row, name);
+    _accountIds[row] = accountId;
+    _classes[row] = playerClass;
+    _races[row] = race;
+    _genders[row] = gender;
+    _levels[row] = level;
+    _mailCounts[row] = 0;
+    _guildIds[row] = 0;                     // Will be set in guild loading or guild setting
+    _arenaTeamIds[row].fill(0);             // Will be set in arena teams loading
+    _groupIds[row] = 0;
+
+    return row;
+}
+
+void CharacterCacheStore::Remove(uint32 row)
+{
+    uint32 const lastRow = uint32(_guids.size() - 1);
+
+    _guidIndex.Erase(HashGuid(_guids[row]), row);
+    _nameIndex.Erase(HashName(GetName(row)), row);
+    _unusedNameBytes += _nameLengths[row];
+
+    if (row != lastRow)
+    {
+        _guidIndex.Replace(HashGuid(_guids[lastRow]), lastRow, row);
+        _nameIndex.Replace(HashName(GetName(lastRow)), lastRow, row);
+
+        _guids[row] = _guids[lastRow];
+        _nameOffsets[row] = _nameOffsets[lastRow];
+        _nameLengths[row] = _nameLengths[lastRow];
+        _accountIds[row] = _accountIds[lastRow];
+        _classes[row] = _classes[lastRow];
+        _races[row] = _races[lastRow];
+        _genders[row] = _genders[lastRow];
+        _levels[row] = _levels[lastRow];
+        _mailCounts[row] = _mailCounts[lastRow];
+        _guildIds[row] = _guildIds[lastRow];
+        _arenaTeamIds[row] = _arenaTeamIds[lastRow];
+        _groupIds[row] = _groupIds[lastRow];
+    }
+
+    _guids.pop_back();
+    _nameOffsets.pop_back();
+    _nameLengths.pop_back();
+    _accountIds.pop_back();
+    _classes.pop_back();
+    _races.pop_back();
+    _genders.pop_back();
+    _levels.pop_back();
+    _mailCounts.pop_back();
+    _guildIds.pop_back();
+    _arenaTeamIds.pop_back();
+    _groupIds.pop_back();
+
+    if (_unusedNameBytes > MIN_UNUSED_NAME_BYTES && _unusedNameBytes * 2 > _names.size())
+        CompactNames();
+}
+
+void CharacterCacheStore::Rename(uint32 row, std::string_view name)
+{
+    _nameIndex.Erase(HashName(GetName(row)), row);
+    _unusedNameBytes += _nameLengths[row];
+
+    SetName(row, name);
+
+    if (_unusedNameBytes > MIN_UNUSED_NAME_BYTES && _unusedNameBytes * 2 > _names.size())
+        CompactNames();
+}
+
+void CharacterCacheStore::Reserve(std::size_t count)
+{
+    _guidIndex.Reserve(count);
+    _nameIndex.Reserve(count);
+    _names.reserve(count * 8);
+
+    _guids.reserve(count);
+    _nameOffsets.reserve(count);
+    _nameLengths.reserve(count);
+    _accountIds.reserve(count);
+    _classes.reserve(count);
+    _races.reserve(count);
+    _genders.reserve(count);
+    _levels.reserve(count);
+    _mailCounts.reserve(count);
+    _guildIds.reserve(count);
+    _arenaTeamIds.reserve(count);
+    _groupIds.reserve(count);
+}
+
+void CharacterCacheStore::Clear()
+{
+    _guidIndex.Clear();
+    _nameIndex.Clear();
+    _names.clear();
+    _unusedNameBytes = 0;
+
+    _guids.clear();
+    _nameOffsets.clear();
+    _nameLengths.clear();
+    _accountIds.clear();
+    _classes.clear();
+    _races.clear();
+    _genders.clear();
+    _levels.clear();
+    _mailCounts.clear();
+    _guildIds.clear();
+    _arenaTeamIds.clear();
+    _groupIds.clear();
+}
+
+uint32 CharacterCacheStore::Find(ObjectGuid::LowType guid) const
+{
+    return _guidIndex.Find(HashGuid(guid), [this, guid](uint32 row) { return _guids[row] == guid; });
+}
+
+uint32 CharacterCacheStore::FindByName(std::string_view name) const
+{
+    return _nameIndex.Find(HashName(name), [this, name](uint32 row) { return IsEqualName(GetName(row), name); });
+}
+
+std::size_t CharacterCacheStore::GetMemoryUsage() const
+{
+    return _guidIndex.GetMemoryUsage() + _nameIndex.GetMemoryUsage() + _names.capacity() +
+        _guids.capacity() * sizeof(ObjectGuid::LowType) +
+        _nameOffsets.capacity() * sizeof(uint32) +
+        _nameLengths.capacity() * sizeof(uint16) +
+        _accountIds.capacity() * sizeof(uint32) +
+        (_classes.capacity() + _races.capacity() + _genders.capacity() + _levels.capacity() + _mailCounts.capacity()) * sizeof(uint8) +
+        _guildIds.capacity() * sizeof(ObjectGuid::LowType) +
+        _arenaTeamIds.capacity() * sizeof(std::array<uint32, MAX_ARENA_SLOT>) +
+        _groupIds.capacity() * sizeof(ObjectGuid::LowType);
+}
+
+CharacterCacheEntry CharacterCacheStore::GetEntry(uint32 row) const
+{
+    CharacterCacheEntry entry;
+    entry.Guid = ObjectGuid::Create<HighGuid::Player>(_guids[row]);
+    entry.Name = GetName(row);
+    entry.AccountId = _accountIds[row];
+    entry.Class = _classes[row];
+    entry.Race = _races[row];
+    entry.Sex = _genders[row];
+    entry.Level = _levels[row];
+    entry.MailCount = _mailCounts[row];
+    entry.GuildId = _guildIds[row];
+    entry.ArenaTeamId = _arenaTeamIds[row];
+
+    if (_groupIds[row])
+        entry.GroupGuid = ObjectGuid::Create<HighGuid::Group>(_groupIds[row]);
+
+    return entry;
+}
+
+uint32 CharacterCacheStore::HashGuid(ObjectGuid::LowType guid)
+{
+    // fibonacci hashing, index takes low bits so high bits of product are moved down
+    uint64 hash = uint64(guid) * UI64LIT(0x9E3779B97F4A7C15);
+    return uint32(hash >> 32) ^ uint32(hash);
+}
+
+uint32 CharacterCacheStore::HashName(std::string_view name)
+{
+    // FNV-1a of lowercase characters
+    uint32 hash = 2166136261u;
+
+    NameReader reader(name);
+    while (uint32 character = reader.Next())
+    {
+        hash ^= character;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+bool CharacterCacheStore::IsEqualName(std::string_view left, std::string_view right)
+{
+    NameReader leftReader(left);
+    NameReader rightReader(right);
+
+    for (;;)
+    {
+        uint32 character = leftReader.Next();
+        if (character != rightReader.Next())
+            return false;
+
+        if (!character)
+            return true;
+    }
+}
+
+void CharacterCacheStore::SetName(uint32 row, std::string_view name)
+{
+    // name of other character which wasn't deleted, newest one is found by name
+    uint32 const hash = HashName(name);
+    uint32 const oldRow = FindByName(name);
+    if (oldRow != NOT_FOUND)
+        _nameIndex.Erase(hash, oldRow);
+
+    _nameOffsets[row] = uint32(_names.size());
+    _nameLengths[row] = uint16(name.size());
+    _names.append(name);
+
+    _nameIndex.Insert(hash, row);
+}
+
+void CharacterCacheStore::CompactNames()
+{
+    std::string names;
+    names.reserve(_names.size() - _unusedNameBytes);
+
+    for (std::size_t row = 0; row < _guids.size(); ++row)
+    {
+        std::string_view name = GetName(uint32(row));
+        _nameOffsets[row] = uint32(names.size());
+        names.append(name);
+    }
+
+    _names.swap(names);
+    _unusedNameBytes = 0;
+}
+
+void CharacterCacheStore::Index::Insert(uint32 hash, uint32 row)
+{
+    // keep load factor at most 3/4
+    if ((_size + 1) * 4 > _slots.size() * 3)
+        Rehash(_slots.empty() ? MIN_INDEX_CAPACITY : _slots.size() * 2);
+
+    std::size_t const mask = _slots.size() - 1;
+
+    std::size_t index = hash & mask;
+    while (_slots[index].Row != NOT_FOUND)
+        index = (index + 1) & mask;
+
+    _slots[index].Row = row;
+    _slots[index].Hash = hash;
+    ++_size;
+}
+
+void CharacterCacheStore::Index::Reserve(std::size_t count)
+{
+    std::size_t capacity = MIN_INDEX_CAPACITY;
+    while (count * 4 > capacity * 3)
+        capacity *= 2;
+
+    if (capacity > _slots.size())
+        Rehash(capacity);
+}
+
+void CharacterCacheStore::Index::Erase(uint32 hash, uint32 row)
+{
+    std::size_t hole = FindSlot(hash, row);
+    if (hole == std::size_t(NOT_FOUND))
+        return;
+
+    std::size_t const mask = _slots.size() - 1;
+
+    // shift back following entries of cluster which can be placed in hole, no tombstones are needed
+    for (std::size_t next = (hole + 1) & mask; _slots[next].Row != NOT_FOUND; next = (next + 1) & mask)
+    {
+        std::size_t ideal = _slots[next].Hash & mask;
+
+        if (((next - ideal) & mask) >= ((next - hole) & mask))
+        {
+            _slots[hole] = _slots[next];
+            hole = next;
+        }
+    }
+
+    _slots[hole] = Slot();
+    --_size;
+}
+
+void CharacterCacheStore::Index::Replace(uint32 hash, uint32 oldRow, uint32 newRow)
+{
+    std::size_t index = FindSlot(hash, oldRow);
+    if (index != std::size_t(NOT_FOUND))
+        _slots[index].Row = newRow;
+}
+
+std::size_t CharacterCacheStore::Index::FindSlot(uint32 hash, uint32 row) const
+{
+    if (_slots.empty())
+        return std::size_t(NOT_FOUND);
+
+    std::size_t const mask = _slots.size() - 1;
+
+    for (std::size_t index = hash & mask; _slots[index].Row != NOT_FOUND; index = (index + 1) & mask)
+        if (_slots[index].Row == row)
+            return index;
+
+    return std::size_t(NOT_FOUND);
+}
+
+void CharacterCacheStore::Index::Rehash(std::size_t capacity)
+{
+    std::vector<Slot> oldSlots(capacity);
+    oldSlots.swap(_slots);
+
+    std::size_t const mask = _slots.size() - 1;
+
+    for (Slot const& oldSlot : oldSlots)
+    {
+        if (oldSlot.Row == NOT_FOUND)
+            continue;
+
+        std::size_t index = oldSlot.Hash & mask;
+        while (_slots[index].Row != NOT_FOUND)
+            index = (index + 1) & mask;
+
+        _slots[index] = oldSlot;
+    }
+}
@@ -0,0 +1,161 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _CHARACTER_CACHE_STORE_H_
+#define _CHARACTER_CACHE_STORE_H_
+
+#include "ArenaTeam.h"
+#include "ObjectGuid.h"
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct CharacterCacheEntry
+{
+    ObjectGuid Guid;
+    std::string Name;
+    uint32 AccountId{};
+    uint8 Class{};
+    uint8 Race{};
+    uint8 Sex{};
+    uint8 Level{};
+    uint8 MailCount{};
+    ObjectGuid::LowType GuildId{};
+    std::array<uint32, MAX_ARENA_SLOT> ArenaTeamId{};
+    ObjectGuid GroupGuid;
+};
+
+// Characters known by server, one row per character and one vector per column.
+// Names are kept in one buffer, rows are found by guid and by name through open addressing tables,
+// name lookup ignores letter case. Not thread safe, see CharacterCache
+class WH_GAME_API CharacterCacheStore
+{
+public:
+    static constexpr uint32 NOT_FOUND = uint32(-1);
+
+    // Adds character or replaces character with same guid, returns row
+    uint32 Add(ObjectGuid::LowType guid, std::string_view name, uint32 accountId, uint8 gender, uint8 race, uint8 playerClass, uint8 level);
+
+    // Last row is moved to removed one, row numbers are valid only until next Add or Remove
+    void Remove(uint32 row);
+    void Rename(uint32 row, std::string_view name);
+    void Reserve(std::size_t count);
+    void Clear();
+
+    [[nodiscard]] uint32 Find(ObjectGuid::LowType guid) const;
+    [[nodiscard]] uint32 FindByName(std::string_view name) const;
+
+    [[nodiscard]] std::size_t size() const { return _guids.size(); }
+    [[nodiscard]] std::size_t GetMemoryUsage() const;
+
+    [[nodiscard]] CharacterCacheEntry GetEntry(uint32 row) const;
+
+    [[nodiscard]] ObjectGuid::LowType GetGuid(uint32 row) const { return _guids[row]; }
+    [[nodiscard]] std::string_view GetName(uint32 row) const { return { _names.data() + _nameOffsets[row], _nameLengths[row] }; }
+    [[nodiscard]] uint32 GetAccountId(uint32 row) const { return _accountIds[row]; }
+    [[nodiscard]] uint8 GetRace(uint32 row) const { return _races[row]; }
+    [[nodiscard]] uint8 GetLevel(uint32 row) const { return _levels[row]; }
+    [[nodiscard]] uint8 GetMailCount(uint32 row) const { return _mailCounts[row]; }
+    [[nodiscard]] ObjectGuid::LowType GetGuildId(uint32 row) const { return _guildIds[row]; }
+    [[nodiscard]] uint32 GetArenaTeamId(uint32 row, uint8 slot) const { return _arenaTeamIds[row][slot]; }
+    [[nodiscard]] ObjectGuid::LowType GetGroupId(uint32 row) const { return _groupIds[row]; }
+
+    void SetGender(uint32 row, uint8 gender) { _genders[row] = gender; }
+    void SetRace(uint32 row, uint8 race) { _races[row] = race; }
+    void SetLevel(uint32 row, uint8 level) { _levels[row] = level; }
+    void SetAccountId(uint32 row, uint32 accountId) { _accountIds[row] = accountId; }
+    void SetMailCount(uint32 row, uint8 count) { _mailCounts[row] = count; }
+    void SetGuildId(uint32 row, ObjectGuid::LowType guildId) { _guildIds[row] = guildId; }
+    void SetArenaTeamId(uint32 row, uint8 slot, uint32 arenaTeamId) { _arenaTeamIds[row][slot] = arenaTeamId; }
+    void SetGroupId(uint32 row, ObjectGuid::LowType groupId) { _groupIds[row] = groupId; }
+
+private:
+    // Row numbers with their hash, row is NOT_FOUND in empty slot
+    class Index
+    {
+    public:
+        template<typename Equal>
+        [[nodiscard]] uint32 Find(uint32 hash, Equal&& equal) const
+        {
+            if (_slots.empty())
+                return NOT_FOUND;
+
+            std::size_t const mask = _slots.size() - 1;
+
+            for (std::size_t index = hash & mask;; index = (index + 1) & mask)
+            {
+                Slot const& slot = _slots[index];
+
+                if (slot.Row == NOT_FOUND)
+                    return NOT_FOUND;
+
+                if (slot.Hash == hash && equal(slot.Row))
+                    return slot.Row;
+            }
+        }
+
+        void Insert(uint32 hash, uint32 row);
+        void Reserve(std::size_t count);
+        void Erase(uint32 hash, uint32 row);
+        void Replace(uint32 hash, uint32 oldRow, uint32 newRow);
+        void Clear() { _slots.clear(); _size = 0; }
+
+        [[nodiscard]] std::size_t GetMemoryUsage() const { return _slots.capacity() * sizeof(Slot); }
+
+    private:
+        struct Slot
+        {
+            uint32 Row{ NOT_FOUND };
+            uint32 Hash{};
+        };
+
+        [[nodiscard]] std::size_t FindSlot(uint32 hash, uint32 row) const;
+        void Rehash(std::size_t capacity);
+
+        std::vector<Slot> _slots;
+        std::size_t _size{};
+    };
+
+    static uint32 HashGuid(ObjectGuid::LowType guid);
+    static uint32 HashName(std::string_view name);
+    static bool IsEqualName(std::string_view left, std::string_view right);
+
+    void SetName(uint32 row, std::string_view name);
+    void CompactNames();
+
+    Index _guidIndex;
+    Index _nameIndex;
+
+    std::string _names;
+    std::size_t _unusedNameBytes{};
+
+    std::vector<ObjectGuid::LowType> _guids;
+    std::vector<uint32> _nameOffsets;
+    std::vector<uint16> _nameLengths;
+    std::vector<uint32> _accountIds;
+    std::vector<uint8> _classes;
+    std::vector<uint8> _races;
+    std::vector<uint8> _genders;
+    std::vector<uint8> _levels;
+    std::vector<uint8> _mailCounts;
+    std::vector<ObjectGuid::LowType> _guildIds;
+    std::vector<std::array<uint32, MAX_ARENA_SLOT>> _arenaTeamIds;
+    std::vector<ObjectGuid::LowType> _groupIds;
+};
+
+#endif
@@ -49,6 +49,8 @@ void DBCacheMgr::AddQuery(DBCacheTable index)
     if (!_isEnableAsyncLoad)
         return;
 
+    std::lock_guard<std::mutex> guard(_queryListLock);
+
     if (_queryList.contains(index))
     {
         LOG_ERROR("db.async", "Query with index {} exist!", AsUnderlyingType(index));
@@ -86,8 +88,13 @@ QueryResult DBCacheMgr::GetResult(DBCacheTable index)
         return WorldDatabase.Query(sql);
     }
 
-    auto const& itr = _queryList.find(index);
-    if (itr == _queryList.end())
+    // loaders can get results from several threads, future is waited without lock
+    std::unique_lock<std::mutex> guard(_queryListLock);
+
+    auto node = _queryList.extract(index);
+    guard.unlock();
+
+    if (node.empty())
     {
         LOG_ERROR("db.async", "Not found query with index {}", AsUnderlyingType(index));
 
@@ -101,10 +108,8 @@ QueryResult DBCacheMgr::GetResult(DBCacheTable index)
         return WorldDatabase.Query(sql);
     }
 
-    itr->second.wait();
-    auto result{ itr->second.get() };
-    _queryList.erase(index);
-    return result;
+    node.mapped().wait();
+    return node.mapped().get();
 }
 
 std::string_view DBCacheMgr::GetStringQuery(DBCacheTable index)
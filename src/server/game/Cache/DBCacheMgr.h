@@ -20,6 +20,7 @@
 
 #include "DBCacheStrings.h"
 #include "DatabaseEnvFwd.h"
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -57,6 +58,7 @@ private:
     std::string_view GetStringQuery(DBCacheTable index);
 
     std::unordered_map<DBCacheTable, QueryResultFuture> _queryList;
+    std::mutex _queryListLock;
     std::unordered_map<DBCacheTable, std::string> _queryStrings;
     bool _isEnableAsyncLoad{};
     bool _isEnableWaitAtAdd{};
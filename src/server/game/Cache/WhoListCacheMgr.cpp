@@ -19,9 +19,21 @@
 // PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 
 #include "WhoListCacheMgr.h"
+#include "AccountMgr.h"
+#include "DBCStores.h"
 #include "GuildMgr.h"
-#include "ObjectAccessor.h"
-#include "World.h"
+#include "Player.h"
+#include "WorldSession.h"
+
+namespace
+{
+    constexpr uint32 SPECTATOR_ZONE_ID = 4395; // Dalaran
+
+    uint32 GetWhoListZoneId(Player const* player, uint32 zoneId)
+    {
+        return player->IsSpectator() ? SPECTATOR_ZONE_ID : zoneId;
+    }
+}
 
 WhoListCacheMgr* WhoListCacheMgr::instance()
 {
@@ -29,36 +41,253 @@ WhoListCacheMgr* WhoListCacheMgr::instance()
     return &instance;
 }
 
-void WhoListCacheMgr::Update()
+void WhoListCacheMgr::AddPlayer(Player const* player)
 {
-    // clear current list
-    _whoListStorage.clear();
-    _whoListStorage.reserve(sWorld->GetPlayerCount() + 1);
+    std::string const& playerName = player->GetName();
+    std::wstring widePlayerName;
+
+    if (!Utf8toWStr(playerName, widePlayerName))
+        return;
+
+    wstrToLower(widePlayerName);
 
-    for (auto const& [guid, player] : ObjectAccessor::GetPlayers())
+    std::unique_lock guard(_mutex);
+
+    auto [itr, inserted] = _rows.try_emplace(player->GetGUID(), uint32(_guids.size()));
+    if (inserted)
     {
-        if (!player->FindMap() || player->GetSession()->PlayerLoading())
-            continue;
+        _guids.emplace_back();
+        _teams.emplace_back();
+        _securities.emplace_back();
+        _levels.emplace_back();
+        _classes.emplace_back();
+        _races.emplace_back();
+        _genders.emplace_back();
+        _visible.emplace_back();
+        _zoneIds.emplace_back();
+        _guildIds.emplace_back();
+        _playerNames.emplace_back();
+        _widePlayerNames.emplace_back();
+    }
+
+    uint32 row = itr->second;
+    _guids[row] = player->GetGUID();
+    _teams[row] = uint8(player->GetTeamId());
+    _securities[row] = uint8(player->GetSession()->GetSecurity());
+    _levels[row] = player->GetLevel();
+    _classes[row] = player->getClass();
+    _races[row] = player->getRace();
+    _genders[row] = player->getGender();
+    _visible[row] = player->IsVisible();
+    _zoneIds[row] = GetWhoListZoneId(player, player->GetZoneId());
+    _guildIds[row] = player->GetGuildId();
+    _playerNames[row] = playerName;
+    _widePlayerNames[row] = std::move(widePlayerName);
+
+    CacheGuildName(player->GetGuildId());
+}
+
+void WhoListCacheMgr::RemovePlayer(ObjectGuid guid)
+{
+    std::unique_lock guard(_mutex);
+
+    auto itr = _rows.find(guid);
+    if (itr == _rows.end())
+        return;
+
+    uint32 row = itr->second;
+    uint32 lastRow = uint32(_guids.size() - 1);
+    _rows.erase(itr);
+
+    // move last row into the removed one
+    if (row != lastRow)
+    {
+        _guids[row] = _guids[lastRow];
+        _teams[row] = _teams[lastRow];
+        _securities[row] = _securities[lastRow];
+        _levels[row] = _levels[lastRow];
+        _classes[row] = _classes[lastRow];
+        _races[row] = _races[lastRow];
+        _genders[row] = _genders[lastRow];
+        _visible[row] = _visible[lastRow];
+        _zoneIds[row] = _zoneIds[lastRow];
+        _guildIds[row] = _guildIds[lastRow];
+        _playerNames[row] = std::move(_playerNames[lastRow]);
+        _widePlayerNames[row] = std::move(_widePlayerNames[lastRow]);
+        _rows[_guids[row]] = row;
+    }
+
+    _guids.pop_back();
+    _teams.pop_back();
+    _securities.pop_back();
+    _levels.pop_back();
+    _classes.pop_back();
+    _races.pop_back();
+    _genders.pop_back();
+    _visible.pop_back();
+    _zoneIds.pop_back();
+    _guildIds.pop_back();
+    _playerNames.pop_back();
+    _widePlayerNames.pop_back();
+}
+
+void WhoListCacheMgr::UpdatePlayerLevel(ObjectGuid guid, uint8 level)
+{
+    std::unique_lock guard(_mutex);
+
+    if (uint32 const* row = Warhead::Containers::MapGetValuePtr(_rows, guid))
+        _levels[*row] = level;
+}
+
+void WhoListCacheMgr::UpdatePlayerZone(Player const* player, uint32 zoneId)
+{
+    std::unique_lock guard(_mutex);
+
+    if (uint32 const* row = Warhead::Containers::MapGetValuePtr(_rows, player->GetGUID()))
+        _zoneIds[*row] = GetWhoListZoneId(player, zoneId);
+}
+
+void WhoListCacheMgr::UpdatePlayerGuild(ObjectGuid guid, uint32 guildId)
+{
+    std::unique_lock guard(_mutex);
+
+    if (uint32 const* row = Warhead::Containers::MapGetValuePtr(_rows, guid))
+    {
+        _guildIds[*row] = guildId;
+        CacheGuildName(guildId);
+    }
+}
 
-        std::string playerName = player->GetName();
-        std::wstring widePlayerName;
+void WhoListCacheMgr::UpdatePlayerVisibility(ObjectGuid guid, bool visible)
+{
+    std::unique_lock guard(_mutex);
+
+    if (uint32 const* row = Warhead::Containers::MapGetValuePtr(_rows, guid))
+        _visible[*row] = visible;
+}
 
-        if (!Utf8toWStr(playerName, widePlayerName))
+void WhoListCacheMgr::UpdateGuildName(uint32 guildId, std::string const& guildName)
+{
+    std::unique_lock guard(_mutex);
+
+    GuildName& name = _guildNames[guildId];
+    name.Name = guildName;
+    name.WideName.clear();
+
+    if (Utf8toWStr(guildName, name.WideName))
+        wstrToLower(name.WideName);
+}
+
+void WhoListCacheMgr::Search(WhoListQuery const& query, std::function<void(WhoListPlayerInfo const&)> const& fn)
+{
+    std::shared_lock guard(_mutex);
+
+    std::size_t count = _guids.size();
+    std::vector<uint8> matches(count);
+
+    bool playerAccount = AccountMgr::IsPlayerAccount(query.Security);
+    uint32 const* selfRowPtr = Warhead::Containers::MapGetValuePtr(_rows, query.PlayerGuid);
+    std::size_t selfRow = selfRowPtr ? *selfRowPtr : count;
+
+    // Numeric filters without branches, in separate passes over columns
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        matches[i] = (_levels[i] >= query.LevelMin) & (_levels[i] <= query.LevelMax) &
+            ((query.ClassMask >> _classes[i]) & 1) & ((query.RaceMask >> _races[i]) & 1);
+    }
+
+    // player can see member of other team only if AllowTwoSide.WhoList
+    // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if GM.InWhoList.Level
+    if (playerAccount)
+    {
+        uint8 team = uint8(query.Team);
+        uint8 gmLevel = uint8(query.GmLevelInWhoList);
+        uint8 allowTwoSide = query.AllowTwoSide;
+
+        for (std::size_t i = 0; i < count; ++i)
+            matches[i] &= ((_teams[i] == team) | allowTwoSide) & (_securities[i] <= gmLevel);
+    }
+
+    // hidden players are listed only to themselves and to game masters of same or higher level
+    {
+        uint8 security = uint8(query.Security);
+
+        for (std::size_t i = 0; i < count; ++i)
+            matches[i] &= _visible[i] | (i == selfRow) | (!playerAccount & (_securities[i] <= security));
+    }
+
+    if (!query.ZoneIds.empty())
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            uint8 inZone = 0;
+
+            for (uint32 zoneId : query.ZoneIds)
+                inZone |= _zoneIds[i] == zoneId;
+
+            matches[i] &= inZone;
+        }
+    }
+
+    static GuildName const noGuild;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (!matches[i])
             continue;
 
-        wstrToLower(widePlayerName);
+        std::wstring const& widePlayerName = _widePlayerNames[i];
+        if (!query.PlayerName.empty() && widePlayerName.find(query.PlayerName) == std::wstring::npos)
+            continue;
 
-        std::string guildName = sGuildMgr->GetGuildNameById(player->GetGuildId());
-        std::wstring wideGuildName;
+        GuildName const* guildName = Warhead::Containers::MapGetValuePtr(_guildNames, _guildIds[i]);
+        if (!guildName)
+            guildName = &noGuild;
 
-        if (!Utf8toWStr(guildName, wideGuildName))
+        if (!query.GuildName.empty() && guildName->WideName.find(query.GuildName) == std::wstring::npos)
             continue;
 
-        wstrToLower(wideGuildName);
+        bool show = true;
+        for (std::wstring const& str : query.Strings)
+        {
+            if (str.empty())
+                continue;
+
+            std::string areaName;
+            if (AreaTableEntry const* areaEntry = sAreaTableStore.LookupEntry(_zoneIds[i]))
+                areaName = areaEntry->area_name[query.Locale];
+
+            if (guildName->WideName.find(str) != std::wstring::npos ||
+                widePlayerName.find(str) != std::wstring::npos ||
+                Utf8FitTo(areaName, str))
+            {
+                show = true;
+                break;
+            }
 
-        _whoListStorage.emplace_back(player->GetGUID(), player->GetTeamId(), player->GetSession()->GetSecurity(), player->GetLevel(),
-            player->getClass(), player->getRace(),
-            (player->IsSpectator() ? 4395 /*Dalaran*/ : player->GetZoneId()), player->getGender(), player->IsVisible(),
-            widePlayerName, wideGuildName, playerName, guildName);
+            show = false;
+        }
+
+        if (!show)
+            continue;
+
+        fn({ _playerNames[i], guildName->Name, _levels[i], _classes[i], _races[i], _genders[i], _zoneIds[i] });
     }
 }
+
+void WhoListCacheMgr::CacheGuildName(uint32 guildId)
+{
+    if (!guildId || _guildNames.contains(guildId))
+        return;
+
+    // guild master joins new guild before it's added to GuildMgr
+    std::string guildName = sGuildMgr->GetGuildNameById(guildId);
+    if (guildName.empty())
+        return;
+
+    GuildName& name = _guildNames[guildId];
+    name.Name = std::move(guildName);
+
+    if (Utf8toWStr(name.Name, name.WideName))
+        wstrToLower(name.WideName);
+}
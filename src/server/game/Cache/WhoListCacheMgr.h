@@ -21,58 +21,44 @@
 #include "Common.h"
 #include "ObjectGuid.h"
 #include "SharedDefines.h"
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
 
-class WhoListPlayerInfo
+class Player;
+
+// Filters of CMSG_WHO and player who sent it, names are lowercase
+struct WhoListQuery
 {
-public:
-    WhoListPlayerInfo(ObjectGuid guid, TeamId team, AccountTypes security, uint8 level, uint8 clss, uint8 race, uint32 zoneid, uint8 gender, bool visible, std::wstring const& widePlayerName,
-        std::wstring const& wideGuildName, std::string const& playerName, std::string const& guildName) :
-        _guid(guid),
-        _team(team),
-        _security(security),
-        _level(level),
-        _class(clss),
-        _race(race),
-        _zoneid(zoneid),
-        _gender(gender),
-        _visible(visible),
-        _widePlayerName(widePlayerName),
-        _wideGuildName(wideGuildName),
-        _playerName(playerName),
-        _guildName(guildName) { }
-
-    ObjectGuid GetGuid() const { return _guid; }
-    TeamId GetTeamId() const { return _team; }
-    AccountTypes GetSecurity() const { return _security; }
-    uint8 GetLevel() const { return _level; }
-    uint8 GetClass() const { return _class; }
-    uint8 GetRace() const { return _race; }
-    uint32 GetZoneId() const { return _zoneid; }
-    uint8 GetGender() const { return _gender; }
-    bool IsVisible() const { return _visible; }
-    std::wstring const& GetWidePlayerName() const { return _widePlayerName; }
-    std::wstring const& GetWideGuildName() const { return _wideGuildName; }
-    std::string const& GetPlayerName() const { return _playerName; }
-    std::string const& GetGuildName() const { return _guildName; }
+    ObjectGuid PlayerGuid;
+    TeamId Team{ TEAM_NEUTRAL };
+    AccountTypes Security{ SEC_PLAYER };
+    bool AllowTwoSide{};
+    AccountTypes GmLevelInWhoList{ SEC_PLAYER };
+    LocaleConstant Locale{ LOCALE_enUS };
 
-private:
-    ObjectGuid _guid;
-    TeamId _team;
-    AccountTypes _security;
-    uint8 _level;
-    uint8 _class;
-    uint8 _race;
-    uint32 _zoneid;
-    uint8 _gender;
-    bool _visible;
-    std::wstring _widePlayerName;
-    std::wstring _wideGuildName;
-    std::string _playerName;
-    std::string _guildName;
+    uint32 LevelMin{};
+    uint32 LevelMax{};
+    uint32 RaceMask{};
+    uint32 ClassMask{};
+    std::vector<uint32> ZoneIds;
+    std::wstring PlayerName;
+    std::wstring GuildName;
+    std::vector<std::wstring> Strings;
 };
 
-using WhoListInfoVector = std::vector<WhoListPlayerInfo>;
+struct WhoListPlayerInfo
+{
+    std::string const& PlayerName;
+    std::string const& GuildName;
+    uint8 Level;
+    uint8 Class;
+    uint8 Race;
+    uint8 Gender;
+    uint32 ZoneId;
+};
 
+// Online players listed by /who, updated on login, logout, level, zone, guild and visibility change
 class WH_GAME_API WhoListCacheMgr
 {
     WhoListCacheMgr() = default;
@@ -86,11 +72,46 @@ class WH_GAME_API WhoListCacheMgr
 public:
     static WhoListCacheMgr* instance();
 
-    void Update();
-    WhoListInfoVector const& GetWhoList() const { return _whoListStorage; }
+    void AddPlayer(Player const* player);
+    void RemovePlayer(ObjectGuid guid);
+
+    void UpdatePlayerLevel(ObjectGuid guid, uint8 level);
+    void UpdatePlayerZone(Player const* player, uint32 zoneId);
+    void UpdatePlayerGuild(ObjectGuid guid, uint32 guildId);
+    void UpdatePlayerVisibility(ObjectGuid guid, bool visible);
+    void UpdateGuildName(uint32 guildId, std::string const& guildName);
+
+    // calls fn for every player matching query, in no particular order
+    void Search(WhoListQuery const& query, std::function<void(WhoListPlayerInfo const&)> const& fn);
+
+private:
+    struct GuildName
+    {
+        std::string Name;
+        std::wstring WideName;
+    };
+
+    // names of guilds not registered in GuildMgr yet are not cached, see UpdateGuildName
+    void CacheGuildName(uint32 guildId);
+
+    std::shared_mutex _mutex;
+    std::unordered_map<ObjectGuid, uint32> _rows;
+
+    // one row per player, columns filtered separately
+    std::vector<ObjectGuid> _guids;
+    std::vector<uint8> _teams;
+    std::vector<uint8> _securities;
+    std::vector<uint8> _levels;
+    std::vector<uint8> _classes;
+    std::vector<uint8> _races;
+    std::vector<uint8> _genders;
+    std::vector<uint8> _visible;
+    std::vector<uint32> _zoneIds;
+    std::vector<uint32> _guildIds;
+    std::vector<std::string> _playerNames;
+    std::vector<std::wstring> _widePlayerNames;
 
-protected:
-    WhoListInfoVector _whoListStorage;
+    std::unordered_map<uint32, GuildName> _guildNames;
 };
 
 #define sWhoListCacheMgr WhoListCacheMgr::instance()
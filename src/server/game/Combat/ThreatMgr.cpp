@@ -28,6 +28,8 @@
 #include "SpellMgr.h"
 #include "Unit.h"
 #include "UnitEvents.h"
+#include <algorithm>
+#include <iterator>
 
 //==============================================================
 //================= ThreatCalcHelper ===========================
@@ -100,6 +102,8 @@ HostileReference::HostileReference(Unit* refUnit, ThreatMgr* threatMgr, float th
     link(refUnit, threatMgr);
     iUnitGuid = refUnit->GetGUID();
     iOnline = true;
+    iSlot = 0;
+    iThreatChanged = false;
 }
 
 //============================================================
@@ -257,6 +261,44 @@ void ThreatContainer::clearReferences()
     }
 
     iThreatList.clear();
+    iReferencesByGuid.clear();
+    iHasChangedReferences = false;
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    hostileRef->iSlot = iThreatList.size();
+    iThreatList.push_back(hostileRef);
+    iReferencesByGuid[hostileRef->getUnitGuid()] = hostileRef;
+
+    // new references are put in order with the next update
+    threatChanged(hostileRef);
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    auto itr = iReferencesByGuid.find(hostileRef->getUnitGuid());
+    if (itr == iReferencesByGuid.end() || itr->second != hostileRef)
+        return;
+
+    iReferencesByGuid.erase(itr);
+
+    ASSERT(hostileRef->iSlot < iThreatList.size() && iThreatList[hostileRef->iSlot] == hostileRef);
+    iThreatList.erase(iThreatList.begin() + hostileRef->iSlot);
+    for (uint32 slot = hostileRef->iSlot; slot < iThreatList.size(); ++slot)
+        iThreatList[slot]->iSlot = slot;
+}
+
+//============================================================
+
+void ThreatContainer::threatChanged(HostileReference* hostileRef)
+{
+    hostileRef->iThreatChanged = true;
+    iHasChangedReferences = true;
 }
 
 //============================================================
@@ -271,16 +313,8 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit const* victim) cons
 
 HostileReference* ThreatContainer::getReferenceByTarget(ObjectGuid const& guid) const
 {
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        HostileReference* ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-        {
-            return ref;
-        }
-    }
-
-    return nullptr;
+    auto itr = iReferencesByGuid.find(guid);
+    return itr != iReferencesByGuid.end() ? itr->second : nullptr;
 }
 
 //============================================================
@@ -303,12 +337,36 @@ void ThreatContainer::ModifyThreatByPercent(Unit* victim, int32 percent)
 }
 
 //============================================================
-// Check if the list is dirty and sort if necessary
+// Check if the list is dirty and order it if necessary
+// References with unchanged threat are still ordered, so only the changed ones are sorted and merged back
 
 void ThreatContainer::update()
 {
-    if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Warhead::ThreatOrderPred());
+    if (iDirty && iHasChangedReferences)
+    {
+        iChangedReferences.clear();
+        auto unchangedEnd = std::remove_if(iThreatList.begin(), iThreatList.end(), [this](HostileReference* ref)
+        {
+            if (!ref->iThreatChanged)
+                return false;
+
+            ref->iThreatChanged = false;
+            iChangedReferences.push_back(ref);
+            return true;
+        });
+
+        // remove_if keeps the relative order of the unchanged references
+        std::sort(iChangedReferences.begin(), iChangedReferences.end(), Warhead::ThreatOrderPred());
+
+        iMergedReferences.clear();
+        std::merge(iThreatList.begin(), unchangedEnd, iChangedReferences.begin(), iChangedReferences.end(), std::back_inserter(iMergedReferences), Warhead::ThreatOrderPred());
+        iThreatList.swap(iMergedReferences);
+
+        for (uint32 slot = 0; slot < iThreatList.size(); ++slot)
+            iThreatList[slot]->iSlot = slot;
+
+        iHasChangedReferences = false;
+    }
 
     iDirty = false;
 }
@@ -594,6 +652,8 @@ void ThreatMgr::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStatusCh
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
+            if (hostileRef->IsOnline())
+                iThreatContainer.threatChanged(hostileRef);
             if ((getCurrentVictim() == hostileRef && threatRefStatusChangeEvent->getFValue() < 0.0f) ||
                     (getCurrentVictim() != hostileRef && threatRefStatusChangeEvent->getFValue() > 0.0f))
                 setDirty(true);                             // the order in the threat list might have changed
@@ -617,8 +677,8 @@ void ThreatMgr::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStatusCh
             {
                 if (getCurrentVictim() && hostileRef->GetThreat() > (1.1f * getCurrentVictim()->GetThreat()))
                     setDirty(true);
-                iThreatContainer.addReference(hostileRef);
                 iThreatOfflineContainer.remove(hostileRef);
+                iThreatContainer.addReference(hostileRef);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
@@ -657,8 +717,9 @@ void ThreatMgr::ResetAllThreat()
     if (threatList.empty())
         return;
 
-    for (ThreatContainer::StorageType::iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
-        (*itr)->SetThreat(0);
+    // threat of pet owners may be added while iterating, which can grow the list
+    for (std::size_t i = 0; i < threatList.size(); ++i)
+        threatList[i]->SetThreat(0);
 
     setDirty(true);
 }
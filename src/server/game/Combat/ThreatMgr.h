@@ -23,7 +23,8 @@
 #include "Reference.h"
 #include "SharedDefines.h"
 #include "UnitEvents.h"
-#include <list>
+#include <unordered_map>
+#include <vector>
 
 //==============================================================
 
@@ -46,6 +47,8 @@ struct ThreatCalcHelper
 //==============================================================
 class WH_GAME_API HostileReference : public Reference<Unit, ThreatMgr>
 {
+    friend class ThreatContainer;
+
 public:
     HostileReference(Unit* refUnit, ThreatMgr* threatMgr, float threat);
 
@@ -134,17 +137,22 @@ private:
     float iTempThreatModifier;                          // used for taunt
     ObjectGuid iUnitGuid;
     bool iOnline;
+    uint32 iSlot;                                       // index in threat list of the container holding this reference
+    bool iThreatChanged;                                // threat changed since the container was last ordered
 };
 
 //==============================================================
 class ThreatMgr;
 
+// References are kept in a contiguous list ordered by threat, with lookup by target guid.
+// Threat changes only flag the reference, the order is repaired in update() by merging
+// the changed references back into the list instead of sorting all of it.
 class WH_GAME_API ThreatContainer
 {
     friend class ThreatMgr;
 
 public:
-    typedef std::list<HostileReference*> StorageType;
+    typedef std::vector<HostileReference*> StorageType;
 
     ThreatContainer() = default;
 
@@ -176,22 +184,22 @@ public:
     [[nodiscard]] StorageType const& GetThreatList() const { return iThreatList; }
 
 private:
-    void remove(HostileReference* hostileRef)
-    {
-        iThreatList.remove(hostileRef);
-    }
+    void remove(HostileReference* hostileRef);
+    void addReference(HostileReference* hostileRef);
 
-    void addReference(HostileReference* hostileRef)
-    {
-        iThreatList.push_back(hostileRef);
-    }
+    // Threat of the reference changed, its place in the list has to be checked in next update
+    void threatChanged(HostileReference* hostileRef);
 
     void clearReferences();
 
-    // Sort the list if necessary
+    // Order the list if necessary
     void update();
 
     StorageType iThreatList;
+    std::unordered_map<ObjectGuid, HostileReference*> iReferencesByGuid;
+    StorageType iChangedReferences;                     // buffers of update(), kept to reuse their memory
+    StorageType iMergedReferences;
+    bool iHasChangedReferences{false};
     bool iDirty{false};
 };
 
@@ -224,8 +232,8 @@ public:
     [[nodiscard]] bool isThreatListEmpty() const { return iThreatContainer.empty(); }
     [[nodiscard]] bool areThreatListsEmpty() const { return iThreatContainer.empty() && iThreatOfflineContainer.empty(); }
 
-    [[nodiscard]] Warhead::IteratorPair<std::list<ThreatReference*>::const_iterator> GetSortedThreatList() const { auto& list = iThreatContainer.GetThreatList(); return { list.cbegin(), list.cend() }; }
-    [[nodiscard]] Warhead::IteratorPair<std::list<ThreatReference*>::const_iterator> GetUnsortedThreatList() const { return GetSortedThreatList(); }
+    [[nodiscard]] Warhead::IteratorPair<ThreatContainer::StorageType::const_iterator> GetSortedThreatList() const { auto& list = iThreatContainer.GetThreatList(); return { list.cbegin(), list.cend() }; }
+    [[nodiscard]] Warhead::IteratorPair<ThreatContainer::StorageType::const_iterator> GetUnsortedThreatList() const { return GetSortedThreatList(); }
 
     void processThreatEvent(ThreatRefStatusChangeEvent* threatRefStatusChangeEvent);
 
@@ -258,8 +266,10 @@ public:
         if (threatList.empty())
             return;
 
-        for (auto& ref : threatList)
+        // threat of pet owners may be added while iterating, which can grow the list
+        for (std::size_t i = 0; i < threatList.size(); ++i)
         {
+            HostileReference* ref = threatList[i];
             if (predicate(ref->getTarget()))
             {
                 ref->SetThreat(0);
@@ -274,6 +284,7 @@ public:
     [[nodiscard]] ThreatContainer::StorageType const& GetOfflineThreatList() const { return iThreatOfflineContainer.GetThreatList(); }
     ThreatContainer& GetOnlineContainer() { return iThreatContainer; }
     ThreatContainer& GetOfflineContainer() { return iThreatOfflineContainer; }
+    [[nodiscard]] ThreatContainer const& GetOnlineContainer() const { return iThreatContainer; }
 
 private:
     HostileReference* FindReference(Unit const* who, bool includeOffline) const { if (auto* ref = iThreatContainer.getReferenceByTarget(who)) return ref; if (includeOffline) if (auto* ref = iThreatOfflineContainer.getReferenceByTarget(who)) return ref; return nullptr; }
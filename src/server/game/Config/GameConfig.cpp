@@ -39,6 +39,7 @@ void GameConfig::Load(bool reload)
     LOG_INFO("server.loading", "{} game configuraton:", reload ? "Reloading" : "Loading");
 
     LoadConfigs(reload);
+    PublishRegisteredOptions();
     CheckOptions(reload);
 
     LOG_INFO("server.loading", "");
@@ -149,6 +150,105 @@ void GameConfig::SetOption(std::string_view optionName, T value)
 
     _configOptions.erase(option);
     _configOptions.emplace(option, valueStr);
+    cacheLock.unlock();
+
+    // Update typed value if option is registered
+    std::lock_guard<std::mutex> guard(_optionIdsMutex);
+
+    auto const& itr = _optionIds.find(option);
+    if (itr != _optionIds.end())
+        PublishOption(GetSlot(itr->second));
+}
+
+// Register option
+template<Warhead::Types::ConfigValue T>
+GameConfigOptionId GameConfig::RegisterOption(std::string_view optionName)
+{
+    return RegisterOption(optionName, Warhead::Config::GetDefaultValueString<T>(std::nullopt));
+}
+
+GameConfigOptionId GameConfig::RegisterOption(std::string_view optionName, std::string_view defaultValue)
+{
+    std::string option{ optionName };
+
+    std::lock_guard<std::mutex> guard(_optionIdsMutex);
+
+    auto const& itr = _optionIds.find(option);
+    if (itr != _optionIds.end())
+        return itr->second;
+
+    uint32 index = _optionSlotCount;
+    uint32 chunkIndex = index / OPTION_SLOT_CHUNK_SIZE;
+
+    if (chunkIndex >= MAX_OPTION_SLOT_CHUNKS)
+    {
+        LOG_CRIT("server.loading", "> GameConfig::RegisterOption: too many registered options, can't register ({})", optionName);
+        ABORT();
+    }
+
+    if (!_optionSlotChunks[chunkIndex])
+        _optionSlotChunks[chunkIndex] = std::make_unique<OptionSlotChunk>();
+
+    GameConfigOptionId id = static_cast<GameConfigOptionId>(index);
+    GameConfigOptionSlot& slot = GetSlot(id);
+    slot.Name = option;
+    slot.DefaultValue = defaultValue;
+
+    PublishOption(slot);
+
+    _optionIds.emplace(option, id);
+    ++_optionSlotCount;
+
+    return id;
+}
+
+void GameConfig::PublishOption(GameConfigOptionSlot& slot)
+{
+    Optional<std::string> value;
+
+    {
+        std::shared_lock cacheLock(_mutex);
+
+        auto const& itr = _configOptions.find(slot.Name);
+        if (itr != _configOptions.end())
+            value = itr->second;
+    }
+
+    // Option not loaded yet or removed at reload - add it like GetOption does
+    if (!value)
+    {
+        value = sConfigMgr->GetOption<std::string>(slot.Name, slot.DefaultValue);
+
+        std::unique_lock cacheLock(_mutex);
+        _configOptions.emplace(slot.Name, *value);
+    }
+
+    auto Publish = [&slot](GameConfigOptionSlot::ValueType type, Optional<uint32> bits)
+    {
+        slot.Values[type].store(bits ? GameConfigOptionSlot::PARSED_FLAG | *bits : 0, std::memory_order_relaxed);
+    };
+
+    Optional<bool> boolValue = Warhead::StringTo<bool>(*value);
+    Publish(GameConfigOptionSlot::VALUE_BOOL, boolValue ? Optional<uint32>(*boolValue ? 1 : 0) : std::nullopt);
+
+    Optional<int32> intValue = Warhead::StringTo<int32>(*value);
+    Publish(GameConfigOptionSlot::VALUE_INT, intValue ? Optional<uint32>(static_cast<uint32>(*intValue)) : std::nullopt);
+
+    Publish(GameConfigOptionSlot::VALUE_UINT, Warhead::StringTo<uint32>(*value));
+
+    Optional<float> floatValue = Warhead::StringTo<float>(*value);
+    Publish(GameConfigOptionSlot::VALUE_FLOAT, floatValue ? Optional<uint32>(std::bit_cast<uint32>(*floatValue)) : std::nullopt);
+}
+
+void GameConfig::PublishRegisteredOptions()
+{
+    std::lock_guard<std::mutex> guard(_optionIdsMutex);
+
+    for (uint32 i = 0; i < _optionSlotCount; ++i)
+        PublishOption(GetSlot(static_cast<GameConfigOptionId>(i)));
+
+    if (_optionSlotCount)
+        LOG_INFO("server.loading", "> Updated {} typed config options", _optionSlotCount);
 }
 
 // Loading
@@ -202,7 +302,7 @@ void GameConfig::CheckOptions(bool reload /*= false*/)
     ///- Read all rates from the config file
     auto CheckRate = [this](std::string const& optionName)
     {
-        auto _rate = CONF_GET_FLOAT(optionName);
+        auto _rate = GetOption<float>(optionName);
 
         if (_rate < 0.0f)
         {
@@ -260,7 +360,7 @@ void GameConfig::CheckOptions(bool reload /*= false*/)
 
     auto CheckDurabilityLossChance = [this](std::string const& optionName)
     {
-        float option = CONF_GET_FLOAT(optionName);
+        float option = GetOption<float>(optionName);
         if (option < 0.0f)
         {
             LOG_ERROR("server.loading", "{} ({}) must be >= 0. Using 0.0 instead", optionName, option);
@@ -300,7 +400,7 @@ void GameConfig::CheckOptions(bool reload /*= false*/)
 
     auto CheckMinName = [this](std::string const& optionName, int32 const& maxNameSymols)
     {
-        int32 confSymbols = CONF_GET_INT(optionName);
+        int32 confSymbols = GetOption<int32>(optionName);
         if (confSymbols < 1 || confSymbols > maxNameSymols)
         {
             LOG_ERROR("server.loading", "{} ({}) must be in range 1..{}. Set to 2.", optionName, confSymbols, maxNameSymols);
@@ -386,14 +486,14 @@ void GameConfig::CheckOptions(bool reload /*= false*/)
 
     auto CheckPoints = [this](std::string const& startPointsOptionName, std::string const& maxPointsOptionName)
     {
-        int32 maxPoints = CONF_GET_INT(maxPointsOptionName);
+        int32 maxPoints = GetOption<int32>(maxPointsOptionName);
         if (maxPoints < 0)
         {
             LOG_ERROR("server.loading", "{} ({}) can't be negative. Set to 0.", maxPointsOptionName, maxPoints);
             SetOption<int32>(maxPointsOptionName, 0);
         }
 
-        int32 startPoints = CONF_GET_INT(startPointsOptionName);
+        int32 startPoints = GetOption<int32>(startPointsOptionName);
         if (startPoints < 0)
         {
             LOG_ERROR("server.loading", "{} ({}) must be in range 0..{}({}). Set to {}.", startPointsOptionName, startPoints, maxPointsOptionName, maxPoints, 0);
@@ -475,7 +575,7 @@ void GameConfig::CheckOptions(bool reload /*= false*/)
 
     auto CheckResetTime = [this](std::string const& optionName)
     {
-        int32 hours = CONF_GET_INT(optionName);
+        int32 hours = GetOption<int32>(optionName);
         if (hours > 23)
         {
             LOG_ERROR("server.loading", "{} ({}) can't be load. Set to 6.", optionName, hours);
@@ -503,7 +603,7 @@ void GameConfig::CheckOptions(bool reload /*= false*/)
 
     auto CheckBuffBG = [this](std::string const& optionName, uint32 defaultTime)
     {
-        uint32 time = CONF_GET_INT(optionName);
+        uint32 time = GetOption<int32>(optionName);
         if (time < 1)
         {
             LOG_ERROR("server.loading", "{} ({}) must be > 0. Using {} instead.", optionName, defaultTime);
@@ -532,7 +632,7 @@ void GameConfig::CheckOptions(bool reload /*= false*/)
 
     auto CheckLogRecordsCount = [this](std::string const& optionName, int32 const& maxRecords)
     {
-        int32 records = CONF_GET_INT(optionName);
+        int32 records = GetOption<int32>(optionName);
         if (records > maxRecords)
             SetOption<int32>(optionName, maxRecords);
     };
@@ -557,7 +657,8 @@ void GameConfig::CheckOptions(bool reload /*= false*/)
 
 #define TEMPLATE_GAME_CONFIG_OPTION(__typename) \
     template WH_GAME_API __typename GameConfig::GetOption(std::string_view optionName, Optional<__typename> def /*= std::nullopt*/); \
-    template WH_GAME_API void GameConfig::SetOption(std::string_view optionName, __typename value);
+    template WH_GAME_API void GameConfig::SetOption(std::string_view optionName, __typename value); \
+    template WH_GAME_API GameConfigOptionId GameConfig::RegisterOption<__typename>(std::string_view optionName);
 
 TEMPLATE_GAME_CONFIG_OPTION(bool)
 TEMPLATE_GAME_CONFIG_OPTION(uint8)
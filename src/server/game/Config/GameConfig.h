@@ -21,9 +21,41 @@
 #include "Define.h"
 #include "Optional.h"
 #include "Types.h"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
 
+// Numeric handle of an option registered in the typed option table
+enum class GameConfigOptionId : uint32 { };
+
+// Typed values of a registered option, parsed once on load/reload/set.
+// Each value is published together with its parsed flag in one relaxed atomic word,
+// so readers never lock and never see a flag of one value with the bits of another
+struct GameConfigOptionSlot
+{
+    enum ValueType : uint8
+    {
+        VALUE_BOOL,
+        VALUE_INT,
+        VALUE_UINT,
+        VALUE_FLOAT,
+
+        MAX_VALUE_TYPE
+    };
+
+    static constexpr uint64 PARSED_FLAG = uint64(1) << 32;
+
+    std::string Name;
+    std::string DefaultValue;
+
+    // PARSED_FLAG | 32 bits of value, 0 when option value can't be parsed as the type
+    std::array<std::atomic<uint64>, MAX_VALUE_TYPE> Values{};
+};
+
 class WH_GAME_API GameConfig
 {
     GameConfig(GameConfig const&) = delete;
@@ -58,19 +90,83 @@ public:
     template<Warhead::Types::ConfigValue T>
     void SetOption(std::string_view optionName, T value);
 
+    // Register option in typed table and return its id. Called once per call site by CONF_GET_* macros
+    template<Warhead::Types::ConfigValue T>
+    GameConfigOptionId RegisterOption(std::string_view optionName);
+
+    // Get registered option without string lookup, allocation or parsing
+    template<Warhead::Types::ConfigValue T>
+    inline T GetOption(GameConfigOptionId id)
+    {
+        GameConfigOptionSlot const& slot = GetSlot(id);
+
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            if (uint64 value = slot.Values[GameConfigOptionSlot::VALUE_BOOL].load(std::memory_order_relaxed))
+                return static_cast<uint32>(value) != 0;
+        }
+        else if constexpr (std::is_same_v<T, int32>)
+        {
+            if (uint64 value = slot.Values[GameConfigOptionSlot::VALUE_INT].load(std::memory_order_relaxed))
+                return static_cast<int32>(static_cast<uint32>(value));
+        }
+        else if constexpr (std::is_same_v<T, uint32>)
+        {
+            if (uint64 value = slot.Values[GameConfigOptionSlot::VALUE_UINT].load(std::memory_order_relaxed))
+                return static_cast<uint32>(value);
+        }
+        else if constexpr (std::is_same_v<T, float>)
+        {
+            if (uint64 value = slot.Values[GameConfigOptionSlot::VALUE_FLOAT].load(std::memory_order_relaxed))
+                return std::bit_cast<float>(static_cast<uint32>(value));
+        }
+
+        // Bad value or unsupported type - use slow path for error report and default value
+        return GetOption<T>(slot.Name);
+    }
+
 private:
+    static constexpr uint32 OPTION_SLOT_CHUNK_SIZE = 256;
+    static constexpr uint32 MAX_OPTION_SLOT_CHUNKS = 32;
+
+    struct OptionSlotChunk
+    {
+        std::array<GameConfigOptionSlot, OPTION_SLOT_CHUNK_SIZE> Slots;
+    };
+
     void LoadConfigs(bool reload = false);
 
+    // Slots storage never moves, ids are handed out only after slot is fully initialized
+    inline GameConfigOptionSlot& GetSlot(GameConfigOptionId id) const
+    {
+        uint32 index = static_cast<uint32>(id);
+        return _optionSlotChunks[index / OPTION_SLOT_CHUNK_SIZE]->Slots[index % OPTION_SLOT_CHUNK_SIZE];
+    }
+
+    GameConfigOptionId RegisterOption(std::string_view optionName, std::string_view defaultValue);
+    void PublishOption(GameConfigOptionSlot& slot);
+    void PublishRegisteredOptions();
+
     std::unordered_map<std::string /*name*/, std::string /*value*/> _configOptions;
     std::shared_mutex _mutex;
+
+    // Typed option table
+    std::array<std::unique_ptr<OptionSlotChunk>, MAX_OPTION_SLOT_CHUNKS> _optionSlotChunks;
+    std::unordered_map<std::string /*name*/, GameConfigOptionId> _optionIds;
+    uint32 _optionSlotCount{ 0 };
+    std::mutex _optionIdsMutex;
 };
 
 #define sGameConfig GameConfig::instance()
 
-#define CONF_GET_BOOL(__optionName) sGameConfig->GetOption<bool>(__optionName)
+// Resolve option id once per call site. Option name must be a constant, use sGameConfig->GetOption for runtime names
+#define CONF_OPTION_ID(__optionName, __typename) \
+    [] { static GameConfigOptionId const optionId = sGameConfig->RegisterOption<__typename>(__optionName); return optionId; }()
+
+#define CONF_GET_BOOL(__optionName) sGameConfig->GetOption<bool>(CONF_OPTION_ID(__optionName, bool))
 #define CONF_GET_STR(__optionName) sGameConfig->GetOption<std::string>(__optionName)
-#define CONF_GET_INT(__optionName) sGameConfig->GetOption<int32>(__optionName)
-#define CONF_GET_UINT(__optionName) sGameConfig->GetOption<uint32>(__optionName)
-#define CONF_GET_FLOAT(__optionName) sGameConfig->GetOption<float>(__optionName)
+#define CONF_GET_INT(__optionName) sGameConfig->GetOption<int32>(CONF_OPTION_ID(__optionName, int32))
+#define CONF_GET_UINT(__optionName) sGameConfig->GetOption<uint32>(CONF_OPTION_ID(__optionName, uint32))
+#define CONF_GET_FLOAT(__optionName) sGameConfig->GetOption<float>(CONF_OPTION_ID(__optionName, float))
 
 #endif // __GAME_CONFIG
@@ -302,7 +302,7 @@ namespace lfg
 
     void AddSC_LFGScripts()
     {
-        new LFGPlayerScript();
+        RegisterHookedScript<LFGPlayerScript>();
         new LFGGroupScript();
     }
 
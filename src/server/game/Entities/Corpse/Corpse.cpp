@@ -221,35 +221,7 @@ void Corpse::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
 
             if (index == CORPSE_FIELD_BYTES_1 || index == CORPSE_FIELD_BYTES_2)
             {
-                Player* owner = ObjectAccessor::GetPlayer(*this, GetOwnerGUID());
-                if (owner && owner != target && CONF_GET_BOOL("AllowTwoSide.Interaction.Group") && owner->IsInRaidWith(target) && owner->GetTeamId() != target->GetTeamId())
-                {
-                    uint32 playerBytes = target->GetUInt32Value(PLAYER_BYTES);
-                    uint32 playerBytes2 = target->GetUInt32Value(PLAYER_BYTES_2);
-
-                    uint8 race = target->getRace();
-                    uint8 skin = (uint8)(playerBytes);
-                    uint8 face = (uint8)(playerBytes >> 8);
-                    uint8 hairstyle = (uint8)(playerBytes >> 16);
-                    uint8 haircolor = (uint8)(playerBytes >> 24);
-                    uint8 facialhair = (uint8)(playerBytes2);
-
-                    uint32 corpseBytes1 = ((0x00) | (race << 8) | (target->GetByteValue(PLAYER_BYTES_3, 0) << 16) | (skin << 24));
-                    uint32 corpseBytes2 = ((face) | (hairstyle << 8) | (haircolor << 16) | (facialhair << 24));
-
-                    if (index == CORPSE_FIELD_BYTES_1)
-                    {
-                        fieldBuffer << corpseBytes1;
-                    }
-                    else
-                    {
-                        fieldBuffer << corpseBytes2;
-                    }
-                }
-                else
-                {
-                    fieldBuffer << m_uint32Values[index];
-                }
+                fieldBuffer << GetViewerDependentUpdateFieldValue(index, target);
             }
             else
             {
@@ -262,3 +234,33 @@ void Corpse::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
     updateMask.AppendToPacket(data);
     data->append(fieldBuffer);
 }
+
+bool Corpse::IsViewerDependentUpdateField(uint16 index) const
+{
+    return index == CORPSE_FIELD_BYTES_1 || index == CORPSE_FIELD_BYTES_2;
+}
+
+uint32 Corpse::GetViewerDependentUpdateFieldValue(uint16 index, Player* target) const
+{
+    if (index != CORPSE_FIELD_BYTES_1 && index != CORPSE_FIELD_BYTES_2)
+        return m_uint32Values[index];
+
+    Player* owner = ObjectAccessor::GetPlayer(*this, GetOwnerGUID());
+    if (!owner || owner == target || !CONF_GET_BOOL("AllowTwoSide.Interaction.Group") || !owner->IsInRaidWith(target) || owner->GetTeamId() == target->GetTeamId())
+        return m_uint32Values[index];
+
+    uint32 playerBytes = target->GetUInt32Value(PLAYER_BYTES);
+    uint32 playerBytes2 = target->GetUInt32Value(PLAYER_BYTES_2);
+
+    uint8 race = target->getRace();
+    uint8 skin = (uint8)(playerBytes);
+    uint8 face = (uint8)(playerBytes >> 8);
+    uint8 hairstyle = (uint8)(playerBytes >> 16);
+    uint8 haircolor = (uint8)(playerBytes >> 24);
+    uint8 facialhair = (uint8)(playerBytes2);
+
+    if (index == CORPSE_FIELD_BYTES_1)
+        return ((0x00) | (race << 8) | (target->GetByteValue(PLAYER_BYTES_3, 0) << 16) | (skin << 24));
+
+    return ((face) | (hairstyle << 8) | (haircolor << 16) | (facialhair << 24));
+}
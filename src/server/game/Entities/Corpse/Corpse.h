@@ -56,6 +56,8 @@ public:
     void RemoveFromWorld() override;
 
     void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const override;
+    [[nodiscard]] bool IsViewerDependentUpdateField(uint16 index) const override;
+    [[nodiscard]] uint32 GetViewerDependentUpdateFieldValue(uint16 index, Player* target) const override;
 
     bool Create(ObjectGuid::LowType guidlow);
     bool Create(ObjectGuid::LowType guidlow, Player* owner);
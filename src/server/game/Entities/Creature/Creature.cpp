@@ -271,9 +271,7 @@ void Creature::AddToWorld()
 
         GetMap()->GetObjectsStore().Insert<Creature>(GetGUID(), this);
         if (m_spawnId)
-        {
-            GetMap()->GetCreatureBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
-        }
+            GetMap()->AddToSpawnIdStore(this);
         Unit::AddToWorld();
 
         SearchFormation();
@@ -314,7 +312,7 @@ void Creature::RemoveFromWorld()
         Unit::RemoveFromWorld();
 
         if (m_spawnId)
-            Warhead::Containers::MultimapErasePair(GetMap()->GetCreatureBySpawnIdStore(), m_spawnId, this);
+            GetMap()->RemoveFromSpawnIdStore(this);
 
         GetMap()->GetObjectsStore().Remove<Creature>(GetGUID());
     }
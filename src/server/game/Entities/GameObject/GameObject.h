@@ -125,6 +125,8 @@ public:
     ~GameObject() override;
 
     void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+    [[nodiscard]] bool IsViewerDependentUpdateField(uint16 index) const override;
+    [[nodiscard]] uint32 GetViewerDependentUpdateFieldValue(uint16 index, Player* target) const override;
 
     void AddToWorld() override;
     void RemoveFromWorld() override;
@@ -54,6 +54,7 @@
 #include "Util.h"
 #include "Vehicle.h"
 #include "WorldPacket.h"
+#include <bit>
 #include <sstream>
 
 /// @todo: this import is not necessary for compilation and marked as unused by the IDE
@@ -512,6 +513,13 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
 
     for (uint16 index = 0; index < m_valuesCount; ++index)
     {
+        // skip whole mask blocks without changed or always sent fields
+        if (updateType == UPDATETYPE_VALUES && !(index % UpdateMask::CLIENT_UPDATE_MASK_BITS) && IsValuesBlockUnchanged(index / UpdateMask::CLIENT_UPDATE_MASK_BITS, flags, _fieldNotifyFlags))
+        {
+            index += UpdateMask::CLIENT_UPDATE_MASK_BITS - 1;
+            continue;
+        }
+
         if (_fieldNotifyFlags & flags[index] ||
                 ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)))
         {
@@ -546,7 +554,22 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+bool Object::IsValuesBlockUnchanged(uint32 block, uint32 const* flags, uint32 alwaysSentFlags) const
+{
+    if (_changesMask.HasBitInBlock(block))
+        return false;
+
+    uint32 first = block * UpdateMask::CLIENT_UPDATE_MASK_BITS;
+    uint32 last = std::min<uint32>(first + UpdateMask::CLIENT_UPDATE_MASK_BITS, m_valuesCount);
+
+    uint32 blockFlags = 0;
+    for (uint32 index = first; index < last; ++index)
+        blockFlags |= flags[index];
+
+    return !(blockFlags & alwaysSentFlags);
+}
+
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateBlockCache* cache /*= nullptr*/) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -557,7 +580,58 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (!cache || !CanShareValuesUpdate())
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+        return;
+    }
+
+    uint32* flags = nullptr;
+    uint32 visibleFlag = GetUpdateFieldData(player, flags);
+
+    ValuesUpdateBlockCache::Block* block = cache->Find(visibleFlag);
+    if (!block)
+    {
+        // first viewer of this visibility class, remember where the fields depending on viewer were written
+        block = &cache->Add(visibleFlag);
+        block->Data << uint8(UPDATETYPE_VALUES);
+        block->Data << GetPackGUID();
+
+        std::size_t maskPos = block->Data.wpos();
+        BuildValuesUpdate(UPDATETYPE_VALUES, &block->Data, player);
+
+        uint8 blockCount = block->Data.read<uint8>(maskPos);
+        std::size_t fieldPos = maskPos + 1 + blockCount * sizeof(UpdateMask::ClientUpdateMaskType);
+        for (uint8 i = 0; i < blockCount; ++i)
+        {
+            for (uint32 mask = block->Data.read<uint32>(maskPos + 1 + i * sizeof(UpdateMask::ClientUpdateMaskType)); mask; mask &= mask - 1)
+            {
+                uint16 index = i * UpdateMask::CLIENT_UPDATE_MASK_BITS + std::countr_zero(mask);
+                if (IsViewerDependentUpdateField(index))
+                    block->ViewerDependentFields.emplace_back(index, fieldPos);
+
+                fieldPos += sizeof(uint32);
+            }
+        }
+
+        iter->second.AddUpdateBlock(block->Data);
+        return;
+    }
+
+    if (block->ViewerDependentFields.empty())
+    {
+        iter->second.AddUpdateBlock(block->Data);
+        return;
+    }
+
+    ByteBuffer& viewerData = cache->GetViewerBuffer();
+    viewerData.clear();
+    viewerData.append(block->Data);
+
+    for (auto const& [index, pos] : block->ViewerDependentFields)
+        viewerData.put<uint32>(pos, GetViewerDependentUpdateFieldValue(index, player));
+
+    iter->second.AddUpdateBlock(viewerData);
 }
 
 uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
@@ -2964,6 +3038,7 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     UpdatePlayerSet& i_playerSet;
     WorldObject& i_object;
+    ValuesUpdateBlockCache i_updateBlocks;
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d, UpdatePlayerSet& p) : i_updateDatas(d), i_playerSet(p), i_object(obj)
     {
         i_playerSet.clear();
@@ -3024,7 +3099,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (i_playerSet.find(player->GetGUID()) == i_playerSet.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, &i_updateBlocks);
             i_playerSet.insert(player->GetGUID());
         }
     }
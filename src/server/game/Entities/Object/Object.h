@@ -92,6 +92,41 @@ struct PositionFullTerrainStatus;
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 typedef GuidUnorderedSet UpdatePlayerSet;
 
+// Values update blocks of one object built during one BuildUpdate, shared by all viewers with the same
+// visibility flags. Fields whose value depends on the viewer are rewritten in a copy for each viewer.
+class ValuesUpdateBlockCache
+{
+public:
+    struct Block
+    {
+        uint32 VisibleFlag;
+        ByteBuffer Data;
+        std::vector<std::pair<uint16, std::size_t>> ViewerDependentFields;  // update field index, position in Data
+    };
+
+    Block* Find(uint32 visibleFlag)
+    {
+        for (Block& block : _blocks)
+            if (block.VisibleFlag == visibleFlag)
+                return &block;
+
+        return nullptr;
+    }
+
+    Block& Add(uint32 visibleFlag)
+    {
+        Block& block = _blocks.emplace_back();
+        block.VisibleFlag = visibleFlag;
+        return block;
+    }
+
+    ByteBuffer& GetViewerBuffer() { return _viewerBuffer; }
+
+private:
+    std::vector<Block> _blocks;
+    ByteBuffer _viewerBuffer;
+};
+
 class WH_GAME_API Object
 {
 public:
@@ -182,7 +217,7 @@ public:
     [[nodiscard]] virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
     [[nodiscard]] virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
     virtual void BuildUpdate(UpdateDataMapType&, UpdatePlayerSet&) {}
-    void BuildFieldsUpdate(Player*, UpdateDataMapType&) const;
+    void BuildFieldsUpdate(Player*, UpdateDataMapType&, ValuesUpdateBlockCache* cache = nullptr) const;
 
     void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
     void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= ~flag; }
@@ -224,6 +259,15 @@ protected:
     void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
     virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
 
+    // Values update built for one viewer may be sent to other viewers with the same visibility flags
+    [[nodiscard]] virtual bool CanShareValuesUpdate() const { return true; }
+    // Fields sent with different value to different viewers, BuildValuesUpdate must write them as uint32
+    [[nodiscard]] virtual bool IsViewerDependentUpdateField(uint16 /*index*/) const { return false; }
+    [[nodiscard]] virtual uint32 GetViewerDependentUpdateFieldValue(uint16 index, Player* /*target*/) const { return m_uint32Values[index]; }
+
+    // True when values update of the client mask block has no field to send
+    [[nodiscard]] bool IsValuesBlockUnchanged(uint32 block, uint32 const* flags, uint32 alwaysSentFlags) const;
+
     uint16 m_objectType;
 
     TypeID m_objectTypeId;
@@ -25,6 +25,8 @@
 #include "Log.h"
 #include "Opcodes.h"
 #include "WorldPacket.h"
+#include <algorithm>
+#include <chrono>
 #include <zlib.h>
 
 UpdateData::UpdateData() : m_blockCount(0)
@@ -49,104 +51,205 @@ void UpdateData::AddUpdateBlock(const UpdateData& block)
     m_blockCount += block.m_blockCount;
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+namespace
 {
-    z_stream c_stream;
+    // Persistent deflate context of calling thread, avoids deflateInit/deflateEnd per update packet
+    class UpdateCompressor
+    {
+    public:
+        ~UpdateCompressor()
+        {
+            if (_initialized)
+                deflateEnd(&_stream);
+        }
 
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+        ByteBuffer& GetHeaderBuffer()
+        {
+            _header.clear();
+            return _header;
+        }
 
-    // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, CONF_GET_INT("Compression"));
-    if (z_res != Z_OK)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateInit) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+        // Compresses header + data into packet after uncompressed size, returns compressed size or 0 on error
+        uint32 Compress(WorldPacket& packet, ByteBuffer const& data)
+        {
+            uint32 sourceSize = uint32(_header.wpos() + data.wpos());
+            int32 level = SelectLevel();
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+            if (!Reset(level))
+                return 0;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+            auto startTime = std::chrono::steady_clock::now();
 
-    if (c_stream.avail_in != 0)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate not greedy)");
-        *dst_size = 0;
-        return;
-    }
+            uint32 destSize = compressBound(sourceSize);
+            packet.resize(destSize + sizeof(uint32));
+            packet.put<uint32>(0, sourceSize);
 
-    z_res = deflate(&c_stream, Z_FINISH);
-    if (z_res != Z_STREAM_END)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+            _stream.next_out = const_cast<uint8*>(packet.contents()) + sizeof(uint32);
+            _stream.avail_out = destSize;
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateEnd) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+            // Stream header and blocks one after another, no copy to temporary buffer
+            if (!Deflate(_header, Z_NO_FLUSH) || !Deflate(data, Z_FINISH))
+                return 0;
+
+            UpdateCost(sourceSize, std::chrono::steady_clock::now() - startTime);
+            return uint32(_stream.total_out);
+        }
+
+    private:
+        // Lower level when measured cost per KiB is over budget, raise back up to configured one when well under it
+        int32 SelectLevel()
+        {
+            int32 maxLevel = std::clamp(CONF_GET_INT("Compression"), Z_BEST_SPEED, Z_BEST_COMPRESSION);
+            uint32 maxCost = CONF_GET_UINT("Compression.Adaptive.MaxCost");
+
+            if (!maxCost || !_level)
+                _level = maxLevel;
+            else if (_costSamples >= COST_SAMPLES_TO_ADAPT)
+            {
+                if (_costPerKiB > maxCost && _level > Z_BEST_SPEED)
+                    --_level;
+                else if (_costPerKiB * 2 < maxCost && _level < maxLevel)
+                    ++_level;
+
+                if (_level != _streamLevel)
+                    _costSamples = 0;
+            }
+
+            return _level = std::min(_level, maxLevel);
+        }
+
+        bool Reset(int32 level)
+        {
+            int z_res;
+
+            if (!_initialized)
+            {
+                _stream.zalloc = (alloc_func)0;
+                _stream.zfree = (free_func)0;
+                _stream.opaque = (voidpf)0;
+
+                z_res = deflateInit(&_stream, level);
+                if (z_res != Z_OK)
+                {
+                    LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateInit) Error code: {} ({})", z_res, zError(z_res));
+                    return false;
+                }
 
-    *dst_size = c_stream.total_out;
+                _initialized = true;
+                _streamLevel = level;
+                return true;
+            }
+
+            z_res = deflateReset(&_stream);
+            if (z_res == Z_OK && level != _streamLevel)
+                z_res = deflateParams(&_stream, level, Z_DEFAULT_STRATEGY);
+
+            if (z_res != Z_OK)
+            {
+                LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateReset) Error code: {} ({})", z_res, zError(z_res));
+                Destroy();
+                return false;
+            }
+
+            _streamLevel = level;
+            return true;
+        }
+
+        bool Deflate(ByteBuffer const& source, int flush)
+        {
+            _stream.next_in = source.wpos() ? const_cast<Bytef*>(source.contents()) : Z_NULL;
+            _stream.avail_in = uInt(source.wpos());
+
+            int z_res = deflate(&_stream, flush);
+            if (z_res != (flush == Z_FINISH ? Z_STREAM_END : Z_OK))
+            {
+                LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate) Error code: {} ({})", z_res, zError(z_res));
+                Destroy();
+                return false;
+            }
+
+            if (_stream.avail_in != 0)
+            {
+                LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate not greedy)");
+                Destroy();
+                return false;
+            }
+
+            return true;
+        }
+
+        void UpdateCost(uint32 sourceSize, std::chrono::steady_clock::duration elapsed)
+        {
+            uint32 cost = uint32(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() * 1024 / 1000 / std::max<uint32>(sourceSize, 1));
+
+            // Moving average, first sample of level starts it
+            _costPerKiB = _costSamples ? (_costPerKiB * 7 + cost) / 8 : cost;
+            _costSamples = std::min<uint32>(_costSamples + 1, COST_SAMPLES_TO_ADAPT);
+        }
+
+        void Destroy()
+        {
+            deflateEnd(&_stream);
+            _initialized = false;
+        }
+
+        static constexpr uint32 COST_SAMPLES_TO_ADAPT = 16;
+
+        z_stream _stream{};
+        bool _initialized{ false };
+        int32 _streamLevel{ 0 };
+        int32 _level{ 0 };
+        uint32 _costPerKiB{ 0 };
+        uint32 _costSamples{ 0 };
+        ByteBuffer _header;
+    };
+
+    thread_local UpdateCompressor _updateCompressor;
 }
 
 bool UpdateData::BuildPacket(WorldPacket* packet)
 {
     ASSERT(packet->empty());                                // shouldn't happen
 
-    ByteBuffer buf(4 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data.wpos());
+    ByteBuffer& header = _updateCompressor.GetHeaderBuffer();
 
-    buf << (uint32) (!m_outOfRangeGUIDs.empty() ? m_blockCount + 1 : m_blockCount);
+    header << (uint32) (!m_outOfRangeGUIDs.empty() ? m_blockCount + 1 : m_blockCount);
 
     if (!m_outOfRangeGUIDs.empty())
     {
-        buf << (uint8) UPDATETYPE_OUT_OF_RANGE_OBJECTS;
-        buf << (uint32) m_outOfRangeGUIDs.size();
+        header << (uint8) UPDATETYPE_OUT_OF_RANGE_OBJECTS;
+        header << (uint32) m_outOfRangeGUIDs.size();
 
         for (ObjectGuid const& guid : m_outOfRangeGUIDs)
         {
-            buf << guid.WriteAsPacked();
+            header << guid.WriteAsPacked();
         }
     }
 
-    buf.append(m_data);
-
-    size_t pSize = buf.wpos();                              // use real used data size
+    size_t pSize = header.wpos() + m_data.wpos();          // use real used data size
 
     if (pSize > 100)                                       // compress large packets
     {
-        uint32 destsize = compressBound(pSize);
-        packet->resize(destsize + sizeof(uint32));
-
-        packet->put<uint32>(0, pSize);
-        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
+        uint32 destsize = _updateCompressor.Compress(*packet, m_data);
         if (destsize == 0)
             return false;
 
-        packet->resize(destsize + sizeof(uint32));
-        packet->SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
-    }
-    else                                                    // send small packets without compression
-    {
-        packet->append(buf);
-        packet->SetOpcode(SMSG_UPDATE_OBJECT);
+        // Incompressible data, client accepts uncompressed update of any size
+        if (destsize + sizeof(uint32) < pSize)
+        {
+            packet->resize(destsize + sizeof(uint32));
+            packet->SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
+            return true;
+        }
+
+        packet->clear();
     }
 
+    // send small packets without compression
+    packet->reserve(pSize);
+    packet->append(header);
+    packet->append(m_data);
+    packet->SetOpcode(SMSG_UPDATE_OBJECT);
     return true;
 }
 
@@ -46,10 +46,24 @@ public:
     void UnsetBit(uint32 index) { _bits[index] = 0; }
     [[nodiscard]] bool GetBit(uint32 index) const { return _bits[index] != 0; }
 
+    /// Checks all fields of one client mask block, 8 fields per load
+    [[nodiscard]] bool HasBitInBlock(uint32 block) const
+    {
+        uint64 parts[CLIENT_UPDATE_MASK_BITS / sizeof(uint64)];
+        memcpy(parts, &_bits[block * CLIENT_UPDATE_MASK_BITS], sizeof(parts));
+        return (parts[0] | parts[1] | parts[2] | parts[3]) != 0;
+    }
+
     void AppendToPacket(ByteBuffer* data)
     {
         for (uint32 i = 0; i < GetBlockCount(); ++i)
         {
+            if (!HasBitInBlock(i))
+            {
+                *data << ClientUpdateMaskType(0);
+                continue;
+            }
+
             ClientUpdateMaskType maskPart = 0;
             for (uint32 j = 0; j < CLIENT_UPDATE_MASK_BITS; ++j)
                 if (_bits[CLIENT_UPDATE_MASK_BITS * i + j])
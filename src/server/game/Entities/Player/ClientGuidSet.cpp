@@ -0,0 +1,157 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ClientGuidSet.h"
+
+bool ClientGuidSet::insert(ObjectGuid guid)
+{
+    if (guid.IsEmpty())
+        return false;
+
+    // keep load factor at most 3/4
+    if ((_size + 1) * 4 > _slots.size() * 3)
+        Rehash(_slots.empty() ? MIN_CAPACITY_BITS : _capacityBits + 1);
+
+    std::size_t const mask = _slots.size() - 1;
+
+    for (std::size_t index = GetIdealSlot(guid);; index = (index + 1) & mask)
+    {
+        Slot& slot = _slots[index];
+
+        if (slot.Guid == guid)
+            return false;
+
+        if (slot.Guid.IsEmpty())
+        {
+            slot.Guid = guid;
+            slot.Generation = _generation;
+            ++_size;
+            return true;
+        }
+    }
+}
+
+bool ClientGuidSet::erase(ObjectGuid guid)
+{
+    std::size_t index = Find(guid);
+    if (index == NOT_FOUND)
+        return false;
+
+    EraseAt(index);
+    return true;
+}
+
+void ClientGuidSet::clear()
+{
+    // keep memory, set is filled again after teleport
+    for (Slot& slot : _slots)
+        slot = Slot();
+
+    _size = 0;
+}
+
+void ClientGuidSet::BeginVisibilityPass()
+{
+    if (++_generation)
+        return;
+
+    // generation overflow, old stamps can't be equal to new generation
+    for (Slot& slot : _slots)
+        slot.Generation = 0;
+
+    _generation = 1;
+}
+
+void ClientGuidSet::MarkVisible(ObjectGuid guid)
+{
+    std::size_t index = Find(guid);
+    if (index != NOT_FOUND)
+        _slots[index].Generation = _generation;
+}
+
+bool ClientGuidSet::IsMarkedVisible(ObjectGuid guid) const
+{
+    std::size_t index = Find(guid);
+    return index != NOT_FOUND && _slots[index].Generation == _generation;
+}
+
+std::size_t ClientGuidSet::GetIdealSlot(ObjectGuid guid) const
+{
+    // fibonacci hashing, low guid counters are spread over all slots
+    return std::size_t((guid.GetRawValue() * UI64LIT(0x9E3779B97F4A7C15)) >> (64 - _capacityBits));
+}
+
+std::size_t ClientGuidSet::Find(ObjectGuid guid) const
+{
+    if (!_size || guid.IsEmpty())
+        return NOT_FOUND;
+
+    std::size_t const mask = _slots.size() - 1;
+
+    for (std::size_t index = GetIdealSlot(guid);; index = (index + 1) & mask)
+    {
+        Slot const& slot = _slots[index];
+
+        if (slot.Guid == guid)
+            return index;
+
+        if (slot.Guid.IsEmpty())
+            return NOT_FOUND;
+    }
+}
+
+void ClientGuidSet::EraseAt(std::size_t index)
+{
+    std::size_t const mask = _slots.size() - 1;
+    std::size_t hole = index;
+
+    // shift back following entries of cluster which can be placed in hole, no tombstones are needed
+    for (std::size_t next = (hole + 1) & mask; !_slots[next].Guid.IsEmpty(); next = (next + 1) & mask)
+    {
+        std::size_t ideal = GetIdealSlot(_slots[next].Guid);
+
+        if (((next - ideal) & mask) >= ((next - hole) & mask))
+        {
+            _slots[hole] = _slots[next];
+            hole = next;
+        }
+    }
+
+    _slots[hole] = Slot();
+    --_size;
+}
+
+void ClientGuidSet::Rehash(uint8 capacityBits)
+{
+    std::vector<Slot> oldSlots(std::size_t(1) << capacityBits);
+    oldSlots.swap(_slots);
+    _capacityBits = capacityBits;
+
+    std::size_t const mask = _slots.size() - 1;
+
+    for (Slot const& oldSlot : oldSlots)
+    {
+        if (oldSlot.Guid.IsEmpty())
+            continue;
+
+        std::size_t index = GetIdealSlot(oldSlot.Guid);
+        while (!_slots[index].Guid.IsEmpty())
+            index = (index + 1) & mask;
+
+        _slots[index] = oldSlot;
+    }
+}
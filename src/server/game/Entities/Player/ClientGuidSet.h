@@ -0,0 +1,141 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _CLIENT_GUID_SET_H_
+#define _CLIENT_GUID_SET_H_
+
+#include "ObjectGuid.h"
+#include <iterator>
+#include <vector>
+
+// Guids of objects known by player client, open addressing table with linear probing.
+// Every guid has generation of visibility pass in which it was seen last time,
+// so objects which left visibility range are found without copy of set.
+class WH_GAME_API ClientGuidSet
+{
+    struct Slot
+    {
+        ObjectGuid Guid;
+        uint32 Generation{};
+    };
+
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ObjectGuid;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ObjectGuid const*;
+        using reference = ObjectGuid const&;
+
+        const_iterator(Slot const* slot, Slot const* end) : _slot(slot), _end(end) { SkipEmpty(); }
+
+        reference operator*() const { return _slot->Guid; }
+        pointer operator->() const { return &_slot->Guid; }
+
+        const_iterator& operator++()
+        {
+            ++_slot;
+            SkipEmpty();
+            return *this;
+        }
+
+        bool operator==(const_iterator const& right) const { return _slot == right._slot; }
+        bool operator!=(const_iterator const& right) const { return _slot != right._slot; }
+
+    private:
+        void SkipEmpty()
+        {
+            while (_slot != _end && _slot->Guid.IsEmpty())
+                ++_slot;
+        }
+
+        Slot const* _slot;
+        Slot const* _end;
+    };
+
+    bool insert(ObjectGuid guid);
+    bool erase(ObjectGuid guid);
+    [[nodiscard]] bool contains(ObjectGuid guid) const { return Find(guid) != NOT_FOUND; }
+    void clear();
+
+    [[nodiscard]] std::size_t size() const { return _size; }
+    [[nodiscard]] bool empty() const { return !_size; }
+
+    [[nodiscard]] const_iterator begin() const { return { _slots.data(), _slots.data() + _slots.size() }; }
+    [[nodiscard]] const_iterator end() const { return { _slots.data() + _slots.size(), _slots.data() + _slots.size() }; }
+
+    // Erases guids for which predicate returns true, predicate must not change this set
+    template<typename Predicate>
+    void EraseIf(Predicate&& predicate)
+    {
+        EraseSlotsIf([&predicate](Slot const& slot) { return predicate(ObjectGuid(slot.Guid)); });
+    }
+
+    // Visibility pass: guids marked after BeginVisibilityPass are still visible, guids added during pass are marked too
+    void BeginVisibilityPass();
+    void MarkVisible(ObjectGuid guid);
+    [[nodiscard]] bool IsMarkedVisible(ObjectGuid guid) const;
+
+    // Predicate is called for guids not marked in current pass, guid is erased if it returns true.
+    // Predicate must not change this set
+    template<typename Predicate>
+    void EraseIfNotMarked(Predicate&& predicate)
+    {
+        EraseSlotsIf([this, &predicate](Slot const& slot) { return slot.Generation != _generation && predicate(ObjectGuid(slot.Guid)); });
+    }
+
+private:
+    static constexpr std::size_t NOT_FOUND = std::size_t(-1);
+    static constexpr uint8 MIN_CAPACITY_BITS = 6;
+
+    [[nodiscard]] std::size_t GetIdealSlot(ObjectGuid guid) const;
+    [[nodiscard]] std::size_t Find(ObjectGuid guid) const;
+    void EraseAt(std::size_t index);
+    void Rehash(uint8 capacityBits);
+
+    template<typename Predicate>
+    void EraseSlotsIf(Predicate&& predicate)
+    {
+        if (!_size)
+            return;
+
+        std::size_t const mask = _slots.size() - 1;
+
+        // start after empty slot, entries are never shifted back over it
+        std::size_t index = 0;
+        while (!_slots[index].Guid.IsEmpty())
+            ++index;
+
+        for (std::size_t steps = 0; steps < _slots.size(); ++steps)
+        {
+            index = (index + 1) & mask;
+
+            // entry shifted to erased slot is checked again
+            while (!_slots[index].Guid.IsEmpty() && predicate(_slots[index]))
+                EraseAt(index);
+        }
+    }
+
+    std::vector<Slot> _slots;
+    std::size_t _size{};
+    uint8 _capacityBits{};
+    uint32 _generation{ 1 };
+};
+
+#endif
@@ -61,6 +61,7 @@
 #include "LootItemStorage.h"
 #include "MapMgr.h"
 #include "MiscPackets.h"
+#include "MultiRowInsert.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Opcodes.h"
@@ -3573,16 +3574,17 @@ void Player::_LoadSpellCooldowns(PreparedQueryResult result)
 
 void Player::_SaveSpellCooldowns(CharacterDatabaseTransaction trans, bool logout)
 {
-    CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
-    stmt->SetData(0, GetGUID().GetCounter());
-    trans->Append(stmt);
-
     time_t curTime = GameTime::GetGameTime().count();
     uint32 curMSTime = GameTime::GetGameTimeMS().count();
     uint32 infTime = curMSTime + infinityCooldownDelayCheck;
 
-    bool first_round = true;
-    std::ostringstream ss;
+    // not save locked cooldowns, it will be reset or set at reload
+    auto isSaved = [&](SpellCooldown const& cooldown)
+    {
+        return cooldown.end <= infTime && (logout || cooldown.end > (curMSTime + 5 * MINUTE * IN_MILLISECONDS));
+    };
+
+    PlayerSaveSignature signature;
 
     // remove outdated and save active
     for (SpellCooldowns::iterator itr = m_spellCooldowns.begin(); itr != m_spellCooldowns.end();)
@@ -3596,27 +3598,33 @@ void Player::_SaveSpellCooldowns(CharacterDatabaseTransaction trans, bool logout
 
         if (itr->second.end <= curMSTime + 1000)
             m_spellCooldowns.erase(itr++);
-        else if (itr->second.end <= infTime && (logout || itr->second.end > (curMSTime + 5 * MINUTE * IN_MILLISECONDS)))             // not save locked cooldowns, it will be reset or set at reload
+        else
         {
-            if (first_round)
-            {
-                ss << "INSERT INTO character_spell_cooldown (guid, spell, category, item, time, needSend) VALUES ";
-                first_round = false;
-            }
-            // next new/changed record prefix
-            else
-                ss << ',';
+            if (isSaved(itr->second))
+                signature << itr->first << itr->second.category << itr->second.itemid << itr->second.end << itr->second.needSendToClient;
 
-            uint64 cooldown = uint64(((itr->second.end - curMSTime) / IN_MILLISECONDS) + curTime);
-            ss << '(' << GetGUID().GetCounter() << ',' << itr->first << ',' << itr->second.category << "," << itr->second.itemid << ',' << cooldown << ',' << (itr->second.needSendToClient ? '1' : '0') << ')';
             ++itr;
         }
-        else
-            ++itr;
     }
-    // if something changed execute
-    if (!first_round)
-        trans->Append(ss.str().c_str());
+
+    // end of cooldown doesn't change, cooldowns are written again only when some was added or removed
+    if (!IsSaveSectionChanged(PLAYER_SAVE_SPELL_COOLDOWNS, signature) && !logout)
+        return;
+
+    CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
+    stmt->SetData(0, GetGUID().GetCounter());
+    trans->Append(stmt);
+
+    MultiRowInsert insert(trans, "INSERT INTO character_spell_cooldown (guid, spell, category, item, time, needSend)");
+
+    for (auto const& [spellId, cooldown] : m_spellCooldowns)
+    {
+        if (spellId == uint32(-1) || !isSaved(cooldown))
+            continue;
+
+        uint64 cooldownTime = uint64(((cooldown.end - curMSTime) / IN_MILLISECONDS) + curTime);
+        insert.AddRow(GetGUID().GetCounter(), spellId, cooldown.category, cooldown.itemid, cooldownTime, cooldown.needSendToClient);
+    }
 }
 
 uint32 Player::resetTalentsCost() const
@@ -4254,7 +4262,7 @@ void Player::DeleteFromDB(ObjectGuid::LowType lowGuid, uint32 accountId, bool up
             return;
     }
 
-    if (CharacterCacheEntry const* cache = sCharacterCache->GetCharacterCacheByGuid(playerGuid))
+    if (Optional<CharacterCacheEntry> cache = sCharacterCache->GetCharacterCacheByGuid(playerGuid))
     {
         std::string name = cache->Name;
         sCharacterCache->DeleteCharacterCacheEntry(playerGuid, name);
@@ -7620,7 +7628,7 @@ void Player::SendQuestGiverStatusMultiple()
     WorldPacket data(SMSG_QUESTGIVER_STATUS_MULTIPLE, 4);
     data << uint32(count); // placeholder
 
-    for (GuidUnorderedSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
+    for (ClientGuidSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
     {
         uint32 questStatus = DIALOG_STATUS_NONE;
 
@@ -11355,7 +11363,7 @@ bool Player::HaveAtClient(WorldObject const* u) const
         }
     }
 
-    return m_clientGUIDs.find(u->GetGUID()) != m_clientGUIDs.end();
+    return m_clientGUIDs.contains(u->GetGUID());
 }
 
 bool Player::HaveAtClient(ObjectGuid guid) const
@@ -11365,7 +11373,7 @@ bool Player::HaveAtClient(ObjectGuid guid) const
         return true;
     }
 
-    return m_clientGUIDs.find(guid) != m_clientGUIDs.end();
+    return m_clientGUIDs.contains(guid);
 }
 
 bool Player::IsNeverVisible() const
@@ -14536,6 +14544,14 @@ void Player::_SaveEntryPoint(CharacterDatabaseTransaction trans)
     if (!mEntry)
         return;
 
+    PlayerSaveSignature signature;
+    signature << m_entryPointData.joinPos.GetPositionX() << m_entryPointData.joinPos.GetPositionY() << m_entryPointData.joinPos.GetPositionZ()
+        << m_entryPointData.joinPos.GetOrientation() << m_entryPointData.joinPos.GetMapId() << m_entryPointData.taxiPath[0]
+        << m_entryPointData.taxiPath[1] << m_entryPointData.mountSpell;
+
+    if (!IsSaveSectionChanged(PLAYER_SAVE_ENTRY_POINT, signature))
+        return;
+
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_ENTRY_POINT);
     stmt->SetData(0, GetGUID().GetCounter());
     trans->Append(stmt);
@@ -14920,18 +14936,15 @@ void Player::_SaveGlyphs(CharacterDatabaseTransaction trans)
     stmt->SetData(0, GetGUID().GetCounter());
     trans->Append(stmt);
 
-    for (uint8 spec = 0; spec < m_specsCount; ++spec)
-    {
-        uint8 index = 0;
-
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_GLYPHS);
-        stmt->SetData(index++, GetGUID().GetCounter());
-        stmt->SetData(index++, spec);
+    static_assert(MAX_GLYPH_SLOT_INDEX == 6, "Update character_glyphs columns");
 
-        for (uint8 i = 0; i < MAX_GLYPH_SLOT_INDEX; ++i)
-            stmt->SetData(index++, uint16(m_Glyphs[spec][i]));
+    MultiRowInsert insert(trans, "INSERT INTO character_glyphs (guid, talentGroup, glyph1, glyph2, glyph3, glyph4, glyph5, glyph6)");
 
-        trans->Append(stmt);
+    for (uint8 spec = 0; spec < m_specsCount; ++spec)
+    {
+        uint32 const* glyphs = m_Glyphs[spec];
+        insert.AddRow(GetGUID().GetCounter(), spec, uint16(glyphs[0]), uint16(glyphs[1]), uint16(glyphs[2]), uint16(glyphs[3]),
+            uint16(glyphs[4]), uint16(glyphs[5]));
     }
 
     SetNeedToSaveGlyphs(false);
@@ -14962,6 +14975,9 @@ void Player::_SaveTalents(CharacterDatabaseTransaction trans)
 {
     CharacterDatabasePreparedStatement stmt = nullptr;
 
+    // deletes are appended first, changed talents are inserted again after them
+    MultiRowInsert insert(trans, "INSERT INTO character_talent (guid, spell, specMask)");
+
     for (PlayerTalentMap::iterator itr = m_talents.begin(); itr != m_talents.end();)
     {
         // xinef: skip temporary spells
@@ -14983,11 +14999,7 @@ void Player::_SaveTalents(CharacterDatabaseTransaction trans)
         // xinef: insert statement for new / updated spell
         if (itr->second->State == PLAYERSPELL_NEW || itr->second->State == PLAYERSPELL_CHANGED)
         {
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_TALENT);
-            stmt->SetData(0, GetGUID().GetCounter());
-            stmt->SetData(1, itr->first);
-            stmt->SetData(2, itr->second->specMask);
-            trans->Append(stmt);
+            insert.AddRow(GetGUID().GetCounter(), itr->first, itr->second->specMask);
         }
 
         if (itr->second->State == PLAYERSPELL_REMOVED)
@@ -15807,17 +15819,22 @@ void Player::_SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans)
     if (_instanceResetTimes.empty())
         return;
 
+    PlayerSaveSignature signature;
+    for (InstanceTimeMap::const_iterator itr = _instanceResetTimes.begin(); itr != _instanceResetTimes.end(); ++itr)
+        signature << itr->first << int64(itr->second);
+
+    if (!IsSaveSectionChanged(PLAYER_SAVE_INSTANCE_TIMES, signature))
+        return;
+
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIMES);
     stmt->SetData(0, GetSession()->GetAccountId());
     trans->Append(stmt);
 
+    MultiRowInsert insert(trans, "INSERT INTO account_instance_times (accountId, instanceId, releaseTime)");
+
     for (InstanceTimeMap::const_iterator itr = _instanceResetTimes.begin(); itr != _instanceResetTimes.end(); ++itr)
     {
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_ACCOUNT_INSTANCE_LOCK_TIMES);
-        stmt->SetData(0, GetSession()->GetAccountId());
-        stmt->SetData(1, itr->first);
-        stmt->SetData(2, (int64)itr->second);
-        trans->Append(stmt);
+        insert.AddRow(GetSession()->GetAccountId(), itr->first, int64(itr->second));
     }
 }
 
@@ -22,6 +22,7 @@
 #include "Battleground.h"
 #include "CharacterCache.h"
 #include "CinematicMgr.h"
+#include "ClientGuidSet.h"
 #include "DBCStores.h"
 #include "DatabaseEnvFwd.h"
 #include "EnumFlag.h"
@@ -32,6 +33,7 @@
 #include "ObjectMgr.h"
 #include "Optional.h"
 #include "PetDefines.h"
+#include "PlayerSaveStats.h"
 #include "PlayerTaxi.h"
 #include "QuestDef.h"
 #include "SpellAuras.h"
@@ -39,6 +41,7 @@
 #include "SpellMgr.h"
 #include "TradeData.h"
 #include "Unit.h"
+#include "WhoListCacheMgr.h"
 #include "WorldSession.h"
 #include <string>
 #include <vector>
@@ -1853,6 +1856,7 @@ public:
         SetUInt32Value(PLAYER_GUILDID, GuildId);
         // xinef: update global storage
         sCharacterCache->UpdateCharacterGuildId(GetGUID(), GetGuildId());
+        sWhoListCacheMgr->UpdatePlayerGuild(GetGUID(), GetGuildId());
     }
     void SetRank(uint8 rankId) { SetUInt32Value(PLAYER_GUILDRANK, rankId); }
     [[nodiscard]] uint8 GetRank() const { return uint8(GetUInt32Value(PLAYER_GUILDRANK)); }
@@ -2336,7 +2340,7 @@ public:
     void SetEntryPoint();
 
     // currently visible objects at player client
-    GuidUnorderedSet m_clientGUIDs;
+    ClientGuidSet m_clientGUIDs;
     std::vector<Unit*> m_newVisible; // pussywizard
 
     [[nodiscard]] bool HaveAtClient(WorldObject const* u) const;
@@ -2694,6 +2698,10 @@ public:
     void _SaveCharacter(bool create, CharacterDatabaseTransaction trans);
     void _SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans);
 
+    // Returns true if values written by section changed since its last committed save, new values
+    // are remembered as saved when SaveToDB transaction is committed
+    bool IsSaveSectionChanged(PlayerSaveSection section, PlayerSaveSignature const& signature);
+
     /*********************************************************/
     /***              ENVIRONMENTAL SYSTEM                 ***/
     /*********************************************************/
@@ -2715,6 +2723,10 @@ public:
     uint32 m_nextSave; // pussywizard
     uint16 m_additionalSaveTimer; // pussywizard
     uint8 m_additionalSaveMask; // pussywizard
+    std::array<uint64, MAX_PLAYER_SAVE_SECTIONS> m_saveSignatures{};        // committed to database, 0 if unknown
+    std::array<uint64, MAX_PLAYER_SAVE_SECTIONS> m_pendingSaveSignatures{}; // written by last save
+    uint32 m_pendingSaveSections{};
+    uint32 m_saveCounter{};
     uint16 m_hostileReferenceCheckTimer; // pussywizard
     std::array<ChatFloodThrottle, ChatFloodThrottle::MAX> m_chatFloodData;
     Difficulty m_dungeonDifficulty;
@@ -0,0 +1,83 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlayerSaveStats.h"
+
+PlayerSaveStats* PlayerSaveStats::instance()
+{
+    static PlayerSaveStats instance;
+    return &instance;
+}
+
+void PlayerSaveStats::AddSection(PlayerSaveSection section, std::size_t statements)
+{
+    if (section >= MAX_PLAYER_SAVE_SECTIONS)
+        return;
+
+    AtomicSectionCounters& counters = _sections[section];
+
+    if (statements)
+    {
+        counters.Saves.fetch_add(1, std::memory_order_relaxed);
+        counters.Statements.fetch_add(statements, std::memory_order_relaxed);
+    }
+    else
+        counters.Skipped.fetch_add(1, std::memory_order_relaxed);
+}
+
+PlayerSaveStats::SectionCounters PlayerSaveStats::GetCounters(PlayerSaveSection section) const
+{
+    if (section >= MAX_PLAYER_SAVE_SECTIONS)
+        return {};
+
+    AtomicSectionCounters const& counters = _sections[section];
+    return { counters.Saves.load(std::memory_order_relaxed), counters.Skipped.load(std::memory_order_relaxed),
+        counters.Statements.load(std::memory_order_relaxed) };
+}
+
+char const* PlayerSaveStats::GetSectionName(PlayerSaveSection section)
+{
+    switch (section)
+    {
+        case PLAYER_SAVE_CHARACTER:       return "character";
+        case PLAYER_SAVE_MAIL:            return "mail";
+        case PLAYER_SAVE_ENTRY_POINT:     return "entry point";
+        case PLAYER_SAVE_INVENTORY:       return "inventory";
+        case PLAYER_SAVE_QUEST_STATUS:    return "quest status";
+        case PLAYER_SAVE_DAILY_QUESTS:    return "daily quests";
+        case PLAYER_SAVE_WEEKLY_QUESTS:   return "weekly quests";
+        case PLAYER_SAVE_SEASONAL_QUESTS: return "seasonal quests";
+        case PLAYER_SAVE_MONTHLY_QUESTS:  return "monthly quests";
+        case PLAYER_SAVE_TALENTS:         return "talents";
+        case PLAYER_SAVE_SPELLS:          return "spells";
+        case PLAYER_SAVE_SPELL_COOLDOWNS: return "spell cooldowns";
+        case PLAYER_SAVE_ACTIONS:         return "actions";
+        case PLAYER_SAVE_AURAS:           return "auras";
+        case PLAYER_SAVE_SKILLS:          return "skills";
+        case PLAYER_SAVE_ACHIEVEMENTS:    return "achievements";
+        case PLAYER_SAVE_REPUTATION:      return "reputation";
+        case PLAYER_SAVE_EQUIPMENT_SETS:  return "equipment sets";
+        case PLAYER_SAVE_TUTORIALS:       return "tutorials";
+        case PLAYER_SAVE_GLYPHS:          return "glyphs";
+        case PLAYER_SAVE_INSTANCE_TIMES:  return "instance times";
+        case PLAYER_SAVE_STATS:           return "stats";
+        default:
+            break;
+    }
+
+    return "unknown";
+}
@@ -0,0 +1,112 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PLAYER_SAVE_STATS_H_
+#define _PLAYER_SAVE_STATS_H_
+
+#include "Define.h"
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+// Sections of Player::SaveToDB, every section writes its rows only when they changed
+enum PlayerSaveSection : uint8
+{
+    PLAYER_SAVE_CHARACTER,
+    PLAYER_SAVE_MAIL,
+    PLAYER_SAVE_ENTRY_POINT,
+    PLAYER_SAVE_INVENTORY,
+    PLAYER_SAVE_QUEST_STATUS,
+    PLAYER_SAVE_DAILY_QUESTS,
+    PLAYER_SAVE_WEEKLY_QUESTS,
+    PLAYER_SAVE_SEASONAL_QUESTS,
+    PLAYER_SAVE_MONTHLY_QUESTS,
+    PLAYER_SAVE_TALENTS,
+    PLAYER_SAVE_SPELLS,
+    PLAYER_SAVE_SPELL_COOLDOWNS,
+    PLAYER_SAVE_ACTIONS,
+    PLAYER_SAVE_AURAS,
+    PLAYER_SAVE_SKILLS,
+    PLAYER_SAVE_ACHIEVEMENTS,
+    PLAYER_SAVE_REPUTATION,
+    PLAYER_SAVE_EQUIPMENT_SETS,
+    PLAYER_SAVE_TUTORIALS,
+    PLAYER_SAVE_GLYPHS,
+    PLAYER_SAVE_INSTANCE_TIMES,
+    PLAYER_SAVE_STATS,
+
+    MAX_PLAYER_SAVE_SECTIONS
+};
+
+// Hash of values written by a save section, sections rewriting all their rows
+// compare it with hash of last save instead of tracking every change of their data
+class PlayerSaveSignature
+{
+public:
+    template<typename T>
+    PlayerSaveSignature& operator<<(T value)
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Only plain values can be hashed");
+
+        uint64 bits = 0;
+        std::memcpy(&bits, &value, sizeof(T) < sizeof(bits) ? sizeof(T) : sizeof(bits));
+
+        // FNV-1a over 64 bit words, followed by multiplicative mix
+        _hash = (_hash ^ bits) * UI64LIT(0x100000001B3);
+        _hash ^= _hash >> 29;
+        return *this;
+    }
+
+    [[nodiscard]] uint64 GetHash() const { return _hash; }
+
+private:
+    uint64 _hash{ UI64LIT(0xCBF29CE484222325) };
+};
+
+// Counters of Player::SaveToDB sections over all players since server start
+class WH_GAME_API PlayerSaveStats
+{
+public:
+    struct SectionCounters
+    {
+        uint64 Saves;      // section had changes and wrote them
+        uint64 Skipped;    // section had no changes
+        uint64 Statements; // statements appended to save transactions
+    };
+
+    static PlayerSaveStats* instance();
+
+    void AddSection(PlayerSaveSection section, std::size_t statements);
+
+    [[nodiscard]] SectionCounters GetCounters(PlayerSaveSection section) const;
+    [[nodiscard]] static char const* GetSectionName(PlayerSaveSection section);
+
+private:
+    struct AtomicSectionCounters
+    {
+        std::atomic<uint64> Saves{ 0 };
+        std::atomic<uint64> Skipped{ 0 };
+        std::atomic<uint64> Statements{ 0 };
+    };
+
+    std::array<AtomicSectionCounters, MAX_PLAYER_SAVE_SECTIONS> _sections;
+};
+
+#define sPlayerSaveStats PlayerSaveStats::instance()
+
+#endif
@@ -51,6 +51,7 @@
 #include "Log.h"
 #include "LootItemStorage.h"
 #include "MapMgr.h"
+#include "MultiRowInsert.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "OutdoorPvP.h"
@@ -7079,7 +7080,29 @@ void Player::SaveToDB(bool create, bool logout)
 
     SaveToDB(trans, create, logout);
 
-    CharacterDatabase.CommitTransaction(trans);
+    // Player is gone before commit completes
+    if (logout)
+    {
+        CharacterDatabase.CommitTransaction(trans);
+        return;
+    }
+
+    // Sections written by this save are skipped by later saves only after commit succeeds,
+    // unless another save was made meanwhile, that one decides when it's committed
+    GetSession()->AddTransactionCallback(CharacterDatabase.AsyncCommitTransaction(trans)).AfterComplete(
+        [guid = GetGUID(), saveCounter = m_saveCounter, sections = m_pendingSaveSections, signatures = m_pendingSaveSignatures](bool success)
+    {
+        if (!success)
+            return;
+
+        Player* player = ObjectAccessor::FindConnectedPlayer(guid);
+        if (!player || player->m_saveCounter != saveCounter)
+            return;
+
+        for (uint8 i = 0; i < MAX_PLAYER_SAVE_SECTIONS; ++i)
+            if (sections & (1 << i))
+                player->m_saveSignatures[i] = signatures[i];
+    });
 }
 
 void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logout)
@@ -7098,6 +7121,9 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     m_additionalSaveTimer = 0;
     m_additionalSaveMask = 0;
 
+    m_pendingSaveSections = 0;
+    ++m_saveCounter;
+
     // first save/honor gain after midnight will also update the player's honor fields
     UpdateHonorFields();
 
@@ -7107,35 +7133,54 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     if (!create)
         sScriptMgr->OnPlayerSave(this);
 
-    _SaveCharacter(create, trans);
-
-    if (m_mailsUpdated)                                     //save mails only when needed
-        _SaveMail(trans);
+    // every section appends statements only for changed data, statements appended by section are counted
+    auto saveSection = [&trans](PlayerSaveSection section, auto&& save)
+    {
+        std::size_t const statements = trans->GetSize();
+        save();
+        sPlayerSaveStats->AddSection(section, trans->GetSize() - statements);
+    };
 
-    _SaveEntryPoint(trans);
-    _SaveInventory(trans);
-    _SaveQuestStatus(trans);
-    _SaveDailyQuestStatus(trans);
-    _SaveWeeklyQuestStatus(trans);
-    _SaveSeasonalQuestStatus(trans);
-    _SaveMonthlyQuestStatus(trans);
-    _SaveTalents(trans);
-    _SaveSpells(trans);
-    _SaveSpellCooldowns(trans, logout);
-    _SaveActions(trans);
-    _SaveAuras(trans, logout);
-    _SaveSkills(trans);
-    m_achievementMgr->SaveToDB(trans);
-    m_reputationMgr->SaveToDB(trans);
-    _SaveEquipmentSets(trans);
-    GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
-    _SaveGlyphs(trans);
-    _SaveInstanceTimeRestrictions(trans);
+    saveSection(PLAYER_SAVE_CHARACTER, [&]() { _SaveCharacter(create, trans); });
+
+    saveSection(PLAYER_SAVE_MAIL, [&]()
+    {
+        if (m_mailsUpdated)                                 //save mails only when needed
+            _SaveMail(trans);
+    });
+
+    saveSection(PLAYER_SAVE_ENTRY_POINT, [&]() { _SaveEntryPoint(trans); });
+    saveSection(PLAYER_SAVE_INVENTORY, [&]() { _SaveInventory(trans); });
+    saveSection(PLAYER_SAVE_QUEST_STATUS, [&]() { _SaveQuestStatus(trans); });
+    saveSection(PLAYER_SAVE_DAILY_QUESTS, [&]() { _SaveDailyQuestStatus(trans); });
+    saveSection(PLAYER_SAVE_WEEKLY_QUESTS, [&]() { _SaveWeeklyQuestStatus(trans); });
+    saveSection(PLAYER_SAVE_SEASONAL_QUESTS, [&]() { _SaveSeasonalQuestStatus(trans); });
+    saveSection(PLAYER_SAVE_MONTHLY_QUESTS, [&]() { _SaveMonthlyQuestStatus(trans); });
+    saveSection(PLAYER_SAVE_TALENTS, [&]() { _SaveTalents(trans); });
+    saveSection(PLAYER_SAVE_SPELLS, [&]() { _SaveSpells(trans); });
+    saveSection(PLAYER_SAVE_SPELL_COOLDOWNS, [&]() { _SaveSpellCooldowns(trans, logout); });
+    saveSection(PLAYER_SAVE_ACTIONS, [&]() { _SaveActions(trans); });
+    saveSection(PLAYER_SAVE_AURAS, [&]() { _SaveAuras(trans, logout); });
+    saveSection(PLAYER_SAVE_SKILLS, [&]() { _SaveSkills(trans); });
+    saveSection(PLAYER_SAVE_ACHIEVEMENTS, [&]() { m_achievementMgr->SaveToDB(trans); });
+    saveSection(PLAYER_SAVE_REPUTATION, [&]() { m_reputationMgr->SaveToDB(trans); });
+    saveSection(PLAYER_SAVE_EQUIPMENT_SETS, [&]() { _SaveEquipmentSets(trans); });
+    saveSection(PLAYER_SAVE_TUTORIALS, [&]() { GetSession()->SaveTutorialsData(trans); }); // changed only while character in game
+    saveSection(PLAYER_SAVE_GLYPHS, [&]() { _SaveGlyphs(trans); });
+    saveSection(PLAYER_SAVE_INSTANCE_TIMES, [&]() { _SaveInstanceTimeRestrictions(trans); });
 
     // check if stats should only be saved on logout
     // save stats can be out of transaction
-    if (m_session->isLogingOut() || !CONF_GET_BOOL("PlayerSave.Stats.SaveOnlyOnLogout"))
-        _SaveStats(trans);
+    saveSection(PLAYER_SAVE_STATS, [&]()
+    {
+        if (m_session->isLogingOut() || !CONF_GET_BOOL("PlayerSave.Stats.SaveOnlyOnLogout"))
+            _SaveStats(trans);
+    });
+
+    // Database content of written sections is unknown until transaction is committed
+    for (uint8 i = 0; i < MAX_PLAYER_SAVE_SECTIONS; ++i)
+        if (m_pendingSaveSections & (1 << i))
+            m_saveSignatures[i] = 0;
 
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
@@ -7160,19 +7205,14 @@ void Player::SaveGoldToDB(CharacterDatabaseTransaction trans)
 void Player::_SaveActions(CharacterDatabaseTransaction trans)
 {
     CharacterDatabasePreparedStatement stmt = nullptr;
+    MultiRowInsert insert(trans, "INSERT INTO character_action (guid, spec, button, action, type)");
 
     for (ActionButtonList::iterator itr = m_actionButtons.begin(); itr != m_actionButtons.end();)
     {
         switch (itr->second.uState)
         {
             case ACTIONBUTTON_NEW:
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_ACTION);
-                stmt->SetData(0, GetGUID().GetCounter());
-                stmt->SetData(1, m_activeSpec);
-                stmt->SetData(2, itr->first);
-                stmt->SetData(3, itr->second.GetAction());
-                stmt->SetData(4, uint8(itr->second.GetType()));
-                trans->Append(stmt);
+                insert.AddRow(GetGUID().GetCounter(), m_activeSpec, itr->first, itr->second.GetAction(), uint8(itr->second.GetType()));
 
                 itr->second.uState = ACTIONBUTTON_UNCHANGED;
                 ++itr;
@@ -7207,9 +7247,17 @@ void Player::_SaveActions(CharacterDatabaseTransaction trans)
 
 void Player::_SaveAuras(CharacterDatabaseTransaction trans, bool logout)
 {
-    CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
-    stmt->SetData(0, GetGUID().GetCounter());
-    trans->Append(stmt);
+    struct AuraSaveData
+    {
+        Aura const* aura;
+        int32 damage[MAX_SPELL_EFFECTS];
+        int32 baseDamage[MAX_SPELL_EFFECTS];
+        uint8 effMask;
+        uint8 recalculateMask;
+    };
+
+    std::vector<AuraSaveData> auras;
+    auras.reserve(m_ownedAuras.size());
 
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
@@ -7220,46 +7268,63 @@ void Player::_SaveAuras(CharacterDatabaseTransaction trans, bool logout)
         if( !logout && aura->GetDuration() < 60 * IN_MILLISECONDS )
             continue;
 
-        int32 damage[MAX_SPELL_EFFECTS];
-        int32 baseDamage[MAX_SPELL_EFFECTS];
-        uint8 effMask = 0;
-        uint8 recalculateMask = 0;
+        AuraSaveData& data = auras.emplace_back();
+        data.aura = aura;
+        data.effMask = 0;
+        data.recalculateMask = 0;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
             if (AuraEffect const* effect = aura->GetEffect(i))
             {
-                baseDamage[i] = effect->GetBaseAmount();
-                damage[i] = effect->GetAmount();
-                effMask |= 1 << i;
+                data.baseDamage[i] = effect->GetBaseAmount();
+                data.damage[i] = effect->GetAmount();
+                data.effMask |= 1 << i;
                 if (effect->CanBeRecalculated())
-                    recalculateMask |= 1 << i;
+                    data.recalculateMask |= 1 << i;
             }
             else
             {
-                baseDamage[i] = 0;
-                damage[i] = 0;
+                data.baseDamage[i] = 0;
+                data.damage[i] = 0;
             }
         }
+    }
 
-        uint8 index = 0;
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
-        stmt->SetData(index++, GetGUID().GetCounter());
-        stmt->SetData(index++, itr->second->GetCasterGUID().GetRawValue());
-        stmt->SetData(index++, itr->second->GetCastItemGUID().GetRawValue());
-        stmt->SetData(index++, itr->second->GetId());
-        stmt->SetData(index++, effMask);
-        stmt->SetData(index++, recalculateMask);
-        stmt->SetData(index++, itr->second->GetStackAmount());
-        stmt->SetData(index++, damage[0]);
-        stmt->SetData(index++, damage[1]);
-        stmt->SetData(index++, damage[2]);
-        stmt->SetData(index++, baseDamage[0]);
-        stmt->SetData(index++, baseDamage[1]);
-        stmt->SetData(index++, baseDamage[2]);
-        stmt->SetData(index++, itr->second->GetMaxDuration());
-        stmt->SetData(index++, itr->second->GetDuration());
-        stmt->SetData(index, itr->second->GetCharges());
-        trans->Append(stmt);
+    // expiration time changes when aura is refreshed, it's rounded to 10 seconds as aura updates
+    // are not synchronized with game time. Remaining time is saved once per minute, so it's
+    // never more than a minute longer in db if server crashes
+    uint32 const now = GameTime::GetGameTimeMS().count();
+
+    PlayerSaveSignature signature;
+    for (AuraSaveData const& data : auras)
+    {
+        signature << data.aura->GetCasterGUID().GetRawValue() << data.aura->GetCastItemGUID().GetRawValue() << data.aura->GetId()
+            << data.effMask << data.recalculateMask << data.aura->GetStackAmount() << data.aura->GetCharges() << data.aura->GetMaxDuration();
+
+        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+            signature << data.damage[i] << data.baseDamage[i];
+
+        signature << (data.aura->GetDuration() < 0 ? -1 : int64((now + data.aura->GetDuration()) / (10 * IN_MILLISECONDS)))
+            << (data.aura->GetDuration() < 0 ? -1 : int32(data.aura->GetDuration() / (MINUTE * IN_MILLISECONDS)));
+    }
+
+    // logout save writes exact remaining time
+    if (!IsSaveSectionChanged(PLAYER_SAVE_AURAS, signature) && !logout)
+        return;
+
+    CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
+    stmt->SetData(0, GetGUID().GetCounter());
+    trans->Append(stmt);
+
+    MultiRowInsert insert(trans, "INSERT INTO character_aura (guid, casterGuid, itemGuid, spell, effectMask, recalculateMask, stackcount, "
+        "amount0, amount1, amount2, base_amount0, base_amount1, base_amount2, maxDuration, remainTime, remainCharges)");
+
+    for (AuraSaveData const& data : auras)
+    {
+        Aura const* aura = data.aura;
+        insert.AddRow(GetGUID().GetCounter(), aura->GetCasterGUID().GetRawValue(), aura->GetCastItemGUID().GetRawValue(), aura->GetId(),
+            data.effMask, data.recalculateMask, aura->GetStackAmount(), data.damage[0], data.damage[1], data.damage[2],
+            data.baseDamage[0], data.baseDamage[1], data.baseDamage[2], aura->GetMaxDuration(), aura->GetDuration(), aura->GetCharges());
     }
 }
 
@@ -7488,53 +7553,56 @@ void Player::_SaveQuestStatus(CharacterDatabaseTransaction trans)
 
     bool keepAbandoned = !(sWorld->GetCleaningFlags() & CharacterDatabaseCleaner::CLEANING_FLAG_QUESTSTATUS);
 
-    for (saveItr = m_QuestStatusSave.begin(); saveItr != m_QuestStatusSave.end(); ++saveItr)
+    static_assert(QUEST_OBJECTIVES_COUNT == 4 && QUEST_ITEM_OBJECTIVES_COUNT == 6, "Update character_queststatus columns");
+
     {
-        if (saveItr->second)
+        MultiRowInsert insert(trans, "REPLACE INTO character_queststatus (guid, quest, status, explored, timer, mobcount1, mobcount2, mobcount3, mobcount4, "
+            "itemcount1, itemcount2, itemcount3, itemcount4, itemcount5, itemcount6, playercount)");
+
+        for (saveItr = m_QuestStatusSave.begin(); saveItr != m_QuestStatusSave.end(); ++saveItr)
         {
-            statusItr = m_QuestStatus.find(saveItr->first);
-            if (statusItr != m_QuestStatus.end() && (keepAbandoned || statusItr->second.Status != QUEST_STATUS_NONE))
+            if (saveItr->second)
             {
-                uint8 index = 0;
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CHAR_QUESTSTATUS);
-
-                stmt->SetData(index++, GetGUID().GetCounter());
-                stmt->SetData(index++, statusItr->first);
-                stmt->SetData(index++, uint8(statusItr->second.Status));
-                stmt->SetData(index++, statusItr->second.Explored);
-                stmt->SetData(index++, uint32(statusItr->second.Timer / IN_MILLISECONDS + GameTime::GetGameTime().count()));
-
-                for (uint8 i = 0; i < QUEST_OBJECTIVES_COUNT; i++)
-                    stmt->SetData(index++, statusItr->second.CreatureOrGOCount[i]);
-
-                for (uint8 i = 0; i < QUEST_ITEM_OBJECTIVES_COUNT; i++)
-                    stmt->SetData(index++, statusItr->second.ItemCount[i]);
-
-                stmt->SetData(index, statusItr->second.PlayerCount);
+                statusItr = m_QuestStatus.find(saveItr->first);
+                if (statusItr != m_QuestStatus.end() && (keepAbandoned || statusItr->second.Status != QUEST_STATUS_NONE))
+                {
+                    QuestStatusData const& status = statusItr->second;
+                    insert.AddRow(GetGUID().GetCounter(), statusItr->first, uint8(status.Status), status.Explored,
+                        uint32(status.Timer / IN_MILLISECONDS + GameTime::GetGameTime().count()),
+                        status.CreatureOrGOCount[0], status.CreatureOrGOCount[1], status.CreatureOrGOCount[2], status.CreatureOrGOCount[3],
+                        status.ItemCount[0], status.ItemCount[1], status.ItemCount[2], status.ItemCount[3], status.ItemCount[4], status.ItemCount[5],
+                        status.PlayerCount);
+                }
+            }
+            else
+            {
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_QUESTSTATUS_BY_QUEST);
+                stmt->SetData(0, GetGUID().GetCounter());
+                stmt->SetData(1, saveItr->first);
                 trans->Append(stmt);
             }
         }
-        else
-        {
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_QUESTSTATUS_BY_QUEST);
-            stmt->SetData(0, GetGUID().GetCounter());
-            stmt->SetData(1, saveItr->first);
-            trans->Append(stmt);
-        }
     }
 
     m_QuestStatusSave.clear();
 
-    for (saveItr = m_RewardedQuestsSave.begin(); saveItr != m_RewardedQuestsSave.end(); ++saveItr)
     {
-        if (saveItr->second)
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_QUESTSTATUS_REWARDED);
-        else // xinef: what the is this? quest can be removed by spelleffect if (!keepAbandoned)
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_QUESTSTATUS_REWARDED_BY_QUEST);
+        MultiRowInsert insert(trans, "INSERT IGNORE INTO character_queststatus_rewarded (guid, quest, active)");
 
-        stmt->SetData(0, GetGUID().GetCounter());
-        stmt->SetData(1, saveItr->first);
-        trans->Append(stmt);
+        for (saveItr = m_RewardedQuestsSave.begin(); saveItr != m_RewardedQuestsSave.end(); ++saveItr)
+        {
+            if (saveItr->second)
+            {
+                insert.AddRow(GetGUID().GetCounter(), saveItr->first, uint8(1));
+                continue;
+            }
+
+            // xinef: what the is this? quest can be removed by spelleffect if (!keepAbandoned)
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_QUESTSTATUS_REWARDED_BY_QUEST);
+            stmt->SetData(0, GetGUID().GetCounter());
+            stmt->SetData(1, saveItr->first);
+            trans->Append(stmt);
+        }
     }
 
     m_RewardedQuestsSave.clear();
@@ -7556,28 +7624,20 @@ void Player::_SaveDailyQuestStatus(CharacterDatabaseTransaction trans)
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_QUEST_STATUS_DAILY_CHAR);
     stmt->SetData(0, GetGUID().GetCounter());
     trans->Append(stmt);
+
+    MultiRowInsert insert(trans, "INSERT INTO character_queststatus_daily (guid, quest, time)");
+
     for (uint32 quest_daily_idx = 0; quest_daily_idx < PLAYER_MAX_DAILY_QUESTS; ++quest_daily_idx)
     {
         if (GetUInt32Value(PLAYER_FIELD_DAILY_QUESTS_1 + quest_daily_idx))
         {
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHARACTER_DAILYQUESTSTATUS);
-            stmt->SetData(0, GetGUID().GetCounter());
-            stmt->SetData(1, GetUInt32Value(PLAYER_FIELD_DAILY_QUESTS_1 + quest_daily_idx));
-            stmt->SetData(2, uint64(m_lastDailyQuestTime));
-            trans->Append(stmt);
+            insert.AddRow(GetGUID().GetCounter(), GetUInt32Value(PLAYER_FIELD_DAILY_QUESTS_1 + quest_daily_idx), uint64(m_lastDailyQuestTime));
         }
     }
 
-    if (!m_DFQuests.empty())
+    for (DFQuestsDoneList::iterator itr = m_DFQuests.begin(); itr != m_DFQuests.end(); ++itr)
     {
-        for (DFQuestsDoneList::iterator itr = m_DFQuests.begin(); itr != m_DFQuests.end(); ++itr)
-        {
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHARACTER_DAILYQUESTSTATUS);
-            stmt->SetData(0, GetGUID().GetCounter());
-            stmt->SetData(1, (*itr));
-            stmt->SetData(2, uint64(m_lastDailyQuestTime));
-            trans->Append(stmt);
-        }
+        insert.AddRow(GetGUID().GetCounter(), uint32(*itr), uint64(m_lastDailyQuestTime));
     }
 }
 
@@ -7591,14 +7651,12 @@ void Player::_SaveWeeklyQuestStatus(CharacterDatabaseTransaction trans)
     stmt->SetData(0, GetGUID().GetCounter());
     trans->Append(stmt);
 
+    MultiRowInsert insert(trans, "INSERT INTO character_queststatus_weekly (guid, quest)");
+
     for (QuestSet::const_iterator iter = m_weeklyquests.begin(); iter != m_weeklyquests.end(); ++iter)
     {
         uint32 quest_id  = *iter;
-
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHARACTER_WEEKLYQUESTSTATUS);
-        stmt->SetData(0, GetGUID().GetCounter());
-        stmt->SetData(1, quest_id);
-        trans->Append(stmt);
+        insert.AddRow(GetGUID().GetCounter(), quest_id);
     }
 
     m_WeeklyQuestChanged = false;
@@ -7623,6 +7681,8 @@ void Player::_SaveSeasonalQuestStatus(CharacterDatabaseTransaction trans)
         return;
     }
 
+    MultiRowInsert insert(trans, "INSERT IGNORE INTO character_queststatus_seasonal (guid, quest, event)");
+
     for (SeasonalEventQuestMap::const_iterator iter = m_seasonalquests.begin(); iter != m_seasonalquests.end(); ++iter)
     {
         uint16 eventId = iter->first;
@@ -7630,10 +7690,7 @@ void Player::_SaveSeasonalQuestStatus(CharacterDatabaseTransaction trans)
         for (SeasonalQuestSet::const_iterator itr = iter->second.begin(); itr != iter->second.end(); ++itr)
         {
             uint32 questId = *itr;
-
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHARACTER_SEASONALQUESTSTATUS);
-            stmt->SetArguments(GetGUID().GetCounter(), questId, eventId);
-            trans->Append(stmt);
+            insert.AddRow(GetGUID().GetCounter(), questId, eventId);
         }
     }
 }
@@ -7648,13 +7705,12 @@ void Player::_SaveMonthlyQuestStatus(CharacterDatabaseTransaction trans)
     stmt->SetData(0, GetGUID().GetCounter());
     trans->Append(stmt);
 
+    MultiRowInsert insert(trans, "INSERT INTO character_queststatus_monthly (guid, quest)");
+
     for (QuestSet::const_iterator iter = m_monthlyquests.begin(); iter != m_monthlyquests.end(); ++iter)
     {
         uint32 quest_id = *iter;
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHARACTER_MONTHLYQUESTSTATUS);
-        stmt->SetData(0, GetGUID().GetCounter());
-        stmt->SetData(1, quest_id);
-        trans->Append(stmt);
+        insert.AddRow(GetGUID().GetCounter(), quest_id);
     }
 
     m_MonthlyQuestChanged = false;
@@ -7663,6 +7719,7 @@ void Player::_SaveMonthlyQuestStatus(CharacterDatabaseTransaction trans)
 void Player::_SaveSkills(CharacterDatabaseTransaction trans)
 {
     CharacterDatabasePreparedStatement stmt = nullptr;
+    MultiRowInsert insert(trans, "INSERT INTO character_skills (guid, skill, value, max)");
 
     // we don't need transactions here.
     for (SkillStatusMap::iterator itr = mSkillStatus.begin(); itr != mSkillStatus.end();)
@@ -7691,13 +7748,7 @@ void Player::_SaveSkills(CharacterDatabaseTransaction trans)
         switch (itr->second.uState)
         {
             case SKILL_NEW:
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_SKILLS);
-                stmt->SetData(0, GetGUID().GetCounter());
-                stmt->SetData(1, uint16(itr->first));
-                stmt->SetData(2, value);
-                stmt->SetData(3, max);
-                trans->Append(stmt);
-
+                insert.AddRow(GetGUID().GetCounter(), uint16(itr->first), value, max);
                 break;
             case SKILL_CHANGED:
                 stmt = CharacterDatabase.GetPreparedStatement(CHAR_UDP_CHAR_SKILLS);
@@ -7721,6 +7772,9 @@ void Player::_SaveSpells(CharacterDatabaseTransaction trans)
 {
     CharacterDatabasePreparedStatement stmt = nullptr;
 
+    // deletes are appended first, changed spells are inserted again after them
+    MultiRowInsert insert(trans, "INSERT INTO character_spell (guid, spell, specMask)");
+
     for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
     {
         // xinef: skip temporary spells
@@ -7742,11 +7796,7 @@ void Player::_SaveSpells(CharacterDatabaseTransaction trans)
         // xinef: insert statement for new / updated spell
         if (itr->second->State == PLAYERSPELL_NEW || itr->second->State == PLAYERSPELL_CHANGED)
         {
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_SPELL);
-            stmt->SetData(0, GetGUID().GetCounter());
-            stmt->SetData(1, itr->first);
-            stmt->SetData(2, itr->second->specMask);
-            trans->Append(stmt);
+            insert.AddRow(GetGUID().GetCounter(), itr->first, itr->second->specMask);
         }
 
         if (itr->second->State == PLAYERSPELL_REMOVED)
@@ -7770,6 +7820,26 @@ void Player::_SaveStats(CharacterDatabaseTransaction trans)
     if (!CONF_GET_INT("PlayerSave.Stats.MinLevel") || GetLevel() < CONF_GET_INT("PlayerSave.Stats.MinLevel"))
         return;
 
+    PlayerSaveSignature signature;
+    signature << GetMaxHealth();
+
+    for (uint8 i = 0; i < MAX_POWERS; ++i)
+        signature << GetMaxPower(Powers(i));
+
+    for (uint8 i = 0; i < MAX_STATS; ++i)
+        signature << GetStat(Stats(i));
+
+    for (int i = 0; i < MAX_SPELL_SCHOOL; ++i)
+        signature << GetResistance(SpellSchools(i));
+
+    signature << GetFloatValue(PLAYER_BLOCK_PERCENTAGE) << GetFloatValue(PLAYER_DODGE_PERCENTAGE) << GetFloatValue(PLAYER_PARRY_PERCENTAGE)
+        << GetFloatValue(PLAYER_CRIT_PERCENTAGE) << GetFloatValue(PLAYER_RANGED_CRIT_PERCENTAGE) << GetFloatValue(PLAYER_SPELL_CRIT_PERCENTAGE1)
+        << GetUInt32Value(UNIT_FIELD_ATTACK_POWER) << GetUInt32Value(UNIT_FIELD_RANGED_ATTACK_POWER) << GetBaseSpellPowerBonus()
+        << GetUInt32Value(PLAYER_FIELD_COMBAT_RATING_1 + static_cast<uint16>(CR_CRIT_TAKEN_SPELL));
+
+    if (!IsSaveSectionChanged(PLAYER_SAVE_STATS, signature))
+        return;
+
     CharacterDatabasePreparedStatement stmt = nullptr;
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_STATS);
@@ -7805,6 +7875,16 @@ void Player::_SaveStats(CharacterDatabaseTransaction trans)
     trans->Append(stmt);
 }
 
+bool Player::IsSaveSectionChanged(PlayerSaveSection section, PlayerSaveSignature const& signature)
+{
+    if (m_saveSignatures[section] == signature.GetHash())
+        return false;
+
+    m_pendingSaveSignatures[section] = signature.GetHash();
+    m_pendingSaveSections |= 1 << section;
+    return true;
+}
+
 void Player::outDebugValues() const
 {
     if (!sLog->ShouldLog("entities.player", spdlog::level::debug)) // optimize disabled debug output
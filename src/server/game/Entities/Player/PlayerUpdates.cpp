@@ -46,6 +46,7 @@
 #include "Vehicle.h"
 #include "Weather.h"
 #include "WeatherMgr.h"
+#include "WhoListCacheMgr.h"
 #include "WorldStatePackets.h"
 #include <fmt/printf.h>
 
@@ -1125,6 +1126,8 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea)
                                       // just area change, works strange...
         if (Guild* guild = GetGuild())
             guild->UpdateMemberData(this, GUILD_MEMBER_DATA_ZONEID, newZone);
+
+        sWhoListCacheMgr->UpdatePlayerZone(this, newZone);
     }
 
     // group update
@@ -1465,14 +1468,14 @@ void Player::UpdateObjectVisibility(bool forced, bool fromUpdate)
 }
 
 template <class T>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, T* target,
+inline void UpdateVisibilityOf_helper(ClientGuidSet& s64, T* target,
                                       std::vector<Unit*>& /*v*/)
 {
     s64.insert(target->GetGUID());
 }
 
 template <>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, GameObject* target,
+inline void UpdateVisibilityOf_helper(ClientGuidSet& s64, GameObject* target,
                                       std::vector<Unit*>& /*v*/)
 {
     // @HACK: This is to prevent objects like deeprun tram from disappearing
@@ -1482,7 +1485,7 @@ inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, GameObject* target,
 }
 
 template <>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, Creature* target,
+inline void UpdateVisibilityOf_helper(ClientGuidSet& s64, Creature* target,
                                       std::vector<Unit*>& v)
 {
     s64.insert(target->GetGUID());
@@ -1490,7 +1493,7 @@ inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, Creature* target,
 }
 
 template <>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, Player* target,
+inline void UpdateVisibilityOf_helper(ClientGuidSet& s64, Player* target,
                                       std::vector<Unit*>& v)
 {
     s64.insert(target->GetGUID());
@@ -1583,7 +1586,7 @@ void Player::UpdateTriggerVisibility()
 
     UpdateData  udata;
     WorldPacket packet;
-    for (GuidUnorderedSet::iterator itr = m_clientGUIDs.begin();
+    for (ClientGuidSet::const_iterator itr = m_clientGUIDs.begin();
          itr != m_clientGUIDs.end(); ++itr)
     {
         if ((*itr).IsCreatureOrVehicle())
@@ -1626,7 +1629,7 @@ void Player::UpdateForQuestWorldObjects()
 
     UpdateData  udata;
     WorldPacket packet;
-    for (GuidUnorderedSet::iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
+    for (ClientGuidSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
     {
         if ((*itr).IsGameObject())
         {
@@ -130,8 +130,9 @@ void MotionTransport::BuildUpdate(UpdateDataMapType& data_map, UpdatePlayerSet&)
     if (players.IsEmpty())
         return;
 
+    ValuesUpdateBlockCache updateBlocks;
     for (Map::PlayerList::const_iterator itr = players.begin(); itr != players.end(); ++itr)
-        BuildFieldsUpdate(itr->GetSource(), data_map);
+        BuildFieldsUpdate(itr->GetSource(), data_map, &updateBlocks);
 
     ClearUpdateMask(true);
 }
@@ -804,8 +805,9 @@ void StaticTransport::BuildUpdate(UpdateDataMapType& data_map, UpdatePlayerSet&)
     if (players.IsEmpty())
         return;
 
+    ValuesUpdateBlockCache updateBlocks;
     for (Map::PlayerList::const_iterator itr = players.begin(); itr != players.end(); ++itr)
-        BuildFieldsUpdate(itr->GetSource(), data_map);
+        BuildFieldsUpdate(itr->GetSource(), data_map, &updateBlocks);
 
     ClearUpdateMask(true);
 }
@@ -29,7 +29,9 @@
 #include "Optional.h"
 #include "SpellAuraDefines.h"
 #include "SpellDefines.h"
+#include "StableVector.h"
 #include "ThreatMgr.h"
+#include <boost/container/flat_map.hpp>
 #include <functional>
 #include <utility>
 
@@ -1317,13 +1319,14 @@ public:
     typedef std::multimap<AuraStateType,  AuraApplication*> AuraStateAurasMap;
     typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
 
-    typedef std::list<AuraEffect*> AuraEffectList;
+    typedef Warhead::StableVector<AuraEffect*> AuraEffectList;
     typedef std::list<Aura*> AuraList;
     typedef std::list<AuraApplication*> AuraApplicationList;
     typedef std::list<DiminishingReturn> Diminishing;
     typedef GuidUnorderedSet ComboPointHolderSet;
 
-    typedef std::map<uint8, AuraApplication*> VisibleAuraMap;
+    // Sorted by slot, contiguous as it is iterated on every aura update and packet
+    typedef boost::container::flat_map<uint8, AuraApplication*> VisibleAuraMap;
 
     ~Unit() override;
 
@@ -2483,6 +2486,10 @@ protected:
     explicit Unit (bool isWorldObject);
 
     void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+    [[nodiscard]] bool CanShareValuesUpdate() const override;
+    [[nodiscard]] bool IsViewerDependentUpdateField(uint16 index) const override;
+    [[nodiscard]] uint32 GetViewerDependentUpdateFieldValue(uint16 index, Player* target) const override;
+    [[nodiscard]] bool IsFactionFieldOverriddenFor(Player const* target) const;
 
     UnitAI* i_AI, *i_disabledAI;
 
@@ -2523,6 +2530,7 @@ protected:
     uint32 m_removedAurasCount;
 
     AuraEffectList m_modAuras[TOTAL_AURAS];
+    std::vector<AuraType> m_modAurasToCompact; // aura types with removed effects, compacted at next spells update
     AuraList m_scAuras;                        // casted singlecast auras
     AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
     AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
@@ -37,7 +37,7 @@ void VisibleNotifier::Visit(GameObjectMapType& m)
         if (i_largeOnly != go->IsVisibilityOverridden())
             continue;
 
-        vis_guids.erase(go->GetGUID());
+        i_player.m_clientGUIDs.MarkVisible(go->GetGUID());
         i_player.UpdateVisibilityOf(go, i_data, i_visibleNow);
     }
 }
@@ -52,9 +52,9 @@ void VisibleNotifier::SendToSelf()
             if (i_largeOnly != (*itr)->IsVisibilityOverridden())
                 continue;
 
-            if (vis_guids.find((*itr)->GetGUID()) != vis_guids.end())
+            if (i_player.m_clientGUIDs.contains((*itr)->GetGUID()) && !i_player.m_clientGUIDs.IsMarkedVisible((*itr)->GetGUID()))
             {
-                vis_guids.erase((*itr)->GetGUID());
+                i_player.m_clientGUIDs.MarkVisible((*itr)->GetGUID());
 
                 switch ((*itr)->GetTypeId())
                 {
@@ -74,30 +74,32 @@ void VisibleNotifier::SendToSelf()
             }
         }
 
-    for (GuidUnorderedSet::const_iterator it = vis_guids.begin(); it != vis_guids.end(); ++it)
+    i_player.m_clientGUIDs.EraseIfNotMarked([this](ObjectGuid guid)
     {
-        if (WorldObject* obj = ObjectAccessor::GetWorldObject(i_player, *it))
+        if (WorldObject* obj = ObjectAccessor::GetWorldObject(i_player, guid))
         {
             if (i_largeOnly != obj->IsVisibilityOverridden())
-                continue;
+                return false;
         }
 
         // pussywizard: static transports are removed only in RemovePlayerFromMap and here if can no longer detect (eg. phase changed)
-        if ((*it).IsTransport())
-            if (GameObject* staticTrans = i_player.GetMap()->GetGameObject(*it))
+        if (guid.IsTransport())
+            if (GameObject* staticTrans = i_player.GetMap()->GetGameObject(guid))
                 if (i_player.CanSeeOrDetect(staticTrans, false, true))
-                    continue;
+                    return false;
 
-        i_player.m_clientGUIDs.erase(*it);
-        i_data.AddOutOfRangeGUID(*it);
+        i_data.AddOutOfRangeGUID(guid);
 
-        if ((*it).IsPlayer())
+        // changes only client guids of other player
+        if (guid.IsPlayer())
         {
-            Player* player = ObjectAccessor::FindPlayer(*it);
+            Player* player = ObjectAccessor::FindPlayer(guid);
             if (player && player->IsInMap(&i_player))
                 player->UpdateVisibilityOf(&i_player);
         }
-    }
+
+        return true;
+    });
 
     if (!i_data.HasData())
         return;
@@ -175,7 +177,7 @@ void PlayerRelocationNotifier::Visit(PlayerMapType& m)
     for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Player* player = iter->GetSource();
-        vis_guids.erase(player->GetGUID());
+        i_player.m_clientGUIDs.MarkVisible(player->GetGUID());
         i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
         player->UpdateVisibilityOf(&i_player); // this notifier with different Visit(PlayerMapType&) than VisibleNotifier is needed to update visibility of self for other players when we move (eg. stealth detection changes)
     }
@@ -349,7 +351,12 @@ void ObjectUpdater::Visit(GridRefMgr<T>& m)
     {
         obj = iter->GetSource();
         ++iter;
-        if (obj->IsInWorld() && (i_largeOnly == obj->IsVisibilityOverridden()))
+        if (!obj->IsInWorld() || (i_largeOnly != obj->IsVisibilityOverridden()))
+            continue;
+
+        if (i_deferred && !obj->GetMap()->CanUpdateInRegion(obj))
+            i_deferred->emplace_back(obj);
+        else
             obj->Update(i_timeDiff);
     }
 }
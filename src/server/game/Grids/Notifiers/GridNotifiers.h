@@ -38,16 +38,17 @@ namespace Warhead
     struct VisibleNotifier
     {
         Player& i_player;
-        GuidUnorderedSet vis_guids;
         std::vector<Unit*>& i_visibleNow;
         bool i_gobjOnly;
         bool i_largeOnly;
         UpdateData i_data;
 
+        // objects visited by this notifier are marked in client guids, not marked ones are out of range at SendToSelf
         VisibleNotifier(Player& player, bool gobjOnly, bool largeOnly) :
-            i_player(player), vis_guids(player.m_clientGUIDs), i_visibleNow(player.m_newVisible), i_gobjOnly(gobjOnly), i_largeOnly(largeOnly)
+            i_player(player), i_visibleNow(player.m_newVisible), i_gobjOnly(gobjOnly), i_largeOnly(largeOnly)
         {
             i_visibleNow.clear();
+            i_player.m_clientGUIDs.BeginVisibilityPass();
         }
 
         void Visit(GameObjectMapType&);
@@ -95,6 +96,7 @@ namespace Warhead
     {
         WorldObject const* i_source;
         WorldPacket const* i_message;
+        SharedWorldPacket i_sharedMessage;
         uint32 i_phaseMask;
         float i_distSq;
         TeamId teamId;
@@ -119,7 +121,7 @@ namespace Warhead
             if (!player->HaveAtClient(i_source))
                 return;
 
-            player->GetSession()->SendPacket(i_message);
+            player->GetSession()->SendPacket(i_message, i_sharedMessage);
         }
     };
 
@@ -127,6 +129,7 @@ namespace Warhead
     {
         Unit* i_source;
         WorldPacket* i_message;
+        SharedWorldPacket i_sharedMessage;
         uint32 i_phaseMask;
         float i_distSq;
         MessageDistDelivererToHostile(Unit* src, WorldPacket* msg, float dist)
@@ -144,7 +147,7 @@ namespace Warhead
             if (player == i_source || !player->HaveAtClient(i_source) || player->IsFriendlyTo(i_source))
                 return;
 
-            player->GetSession()->SendPacket(i_message);
+            player->GetSession()->SendPacket(i_message, i_sharedMessage);
         }
     };
 
@@ -152,7 +155,8 @@ namespace Warhead
     {
         uint32 i_timeDiff;
         bool i_largeOnly;
-        explicit ObjectUpdater(const uint32 diff, bool largeOnly) : i_timeDiff(diff), i_largeOnly(largeOnly) {}
+        std::vector<WorldObject*>* i_deferred; // objects linked to other regions, updated after parallel region update
+        explicit ObjectUpdater(const uint32 diff, bool largeOnly, std::vector<WorldObject*>* deferred = nullptr) : i_timeDiff(diff), i_largeOnly(largeOnly), i_deferred(deferred) {}
         template<class T> void Visit(GridRefMgr<T>& m);
         void Visit(PlayerMapType&) {}
         void Visit(CorpseMapType&) {}
@@ -37,6 +37,7 @@
 #include "Player.h"
 #include "ScriptMgr.h"
 #include "SocialMgr.h"
+#include "WhoListCacheMgr.h"
 #include "WorldSession.h"
 #include <boost/iterator/counting_iterator.hpp>
 
@@ -1194,6 +1195,8 @@ bool Guild::SetName(std::string_view const& name)
     }
 
     m_name = name;
+    sWhoListCacheMgr->UpdateGuildName(GetId(), m_name);
+
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GUILD_NAME);
     stmt->SetData(0, m_name);
     stmt->SetData(1, GetId());
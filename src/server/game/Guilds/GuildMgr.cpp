@@ -23,6 +23,7 @@
 #include "DatabaseEnv.h"
 #include "GameConfig.h"
 #include "StopWatch.h"
+#include "WhoListCacheMgr.h"
 
 GuildMgr::GuildMgr() : NextGuildId(1)
 { }
@@ -42,6 +43,9 @@ GuildMgr* GuildMgr::instance()
 void GuildMgr::AddGuild(Guild* guild)
 {
     GuildStore[guild->GetId()] = guild;
+
+    // members of new guild were added to who list before guild was registered
+    sWhoListCacheMgr->UpdateGuildName(guild->GetId(), guild->GetName());
 }
 
 void GuildMgr::RemoveGuild(uint32 guildId)
@@ -59,6 +59,7 @@
 #include "Transport.h"
 #include "UpdateMask.h"
 #include "Util.h"
+#include "WhoListCacheMgr.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -81,6 +82,9 @@ void WorldSession::HandleCharEnum(PreparedQueryResult result)
             LOG_DEBUG("network.opcode", "Loading char {} from account {}.", guid.ToString(), GetAccountId());
             if (Player::BuildEnumData(result, &data))
             {
+                // Character cache in lazy mode may not have this character yet, have it ready for login
+                sCharacterCache->RequestCharacterCacheEntry(guid);
+
                 _legitCharacters.insert(guid);
                 ++num;
             }
@@ -476,7 +480,7 @@ void WorldSession::HandleCharDeleteOpcode(WorldPacket& recvData)
         return;
     }
 
-    if (CharacterCacheEntry const* playerData = sCharacterCache->GetCharacterCacheByGuid(guid))
+    if (Optional<CharacterCacheEntry> playerData = sCharacterCache->GetCharacterCacheByGuid(guid))
     {
         accountId = playerData->AccountId;
         name = playerData->Name;
@@ -646,6 +650,13 @@ void WorldSession::HandlePlayerLoginFromDB(LoginQueryHolder const& holder)
         return;
     }
 
+    // Character cache in lazy mode may not have this character yet, auctions and mails need its account id
+    if (!sCharacterCache->HasCharacterCacheEntry(playerGuid))
+    {
+        sCharacterCache->AddCharacterCacheEntry(playerGuid, GetAccountId(), pCurrChar->GetName(), pCurrChar->getGender(), pCurrChar->getRace(), pCurrChar->getClass(), pCurrChar->GetLevel());
+        sCharacterCache->UpdateCharacterMailCount(playerGuid, int8(std::min<std::size_t>(pCurrChar->GetMailSize(), std::numeric_limits<int8>::max())), true);
+    }
+
     pCurrChar->GetMotionMaster()->Initialize();
     pCurrChar->SendDungeonDifficulty(false);
 
@@ -948,6 +959,7 @@ void WorldSession::HandlePlayerLoginFromDB(LoginQueryHolder const& holder)
         }
     }
 
+    sWhoListCacheMgr->AddPlayer(pCurrChar);
     sScriptMgr->OnPlayerLogin(pCurrChar);
 
     if (pCurrChar->HasAtLoginFlag(AT_LOGIN_FIRST))
@@ -1491,7 +1503,7 @@ void WorldSession::HandleCharCustomizeCallback(std::shared_ptr<CharacterCustomiz
     }
 
     // get the players old (at this moment current) race
-    CharacterCacheEntry const* playerData = sCharacterCache->GetCharacterCacheByGuid(customizeInfo->Guid);
+    Optional<CharacterCacheEntry> playerData = sCharacterCache->GetCharacterCacheByGuid(customizeInfo->Guid);
     if (!playerData)
     {
         SendCharCustomize(CHAR_CREATE_ERROR, customizeInfo.get());
@@ -1776,7 +1788,7 @@ void WorldSession::HandleCharFactionOrRaceChangeCallback(std::shared_ptr<Charact
     ObjectGuid::LowType lowGuid = factionChangeInfo->Guid.GetCounter();
 
     // get the players old (at this moment current) race
-    CharacterCacheEntry const* playerData = sCharacterCache->GetCharacterCacheByGuid(factionChangeInfo->Guid);
+    Optional<CharacterCacheEntry> playerData = sCharacterCache->GetCharacterCacheByGuid(factionChangeInfo->Guid);
     if (!playerData)
     {
         SendCharFactionChange(CHAR_CREATE_ERROR, factionChangeInfo.get());
@@ -249,163 +249,69 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
     LOG_DEBUG("network.who", "Minlvl {}, maxlvl {}, name {}, guild {}, racemask {}, classmask {}, zones {}, strings {}",
         levelMin, levelMax, packetPlayerName, packetGuildName, racemask, classmask, zonesCount, strCount);
 
-    std::wstring str[4];                                    // 4 is client limit
+    WhoListQuery query;
+    query.Strings.resize(strCount);                         // 4 is client limit
+
     for (uint32 i = 0; i < strCount; ++i)
     {
         std::string temp;
         recvData >> temp;                                   // user entered string, it used as universal search pattern(guild+player name)?
 
-        if (!Utf8toWStr(temp, str[i]))
+        if (!Utf8toWStr(temp, query.Strings[i]))
             continue;
 
-        wstrToLower(str[i]);
+        wstrToLower(query.Strings[i]);
 
         LOG_DEBUG("network.who", "String {}: {}", i, temp);
     }
 
-    std::wstring wpacketPlayerName;
-    std::wstring wpacketGuildName;
-    if (!(Utf8toWStr(packetPlayerName, wpacketPlayerName) && Utf8toWStr(packetGuildName, wpacketGuildName)))
+    if (!(Utf8toWStr(packetPlayerName, query.PlayerName) && Utf8toWStr(packetGuildName, query.GuildName)))
         return;
 
-    wstrToLower(wpacketPlayerName);
-    wstrToLower(wpacketGuildName);;
+    wstrToLower(query.PlayerName);
+    wstrToLower(query.GuildName);
 
     // client send in case not set max level value 100 but Warhead supports 255 max level,
     // update it to show GMs with characters after 100 level
     if (levelMax >= MAX_LEVEL)
         levelMax = STRONG_MAX_LEVEL;
 
-    uint32 team = _player->GetTeamId();
-    uint32 security = GetSecurity();
-    bool allowTwoSideWhoList = CONF_GET_BOOL("AllowTwoSide.WhoList");
-    uint32 gmLevelInWhoList = CONF_GET_INT("GM.InWhoList.Level");
+    query.PlayerGuid = _player->GetGUID();
+    query.Team = _player->GetTeamId();
+    query.Security = GetSecurity();
+    query.AllowTwoSide = CONF_GET_BOOL("AllowTwoSide.WhoList");
+    query.GmLevelInWhoList = AccountTypes(CONF_GET_INT("GM.InWhoList.Level"));
+    query.Locale = GetSessionDbcLocale();
+    query.LevelMin = levelMin;
+    query.LevelMax = levelMax;
+    query.RaceMask = racemask;
+    query.ClassMask = classmask;
+    query.ZoneIds.assign(zoneids.begin(), zoneids.begin() + zonesCount);
+
+    uint32 maxWhoListReturns = CONF_GET_UINT("MaxWhoListReturns");
     uint32 displaycount = 0;
 
     WorldPacket data(SMSG_WHO, 50);     // guess size
     data << uint32(matchCount);         // placeholder, count of players matching criteria
     data << uint32(displaycount);       // placeholder, count of players displayed
 
-    for (auto const& target : sWhoListCacheMgr->GetWhoList())
+    sWhoListCacheMgr->Search(query, [&](WhoListPlayerInfo const& target)
     {
-        if (AccountMgr::IsPlayerAccount(security))
-        {
-            // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
-            if (target.GetTeamId() != team && !allowTwoSideWhoList)
-            {
-                continue;
-            }
-
-            // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
-            if (target.GetSecurity() > AccountTypes(gmLevelInWhoList))
-            {
-                continue;
-            }
-        }
-
-        // check if target is globally visible for player
-        if ((_player->GetGUID() != target.GetGuid() && !target.IsVisible()) &&
-            (AccountMgr::IsPlayerAccount(_player->GetSession()->GetSecurity()) || target.GetSecurity() > _player->GetSession()->GetSecurity()))
-        {
-            continue;
-        }
-
-        // check if target's level is in level range
-        uint8 lvl = target.GetLevel();
-        if (lvl < levelMin || lvl > levelMax)
-        {
-            continue;
-        }
-
-        // check if class matches classmask
-        uint8 class_ = target.GetClass();
-        if (!(classmask & (1 << class_)))
-        {
-            continue;
-        }
-
-        // check if race matches racemask
-        uint32 race = target.GetRace();
-        if (!(racemask & (1 << race)))
-        {
-            continue;
-        }
-
-        uint32 playerZoneId = target.GetZoneId();
-        uint8 gender = target.GetGender();
-
-        bool showZones = true;
-        for (uint32 i = 0; i < zonesCount; ++i)
-        {
-            if (zoneids[i] == playerZoneId)
-            {
-                showZones = true;
-                break;
-            }
-
-            showZones = false;
-        }
-
-        if (!showZones)
-        {
-            continue;
-        }
-
-        std::wstring const& wideplayername = target.GetWidePlayerName();
-        if (!(wpacketPlayerName.empty() || wideplayername.find(wpacketPlayerName) != std::wstring::npos))
-        {
-            continue;
-        }
-
-        std::wstring const& wideguildname = target.GetWideGuildName();
-        if (!(wpacketGuildName.empty() || wideguildname.find(wpacketGuildName) != std::wstring::npos))
-        {
-            continue;
-        }
-
-        std::string aname;
-        if (AreaTableEntry const* areaEntry = sAreaTableStore.LookupEntry(playerZoneId))
-        {
-            aname = areaEntry->area_name[GetSessionDbcLocale()];
-        }
-
-        bool s_show = true;
-        for (uint32 i = 0; i < strCount; ++i)
-        {
-            if (!str[i].empty())
-            {
-                if (wideguildname.find(str[i]) != std::wstring::npos ||
-                    wideplayername.find(str[i]) != std::wstring::npos ||
-                    Utf8FitTo(aname, str[i]))
-                {
-                    s_show = true;
-                    break;
-                }
-
-                s_show = false;
-            }
-        }
-
-        if (!s_show)
-        {
-            continue;
-        }
-
         // 49 is maximum player count sent to client - can be overridden
         // through config, but is unstable
-        if ((matchCount++) >= CONF_GET_UINT("MaxWhoListReturns"))
-            continue;
+        if ((matchCount++) >= maxWhoListReturns)
+            return;
 
-        data << target.GetPlayerName();                   // player name
-        data << target.GetGuildName();                    // guild name
-        data << uint32(lvl);                              // player level
-        data << uint32(class_);                           // player class
-        data << uint32(race);                             // player race
-        data << uint8(gender);                            // player gender
-        data << uint32(playerZoneId);                     // player zone id
+        data << target.PlayerName;                        // player name
+        data << target.GuildName;                         // guild name
+        data << uint32(target.Level);                     // player level
+        data << uint32(target.Class);                     // player class
+        data << uint32(target.Race);                      // player race
+        data << uint8(target.Gender);                     // player gender
+        data << uint32(target.ZoneId);                    // player zone id
 
         ++displaycount;
-    }
+    });
 
     data.put(0, displaycount);                            // insert right count, count displayed
     data.put(4, matchCount);                              // insert right count, count of matches
@@ -322,7 +322,7 @@ bool LootStoreItem::Roll(bool rate, Player const* player, Loot& loot, LootStore
 
     ItemTemplate const* pProto = sObjectMgr->GetItemTemplate(itemid);
 
-    float qualityModifier = pProto && rate ? CONF_GET_FLOAT(qualityToRate[pProto->Quality]) : 1.0f;
+    float qualityModifier = pProto && rate ? sGameConfig->GetOption<float>(qualityToRate[pProto->Quality]) : 1.0f;
 
     return roll_chance_f(_chance * qualityModifier);
 }
@@ -19,6 +19,7 @@
 // PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 
 #include "Map.h"
+#include "BattlefieldMgr.h"
 #include "Battleground.h"
 #include "CellImpl.h"
 #include "DatabaseEnv.h"
@@ -31,17 +32,27 @@
 #include "InstanceScript.h"
 #include "LFGMgr.h"
 #include "MapMgr.h"
+#include "MapUpdater.h"
 #include "Metric.h"
 #include "MiscPackets.h"
 #include "ObjectAccessor.h"
+#include "OutdoorPvPMgr.h"
+#include "PathRequestQueue.h"
 #include "ScriptMgr.h"
 #include "Transport.h"
 #include "VMapFactory.h"
 #include "VMapMgr2.h"
 #include "Vehicle.h"
 #include "Weather.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <utility>
 
+#if WARHEAD_PLATFORM == WARHEAD_PLATFORM_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 union u_map_magic
 {
     char asChar[4];
@@ -57,6 +68,11 @@ u_map_magic MapLiquidMagic  = { {'M', 'L', 'I', 'Q'} };
 static uint16 const holetab_h[4] = { 0x1111, 0x2222, 0x4444, 0x8888 };
 static uint16 const holetab_v[4] = { 0x000F, 0x00F0, 0x0F00, 0xF000 };
 
+static std::string GetGridMapFileName(uint32 mapId, int gx, int gy)
+{
+    return Warhead::StringFormat(sWorld->GetDataPath() + "maps/{:03}{:02}{:02}.map", mapId, gx, gy);
+}
+
 ZoneDynamicInfo::ZoneDynamicInfo() :
     WeatherId(WEATHER_STATE_FINE) { }
 
@@ -77,11 +93,15 @@ Map::~Map()
         sMapMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
     MMAP::MMapFactory::createOrGetMMapMgr()->unloadMapInstance(GetId(), _instanceId);
+
+    // Series are tagged by instance id
+    sMetric->ReleaseSeries(_creaturesMetricSeries);
+    sMetric->ReleaseSeries(_gameObjectsMetricSeries);
 }
 
 bool Map::ExistMap(uint32 mapid, int gx, int gy)
 {
-    std::string mapName = Warhead::StringFormat(sWorld->GetDataPath() + "maps/{:03}{:02}{:02}.map", mapid, gx, gy);
+    std::string mapName = GetGridMapFileName(mapid, gx, gy);
 
     bool ret = false;
     FILE* pf = fopen(mapName.c_str(), "rb");
@@ -199,19 +219,48 @@ void Map::LoadMap(int gx, int gy, bool reload)
         _gridMaps[gx][gy].reset();
     }
 
-    std::string mapName = Warhead::StringFormat(sWorld->GetDataPath() + "maps/{:03}{:02}{:02}.map", GetId(), gx, gy);
+    std::string mapName = GetGridMapFileName(GetId(), gx, gy);
 
     LOG_TRACE("maps", "Loading map {}", mapName);
 
     // loading data
     _gridMaps[gx][gy] = std::make_shared<GridMap>();
 
-    if (!_gridMaps[gx][gy]->LoadData(mapName))
+    if (!_gridMaps[gx][gy]->LoadData(mapName, CONF_GET_BOOL("GridMap.MemoryMapped")))
         LOG_ERROR("maps", "Error loading map file: {}", mapName);
 
     sScriptMgr->OnLoadGridMap(this, _gridMaps[gx][gy].get(), gx, gy);
 }
 
+void Map::PrefetchGridMaps(float x, float y)
+{
+    float distance = CONF_GET_FLOAT("GridMap.PrefetchDistance");
+    if (distance <= 0.0f)
+        return;
+
+    GridCoord current = Warhead::ComputeGridCoord(x, y);
+
+    for (float offsetX : { -distance, 0.0f, distance })
+    {
+        for (float offsetY : { -distance, 0.0f, distance })
+        {
+            GridCoord coord = Warhead::ComputeGridCoord(x + offsetX, y + offsetY);
+            if (coord == current || !coord.IsCoordValid())
+                continue;
+
+            //z coord
+            int gx = (MAX_NUMBER_OF_GRIDS - 1) - coord.x_coord;
+            int gy = (MAX_NUMBER_OF_GRIDS - 1) - coord.y_coord;
+
+            if (_gridMaps[gx][gy] || _prefetchedGridMaps.test(gx * MAX_NUMBER_OF_GRIDS + gy))
+                continue;
+
+            _prefetchedGridMaps.set(gx * MAX_NUMBER_OF_GRIDS + gy);
+            GridMap::Prefetch(GetGridMapFileName(GetId(), gx, gy));
+        }
+    }
+}
+
 void Map::LoadMapAndVMap(int gx, int gy)
 {
     LoadMap(gx, gy);
@@ -230,6 +279,7 @@ Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
     _visibleDistance(DEFAULT_VISIBILITY_DISTANCE),
     _activeNonPlayersIter(_activeNonPlayers.end()),
     _transportsUpdateIter(_transports.end()),
+    _pathRequests(std::make_unique<PathRequestQueue>()),
     _defaultLight(GetDefaultMapLight(id))
 {
     m_parentMap = (_parent ? _parent : this);
@@ -551,6 +601,8 @@ void Map::InitializeObject(GameObject*  /*obj*/)
 template<class T>
 bool Map::AddToMap(T* obj, bool checkTransport)
 {
+    auto regionGuard = LockForRegionMerge();
+
     //TODO: Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
     {
@@ -735,45 +787,8 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Warhead::Obj
     }
 }
 
-void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
+void Map::UpdateActiveCells(uint32 t_diff, uint32 s_diff)
 {
-    if (t_diff)
-        _dynamicTree.update(t_diff);
-
-    /// update worldsessions for existing players
-    for (m_mapRefIter = m_mapRefMgr.begin(); m_mapRefIter != m_mapRefMgr.end(); ++m_mapRefIter)
-    {
-        Player* player = m_mapRefIter->GetSource();
-        if (player && player->IsInWorld())
-        {
-            //player->Update(t_diff);
-            WorldSession* session = player->GetSession();
-            MapSessionFilter updater(session);
-            session->Update(s_diff, updater);
-        }
-    }
-
-    if (!t_diff)
-    {
-        for (m_mapRefIter = m_mapRefMgr.begin(); m_mapRefIter != m_mapRefMgr.end(); ++m_mapRefIter)
-        {
-            Player* player = m_mapRefIter->GetSource();
-
-            if (!player || !player->IsInWorld())
-                continue;
-
-            // update players at tick
-            player->Update(s_diff);
-        }
-
-        HandleDelayedVisibility();
-        return;
-    }
-
-    /// update active cells around players and active objects
-    resetMarkedCells();
-    resetMarkedCellsLarge();
-
     Warhead::ObjectUpdater updater(t_diff, false);
 
     // for creature
@@ -852,6 +867,348 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
                 VisitNearbyCellsOf(itr, grid_object_update, world_object_update, grid_large_object_update, world_large_object_update);
         }
     }
+}
+
+bool Map::CanUpdateRegionsInParallel() const
+{
+    // Only busy open world maps, instances are small enough for one thread
+    if (Instanceable() || !CONF_GET_BOOL("MapUpdate.ParallelRegions.Enable"))
+        return false;
+
+    if (!sMapMgr->GetMapUpdater()->IsActive())
+        return false;
+
+    return GetPlayersCountExceptGMs() >= CONF_GET_UINT("MapUpdate.ParallelRegions.MinPlayers");
+}
+
+void Map::UpdateActiveCellsInParallel(uint32 t_diff, uint32 s_diff)
+{
+    if (_regionCells.empty())
+        _regionCells.resize(MAX_NUMBER_OF_GRIDS * MAX_NUMBER_OF_GRIDS);
+
+    // Serial phase: update players and collect cells around activation sources like UpdateActiveCells does
+    for (_activeNonPlayersIter = _activeNonPlayers.begin(); _activeNonPlayersIter != _activeNonPlayers.end();)
+    {
+        WorldObject* obj = *_activeNonPlayersIter;
+        ++_activeNonPlayersIter;
+
+        if (!obj || !obj->IsInWorld())
+            continue;
+
+        CollectRegionCells(obj);
+    }
+
+    for (m_mapRefIter = m_mapRefMgr.begin(); m_mapRefIter != m_mapRefMgr.end(); ++m_mapRefIter)
+    {
+        Player* player = m_mapRefIter->GetSource();
+
+        if (!player || !player->IsInWorld())
+            continue;
+
+        player->Update(s_diff);
+
+        CollectRegionCellsOfPlayer(player);
+
+        if (WorldObject* viewPoint = player->GetViewpoint())
+            if (viewPoint->ToCreature() || viewPoint->ToDynObject())
+                CollectRegionCells(viewPoint);
+
+        // creatures in combat with player and are more than X yards away
+        if (player->IsInCombat())
+        {
+            float rangeSq = player->GetGridActivationRange() - 1.0f;
+            rangeSq = rangeSq * rangeSq;
+
+            for (HostileReference* ref = player->getHostileRefMgr().getFirst(); ref; ref = ref->next())
+                if (Unit* unit = ref->GetSource()->GetOwner())
+                    if (Creature* cre = unit->ToCreature())
+                        if (cre->FindMap() == player->FindMap() && cre->GetExactDist2dSq(player) > rangeSq)
+                            CollectRegionCells(cre);
+        }
+    }
+
+    // Grid loading adds objects to map, do it before threads start
+    for (uint32 gridId : _activeRegions)
+    {
+        RegionCells const& region = _regionCells[gridId];
+        uint32 cellId = region.Cells.empty() ? region.LargeCells.front() : region.Cells.front();
+        EnsureGridLoaded(Cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP)));
+    }
+
+    // Parallel phases: grids with the same parity of both coordinates are at least one grid apart,
+    // so objects in them can't see or reach each other (MAX_VISIBILITY_DISTANCE * 2 < SIZE_OF_GRIDS)
+    static_assert(MAX_VISIBILITY_DISTANCE * 2 < SIZE_OF_GRIDS, "Parallel region update requires regions farther than visibility distance");
+
+    std::array<std::vector<uint32>, 4> phases;
+
+    for (uint32 gridId : _activeRegions)
+    {
+        uint32 gridX = gridId % MAX_NUMBER_OF_GRIDS;
+        uint32 gridY = gridId / MAX_NUMBER_OF_GRIDS;
+        phases[(gridX & 1) | ((gridY & 1) << 1)].emplace_back(gridId);
+    }
+
+    _parallelRegionUpdate = true;
+
+    for (auto const& phase : phases)
+    {
+        sMapMgr->GetMapUpdater()->ExecuteParallel(phase.size(), [this, &phase, t_diff](uint32 index)
+        {
+            UpdateRegion(_regionCells[phase[index]], t_diff);
+        });
+    }
+
+    _parallelRegionUpdate = false;
+
+    ApplySpawnIdStoreChanges();
+
+    // Serial phase: objects seen from far away and objects linked to other regions
+    Warhead::ObjectUpdater largeObjectUpdater(t_diff, true);
+    TypeContainerVisitor<Warhead::ObjectUpdater, GridTypeMapContainer> grid_large_object_update(largeObjectUpdater);
+    TypeContainerVisitor<Warhead::ObjectUpdater, WorldTypeMapContainer> world_large_object_update(largeObjectUpdater);
+
+    for (uint32 gridId : _activeRegions)
+    {
+        RegionCells& region = _regionCells[gridId];
+
+        for (uint32 cellId : region.LargeCells)
+        {
+            Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+            Visit(cell, grid_large_object_update);
+            Visit(cell, world_large_object_update);
+        }
+
+        // Removed objects are deleted in RemoveAllObjectsInRemoveList, pointers are valid until then
+        for (WorldObject* obj : region.Deferred)
+            if (obj->IsInWorld())
+                obj->Update(t_diff);
+
+        region.Cells.clear();
+        region.LargeCells.clear();
+        region.Deferred.clear();
+    }
+
+    _activeRegions.clear();
+}
+
+void Map::CollectRegionCells(WorldObject* obj)
+{
+    if (!obj->IsPositionValid() || obj->GetGridActivationRange() <= 0.0f)
+        return;
+
+    CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), obj->GetGridActivationRange());
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            if (isCellMarked(cell_id))
+                continue;
+
+            markCell(cell_id);
+            AddRegionCell(x, y, false);
+
+            if (!isCellMarkedLarge(cell_id))
+            {
+                markCellLarge(cell_id);
+                AddRegionCell(x, y, true);
+            }
+        }
+    }
+}
+
+void Map::CollectRegionCellsOfPlayer(Player* player)
+{
+    if (!player->IsPositionValid())
+        return;
+
+    CollectRegionCells(player);
+
+    CellArea area = Cell::CalculateCellArea(player->GetPositionX(), player->GetPositionY(), MAX_VISIBILITY_DISTANCE);
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            if (isCellMarkedLarge(cell_id))
+                continue;
+
+            markCellLarge(cell_id);
+            AddRegionCell(x, y, true);
+        }
+    }
+}
+
+void Map::AddRegionCell(uint32 x, uint32 y, bool large)
+{
+    uint32 gridId = (y / MAX_NUMBER_OF_CELLS) * MAX_NUMBER_OF_GRIDS + (x / MAX_NUMBER_OF_CELLS);
+    RegionCells& region = _regionCells[gridId];
+
+    if (region.Cells.empty() && region.LargeCells.empty())
+        _activeRegions.emplace_back(gridId);
+
+    (large ? region.LargeCells : region.Cells).emplace_back((y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x);
+}
+
+void Map::UpdateRegion(RegionCells& region, uint32 t_diff)
+{
+    Warhead::ObjectUpdater updater(t_diff, false, &region.Deferred);
+    TypeContainerVisitor<Warhead::ObjectUpdater, GridTypeMapContainer> grid_object_update(updater);
+    TypeContainerVisitor<Warhead::ObjectUpdater, WorldTypeMapContainer> world_object_update(updater);
+
+    for (uint32 cellId : region.Cells)
+    {
+        Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+        Visit(cell, grid_object_update);
+        Visit(cell, world_object_update);
+    }
+}
+
+bool Map::CanUpdateInRegion(WorldObject const* obj) const
+{
+    // Dynamic objects change auras of their caster, large objects are seen from other regions
+    if (obj->GetTypeId() == TYPEID_DYNAMICOBJECT || obj->IsVisibilityOverridden())
+        return false;
+
+    // Zone scripts keep state of the whole zone
+    uint32 zoneId = obj->GetZoneId();
+    if (sOutdoorPvPMgr->GetOutdoorPvPToZoneId(zoneId) || sBattlefieldMgr->GetBattlefieldToZoneId(zoneId))
+        return false;
+
+    if (GameObject const* go = obj->ToGameObject())
+        return !go->GetOwnerGUID();
+
+    Creature const* creature = obj->ToCreature();
+    if (!creature)
+        return false;
+
+    // Threat links, formations, owners and controlled units may be in any distance
+    if (creature->IsInCombat() || creature->GetFormation() || creature->IsSummon() || creature->GetVehicleKit() || creature->GetVehicle())
+        return false;
+
+    if (creature->GetCharmerOrOwnerGUID() || creature->GetMinionGUID() || creature->GetCharmGUID() || !creature->m_Controlled.empty())
+        return false;
+
+    return true;
+}
+
+void Map::AddToSpawnIdStore(Creature* creature)
+{
+    if (_parallelRegionUpdate)
+    {
+        auto regionGuard = LockForRegionMerge();
+        _spawnIdStoreChanges.push_back({ creature, creature->GetSpawnId(), true });
+        return;
+    }
+
+    _creatureBySpawnIdStore.emplace(creature->GetSpawnId(), creature);
+}
+
+void Map::RemoveFromSpawnIdStore(Creature* creature)
+{
+    if (_parallelRegionUpdate)
+    {
+        auto regionGuard = LockForRegionMerge();
+        _spawnIdStoreChanges.push_back({ creature, creature->GetSpawnId(), false });
+        return;
+    }
+
+    Warhead::Containers::MultimapErasePair(_creatureBySpawnIdStore, creature->GetSpawnId(), creature);
+}
+
+void Map::AddToSpawnIdStore(GameObject* gameObject)
+{
+    if (_parallelRegionUpdate)
+    {
+        auto regionGuard = LockForRegionMerge();
+        _spawnIdStoreChanges.push_back({ gameObject, gameObject->GetSpawnId(), true });
+        return;
+    }
+
+    _gameobjectBySpawnIdStore.emplace(gameObject->GetSpawnId(), gameObject);
+}
+
+void Map::RemoveFromSpawnIdStore(GameObject* gameObject)
+{
+    if (_parallelRegionUpdate)
+    {
+        auto regionGuard = LockForRegionMerge();
+        _spawnIdStoreChanges.push_back({ gameObject, gameObject->GetSpawnId(), false });
+        return;
+    }
+
+    Warhead::Containers::MultimapErasePair(_gameobjectBySpawnIdStore, gameObject->GetSpawnId(), gameObject);
+}
+
+void Map::ApplySpawnIdStoreChanges()
+{
+    // Objects are deleted in RemoveAllObjectsInRemoveList, pointers are valid until then
+    for (SpawnIdStoreChange const& change : _spawnIdStoreChanges)
+    {
+        if (Creature* creature = change.Object->ToCreature())
+        {
+            if (change.Add)
+                _creatureBySpawnIdStore.emplace(change.SpawnId, creature);
+            else
+                Warhead::Containers::MultimapErasePair(_creatureBySpawnIdStore, change.SpawnId, creature);
+        }
+        else if (GameObject* gameObject = change.Object->ToGameObject())
+        {
+            if (change.Add)
+                _gameobjectBySpawnIdStore.emplace(change.SpawnId, gameObject);
+            else
+                Warhead::Containers::MultimapErasePair(_gameobjectBySpawnIdStore, change.SpawnId, gameObject);
+        }
+    }
+
+    _spawnIdStoreChanges.clear();
+}
+
+void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
+{
+    if (t_diff)
+        _dynamicTree.update(t_diff);
+
+    /// update worldsessions for existing players
+    for (m_mapRefIter = m_mapRefMgr.begin(); m_mapRefIter != m_mapRefMgr.end(); ++m_mapRefIter)
+    {
+        Player* player = m_mapRefIter->GetSource();
+        if (player && player->IsInWorld())
+        {
+            //player->Update(t_diff);
+            WorldSession* session = player->GetSession();
+            MapSessionFilter updater(session);
+            session->Update(s_diff, updater);
+        }
+    }
+
+    if (!t_diff)
+    {
+        for (m_mapRefIter = m_mapRefMgr.begin(); m_mapRefIter != m_mapRefMgr.end(); ++m_mapRefIter)
+        {
+            Player* player = m_mapRefIter->GetSource();
+
+            if (!player || !player->IsInWorld())
+                continue;
+
+            // update players at tick
+            player->Update(s_diff);
+        }
+
+        HandleDelayedVisibility();
+        return;
+    }
+
+    /// update active cells around players and active objects
+    resetMarkedCells();
+    resetMarkedCellsLarge();
+
+    if (CanUpdateRegionsInParallel())
+        UpdateActiveCellsInParallel(t_diff, s_diff);
+    else
+        UpdateActiveCells(t_diff, s_diff);
 
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();) // pussywizard: transports updated after VisitNearbyCellsOf, grids around are loaded, everything ok
     {
@@ -864,6 +1221,9 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
         transport->Update(t_diff);
     }
 
+    // motion generators get paths requested during object updates on their next update
+    _pathRequests->Update(this);
+
     SendObjectUpdates();
 
     ///- Process necessary scripts
@@ -882,15 +1242,21 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 
     sScriptMgr->OnMapUpdate(this, t_diff);
 
-    METRIC_VALUE("map_creatures", uint64(GetObjectsStore().Size<Creature>()),
+    METRIC_SERIES_VALUE(_creaturesMetricSeries, "map_creatures", uint64(GetObjectsStore().Size<Creature>()),
         METRIC_TAG("map_id", std::to_string(GetId())),
         METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
 
-    METRIC_VALUE("map_gameobjects", uint64(GetObjectsStore().Size<GameObject>()),
+    METRIC_SERIES_VALUE(_gameObjectsMetricSeries, "map_gameobjects", uint64(GetObjectsStore().Size<GameObject>()),
         METRIC_TAG("map_id", std::to_string(GetId())),
         METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
 }
 
+std::shared_ptr<PathRequest> Map::RequestPath(std::unique_ptr<PathGenerator> path, float destX, float destY, float destZ, bool forceDest /*= false*/)
+{
+    auto regionGuard = LockForRegionMerge();
+    return _pathRequests->Submit(std::move(path), destX, destY, destZ, forceDest);
+}
+
 void Map::HandleDelayedVisibility()
 {
     if (i_objectsForDelayedVisibility.empty())
@@ -948,6 +1314,8 @@ void Map::AfterPlayerUnlinkFromMap()
 template<class T>
 void Map::RemoveFromMap(T* obj, bool remove)
 {
+    auto regionGuard = LockForRegionMerge();
+
     bool inWorld = obj->IsInWorld() && obj->GetTypeId() >= TYPEID_UNIT && obj->GetTypeId() <= TYPEID_GAMEOBJECT;
     obj->RemoveFromWorld();
 
@@ -1024,6 +1392,9 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float o)
             EnsureGridLoaded(new_cell);
 
         AddToGrid(player, new_cell);
+
+        // Terrain of grid ahead is read in background before player gets there
+        PrefetchGridMaps(x, y);
     }
 
     player->Relocate(x, y, z, o);
@@ -1102,6 +1473,8 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
 
 void Map::AddCreatureToMoveList(Creature* c)
 {
+    auto regionGuard = LockForRegionMerge();
+
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _creaturesToMove.push_back(c);
 
@@ -1116,6 +1489,8 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
 
 void Map::AddGameObjectToMoveList(GameObject* go)
 {
+    auto regionGuard = LockForRegionMerge();
+
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _gameObjectsToMove.push_back(go);
 
@@ -1130,6 +1505,8 @@ void Map::RemoveGameObjectFromMoveList(GameObject* go)
 
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj)
 {
+    auto regionGuard = LockForRegionMerge();
+
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _dynamicObjectsToMove.push_back(dynObj);
     dynObj->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -1267,6 +1644,8 @@ bool Map::UnloadGrid(NGridType& ngrid)
         if (_gridMaps[gx][gy])
             _gridMaps[gx][gy].reset();
 
+        _prefetchedGridMaps.reset(gx * MAX_NUMBER_OF_GRIDS + gy);
+
         // x and y are swapped
         VMAP::VMapFactory::createOrGetVMapMgr()->unloadMap(GetId(), gx, gy);
         MMAP::MMapFactory::createOrGetMMapMgr()->unloadMap(GetId(), gx, gy);
@@ -1344,6 +1723,19 @@ uint32 Map::GetId() const
 // *****************************
 // Grid function
 // *****************************
+// Content of loaded map file, either memory mapped (pages shared through page cache) or read to private memory
+struct GridMapFile
+{
+    uint8 const* Data{};
+    std::size_t Size{};
+
+    boost::interprocess::mapped_region Region;
+    std::unique_ptr<uint8[]> Buffer;
+
+    // Copies of arrays not aligned for their type in file
+    std::vector<std::unique_ptr<uint8[]>> AlignedCopies;
+};
+
 GridMap::GridMap()
 {
     _gridGetHeight = &GridMap::GetHeightFromFlat;
@@ -1354,133 +1746,216 @@ GridMap::~GridMap()
     UnloadData();
 }
 
-bool GridMap::LoadData(std::string_view filename)
+bool GridMap::LoadData(std::string_view filename, bool memoryMapped /*= false*/)
 {
     // Unload old data if exist
     UnloadData();
 
-    map_fileheader header;
-
     // Not return error if file not found
     FILE* in = fopen(filename.data(), "rb");
     if (!in)
         return true;
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+
+    if (size < long(sizeof(map_fileheader)))
     {
         fclose(in);
         return false;
     }
 
-    if (header.mapMagic == MapMagic.asUInt && header.versionMagic == MapVersionMagic)
+    auto file = std::make_unique<GridMapFile>();
+    file->Size = std::size_t(size);
+
+    if (memoryMapped)
+    {
+        fclose(in);
+
+        try
+        {
+            boost::interprocess::file_mapping mapping(filename.data(), boost::interprocess::read_only);
+            file->Region = boost::interprocess::mapped_region(mapping, boost::interprocess::read_only, 0, file->Size);
+        }
+        catch (boost::interprocess::interprocess_exception const& e)
+        {
+            LOG_ERROR("maps", "Can't map file '{}' to memory: {}", filename, e.what());
+            return false;
+        }
+
+        // Start read of the whole file, first height lookups should not wait for disk
+        file->Region.advise(boost::interprocess::mapped_region::advice_willneed);
+        file->Data = static_cast<uint8 const*>(file->Region.get_address());
+    }
+    else
+    {
+        file->Buffer.reset(new uint8[file->Size]);
+
+        bool readed = fread(file->Buffer.get(), 1, file->Size, in) == file->Size;
+        fclose(in);
+
+        if (!readed)
+            return false;
+
+        file->Data = file->Buffer.get();
+    }
+
+    _file = std::move(file);
+
+    map_fileheader const* header = GetFileData<map_fileheader>(0);
+
+    if (header->mapMagic == MapMagic.asUInt && header->versionMagic == MapVersionMagic)
     {
         // loadup area data
-        if (header.areaMapOffset && !LoadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header->areaMapOffset && !LoadAreaData(header->areaMapOffset, header->areaMapSize))
         {
             LOG_ERROR("maps", "Error loading map area data\n");
-            fclose(in);
             return false;
         }
 
         // loadup height data
-        if (header.heightMapOffset && !LoadHeightData(in, header.heightMapOffset, header.heightMapSize))
+        if (header->heightMapOffset && !LoadHeightData(header->heightMapOffset, header->heightMapSize))
         {
             LOG_ERROR("maps", "Error loading map height data\n");
-            fclose(in);
             return false;
         }
 
         // loadup liquid data
-        if (header.liquidMapOffset && !LoadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header->liquidMapOffset && !LoadLiquidData(header->liquidMapOffset, header->liquidMapSize))
         {
             LOG_ERROR("maps", "Error loading map liquids data\n");
-            fclose(in);
             return false;
         }
 
         // loadup holes data (if any. check header.holesOffset)
-        if (header.holesSize && !LoadHolesData(in, header.holesOffset, header.holesSize))
+        if (header->holesSize && !LoadHolesData(header->holesOffset, header->holesSize))
         {
             LOG_ERROR("maps", "Error loading map holes data\n");
-            fclose(in);
             return false;
         }
 
-        fclose(in);
         return true;
     }
 
     LOG_ERROR("maps", "Map file '{}' is from an incompatible clientversion. Please recreate using the mapextractor.", filename);
-    fclose(in);
     return false;
 }
 
 void GridMap::UnloadData()
 {
     _gridGetHeight = &GridMap::GetHeightFromFlat;
+    _gridHeight = INVALID_HEIGHT;
+    _gridArea = 0;
+    _liquidLevel = INVALID_HEIGHT;
+    _liquidGlobalEntry = 0;
+    _liquidGlobalFlags = 0;
+
+    _v9 = static_cast<float const*>(nullptr);
+    _v8 = static_cast<float const*>(nullptr);
+    _maxHeight = nullptr;
+    _minHeight = nullptr;
+    _areaMap = nullptr;
+    _liquidEntry = nullptr;
+    _liquidFlags = nullptr;
+    _liquidMap = nullptr;
+    _holes = nullptr;
+
+    _file.reset();
+}
+
+void GridMap::Prefetch(std::string const& filename)
+{
+#if WARHEAD_PLATFORM == WARHEAD_PLATFORM_UNIX
+    // Only queues read ahead, does not wait for it
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    close(fd);
+#else
+    (void)filename;
+#endif
 }
 
-bool GridMap::LoadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+template<class T>
+T const* GridMap::GetFileData(uint32 offset, uint32 count /*= 1*/)
 {
-    map_areaHeader header;
-    fseek(in, offset, SEEK_SET);
+    if (uint64(offset) + uint64(count) * sizeof(T) > _file->Size)
+        return nullptr;
+
+    uint8 const* data = _file->Data + offset;
+    if (reinterpret_cast<uintptr_t>(data) % alignof(T) == 0)
+        return reinterpret_cast<T const*>(data);
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapAreaMagic.asUInt)
+    // operator new[] result is aligned for any fundamental type
+    auto& copy = _file->AlignedCopies.emplace_back(new uint8[count * sizeof(T)]);
+    memcpy(copy.get(), data, count * sizeof(T));
+    return reinterpret_cast<T const*>(copy.get());
+}
+
+bool GridMap::LoadAreaData(uint32 offset, uint32 /*size*/)
+{
+    map_areaHeader const* header = GetFileData<map_areaHeader>(offset);
+    if (!header || header->fourcc != MapAreaMagic.asUInt)
         return false;
 
-    _gridArea = header.gridArea;
-    if (!(header.flags & MAP_AREA_NO_AREA))
+    _gridArea = header->gridArea;
+    if (!(header->flags & MAP_AREA_NO_AREA))
     {
-        _areaMap = std::make_unique<uint16[]>(16 * 16);
-        if (fread(_areaMap.get(), sizeof(uint16), 16 * 16, in) != 16 * 16)
+        _areaMap = GetFileData<uint16>(offset + sizeof(map_areaHeader), 16 * 16);
+        if (!_areaMap)
             return false;
     }
 
     return true;
 }
 
-bool GridMap::LoadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::LoadHeightData(uint32 offset, uint32 /*size*/)
 {
-    map_heightHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapHeightMagic.asUInt)
+    map_heightHeader const* header = GetFileData<map_heightHeader>(offset);
+    if (!header || header->fourcc != MapHeightMagic.asUInt)
         return false;
 
-    _gridHeight = header.gridHeight;
-    if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
+    offset += sizeof(map_heightHeader);
+
+    // V9 and V8 arrays follow the header, flight bounds follow them
+    auto LoadHeights = [&]<class T>(T const*)
     {
-        if ((header.flags & MAP_HEIGHT_AS_INT16))
-        {
-            _v9 = std::make_unique<uint16[]>(129 * 129);
-            _v8 = std::make_unique<uint16[]>(128 * 128);
+        T const* v9 = GetFileData<T>(offset, 129 * 129);
+        T const* v8 = GetFileData<T>(offset + 129 * 129 * sizeof(T), 128 * 128);
+        if (!v9 || !v8)
+            return false;
+
+        _v9 = v9;
+        _v8 = v8;
+        offset += (129 * 129 + 128 * 128) * sizeof(T);
+        return true;
+    };
 
-            if (fread(std::get<std::unique_ptr<uint16[]>>(_v9).get(), sizeof(uint16), 129 * 129, in) != 129 * 129 ||
-                fread(std::get<std::unique_ptr<uint16[]>>(_v8).get(), sizeof(uint16), 128 * 128, in) != 128 * 128)
+    _gridHeight = header->gridHeight;
+    if (!(header->flags & MAP_HEIGHT_NO_HEIGHT))
+    {
+        if ((header->flags & MAP_HEIGHT_AS_INT16))
+        {
+            if (!LoadHeights(static_cast<uint16 const*>(nullptr)))
                 return false;
 
-            _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
+            _gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 65535;
             _gridGetHeight = &GridMap::GetHeightFromUint16;
         }
-        else if ((header.flags & MAP_HEIGHT_AS_INT8))
+        else if ((header->flags & MAP_HEIGHT_AS_INT8))
         {
-            _v9 = std::make_unique<uint8[]>(129 * 129);
-            _v8 = std::make_unique<uint8[]>(128 * 128);
-
-            if (fread(std::get<std::unique_ptr<uint8[]>>(_v9).get(), sizeof(uint8), 129 * 129, in) != 129 * 129 ||
-                fread(std::get<std::unique_ptr<uint8[]>>(_v8).get(), sizeof(uint8), 128 * 128, in) != 128 * 128)
+            if (!LoadHeights(static_cast<uint8 const*>(nullptr)))
                 return false;
 
-            _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
+            _gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 255;
             _gridGetHeight = &GridMap::GetHeightFromUint8;
         }
         else
         {
-            _v9 = std::make_unique<float[]>(129 * 129);
-            _v8 = std::make_unique<float[]>(128 * 128);
-
-            if (fread(std::get<std::unique_ptr<float[]>>(_v9).get(), sizeof(float), 129 * 129, in) != 129 * 129 ||
-                fread(std::get<std::unique_ptr<float[]>>(_v8).get(), sizeof(float), 128 * 128, in) != 128 * 128)
+            if (!LoadHeights(static_cast<float const*>(nullptr)))
                 return false;
 
             _gridGetHeight = &GridMap::GetHeightFromFloat;
@@ -1489,66 +1964,59 @@ bool GridMap::LoadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     else
         _gridGetHeight = &GridMap::GetHeightFromFlat;
 
-    if (header.flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
+    if (header->flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
     {
-        _maxHeight = std::make_unique<int16[]>(3 * 3);
-        _minHeight = std::make_unique<int16[]>(3 * 3);
+        _maxHeight = GetFileData<int16>(offset, 3 * 3);
+        _minHeight = GetFileData<int16>(offset + 3 * 3 * sizeof(int16), 3 * 3);
 
-        if (fread(_maxHeight.get(), sizeof(int16), 3 * 3, in) != 3 * 3 ||
-            fread(_minHeight.get(), sizeof(int16), 3 * 3, in) != 3 * 3)
+        if (!_maxHeight || !_minHeight)
             return false;
     }
 
     return true;
 }
 
-bool GridMap::LoadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::LoadLiquidData(uint32 offset, uint32 /*size*/)
 {
-    map_liquidHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapLiquidMagic.asUInt)
+    map_liquidHeader const* header = GetFileData<map_liquidHeader>(offset);
+    if (!header || header->fourcc != MapLiquidMagic.asUInt)
         return false;
 
-    _liquidGlobalEntry = header.liquidType;
-    _liquidGlobalFlags = header.liquidFlags;
-    _liquidOffX  = header.offsetX;
-    _liquidOffY  = header.offsetY;
-    _liquidWidth = header.width;
-    _liquidHeight = header.height;
-    _liquidLevel  = header.liquidLevel;
+    _liquidGlobalEntry = header->liquidType;
+    _liquidGlobalFlags = header->liquidFlags;
+    _liquidOffX  = header->offsetX;
+    _liquidOffY  = header->offsetY;
+    _liquidWidth = header->width;
+    _liquidHeight = header->height;
+    _liquidLevel  = header->liquidLevel;
 
-    if (!(header.flags & MAP_LIQUID_NO_TYPE))
+    offset += sizeof(map_liquidHeader);
+
+    if (!(header->flags & MAP_LIQUID_NO_TYPE))
     {
-        _liquidEntry = std::make_unique<uint16[]>(16 * 16);
-        if (fread(_liquidEntry.get(), sizeof(uint16), 16 * 16, in) != 16 * 16)
-            return false;
+        _liquidEntry = GetFileData<uint16>(offset, 16 * 16);
+        _liquidFlags = GetFileData<uint8>(offset + 16 * 16 * sizeof(uint16), 16 * 16);
 
-        _liquidFlags = std::make_unique<uint8[]>(16 * 16);
-        if (fread(_liquidFlags.get(), sizeof(uint8), 16 * 16, in) != 16 * 16)
+        if (!_liquidEntry || !_liquidFlags)
             return false;
+
+        offset += 16 * 16 * (sizeof(uint16) + sizeof(uint8));
     }
 
-    if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
+    if (!(header->flags & MAP_LIQUID_NO_HEIGHT))
     {
-        _liquidMap = std::make_unique<float[]>(uint32(_liquidWidth) * uint32(_liquidHeight));
-        if (fread(_liquidMap.get(), sizeof(float), _liquidWidth * _liquidHeight, in) != (uint32(_liquidWidth) * uint32(_liquidHeight)))
+        _liquidMap = GetFileData<float>(offset, uint32(_liquidWidth) * uint32(_liquidHeight));
+        if (!_liquidMap)
             return false;
     }
 
     return true;
 }
 
-bool GridMap::LoadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::LoadHolesData(uint32 offset, uint32 /*size*/)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
-        return false;
-
-    _holes = std::make_unique<uint16[]>(16 * 16);
-    if (fread(_holes.get(), sizeof(uint16), 16 * 16, in) != 16 * 16)
-        return false;
-
-    return true;
+    _holes = GetFileData<uint16>(offset, 16 * 16);
+    return _holes != nullptr;
 }
 
 uint16 GridMap::GetArea(float x, float y) const
@@ -1570,7 +2038,7 @@ float GridMap::GetHeightFromFlat(float /*x*/, float /*y*/) const
 
 float GridMap::GetHeightFromFloat(float x, float y) const
 {
-    if (!std::holds_alternative<std::unique_ptr<float[]>>(_v8) || !std::holds_alternative<std::unique_ptr<float[]>>(_v9))
+    if (!std::holds_alternative<float const*>(_v8) || !std::holds_alternative<float const*>(_v9))
         return _gridHeight;
 
     x = MAP_RESOLUTION * (32 - x / SIZE_OF_GRIDS);
@@ -1602,8 +2070,8 @@ float GridMap::GetHeightFromFloat(float x, float y) const
     // Calculate coefficients for solve h = a*x + b*y + c
 
     float a, b, c;
-    auto v9 = std::get<std::unique_ptr<float[]>>(_v9).get();
-    auto v8 = std::get<std::unique_ptr<float[]>>(_v8).get();
+    auto v9 = std::get<float const*>(_v9);
+    auto v8 = std::get<float const*>(_v8);
 
     // Select triangle:
     if (x + y < 1)
@@ -1659,7 +2127,7 @@ float GridMap::GetHeightFromFloat(float x, float y) const
 
 float GridMap::GetHeightFromUint8(float x, float y) const
 {
-    if (!std::holds_alternative<std::unique_ptr<uint8[]>>(_v8) || !std::holds_alternative<std::unique_ptr<uint8[]>>(_v9))
+    if (!std::holds_alternative<uint8 const*>(_v8) || !std::holds_alternative<uint8 const*>(_v9))
         return _gridHeight;
 
     x = MAP_RESOLUTION * (32 - x / SIZE_OF_GRIDS);
@@ -1675,11 +2143,11 @@ float GridMap::GetHeightFromUint8(float x, float y) const
     if (isHole(x_int, y_int))
         return INVALID_HEIGHT;
 
-    auto v9 = std::get<std::unique_ptr<uint8[]>>(_v9).get();
-    auto v8 = std::get<std::unique_ptr<uint8[]>>(_v8).get();
+    auto v9 = std::get<uint8 const*>(_v9);
+    auto v8 = std::get<uint8 const*>(_v8);
 
     int32 a, b, c;
-    uint8* V9_h1_ptr = &v9[x_int * 128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &v9[x_int * 128 + x_int + y_int];
 
     if (x + y < 1)
     {
@@ -1734,7 +2202,7 @@ float GridMap::GetHeightFromUint8(float x, float y) const
 
 float GridMap::GetHeightFromUint16(float x, float y) const
 {
-    if (!std::holds_alternative<std::unique_ptr<uint16[]>>(_v8) || !std::holds_alternative<std::unique_ptr<uint16[]>>(_v9))
+    if (!std::holds_alternative<uint16 const*>(_v8) || !std::holds_alternative<uint16 const*>(_v9))
         return _gridHeight;
 
     x = MAP_RESOLUTION * (32 - x / SIZE_OF_GRIDS);
@@ -1751,9 +2219,9 @@ float GridMap::GetHeightFromUint16(float x, float y) const
         return INVALID_HEIGHT;
 
     int32 a, b, c;
-    auto v9 = std::get<std::unique_ptr<uint16[]>>(_v9).get();
-    auto v8 = std::get<std::unique_ptr<uint16[]>>(_v8).get();
-    uint16* V9_h1_ptr = &v9[x_int * 128 + x_int + y_int];
+    auto v9 = std::get<uint16 const*>(_v9);
+    auto v8 = std::get<uint16 const*>(_v8);
+    uint16 const* V9_h1_ptr = &v9[x_int * 128 + x_int + y_int];
 
     if (x + y < 1)
     {
@@ -2605,16 +3073,14 @@ void Map::SendRemoveTransports(Player* player)
             _transport->BuildOutOfRangeUpdateBlock(&transData);
 
     // pussywizard: remove static transports from client
-    for (auto it = player->m_clientGUIDs.begin(); it != player->m_clientGUIDs.end(); )
+    player->m_clientGUIDs.EraseIf([&transData](ObjectGuid guid)
     {
-        if ((*it).IsTransport())
-        {
-            transData.AddOutOfRangeGUID(*it);
-            it = player->m_clientGUIDs.erase(it);
-        }
-        else
-            ++it;
-    }
+        if (!guid.IsTransport())
+            return false;
+
+        transData.AddOutOfRangeGUID(guid);
+        return true;
+    });
 
     WorldPacket packet;
     transData.BuildPacket(&packet);
@@ -2652,6 +3118,18 @@ void Map::SendObjectUpdates()
         obj->BuildUpdate(update_players, player_set);
     }
 
+    if (CanBuildUpdatePacketsInParallel(update_players.size()))
+    {
+        std::vector<std::pair<Player*, UpdateData*>> updates;
+        updates.reserve(update_players.size());
+
+        for (auto& [player, updateData] : update_players)
+            updates.emplace_back(player, &updateData);
+
+        SendObjectUpdatesInParallel(updates);
+        return;
+    }
+
     WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
     for (auto& update_player : update_players)
     {
@@ -2661,6 +3139,34 @@ void Map::SendObjectUpdates()
     }
 }
 
+bool Map::CanBuildUpdatePacketsInParallel(std::size_t playersCount) const
+{
+    if (!CONF_GET_BOOL("MapUpdate.ParallelPackets.Enable") || !sMapMgr->GetMapUpdater()->IsActive())
+        return false;
+
+    return playersCount >= CONF_GET_UINT("MapUpdate.ParallelPackets.MinPlayers");
+}
+
+void Map::SendObjectUpdatesInParallel(std::vector<std::pair<Player*, UpdateData*>> const& updates)
+{
+    // Players per task, compression of one packet is too small to be scheduled alone
+    constexpr std::size_t PACKETS_PER_TASK = 4;
+
+    // Build and compress on map update threads, only this map's update data is touched
+    std::vector<WorldPacket> packets(updates.size());
+
+    sMapMgr->GetMapUpdater()->ExecuteParallel((updates.size() + PACKETS_PER_TASK - 1) / PACKETS_PER_TASK, [&updates, &packets](uint32 index)
+    {
+        std::size_t end = std::min(updates.size(), (index + 1) * PACKETS_PER_TASK);
+        for (std::size_t i = index * PACKETS_PER_TASK; i < end; ++i)
+            updates[i].second->BuildPacket(&packets[i]);
+    });
+
+    // Sessions get packets from map thread after all are built, same order as serial send
+    for (std::size_t i = 0; i < updates.size(); ++i)
+        updates[i].first->GetSession()->SendPacket(&packets[i]);
+}
+
 void Map::DelayedUpdate(uint32 t_diff)
 {
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
@@ -2683,6 +3189,7 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
+    auto regionGuard = LockForRegionMerge();
     i_objectsToRemove.insert(obj);
     //LOG_DEBUG("maps", "Object ({}) added to removing list.", obj->GetGUID().ToString());
 }
@@ -2695,6 +3202,8 @@ void Map::AddObjectToSwitchList(WorldObject* obj, bool on)
     if (obj->GetTypeId() != TYPEID_UNIT && obj->GetTypeId() != TYPEID_GAMEOBJECT)
         return;
 
+    auto regionGuard = LockForRegionMerge();
+
     auto itr = i_objectsToSwitch.find(obj);
     if (itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -2782,8 +3291,9 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    SharedWorldPacket sharedData;
     for (MapRefMgr::const_iterator itr = m_mapRefMgr.begin(); itr != m_mapRefMgr.end(); ++itr)
-        itr->GetSource()->GetSession()->SendPacket(data);
+        itr->GetSource()->GetSession()->SendPacket(data, sharedData);
 }
 
 template<class T>
@@ -3401,21 +3911,25 @@ void BattlegroundMap::RemoveAllPlayers()
 
 Corpse* Map::GetCorpse(ObjectGuid const guid)
 {
+    auto regionGuard = LockForRegionMerge();
     return _objectsStore.Find<Corpse>(guid);
 }
 
 Creature* Map::GetCreature(ObjectGuid const guid)
 {
+    auto regionGuard = LockForRegionMerge();
     return _objectsStore.Find<Creature>(guid);
 }
 
 GameObject* Map::GetGameObject(ObjectGuid const guid)
 {
+    auto regionGuard = LockForRegionMerge();
     return _objectsStore.Find<GameObject>(guid);
 }
 
 Pet* Map::GetPet(ObjectGuid const guid)
 {
+    auto regionGuard = LockForRegionMerge();
     return _objectsStore.Find<Pet>(guid);
 }
 
@@ -3430,6 +3944,7 @@ Transport* Map::GetTransport(ObjectGuid guid)
 
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    auto regionGuard = LockForRegionMerge();
     return _objectsStore.Find<DynamicObject>(guid);
 }
 
@@ -3452,7 +3967,10 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _creatureRespawnTimes[spawnId] = respawnTime;
+    {
+        auto regionGuard = LockForRegionMerge();
+        _creatureRespawnTimes[spawnId] = respawnTime;
+    }
 
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CREATURE_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -3464,7 +3982,10 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
 
 void Map::RemoveCreatureRespawnTime(ObjectGuid::LowType spawnId)
 {
-    _creatureRespawnTimes.erase(spawnId);
+    {
+        auto regionGuard = LockForRegionMerge();
+        _creatureRespawnTimes.erase(spawnId);
+    }
 
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -3486,7 +4007,10 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _goRespawnTimes[spawnId] = respawnTime;
+    {
+        auto regionGuard = LockForRegionMerge();
+        _goRespawnTimes[spawnId] = respawnTime;
+    }
 
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GO_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -3498,7 +4022,10 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
 
 void Map::RemoveGORespawnTime(ObjectGuid::LowType spawnId)
 {
-    _goRespawnTimes.erase(spawnId);
+    {
+        auto regionGuard = LockForRegionMerge();
+        _goRespawnTimes.erase(spawnId);
+    }
 
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN);
     stmt->SetData(0, spawnId);
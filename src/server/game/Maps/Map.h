@@ -25,6 +25,7 @@
 #include "GridDefines.h"
 #include "GridRefMgr.h"
 #include "MapRefMgr.h"
+#include "Metric.h"
 #include "ObjectDefines.h"
 #include "ObjectGuid.h"
 #include <bitset>
@@ -43,6 +44,7 @@ class Object;
 class WorldObject;
 class TempSummon;
 class Player;
+class UpdateData;
 class CreatureGroup;
 class Battleground;
 class MapInstanced;
@@ -52,6 +54,8 @@ class Transport;
 class StaticTransport;
 class MotionTransport;
 class PathGenerator;
+class PathRequest;
+class PathRequestQueue;
 class GameObjectModel;
 class MapEntry;
 
@@ -194,15 +198,21 @@ enum LineOfSightChecks
     LINEOFSIGHT_ALL_CHECKS          = LINEOFSIGHT_CHECK_VMAP | LINEOFSIGHT_CHECK_GOBJECT_ALL
 };
 
+struct GridMapFile;
+
 class WH_GAME_API GridMap
 {
 public:
     GridMap();
     ~GridMap();
 
-    bool LoadData(std::string_view filename);
+    // memoryMapped: use file pages from page cache directly (shared by all processes), otherwise read file to private memory
+    bool LoadData(std::string_view filename, bool memoryMapped = false);
     void UnloadData();
 
+    // Starts asynchronous read of file to page cache, so later LoadData does not wait for disk
+    static void Prefetch(std::string const& filename);
+
     [[nodiscard]] uint16 GetArea(float x, float y) const;
     [[nodiscard]] inline float GetHeight(float x, float y) const {return (this->*_gridGetHeight)(x, y);}
     [[nodiscard]] float GetMinHeight(float x, float y) const;
@@ -210,12 +220,15 @@ public:
     [[nodiscard]] LiquidData const GetLiquidData(float x, float y, float z, float collisionHeight, uint8 ReqLiquidType) const;
 
 private:
-    bool LoadAreaData(FILE* in, uint32 offset, uint32 size);
-    bool LoadHeightData(FILE* in, uint32 offset, uint32 size);
-    bool LoadLiquidData(FILE* in, uint32 offset, uint32 size);
-    bool LoadHolesData(FILE* in, uint32 offset, uint32 size);
+    bool LoadAreaData(uint32 offset, uint32 size);
+    bool LoadHeightData(uint32 offset, uint32 size);
+    bool LoadLiquidData(uint32 offset, uint32 size);
+    bool LoadHolesData(uint32 offset, uint32 size);
     [[nodiscard]] bool isHole(int row, int col) const;
 
+    template<class T>
+    T const* GetFileData(uint32 offset, uint32 count = 1);
+
     // Get height functions and pointers
     typedef float (GridMap::*GetHeightPtr)(float x, float y) const;
     GetHeightPtr _gridGetHeight;
@@ -227,24 +240,27 @@ private:
 
     uint32 _flags{};
 
-    std::variant<std::unique_ptr<float[]>, std::unique_ptr<uint16[]>, std::unique_ptr<uint8[]>> _v9;
-    std::variant<std::unique_ptr<float[]>, std::unique_ptr<uint16[]>, std::unique_ptr<uint8[]>> _v8;
+    // Owns file content, all arrays below point into it
+    std::unique_ptr<GridMapFile> _file;
+
+    std::variant<float const*, uint16 const*, uint8 const*> _v9;
+    std::variant<float const*, uint16 const*, uint8 const*> _v8;
 
-    std::unique_ptr<int16[]> _maxHeight;
-    std::unique_ptr<int16[]> _minHeight;
+    int16 const* _maxHeight{};
+    int16 const* _minHeight{};
 
     // Height level data
     float _gridHeight{ INVALID_HEIGHT };
     float _gridIntHeightMultiplier{};
 
     // Area data
-    std::unique_ptr<uint16[]> _areaMap;
+    uint16 const* _areaMap{};
 
     // Liquid data
     float _liquidLevel{ INVALID_HEIGHT };
-    std::unique_ptr<uint16[]> _liquidEntry;
-    std::unique_ptr<uint8[]> _liquidFlags;
-    std::unique_ptr<float[]> _liquidMap;
+    uint16 const* _liquidEntry{};
+    uint8 const* _liquidFlags{};
+    float const* _liquidMap{};
     uint16 _gridArea{};
     uint16 _liquidGlobalEntry{};
     uint8 _liquidGlobalFlags{};
@@ -252,7 +268,7 @@ private:
     uint8 _liquidOffY{};
     uint8 _liquidWidth{};
     uint8 _liquidHeight{};
-    std::unique_ptr<uint16[]> _holes;
+    uint16 const* _holes{};
 };
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push, N), also any gcc version not support it at some platform
@@ -362,6 +378,10 @@ public:
 
     virtual void Update(uint32, uint32, bool thread = true);
 
+    // Smoothed duration of previous updates in microseconds, used by MapUpdater to start expensive maps first
+    [[nodiscard]] uint32 GetUpdateCost() const { return _updateCost; }
+    void SetUpdateCost(uint32 cost) { _updateCost = cost; }
+
     [[nodiscard]] float GetVisibilityRange() const { return _visibleDistance; }
     void SetVisibilityRange(float range) { _visibleDistance = range; }
 
@@ -404,6 +424,7 @@ public:
 
     // pussywizard:
     std::unordered_set<Unit*> i_objectsForDelayedVisibility;
+    void AddObjectForDelayedVisibility(Unit* unit) { auto regionGuard = LockForRegionMerge(); i_objectsForDelayedVisibility.insert(unit); }
     void HandleDelayedVisibility();
 
     // some calls like isInWater should not use vmaps due to processor power
@@ -473,8 +494,11 @@ public:
     [[nodiscard]] bool HavePlayers() const { return !m_mapRefMgr.IsEmpty(); }
     [[nodiscard]] uint32 GetPlayersCountExceptGMs() const;
 
-    void AddWorldObject(WorldObject* obj) { i_worldObjects.insert(obj); }
-    void RemoveWorldObject(WorldObject* obj) { i_worldObjects.erase(obj); }
+    void AddWorldObject(WorldObject* obj) { auto regionGuard = LockForRegionMerge(); i_worldObjects.insert(obj); }
+    void RemoveWorldObject(WorldObject* obj) { auto regionGuard = LockForRegionMerge(); i_worldObjects.erase(obj); }
+
+    // Objects which may reach objects of other regions are updated serially after parallel region update
+    [[nodiscard]] bool CanUpdateInRegion(WorldObject const* obj) const;
 
     void SendToPlayers(WorldPacket const* data) const;
 
@@ -518,6 +542,12 @@ public:
     typedef std::unordered_multimap<ObjectGuid::LowType, GameObject*> GameObjectBySpawnIdContainer;
     GameObjectBySpawnIdContainer& GetGameObjectBySpawnIdStore() { return _gameobjectBySpawnIdStore; }
 
+    // Spawn id stores are read by objects of all regions, changes made in parallel region update are applied after it
+    void AddToSpawnIdStore(Creature* creature);
+    void RemoveFromSpawnIdStore(Creature* creature);
+    void AddToSpawnIdStore(GameObject* gameObject);
+    void RemoveFromSpawnIdStore(GameObject* gameObject);
+
     [[nodiscard]] std::unordered_set<Corpse*> const* GetCorpsesInCell(uint32 cellId) const
     {
         auto itr = _corpsesByCell.find(cellId);
@@ -570,6 +600,7 @@ public:
     [[nodiscard]] time_t GetLinkedRespawnTime(ObjectGuid guid) const;
     [[nodiscard]] time_t GetCreatureRespawnTime(ObjectGuid::LowType dbGuid) const
     {
+        auto regionGuard = LockForRegionMerge();
         auto itr = _creatureRespawnTimes.find(dbGuid);
         if (itr != _creatureRespawnTimes.end())
             return itr->second;
@@ -579,6 +610,7 @@ public:
 
     [[nodiscard]] time_t GetGORespawnTime(ObjectGuid::LowType dbGuid) const
     {
+        auto regionGuard = LockForRegionMerge();
         auto itr = _goRespawnTimes.find(dbGuid);
         if (itr != _goRespawnTimes.end())
             return itr->second;
@@ -632,19 +664,28 @@ public:
     inline ObjectGuid::LowType GenerateLowGuid()
     {
         static_assert(ObjectGuidTraits<high>::MapSpecific, "Only map specific guid can be generated in Map context");
+        auto regionGuard = LockForRegionMerge();
         return GetGuidSequenceGenerator<high>().Generate();
     }
 
     void AddUpdateObject(Object* obj)
     {
+        auto regionGuard = LockForRegionMerge();
         _updateObjects.insert(obj);
     }
 
     void RemoveUpdateObject(Object* obj)
     {
+        auto regionGuard = LockForRegionMerge();
         _updateObjects.erase(obj);
     }
 
+    // True while independent cell regions of this map are updated by several threads
+    [[nodiscard]] bool IsParallelRegionUpdate() const { return _parallelRegionUpdate; }
+
+    // Calculate path after objects of the map are updated, in parallel with paths requested by other objects
+    std::shared_ptr<PathRequest> RequestPath(std::unique_ptr<PathGenerator> path, float destX, float destY, float destZ, bool forceDest = false);
+
     size_t GetActiveNonPlayersCount() const
     {
         return _activeNonPlayers.size();
@@ -657,6 +698,9 @@ private:
     void LoadVMap(int gx, int gy);
     void LoadMap(int gx, int gy, bool reload = false);
 
+    // Queue read of terrain files of grids near position, see GridMap.PrefetchDistance in worldserver.conf
+    void PrefetchGridMaps(float x, float y);
+
     // Load MMap Data
     void LoadMMap(int gx, int gy);
 
@@ -692,6 +736,8 @@ private:
     void setNGrid(std::shared_ptr<NGridType> grid, uint32 x, uint32 y);
     void ScriptsProcess();
     void SendObjectUpdates();
+    [[nodiscard]] bool CanBuildUpdatePacketsInParallel(std::size_t playersCount) const;
+    void SendObjectUpdatesInParallel(std::vector<std::pair<Player*, UpdateData*>> const& updates);
 
 protected:
     std::mutex Lock;
@@ -731,8 +777,57 @@ private:
     //InstanceMaps and BattlegroundMaps...
     Map* m_parentMap;
 
+    uint32 _updateCost{};
+
+    // Metric series with map_id / map_instanceid tags, registered on first log
+    MetricSeriesId _creaturesMetricSeries{};
+    MetricSeriesId _gameObjectsMetricSeries{};
+
+    // Parallel region update, see MapUpdate.ParallelRegions in worldserver.conf
+    struct RegionCells
+    {
+        std::vector<uint32> Cells;      // cells to update normal objects
+        std::vector<uint32> LargeCells; // cells to update objects with overridden visibility
+        std::vector<WorldObject*> Deferred; // objects linked to other regions
+    };
+
+    struct SpawnIdStoreChange
+    {
+        WorldObject* Object;
+        ObjectGuid::LowType SpawnId;
+        bool Add;
+    };
+
+    [[nodiscard]] bool CanUpdateRegionsInParallel() const;
+    void UpdateActiveCells(uint32 t_diff, uint32 s_diff);
+    void UpdateActiveCellsInParallel(uint32 t_diff, uint32 s_diff);
+    void CollectRegionCells(WorldObject* obj);
+    void CollectRegionCellsOfPlayer(Player* player);
+    void AddRegionCell(uint32 x, uint32 y, bool large);
+    void UpdateRegion(RegionCells& region, uint32 t_diff);
+    void ApplySpawnIdStoreChanges();
+
+    // Map wide containers are shared between regions, changes are serialized here and applied in the serial phase after update
+    std::unique_lock<std::recursive_mutex> LockForRegionMerge() const
+    {
+        if (!_parallelRegionUpdate)
+            return {};
+
+        return std::unique_lock<std::recursive_mutex>(_regionMergeLock);
+    }
+
+    bool _parallelRegionUpdate{};
+    mutable std::recursive_mutex _regionMergeLock;
+    std::vector<RegionCells> _regionCells;
+    std::vector<uint32> _activeRegions;
+    std::vector<SpawnIdStoreChange> _spawnIdStoreChanges;
+
+    // Paths requested by motion generators, see MoveMaps.AsyncPathfinding in worldserver.conf
+    std::unique_ptr<PathRequestQueue> _pathRequests;
+
     std::shared_ptr<NGridType> i_grids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
     std::shared_ptr<GridMap> _gridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+    std::bitset<MAX_NUMBER_OF_GRIDS * MAX_NUMBER_OF_GRIDS> _prefetchedGridMaps;
     std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
     std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells_large;
 
@@ -753,11 +848,14 @@ private:
 
     void AddToActiveHelper(WorldObject* obj)
     {
+        auto regionGuard = LockForRegionMerge();
         _activeNonPlayers.insert(obj);
     }
 
     void RemoveFromActiveHelper(WorldObject* obj)
     {
+        auto regionGuard = LockForRegionMerge();
+
         // Map::Update for active object in proccess
         if (_activeNonPlayersIter != _activeNonPlayers.end())
         {
@@ -65,6 +65,9 @@ void MapMgr::Initialize()
     if (threadsCount)
         _updater->InitThreads(threadsCount);
 
+    if (threadsCount && CONF_GET_BOOL("MapUpdate.ParallelRegions.Enable"))
+        LOG_WARN("server.loading", "> MapUpdate.ParallelRegions.Enable is experimental, scripts touching objects of other regions are not thread safe");
+
     LOG_INFO("server.loading", ">> Added {} threads for map update in {}", threadsCount, sw);
     LOG_INFO("server.loading", "");
 }
@@ -54,14 +54,20 @@ void Map::ScriptsStart(ScriptMapMap const& scripts, uint32 id, Object* source, O
         sa.ownerGUID = ownerGUID;
 
         sa.script = &iter->second;
-        m_scriptSchedule.emplace(time_t(GameTime::GetGameTime().count() + iter->first), sa);
+
+        {
+            auto regionGuard = LockForRegionMerge();
+            m_scriptSchedule.emplace(time_t(GameTime::GetGameTime().count() + iter->first), sa);
+        }
+
         if (iter->first == 0)
             immedScript = true;
 
         sMapMgr->IncreaseScheduledScriptsCount();
     }
     ///- If one of the effects should be immediate, launch the script execution
-    if (/*start &&*/ immedScript && !_scriptLock)
+    ///- Scripts started in parallel region update are processed after the update
+    if (/*start &&*/ immedScript && !_scriptLock && !_parallelRegionUpdate)
     {
         _scriptLock = true;
         ScriptsProcess();
@@ -84,12 +90,17 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
     sa.ownerGUID = ownerGUID;
 
     sa.script = &script;
-    m_scriptSchedule.emplace(time_t(GameTime::GetGameTime().count() + delay), sa);
+
+    {
+        auto regionGuard = LockForRegionMerge();
+        m_scriptSchedule.emplace(time_t(GameTime::GetGameTime().count() + delay), sa);
+    }
 
     sMapMgr->IncreaseScheduledScriptsCount();
 
     ///- If effects should be immediate, launch the script execution
-    if (delay == 0 && !_scriptLock)
+    ///- Scripts started in parallel region update are processed after the update
+    if (delay == 0 && !_scriptLock && !_parallelRegionUpdate)
     {
         _scriptLock = true;
         ScriptsProcess();
@@ -23,66 +23,112 @@
 #include "LFGMgr.h"
 #include "Map.h"
 #include "Metric.h"
+#include <algorithm>
+#include <limits>
 
-class UpdateRequest
+namespace
 {
-public:
-    UpdateRequest() = default;
-    virtual ~UpdateRequest() = default;
+    // Index of the current map update worker, -1 for other threads
+    thread_local int32 _currentWorkerIndex = -1;
 
-    virtual void UpdateMap() = 0;
-};
+    // Weight of the last measured update in smoothed map update cost (1/4)
+    constexpr uint32 UPDATE_COST_SMOOTHING = 4;
 
-class MapUpdateRequest : public UpdateRequest
-{
-public:
-    MapUpdateRequest(Map& m, MapUpdater& u, uint32 d, uint32 sd) :
-        _map(m), _updater(u), _mapDiff(d), _sDiff(sd) { }
-
-    void UpdateMap() override
+    uint32 SmoothUpdateCost(uint32 oldCost, uint64 newCost)
     {
-        METRIC_TIMER("map_update_time_diff", METRIC_TAG("map_id", std::to_string(_map.GetId())));
-        _map.Update(_mapDiff, _sDiff);
-        _updater.FinishUpdate();
+        if (!oldCost)
+            return uint32(std::min<uint64>(newCost, std::numeric_limits<uint32>::max()));
+
+        return uint32(std::min<uint64>((uint64(oldCost) * (UPDATE_COST_SMOOTHING - 1) + newCost) / UPDATE_COST_SMOOTHING, std::numeric_limits<uint32>::max()));
     }
+}
 
-private:
-    Map& _map;
-    MapUpdater& _updater;
-    uint32 _mapDiff;
-    uint32 _sDiff;
-};
+void MapUpdater::RequestDeque::PushBack(UpdateRequest const& request)
+{
+    if (_size == _requests.size())
+        Grow();
+
+    _requests[(_head + _size) % _requests.size()] = request;
+    ++_size;
+}
 
-class LFGUpdateRequest : public UpdateRequest
+void MapUpdater::RequestDeque::PushFront(UpdateRequest const& request)
 {
-public:
-    LFGUpdateRequest(MapUpdater& u, uint32 d) : _updater(u), _diff(d) {}
+    if (_size == _requests.size())
+        Grow();
 
-    void UpdateMap() override
-    {
-        sLFGMgr->Update(_diff, 1);
-        _updater.FinishUpdate();
-    }
+    _head = (_head + _requests.size() - 1) % _requests.size();
+    _requests[_head] = request;
+    ++_size;
+}
+
+void MapUpdater::RequestDeque::Grow()
+{
+    // Grow and unwrap ring, happens only while tick load increases
+    std::vector<UpdateRequest> requests(std::max<std::size_t>(16, _requests.size() * 2));
+
+    for (std::size_t i = 0; i < _size; ++i)
+        requests[i] = _requests[(_head + i) % _requests.size()];
+
+    _requests.swap(requests);
+    _head = 0;
+}
 
-private:
-    MapUpdater& _updater;
-    uint32 _diff;
-};
+bool MapUpdater::RequestDeque::PopFront(UpdateRequest& request)
+{
+    if (!_size)
+        return false;
+
+    request = _requests[_head];
+    _head = (_head + 1) % _requests.size();
+    --_size;
+    return true;
+}
+
+bool MapUpdater::RequestDeque::PopBack(UpdateRequest& request)
+{
+    if (!_size)
+        return false;
+
+    request = _requests[(_head + _size - 1) % _requests.size()];
+    --_size;
+    return true;
+}
+
+bool MapUpdater::RequestDeque::PopFrontTask(ParallelTask const* task, UpdateRequest& request)
+{
+    if (!_size)
+        return false;
+
+    UpdateRequest const& front = _requests[_head];
+    if (front.Type != UpdateRequestType::Task || front.Task != task)
+        return false;
+
+    return PopFront(request);
+}
 
 void MapUpdater::InitThreads(std::size_t num_threads)
 {
+    _workers.reserve(num_threads);
     _workerThreads.reserve(num_threads);
 
     for (std::size_t i = 0; i < num_threads; ++i)
-        _workerThreads.emplace_back(&MapUpdater::InitializeThread, this);
+        _workers.emplace_back(std::make_unique<Worker>());
+
+    for (std::size_t i = 0; i < num_threads; ++i)
+        _workerThreads.emplace_back(&MapUpdater::WorkerThread, this, i);
 }
 
 void MapUpdater::Stop()
 {
-    _cancelationToken = true;
-
     WaitThreads();
-    _queue.Cancel();
+
+    {
+        std::lock_guard<std::mutex> guard(_workLock);
+        _cancelationToken = true;
+    }
+
+    _workCondition.notify_all();
 
     for (auto& thread : _workerThreads)
         if (thread.joinable())
@@ -91,26 +137,46 @@ void MapUpdater::Stop()
 
 void MapUpdater::WaitThreads()
 {
-    std::unique_lock<std::mutex> guard(_lock);
-
-    while (pending_requests)
-        _condition.wait(guard);
+    DispatchScheduledRequests();
 
+    std::unique_lock<std::mutex> guard(_finishLock);
+    _finishCondition.wait(guard, [this]() { return !_pendingRequests; });
     guard.unlock();
+
+    LogUtilization();
 }
 
 void MapUpdater::ScheduleUpdate(Map& map, uint32 diff, uint32 s_diff)
 {
-    std::lock_guard<std::mutex> guard(_lock);
-    ++pending_requests;
-    _queue.Push(new MapUpdateRequest(map, *this, diff, s_diff));
+    UpdateRequest request;
+    request.Type = UpdateRequestType::Map;
+    request.MapToUpdate = &map;
+    request.Diff = diff;
+    request.SDiff = s_diff;
+    request.Cost = map.GetUpdateCost();
+
+    ++_pendingRequests;
+
+    // Instance maps are scheduled by their parent map update, keep them on the same worker (can be stolen by idle ones)
+    if (_currentWorkerIndex >= 0)
+    {
+        PushRequest(_currentWorkerIndex, request);
+        _workCondition.notify_one();
+        return;
+    }
+
+    _scheduledRequests.emplace_back(request);
 }
 
 void MapUpdater::ScheduleLfgUpdate(uint32 diff)
 {
-    std::lock_guard<std::mutex> guard(_lock);
-    ++pending_requests;
-    _queue.Push(new LFGUpdateRequest(*this, diff));
+    UpdateRequest request;
+    request.Type = UpdateRequestType::Lfg;
+    request.Diff = diff;
+    request.Cost = _lfgUpdateCost;
+
+    ++_pendingRequests;
+    _scheduledRequests.emplace_back(request);
 }
 
 bool MapUpdater::IsActive()
@@ -118,28 +184,237 @@ bool MapUpdater::IsActive()
     return !_workerThreads.empty();
 }
 
+void MapUpdater::DispatchScheduledRequests()
+{
+    _tickStartTime = std::chrono::steady_clock::now();
+
+    if (_scheduledRequests.empty())
+        return;
+
+    // Longest processing time first: most expensive requests start first, each one goes to the least loaded worker
+    std::stable_sort(_scheduledRequests.begin(), _scheduledRequests.end(), [](UpdateRequest const& left, UpdateRequest const& right)
+    {
+        return left.Cost > right.Cost;
+    });
+
+    for (auto& worker : _workers)
+        worker->AssignedCost = 0;
+
+    for (auto const& request : _scheduledRequests)
+    {
+        auto itr = std::min_element(_workers.begin(), _workers.end(), [](auto const& left, auto const& right)
+        {
+            return left->AssignedCost < right->AssignedCost;
+        });
+
+        // Unknown cost still has to count, otherwise all new maps end up on one worker
+        (*itr)->AssignedCost += std::max<uint32>(request.Cost, 1);
+        PushRequest(std::distance(_workers.begin(), itr), request);
+    }
+
+    _scheduledRequests.clear();
+    _workCondition.notify_all();
+}
+
+void MapUpdater::ExecuteParallel(ParallelTask& task, std::size_t count)
+{
+    // Not a worker or nothing to split - run in place
+    if (_currentWorkerIndex < 0 || count <= 1)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            task.Function(task.Context, uint32(i));
+
+        return;
+    }
+
+    task.Remaining = count;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        UpdateRequest request;
+        request.Type = UpdateRequestType::Task;
+        request.Task = &task;
+        request.TaskIndex = uint32(i);
+
+        // Front of own deque: this worker picks tasks before its other maps, idle workers steal from the back
+        PushRequest(_currentWorkerIndex, request, true);
+    }
+
+    _workCondition.notify_all();
+
+    // Help with own tasks instead of waiting. Other requests are left to idle workers,
+    // a map update must not run nested in this one
+    UpdateRequest request;
+    while (PopTaskRequest(_currentWorkerIndex, &task, request))
+        ProcessRequest(request);
+
+    // All other tasks were stolen and run by other workers
+    std::unique_lock<std::mutex> lock(task.DoneLock);
+    task.Done.wait(lock, [&task] { return task.Remaining == 0; });
+}
+
+void MapUpdater::PushRequest(std::size_t workerIndex, UpdateRequest const& request, bool front /*= false*/)
+{
+    {
+        Worker& worker = *_workers[workerIndex];
+        std::lock_guard<std::mutex> guard(worker.Lock);
+
+        if (front)
+            worker.Requests.PushFront(request);
+        else
+            worker.Requests.PushBack(request);
+    }
+
+    ++_queuedRequests;
+
+    // Sync with idle workers checking _queuedRequests under _workLock
+    std::lock_guard<std::mutex> guard(_workLock);
+}
+
+bool MapUpdater::PopRequest(std::size_t workerIndex, UpdateRequest& request)
+{
+    // Own requests from the front (longest first)
+    {
+        Worker& worker = *_workers[workerIndex];
+        std::lock_guard<std::mutex> guard(worker.Lock);
+
+        if (worker.Requests.PopFront(request))
+        {
+            --_queuedRequests;
+            return true;
+        }
+    }
+
+    // Steal the cheapest request from the back of other workers
+    for (std::size_t i = 1; i < _workers.size(); ++i)
+    {
+        Worker& victim = *_workers[(workerIndex + i) % _workers.size()];
+        std::lock_guard<std::mutex> guard(victim.Lock);
+
+        if (victim.Requests.PopBack(request))
+        {
+            --_queuedRequests;
+            ++_workers[workerIndex]->StolenRequests;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool MapUpdater::PopTaskRequest(std::size_t workerIndex, ParallelTask const* task, UpdateRequest& request)
+{
+    // Tasks are pushed to the front of own deque and are never queued anywhere else
+    Worker& worker = *_workers[workerIndex];
+    std::lock_guard<std::mutex> guard(worker.Lock);
+
+    if (!worker.Requests.PopFrontTask(task, request))
+        return false;
+
+    --_queuedRequests;
+    return true;
+}
+
+void MapUpdater::ProcessRequest(UpdateRequest const& request)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    switch (request.Type)
+    {
+        case UpdateRequestType::Map:
+        {
+            Map& map = *request.MapToUpdate;
+
+            {
+                METRIC_SERIES_TIMER(_workers[_currentWorkerIndex]->MapUpdateTimeSeries[map.GetId()], "map_update_time_diff", METRIC_TAG("map_id", std::to_string(map.GetId())));
+                map.Update(request.Diff, request.SDiff);
+            }
+
+            map.SetUpdateCost(SmoothUpdateCost(map.GetUpdateCost(), std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - startTime).count()));
+            break;
+        }
+        case UpdateRequestType::Lfg:
+            sLFGMgr->Update(request.Diff, 1);
+            _lfgUpdateCost = SmoothUpdateCost(_lfgUpdateCost, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - startTime).count());
+            break;
+        case UpdateRequestType::Task:
+        {
+            ParallelTask* task = request.Task;
+            task->Function(task->Context, request.TaskIndex);
+
+            _workers[_currentWorkerIndex]->BusyTime += std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - startTime).count();
+
+            // Owner may return and destroy task once lock is released after last decrement, don't touch it anymore
+            std::lock_guard<std::mutex> guard(task->DoneLock);
+            if (--task->Remaining == 0)
+                task->Done.notify_one();
+
+            return;
+        }
+        default:
+            break;
+    }
+
+    Worker& worker = *_workers[_currentWorkerIndex];
+    worker.BusyTime += std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - startTime).count();
+    ++worker.ProcessedRequests;
+
+    FinishUpdate();
+}
+
 void MapUpdater::FinishUpdate()
 {
-    std::lock_guard<std::mutex> lock(_lock);
-    --pending_requests;
-    _condition.notify_all();
+    // Single wake up of the waiting thread when the last request of the tick is done
+    if (--_pendingRequests)
+        return;
+
+    std::lock_guard<std::mutex> guard(_finishLock);
+    _finishCondition.notify_all();
 }
 
-void MapUpdater::InitializeThread()
+void MapUpdater::LogUtilization()
 {
+    auto tickTime = std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - _tickStartTime).count();
+
+    for (std::size_t i = 0; i < _workers.size(); ++i)
+    {
+        Worker& worker = *_workers[i];
+
+        uint64 busyTime = worker.BusyTime.exchange(0);
+        uint32 processedRequests = worker.ProcessedRequests.exchange(0);
+        uint32 stolenRequests = worker.StolenRequests.exchange(0);
+
+        if (!tickTime)
+            continue;
+
+        METRIC_SERIES_VALUE(worker.UtilizationSeries, "map_updater_thread_utilization", std::min<uint64>(busyTime * 100 / tickTime, 100), METRIC_TAG("thread", std::to_string(i)));
+        METRIC_SERIES_VALUE(worker.RequestsSeries, "map_updater_thread_requests", processedRequests, METRIC_TAG("thread", std::to_string(i)));
+        METRIC_SERIES_VALUE(worker.StealsSeries, "map_updater_thread_steals", stolenRequests, METRIC_TAG("thread", std::to_string(i)));
+    }
+}
+
+void MapUpdater::WorkerThread(std::size_t workerIndex)
+{
+    _currentWorkerIndex = int32(workerIndex);
+
     AuthDatabase.WarnAboutSyncQueries(true);
     CharacterDatabase.WarnAboutSyncQueries(true);
     WorldDatabase.WarnAboutSyncQueries(true);
 
     for (;;)
     {
-        UpdateRequest* request = nullptr;
+        UpdateRequest request;
+
+        if (PopRequest(workerIndex, request))
+        {
+            ProcessRequest(request);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(_workLock);
+        _workCondition.wait(guard, [this]() { return _cancelationToken || _queuedRequests; });
 
-        _queue.WaitAndPop(request);
         if (_cancelationToken)
             return;
-
-        request->UpdateMap();
-        delete request;
     }
 }
@@ -19,11 +19,18 @@
 #define MAP_UPDATER_H_
 
 #include "Define.h"
-#include "PCQueue.h"
+#include "Duration.h"
+#include "Metric.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 class Map;
-class UpdateRequest;
 
 class WH_GAME_API MapUpdater
 {
@@ -37,19 +44,116 @@ public:
     void InitThreads(std::size_t num_threads);
     void Stop();
     bool IsActive();
-    void FinishUpdate();
+
+    // Run func(index) for every index in [0, count) on idle workers and return when all are done.
+    // Calling worker runs tasks too, so it's safe to call from a map update. Other threads run tasks in place
+    template<typename Func>
+    void ExecuteParallel(std::size_t count, Func&& func)
+    {
+        ParallelTask task;
+        task.Context = &func;
+        task.Function = [](void* context, uint32 index) { (*static_cast<std::remove_reference_t<Func>*>(context))(index); };
+        ExecuteParallel(task, count);
+    }
 
 private:
-    void InitializeThread();
+    enum class UpdateRequestType : uint8
+    {
+        Map,
+        Lfg,
+        Task
+    };
+
+    struct ParallelTask
+    {
+        void(*Function)(void*, uint32){ nullptr };
+        void* Context{ nullptr };
+        std::atomic<std::size_t> Remaining{ 0 };
+
+        // Signalled when Remaining drops to 0, owner waits on it for tasks run by other workers
+        std::mutex DoneLock;
+        std::condition_variable Done;
+    };
+
+    struct UpdateRequest
+    {
+        UpdateRequestType Type{ UpdateRequestType::Map };
+        Map* MapToUpdate{ nullptr };
+        ParallelTask* Task{ nullptr };
+        uint32 TaskIndex{ 0 };
+        uint32 Diff{ 0 };
+        uint32 SDiff{ 0 };
+        uint32 Cost{ 0 };
+    };
+
+    // Ring buffer deque, storage is reused between ticks so scheduling doesn't allocate
+    class RequestDeque
+    {
+    public:
+        bool IsEmpty() const { return _size == 0; }
+        std::size_t GetSize() const { return _size; }
+
+        void PushBack(UpdateRequest const& request);
+        void PushFront(UpdateRequest const& request);
+        bool PopFront(UpdateRequest& request);
+        bool PopBack(UpdateRequest& request);
+        bool PopFrontTask(ParallelTask const* task, UpdateRequest& request);
+
+    private:
+        void Grow();
+
+        std::vector<UpdateRequest> _requests;
+        std::size_t _head{ 0 };
+        std::size_t _size{ 0 };
+    };
 
-    ProducerConsumerQueue<UpdateRequest*> _queue;
+    struct Worker
+    {
+        std::mutex Lock;
+        RequestDeque Requests;
+
+        // Utilization counters, reset every tick by WaitThreads
+        std::atomic<uint64> BusyTime{ 0 };
+        std::atomic<uint32> ProcessedRequests{ 0 };
+        std::atomic<uint32> StolenRequests{ 0 };
+
+        // Cost of requests assigned at dispatch, only used by scheduling thread
+        uint64 AssignedCost{ 0 };
+
+        // Metric series of this worker, utilization ones are only logged by scheduling thread
+        std::unordered_map<uint32, MetricSeriesId> MapUpdateTimeSeries;
+        MetricSeriesId UtilizationSeries{};
+        MetricSeriesId RequestsSeries{};
+        MetricSeriesId StealsSeries{};
+    };
+
+    void ExecuteParallel(ParallelTask& task, std::size_t count);
+    void WorkerThread(std::size_t workerIndex);
+    void PushRequest(std::size_t workerIndex, UpdateRequest const& request, bool front = false);
+    bool PopRequest(std::size_t workerIndex, UpdateRequest& request);
+    bool PopTaskRequest(std::size_t workerIndex, ParallelTask const* task, UpdateRequest& request);
+    void ProcessRequest(UpdateRequest const& request);
+    void DispatchScheduledRequests();
+    void FinishUpdate();
+    void LogUtilization();
 
     std::vector<std::thread> _workerThreads;
-    std::atomic<bool> _cancelationToken;
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::atomic<bool> _cancelationToken{ false };
+
+    // Requests scheduled from world thread, dispatched longest first on WaitThreads
+    std::vector<UpdateRequest> _scheduledRequests;
+
+    std::mutex _workLock;
+    std::condition_variable _workCondition;
+    std::atomic<std::size_t> _queuedRequests{ 0 };
+
+    std::mutex _finishLock;
+    std::condition_variable _finishCondition;
+    std::atomic<std::size_t> _pendingRequests{ 0 };
 
-    std::mutex _lock;
-    std::condition_variable _condition;
-    std::size_t pending_requests{};
+    uint32 _lfgUpdateCost{ 0 };
+    TimePoint _tickStartTime;
 };
 
 #endif
@@ -25,6 +25,7 @@
 #include "MoveSplineInit.h"
 #include "ObjectAccessor.h"
 #include "PathGenerator.h"
+#include "PathRequestQueue.h"
 #include "Player.h"
 
 #define MIN_QUIET_DISTANCE 28.0f
@@ -41,6 +42,7 @@ void FleeingMovementGenerator<T>::DoInitialize(T* owner)
 
     owner->StopMoving();
     _path = nullptr;
+    _pathRequest = nullptr;
     owner->SetUnitFlag(UNIT_FLAG_FLEEING);
     owner->AddUnitState(UNIT_STATE_FLEEING);
     SetTargetLocation(owner);
@@ -88,6 +90,7 @@ bool FleeingMovementGenerator<T>::DoUpdate(T* owner, uint32 diff)
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || owner->IsMovementPreventedByCasting())
     {
         _path = nullptr;
+        _pathRequest = nullptr;
         _interrupt = true;
         owner->StopMoving();
         return true;
@@ -95,6 +98,19 @@ bool FleeingMovementGenerator<T>::DoUpdate(T* owner, uint32 diff)
     else
         _interrupt = false;
 
+    // path requested on previous update, move once it's calculated
+    if (_pathRequest)
+    {
+        if (_pathRequest->IsReady())
+        {
+            PathRequestPtr request = std::move(_pathRequest);
+            _path = request->TakePath();
+            LaunchPath(owner, request->IsSuccess());
+        }
+
+        return true;
+    }
+
     _timer.Update(diff);
     if (!_interrupt && _timer.Passed() && owner->movespline->Finalized())
     {
@@ -115,6 +131,7 @@ void FleeingMovementGenerator<T>::SetTargetLocation(T* owner)
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || owner->IsMovementPreventedByCasting())
     {
         _path = nullptr;
+        _pathRequest = nullptr;
         _interrupt = true;
         owner->StopMoving();
         return;
@@ -142,8 +159,21 @@ void FleeingMovementGenerator<T>::SetTargetLocation(T* owner)
     }
 
     _path->SetPathLengthLimit(30.0f);
+
+    if (PathRequestQueue::IsEnabled())
+    {
+        _pathRequest = owner->GetMap()->RequestPath(std::move(_path), destination.GetPositionX(), destination.GetPositionY(), destination.GetPositionZ());
+        return;
+    }
+
     bool result = _path->CalculatePath(destination.GetPositionX(), destination.GetPositionY(), destination.GetPositionZ());
-    if (!result || (_path->GetPathType() & PathType(PATHFIND_NOPATH | PATHFIND_SHORTCUT | PATHFIND_FARFROMPOLY)))
+    LaunchPath(owner, result);
+}
+
+template<class T>
+void FleeingMovementGenerator<T>::LaunchPath(T* owner, bool success)
+{
+    if (!success || (_path->GetPathType() & PathType(PATHFIND_NOPATH | PATHFIND_SHORTCUT | PATHFIND_FARFROMPOLY)))
     {
         _timer.Reset(100);
         return;
@@ -60,6 +60,23 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
 }
 
 bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float destY, float destZ, bool forceDest)
+{
+    if (!PreparePath(x, y, z, destX, destY, destZ, forceDest))
+        return false;
+
+    if (_type != PATHFIND_BLANK)
+        return true;
+
+    // regions of the map are updated by several threads, the query of the instance can't be shared by them
+    if (Map const* map = _source->FindMap(); map && map->IsParallelRegionUpdate())
+        BuildPreparedPath(MMAP::MMapFactory::createOrGetMMapMgr()->GetThreadNavMeshQuery(_source->GetMapId()));
+    else
+        BuildPolyPath(_startPosition, _endPosition);
+
+    return true;
+}
+
+bool PathGenerator::PreparePath(float x, float y, float z, float destX, float destY, float destZ, bool forceDest)
 {
     if (!Warhead::IsValidMapCoord(destX, destY, destZ) || !Warhead::IsValidMapCoord(x, y, z))
         return false;
@@ -87,10 +104,40 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
 
     UpdateFilter();
 
-    BuildPolyPath(start, dest);
+    _type = PATHFIND_BLANK;
     return true;
 }
 
+void PathGenerator::BuildPreparedPath(dtNavMeshQuery const* navMeshQuery)
+{
+    if (!navMeshQuery)
+    {
+        BuildShortcut();
+        _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        return;
+    }
+
+    dtNavMeshQuery const* instanceQuery = _navMeshQuery;
+    _navMeshQuery = navMeshQuery;
+
+    BuildPolyPath(_startPosition, _endPosition);
+
+    _navMeshQuery = instanceQuery;
+}
+
+void PathGenerator::CopyPreparedPath(PathGenerator const& other)
+{
+    memcpy(_pathPolyRefs, other._pathPolyRefs, sizeof(_pathPolyRefs));
+    _polyLength = other._polyLength;
+    _pathPoints = other._pathPoints;
+    _type = other._type;
+    _actualEndPosition = other._actualEndPosition;
+
+    // path of near start position, begin it from own one
+    if (!_pathPoints.empty())
+        _pathPoints[0] = _startPosition;
+}
+
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
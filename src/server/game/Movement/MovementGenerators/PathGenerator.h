@@ -128,6 +128,9 @@ class WH_GAME_API PathGenerator
         }
 
     private:
+        // PathRequestQueue splits CalculatePath: PreparePath on map thread, BuildPreparedPath on any thread of the map update
+        friend class PathRequestQueue;
+
         dtPolyRef _pathPolyRefs[MAX_PATH_LENGTH];   // array of detour polygon references
         uint32 _polyLength;                         // number of polygons in the path
 
@@ -155,6 +158,11 @@ class WH_GAME_API PathGenerator
         void SetActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
         void NormalizePath();
 
+        // return: false if coordinates are invalid, path type stays PATHFIND_BLANK if navmesh path has to be built
+        bool PreparePath(float x, float y, float z, float destX, float destY, float destZ, bool forceDest);
+        void BuildPreparedPath(dtNavMeshQuery const* navMeshQuery);
+        void CopyPreparedPath(PathGenerator const& other);
+
         [[nodiscard]] bool InRange(G3D::Vector3 const& p1, G3D::Vector3 const& p2, float r, float h) const;
         [[nodiscard]] float Dist3DSqr(G3D::Vector3 const& p1, G3D::Vector3 const& p2) const;
         bool InRangeYZX(float const* v1, float const* v2, float r, float h) const;
@@ -0,0 +1,228 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathRequestQueue.h"
+#include "GameConfig.h"
+#include "Map.h"
+#include "MapMgr.h"
+#include "MapUpdater.h"
+#include "Unit.h"
+#include <bit>
+#include <cmath>
+
+namespace
+{
+    enum PathKeyOptions : int32
+    {
+        PATH_KEY_FORCE_DESTINATION  = 0x001,
+        PATH_KEY_STRAIGHT_PATH      = 0x002,
+        PATH_KEY_SLOPE_CHECK        = 0x004,
+        PATH_KEY_RAYCAST            = 0x008,
+        PATH_KEY_UNIT               = 0x010,
+        PATH_KEY_CREATURE           = 0x020,
+        PATH_KEY_CAN_FLY            = 0x040,
+        PATH_KEY_CAN_SWIM           = 0x080,
+        PATH_KEY_FALLING            = 0x100,
+        PATH_KEY_ON_TRANSPORT       = 0x200
+    };
+
+    int32 QuantizeCoord(float coord, float coalesceDistance)
+    {
+        // coalescing disabled, only exactly same positions share path
+        if (coalesceDistance <= 0.0f)
+            return std::bit_cast<int32>(coord);
+
+        return int32(std::floor(coord / coalesceDistance));
+    }
+}
+
+PathRequestQueue::~PathRequestQueue()
+{
+    // Series are tagged by instance id
+    sMetric->ReleaseSeries(_requestsMetricSeries);
+    sMetric->ReleaseSeries(_coalescedMetricSeries);
+    sMetric->ReleaseSeries(_latencyMetricSeries);
+    sMetric->ReleaseSeries(_updateTimeMetricSeries);
+}
+
+bool PathRequestQueue::IsEnabled()
+{
+    return CONF_GET_BOOL("MoveMaps.AsyncPathfinding.Enable");
+}
+
+PathRequestPtr PathRequestQueue::Submit(std::unique_ptr<PathGenerator> path, float destX, float destY, float destZ, bool forceDest)
+{
+    ASSERT(path);
+
+    G3D::Vector3 start;
+    path->_source->GetPosition(start.x, start.y, start.z);
+
+    PathRequestPtr request = std::make_shared<PathRequest>(std::move(path), start, G3D::Vector3(destX, destY, destZ), forceDest);
+    _requests.emplace_back(request);
+    return request;
+}
+
+std::size_t PathRequestQueue::PathKeyHash::operator()(PathKey const& key) const
+{
+    std::size_t hash = 0;
+
+    for (int32 value : key)
+        hash = hash * 31 + std::hash<int32>()(value);
+
+    return hash;
+}
+
+PathRequestQueue::PathKey PathRequestQueue::BuildKey(PathRequest const& request, float coalesceDistance)
+{
+    PathGenerator const* path = request._path.get();
+    WorldObject const* source = path->_source;
+
+    int32 options = 0;
+
+    if (request._forceDest)
+        options |= PATH_KEY_FORCE_DESTINATION;
+
+    if (path->_useStraightPath)
+        options |= PATH_KEY_STRAIGHT_PATH;
+
+    if (path->_slopeCheck)
+        options |= PATH_KEY_SLOPE_CHECK;
+
+    if (path->_useRaycast)
+        options |= PATH_KEY_RAYCAST;
+
+    if (source->GetTransport())
+        options |= PATH_KEY_ON_TRANSPORT;
+
+    if (Unit const* unit = source->ToUnit())
+    {
+        options |= PATH_KEY_UNIT;
+
+        if (unit->ToCreature())
+            options |= PATH_KEY_CREATURE;
+
+        if (unit->CanFly())
+            options |= PATH_KEY_CAN_FLY;
+
+        if (unit->CanSwim())
+            options |= PATH_KEY_CAN_SWIM;
+
+        if (unit->IsFalling())
+            options |= PATH_KEY_FALLING;
+    }
+
+    return
+    {
+        QuantizeCoord(request._start.x, coalesceDistance),
+        QuantizeCoord(request._start.y, coalesceDistance),
+        QuantizeCoord(request._start.z, coalesceDistance),
+        QuantizeCoord(request._dest.x, coalesceDistance),
+        QuantizeCoord(request._dest.y, coalesceDistance),
+        QuantizeCoord(request._dest.z, coalesceDistance),
+        int32(path->_filter.getIncludeFlags()) | (int32(path->_filter.getExcludeFlags()) << 16),
+        options,
+        int32(path->_pointPathLimit),
+        int32(source->GetPhaseMask()),
+        int32(std::lround(source->GetCollisionHeight() * 10.0f)),
+        int32(source->GetTypeId())
+    };
+}
+
+void PathRequestQueue::Update(Map* map)
+{
+    if (_requests.empty())
+        return;
+
+    METRIC_SERIES_TIMER(_updateTimeMetricSeries, "map_path_requests_update_time",
+        METRIC_TAG("map_id", std::to_string(map->GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(map->GetInstanceId())));
+
+    float coalesceDistance = CONF_GET_FLOAT("MoveMaps.AsyncPathfinding.CoalesceDistance");
+    [[maybe_unused]] std::size_t requestsCount = _requests.size();
+
+    // Serial phase: cheap checks and shortcut paths, group requests needing navmesh path
+    for (PathRequestPtr& request : _requests)
+    {
+        // generator dropped the request, its owner may not exist anymore
+        if (request.use_count() == 1)
+            continue;
+
+        PathGenerator* path = request->_path.get();
+
+        if (!path->_source->IsInWorld() || path->_source->FindMap() != map)
+        {
+            request->_cancelled = true;
+            request->_ready = true;
+            continue;
+        }
+
+        request->_success = path->PreparePath(request->_start.x, request->_start.y, request->_start.z,
+            request->_dest.x, request->_dest.y, request->_dest.z, request->_forceDest);
+
+        if (!request->_success || path->GetPathType() != PATHFIND_BLANK)
+        {
+            request->_ready = true;
+            continue;
+        }
+
+        auto [itr, inserted] = _leaderIndexes.try_emplace(BuildKey(*request, coalesceDistance), uint32(_leaders.size()));
+        if (inserted)
+            _leaders.emplace_back(request.get());
+        else
+            _followers.emplace_back(request.get(), itr->second);
+    }
+
+    // Parallel phase: objects of the map are not changed now, only read by path building
+    uint32 mapId = map->GetId();
+
+    sMapMgr->GetMapUpdater()->ExecuteParallel(_leaders.size(), [this, mapId](uint32 index)
+    {
+        _leaders[index]->_path->BuildPreparedPath(MMAP::MMapFactory::createOrGetMMapMgr()->GetThreadNavMeshQuery(mapId));
+    });
+
+    for (PathRequest* leader : _leaders)
+        leader->_ready = true;
+
+    for (auto const& [follower, leaderIndex] : _followers)
+    {
+        follower->_path->CopyPreparedPath(*_leaders[leaderIndex]->_path);
+        follower->_ready = true;
+    }
+
+    [[maybe_unused]] TimePoint now = std::chrono::steady_clock::now();
+    [[maybe_unused]] TimePoint oldestSubmitTime = now;
+
+    for (PathRequestPtr const& request : _requests)
+        oldestSubmitTime = std::min(oldestSubmitTime, request->_submitTime);
+
+    METRIC_SERIES_VALUE(_requestsMetricSeries, "map_path_requests", uint64(requestsCount),
+        METRIC_TAG("map_id", std::to_string(map->GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(map->GetInstanceId())));
+
+    METRIC_SERIES_VALUE(_coalescedMetricSeries, "map_path_requests_coalesced", uint64(_followers.size()),
+        METRIC_TAG("map_id", std::to_string(map->GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(map->GetInstanceId())));
+
+    METRIC_SERIES_VALUE(_latencyMetricSeries, "map_path_requests_max_latency", std::chrono::duration_cast<std::chrono::nanoseconds>(now - oldestSubmitTime),
+        METRIC_TAG("map_id", std::to_string(map->GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(map->GetInstanceId())));
+
+    _requests.clear();
+    _leaderIndexes.clear();
+    _leaders.clear();
+    _followers.clear();
+}
@@ -0,0 +1,106 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PATH_REQUEST_QUEUE_H
+#define _PATH_REQUEST_QUEUE_H
+
+#include "Duration.h"
+#include "Metric.h"
+#include "PathGenerator.h"
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class Map;
+
+// Path calculation submitted by a motion generator, done by the map on its next update
+class WH_GAME_API PathRequest
+{
+public:
+    PathRequest(std::unique_ptr<PathGenerator> path, G3D::Vector3 const& start, G3D::Vector3 const& dest, bool forceDest) :
+        _path(std::move(path)), _start(start), _dest(dest), _forceDest(forceDest), _submitTime(std::chrono::steady_clock::now()) { }
+
+    [[nodiscard]] bool IsReady() const { return _ready; }
+
+    // return value of PathGenerator::CalculatePath, valid when ready
+    [[nodiscard]] bool IsSuccess() const { return _success; }
+
+    // path owner left the map before calculation, result must be ignored
+    [[nodiscard]] bool IsCancelled() const { return _cancelled; }
+
+    // give path back to the generator, it's owned by the request until ready
+    std::unique_ptr<PathGenerator> TakePath() { return std::move(_path); }
+
+private:
+    friend class PathRequestQueue;
+
+    std::unique_ptr<PathGenerator> _path;
+    G3D::Vector3 _start;
+    G3D::Vector3 _dest;
+    bool _forceDest;
+    bool _ready{};
+    bool _success{};
+    bool _cancelled{};
+    TimePoint _submitTime;
+};
+
+typedef std::shared_ptr<PathRequest> PathRequestPtr;
+
+// Path requests of a map, see MoveMaps.AsyncPathfinding in worldserver.conf
+// Requests are calculated in parallel by map update threads, each one with own dtNavMeshQuery.
+// Requests with near identical start, destination and path options are calculated only once.
+// Dropping the returned PathRequestPtr cancels the request.
+class WH_GAME_API PathRequestQueue
+{
+public:
+    ~PathRequestQueue();
+
+    [[nodiscard]] static bool IsEnabled();
+
+    // path starts at current position of path owner
+    PathRequestPtr Submit(std::unique_ptr<PathGenerator> path, float destX, float destY, float destZ, bool forceDest);
+
+    // calculate all submitted requests, called by map update after objects are updated
+    void Update(Map* map);
+
+    [[nodiscard]] std::size_t GetSize() const { return _requests.size(); }
+
+private:
+    typedef std::array<int32, 12> PathKey;
+
+    struct PathKeyHash
+    {
+        std::size_t operator()(PathKey const& key) const;
+    };
+
+    [[nodiscard]] static PathKey BuildKey(PathRequest const& request, float coalesceDistance);
+
+    std::vector<PathRequestPtr> _requests;
+
+    // reused between updates
+    std::unordered_map<PathKey, uint32, PathKeyHash> _leaderIndexes;
+    std::vector<PathRequest*> _leaders;
+    std::vector<std::pair<PathRequest*, uint32>> _followers;
+
+    MetricSeriesId _requestsMetricSeries{};
+    MetricSeriesId _coalescedMetricSeries{};
+    MetricSeriesId _latencyMetricSeries{};
+    MetricSeriesId _updateTimeMetricSeries{};
+};
+
+#endif
@@ -27,14 +27,87 @@
 #include "ObjectAccessor.h"
 #include "Spell.h"
 #include "Util.h"
+#include <algorithm>
 
 template<class T>
 RandomMovementGenerator<T>::~RandomMovementGenerator() { }
 
 template<>
-RandomMovementGenerator<Creature>::~RandomMovementGenerator()
+RandomMovementGenerator<Creature>::~RandomMovementGenerator() { }
+
+template<>
+bool RandomMovementGenerator<Creature>::_checkPath(Creature* creature, bool success, G3D::Vector3 const& destination, Movement::PointsArray& finalPath)
+{
+    if (!success || (_pathGenerator->GetPathType() & PATHFIND_NOPATH))
+        return false;
+
+    // generated path is too long
+    float pathLen = _pathGenerator->getPathLength();
+    if (pathLen * pathLen > creature->GetExactDistSq(destination.x, destination.y, destination.z) * MAX_PATH_LENGHT_FACTOR * MAX_PATH_LENGHT_FACTOR)
+        return false;
+
+    finalPath = _pathGenerator->GetPath();
+    Movement::PointsArray::iterator itr = finalPath.begin();
+    Movement::PointsArray::iterator itrNext = finalPath.begin() + 1;
+    float zDiff, distDiff;
+
+    for (; itrNext != finalPath.end(); ++itr, ++itrNext)
+    {
+        distDiff = std::sqrt(((*itr).x - (*itrNext).x) * ((*itr).x - (*itrNext).x) + ((*itr).y - (*itrNext).y) * ((*itr).y - (*itrNext).y));
+        zDiff = std::fabs((*itr).z - (*itrNext).z);
+
+        // Xinef: tree climbing, cut as much as we can
+        if (zDiff > 2.0f ||
+                (G3D::fuzzyNe(zDiff, 0.0f) && distDiff / zDiff < 2.15f)) // ~25˚
+            return false;
+
+        if (!creature->GetMap()->isInLineOfSight((*itr).x, (*itr).y, (*itr).z + 2.f, (*itrNext).x, (*itrNext).y, (*itrNext).z + 2.f, creature->GetPhaseMask(),
+            LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::Nothing))
+            return false;
+    }
+
+    // no valid path
+    return finalPath.size() >= 2;
+}
+
+template<>
+void RandomMovementGenerator<Creature>::_moveToPoint(Creature* creature, uint8 newPoint, Movement::PointsArray const& finalPath, uint16 pathIdx)
 {
-    delete _pathGenerator;
+    _currentPoint = newPoint;
+    G3D::Vector3 finalPoint = finalPath[finalPath.size() - 1];
+    _currDestPosition.Relocate(finalPoint.x, finalPoint.y, finalPoint.z);
+
+    creature->AddUnitState(UNIT_STATE_ROAMING_MOVE);
+    bool walk = true;
+    switch (creature->GetMovementTemplate().GetRandom())
+    {
+    case CreatureRandomMovementType::CanRun:
+        walk = creature->IsWalking();
+        break;
+    case CreatureRandomMovementType::AlwaysRun:
+        walk = false;
+        break;
+    default:
+        break;
+    }
+
+    Movement::MoveSplineInit init(creature);
+    init.MovebyPath(finalPath);
+    init.SetWalk(walk);
+    init.Launch();
+
+    ++_moveCount;
+    if (roll_chance_i((int32) _moveCount * 25 + 10))
+    {
+        _moveCount = 0;
+        _nextMoveTime.Reset(urand(4000, 8000));
+    }
+    if (CONF_GET_BOOL("DontCacheRandomMovementPaths"))
+        _preComputedPaths.erase(pathIdx);
+
+    //Call for creature group update
+    if (creature->GetFormation() && creature->GetFormation()->GetLeader() == creature)
+        creature->GetFormation()->LeaderMoveTo(finalPoint.x, finalPoint.y, finalPoint.z, false);
 }
 
 template<>
@@ -137,59 +210,20 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
         else // ground
         {
             if (!_pathGenerator)
-                _pathGenerator = new PathGenerator(creature);
+                _pathGenerator = std::make_unique<PathGenerator>(creature);
             else
                 _pathGenerator->Clear();
 
-            bool result = _pathGenerator->CalculatePath(x, y, levelZ, false);
-            if (result && !(_pathGenerator->GetPathType() & PATHFIND_NOPATH))
+            if (PathRequestQueue::IsEnabled())
             {
-                // generated path is too long
-                float pathLen = _pathGenerator->getPathLength();
-                if (pathLen * pathLen > creature->GetExactDistSq(x, y, levelZ) * MAX_PATH_LENGHT_FACTOR * MAX_PATH_LENGHT_FACTOR)
-                {
-                    _validPointsVector[_currentPoint].erase(randomIter);
-                    _preComputedPaths.erase(pathIdx);
-                    return;
-                }
-
-                finalPath = _pathGenerator->GetPath();
-                Movement::PointsArray::iterator itr = finalPath.begin();
-                Movement::PointsArray::iterator itrNext = finalPath.begin() + 1;
-                float zDiff, distDiff;
-
-                for (; itrNext != finalPath.end(); ++itr, ++itrNext)
-                {
-                    distDiff = std::sqrt(((*itr).x - (*itrNext).x) * ((*itr).x - (*itrNext).x) + ((*itr).y - (*itrNext).y) * ((*itr).y - (*itrNext).y));
-                    zDiff = std::fabs((*itr).z - (*itrNext).z);
-
-                    // Xinef: tree climbing, cut as much as we can
-                    if (zDiff > 2.0f ||
-                            (G3D::fuzzyNe(zDiff, 0.0f) && distDiff / zDiff < 2.15f)) // ~25˚
-                    {
-                        _validPointsVector[_currentPoint].erase(randomIter);
-                        _preComputedPaths.erase(pathIdx);
-                        return;
-                    }
-
-                    if (!map->isInLineOfSight((*itr).x, (*itr).y, (*itr).z + 2.f, (*itrNext).x, (*itrNext).y, (*itrNext).z + 2.f, creature->GetPhaseMask(),
-                        LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::Nothing))
-                    {
-                        _validPointsVector[_currentPoint].erase(randomIter);
-                        _preComputedPaths.erase(pathIdx);
-                        return;
-                    }
-                }
-
-                // no valid path
-                if (finalPath.size() < 2)
-                {
-                    _validPointsVector[_currentPoint].erase(randomIter);
-                    _preComputedPaths.erase(pathIdx);
-                    return;
-                }
+                _pathRequestPoint = newPoint;
+                _pathRequest = map->RequestPath(std::move(_pathGenerator), x, y, levelZ, false);
+                _preComputedPaths.erase(pathIdx);
+                return;
             }
-            else
+
+            bool result = _pathGenerator->CalculatePath(x, y, levelZ, false);
+            if (!_checkPath(creature, result, G3D::Vector3(x, y, levelZ), finalPath))
             {
                 _validPointsVector[_currentPoint].erase(randomIter);
                 _preComputedPaths.erase(pathIdx);
@@ -198,41 +232,40 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
         }
     }
 
-    _currentPoint = newPoint;
-    G3D::Vector3& finalPoint = finalPath[finalPath.size() - 1];
-    _currDestPosition.Relocate(finalPoint.x, finalPoint.y, finalPoint.z);
+    _moveToPoint(creature, newPoint, finalPath, pathIdx);
+}
 
-    creature->AddUnitState(UNIT_STATE_ROAMING_MOVE);
-    bool walk = true;
-    switch (creature->GetMovementTemplate().GetRandom())
-    {
-    case CreatureRandomMovementType::CanRun:
-        walk = creature->IsWalking();
-        break;
-    case CreatureRandomMovementType::AlwaysRun:
-        walk = false;
-        break;
-    default:
-        break;
-    }
+template<>
+void RandomMovementGenerator<Creature>::_onPathCalculated(Creature* creature)
+{
+    // Called only by DoUpdate with the request this generator holds, the request is dropped
+    // whenever the generator is initialized, reset, finalized or movement is prevented
+    PathRequestPtr request = std::move(_pathRequest);
+    _pathGenerator = request->TakePath();
 
-    Movement::MoveSplineInit init(creature);
-    init.MovebyPath(finalPath);
-    init.SetWalk(walk);
-    init.Launch();
+    if (request->IsCancelled())
+        return;
 
-    ++_moveCount;
-    if (roll_chance_i((int32) _moveCount * 25 + 10))
+    // started to move some other way meanwhile, pick new point later
+    if (!creature->movespline->Finalized())
+        return;
+
+    uint8 newPoint = _pathRequestPoint;
+    uint16 pathIdx = uint16(_currentPoint * RANDOM_POINTS_NUMBER + newPoint);
+
+    std::vector<uint8>::iterator pointIter = std::find(_validPointsVector[_currentPoint].begin(), _validPointsVector[_currentPoint].end(), newPoint);
+    if (pointIter == _validPointsVector[_currentPoint].end())
+        return;
+
+    Movement::PointsArray& finalPath = _preComputedPaths[pathIdx];
+    if (!_checkPath(creature, request->IsSuccess(), _pathGenerator->GetEndPosition(), finalPath))
     {
-        _moveCount = 0;
-        _nextMoveTime.Reset(urand(4000, 8000));
-    }
-    if (CONF_GET_BOOL("DontCacheRandomMovementPaths"))
+        _validPointsVector[_currentPoint].erase(pointIter);
         _preComputedPaths.erase(pathIdx);
+        return;
+    }
 
-    //Call for creature group update
-    if (creature->GetFormation() && creature->GetFormation()->GetLeader() == creature)
-        creature->GetFormation()->LeaderMoveTo(finalPoint.x, finalPoint.y, finalPoint.z, false);
+    _moveToPoint(creature, newPoint, finalPath, pathIdx);
 }
 
 template<>
@@ -241,6 +274,8 @@ void RandomMovementGenerator<Creature>::DoInitialize(Creature* creature)
     if (!creature->IsAlive())
         return;
 
+    _pathRequest = nullptr;
+
     if (!_wanderDistance)
         _wanderDistance = creature->GetWanderDistance();
 
@@ -271,6 +306,7 @@ void RandomMovementGenerator<Creature>::DoReset(Creature* creature)
 template<>
 void RandomMovementGenerator<Creature>::DoFinalize(Creature* creature)
 {
+    _pathRequest = nullptr;
     creature->ClearUnitState(UNIT_STATE_ROAMING | UNIT_STATE_ROAMING_MOVE);
     creature->SetWalk(false);
 }
@@ -281,6 +317,7 @@ bool RandomMovementGenerator<Creature>::DoUpdate(Creature* creature, const uint3
     if (creature->HasUnitState(UNIT_STATE_NOT_MOVE) || creature->IsMovementPreventedByCasting())
     {
         _nextMoveTime.Reset(0);  // Expire the timer
+        _pathRequest = nullptr;
         creature->StopMoving();
         return true;
     }
@@ -289,10 +326,20 @@ bool RandomMovementGenerator<Creature>::DoUpdate(Creature* creature, const uint3
     if (creature->HasUnitFlag(UNIT_FLAG_DISABLE_MOVE))
     {
         _nextMoveTime.Reset(0);  // Expire the timer
+        _pathRequest = nullptr;
         creature->ClearUnitState(UNIT_STATE_ROAMING_MOVE);
         return true;
     }
 
+    // path requested on previous update, move once it's calculated
+    if (_pathRequest)
+    {
+        if (_pathRequest->IsReady())
+            _onPathCalculated(creature);
+
+        return true;
+    }
+
     if (creature->movespline->Finalized())
     {
         _nextMoveTime.Update(diff);
@@ -20,6 +20,7 @@
 
 #include "MovementGenerator.h"
 #include "PathGenerator.h"
+#include "PathRequestQueue.h"
 
 #define RANDOM_POINTS_NUMBER        12
 #define RANDOM_LINKS_COUNT          7
@@ -31,7 +32,7 @@ template<class T>
 class RandomMovementGenerator : public MovementGeneratorMedium< T, RandomMovementGenerator<T> >
 {
 public:
-    RandomMovementGenerator(float wanderDistance = 0.0f) : _nextMoveTime(0), _moveCount(0), _wanderDistance(wanderDistance), _pathGenerator(nullptr), _currentPoint(RANDOM_POINTS_NUMBER)
+    RandomMovementGenerator(float wanderDistance = 0.0f) : _nextMoveTime(0), _moveCount(0), _wanderDistance(wanderDistance), _pathGenerator(nullptr), _pathRequestPoint(0), _currentPoint(RANDOM_POINTS_NUMBER)
     {
         _initialPosition.Relocate(0.0f, 0.0f, 0.0f, 0.0f);
         _destinationPoints.reserve(RANDOM_POINTS_NUMBER);
@@ -58,10 +59,16 @@ public:
     MovementGeneratorType GetMovementGeneratorType() { return RANDOM_MOTION_TYPE; }
 
 private:
+    bool _checkPath(T*, bool success, G3D::Vector3 const& destination, Movement::PointsArray& finalPath);
+    void _onPathCalculated(T*);
+    void _moveToPoint(T*, uint8 newPoint, Movement::PointsArray const& finalPath, uint16 pathIdx);
+
     TimeTrackerSmall _nextMoveTime;
     uint8 _moveCount;
     float _wanderDistance;
-    PathGenerator* _pathGenerator;
+    std::unique_ptr<PathGenerator> _pathGenerator;
+    PathRequestPtr _pathRequest; // _pathGenerator is owned by the request until it's ready
+    uint8 _pathRequestPoint;
     std::vector<G3D::Vector3> _destinationPoints;
     std::vector<uint8> _validPointsVector[RANDOM_POINTS_NUMBER + 1];
     uint8 _currentPoint;
@@ -22,6 +22,7 @@
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "MoveSplineInit.h"
+#include "PathRequestQueue.h"
 #include "Pet.h"
 #include "Player.h"
 #include "Spell.h"
@@ -62,6 +63,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     // the owner might be unable to move (rooted or casting), or we have lost the target, pause movement
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || HasLostTarget(owner) || (cOwner && cOwner->IsMovementPreventedByCasting()))
     {
+        i_pathRequest = nullptr;
         owner->StopMoving();
         _lastTargetPosition.reset();
         if (Creature* cOwner2 = owner->ToCreature())
@@ -87,6 +89,23 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     float const maxTarget = _range ? _range->MaxTolerance + hitboxSum : CONTACT_DISTANCE + hitboxSum;
     Optional<ChaseAngle> angle = mutualChase ? Optional<ChaseAngle>() : _angle;
 
+    // path requested on previous update, move once it's calculated
+    if (i_pathRequest)
+    {
+        if (!i_pathRequest->IsReady())
+            return true;
+
+        PathRequestPtr request = std::move(i_pathRequest);
+        i_path = request->TakePath();
+
+        // owner left the map, result doesn't tell if target is reachable
+        if (request->IsCancelled())
+            return true;
+
+        LaunchPath(owner, target, request->IsSuccess(), i_shortenPath, maxTarget);
+        return true;
+    }
+
     i_recheckDistance.Update(time_diff);
     if (i_recheckDistance.Passed())
     {
@@ -197,7 +216,23 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
 
     i_recalculateTravel = true;
 
+    if (PathRequestQueue::IsEnabled())
+    {
+        i_shortenPath = shortenPath;
+        i_pathRequest = owner->GetMap()->RequestPath(std::move(i_path), x, y, z, forceDest);
+        return true;
+    }
+
     bool success = i_path->CalculatePath(x, y, z, forceDest);
+    LaunchPath(owner, target, success, shortenPath, maxTarget);
+    return true;
+}
+
+template<class T>
+void ChaseMovementGenerator<T>::LaunchPath(T* owner, Unit* target, bool success, bool shortenPath, float maxTarget)
+{
+    Creature* cOwner = owner->ToCreature();
+
     if (!success || i_path->GetPathType() & PATHFIND_NOPATH)
     {
         if (cOwner)
@@ -205,7 +240,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
             cOwner->SetCannotReachTarget(target->GetGUID());
         }
 
-        return true;
+        return;
     }
 
     if (shortenPath)
@@ -240,8 +275,6 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     init.SetFacing(target);
     init.SetWalk(walk);
     init.Launch();
-
-    return true;
 }
 
 //-----------------------------------------------//
@@ -249,6 +282,7 @@ template<>
 void ChaseMovementGenerator<Player>::DoInitialize(Player* owner)
 {
     i_path = nullptr;
+    i_pathRequest = nullptr;
     _lastTargetPosition.reset();
     owner->StopMoving();
     owner->AddUnitState(UNIT_STATE_CHASE);
@@ -258,6 +292,7 @@ template<>
 void ChaseMovementGenerator<Creature>::DoInitialize(Creature* owner)
 {
     i_path = nullptr;
+    i_pathRequest = nullptr;
     _lastTargetPosition.reset();
     owner->SetWalk(false);
     owner->StopMoving();
@@ -267,6 +302,7 @@ void ChaseMovementGenerator<Creature>::DoInitialize(Creature* owner)
 template<class T>
 void ChaseMovementGenerator<T>::DoFinalize(T* owner)
 {
+    i_pathRequest = nullptr;
     owner->ClearUnitState(UNIT_STATE_CHASE | UNIT_STATE_CHASE_MOVE);
     if (Creature* cOwner = owner->ToCreature())
     {
@@ -415,6 +451,7 @@ bool FollowMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || (cOwner && owner->ToCreature()->IsMovementPreventedByCasting()))
     {
         i_path = nullptr;
+        i_pathRequest = nullptr;
         owner->StopMoving();
         _lastTargetPosition.reset();
         return true;
@@ -433,6 +470,22 @@ bool FollowMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
         (i_target->GetTypeId() == TYPEID_PLAYER && i_target->ToPlayer()->IsGameMaster()) // for .npc follow
         ; // closes "bool forceDest", that way it is more appropriate, so we can comment out crap whenever we need to
 
+    // path requested on previous update, move once it's calculated
+    if (i_pathRequest)
+    {
+        if (!i_pathRequest->IsReady())
+            return true;
+
+        PathRequestPtr request = std::move(i_pathRequest);
+        i_path = request->TakePath();
+
+        if (request->IsCancelled())
+            return true;
+
+        LaunchPath(owner, target, request->IsSuccess(), followingMaster);
+        return true;
+    }
+
     bool targetIsMoving = false;
     if (PositionOkay(target, owner->IsGuardian() && target->GetTypeId() == TYPEID_PLAYER, targetIsMoving, time_diff))
     {
@@ -485,32 +538,45 @@ bool FollowMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
         if (owner->IsHovering())
             owner->UpdateAllowedPositionZ(x, y, z);
 
-        bool success = i_path->CalculatePath(x, y, z, forceDest);
-        if (!success || (i_path->GetPathType() & PATHFIND_NOPATH && !followingMaster))
+        if (PathRequestQueue::IsEnabled())
         {
-            if (!owner->IsStopped())
-                owner->StopMoving();
-
+            i_pathRequest = owner->GetMap()->RequestPath(std::move(i_path), x, y, z, forceDest);
             return true;
         }
 
-        owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
-
-        Movement::MoveSplineInit init(owner);
-        init.MovebyPath(i_path->GetPath());
-        init.SetWalk(target->IsWalking() || target->movespline->isWalking());
-        if (Optional<float> velocity = GetVelocity(owner, target, i_path->GetActualEndPosition(), owner->IsGuardian()))
-            init.SetVelocity(*velocity);
-        init.Launch();
+        bool success = i_path->CalculatePath(x, y, z, forceDest);
+        LaunchPath(owner, target, success, followingMaster);
     }
 
     return true;
 }
 
+template<class T>
+void FollowMovementGenerator<T>::LaunchPath(T* owner, Unit* target, bool success, bool followingMaster)
+{
+    if (!success || (i_path->GetPathType() & PATHFIND_NOPATH && !followingMaster))
+    {
+        if (!owner->IsStopped())
+            owner->StopMoving();
+
+        return;
+    }
+
+    owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
+
+    Movement::MoveSplineInit init(owner);
+    init.MovebyPath(i_path->GetPath());
+    init.SetWalk(target->IsWalking() || target->movespline->isWalking());
+    if (Optional<float> velocity = GetVelocity(owner, target, i_path->GetActualEndPosition(), owner->IsGuardian()))
+        init.SetVelocity(*velocity);
+    init.Launch();
+}
+
 template<class T>
 void FollowMovementGenerator<T>::DoInitialize(T* owner)
 {
     i_path = nullptr;
+    i_pathRequest = nullptr;
     _lastTargetPosition.reset();
     owner->AddUnitState(UNIT_STATE_FOLLOW);
 }
@@ -518,6 +584,7 @@ void FollowMovementGenerator<T>::DoInitialize(T* owner)
 template<class T>
 void FollowMovementGenerator<T>::DoFinalize(T* owner)
 {
+    i_pathRequest = nullptr;
     owner->ClearUnitState(UNIT_STATE_FOLLOW | UNIT_STATE_FOLLOW_MOVE);
 }
 
@@ -22,6 +22,7 @@
 #include "MovementGenerator.h"
 #include "Optional.h"
 #include "PathGenerator.h"
+#include "PathRequestQueue.h"
 #include "Timer.h"
 #include "Unit.h"
 
@@ -59,9 +60,13 @@ public:
     bool HasLostTarget(Unit* unit) const { return unit->GetVictim() != this->GetTarget(); }
 
 private:
+    void LaunchPath(T* owner, Unit* target, bool success, bool shortenPath, float maxTarget);
+
     std::unique_ptr<PathGenerator> i_path;
+    PathRequestPtr i_pathRequest; // i_path is owned by the request until it's ready
     TimeTrackerSmall i_recheckDistance;
     bool i_recalculateTravel;
+    bool i_shortenPath = false;
 
     Optional<Position> _lastTargetPosition;
     Optional<ChaseRange> const _range;
@@ -98,7 +103,10 @@ public:
     float GetFollowRange() const { return _range; }
 
 private:
+    void LaunchPath(T* owner, Unit* target, bool success, bool followingMaster);
+
     std::unique_ptr<PathGenerator> i_path;
+    PathRequestPtr i_pathRequest; // i_path is owned by the request until it's ready
     TimeTrackerSmall i_recheckPredictedDistanceTimer;
     bool i_recheckPredictedDistance;
 
@@ -24,11 +24,15 @@
 
 uint32 ScriptMgr::DealDamage(Unit* AttackerUnit, Unit* pVictim, uint32 damage, DamageEffectType damagetype)
 {
-    if (ScriptRegistry<UnitScript>::Instance()->GetScripts().empty())
+    auto const& hooks = ScriptRegistry<UnitScript>::Instance()->GetHooks();
+    if (!hooks.HasSubscribers(UNITHOOK_DEAL_DAMAGE))
         return damage;
 
-    for (auto const& [scriptID, script] : ScriptRegistry<UnitScript>::Instance()->GetScripts())
+    for (UnitScript* script : hooks.GetSubscribers(UNITHOOK_DEAL_DAMAGE))
     {
+        if (script->IsHookUnused(UNITHOOK_DEAL_DAMAGE))
+            continue;
+
         auto const& dmg = script->DealDamage(AttackerUnit, pVictim, damage, damagetype);
         if (dmg != damage)
             return damage;
@@ -39,7 +43,7 @@ uint32 ScriptMgr::DealDamage(Unit* AttackerUnit, Unit* pVictim, uint32 damage, D
 
 void ScriptMgr::OnHeal(Unit* healer, Unit* reciever, uint32& gain)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_ON_HEAL, [&](UnitScript* script)
     {
         script->OnHeal(healer, reciever, gain);
     });
@@ -47,7 +51,7 @@ void ScriptMgr::OnHeal(Unit* healer, Unit* reciever, uint32& gain)
 
 void ScriptMgr::OnDamage(Unit* attacker, Unit* victim, uint32& damage)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_ON_DAMAGE, [&](UnitScript* script)
     {
         script->OnDamage(attacker, victim, damage);
     });
@@ -55,7 +59,7 @@ void ScriptMgr::OnDamage(Unit* attacker, Unit* victim, uint32& damage)
 
 void ScriptMgr::ModifyPeriodicDamageAurasTick(Unit* target, Unit* attacker, uint32& damage, SpellInfo const* spellInfo)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_MODIFY_PERIODIC_DAMAGE_AURAS_TICK, [&](UnitScript* script)
     {
         script->ModifyPeriodicDamageAurasTick(target, attacker, damage, spellInfo);
     });
@@ -63,7 +67,7 @@ void ScriptMgr::ModifyPeriodicDamageAurasTick(Unit* target, Unit* attacker, uint
 
 void ScriptMgr::ModifyMeleeDamage(Unit* target, Unit* attacker, uint32& damage)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_MODIFY_MELEE_DAMAGE, [&](UnitScript* script)
     {
         script->ModifyMeleeDamage(target, attacker, damage);
     });
@@ -71,7 +75,7 @@ void ScriptMgr::ModifyMeleeDamage(Unit* target, Unit* attacker, uint32& damage)
 
 void ScriptMgr::ModifySpellDamageTaken(Unit* target, Unit* attacker, int32& damage, SpellInfo const* spellInfo)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_MODIFY_SPELL_DAMAGE_TAKEN, [&](UnitScript* script)
     {
         script->ModifySpellDamageTaken(target, attacker, damage, spellInfo);
     });
@@ -79,7 +83,7 @@ void ScriptMgr::ModifySpellDamageTaken(Unit* target, Unit* attacker, int32& dama
 
 void ScriptMgr::ModifyHealReceived(Unit* target, Unit* healer, uint32& heal, SpellInfo const* spellInfo)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_MODIFY_HEAL_RECEIVED, [&](UnitScript* script)
     {
         script->ModifyHealReceived(target, healer, heal, spellInfo);
     });
@@ -87,7 +91,7 @@ void ScriptMgr::ModifyHealReceived(Unit* target, Unit* healer, uint32& heal, Spe
 
 void ScriptMgr::OnBeforeRollMeleeOutcomeAgainst(Unit const* attacker, Unit const* victim, WeaponAttackType attType, int32& attackerMaxSkillValueForLevel, int32& victimMaxSkillValueForLevel, int32& attackerWeaponSkill, int32& victimDefenseSkill, int32& crit_chance, int32& miss_chance, int32& dodge_chance, int32& parry_chance, int32& block_chance)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_ON_BEFORE_ROLL_MELEE_OUTCOME_AGAINST, [&](UnitScript* script)
     {
         script->OnBeforeRollMeleeOutcomeAgainst(attacker, victim, attType, attackerMaxSkillValueForLevel, victimMaxSkillValueForLevel, attackerWeaponSkill, victimDefenseSkill, crit_chance, miss_chance, dodge_chance, parry_chance, block_chance);
     });
@@ -95,7 +99,7 @@ void ScriptMgr::OnBeforeRollMeleeOutcomeAgainst(Unit const* attacker, Unit const
 
 void ScriptMgr::OnAuraRemove(Unit* unit, AuraApplication* aurApp, AuraRemoveMode mode)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_ON_AURA_REMOVE, [&](UnitScript* script)
     {
         script->OnAuraRemove(unit, aurApp, mode);
     });
@@ -103,7 +107,7 @@ void ScriptMgr::OnAuraRemove(Unit* unit, AuraApplication* aurApp, AuraRemoveMode
 
 bool ScriptMgr::IfNormalReaction(Unit const* unit, Unit const* target, ReputationRank& repRank)
 {
-    auto ret = IsValidBoolScript<UnitScript>([&](UnitScript* script)
+    auto ret = IsValidBoolScript<UnitScript>(UNITHOOK_IF_NORMAL_REACTION, [&](UnitScript* script)
     {
         return !script->IfNormalReaction(unit, target, repRank);
     });
@@ -113,7 +117,7 @@ bool ScriptMgr::IfNormalReaction(Unit const* unit, Unit const* target, Reputatio
 
 bool ScriptMgr::IsNeedModSpellDamagePercent(Unit const* unit, AuraEffect* auraEff, float& doneTotalMod, SpellInfo const* spellProto)
 {
-    auto ret = IsValidBoolScript<UnitScript>([&](UnitScript* script)
+    auto ret = IsValidBoolScript<UnitScript>(UNITHOOK_IS_NEED_MOD_SPELL_DAMAGE_PERCENT, [&](UnitScript* script)
     {
         return !script->IsNeedModSpellDamagePercent(unit, auraEff, doneTotalMod, spellProto);
     });
@@ -123,7 +127,7 @@ bool ScriptMgr::IsNeedModSpellDamagePercent(Unit const* unit, AuraEffect* auraEf
 
 bool ScriptMgr::IsNeedModMeleeDamagePercent(Unit const* unit, AuraEffect* auraEff, float& doneTotalMod, SpellInfo const* spellProto)
 {
-    auto ret = IsValidBoolScript<UnitScript>([&](UnitScript* script)
+    auto ret = IsValidBoolScript<UnitScript>(UNITHOOK_IS_NEED_MOD_MELEE_DAMAGE_PERCENT, [&](UnitScript* script)
     {
         return !script->IsNeedModMeleeDamagePercent(unit, auraEff, doneTotalMod, spellProto);
     });
@@ -133,7 +137,7 @@ bool ScriptMgr::IsNeedModMeleeDamagePercent(Unit const* unit, AuraEffect* auraEf
 
 bool ScriptMgr::IsNeedModHealPercent(Unit const* unit, AuraEffect* auraEff, float& doneTotalMod, SpellInfo const* spellProto)
 {
-    auto ret = IsValidBoolScript<UnitScript>([&](UnitScript* script)
+    auto ret = IsValidBoolScript<UnitScript>(UNITHOOK_IS_NEED_MOD_HEAL_PERCENT, [&](UnitScript* script)
     {
         return !script->IsNeedModHealPercent(unit, auraEff, doneTotalMod, spellProto);
     });
@@ -143,7 +147,7 @@ bool ScriptMgr::IsNeedModHealPercent(Unit const* unit, AuraEffect* auraEff, floa
 
 bool ScriptMgr::CanSetPhaseMask(Unit const* unit, uint32 newPhaseMask, bool update)
 {
-    auto ret = IsValidBoolScript<UnitScript>([&](UnitScript* script)
+    auto ret = IsValidBoolScript<UnitScript>(UNITHOOK_CAN_SET_PHASE_MASK, [&](UnitScript* script)
     {
         return !script->CanSetPhaseMask(unit, newPhaseMask, update);
     });
@@ -153,7 +157,7 @@ bool ScriptMgr::CanSetPhaseMask(Unit const* unit, uint32 newPhaseMask, bool upda
 
 bool ScriptMgr::IsCustomBuildValuesUpdate(Unit const* unit, uint8 updateType, ByteBuffer* fieldBuffer, Player const* target, uint16 index)
 {
-    auto ret = IsValidBoolScript<UnitScript>([&](UnitScript* script)
+    auto ret = IsValidBoolScript<UnitScript>(UNITHOOK_IS_CUSTOM_BUILD_VALUES_UPDATE, [&](UnitScript* script)
     {
         return script->IsCustomBuildValuesUpdate(unit, updateType, fieldBuffer, target, index);
     });
@@ -163,7 +167,7 @@ bool ScriptMgr::IsCustomBuildValuesUpdate(Unit const* unit, uint8 updateType, By
 
 bool ScriptMgr::OnBuildValuesUpdate(Unit const* unit, uint8 updateType, ByteBuffer* fieldBuffer, Player* target, uint16 index)
 {
-    auto ret = IsValidBoolScript<UnitScript>([&](UnitScript* script)
+    auto ret = IsValidBoolScript<UnitScript>(UNITHOOK_ON_BUILD_VALUES_UPDATE, [&](UnitScript* script)
     {
         return script->OnBuildValuesUpdate(unit, updateType, fieldBuffer, target, index);
     });
@@ -171,9 +175,15 @@ bool ScriptMgr::OnBuildValuesUpdate(Unit const* unit, uint8 updateType, ByteBuff
     return ReturnValidBool(ret, true);
 }
 
+bool ScriptMgr::HasBuildValuesUpdateHooks()
+{
+    auto const& hooks = ScriptRegistry<UnitScript>::Instance()->GetHooks();
+    return hooks.HasSubscribers(UNITHOOK_IS_CUSTOM_BUILD_VALUES_UPDATE) || hooks.HasSubscribers(UNITHOOK_ON_BUILD_VALUES_UPDATE);
+}
+
 void ScriptMgr::OnUnitUpdate(Unit* unit, uint32 diff)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_ON_UNIT_UPDATE, [&](UnitScript* script)
     {
         script->OnUnitUpdate(unit, diff);
     });
@@ -181,7 +191,7 @@ void ScriptMgr::OnUnitUpdate(Unit* unit, uint32 diff)
 
 void ScriptMgr::OnDisplayIdChange(Unit* unit, uint32 displayId)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_ON_DISPLAY_ID_CHANGE, [&](UnitScript* script)
     {
         script->OnDisplayIdChange(unit, displayId);
     });
@@ -189,7 +199,7 @@ void ScriptMgr::OnDisplayIdChange(Unit* unit, uint32 displayId)
 
 void ScriptMgr::OnUnitEnterEvadeMode(Unit* unit, uint8 evadeReason)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_ON_UNIT_ENTER_EVADE_MODE, [&](UnitScript* script)
     {
         script->OnUnitEnterEvadeMode(unit, evadeReason);
     });
@@ -197,7 +207,7 @@ void ScriptMgr::OnUnitEnterEvadeMode(Unit* unit, uint8 evadeReason)
 
 void ScriptMgr::OnUnitEnterCombat(Unit* unit, Unit* victim)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_ON_UNIT_ENTER_COMBAT, [&](UnitScript* script)
     {
         script->OnUnitEnterCombat(unit, victim);
     });
@@ -205,7 +215,7 @@ void ScriptMgr::OnUnitEnterCombat(Unit* unit, Unit* victim)
 
 void ScriptMgr::OnUnitDeath(Unit* unit, Unit* killer)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_ON_UNIT_DEATH, [&](UnitScript* script)
     {
         script->OnUnitDeath(unit, killer);
     });
@@ -213,7 +223,7 @@ void ScriptMgr::OnUnitDeath(Unit* unit, Unit* killer)
 
 void ScriptMgr::OnAuraApply(Unit* unit, Aura* aura)
 {
-    ExecuteScript<UnitScript>([&](UnitScript* script)
+    ExecuteScript<UnitScript>(UNITHOOK_ON_AURA_APPLY, [&](UnitScript* script)
     {
         script->OnAuraApply(unit, aura);
     });
@@ -88,6 +88,9 @@ void ScriptMgr::OnShutdownCancel()
 
 void ScriptMgr::OnWorldUpdate(uint32 diff)
 {
+    // Map updates are finished here, no hook is executed by other threads
+    sScriptRegistryCompositum->CompactHooks();
+
     ExecuteScript<WorldScript>([diff](WorldScript* script)
     {
         script->OnUpdate(diff);
@@ -0,0 +1,609 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WARHEAD_SCRIPT_HOOKS_H_
+#define WARHEAD_SCRIPT_HOOKS_H_
+
+#include "Define.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <type_traits>
+#include <vector>
+
+class PlayerScript;
+class UnitScript;
+
+enum UnitHook : uint16
+{
+    UNITHOOK_ON_HEAL = 0,
+    UNITHOOK_ON_DAMAGE,
+    UNITHOOK_MODIFY_PERIODIC_DAMAGE_AURAS_TICK,
+    UNITHOOK_MODIFY_MELEE_DAMAGE,
+    UNITHOOK_MODIFY_SPELL_DAMAGE_TAKEN,
+    UNITHOOK_MODIFY_HEAL_RECEIVED,
+    UNITHOOK_DEAL_DAMAGE,
+    UNITHOOK_ON_BEFORE_ROLL_MELEE_OUTCOME_AGAINST,
+    UNITHOOK_ON_AURA_APPLY,
+    UNITHOOK_ON_AURA_REMOVE,
+    UNITHOOK_IF_NORMAL_REACTION,
+    UNITHOOK_IS_NEED_MOD_SPELL_DAMAGE_PERCENT,
+    UNITHOOK_IS_NEED_MOD_MELEE_DAMAGE_PERCENT,
+    UNITHOOK_IS_NEED_MOD_HEAL_PERCENT,
+    UNITHOOK_CAN_SET_PHASE_MASK,
+    UNITHOOK_IS_CUSTOM_BUILD_VALUES_UPDATE,
+    UNITHOOK_ON_BUILD_VALUES_UPDATE,
+    UNITHOOK_ON_UNIT_UPDATE,
+    UNITHOOK_ON_DISPLAY_ID_CHANGE,
+    UNITHOOK_ON_UNIT_ENTER_EVADE_MODE,
+    UNITHOOK_ON_UNIT_ENTER_COMBAT,
+    UNITHOOK_ON_UNIT_DEATH,
+    UNITHOOK_END
+};
+
+enum PlayerHook : uint16
+{
+    PLAYERHOOK_ON_PLAYER_RELEASED_GHOST = 0,
+    PLAYERHOOK_ON_SEND_INITIAL_PACKETS_BEFORE_ADD_TO_MAP,
+    PLAYERHOOK_ON_BATTLEGROUND_DESERTION,
+    PLAYERHOOK_ON_PLAYER_COMPLETE_QUEST,
+    PLAYERHOOK_ON_PVP_KILL,
+    PLAYERHOOK_ON_PLAYER_PVP_FLAG_CHANGE,
+    PLAYERHOOK_ON_CREATURE_KILL,
+    PLAYERHOOK_ON_CREATURE_KILLED_BY_PET,
+    PLAYERHOOK_ON_PLAYER_KILLED_BY_CREATURE,
+    PLAYERHOOK_ON_LEVEL_CHANGED,
+    PLAYERHOOK_ON_FREE_TALENT_POINTS_CHANGED,
+    PLAYERHOOK_ON_TALENTS_RESET,
+    PLAYERHOOK_ON_BEFORE_UPDATE,
+    PLAYERHOOK_ON_UPDATE,
+    PLAYERHOOK_ON_MONEY_CHANGED,
+    PLAYERHOOK_ON_BEFORE_LOOT_MONEY,
+    PLAYERHOOK_ON_GIVE_XP,
+    PLAYERHOOK_ON_REPUTATION_CHANGE,
+    PLAYERHOOK_ON_REPUTATION_RANK_CHANGE,
+    PLAYERHOOK_ON_LEARN_SPELL,
+    PLAYERHOOK_ON_FORGOT_SPELL,
+    PLAYERHOOK_ON_DUEL_REQUEST,
+    PLAYERHOOK_ON_DUEL_START,
+    PLAYERHOOK_ON_DUEL_END,
+    PLAYERHOOK_ON_CHAT,
+    PLAYERHOOK_ON_BEFORE_SEND_CHAT_MESSAGE,
+    PLAYERHOOK_ON_CHAT_RECEIVER,
+    PLAYERHOOK_ON_CHAT_GROUP,
+    PLAYERHOOK_ON_CHAT_GUILD,
+    PLAYERHOOK_ON_CHAT_CHANNEL,
+    PLAYERHOOK_ON_EMOTE,
+    PLAYERHOOK_ON_TEXT_EMOTE,
+    PLAYERHOOK_ON_SPELL_CAST,
+    PLAYERHOOK_ON_LOAD_FROM_DB,
+    PLAYERHOOK_ON_LOGIN,
+    PLAYERHOOK_ON_LOGOUT,
+    PLAYERHOOK_ON_CREATE,
+    PLAYERHOOK_ON_DELETE,
+    PLAYERHOOK_ON_FAILED_DELETE,
+    PLAYERHOOK_ON_SAVE,
+    PLAYERHOOK_ON_BIND_TO_INSTANCE,
+    PLAYERHOOK_ON_UPDATE_ZONE,
+    PLAYERHOOK_ON_UPDATE_AREA,
+    PLAYERHOOK_ON_MAP_CHANGED,
+    PLAYERHOOK_ON_BEFORE_TELEPORT,
+    PLAYERHOOK_ON_UPDATE_FACTION,
+    PLAYERHOOK_ON_ADD_TO_BATTLEGROUND,
+    PLAYERHOOK_ON_QUEUE_RANDOM_DUNGEON,
+    PLAYERHOOK_ON_REMOVE_FROM_BATTLEGROUND,
+    PLAYERHOOK_ON_ACHI_COMPLETE,
+    PLAYERHOOK_ON_BEFORE_ACHI_COMPLETE,
+    PLAYERHOOK_ON_CRITERIA_PROGRESS,
+    PLAYERHOOK_ON_BEFORE_CRITERIA_PROGRESS,
+    PLAYERHOOK_ON_ACHI_SAVE,
+    PLAYERHOOK_ON_CRITERIA_SAVE,
+    PLAYERHOOK_ON_GOSSIP_SELECT,
+    PLAYERHOOK_ON_GOSSIP_SELECT_CODE,
+    PLAYERHOOK_ON_BEING_CHARMED,
+    PLAYERHOOK_ON_AFTER_SET_VISIBLE_ITEM_SLOT,
+    PLAYERHOOK_ON_AFTER_MOVE_ITEM_FROM_INVENTORY,
+    PLAYERHOOK_ON_EQUIP,
+    PLAYERHOOK_ON_PLAYER_JOIN_BG,
+    PLAYERHOOK_ON_PLAYER_JOIN_ARENA,
+    PLAYERHOOK_GET_CUSTOM_GET_ARENA_TEAM_ID,
+    PLAYERHOOK_GET_CUSTOM_ARENA_PERSONAL_RATING,
+    PLAYERHOOK_ON_GET_MAX_PERSONAL_ARENA_RATING_REQUIREMENT,
+    PLAYERHOOK_ON_LOOT_ITEM,
+    PLAYERHOOK_ON_BEFORE_FILL_QUEST_LOOT_ITEM,
+    PLAYERHOOK_ON_STORE_NEW_ITEM,
+    PLAYERHOOK_ON_CREATE_ITEM,
+    PLAYERHOOK_ON_QUEST_REWARD_ITEM,
+    PLAYERHOOK_CAN_PLACE_AUCTION_BID,
+    PLAYERHOOK_ON_GROUP_ROLL_REWARD_ITEM,
+    PLAYERHOOK_ON_BEFORE_OPEN_ITEM,
+    PLAYERHOOK_ON_BEFORE_QUEST_COMPLETE,
+    PLAYERHOOK_ON_QUEST_COMPUTE_XP,
+    PLAYERHOOK_ON_BEFORE_DURABILITY_REPAIR,
+    PLAYERHOOK_ON_BEFORE_BUY_ITEM_FROM_VENDOR,
+    PLAYERHOOK_ON_BEFORE_STORE_OR_EQUIP_NEW_ITEM,
+    PLAYERHOOK_ON_AFTER_STORE_OR_EQUIP_NEW_ITEM,
+    PLAYERHOOK_ON_AFTER_UPDATE_MAX_POWER,
+    PLAYERHOOK_ON_AFTER_UPDATE_MAX_HEALTH,
+    PLAYERHOOK_ON_BEFORE_UPDATE_ATTACK_POWER_AND_DAMAGE,
+    PLAYERHOOK_ON_AFTER_UPDATE_ATTACK_POWER_AND_DAMAGE,
+    PLAYERHOOK_ON_BEFORE_INIT_TALENT_FOR_LEVEL,
+    PLAYERHOOK_ON_FIRST_LOGIN,
+    PLAYERHOOK_ON_SET_MAX_LEVEL,
+    PLAYERHOOK_CAN_JOIN_IN_BATTLEGROUND_QUEUE,
+    PLAYERHOOK_SHOULD_BE_REWARDED_WITH_MONEY_INSTEAD_OF_EXP,
+    PLAYERHOOK_ON_BEFORE_TEMP_SUMMON_INIT_STATS,
+    PLAYERHOOK_ON_BEFORE_GUARDIAN_INIT_STATS_FOR_LEVEL,
+    PLAYERHOOK_ON_AFTER_GUARDIAN_INIT_STATS_FOR_LEVEL,
+    PLAYERHOOK_ON_BEFORE_LOAD_PET_FROM_DB,
+    PLAYERHOOK_CAN_JOIN_IN_ARENA_QUEUE,
+    PLAYERHOOK_CAN_BATTLE_FIELD_PORT,
+    PLAYERHOOK_CAN_GROUP_INVITE,
+    PLAYERHOOK_CAN_GROUP_ACCEPT,
+    PLAYERHOOK_CAN_SELL_ITEM,
+    PLAYERHOOK_CAN_SEND_MAIL,
+    PLAYERHOOK_PETITION_BUY,
+    PLAYERHOOK_PETITION_SHOW_LIST,
+    PLAYERHOOK_ON_REWARD_KILL_REWARDER,
+    PLAYERHOOK_CAN_GIVE_MAIL_REWARD_AT_GIVE_LEVEL,
+    PLAYERHOOK_ON_DELETE_FROM_DB,
+    PLAYERHOOK_CAN_REPOP_AT_GRAVEYARD,
+    PLAYERHOOK_ON_GET_MAX_SKILL_VALUE,
+    PLAYERHOOK_ON_UPDATE_GATHERING_SKILL,
+    PLAYERHOOK_ON_UPDATE_CRAFTING_SKILL,
+    PLAYERHOOK_ON_UPDATE_FISHING_SKILL,
+    PLAYERHOOK_CAN_AREA_EXPLORE_AND_OUTDOOR,
+    PLAYERHOOK_ON_VICTIM_REWARD_BEFORE,
+    PLAYERHOOK_ON_VICTIM_REWARD_AFTER,
+    PLAYERHOOK_ON_CUSTOM_SCALING_STAT_VALUE_BEFORE,
+    PLAYERHOOK_ON_CUSTOM_SCALING_STAT_VALUE,
+    PLAYERHOOK_CAN_ARMOR_DAMAGE_MODIFIER,
+    PLAYERHOOK_ON_GET_FERAL_AP_BONUS,
+    PLAYERHOOK_CAN_APPLY_WEAPON_DEPENDENT_AURA_DAMAGE_MOD,
+    PLAYERHOOK_CAN_APPLY_EQUIP_SPELL,
+    PLAYERHOOK_CAN_APPLY_EQUIP_SPELLS_ITEM_SET,
+    PLAYERHOOK_CAN_CAST_ITEM_COMBAT_SPELL,
+    PLAYERHOOK_CAN_CAST_ITEM_USE_SPELL,
+    PLAYERHOOK_ON_APPLY_AMMO_BONUSES,
+    PLAYERHOOK_CAN_EQUIP_ITEM,
+    PLAYERHOOK_CAN_UNEQUIP_ITEM,
+    PLAYERHOOK_CAN_USE_ITEM,
+    PLAYERHOOK_CAN_SAVE_EQUIP_NEW_ITEM,
+    PLAYERHOOK_CAN_APPLY_ENCHANTMENT,
+    PLAYERHOOK_ON_GET_QUEST_RATE,
+    PLAYERHOOK_PASSED_QUEST_KILLED_MONSTER_CREDIT,
+    PLAYERHOOK_CHECK_ITEM_IN_SLOT_AT_LOAD_INVENTORY,
+    PLAYERHOOK_NOT_AVOID_SATISFY,
+    PLAYERHOOK_NOT_VISIBLE_GLOBALLY_FOR,
+    PLAYERHOOK_ON_GET_ARENA_PERSONAL_RATING,
+    PLAYERHOOK_ON_GET_ARENA_TEAM_ID,
+    PLAYERHOOK_ON_FFA_PVP_STATE_UPDATE,
+    PLAYERHOOK_ON_IS_FFA_PV_P,
+    PLAYERHOOK_ON_IS_PV_P,
+    PLAYERHOOK_ON_GET_MAX_SKILL_VALUE_FOR_LEVEL,
+    PLAYERHOOK_NOT_SET_ARENA_TEAM_INFO_FIELD,
+    PLAYERHOOK_CAN_JOIN_LFG,
+    PLAYERHOOK_CAN_ENTER_MAP,
+    PLAYERHOOK_CAN_INIT_TRADE,
+    PLAYERHOOK_ON_SET_SERVER_SIDE_VISIBILITY,
+    PLAYERHOOK_ON_SET_SERVER_SIDE_VISIBILITY_DETECT,
+    PLAYERHOOK_ON_GIVE_HONOR_POINTS,
+    PLAYERHOOK_ON_AFTER_RESURRECT,
+    PLAYERHOOK_ON_PLAYER_RESURRECT,
+    PLAYERHOOK_ON_BEFORE_CHOOSE_GRAVEYARD,
+    PLAYERHOOK_CAN_PLAYER_USE_CHAT,
+    PLAYERHOOK_CAN_PLAYER_USE_CHAT_RECEIVER,
+    PLAYERHOOK_CAN_PLAYER_USE_CHAT_GROUP,
+    PLAYERHOOK_CAN_PLAYER_USE_CHAT_GUILD,
+    PLAYERHOOK_CAN_PLAYER_USE_CHAT_CHANNEL,
+    PLAYERHOOK_ON_PLAYER_LEARN_TALENTS,
+    PLAYERHOOK_ON_PLAYER_ENTER_COMBAT,
+    PLAYERHOOK_ON_PLAYER_LEAVE_COMBAT,
+    PLAYERHOOK_ON_QUEST_ABANDON,
+    PLAYERHOOK_ON_GET_DODGE_FROM_AGILITY,
+    PLAYERHOOK_ON_GET_ARMOR_FROM_AGILITY,
+    PLAYERHOOK_ON_GET_MELEE_CRIT_FROM_AGILITY,
+    PLAYERHOOK_ON_GET_SPELL_CRIT_FROM_INTELLECT,
+    PLAYERHOOK_ON_GET_MANA_BONUS_FROM_INTELLECT,
+    PLAYERHOOK_ON_GET_SHIELD_BLOCK_VALUE,
+    PLAYERHOOK_ON_UPDATE_ATTACK_POWER_AND_DAMAGE,
+    PLAYERHOOK_ON_CALCULATE_MIN_MAX_DAMAGE,
+    PLAYERHOOK_CAN_COMPLETE_QUEST,
+    PLAYERHOOK_ON_ADD_QUEST,
+    PLAYERHOOK_ON_UPDATE_PROFESSION_SKILL,
+    PLAYERHOOK_ANTICHEAT_SET_SKIP_ONE_PACKET_FOR_ASH,
+    PLAYERHOOK_ANTICHEAT_SET_CAN_FLYBY_SERVER,
+    PLAYERHOOK_ANTICHEAT_SET_UNDER_AC_KMOUNT,
+    PLAYERHOOK_ANTICHEAT_SET_ROOT_ACK_UPD,
+    PLAYERHOOK_ANTICHEAT_SET_JUMPINGBY_OPCODE,
+    PLAYERHOOK_ANTICHEAT_UPDATE_MOVEMENT_INFO,
+    PLAYERHOOK_ANTICHEAT_HANDLE_DOUBLE_JUMP,
+    PLAYERHOOK_ANTICHEAT_CHECK_MOVEMENT_INFO,
+    PLAYERHOOK_CAN_SEND_ERROR_ALREADY_LOOTED,
+    PLAYERHOOK_ON_AFTER_CREATURE_LOOT,
+    PLAYERHOOK_ON_AFTER_CREATURE_LOOT_MONEY,
+    PLAYERHOOK_END
+};
+
+// Hook and script method it's called by, HOOK(hook, method[, signature]) is expanded for every hook.
+// Signature is given for overloaded methods only.
+#define WARHEAD_UNIT_HOOKS(HOOK) \
+    HOOK(UNITHOOK_ON_HEAL, OnHeal) \
+    HOOK(UNITHOOK_ON_DAMAGE, OnDamage) \
+    HOOK(UNITHOOK_MODIFY_PERIODIC_DAMAGE_AURAS_TICK, ModifyPeriodicDamageAurasTick) \
+    HOOK(UNITHOOK_MODIFY_MELEE_DAMAGE, ModifyMeleeDamage) \
+    HOOK(UNITHOOK_MODIFY_SPELL_DAMAGE_TAKEN, ModifySpellDamageTaken) \
+    HOOK(UNITHOOK_MODIFY_HEAL_RECEIVED, ModifyHealReceived) \
+    HOOK(UNITHOOK_DEAL_DAMAGE, DealDamage) \
+    HOOK(UNITHOOK_ON_BEFORE_ROLL_MELEE_OUTCOME_AGAINST, OnBeforeRollMeleeOutcomeAgainst) \
+    HOOK(UNITHOOK_ON_AURA_APPLY, OnAuraApply) \
+    HOOK(UNITHOOK_ON_AURA_REMOVE, OnAuraRemove) \
+    HOOK(UNITHOOK_IF_NORMAL_REACTION, IfNormalReaction) \
+    HOOK(UNITHOOK_IS_NEED_MOD_SPELL_DAMAGE_PERCENT, IsNeedModSpellDamagePercent) \
+    HOOK(UNITHOOK_IS_NEED_MOD_MELEE_DAMAGE_PERCENT, IsNeedModMeleeDamagePercent) \
+    HOOK(UNITHOOK_IS_NEED_MOD_HEAL_PERCENT, IsNeedModHealPercent) \
+    HOOK(UNITHOOK_CAN_SET_PHASE_MASK, CanSetPhaseMask) \
+    HOOK(UNITHOOK_IS_CUSTOM_BUILD_VALUES_UPDATE, IsCustomBuildValuesUpdate) \
+    HOOK(UNITHOOK_ON_BUILD_VALUES_UPDATE, OnBuildValuesUpdate) \
+    HOOK(UNITHOOK_ON_UNIT_UPDATE, OnUnitUpdate) \
+    HOOK(UNITHOOK_ON_DISPLAY_ID_CHANGE, OnDisplayIdChange) \
+    HOOK(UNITHOOK_ON_UNIT_ENTER_EVADE_MODE, OnUnitEnterEvadeMode) \
+    HOOK(UNITHOOK_ON_UNIT_ENTER_COMBAT, OnUnitEnterCombat) \
+    HOOK(UNITHOOK_ON_UNIT_DEATH, OnUnitDeath)
+
+#define WARHEAD_PLAYER_HOOKS(HOOK) \
+    HOOK(PLAYERHOOK_ON_PLAYER_RELEASED_GHOST, OnPlayerReleasedGhost) \
+    HOOK(PLAYERHOOK_ON_SEND_INITIAL_PACKETS_BEFORE_ADD_TO_MAP, OnSendInitialPacketsBeforeAddToMap) \
+    HOOK(PLAYERHOOK_ON_BATTLEGROUND_DESERTION, OnBattlegroundDesertion) \
+    HOOK(PLAYERHOOK_ON_PLAYER_COMPLETE_QUEST, OnPlayerCompleteQuest) \
+    HOOK(PLAYERHOOK_ON_PVP_KILL, OnPVPKill) \
+    HOOK(PLAYERHOOK_ON_PLAYER_PVP_FLAG_CHANGE, OnPlayerPVPFlagChange) \
+    HOOK(PLAYERHOOK_ON_CREATURE_KILL, OnCreatureKill) \
+    HOOK(PLAYERHOOK_ON_CREATURE_KILLED_BY_PET, OnCreatureKilledByPet) \
+    HOOK(PLAYERHOOK_ON_PLAYER_KILLED_BY_CREATURE, OnPlayerKilledByCreature) \
+    HOOK(PLAYERHOOK_ON_LEVEL_CHANGED, OnLevelChanged) \
+    HOOK(PLAYERHOOK_ON_FREE_TALENT_POINTS_CHANGED, OnFreeTalentPointsChanged) \
+    HOOK(PLAYERHOOK_ON_TALENTS_RESET, OnTalentsReset) \
+    HOOK(PLAYERHOOK_ON_BEFORE_UPDATE, OnBeforeUpdate) \
+    HOOK(PLAYERHOOK_ON_UPDATE, OnUpdate) \
+    HOOK(PLAYERHOOK_ON_MONEY_CHANGED, OnMoneyChanged) \
+    HOOK(PLAYERHOOK_ON_BEFORE_LOOT_MONEY, OnBeforeLootMoney) \
+    HOOK(PLAYERHOOK_ON_GIVE_XP, OnGiveXP) \
+    HOOK(PLAYERHOOK_ON_REPUTATION_CHANGE, OnReputationChange) \
+    HOOK(PLAYERHOOK_ON_REPUTATION_RANK_CHANGE, OnReputationRankChange) \
+    HOOK(PLAYERHOOK_ON_LEARN_SPELL, OnLearnSpell) \
+    HOOK(PLAYERHOOK_ON_FORGOT_SPELL, OnForgotSpell) \
+    HOOK(PLAYERHOOK_ON_DUEL_REQUEST, OnDuelRequest) \
+    HOOK(PLAYERHOOK_ON_DUEL_START, OnDuelStart) \
+    HOOK(PLAYERHOOK_ON_DUEL_END, OnDuelEnd) \
+    HOOK(PLAYERHOOK_ON_CHAT, OnChat, void(Player*, uint32, uint32, std::string&)) \
+    HOOK(PLAYERHOOK_ON_BEFORE_SEND_CHAT_MESSAGE, OnBeforeSendChatMessage) \
+    HOOK(PLAYERHOOK_ON_CHAT_RECEIVER, OnChat, void(Player*, uint32, uint32, std::string&, Player*)) \
+    HOOK(PLAYERHOOK_ON_CHAT_GROUP, OnChat, void(Player*, uint32, uint32, std::string&, Group*)) \
+    HOOK(PLAYERHOOK_ON_CHAT_GUILD, OnChat, void(Player*, uint32, uint32, std::string&, Guild*)) \
+    HOOK(PLAYERHOOK_ON_CHAT_CHANNEL, OnChat, void(Player*, uint32, uint32, std::string&, Channel*)) \
+    HOOK(PLAYERHOOK_ON_EMOTE, OnEmote) \
+    HOOK(PLAYERHOOK_ON_TEXT_EMOTE, OnTextEmote) \
+    HOOK(PLAYERHOOK_ON_SPELL_CAST, OnSpellCast) \
+    HOOK(PLAYERHOOK_ON_LOAD_FROM_DB, OnLoadFromDB) \
+    HOOK(PLAYERHOOK_ON_LOGIN, OnLogin) \
+    HOOK(PLAYERHOOK_ON_LOGOUT, OnLogout) \
+    HOOK(PLAYERHOOK_ON_CREATE, OnCreate) \
+    HOOK(PLAYERHOOK_ON_DELETE, OnDelete) \
+    HOOK(PLAYERHOOK_ON_FAILED_DELETE, OnFailedDelete) \
+    HOOK(PLAYERHOOK_ON_SAVE, OnSave) \
+    HOOK(PLAYERHOOK_ON_BIND_TO_INSTANCE, OnBindToInstance) \
+    HOOK(PLAYERHOOK_ON_UPDATE_ZONE, OnUpdateZone) \
+    HOOK(PLAYERHOOK_ON_UPDATE_AREA, OnUpdateArea) \
+    HOOK(PLAYERHOOK_ON_MAP_CHANGED, OnMapChanged) \
+    HOOK(PLAYERHOOK_ON_BEFORE_TELEPORT, OnBeforeTeleport) \
+    HOOK(PLAYERHOOK_ON_UPDATE_FACTION, OnUpdateFaction) \
+    HOOK(PLAYERHOOK_ON_ADD_TO_BATTLEGROUND, OnAddToBattleground) \
+    HOOK(PLAYERHOOK_ON_QUEUE_RANDOM_DUNGEON, OnQueueRandomDungeon) \
+    HOOK(PLAYERHOOK_ON_REMOVE_FROM_BATTLEGROUND, OnRemoveFromBattleground) \
+    HOOK(PLAYERHOOK_ON_ACHI_COMPLETE, OnAchiComplete) \
+    HOOK(PLAYERHOOK_ON_BEFORE_ACHI_COMPLETE, OnBeforeAchiComplete) \
+    HOOK(PLAYERHOOK_ON_CRITERIA_PROGRESS, OnCriteriaProgress) \
+    HOOK(PLAYERHOOK_ON_BEFORE_CRITERIA_PROGRESS, OnBeforeCriteriaProgress) \
+    HOOK(PLAYERHOOK_ON_ACHI_SAVE, OnAchiSave) \
+    HOOK(PLAYERHOOK_ON_CRITERIA_SAVE, OnCriteriaSave) \
+    HOOK(PLAYERHOOK_ON_GOSSIP_SELECT, OnGossipSelect) \
+    HOOK(PLAYERHOOK_ON_GOSSIP_SELECT_CODE, OnGossipSelectCode) \
+    HOOK(PLAYERHOOK_ON_BEING_CHARMED, OnBeingCharmed) \
+    HOOK(PLAYERHOOK_ON_AFTER_SET_VISIBLE_ITEM_SLOT, OnAfterSetVisibleItemSlot) \
+    HOOK(PLAYERHOOK_ON_AFTER_MOVE_ITEM_FROM_INVENTORY, OnAfterMoveItemFromInventory) \
+    HOOK(PLAYERHOOK_ON_EQUIP, OnEquip) \
+    HOOK(PLAYERHOOK_ON_PLAYER_JOIN_BG, OnPlayerJoinBG) \
+    HOOK(PLAYERHOOK_ON_PLAYER_JOIN_ARENA, OnPlayerJoinArena) \
+    HOOK(PLAYERHOOK_GET_CUSTOM_GET_ARENA_TEAM_ID, GetCustomGetArenaTeamId) \
+    HOOK(PLAYERHOOK_GET_CUSTOM_ARENA_PERSONAL_RATING, GetCustomArenaPersonalRating) \
+    HOOK(PLAYERHOOK_ON_GET_MAX_PERSONAL_ARENA_RATING_REQUIREMENT, OnGetMaxPersonalArenaRatingRequirement) \
+    HOOK(PLAYERHOOK_ON_LOOT_ITEM, OnLootItem) \
+    HOOK(PLAYERHOOK_ON_BEFORE_FILL_QUEST_LOOT_ITEM, OnBeforeFillQuestLootItem) \
+    HOOK(PLAYERHOOK_ON_STORE_NEW_ITEM, OnStoreNewItem) \
+    HOOK(PLAYERHOOK_ON_CREATE_ITEM, OnCreateItem) \
+    HOOK(PLAYERHOOK_ON_QUEST_REWARD_ITEM, OnQuestRewardItem) \
+    HOOK(PLAYERHOOK_CAN_PLACE_AUCTION_BID, CanPlaceAuctionBid) \
+    HOOK(PLAYERHOOK_ON_GROUP_ROLL_REWARD_ITEM, OnGroupRollRewardItem) \
+    HOOK(PLAYERHOOK_ON_BEFORE_OPEN_ITEM, OnBeforeOpenItem) \
+    HOOK(PLAYERHOOK_ON_BEFORE_QUEST_COMPLETE, OnBeforeQuestComplete) \
+    HOOK(PLAYERHOOK_ON_QUEST_COMPUTE_XP, OnQuestComputeXP) \
+    HOOK(PLAYERHOOK_ON_BEFORE_DURABILITY_REPAIR, OnBeforeDurabilityRepair) \
+    HOOK(PLAYERHOOK_ON_BEFORE_BUY_ITEM_FROM_VENDOR, OnBeforeBuyItemFromVendor) \
+    HOOK(PLAYERHOOK_ON_BEFORE_STORE_OR_EQUIP_NEW_ITEM, OnBeforeStoreOrEquipNewItem) \
+    HOOK(PLAYERHOOK_ON_AFTER_STORE_OR_EQUIP_NEW_ITEM, OnAfterStoreOrEquipNewItem) \
+    HOOK(PLAYERHOOK_ON_AFTER_UPDATE_MAX_POWER, OnAfterUpdateMaxPower) \
+    HOOK(PLAYERHOOK_ON_AFTER_UPDATE_MAX_HEALTH, OnAfterUpdateMaxHealth) \
+    HOOK(PLAYERHOOK_ON_BEFORE_UPDATE_ATTACK_POWER_AND_DAMAGE, OnBeforeUpdateAttackPowerAndDamage) \
+    HOOK(PLAYERHOOK_ON_AFTER_UPDATE_ATTACK_POWER_AND_DAMAGE, OnAfterUpdateAttackPowerAndDamage) \
+    HOOK(PLAYERHOOK_ON_BEFORE_INIT_TALENT_FOR_LEVEL, OnBeforeInitTalentForLevel) \
+    HOOK(PLAYERHOOK_ON_FIRST_LOGIN, OnFirstLogin) \
+    HOOK(PLAYERHOOK_ON_SET_MAX_LEVEL, OnSetMaxLevel) \
+    HOOK(PLAYERHOOK_CAN_JOIN_IN_BATTLEGROUND_QUEUE, CanJoinInBattlegroundQueue) \
+    HOOK(PLAYERHOOK_SHOULD_BE_REWARDED_WITH_MONEY_INSTEAD_OF_EXP, ShouldBeRewardedWithMoneyInsteadOfExp) \
+    HOOK(PLAYERHOOK_ON_BEFORE_TEMP_SUMMON_INIT_STATS, OnBeforeTempSummonInitStats) \
+    HOOK(PLAYERHOOK_ON_BEFORE_GUARDIAN_INIT_STATS_FOR_LEVEL, OnBeforeGuardianInitStatsForLevel) \
+    HOOK(PLAYERHOOK_ON_AFTER_GUARDIAN_INIT_STATS_FOR_LEVEL, OnAfterGuardianInitStatsForLevel) \
+    HOOK(PLAYERHOOK_ON_BEFORE_LOAD_PET_FROM_DB, OnBeforeLoadPetFromDB) \
+    HOOK(PLAYERHOOK_CAN_JOIN_IN_ARENA_QUEUE, CanJoinInArenaQueue) \
+    HOOK(PLAYERHOOK_CAN_BATTLE_FIELD_PORT, CanBattleFieldPort) \
+    HOOK(PLAYERHOOK_CAN_GROUP_INVITE, CanGroupInvite) \
+    HOOK(PLAYERHOOK_CAN_GROUP_ACCEPT, CanGroupAccept) \
+    HOOK(PLAYERHOOK_CAN_SELL_ITEM, CanSellItem) \
+    HOOK(PLAYERHOOK_CAN_SEND_MAIL, CanSendMail) \
+    HOOK(PLAYERHOOK_PETITION_BUY, PetitionBuy) \
+    HOOK(PLAYERHOOK_PETITION_SHOW_LIST, PetitionShowList) \
+    HOOK(PLAYERHOOK_ON_REWARD_KILL_REWARDER, OnRewardKillRewarder) \
+    HOOK(PLAYERHOOK_CAN_GIVE_MAIL_REWARD_AT_GIVE_LEVEL, CanGiveMailRewardAtGiveLevel) \
+    HOOK(PLAYERHOOK_ON_DELETE_FROM_DB, OnDeleteFromDB) \
+    HOOK(PLAYERHOOK_CAN_REPOP_AT_GRAVEYARD, CanRepopAtGraveyard) \
+    HOOK(PLAYERHOOK_ON_GET_MAX_SKILL_VALUE, OnGetMaxSkillValue) \
+    HOOK(PLAYERHOOK_ON_UPDATE_GATHERING_SKILL, OnUpdateGatheringSkill) \
+    HOOK(PLAYERHOOK_ON_UPDATE_CRAFTING_SKILL, OnUpdateCraftingSkill) \
+    HOOK(PLAYERHOOK_ON_UPDATE_FISHING_SKILL, OnUpdateFishingSkill) \
+    HOOK(PLAYERHOOK_CAN_AREA_EXPLORE_AND_OUTDOOR, CanAreaExploreAndOutdoor) \
+    HOOK(PLAYERHOOK_ON_VICTIM_REWARD_BEFORE, OnVictimRewardBefore) \
+    HOOK(PLAYERHOOK_ON_VICTIM_REWARD_AFTER, OnVictimRewardAfter) \
+    HOOK(PLAYERHOOK_ON_CUSTOM_SCALING_STAT_VALUE_BEFORE, OnCustomScalingStatValueBefore) \
+    HOOK(PLAYERHOOK_ON_CUSTOM_SCALING_STAT_VALUE, OnCustomScalingStatValue) \
+    HOOK(PLAYERHOOK_CAN_ARMOR_DAMAGE_MODIFIER, CanArmorDamageModifier) \
+    HOOK(PLAYERHOOK_ON_GET_FERAL_AP_BONUS, OnGetFeralApBonus) \
+    HOOK(PLAYERHOOK_CAN_APPLY_WEAPON_DEPENDENT_AURA_DAMAGE_MOD, CanApplyWeaponDependentAuraDamageMod) \
+    HOOK(PLAYERHOOK_CAN_APPLY_EQUIP_SPELL, CanApplyEquipSpell) \
+    HOOK(PLAYERHOOK_CAN_APPLY_EQUIP_SPELLS_ITEM_SET, CanApplyEquipSpellsItemSet) \
+    HOOK(PLAYERHOOK_CAN_CAST_ITEM_COMBAT_SPELL, CanCastItemCombatSpell) \
+    HOOK(PLAYERHOOK_CAN_CAST_ITEM_USE_SPELL, CanCastItemUseSpell) \
+    HOOK(PLAYERHOOK_ON_APPLY_AMMO_BONUSES, OnApplyAmmoBonuses) \
+    HOOK(PLAYERHOOK_CAN_EQUIP_ITEM, CanEquipItem) \
+    HOOK(PLAYERHOOK_CAN_UNEQUIP_ITEM, CanUnequipItem) \
+    HOOK(PLAYERHOOK_CAN_USE_ITEM, CanUseItem) \
+    HOOK(PLAYERHOOK_CAN_SAVE_EQUIP_NEW_ITEM, CanSaveEquipNewItem) \
+    HOOK(PLAYERHOOK_CAN_APPLY_ENCHANTMENT, CanApplyEnchantment) \
+    HOOK(PLAYERHOOK_ON_GET_QUEST_RATE, OnGetQuestRate) \
+    HOOK(PLAYERHOOK_PASSED_QUEST_KILLED_MONSTER_CREDIT, PassedQuestKilledMonsterCredit) \
+    HOOK(PLAYERHOOK_CHECK_ITEM_IN_SLOT_AT_LOAD_INVENTORY, CheckItemInSlotAtLoadInventory) \
+    HOOK(PLAYERHOOK_NOT_AVOID_SATISFY, NotAvoidSatisfy) \
+    HOOK(PLAYERHOOK_NOT_VISIBLE_GLOBALLY_FOR, NotVisibleGloballyFor) \
+    HOOK(PLAYERHOOK_ON_GET_ARENA_PERSONAL_RATING, OnGetArenaPersonalRating) \
+    HOOK(PLAYERHOOK_ON_GET_ARENA_TEAM_ID, OnGetArenaTeamId) \
+    HOOK(PLAYERHOOK_ON_FFA_PVP_STATE_UPDATE, OnFfaPvpStateUpdate) \
+    HOOK(PLAYERHOOK_ON_IS_FFA_PV_P, OnIsFFAPvP) \
+    HOOK(PLAYERHOOK_ON_IS_PV_P, OnIsPvP) \
+    HOOK(PLAYERHOOK_ON_GET_MAX_SKILL_VALUE_FOR_LEVEL, OnGetMaxSkillValueForLevel) \
+    HOOK(PLAYERHOOK_NOT_SET_ARENA_TEAM_INFO_FIELD, NotSetArenaTeamInfoField) \
+    HOOK(PLAYERHOOK_CAN_JOIN_LFG, CanJoinLfg) \
+    HOOK(PLAYERHOOK_CAN_ENTER_MAP, CanEnterMap) \
+    HOOK(PLAYERHOOK_CAN_INIT_TRADE, CanInitTrade) \
+    HOOK(PLAYERHOOK_ON_SET_SERVER_SIDE_VISIBILITY, OnSetServerSideVisibility) \
+    HOOK(PLAYERHOOK_ON_SET_SERVER_SIDE_VISIBILITY_DETECT, OnSetServerSideVisibilityDetect) \
+    HOOK(PLAYERHOOK_ON_GIVE_HONOR_POINTS, OnGiveHonorPoints) \
+    HOOK(PLAYERHOOK_ON_AFTER_RESURRECT, OnAfterResurrect) \
+    HOOK(PLAYERHOOK_ON_PLAYER_RESURRECT, OnPlayerResurrect) \
+    HOOK(PLAYERHOOK_ON_BEFORE_CHOOSE_GRAVEYARD, OnBeforeChooseGraveyard) \
+    HOOK(PLAYERHOOK_CAN_PLAYER_USE_CHAT, CanPlayerUseChat, bool(Player*, uint32, uint32, std::string&)) \
+    HOOK(PLAYERHOOK_CAN_PLAYER_USE_CHAT_RECEIVER, CanPlayerUseChat, bool(Player*, uint32, uint32, std::string&, Player*)) \
+    HOOK(PLAYERHOOK_CAN_PLAYER_USE_CHAT_GROUP, CanPlayerUseChat, bool(Player*, uint32, uint32, std::string&, Group*)) \
+    HOOK(PLAYERHOOK_CAN_PLAYER_USE_CHAT_GUILD, CanPlayerUseChat, bool(Player*, uint32, uint32, std::string&, Guild*)) \
+    HOOK(PLAYERHOOK_CAN_PLAYER_USE_CHAT_CHANNEL, CanPlayerUseChat, bool(Player*, uint32, uint32, std::string&, Channel*)) \
+    HOOK(PLAYERHOOK_ON_PLAYER_LEARN_TALENTS, OnPlayerLearnTalents) \
+    HOOK(PLAYERHOOK_ON_PLAYER_ENTER_COMBAT, OnPlayerEnterCombat) \
+    HOOK(PLAYERHOOK_ON_PLAYER_LEAVE_COMBAT, OnPlayerLeaveCombat) \
+    HOOK(PLAYERHOOK_ON_QUEST_ABANDON, OnQuestAbandon) \
+    HOOK(PLAYERHOOK_ON_GET_DODGE_FROM_AGILITY, OnGetDodgeFromAgility) \
+    HOOK(PLAYERHOOK_ON_GET_ARMOR_FROM_AGILITY, OnGetArmorFromAgility) \
+    HOOK(PLAYERHOOK_ON_GET_MELEE_CRIT_FROM_AGILITY, OnGetMeleeCritFromAgility) \
+    HOOK(PLAYERHOOK_ON_GET_SPELL_CRIT_FROM_INTELLECT, OnGetSpellCritFromIntellect) \
+    HOOK(PLAYERHOOK_ON_GET_MANA_BONUS_FROM_INTELLECT, OnGetManaBonusFromIntellect) \
+    HOOK(PLAYERHOOK_ON_GET_SHIELD_BLOCK_VALUE, OnGetShieldBlockValue) \
+    HOOK(PLAYERHOOK_ON_UPDATE_ATTACK_POWER_AND_DAMAGE, OnUpdateAttackPowerAndDamage) \
+    HOOK(PLAYERHOOK_ON_CALCULATE_MIN_MAX_DAMAGE, OnCalculateMinMaxDamage) \
+    HOOK(PLAYERHOOK_CAN_COMPLETE_QUEST, CanCompleteQuest) \
+    HOOK(PLAYERHOOK_ON_ADD_QUEST, OnAddQuest) \
+    HOOK(PLAYERHOOK_ON_UPDATE_PROFESSION_SKILL, OnUpdateProfessionSkill) \
+    HOOK(PLAYERHOOK_ANTICHEAT_SET_SKIP_ONE_PACKET_FOR_ASH, AnticheatSetSkipOnePacketForASH) \
+    HOOK(PLAYERHOOK_ANTICHEAT_SET_CAN_FLYBY_SERVER, AnticheatSetCanFlybyServer) \
+    HOOK(PLAYERHOOK_ANTICHEAT_SET_UNDER_AC_KMOUNT, AnticheatSetUnderACKmount) \
+    HOOK(PLAYERHOOK_ANTICHEAT_SET_ROOT_ACK_UPD, AnticheatSetRootACKUpd) \
+    HOOK(PLAYERHOOK_ANTICHEAT_SET_JUMPINGBY_OPCODE, AnticheatSetJumpingbyOpcode) \
+    HOOK(PLAYERHOOK_ANTICHEAT_UPDATE_MOVEMENT_INFO, AnticheatUpdateMovementInfo) \
+    HOOK(PLAYERHOOK_ANTICHEAT_HANDLE_DOUBLE_JUMP, AnticheatHandleDoubleJump) \
+    HOOK(PLAYERHOOK_ANTICHEAT_CHECK_MOVEMENT_INFO, AnticheatCheckMovementInfo) \
+    HOOK(PLAYERHOOK_CAN_SEND_ERROR_ALREADY_LOOTED, CanSendErrorAlreadyLooted) \
+    HOOK(PLAYERHOOK_ON_AFTER_CREATURE_LOOT, OnAfterCreatureLoot) \
+    HOOK(PLAYERHOOK_ON_AFTER_CREATURE_LOOT_MONEY, OnAfterCreatureLootMoney)
+
+#define WARHEAD_COUNT_SCRIPT_HOOK(hook, ...) + 1
+static_assert(0 WARHEAD_UNIT_HOOKS(WARHEAD_COUNT_SCRIPT_HOOK) == UNITHOOK_END, "WARHEAD_UNIT_HOOKS must list every UnitHook");
+static_assert(0 WARHEAD_PLAYER_HOOKS(WARHEAD_COUNT_SCRIPT_HOOK) == PLAYERHOOK_END, "WARHEAD_PLAYER_HOOKS must list every PlayerHook");
+#undef WARHEAD_COUNT_SCRIPT_HOOK
+
+// Number of hooks of script types with hook indexed dispatch, 0 for others
+template<typename>
+struct script_hook_count
+    : std::integral_constant<std::size_t, 0> { };
+
+template<>
+struct script_hook_count<UnitScript>
+    : std::integral_constant<std::size_t, UNITHOOK_END> { };
+
+template<>
+struct script_hook_count<PlayerScript>
+    : std::integral_constant<std::size_t, PLAYERHOOK_END> { };
+
+/**
+ * @class ScriptHookMask
+ *
+ * @brief Hooks of one script which are known not to be overridden.
+ *
+ * Scripts created by RegisterHookedScript know their overridden hooks at compile time, all other hooks are marked
+ * right away and base class hooks called from overrides are ignored. Scripts created otherwise never mark hooks,
+ * they stay subscribed to every hook as their overrides can't be told apart from default implementations.
+ * HookType only keeps masks of different script types apart when a script derives from several of them.
+ */
+template<typename HookType, std::size_t HookCount>
+class ScriptHookMask
+{
+public:
+    [[nodiscard]] bool IsHookUnused(std::size_t hook) const
+    {
+        return (_unusedHooks[hook / 64].load(std::memory_order_relaxed) & (uint64(1) << (hook % 64))) != 0;
+    }
+
+    [[nodiscard]] bool IsHookIndexed() const { return _hookIndexed; }
+    void SetHookIndexed() { _hookIndexed = true; }
+
+    [[nodiscard]] bool AreOverriddenHooksKnown() const { return _overriddenHooksKnown; }
+
+protected:
+    ScriptHookMask() = default;
+
+    // Called once when script is registered, before its hooks are called
+    void SetOverriddenHooks(std::bitset<HookCount> const& hooks)
+    {
+        _overriddenHooks = hooks;
+        _overriddenHooksKnown = true;
+    }
+
+    // Returns true when this call marked the hook, overridden and unknown hooks are never marked
+    bool MarkHookUnused(std::size_t hook) const
+    {
+        if (!_overriddenHooksKnown || _overriddenHooks.test(hook))
+            return false;
+
+        uint64 bit = uint64(1) << (hook % 64);
+        return !(_unusedHooks[hook / 64].fetch_or(bit, std::memory_order_relaxed) & bit);
+    }
+
+private:
+    mutable std::array<std::atomic<uint64>, (HookCount + 63) / 64> _unusedHooks{};
+    std::bitset<HookCount> _overriddenHooks;
+    bool _overriddenHooksKnown{ false };
+    bool _hookIndexed{ false };
+};
+
+/**
+ * @class ScriptHookIndex
+ *
+ * @brief Scripts subscribed to each hook of one script type.
+ *
+ * Every registered script subscribes to all hooks it didn't mark unused yet. Marked scripts are skipped
+ * right away and dropped from subscriber lists by Compact, which must not run while hooks are called.
+ * Hook without subscribers costs one branch.
+ */
+template<class ScriptType, std::size_t HookCount = script_hook_count<ScriptType>::value>
+class ScriptHookIndex
+{
+public:
+    // Called by script registry whenever its scripts change
+    template<class ScriptStore>
+    void Rebuild(ScriptStore const& scripts)
+    {
+        for (std::size_t hook = 0; hook < HookCount; ++hook)
+        {
+            _subscribers[hook].clear();
+
+            for (auto const& [key, script] : scripts)
+                if (!script->IsHookUnused(hook))
+                    _subscribers[hook].emplace_back(script.get());
+
+            _subscriberCount[hook].store(uint32(_subscribers[hook].size()), std::memory_order_relaxed);
+        }
+
+        for (auto const& [key, script] : scripts)
+            script->SetHookIndexed();
+
+        _compactNeeded = false;
+    }
+
+    // Called by script registry when a script is added
+    void Add(ScriptType* script)
+    {
+        for (std::size_t hook = 0; hook < HookCount; ++hook)
+        {
+            if (script->IsHookUnused(hook))
+                continue;
+
+            _subscribers[hook].emplace_back(script);
+            _subscriberCount[hook].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        script->SetHookIndexed();
+    }
+
+    // Called by default hook implementation of indexed script
+    void OnHookUnused(std::size_t hook)
+    {
+        _subscriberCount[hook].fetch_sub(1, std::memory_order_relaxed);
+        _compactNeeded.store(true, std::memory_order_relaxed);
+    }
+
+    void Compact()
+    {
+        if (!_compactNeeded.exchange(false, std::memory_order_relaxed))
+            return;
+
+        for (std::size_t hook = 0; hook < HookCount; ++hook)
+        {
+            auto& subscribers = _subscribers[hook];
+            subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), [hook](ScriptType* script) { return script->IsHookUnused(hook); }), subscribers.end());
+            _subscriberCount[hook].store(uint32(subscribers.size()), std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] bool HasSubscribers(std::size_t hook) const { return _subscriberCount[hook].load(std::memory_order_relaxed) != 0; }
+    [[nodiscard]] std::vector<ScriptType*> const& GetSubscribers(std::size_t hook) const { return _subscribers[hook]; }
+
+private:
+    std::array<std::vector<ScriptType*>, HookCount> _subscribers;
+    std::array<std::atomic<uint32>, HookCount> _subscriberCount{};
+    std::atomic<bool> _compactNeeded{ false };
+};
+
+// Script types without indexed hooks
+template<class ScriptType>
+class ScriptHookIndex<ScriptType, 0>
+{
+public:
+    template<class ScriptStore>
+    void Rebuild(ScriptStore const& /*scripts*/) { }
+
+    void Add(ScriptType* /*script*/) { }
+    void Compact() { }
+};
+
+#endif // WARHEAD_SCRIPT_HOOKS_H_
@@ -21,8 +21,8 @@
 #include "Optional.h"
 #include "ScriptRegistry.h"
 
-template<typename ScriptName>
-inline Optional<bool> IsValidBoolScript(std::function<bool(ScriptName*)> executeHook)
+template<typename ScriptName, typename Func>
+inline Optional<bool> IsValidBoolScript(Func&& executeHook)
 {
     if (ScriptRegistry<ScriptName>::Instance()->GetScripts().empty())
         return {};
@@ -34,8 +34,23 @@ inline Optional<bool> IsValidBoolScript(std::function<bool(ScriptName*)> execute
     return false;
 }
 
-template<typename ScriptName, class AI>
-inline AI* GetReturnAIScript(std::function<AI*(ScriptName*)> executeHook)
+// Calls only scripts which may override the hook, scripts of type without hook index must use the overload above
+template<typename ScriptName, typename Hook, typename Func>
+inline Optional<bool> IsValidBoolScript(Hook hook, Func&& executeHook)
+{
+    auto const& hooks = ScriptRegistry<ScriptName>::Instance()->GetHooks();
+    if (!hooks.HasSubscribers(hook))
+        return {};
+
+    for (ScriptName* script : hooks.GetSubscribers(hook))
+        if (!script->IsHookUnused(hook) && executeHook(script))
+            return true;
+
+    return false;
+}
+
+template<typename ScriptName, class AI, typename Func>
+inline AI* GetReturnAIScript(Func&& executeHook)
 {
     if (ScriptRegistry<ScriptName>::Instance()->GetScripts().empty())
         return nullptr;
@@ -47,8 +62,8 @@ inline AI* GetReturnAIScript(std::function<AI*(ScriptName*)> executeHook)
     return nullptr;
 }
 
-template<typename ScriptName>
-inline void ExecuteScript(std::function<void(ScriptName*)> executeHook)
+template<typename ScriptName, typename Func>
+inline void ExecuteScript(Func&& executeHook)
 {
     if (ScriptRegistry<ScriptName>::Instance()->GetScripts().empty())
         return;
@@ -57,6 +72,18 @@ inline void ExecuteScript(std::function<void(ScriptName*)> executeHook)
         executeHook(script.get());
 }
 
+template<typename ScriptName, typename Hook, typename Func>
+inline void ExecuteScript(Hook hook, Func&& executeHook)
+{
+    auto const& hooks = ScriptRegistry<ScriptName>::Instance()->GetHooks();
+    if (!hooks.HasSubscribers(hook))
+        return;
+
+    for (ScriptName* script : hooks.GetSubscribers(hook))
+        if (!script->IsHookUnused(hook))
+            executeHook(script);
+}
+
 inline bool ReturnValidBool(Optional<bool> ret, bool need = false)
 {
     return ret && *ret ? need : !need;
@@ -55,6 +55,23 @@ UnitScript::UnitScript(std::string_view name, bool addToScripts)
         ScriptRegistry<UnitScript>::Instance()->AddScript(this);
 }
 
+void UnitScript::SetHookUnused(UnitHook hook) const
+{
+    if (!MarkHookUnused(hook) || !IsHookIndexed())
+        return;
+
+    ScriptRegistry<UnitScript>::Instance()->GetHooks().OnHookUnused(hook);
+}
+
+void UnitScript::SetOverriddenHooks(std::bitset<UNITHOOK_END> const& hooks)
+{
+    ScriptHookMask::SetOverriddenHooks(hooks);
+
+    for (std::size_t hook = 0; hook < UNITHOOK_END; ++hook)
+        if (!hooks.test(hook))
+            SetHookUnused(UnitHook(hook));
+}
+
 MovementHandlerScript::MovementHandlerScript(std::string_view name)
     : ScriptObject(name)
 {
@@ -223,6 +240,23 @@ PlayerScript::PlayerScript(std::string_view name)
     ScriptRegistry<PlayerScript>::Instance()->AddScript(this);
 }
 
+void PlayerScript::SetHookUnused(PlayerHook hook) const
+{
+    if (!MarkHookUnused(hook) || !IsHookIndexed())
+        return;
+
+    ScriptRegistry<PlayerScript>::Instance()->GetHooks().OnHookUnused(hook);
+}
+
+void PlayerScript::SetOverriddenHooks(std::bitset<PLAYERHOOK_END> const& hooks)
+{
+    ScriptHookMask::SetOverriddenHooks(hooks);
+
+    for (std::size_t hook = 0; hook < PLAYERHOOK_END; ++hook)
+        if (!hooks.test(hook))
+            SetHookUnused(PlayerHook(hook));
+}
+
 AccountScript::AccountScript(std::string_view name)
     : ScriptObject(name)
 {
@@ -23,6 +23,7 @@
 #include "Duration.h"
 #include "LFG.h"
 #include "ObjectGuid.h"
+#include "ScriptHooks.h"
 #include "ScriptObjectFwd.h"
 #include "SharedDefines.h"
 #include "Tuples.h"
@@ -310,54 +311,60 @@ public:
     virtual void OnGossipSelectCode(Player* /*player*/, Item* /*item*/, uint32 /*sender*/, uint32 /*action*/, std::string_view /*code*/) { }
 };
 
-class WH_GAME_API UnitScript : public ScriptObject
+class WH_GAME_API UnitScript : public ScriptObject, public ScriptHookMask<UnitHook, UNITHOOK_END>
 {
 protected:
     UnitScript(std::string_view name, bool addToScripts = true);
 
+    // Unsubscribes script from a hook it doesn't override, scripts not created by RegisterHookedScript stay subscribed
+    void SetHookUnused(UnitHook hook) const;
+
 public:
+    // Called by RegisterHookedScript, hooks not set are marked unused right away
+    void SetOverriddenHooks(std::bitset<UNITHOOK_END> const& hooks);
+
     // Called when a unit deals healing to another unit
-    virtual void OnHeal(Unit* /*healer*/, Unit* /*reciever*/, uint32& /*gain*/) { }
+    virtual void OnHeal(Unit* /*healer*/, Unit* /*reciever*/, uint32& /*gain*/) { SetHookUnused(UNITHOOK_ON_HEAL); }
 
     // Called when a unit deals damage to another unit
-    virtual void OnDamage(Unit* /*attacker*/, Unit* /*victim*/, uint32& /*damage*/) { }
+    virtual void OnDamage(Unit* /*attacker*/, Unit* /*victim*/, uint32& /*damage*/) { SetHookUnused(UNITHOOK_ON_DAMAGE); }
 
     // Called when DoT's Tick Damage is being Dealt
     // Attacker can be nullptr if he is despawned while the aura still exists on target
-    virtual void ModifyPeriodicDamageAurasTick(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/, SpellInfo const* /*spellInfo*/) { }
+    virtual void ModifyPeriodicDamageAurasTick(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/, SpellInfo const* /*spellInfo*/) { SetHookUnused(UNITHOOK_MODIFY_PERIODIC_DAMAGE_AURAS_TICK); }
 
     // Called when Melee Damage is being Dealt
-    virtual void ModifyMeleeDamage(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/) { }
+    virtual void ModifyMeleeDamage(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/) { SetHookUnused(UNITHOOK_MODIFY_MELEE_DAMAGE); }
 
     // Called when Spell Damage is being Dealt
-    virtual void ModifySpellDamageTaken(Unit* /*target*/, Unit* /*attacker*/, int32& /*damage*/, SpellInfo const* /*spellInfo*/) { }
+    virtual void ModifySpellDamageTaken(Unit* /*target*/, Unit* /*attacker*/, int32& /*damage*/, SpellInfo const* /*spellInfo*/) { SetHookUnused(UNITHOOK_MODIFY_SPELL_DAMAGE_TAKEN); }
 
     // Called when Heal is Received
-    virtual void ModifyHealReceived(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/, SpellInfo const* /*spellInfo*/) { }
+    virtual void ModifyHealReceived(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/, SpellInfo const* /*spellInfo*/) { SetHookUnused(UNITHOOK_MODIFY_HEAL_RECEIVED); }
 
     //Called when Damage is Dealt
-    virtual uint32 DealDamage(Unit* /*AttackerUnit*/, Unit* /*pVictim*/, uint32 damage, DamageEffectType /*damagetype*/) { return damage; }
+    virtual uint32 DealDamage(Unit* /*AttackerUnit*/, Unit* /*pVictim*/, uint32 damage, DamageEffectType /*damagetype*/) { SetHookUnused(UNITHOOK_DEAL_DAMAGE); return damage; }
 
     virtual void OnBeforeRollMeleeOutcomeAgainst(Unit const* /*attacker*/, Unit const* /*victim*/, WeaponAttackType /*attType*/, int32& /*attackerMaxSkillValueForLevel*/,
-        int32& /*victimMaxSkillValueForLevel*/, int32& /*attackerWeaponSkill*/, int32& /*victimDefenseSkill*/, int32& /*crit_chance*/, int32& /*miss_chance*/, int32& /*dodge_chance*/, int32& /*parry_chance*/, int32& /*block_chance*/) { };
+        int32& /*victimMaxSkillValueForLevel*/, int32& /*attackerWeaponSkill*/, int32& /*victimDefenseSkill*/, int32& /*crit_chance*/, int32& /*miss_chance*/, int32& /*dodge_chance*/, int32& /*parry_chance*/, int32& /*block_chance*/) { SetHookUnused(UNITHOOK_ON_BEFORE_ROLL_MELEE_OUTCOME_AGAINST); };
 
-    virtual void OnAuraApply(Unit* /*unit*/, Aura* /*aura*/) { }
+    virtual void OnAuraApply(Unit* /*unit*/, Aura* /*aura*/) { SetHookUnused(UNITHOOK_ON_AURA_APPLY); }
 
-    virtual void OnAuraRemove(Unit* /*unit*/, AuraApplication* /*aurApp*/, AuraRemoveMode /*mode*/) { }
+    virtual void OnAuraRemove(Unit* /*unit*/, AuraApplication* /*aurApp*/, AuraRemoveMode /*mode*/) { SetHookUnused(UNITHOOK_ON_AURA_REMOVE); }
 
-    [[nodiscard]] virtual bool IfNormalReaction(Unit const* /*unit*/, Unit const* /*target*/, ReputationRank& /*repRank*/) { return true; }
+    [[nodiscard]] virtual bool IfNormalReaction(Unit const* /*unit*/, Unit const* /*target*/, ReputationRank& /*repRank*/) { SetHookUnused(UNITHOOK_IF_NORMAL_REACTION); return true; }
 
-    [[nodiscard]] virtual bool IsNeedModSpellDamagePercent(Unit const* /*unit*/, AuraEffect* /*auraEff*/, float& /*doneTotalMod*/, SpellInfo const* /*spellProto*/) { return true; }
+    [[nodiscard]] virtual bool IsNeedModSpellDamagePercent(Unit const* /*unit*/, AuraEffect* /*auraEff*/, float& /*doneTotalMod*/, SpellInfo const* /*spellProto*/) { SetHookUnused(UNITHOOK_IS_NEED_MOD_SPELL_DAMAGE_PERCENT); return true; }
 
-    [[nodiscard]] virtual bool IsNeedModMeleeDamagePercent(Unit const* /*unit*/, AuraEffect* /*auraEff*/, float& /*doneTotalMod*/, SpellInfo const* /*spellProto*/) { return true; }
+    [[nodiscard]] virtual bool IsNeedModMeleeDamagePercent(Unit const* /*unit*/, AuraEffect* /*auraEff*/, float& /*doneTotalMod*/, SpellInfo const* /*spellProto*/) { SetHookUnused(UNITHOOK_IS_NEED_MOD_MELEE_DAMAGE_PERCENT); return true; }
 
-    [[nodiscard]] virtual bool IsNeedModHealPercent(Unit const* /*unit*/, AuraEffect* /*auraEff*/, float& /*doneTotalMod*/, SpellInfo const* /*spellProto*/) { return true; }
+    [[nodiscard]] virtual bool IsNeedModHealPercent(Unit const* /*unit*/, AuraEffect* /*auraEff*/, float& /*doneTotalMod*/, SpellInfo const* /*spellProto*/) { SetHookUnused(UNITHOOK_IS_NEED_MOD_HEAL_PERCENT); return true; }
 
-    [[nodiscard]] virtual bool CanSetPhaseMask(Unit const* /*unit*/, uint32 /*newPhaseMask*/, bool /*update*/) { return true; }
+    [[nodiscard]] virtual bool CanSetPhaseMask(Unit const* /*unit*/, uint32 /*newPhaseMask*/, bool /*update*/) { SetHookUnused(UNITHOOK_CAN_SET_PHASE_MASK); return true; }
 
-    [[nodiscard]] virtual bool IsCustomBuildValuesUpdate(Unit const* /*unit*/, uint8 /*updateType*/, ByteBuffer* /*fieldBuffer*/, Player const* /*target*/, uint16 /*index*/) { return false; }
+    [[nodiscard]] virtual bool IsCustomBuildValuesUpdate(Unit const* /*unit*/, uint8 /*updateType*/, ByteBuffer* /*fieldBuffer*/, Player const* /*target*/, uint16 /*index*/) { SetHookUnused(UNITHOOK_IS_CUSTOM_BUILD_VALUES_UPDATE); return false; }
 
-    [[nodiscard]] virtual bool OnBuildValuesUpdate(Unit const* /*unit*/, uint8 /*updateType*/, ByteBuffer* /*fieldBuffer*/, Player* /*target*/, uint16 /*index*/) { return false; }
+    [[nodiscard]] virtual bool OnBuildValuesUpdate(Unit const* /*unit*/, uint8 /*updateType*/, ByteBuffer* /*fieldBuffer*/, Player* /*target*/, uint16 /*index*/) { SetHookUnused(UNITHOOK_ON_BUILD_VALUES_UPDATE); return false; }
 
     /**
      * @brief This hook runs in Unit::Update
@@ -365,12 +372,12 @@ public:
      * @param unit Contains information about the Unit
      * @param diff Contains information about the diff time
      */
-    virtual void OnUnitUpdate(Unit* /*unit*/, uint32 /*diff*/) { }
+    virtual void OnUnitUpdate(Unit* /*unit*/, uint32 /*diff*/) { SetHookUnused(UNITHOOK_ON_UNIT_UPDATE); }
 
-    virtual void OnDisplayIdChange(Unit* /*unit*/, uint32 /*displayId*/) { }
-    virtual void OnUnitEnterEvadeMode(Unit* /*unit*/, uint8 /*evadeReason*/) { }
-    virtual void OnUnitEnterCombat(Unit* /*unit*/, Unit* /*victim*/) { }
-    virtual void OnUnitDeath(Unit* /*unit*/, Unit* /*killer*/) { }
+    virtual void OnDisplayIdChange(Unit* /*unit*/, uint32 /*displayId*/) { SetHookUnused(UNITHOOK_ON_DISPLAY_ID_CHANGE); }
+    virtual void OnUnitEnterEvadeMode(Unit* /*unit*/, uint8 /*evadeReason*/) { SetHookUnused(UNITHOOK_ON_UNIT_ENTER_EVADE_MODE); }
+    virtual void OnUnitEnterCombat(Unit* /*unit*/, Unit* /*victim*/) { SetHookUnused(UNITHOOK_ON_UNIT_ENTER_COMBAT); }
+    virtual void OnUnitDeath(Unit* /*unit*/, Unit* /*killer*/) { SetHookUnused(UNITHOOK_ON_UNIT_DEATH); }
 };
 
 class WH_GAME_API MovementHandlerScript : public ScriptObject
@@ -889,296 +896,302 @@ public:
     [[nodiscard]] virtual bool OnCheck(Player* /*source*/, Unit* /*target*/, uint32 /*criteria_id*/) { return true; };
 };
 
-class WH_GAME_API PlayerScript : public ScriptObject
+class WH_GAME_API PlayerScript : public ScriptObject, public ScriptHookMask<PlayerHook, PLAYERHOOK_END>
 {
 protected:
     PlayerScript(std::string_view name);
 
+    // Unsubscribes script from a hook it doesn't override, scripts not created by RegisterHookedScript stay subscribed
+    void SetHookUnused(PlayerHook hook) const;
+
 public:
-    virtual void OnPlayerReleasedGhost(Player* /*player*/) { }
+    // Called by RegisterHookedScript, hooks not set are marked unused right away
+    void SetOverriddenHooks(std::bitset<PLAYERHOOK_END> const& hooks);
+
+    virtual void OnPlayerReleasedGhost(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_PLAYER_RELEASED_GHOST); }
 
     // Called on Send Initial Packets Before Add To Map
-    virtual void OnSendInitialPacketsBeforeAddToMap(Player* /*player*/, WorldPacket& /*data*/) {}
+    virtual void OnSendInitialPacketsBeforeAddToMap(Player* /*player*/, WorldPacket& /*data*/) { SetHookUnused(PLAYERHOOK_ON_SEND_INITIAL_PACKETS_BEFORE_ADD_TO_MAP); }
 
     // Called when a player does a desertion action (see BattlegroundDesertionType)
-    virtual void OnBattlegroundDesertion(Player* /*player*/, BattlegroundDesertionType const /*desertionType*/) { }
+    virtual void OnBattlegroundDesertion(Player* /*player*/, BattlegroundDesertionType const /*desertionType*/) { SetHookUnused(PLAYERHOOK_ON_BATTLEGROUND_DESERTION); }
 
     // Called when a player completes a quest
-    virtual void OnPlayerCompleteQuest(Player* /*player*/, Quest const* /*quest_id*/) { }
+    virtual void OnPlayerCompleteQuest(Player* /*player*/, Quest const* /*quest_id*/) { SetHookUnused(PLAYERHOOK_ON_PLAYER_COMPLETE_QUEST); }
 
     // Called when a player kills another player
-    virtual void OnPVPKill(Player* /*killer*/, Player* /*killed*/) { }
+    virtual void OnPVPKill(Player* /*killer*/, Player* /*killed*/) { SetHookUnused(PLAYERHOOK_ON_PVP_KILL); }
 
     // Called when a player toggles pvp
-    virtual void OnPlayerPVPFlagChange(Player* /*player*/, bool /*state*/) { }
+    virtual void OnPlayerPVPFlagChange(Player* /*player*/, bool /*state*/) { SetHookUnused(PLAYERHOOK_ON_PLAYER_PVP_FLAG_CHANGE); }
 
     // Called when a player kills a creature
-    virtual void OnCreatureKill(Player* /*killer*/, Creature* /*killed*/) { }
+    virtual void OnCreatureKill(Player* /*killer*/, Creature* /*killed*/) { SetHookUnused(PLAYERHOOK_ON_CREATURE_KILL); }
 
     // Called when a player's pet kills a creature
-    virtual void OnCreatureKilledByPet(Player* /*PetOwner*/, Creature* /*killed*/) { }
+    virtual void OnCreatureKilledByPet(Player* /*PetOwner*/, Creature* /*killed*/) { SetHookUnused(PLAYERHOOK_ON_CREATURE_KILLED_BY_PET); }
 
     // Called when a player is killed by a creature
-    virtual void OnPlayerKilledByCreature(Creature* /*killer*/, Player* /*killed*/) { }
+    virtual void OnPlayerKilledByCreature(Creature* /*killer*/, Player* /*killed*/) { SetHookUnused(PLAYERHOOK_ON_PLAYER_KILLED_BY_CREATURE); }
 
     // Called when a player's level changes (right after the level is applied)
-    virtual void OnLevelChanged(Player* /*player*/, uint8 /*oldlevel*/) { }
+    virtual void OnLevelChanged(Player* /*player*/, uint8 /*oldlevel*/) { SetHookUnused(PLAYERHOOK_ON_LEVEL_CHANGED); }
 
     // Called when a player's free talent points change (right before the change is applied)
-    virtual void OnFreeTalentPointsChanged(Player* /*player*/, uint32 /*points*/) { }
+    virtual void OnFreeTalentPointsChanged(Player* /*player*/, uint32 /*points*/) { SetHookUnused(PLAYERHOOK_ON_FREE_TALENT_POINTS_CHANGED); }
 
     // Called when a player's talent points are reset (right before the reset is done)
-    virtual void OnTalentsReset(Player* /*player*/, bool /*noCost*/) { }
+    virtual void OnTalentsReset(Player* /*player*/, bool /*noCost*/) { SetHookUnused(PLAYERHOOK_ON_TALENTS_RESET); }
 
     // Called for player::update
-    virtual void OnBeforeUpdate(Player* /*player*/, uint32 /*p_time*/) { }
-    virtual void OnUpdate(Player* /*player*/, uint32 /*p_time*/) { }
+    virtual void OnBeforeUpdate(Player* /*player*/, uint32 /*p_time*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_UPDATE); }
+    virtual void OnUpdate(Player* /*player*/, uint32 /*p_time*/) { SetHookUnused(PLAYERHOOK_ON_UPDATE); }
 
     // Called when a player's money is modified (before the modification is done)
-    virtual void OnMoneyChanged(Player* /*player*/, int32& /*amount*/) { }
+    virtual void OnMoneyChanged(Player* /*player*/, int32& /*amount*/) { SetHookUnused(PLAYERHOOK_ON_MONEY_CHANGED); }
 
     // Called before looted money is added to a player
-    virtual void OnBeforeLootMoney(Player* /*player*/, Loot* /*loot*/) { }
+    virtual void OnBeforeLootMoney(Player* /*player*/, Loot* /*loot*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_LOOT_MONEY); }
 
     // Called when a player gains XP (before anything is given)
-    virtual void OnGiveXP(Player* /*player*/, uint32& /*amount*/, Unit* /*victim*/, uint8 /*xpSource*/) { }
+    virtual void OnGiveXP(Player* /*player*/, uint32& /*amount*/, Unit* /*victim*/, uint8 /*xpSource*/) { SetHookUnused(PLAYERHOOK_ON_GIVE_XP); }
 
     // Called when a player's reputation changes (before it is actually changed)
-    virtual bool OnReputationChange(Player* /*player*/, uint32 /*factionID*/, int32& /*standing*/, bool /*incremental*/) { return true; }
+    virtual bool OnReputationChange(Player* /*player*/, uint32 /*factionID*/, int32& /*standing*/, bool /*incremental*/) { SetHookUnused(PLAYERHOOK_ON_REPUTATION_CHANGE); return true; }
 
     // Called when a player's reputation rank changes (before it is actually changed)
-    virtual void OnReputationRankChange(Player* /*player*/, uint32 /*factionID*/, ReputationRank /*newRank*/, ReputationRank /*olRank*/, bool /*increased*/) { }
+    virtual void OnReputationRankChange(Player* /*player*/, uint32 /*factionID*/, ReputationRank /*newRank*/, ReputationRank /*olRank*/, bool /*increased*/) { SetHookUnused(PLAYERHOOK_ON_REPUTATION_RANK_CHANGE); }
 
     // Called when a player learned new spell
-    virtual void OnLearnSpell(Player* /*player*/, uint32 /*spellID*/) {}
+    virtual void OnLearnSpell(Player* /*player*/, uint32 /*spellID*/) { SetHookUnused(PLAYERHOOK_ON_LEARN_SPELL); }
 
     // Called when a player forgot spell
-    virtual void OnForgotSpell(Player* /*player*/, uint32 /*spellID*/) {}
+    virtual void OnForgotSpell(Player* /*player*/, uint32 /*spellID*/) { SetHookUnused(PLAYERHOOK_ON_FORGOT_SPELL); }
 
     // Called when a duel is requested
-    virtual void OnDuelRequest(Player* /*target*/, Player* /*challenger*/) { }
+    virtual void OnDuelRequest(Player* /*target*/, Player* /*challenger*/) { SetHookUnused(PLAYERHOOK_ON_DUEL_REQUEST); }
 
     // Called when a duel starts (after 3s countdown)
-    virtual void OnDuelStart(Player* /*player1*/, Player* /*player2*/) { }
+    virtual void OnDuelStart(Player* /*player1*/, Player* /*player2*/) { SetHookUnused(PLAYERHOOK_ON_DUEL_START); }
 
     // Called when a duel ends
-    virtual void OnDuelEnd(Player* /*winner*/, Player* /*loser*/, DuelCompleteType /*type*/) { }
+    virtual void OnDuelEnd(Player* /*winner*/, Player* /*loser*/, DuelCompleteType /*type*/) { SetHookUnused(PLAYERHOOK_ON_DUEL_END); }
 
     // The following methods are called when a player sends a chat message.
-    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/) { }
+    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/) { SetHookUnused(PLAYERHOOK_ON_CHAT); }
 
-    virtual void OnBeforeSendChatMessage(Player* /*player*/, uint32& /*type*/, uint32& /*lang*/, std::string& /*msg*/) { }
+    virtual void OnBeforeSendChatMessage(Player* /*player*/, uint32& /*type*/, uint32& /*lang*/, std::string& /*msg*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_SEND_CHAT_MESSAGE); }
 
-    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Player* /*receiver*/) { }
+    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Player* /*receiver*/) { SetHookUnused(PLAYERHOOK_ON_CHAT_RECEIVER); }
 
-    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Group* /*group*/) { }
+    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Group* /*group*/) { SetHookUnused(PLAYERHOOK_ON_CHAT_GROUP); }
 
-    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Guild* /*guild*/) { }
+    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Guild* /*guild*/) { SetHookUnused(PLAYERHOOK_ON_CHAT_GUILD); }
 
-    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Channel* /*channel*/) { }
+    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Channel* /*channel*/) { SetHookUnused(PLAYERHOOK_ON_CHAT_CHANNEL); }
 
     // Both of the below are called on emote opcodes.
-    virtual void OnEmote(Player* /*player*/, uint32 /*emote*/) { }
+    virtual void OnEmote(Player* /*player*/, uint32 /*emote*/) { SetHookUnused(PLAYERHOOK_ON_EMOTE); }
 
-    virtual void OnTextEmote(Player* /*player*/, uint32 /*textEmote*/, uint32 /*emoteNum*/, ObjectGuid /*guid*/) { }
+    virtual void OnTextEmote(Player* /*player*/, uint32 /*textEmote*/, uint32 /*emoteNum*/, ObjectGuid /*guid*/) { SetHookUnused(PLAYERHOOK_ON_TEXT_EMOTE); }
 
     // Called in Spell::Cast.
-    virtual void OnSpellCast(Player* /*player*/, Spell* /*spell*/, bool /*skipCheck*/) { }
+    virtual void OnSpellCast(Player* /*player*/, Spell* /*spell*/, bool /*skipCheck*/) { SetHookUnused(PLAYERHOOK_ON_SPELL_CAST); }
 
     // Called during data loading
-    virtual void OnLoadFromDB(Player* /*player*/) { };
+    virtual void OnLoadFromDB(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_LOAD_FROM_DB); };
 
     // Called when a player logs in.
-    virtual void OnLogin(Player* /*player*/) { }
+    virtual void OnLogin(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_LOGIN); }
 
     // Called when a player logs out.
-    virtual void OnLogout(Player* /*player*/) { }
+    virtual void OnLogout(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_LOGOUT); }
 
     // Called when a player is created.
-    virtual void OnCreate(Player* /*player*/) { }
+    virtual void OnCreate(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_CREATE); }
 
     // Called when a player is deleted.
-    virtual void OnDelete(ObjectGuid /*guid*/, uint32 /*accountId*/) { }
+    virtual void OnDelete(ObjectGuid /*guid*/, uint32 /*accountId*/) { SetHookUnused(PLAYERHOOK_ON_DELETE); }
 
     // Called when a player delete failed.
-    virtual void OnFailedDelete(ObjectGuid /*guid*/, uint32 /*accountId*/) { }
+    virtual void OnFailedDelete(ObjectGuid /*guid*/, uint32 /*accountId*/) { SetHookUnused(PLAYERHOOK_ON_FAILED_DELETE); }
 
     // Called when a player is about to be saved.
-    virtual void OnSave(Player* /*player*/) { }
+    virtual void OnSave(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_SAVE); }
 
     // Called when a player is bound to an instance
-    virtual void OnBindToInstance(Player* /*player*/, Difficulty /*difficulty*/, uint32 /*mapId*/, bool /*permanent*/) { }
+    virtual void OnBindToInstance(Player* /*player*/, Difficulty /*difficulty*/, uint32 /*mapId*/, bool /*permanent*/) { SetHookUnused(PLAYERHOOK_ON_BIND_TO_INSTANCE); }
 
     // Called when a player switches to a new zone
-    virtual void OnUpdateZone(Player* /*player*/, uint32 /*newZone*/, uint32 /*newArea*/) { }
+    virtual void OnUpdateZone(Player* /*player*/, uint32 /*newZone*/, uint32 /*newArea*/) { SetHookUnused(PLAYERHOOK_ON_UPDATE_ZONE); }
 
     // Called when a player switches to a new area (more accurate than UpdateZone)
-    virtual void OnUpdateArea(Player* /*player*/, uint32 /*oldArea*/, uint32 /*newArea*/) { }
+    virtual void OnUpdateArea(Player* /*player*/, uint32 /*oldArea*/, uint32 /*newArea*/) { SetHookUnused(PLAYERHOOK_ON_UPDATE_AREA); }
 
     // Called when a player changes to a new map (after moving to new map)
-    virtual void OnMapChanged(Player* /*player*/) { }
+    virtual void OnMapChanged(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_MAP_CHANGED); }
 
     // Called before a player is being teleported to new coords
-    [[nodiscard]] virtual bool OnBeforeTeleport(Player* /*player*/, uint32 /*mapid*/, float /*x*/, float /*y*/, float /*z*/, float /*orientation*/, uint32 /*options*/, Unit* /*target*/) { return true; }
+    [[nodiscard]] virtual bool OnBeforeTeleport(Player* /*player*/, uint32 /*mapid*/, float /*x*/, float /*y*/, float /*z*/, float /*orientation*/, uint32 /*options*/, Unit* /*target*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_TELEPORT); return true; }
 
     // Called when team/faction is set on player
-    virtual void OnUpdateFaction(Player* /*player*/) { }
+    virtual void OnUpdateFaction(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_UPDATE_FACTION); }
 
     // Called when a player is added to battleground
-    virtual void OnAddToBattleground(Player* /*player*/, Battleground* /*bg*/) { }
+    virtual void OnAddToBattleground(Player* /*player*/, Battleground* /*bg*/) { SetHookUnused(PLAYERHOOK_ON_ADD_TO_BATTLEGROUND); }
 
     // Called when a player queues a Random Dungeon using the RDF (Random Dungeon Finder)
-    virtual void OnQueueRandomDungeon(Player* /*player*/, uint32& /*rDungeonId*/) { }
+    virtual void OnQueueRandomDungeon(Player* /*player*/, uint32& /*rDungeonId*/) { SetHookUnused(PLAYERHOOK_ON_QUEUE_RANDOM_DUNGEON); }
 
     // Called when a player is removed from battleground
-    virtual void OnRemoveFromBattleground(Player* /*player*/, Battleground* /*bg*/) { }
+    virtual void OnRemoveFromBattleground(Player* /*player*/, Battleground* /*bg*/) { SetHookUnused(PLAYERHOOK_ON_REMOVE_FROM_BATTLEGROUND); }
 
     // Called when a player complete an achievement
-    virtual void OnAchiComplete(Player* /*player*/, AchievementEntry const* /*achievement*/) { }
+    virtual void OnAchiComplete(Player* /*player*/, AchievementEntry const* /*achievement*/) { SetHookUnused(PLAYERHOOK_ON_ACHI_COMPLETE); }
 
     // Called before player complete an achievement, can be used to disable achievements in certain conditions
-    virtual bool OnBeforeAchiComplete(Player* /*player*/, AchievementEntry const* /*achievement*/) { return true; }
+    virtual bool OnBeforeAchiComplete(Player* /*player*/, AchievementEntry const* /*achievement*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_ACHI_COMPLETE); return true; }
 
     // Called when a player complete an achievement criteria
-    virtual void OnCriteriaProgress(Player* /*player*/, AchievementCriteriaEntry const* /*criteria*/) { }
+    virtual void OnCriteriaProgress(Player* /*player*/, AchievementCriteriaEntry const* /*criteria*/) { SetHookUnused(PLAYERHOOK_ON_CRITERIA_PROGRESS); }
 
     //  Called before player complete an achievement criteria, can be used to disable achievement criteria in certain conditions
-    virtual bool OnBeforeCriteriaProgress(Player* /*player*/, AchievementCriteriaEntry const* /*criteria*/) { return true; }
+    virtual bool OnBeforeCriteriaProgress(Player* /*player*/, AchievementCriteriaEntry const* /*criteria*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_CRITERIA_PROGRESS); return true; }
 
     // Called when an Achievement is saved to DB
-    virtual void OnAchiSave(CharacterDatabaseTransaction /*trans*/, Player* /*player*/, uint16 /*achId*/, CompletedAchievementData const* /*achiData*/) { }
+    virtual void OnAchiSave(CharacterDatabaseTransaction /*trans*/, Player* /*player*/, uint16 /*achId*/, CompletedAchievementData const* /*achiData*/) { SetHookUnused(PLAYERHOOK_ON_ACHI_SAVE); }
 
     // Called when an Criteria is saved to DB
-    virtual void OnCriteriaSave(CharacterDatabaseTransaction /*trans*/, Player* /*player*/, uint16 /*achId*/, CriteriaProgress const* /*criteriaData*/) { }
+    virtual void OnCriteriaSave(CharacterDatabaseTransaction /*trans*/, Player* /*player*/, uint16 /*achId*/, CriteriaProgress const* /*criteriaData*/) { SetHookUnused(PLAYERHOOK_ON_CRITERIA_SAVE); }
 
     // Called when a player selects an option in a player gossip window
-    virtual void OnGossipSelect(Player* /*player*/, uint32 /*menu_id*/, uint32 /*sender*/, uint32 /*action*/) { }
+    virtual void OnGossipSelect(Player* /*player*/, uint32 /*menu_id*/, uint32 /*sender*/, uint32 /*action*/) { SetHookUnused(PLAYERHOOK_ON_GOSSIP_SELECT); }
 
     // Called when a player selects an option in a player gossip window
-    virtual void OnGossipSelectCode(Player* /*player*/, uint32 /*menu_id*/, uint32 /*sender*/, uint32 /*action*/, std::string_view /*code*/) { }
+    virtual void OnGossipSelectCode(Player* /*player*/, uint32 /*menu_id*/, uint32 /*sender*/, uint32 /*action*/, std::string_view /*code*/) { SetHookUnused(PLAYERHOOK_ON_GOSSIP_SELECT_CODE); }
 
     // On player getting charmed
-    virtual void OnBeingCharmed(Player* /*player*/, Unit* /*charmer*/, uint32 /*oldFactionId*/, uint32 /*newFactionId*/) { }
+    virtual void OnBeingCharmed(Player* /*player*/, Unit* /*charmer*/, uint32 /*oldFactionId*/, uint32 /*newFactionId*/) { SetHookUnused(PLAYERHOOK_ON_BEING_CHARMED); }
 
     // To change behaviour of set visible item slot
-    virtual void OnAfterSetVisibleItemSlot(Player* /*player*/, uint8 /*slot*/, Item* /*item*/) { }
+    virtual void OnAfterSetVisibleItemSlot(Player* /*player*/, uint8 /*slot*/, Item* /*item*/) { SetHookUnused(PLAYERHOOK_ON_AFTER_SET_VISIBLE_ITEM_SLOT); }
 
     // After an item has been moved from inventory
-    virtual void OnAfterMoveItemFromInventory(Player* /*player*/, Item* /*it*/, uint8 /*bag*/, uint8 /*slot*/, bool /*update*/) { }
+    virtual void OnAfterMoveItemFromInventory(Player* /*player*/, Item* /*it*/, uint8 /*bag*/, uint8 /*slot*/, bool /*update*/) { SetHookUnused(PLAYERHOOK_ON_AFTER_MOVE_ITEM_FROM_INVENTORY); }
 
     // After an item has been equipped
-    virtual void OnEquip(Player* /*player*/, Item* /*it*/, uint8 /*bag*/, uint8 /*slot*/, bool /*update*/) { }
+    virtual void OnEquip(Player* /*player*/, Item* /*it*/, uint8 /*bag*/, uint8 /*slot*/, bool /*update*/) { SetHookUnused(PLAYERHOOK_ON_EQUIP); }
 
     // After player enters queue for BG
-    virtual void OnPlayerJoinBG(Player* /*player*/) { }
+    virtual void OnPlayerJoinBG(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_PLAYER_JOIN_BG); }
 
     // After player enters queue for Arena
-    virtual void OnPlayerJoinArena(Player* /*player*/) { }
+    virtual void OnPlayerJoinArena(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_PLAYER_JOIN_ARENA); }
 
     //Called when trying to get a team ID of a slot > 2 (This is for custom teams created by modules)
-    virtual void GetCustomGetArenaTeamId(Player const* /*player*/, uint8 /*slot*/, uint32& /*teamID*/) const { }
+    virtual void GetCustomGetArenaTeamId(Player const* /*player*/, uint8 /*slot*/, uint32& /*teamID*/) const { SetHookUnused(PLAYERHOOK_GET_CUSTOM_GET_ARENA_TEAM_ID); }
 
     //Called when trying to get players personal rating of an arena slot > 2 (This is for custom teams created by modules)
-    virtual void GetCustomArenaPersonalRating(Player const* /*player*/, uint8 /*slot*/, uint32& /*rating*/) const { }
+    virtual void GetCustomArenaPersonalRating(Player const* /*player*/, uint8 /*slot*/, uint32& /*rating*/) const { SetHookUnused(PLAYERHOOK_GET_CUSTOM_ARENA_PERSONAL_RATING); }
 
     //Called after the normal slots (0..2) for arena have been evaluated so that custom arena teams could modify it if nececasry
-    virtual void OnGetMaxPersonalArenaRatingRequirement(Player const* /*player*/, uint32 /*minSlot*/, uint32& /*maxArenaRating*/) const {}
+    virtual void OnGetMaxPersonalArenaRatingRequirement(Player const* /*player*/, uint32 /*minSlot*/, uint32& /*maxArenaRating*/) const { SetHookUnused(PLAYERHOOK_ON_GET_MAX_PERSONAL_ARENA_RATING_REQUIREMENT); }
 
     //After looting item
-    virtual void OnLootItem(Player* /*player*/, Item* /*item*/, uint32 /*count*/, ObjectGuid /*lootguid*/) { }
+    virtual void OnLootItem(Player* /*player*/, Item* /*item*/, uint32 /*count*/, ObjectGuid /*lootguid*/) { SetHookUnused(PLAYERHOOK_ON_LOOT_ITEM); }
 
     //Before looting item
-    virtual void OnBeforeFillQuestLootItem(Player* /*player*/, LootItem& /*item*/) { }
+    virtual void OnBeforeFillQuestLootItem(Player* /*player*/, LootItem& /*item*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_FILL_QUEST_LOOT_ITEM); }
 
     //After looting item (includes master loot).
-    virtual void OnStoreNewItem(Player* /*player*/, Item* /*item*/, uint32 /*count*/) { }
+    virtual void OnStoreNewItem(Player* /*player*/, Item* /*item*/, uint32 /*count*/) { SetHookUnused(PLAYERHOOK_ON_STORE_NEW_ITEM); }
 
     //After creating item (eg profession item creation)
-    virtual void OnCreateItem(Player* /*player*/, Item* /*item*/, uint32 /*count*/) { }
+    virtual void OnCreateItem(Player* /*player*/, Item* /*item*/, uint32 /*count*/) { SetHookUnused(PLAYERHOOK_ON_CREATE_ITEM); }
 
     // After receiving item as a quest reward
-    virtual void OnQuestRewardItem(Player* /*player*/, Item* /*item*/, uint32 /*count*/) { }
+    virtual void OnQuestRewardItem(Player* /*player*/, Item* /*item*/, uint32 /*count*/) { SetHookUnused(PLAYERHOOK_ON_QUEST_REWARD_ITEM); }
 
     // When placing a bid or buying out an auction
-    [[nodiscard]] virtual bool CanPlaceAuctionBid(Player* /*player*/, AuctionEntry* /*auction*/) { return true; }
+    [[nodiscard]] virtual bool CanPlaceAuctionBid(Player* /*player*/, AuctionEntry* /*auction*/) { SetHookUnused(PLAYERHOOK_CAN_PLACE_AUCTION_BID); return true; }
 
     // After receiving item as a group roll reward
-    virtual void OnGroupRollRewardItem(Player* /*player*/, Item* /*item*/, uint32 /*count*/, RollVote /*voteType*/, Roll* /*roll*/) { }
+    virtual void OnGroupRollRewardItem(Player* /*player*/, Item* /*item*/, uint32 /*count*/, RollVote /*voteType*/, Roll* /*roll*/) { SetHookUnused(PLAYERHOOK_ON_GROUP_ROLL_REWARD_ITEM); }
 
     //Before opening an item
-    [[nodiscard]] virtual bool OnBeforeOpenItem(Player* /*player*/, Item* /*item*/) { return true; }
+    [[nodiscard]] virtual bool OnBeforeOpenItem(Player* /*player*/, Item* /*item*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_OPEN_ITEM); return true; }
 
     // After completed a quest
-    [[nodiscard]] virtual bool OnBeforeQuestComplete(Player* /*player*/, uint32 /*quest_id*/) { return true; }
+    [[nodiscard]] virtual bool OnBeforeQuestComplete(Player* /*player*/, uint32 /*quest_id*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_QUEST_COMPLETE); return true; }
 
     // Called after computing the XP reward value for a quest
-    virtual void OnQuestComputeXP(Player* /*player*/, Quest const* /*quest*/, uint32& /*xpValue*/) { }
+    virtual void OnQuestComputeXP(Player* /*player*/, Quest const* /*quest*/, uint32& /*xpValue*/) { SetHookUnused(PLAYERHOOK_ON_QUEST_COMPUTE_XP); }
 
     // Before durability repair action, you can even modify the discount value
-    virtual void OnBeforeDurabilityRepair(Player* /*player*/, ObjectGuid /*npcGUID*/, ObjectGuid /*itemGUID*/, float&/*discountMod*/, uint8 /*guildBank*/) { }
+    virtual void OnBeforeDurabilityRepair(Player* /*player*/, ObjectGuid /*npcGUID*/, ObjectGuid /*itemGUID*/, float&/*discountMod*/, uint8 /*guildBank*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_DURABILITY_REPAIR); }
 
     //Before buying something from any vendor
-    virtual void OnBeforeBuyItemFromVendor(Player* /*player*/, ObjectGuid /*vendorguid*/, uint32 /*vendorslot*/, uint32& /*item*/, uint8 /*count*/, uint8 /*bag*/, uint8 /*slot*/) { };
+    virtual void OnBeforeBuyItemFromVendor(Player* /*player*/, ObjectGuid /*vendorguid*/, uint32 /*vendorslot*/, uint32& /*item*/, uint8 /*count*/, uint8 /*bag*/, uint8 /*slot*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_BUY_ITEM_FROM_VENDOR); };
 
     //Before buying something from any vendor
-    virtual void OnBeforeStoreOrEquipNewItem(Player* /*player*/, uint32 /*vendorslot*/, uint32& /*item*/, uint8 /*count*/, uint8 /*bag*/, uint8 /*slot*/, ItemTemplate const* /*pProto*/, Creature* /*pVendor*/, VendorItem const* /*crItem*/, bool /*bStore*/) { };
+    virtual void OnBeforeStoreOrEquipNewItem(Player* /*player*/, uint32 /*vendorslot*/, uint32& /*item*/, uint8 /*count*/, uint8 /*bag*/, uint8 /*slot*/, ItemTemplate const* /*pProto*/, Creature* /*pVendor*/, VendorItem const* /*crItem*/, bool /*bStore*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_STORE_OR_EQUIP_NEW_ITEM); };
 
     //After buying something from any vendor
-    virtual void OnAfterStoreOrEquipNewItem(Player* /*player*/, uint32 /*vendorslot*/, Item* /*item*/, uint8 /*count*/, uint8 /*bag*/, uint8 /*slot*/, ItemTemplate const* /*pProto*/, Creature* /*pVendor*/, VendorItem const* /*crItem*/, bool /*bStore*/) { };
+    virtual void OnAfterStoreOrEquipNewItem(Player* /*player*/, uint32 /*vendorslot*/, Item* /*item*/, uint8 /*count*/, uint8 /*bag*/, uint8 /*slot*/, ItemTemplate const* /*pProto*/, Creature* /*pVendor*/, VendorItem const* /*crItem*/, bool /*bStore*/) { SetHookUnused(PLAYERHOOK_ON_AFTER_STORE_OR_EQUIP_NEW_ITEM); };
 
-    virtual void OnAfterUpdateMaxPower(Player* /*player*/, Powers& /*power*/, float& /*value*/) { }
+    virtual void OnAfterUpdateMaxPower(Player* /*player*/, Powers& /*power*/, float& /*value*/) { SetHookUnused(PLAYERHOOK_ON_AFTER_UPDATE_MAX_POWER); }
 
-    virtual void OnAfterUpdateMaxHealth(Player* /*player*/, float& /*value*/) { }
+    virtual void OnAfterUpdateMaxHealth(Player* /*player*/, float& /*value*/) { SetHookUnused(PLAYERHOOK_ON_AFTER_UPDATE_MAX_HEALTH); }
 
-    virtual void OnBeforeUpdateAttackPowerAndDamage(Player* /*player*/, float& /*level*/, float& /*val2*/, bool /*ranged*/) { }
-    virtual void OnAfterUpdateAttackPowerAndDamage(Player* /*player*/, float& /*level*/, float& /*base_attPower*/, float& /*attPowerMod*/, float& /*attPowerMultiplier*/, bool /*ranged*/) { }
+    virtual void OnBeforeUpdateAttackPowerAndDamage(Player* /*player*/, float& /*level*/, float& /*val2*/, bool /*ranged*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_UPDATE_ATTACK_POWER_AND_DAMAGE); }
+    virtual void OnAfterUpdateAttackPowerAndDamage(Player* /*player*/, float& /*level*/, float& /*base_attPower*/, float& /*attPowerMod*/, float& /*attPowerMultiplier*/, bool /*ranged*/) { SetHookUnused(PLAYERHOOK_ON_AFTER_UPDATE_ATTACK_POWER_AND_DAMAGE); }
 
-    virtual void OnBeforeInitTalentForLevel(Player* /*player*/, uint8& /*level*/, uint32& /*talentPointsForLevel*/) { }
+    virtual void OnBeforeInitTalentForLevel(Player* /*player*/, uint8& /*level*/, uint32& /*talentPointsForLevel*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_INIT_TALENT_FOR_LEVEL); }
 
-    virtual void OnFirstLogin(Player* /*player*/) { }
+    virtual void OnFirstLogin(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_FIRST_LOGIN); }
 
-    virtual void OnSetMaxLevel(Player* /*player*/, uint32& /*maxPlayerLevel*/) { }
+    virtual void OnSetMaxLevel(Player* /*player*/, uint32& /*maxPlayerLevel*/) { SetHookUnused(PLAYERHOOK_ON_SET_MAX_LEVEL); }
 
-    [[nodiscard]] virtual bool CanJoinInBattlegroundQueue(Player* /*player*/, ObjectGuid /*BattlemasterGuid*/, BattlegroundTypeId /*BGTypeID*/, uint8 /*joinAsGroup*/, GroupJoinBattlegroundResult& /*err*/) { return true; }
-    virtual bool ShouldBeRewardedWithMoneyInsteadOfExp(Player* /*player*/) { return false; }
+    [[nodiscard]] virtual bool CanJoinInBattlegroundQueue(Player* /*player*/, ObjectGuid /*BattlemasterGuid*/, BattlegroundTypeId /*BGTypeID*/, uint8 /*joinAsGroup*/, GroupJoinBattlegroundResult& /*err*/) { SetHookUnused(PLAYERHOOK_CAN_JOIN_IN_BATTLEGROUND_QUEUE); return true; }
+    virtual bool ShouldBeRewardedWithMoneyInsteadOfExp(Player* /*player*/) { SetHookUnused(PLAYERHOOK_SHOULD_BE_REWARDED_WITH_MONEY_INSTEAD_OF_EXP); return false; }
 
     // Called before the player's temporary summoned creature has initialized it's stats
-    virtual void OnBeforeTempSummonInitStats(Player* /*player*/, TempSummon* /*tempSummon*/, uint32& /*duration*/) { }
+    virtual void OnBeforeTempSummonInitStats(Player* /*player*/, TempSummon* /*tempSummon*/, uint32& /*duration*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_TEMP_SUMMON_INIT_STATS); }
 
     // Called before the player's guardian / pet has initialized it's stats for the player's level
-    virtual void OnBeforeGuardianInitStatsForLevel(Player* /*player*/, Guardian* /*guardian*/, CreatureTemplate const* /*cinfo*/, PetType& /*petType*/) { }
+    virtual void OnBeforeGuardianInitStatsForLevel(Player* /*player*/, Guardian* /*guardian*/, CreatureTemplate const* /*cinfo*/, PetType& /*petType*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_GUARDIAN_INIT_STATS_FOR_LEVEL); }
 
     // Called after the player's guardian / pet has initialized it's stats for the player's level
-    virtual void OnAfterGuardianInitStatsForLevel(Player* /*player*/, Guardian* /*guardian*/) { }
+    virtual void OnAfterGuardianInitStatsForLevel(Player* /*player*/, Guardian* /*guardian*/) { SetHookUnused(PLAYERHOOK_ON_AFTER_GUARDIAN_INIT_STATS_FOR_LEVEL); }
 
     // Called before loading a player's pet from the DB
-    virtual void OnBeforeLoadPetFromDB(Player* /*player*/, uint32& /*petentry*/, uint32& /*petnumber*/, bool& /*current*/, bool& /*forceLoadFromDB*/) { }
+    virtual void OnBeforeLoadPetFromDB(Player* /*player*/, uint32& /*petentry*/, uint32& /*petnumber*/, bool& /*current*/, bool& /*forceLoadFromDB*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_LOAD_PET_FROM_DB); }
 
-    [[nodiscard]] virtual bool CanJoinInArenaQueue(Player* /*player*/, ObjectGuid /*BattlemasterGuid*/, uint8 /*arenaslot*/, BattlegroundTypeId /*BGTypeID*/, uint8 /*joinAsGroup*/, uint8 /*IsRated*/, GroupJoinBattlegroundResult& /*err*/) { return true; }
+    [[nodiscard]] virtual bool CanJoinInArenaQueue(Player* /*player*/, ObjectGuid /*BattlemasterGuid*/, uint8 /*arenaslot*/, BattlegroundTypeId /*BGTypeID*/, uint8 /*joinAsGroup*/, uint8 /*IsRated*/, GroupJoinBattlegroundResult& /*err*/) { SetHookUnused(PLAYERHOOK_CAN_JOIN_IN_ARENA_QUEUE); return true; }
 
-    [[nodiscard]] virtual bool CanBattleFieldPort(Player* /*player*/, uint8 /*arenaType*/, BattlegroundTypeId /*BGTypeID*/, uint8 /*action*/) { return true; }
+    [[nodiscard]] virtual bool CanBattleFieldPort(Player* /*player*/, uint8 /*arenaType*/, BattlegroundTypeId /*BGTypeID*/, uint8 /*action*/) { SetHookUnused(PLAYERHOOK_CAN_BATTLE_FIELD_PORT); return true; }
 
-    [[nodiscard]] virtual bool CanGroupInvite(Player* /*player*/, std::string& /*membername*/) { return true; }
+    [[nodiscard]] virtual bool CanGroupInvite(Player* /*player*/, std::string& /*membername*/) { SetHookUnused(PLAYERHOOK_CAN_GROUP_INVITE); return true; }
 
-    [[nodiscard]] virtual bool CanGroupAccept(Player* /*player*/, Group* /*group*/) { return true; }
+    [[nodiscard]] virtual bool CanGroupAccept(Player* /*player*/, Group* /*group*/) { SetHookUnused(PLAYERHOOK_CAN_GROUP_ACCEPT); return true; }
 
-    [[nodiscard]] virtual bool CanSellItem(Player* /*player*/, Item* /*item*/, Creature* /*creature*/) { return true; }
+    [[nodiscard]] virtual bool CanSellItem(Player* /*player*/, Item* /*item*/, Creature* /*creature*/) { SetHookUnused(PLAYERHOOK_CAN_SELL_ITEM); return true; }
 
-    [[nodiscard]] virtual bool CanSendMail(Player* /*player*/, ObjectGuid /*receiverGuid*/, ObjectGuid /*mailbox*/, std::string& /*subject*/, std::string& /*body*/, uint32 /*money*/, uint32 /*COD*/, Item* /*item*/) { return true; }
+    [[nodiscard]] virtual bool CanSendMail(Player* /*player*/, ObjectGuid /*receiverGuid*/, ObjectGuid /*mailbox*/, std::string& /*subject*/, std::string& /*body*/, uint32 /*money*/, uint32 /*COD*/, Item* /*item*/) { SetHookUnused(PLAYERHOOK_CAN_SEND_MAIL); return true; }
 
-    virtual void PetitionBuy(Player* /*player*/, Creature* /*creature*/, uint32& /*charterid*/, uint32& /*cost*/, uint32& /*type*/) { }
+    virtual void PetitionBuy(Player* /*player*/, Creature* /*creature*/, uint32& /*charterid*/, uint32& /*cost*/, uint32& /*type*/) { SetHookUnused(PLAYERHOOK_PETITION_BUY); }
 
-    virtual void PetitionShowList(Player* /*player*/, Creature* /*creature*/, uint32& /*CharterEntry*/, uint32& /*CharterDispayID*/, uint32& /*CharterCost*/) { }
+    virtual void PetitionShowList(Player* /*player*/, Creature* /*creature*/, uint32& /*CharterEntry*/, uint32& /*CharterDispayID*/, uint32& /*CharterCost*/) { SetHookUnused(PLAYERHOOK_PETITION_SHOW_LIST); }
 
-    virtual void OnRewardKillRewarder(Player* /*player*/, bool /*isDungeon*/, float& /*rate*/) { }
+    virtual void OnRewardKillRewarder(Player* /*player*/, bool /*isDungeon*/, float& /*rate*/) { SetHookUnused(PLAYERHOOK_ON_REWARD_KILL_REWARDER); }
 
-    [[nodiscard]] virtual bool CanGiveMailRewardAtGiveLevel(Player* /*player*/, uint8 /*level*/) { return true; }
+    [[nodiscard]] virtual bool CanGiveMailRewardAtGiveLevel(Player* /*player*/, uint8 /*level*/) { SetHookUnused(PLAYERHOOK_CAN_GIVE_MAIL_REWARD_AT_GIVE_LEVEL); return true; }
 
-    virtual void OnDeleteFromDB(CharacterDatabaseTransaction /*trans*/, uint32 /*guid*/) { }
+    virtual void OnDeleteFromDB(CharacterDatabaseTransaction /*trans*/, uint32 /*guid*/) { SetHookUnused(PLAYERHOOK_ON_DELETE_FROM_DB); }
 
-    [[nodiscard]] virtual bool CanRepopAtGraveyard(Player* /*player*/) { return true; }
+    [[nodiscard]] virtual bool CanRepopAtGraveyard(Player* /*player*/) { SetHookUnused(PLAYERHOOK_CAN_REPOP_AT_GRAVEYARD); return true; }
 
-    virtual void OnGetMaxSkillValue(Player* /*player*/, uint32 /*skill*/, int32& /*result*/, bool /*IsPure*/) { }
+    virtual void OnGetMaxSkillValue(Player* /*player*/, uint32 /*skill*/, int32& /*result*/, bool /*IsPure*/) { SetHookUnused(PLAYERHOOK_ON_GET_MAX_SKILL_VALUE); }
 
     /**
      * @brief This hook called before gathering skill gain is applied to the character.
@@ -1191,7 +1204,7 @@ public:
      * @param yellow Contains the yellow skill level for current application
      * @param gain Contains the amount of points that should be added to the Player
      */
-    virtual void OnUpdateGatheringSkill(Player* /*player*/, uint32 /*skill_id*/, uint32 /*current*/, uint32 /*gray*/, uint32 /*green*/, uint32 /*yellow*/, uint32& /*gain*/) { }
+    virtual void OnUpdateGatheringSkill(Player* /*player*/, uint32 /*skill_id*/, uint32 /*current*/, uint32 /*gray*/, uint32 /*green*/, uint32 /*yellow*/, uint32& /*gain*/) { SetHookUnused(PLAYERHOOK_ON_UPDATE_GATHERING_SKILL); }
 
     /**
      * @brief This hook is called before crafting skill gain is applied to the character.
@@ -1201,89 +1214,89 @@ public:
      * @param current_level Contains the current skill level for skill
      * @param gain Contains the amount of points that should be added to the Player
      */
-    virtual void OnUpdateCraftingSkill(Player* /*player*/, SkillLineAbilityEntry const* /*skill*/, uint32 /*current_level*/, uint32& /*gain*/) { }
+    virtual void OnUpdateCraftingSkill(Player* /*player*/, SkillLineAbilityEntry const* /*skill*/, uint32 /*current_level*/, uint32& /*gain*/) { SetHookUnused(PLAYERHOOK_ON_UPDATE_CRAFTING_SKILL); }
 
-    [[nodiscard]] virtual bool OnUpdateFishingSkill(Player* /*player*/, int32 /*skill*/, int32 /*zone_skill*/, int32 /*chance*/, int32 /*roll*/) { return true; }
+    [[nodiscard]] virtual bool OnUpdateFishingSkill(Player* /*player*/, int32 /*skill*/, int32 /*zone_skill*/, int32 /*chance*/, int32 /*roll*/) { SetHookUnused(PLAYERHOOK_ON_UPDATE_FISHING_SKILL); return true; }
 
-    [[nodiscard]] virtual bool CanAreaExploreAndOutdoor(Player* /*player*/) { return true; }
+    [[nodiscard]] virtual bool CanAreaExploreAndOutdoor(Player* /*player*/) { SetHookUnused(PLAYERHOOK_CAN_AREA_EXPLORE_AND_OUTDOOR); return true; }
 
-    virtual void OnVictimRewardBefore(Player* /*player*/, Player* /*victim*/, uint32& /*killer_title*/, uint32& /*victim_title*/) { }
+    virtual void OnVictimRewardBefore(Player* /*player*/, Player* /*victim*/, uint32& /*killer_title*/, uint32& /*victim_title*/) { SetHookUnused(PLAYERHOOK_ON_VICTIM_REWARD_BEFORE); }
 
-    virtual void OnVictimRewardAfter(Player* /*player*/, Player* /*victim*/, uint32& /*killer_title*/, uint32& /*victim_rank*/, float& /*honor_f*/) { }
+    virtual void OnVictimRewardAfter(Player* /*player*/, Player* /*victim*/, uint32& /*killer_title*/, uint32& /*victim_rank*/, float& /*honor_f*/) { SetHookUnused(PLAYERHOOK_ON_VICTIM_REWARD_AFTER); }
 
-    virtual void OnCustomScalingStatValueBefore(Player* /*player*/, ItemTemplate const* /*proto*/, uint8 /*slot*/, bool /*apply*/, uint32& /*CustomScalingStatValue*/) { }
+    virtual void OnCustomScalingStatValueBefore(Player* /*player*/, ItemTemplate const* /*proto*/, uint8 /*slot*/, bool /*apply*/, uint32& /*CustomScalingStatValue*/) { SetHookUnused(PLAYERHOOK_ON_CUSTOM_SCALING_STAT_VALUE_BEFORE); }
 
-    virtual void OnCustomScalingStatValue(Player* /*player*/, ItemTemplate const* /*proto*/, uint32& /*statType*/, int32& /*val*/, uint8 /*itemProtoStatNumber*/, uint32 /*ScalingStatValue*/, ScalingStatValuesEntry const* /*ssv*/) { }
+    virtual void OnCustomScalingStatValue(Player* /*player*/, ItemTemplate const* /*proto*/, uint32& /*statType*/, int32& /*val*/, uint8 /*itemProtoStatNumber*/, uint32 /*ScalingStatValue*/, ScalingStatValuesEntry const* /*ssv*/) { SetHookUnused(PLAYERHOOK_ON_CUSTOM_SCALING_STAT_VALUE); }
 
-    [[nodiscard]] virtual bool CanArmorDamageModifier(Player* /*player*/) { return true; }
+    [[nodiscard]] virtual bool CanArmorDamageModifier(Player* /*player*/) { SetHookUnused(PLAYERHOOK_CAN_ARMOR_DAMAGE_MODIFIER); return true; }
 
-    virtual void OnGetFeralApBonus(Player* /*player*/, int32& /*feral_bonus*/, int32 /*dpsMod*/, ItemTemplate const* /*proto*/, ScalingStatValuesEntry const* /*ssv*/) { }
+    virtual void OnGetFeralApBonus(Player* /*player*/, int32& /*feral_bonus*/, int32 /*dpsMod*/, ItemTemplate const* /*proto*/, ScalingStatValuesEntry const* /*ssv*/) { SetHookUnused(PLAYERHOOK_ON_GET_FERAL_AP_BONUS); }
 
-    [[nodiscard]] virtual bool CanApplyWeaponDependentAuraDamageMod(Player* /*player*/, Item* /*item*/, WeaponAttackType /*attackType*/, AuraEffect const* /*aura*/, bool /*apply*/) { return true; }
+    [[nodiscard]] virtual bool CanApplyWeaponDependentAuraDamageMod(Player* /*player*/, Item* /*item*/, WeaponAttackType /*attackType*/, AuraEffect const* /*aura*/, bool /*apply*/) { SetHookUnused(PLAYERHOOK_CAN_APPLY_WEAPON_DEPENDENT_AURA_DAMAGE_MOD); return true; }
 
-    [[nodiscard]] virtual bool CanApplyEquipSpell(Player* /*player*/, SpellInfo const* /*spellInfo*/, Item* /*item*/, bool /*apply*/, bool /*form_change*/) { return true; }
+    [[nodiscard]] virtual bool CanApplyEquipSpell(Player* /*player*/, SpellInfo const* /*spellInfo*/, Item* /*item*/, bool /*apply*/, bool /*form_change*/) { SetHookUnused(PLAYERHOOK_CAN_APPLY_EQUIP_SPELL); return true; }
 
-    [[nodiscard]] virtual bool CanApplyEquipSpellsItemSet(Player* /*player*/, ItemSetEffect* /*eff*/) { return true; }
+    [[nodiscard]] virtual bool CanApplyEquipSpellsItemSet(Player* /*player*/, ItemSetEffect* /*eff*/) { SetHookUnused(PLAYERHOOK_CAN_APPLY_EQUIP_SPELLS_ITEM_SET); return true; }
 
-    [[nodiscard]] virtual bool CanCastItemCombatSpell(Player* /*player*/, Unit* /*target*/, WeaponAttackType /*attType*/, uint32 /*procVictim*/, uint32 /*procEx*/, Item* /*item*/, ItemTemplate const* /*proto*/) { return true; }
+    [[nodiscard]] virtual bool CanCastItemCombatSpell(Player* /*player*/, Unit* /*target*/, WeaponAttackType /*attType*/, uint32 /*procVictim*/, uint32 /*procEx*/, Item* /*item*/, ItemTemplate const* /*proto*/) { SetHookUnused(PLAYERHOOK_CAN_CAST_ITEM_COMBAT_SPELL); return true; }
 
-    [[nodiscard]] virtual bool CanCastItemUseSpell(Player* /*player*/, Item* /*item*/, SpellCastTargets const& /*targets*/, uint8 /*cast_count*/, uint32 /*glyphIndex*/) { return true; }
+    [[nodiscard]] virtual bool CanCastItemUseSpell(Player* /*player*/, Item* /*item*/, SpellCastTargets const& /*targets*/, uint8 /*cast_count*/, uint32 /*glyphIndex*/) { SetHookUnused(PLAYERHOOK_CAN_CAST_ITEM_USE_SPELL); return true; }
 
-    virtual void OnApplyAmmoBonuses(Player* /*player*/, ItemTemplate const* /*proto*/, float& /*currentAmmoDPS*/) { }
+    virtual void OnApplyAmmoBonuses(Player* /*player*/, ItemTemplate const* /*proto*/, float& /*currentAmmoDPS*/) { SetHookUnused(PLAYERHOOK_ON_APPLY_AMMO_BONUSES); }
 
-    [[nodiscard]] virtual bool CanEquipItem(Player* /*player*/, uint8 /*slot*/, uint16& /*dest*/, Item* /*pItem*/, bool /*swap*/, bool /*not_loading*/) { return true; }
+    [[nodiscard]] virtual bool CanEquipItem(Player* /*player*/, uint8 /*slot*/, uint16& /*dest*/, Item* /*pItem*/, bool /*swap*/, bool /*not_loading*/) { SetHookUnused(PLAYERHOOK_CAN_EQUIP_ITEM); return true; }
 
-    [[nodiscard]] virtual bool CanUnequipItem(Player* /*player*/, uint16 /*pos*/, bool /*swap*/) { return true; }
+    [[nodiscard]] virtual bool CanUnequipItem(Player* /*player*/, uint16 /*pos*/, bool /*swap*/) { SetHookUnused(PLAYERHOOK_CAN_UNEQUIP_ITEM); return true; }
 
-    [[nodiscard]] virtual bool CanUseItem(Player* /*player*/, ItemTemplate const* /*proto*/, InventoryResult& /*result*/) { return true; }
+    [[nodiscard]] virtual bool CanUseItem(Player* /*player*/, ItemTemplate const* /*proto*/, InventoryResult& /*result*/) { SetHookUnused(PLAYERHOOK_CAN_USE_ITEM); return true; }
 
-    [[nodiscard]] virtual bool CanSaveEquipNewItem(Player* /*player*/, Item* /*item*/, uint16 /*pos*/, bool /*update*/) { return true; }
+    [[nodiscard]] virtual bool CanSaveEquipNewItem(Player* /*player*/, Item* /*item*/, uint16 /*pos*/, bool /*update*/) { SetHookUnused(PLAYERHOOK_CAN_SAVE_EQUIP_NEW_ITEM); return true; }
 
-    [[nodiscard]] virtual bool CanApplyEnchantment(Player* /*player*/, Item* /*item*/, EnchantmentSlot /*slot*/, bool /*apply*/, bool /*apply_dur*/, bool /*ignore_condition*/) { return true; }
+    [[nodiscard]] virtual bool CanApplyEnchantment(Player* /*player*/, Item* /*item*/, EnchantmentSlot /*slot*/, bool /*apply*/, bool /*apply_dur*/, bool /*ignore_condition*/) { SetHookUnused(PLAYERHOOK_CAN_APPLY_ENCHANTMENT); return true; }
 
-    virtual void OnGetQuestRate(Player* /*player*/, float& /*result*/) { }
+    virtual void OnGetQuestRate(Player* /*player*/, float& /*result*/) { SetHookUnused(PLAYERHOOK_ON_GET_QUEST_RATE); }
 
-    [[nodiscard]] virtual bool PassedQuestKilledMonsterCredit(Player* /*player*/, Quest const* /*qinfo*/, uint32 /*entry*/, uint32 /*real_entry*/, ObjectGuid /*guid*/) { return true; }
+    [[nodiscard]] virtual bool PassedQuestKilledMonsterCredit(Player* /*player*/, Quest const* /*qinfo*/, uint32 /*entry*/, uint32 /*real_entry*/, ObjectGuid /*guid*/) { SetHookUnused(PLAYERHOOK_PASSED_QUEST_KILLED_MONSTER_CREDIT); return true; }
 
-    [[nodiscard]] virtual bool CheckItemInSlotAtLoadInventory(Player* /*player*/, Item* /*item*/, uint8 /*slot*/, uint8& /*err*/, uint16& /*dest*/) { return true; }
+    [[nodiscard]] virtual bool CheckItemInSlotAtLoadInventory(Player* /*player*/, Item* /*item*/, uint8 /*slot*/, uint8& /*err*/, uint16& /*dest*/) { SetHookUnused(PLAYERHOOK_CHECK_ITEM_IN_SLOT_AT_LOAD_INVENTORY); return true; }
 
-    [[nodiscard]] virtual bool NotAvoidSatisfy(Player* /*player*/, DungeonProgressionRequirements const* /*ar*/, uint32 /*target_map*/, bool /*report*/) { return true; }
+    [[nodiscard]] virtual bool NotAvoidSatisfy(Player* /*player*/, DungeonProgressionRequirements const* /*ar*/, uint32 /*target_map*/, bool /*report*/) { SetHookUnused(PLAYERHOOK_NOT_AVOID_SATISFY); return true; }
 
-    [[nodiscard]] virtual bool NotVisibleGloballyFor(Player* /*player*/, Player const* /*u*/) { return true; }
+    [[nodiscard]] virtual bool NotVisibleGloballyFor(Player* /*player*/, Player const* /*u*/) { SetHookUnused(PLAYERHOOK_NOT_VISIBLE_GLOBALLY_FOR); return true; }
 
-    virtual void OnGetArenaPersonalRating(Player* /*player*/, uint8 /*slot*/, uint32& /*result*/) { }
+    virtual void OnGetArenaPersonalRating(Player* /*player*/, uint8 /*slot*/, uint32& /*result*/) { SetHookUnused(PLAYERHOOK_ON_GET_ARENA_PERSONAL_RATING); }
 
-    virtual void OnGetArenaTeamId(Player* /*player*/, uint8 /*slot*/, uint32& /*result*/) { }
+    virtual void OnGetArenaTeamId(Player* /*player*/, uint8 /*slot*/, uint32& /*result*/) { SetHookUnused(PLAYERHOOK_ON_GET_ARENA_TEAM_ID); }
 
     // Fires whenever the UNIT_BYTE2_FLAG_FFA_PVP bit is Changed on the player
-    virtual void OnFfaPvpStateUpdate(Player* /*player*/, bool /*result*/) { }
+    virtual void OnFfaPvpStateUpdate(Player* /*player*/, bool /*result*/) { SetHookUnused(PLAYERHOOK_ON_FFA_PVP_STATE_UPDATE); }
 
-    virtual void OnIsFFAPvP(Player* /*player*/, bool& /*result*/) { }
+    virtual void OnIsFFAPvP(Player* /*player*/, bool& /*result*/) { SetHookUnused(PLAYERHOOK_ON_IS_FFA_PV_P); }
 
-    virtual void OnIsPvP(Player* /*player*/, bool& /*result*/) { }
+    virtual void OnIsPvP(Player* /*player*/, bool& /*result*/) { SetHookUnused(PLAYERHOOK_ON_IS_PV_P); }
 
-    virtual void OnGetMaxSkillValueForLevel(Player* /*player*/, uint16& /*result*/) { }
+    virtual void OnGetMaxSkillValueForLevel(Player* /*player*/, uint16& /*result*/) { SetHookUnused(PLAYERHOOK_ON_GET_MAX_SKILL_VALUE_FOR_LEVEL); }
 
-    [[nodiscard]] virtual bool NotSetArenaTeamInfoField(Player* /*player*/, uint8 /*slot*/, ArenaTeamInfoType /*type*/, uint32 /*value*/) { return true; }
+    [[nodiscard]] virtual bool NotSetArenaTeamInfoField(Player* /*player*/, uint8 /*slot*/, ArenaTeamInfoType /*type*/, uint32 /*value*/) { SetHookUnused(PLAYERHOOK_NOT_SET_ARENA_TEAM_INFO_FIELD); return true; }
 
-    [[nodiscard]] virtual bool CanJoinLfg(Player* /*player*/, uint8 /*roles*/, lfg::LfgDungeonSet& /*dungeons*/, const std::string& /*comment*/) { return true; }
+    [[nodiscard]] virtual bool CanJoinLfg(Player* /*player*/, uint8 /*roles*/, lfg::LfgDungeonSet& /*dungeons*/, const std::string& /*comment*/) { SetHookUnused(PLAYERHOOK_CAN_JOIN_LFG); return true; }
 
-    [[nodiscard]] virtual bool CanEnterMap(Player* /*player*/, MapEntry const* /*entry*/, InstanceTemplate const* /*instance*/, MapDifficulty const* /*mapDiff*/, bool /*loginCheck*/) { return true; }
+    [[nodiscard]] virtual bool CanEnterMap(Player* /*player*/, MapEntry const* /*entry*/, InstanceTemplate const* /*instance*/, MapDifficulty const* /*mapDiff*/, bool /*loginCheck*/) { SetHookUnused(PLAYERHOOK_CAN_ENTER_MAP); return true; }
 
-    [[nodiscard]] virtual bool CanInitTrade(Player* /*player*/, Player* /*target*/) { return true; }
+    [[nodiscard]] virtual bool CanInitTrade(Player* /*player*/, Player* /*target*/) { SetHookUnused(PLAYERHOOK_CAN_INIT_TRADE); return true; }
 
-    virtual void OnSetServerSideVisibility(Player* /*player*/, ServerSideVisibilityType& /*type*/, AccountTypes& /*sec*/) { }
+    virtual void OnSetServerSideVisibility(Player* /*player*/, ServerSideVisibilityType& /*type*/, AccountTypes& /*sec*/) { SetHookUnused(PLAYERHOOK_ON_SET_SERVER_SIDE_VISIBILITY); }
 
-    virtual void OnSetServerSideVisibilityDetect(Player* /*player*/, ServerSideVisibilityType& /*type*/, AccountTypes& /*sec*/) { }
+    virtual void OnSetServerSideVisibilityDetect(Player* /*player*/, ServerSideVisibilityType& /*type*/, AccountTypes& /*sec*/) { SetHookUnused(PLAYERHOOK_ON_SET_SERVER_SIDE_VISIBILITY_DETECT); }
 
-    virtual void OnGiveHonorPoints(Player* /*player*/, float& /*honor*/, Unit* /*victim*/) { }
+    virtual void OnGiveHonorPoints(Player* /*player*/, float& /*honor*/, Unit* /*victim*/) { SetHookUnused(PLAYERHOOK_ON_GIVE_HONOR_POINTS); }
 
-    virtual void OnAfterResurrect(Player* /*player*/, float /*restore_percent*/, bool /*applySickness*/) { }
+    virtual void OnAfterResurrect(Player* /*player*/, float /*restore_percent*/, bool /*applySickness*/) { SetHookUnused(PLAYERHOOK_ON_AFTER_RESURRECT); }
 
-    virtual void OnPlayerResurrect(Player* /*player*/, float /*restore_percent*/, bool /*applySickness*/) { }
+    virtual void OnPlayerResurrect(Player* /*player*/, float /*restore_percent*/, bool /*applySickness*/) { SetHookUnused(PLAYERHOOK_ON_PLAYER_RESURRECT); }
 
     // Called before selecting the graveyard when releasing spirit
-    virtual void OnBeforeChooseGraveyard(Player* /*player*/, TeamId /*teamId*/, bool /*nearCorpse*/, uint32& /*graveyardOverride*/) { }
+    virtual void OnBeforeChooseGraveyard(Player* /*player*/, TeamId /*teamId*/, bool /*nearCorpse*/, uint32& /*graveyardOverride*/) { SetHookUnused(PLAYERHOOK_ON_BEFORE_CHOOSE_GRAVEYARD); }
 
     /**
      * @brief This hook called before player sending message in default chat
@@ -1295,7 +1308,7 @@ public:
      *
      * @return True if you want to continue sending the message, false if you want to disable sending the message
      */
-    [[nodiscard]] virtual bool CanPlayerUseChat(Player* /*player*/, uint32 /*type*/, uint32 /*language*/, std::string& /*msg*/) { return true; }
+    [[nodiscard]] virtual bool CanPlayerUseChat(Player* /*player*/, uint32 /*type*/, uint32 /*language*/, std::string& /*msg*/) { SetHookUnused(PLAYERHOOK_CAN_PLAYER_USE_CHAT); return true; }
 
     /**
      * @brief This hook called before player sending message to other player via private
@@ -1308,7 +1321,7 @@ public:
      *
      * @return True if you want to continue sending the message, false if you want to disable sending the message
      */
-    [[nodiscard]] virtual bool CanPlayerUseChat(Player* /*player*/, uint32 /*type*/, uint32 /*language*/, std::string& /*msg*/, Player* /*receiver*/) { return true; }
+    [[nodiscard]] virtual bool CanPlayerUseChat(Player* /*player*/, uint32 /*type*/, uint32 /*language*/, std::string& /*msg*/, Player* /*receiver*/) { SetHookUnused(PLAYERHOOK_CAN_PLAYER_USE_CHAT_RECEIVER); return true; }
 
     /**
      * @brief This hook called before player sending message to group
@@ -1321,7 +1334,7 @@ public:
      *
      * @return True if you want to continue sending the message, false if you want to disable sending the message
      */
-    [[nodiscard]] virtual bool CanPlayerUseChat(Player* /*player*/, uint32 /*type*/, uint32 /*language*/, std::string& /*msg*/, Group* /*group*/) { return true; }
+    [[nodiscard]] virtual bool CanPlayerUseChat(Player* /*player*/, uint32 /*type*/, uint32 /*language*/, std::string& /*msg*/, Group* /*group*/) { SetHookUnused(PLAYERHOOK_CAN_PLAYER_USE_CHAT_GROUP); return true; }
 
     /**
      * @brief This hook called before player sending message to guild
@@ -1334,7 +1347,7 @@ public:
      *
      * @return True if you want to continue sending the message, false if you want to disable sending the message
      */
-    [[nodiscard]] virtual bool CanPlayerUseChat(Player* /*player*/, uint32 /*type*/, uint32 /*language*/, std::string& /*msg*/, Guild* /*guild*/) { return true; }
+    [[nodiscard]] virtual bool CanPlayerUseChat(Player* /*player*/, uint32 /*type*/, uint32 /*language*/, std::string& /*msg*/, Guild* /*guild*/) { SetHookUnused(PLAYERHOOK_CAN_PLAYER_USE_CHAT_GUILD); return true; }
 
     /**
      * @brief This hook called before player sending message to channel
@@ -1347,7 +1360,7 @@ public:
      *
      * @return True if you want to continue sending the message, false if you want to disable sending the message
      */
-    [[nodiscard]] virtual bool CanPlayerUseChat(Player* /*player*/, uint32 /*type*/, uint32 /*language*/, std::string& /*msg*/, Channel* /*channel*/) { return true; }
+    [[nodiscard]] virtual bool CanPlayerUseChat(Player* /*player*/, uint32 /*type*/, uint32 /*language*/, std::string& /*msg*/, Channel* /*channel*/) { SetHookUnused(PLAYERHOOK_CAN_PLAYER_USE_CHAT_CHANNEL); return true; }
 
     /**
      * @brief This hook called after player learning talents
@@ -1357,7 +1370,7 @@ public:
      * @param talentRank Contains information about the talent rank
      * @param spellid Contains information about the spell id
      */
-    virtual void OnPlayerLearnTalents(Player* /*player*/, uint32 /*talentId*/, uint32 /*talentRank*/, uint32 /*spellid*/) { }
+    virtual void OnPlayerLearnTalents(Player* /*player*/, uint32 /*talentId*/, uint32 /*talentRank*/, uint32 /*spellid*/) { SetHookUnused(PLAYERHOOK_ON_PLAYER_LEARN_TALENTS); }
 
     /**
      * @brief This hook called after player entering combat
@@ -1365,14 +1378,14 @@ public:
      * @param player Contains information about the Player
      * @param Unit Contains information about the Unit
      */
-    virtual void OnPlayerEnterCombat(Player* /*player*/, Unit* /*enemy*/) { }
+    virtual void OnPlayerEnterCombat(Player* /*player*/, Unit* /*enemy*/) { SetHookUnused(PLAYERHOOK_ON_PLAYER_ENTER_COMBAT); }
 
     /**
      * @brief This hook called after player leave combat
      *
      * @param player Contains information about the Player
      */
-    virtual void OnPlayerLeaveCombat(Player* /*player*/) { }
+    virtual void OnPlayerLeaveCombat(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_PLAYER_LEAVE_COMBAT); }
 
     /**
      * @brief This hook called after player abandoning quest
@@ -1380,30 +1393,30 @@ public:
      * @param player Contains information about the Player
      * @param questId Contains information about the quest id
      */
-    virtual void OnQuestAbandon(Player* /*player*/, uint32 /*questId*/) { }
+    virtual void OnQuestAbandon(Player* /*player*/, uint32 /*questId*/) { SetHookUnused(PLAYERHOOK_ON_QUEST_ABANDON); }
 
     // Warhead hooks
-    virtual void OnGetDodgeFromAgility(Player* /*player*/, float& /*diminishing*/, float& /*nondiminishing*/) { }
-    virtual void OnGetArmorFromAgility(Player* /*player*/, float& /*value*/) { }
-    virtual void OnGetMeleeCritFromAgility(Player* /*player*/, float& /*value*/) { }
-    virtual void OnGetSpellCritFromIntellect(Player* /*player*/, float& /*value*/) { }
-    virtual void OnGetManaBonusFromIntellect(Player* /*player*/, float& /*value*/) { }
-    virtual void OnGetShieldBlockValue(Player* /*player*/, float& /*value*/) { }
-    virtual void OnUpdateAttackPowerAndDamage(Player* /*player*/, float& /*apFromAgility*/) { }
-    virtual void OnCalculateMinMaxDamage(Player* /*player*/, float& /*damageFromAP*/) { }
-    [[nodiscard]] virtual bool CanCompleteQuest(Player* /*player*/, Quest const* /*questInfo*/, QuestStatusData const* /*questStatusData*/) { return true; }
-    virtual void OnAddQuest(Player* /*player*/, Quest const* /*quest*/, Object* /*questGiver*/) { }
-    virtual void OnUpdateProfessionSkill(Player* /*player*/, uint16 /*skillId*/, int32 /*chance*/, uint32& /*step*/) { }
+    virtual void OnGetDodgeFromAgility(Player* /*player*/, float& /*diminishing*/, float& /*nondiminishing*/) { SetHookUnused(PLAYERHOOK_ON_GET_DODGE_FROM_AGILITY); }
+    virtual void OnGetArmorFromAgility(Player* /*player*/, float& /*value*/) { SetHookUnused(PLAYERHOOK_ON_GET_ARMOR_FROM_AGILITY); }
+    virtual void OnGetMeleeCritFromAgility(Player* /*player*/, float& /*value*/) { SetHookUnused(PLAYERHOOK_ON_GET_MELEE_CRIT_FROM_AGILITY); }
+    virtual void OnGetSpellCritFromIntellect(Player* /*player*/, float& /*value*/) { SetHookUnused(PLAYERHOOK_ON_GET_SPELL_CRIT_FROM_INTELLECT); }
+    virtual void OnGetManaBonusFromIntellect(Player* /*player*/, float& /*value*/) { SetHookUnused(PLAYERHOOK_ON_GET_MANA_BONUS_FROM_INTELLECT); }
+    virtual void OnGetShieldBlockValue(Player* /*player*/, float& /*value*/) { SetHookUnused(PLAYERHOOK_ON_GET_SHIELD_BLOCK_VALUE); }
+    virtual void OnUpdateAttackPowerAndDamage(Player* /*player*/, float& /*apFromAgility*/) { SetHookUnused(PLAYERHOOK_ON_UPDATE_ATTACK_POWER_AND_DAMAGE); }
+    virtual void OnCalculateMinMaxDamage(Player* /*player*/, float& /*damageFromAP*/) { SetHookUnused(PLAYERHOOK_ON_CALCULATE_MIN_MAX_DAMAGE); }
+    [[nodiscard]] virtual bool CanCompleteQuest(Player* /*player*/, Quest const* /*questInfo*/, QuestStatusData const* /*questStatusData*/) { SetHookUnused(PLAYERHOOK_CAN_COMPLETE_QUEST); return true; }
+    virtual void OnAddQuest(Player* /*player*/, Quest const* /*quest*/, Object* /*questGiver*/) { SetHookUnused(PLAYERHOOK_ON_ADD_QUEST); }
+    virtual void OnUpdateProfessionSkill(Player* /*player*/, uint16 /*skillId*/, int32 /*chance*/, uint32& /*step*/) { SetHookUnused(PLAYERHOOK_ON_UPDATE_PROFESSION_SKILL); }
 
     // Passive Anticheat System
-    virtual void AnticheatSetSkipOnePacketForASH(Player* /*player*/, bool /*apply*/) { }
-    virtual void AnticheatSetCanFlybyServer(Player* /*player*/, bool /*apply*/) { }
-    virtual void AnticheatSetUnderACKmount(Player* /*player*/) { }
-    virtual void AnticheatSetRootACKUpd(Player* /*player*/) { }
-    virtual void AnticheatSetJumpingbyOpcode(Player* /*player*/, bool /*jump*/) { }
-    virtual void AnticheatUpdateMovementInfo(Player* /*player*/, MovementInfo const& /*movementInfo*/) { }
-    [[nodiscard]] virtual bool AnticheatHandleDoubleJump(Player* /*player*/, Unit* /*mover*/) { return true; }
-    [[nodiscard]] virtual bool AnticheatCheckMovementInfo(Player* /*player*/, MovementInfo const& /*movementInfo*/, Unit* /*mover*/, bool /*jump*/) { return true; }
+    virtual void AnticheatSetSkipOnePacketForASH(Player* /*player*/, bool /*apply*/) { SetHookUnused(PLAYERHOOK_ANTICHEAT_SET_SKIP_ONE_PACKET_FOR_ASH); }
+    virtual void AnticheatSetCanFlybyServer(Player* /*player*/, bool /*apply*/) { SetHookUnused(PLAYERHOOK_ANTICHEAT_SET_CAN_FLYBY_SERVER); }
+    virtual void AnticheatSetUnderACKmount(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ANTICHEAT_SET_UNDER_AC_KMOUNT); }
+    virtual void AnticheatSetRootACKUpd(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ANTICHEAT_SET_ROOT_ACK_UPD); }
+    virtual void AnticheatSetJumpingbyOpcode(Player* /*player*/, bool /*jump*/) { SetHookUnused(PLAYERHOOK_ANTICHEAT_SET_JUMPINGBY_OPCODE); }
+    virtual void AnticheatUpdateMovementInfo(Player* /*player*/, MovementInfo const& /*movementInfo*/) { SetHookUnused(PLAYERHOOK_ANTICHEAT_UPDATE_MOVEMENT_INFO); }
+    [[nodiscard]] virtual bool AnticheatHandleDoubleJump(Player* /*player*/, Unit* /*mover*/) { SetHookUnused(PLAYERHOOK_ANTICHEAT_HANDLE_DOUBLE_JUMP); return true; }
+    [[nodiscard]] virtual bool AnticheatCheckMovementInfo(Player* /*player*/, MovementInfo const& /*movementInfo*/, Unit* /*mover*/, bool /*jump*/) { SetHookUnused(PLAYERHOOK_ANTICHEAT_CHECK_MOVEMENT_INFO); return true; }
 
     /**
      * @brief This hook is called, to avoid displaying the error message that the body has already been stripped
@@ -1412,7 +1425,7 @@ public:
      *
      * @return true Avoiding displaying the error message that the loot has already been taken.
      */
-    virtual bool CanSendErrorAlreadyLooted(Player* /*player*/) { return true; }
+    virtual bool CanSendErrorAlreadyLooted(Player* /*player*/) { SetHookUnused(PLAYERHOOK_CAN_SEND_ERROR_ALREADY_LOOTED); return true; }
 
     /**
      * @brief It is used when an item is taken from a creature.
@@ -1420,14 +1433,14 @@ public:
      * @param player Contains information about the Player
      *
     */
-    virtual void OnAfterCreatureLoot(Player* /*player*/) { }
+    virtual void OnAfterCreatureLoot(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_AFTER_CREATURE_LOOT); }
 
     /**
      * @brief After a creature's money is taken
      *
      * @param player Contains information about the Player
      */
-    virtual void OnAfterCreatureLootMoney(Player* /*player*/) { }
+    virtual void OnAfterCreatureLootMoney(Player* /*player*/) { SetHookUnused(PLAYERHOOK_ON_AFTER_CREATURE_LOOT_MONEY); }
 };
 
 class WH_GAME_API AccountScript : public ScriptObject
@@ -2080,4 +2093,58 @@ public:
 
 #define RegisterGameObjectAIWithFactory(ai_name, factory_fn) new FactoryGameObjectScript<ai_name, &factory_fn>(#ai_name)
 
+// Class declaring the method, overloaded method needs its signature
+template<typename Signature, class Class>
+Class* GetScriptHookOwner(Signature Class::*);
+
+// Sets hook of Base if Script or its base other than Base declares the method, hooks which can't be
+// checked count as overridden
+#define WARHEAD_SET_OVERRIDDEN_HOOK(hook, method, ...) \
+    hooks.set(hook, []<class S, class B>() \
+    { \
+        if constexpr (requires { GetScriptHookOwner<__VA_ARGS__>(&S::method); }) \
+            return !std::is_same_v<decltype(GetScriptHookOwner<__VA_ARGS__>(&S::method)), B*>; \
+        else \
+            return true; \
+    }.template operator()<Script, Base>());
+
+template<class Script, class Base>
+std::bitset<script_hook_count<Base>::value> GetOverriddenHooks()
+{
+    std::bitset<script_hook_count<Base>::value> hooks;
+
+    if constexpr (std::is_same_v<Base, PlayerScript>)
+    {
+        WARHEAD_PLAYER_HOOKS(WARHEAD_SET_OVERRIDDEN_HOOK)
+    }
+    else
+    {
+        static_assert(std::is_same_v<Base, UnitScript>, "Base must be a script type with indexed hooks");
+        WARHEAD_UNIT_HOOKS(WARHEAD_SET_OVERRIDDEN_HOOK)
+    }
+
+    return hooks;
+}
+
+#undef WARHEAD_SET_OVERRIDDEN_HOOK
+
+// Creates player or unit script with its overridden hooks known at compile time. Hooks it doesn't override
+// are never called and base class hooks called from its overrides don't unsubscribe it.
+// Scripts created with plain new are called for every hook.
+template<class Script, typename... Args>
+Script* RegisterHookedScript(Args&&... args)
+{
+    static_assert(std::is_base_of_v<PlayerScript, Script> || std::is_base_of_v<UnitScript, Script>, "Script must be a player or unit script");
+
+    Script* script = new Script(std::forward<Args>(args)...);
+
+    if constexpr (std::is_base_of_v<PlayerScript, Script>)
+        script->PlayerScript::SetOverriddenHooks(GetOverriddenHooks<Script, PlayerScript>());
+
+    if constexpr (std::is_base_of_v<UnitScript, Script>)
+        script->UnitScript::SetOverriddenHooks(GetOverriddenHooks<Script, UnitScript>());
+
+    return script;
+}
+
 #endif //
\ No newline at end of file
@@ -546,6 +546,7 @@ inline void SpecializedScriptRegistry<ScriptType, false>::AddScript(ScriptType*
 
     // We're dealing with a code-only script, just add it.
     _scripts.insert(std::make_pair(sScriptMgr->GetCurrentScriptContext(), std::move(script_ptr)));
+    _hooks.Add(script);
 }
 
 // Specialize for each script type class like so:
@@ -20,6 +20,7 @@
 
 #include "EventProcessor.h"
 #include "ObjectGuid.h"
+#include "ScriptHooks.h"
 #include <unordered_map>
 
 class Creature;
@@ -164,6 +165,10 @@ public:
 
     /// Loading scripts after loadd DB.
     virtual void LoadDBBoundScripts() = 0;
+
+    /// Drops scripts from subscriber lists of hooks they don't override.
+    /// Must not be called while script hooks are executed.
+    virtual void CompactHooks() { }
 };
 
 template<class>
@@ -237,6 +242,12 @@ public:
             registry->LoadDBBoundScripts();
     }
 
+    void CompactHooks() final override
+    {
+        for (auto const registry : _registries)
+            registry->CompactHooks();
+    }
+
     static ScriptRegistryCompositum* Instance()
     {
         static ScriptRegistryCompositum instance;
@@ -542,6 +553,7 @@ public:
     {
         this->BeforeReleaseContext(context);
         _scripts.erase(std::string{ context });
+        _hooks.Rebuild(_scripts);
     }
 
     void SwapContext(bool initialize) final override
@@ -559,10 +571,16 @@ public:
     {
         this->BeforeUnload();
         _scripts.clear();
+        _hooks.Rebuild(_scripts);
     }
 
     void LoadDBBoundScripts() final { }
 
+    void CompactHooks() final override
+    {
+        _hooks.Compact();
+    }
+
     // Adds a non database bound script
     void AddScript(ScriptType* script);
 
@@ -571,8 +589,14 @@ public:
         return _scripts;
     }
 
+    ScriptHookIndex<ScriptType>& GetHooks()
+    {
+        return _hooks;
+    }
+
 private:
     ScriptStoreType _scripts;
+    ScriptHookIndex<ScriptType> _hooks;
 };
 
 #endif // _SCRIPT_REGISTRY_H_
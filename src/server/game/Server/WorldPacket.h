@@ -22,6 +22,7 @@
 #include "Common.h"
 #include "Duration.h"
 #include "Opcodes.h"
+#include <memory>
 
 class WorldPacket : public ByteBuffer
 {
@@ -83,4 +84,7 @@ protected:
     TimePoint m_receivedTime; // only set for a specific set of opcodes, for performance reasons.
 };
 
+/// Immutable packet shared by all recipients of a broadcast, socket send queues hold it without copying
+typedef std::shared_ptr<WorldPacket const> SharedWorldPacket;
+
 #endif
@@ -56,9 +56,12 @@
 #include "VipQueryHolder.h"
 #include "WardenMac.h"
 #include "WardenWin.h"
+#include "WhoListCacheMgr.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSocket.h"
+#include <array>
+#include <atomic>
 #include <sstream>
 #include <zlib.h>
 
@@ -66,6 +69,9 @@ namespace
 {
     constexpr uint32 MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE = 150;
     std::string const DefaultPlayerName = "<none>";
+
+    // Opcode tagged series, registered on first slow packet of each opcode. Shared by world and map threads
+    [[maybe_unused]] std::array<std::atomic<MetricSeriesId>, NUM_OPCODE_HANDLERS> OpcodeMetricSeries{};
 }
 
 bool MapSessionFilter::Process(WorldPacket* packet)
@@ -183,6 +189,9 @@ WorldSession::~WorldSession()
         delete packet;
 
     AuthDatabase.Execute("UPDATE account SET online = 0 WHERE id = {};", GetAccountId());     // One-time query
+
+    // Series is tagged by account id
+    sMetric->ReleaseSeries(_updateMetricSeries);
 }
 
 std::string const& WorldSession::GetPlayerName() const
@@ -212,17 +221,17 @@ ObjectGuid::LowType WorldSession::GetGuidLow() const
     return GetPlayer() ? GetPlayer()->GetGUID().GetCounter() : 0;
 }
 
-/// Send a packet to the client
-void WorldSession::SendPacket(WorldPacket const* packet)
+/// Validate and log packet before it goes to the socket
+bool WorldSession::CanSendPacket(WorldPacket const* packet)
 {
     if (packet->GetOpcode() == NULL_OPCODE)
     {
         LOG_ERROR("network.opcode", "{} send NULL_OPCODE", GetPlayerInfo());
-        return;
+        return false;
     }
 
     if (!m_Socket)
-        return;
+        return false;
 
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS) && defined(WARHEAD_DEBUG)
     // Code for network use statistic
@@ -262,13 +271,33 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
     if (!sScriptMgr->CanPacketSend(this, *packet))
     {
-        return;
+        return false;
     }
 
     LOG_TRACE("network.opcode", "S->C: {} {}", GetPlayerInfo(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())));
+    return true;
+}
+
+/// Send a packet to the client
+void WorldSession::SendPacket(WorldPacket const* packet)
+{
+    if (!CanSendPacket(packet))
+        return;
+
     m_Socket->SendPacket(*packet);
 }
 
+void WorldSession::SendPacket(WorldPacket const* packet, SharedWorldPacket& sharedPacket)
+{
+    if (!CanSendPacket(packet))
+        return;
+
+    if (!sharedPacket)
+        sharedPacket = std::make_shared<WorldPacket const>(*packet);
+
+    m_Socket->SendPacket(sharedPacket);
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
@@ -327,7 +356,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
         OpcodeClient opcode = static_cast<OpcodeClient>(packet->GetOpcode());
         ClientOpcodeHandler const* opHandle = opcodeTable[opcode];
 
-        METRIC_DETAILED_TIMER("worldsession_update_opcode_time", METRIC_TAG("opcode", opHandle->Name));
+        METRIC_DETAILED_SERIES_TIMER(OpcodeMetricSeries[opcode], "worldsession_update_opcode_time", METRIC_TAG("opcode", opHandle->Name));
 
         try
         {
@@ -711,6 +740,7 @@ void WorldSession::LogoutPlayer(bool save)
         //! Broadcast a logout message to the player's friends
         sSocialMgr->SendFriendStatus(_player, FRIEND_OFFLINE, _player->GetGUID(), true);
         sSocialMgr->RemovePlayerSocial(_player->GetGUID());
+        sWhoListCacheMgr->RemovePlayer(_player->GetGUID());
 
         //! Call script hook before deletion
         sScriptMgr->OnPlayerLogout(_player);
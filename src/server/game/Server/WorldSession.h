@@ -28,6 +28,7 @@
 #include "Common.h"
 #include "DatabaseEnvFwd.h"
 #include "GossipDef.h"
+#include "Metric.h"
 #include "Packet.h"
 #include "SharedDefines.h"
 #include "World.h"
@@ -356,6 +357,8 @@ public:
     void WriteMovementInfo(WorldPacket* data, MovementInfo* mi);
 
     void SendPacket(WorldPacket const* packet);
+    // Broadcast variant, payload is copied to sharedPacket on first send and then shared by all recipients
+    void SendPacket(WorldPacket const* packet, SharedWorldPacket& sharedPacket);
 
     void SendPetNameInvalid(uint32 error, std::string const& name, DeclinedName* declinedName);
     void SendPartyResult(PartyOperation operation, std::string const& member, PartyResult res, uint32 val = 0);
@@ -1070,6 +1073,9 @@ public:                                                 // opcodes handlers
     void SetKicked(bool val) { _kicked = val; }
     bool IsSocketClosed() const;
 
+    // Account tagged series of session update time, used by World::UpdateSessions only
+    MetricSeriesId& GetUpdateMetricSeries() { return _updateMetricSeries; }
+
     /*
      * CALLBACKS
      */
@@ -1083,6 +1089,7 @@ public:                                                 // opcodes handlers
 
 private:
     void ProcessQueryCallbacks();
+    bool CanSendPacket(WorldPacket const* packet);
 
     QueryCallbackProcessor _queryProcessor;
     TransactionCallbackProcessor _transactionCallbacks;
@@ -1149,6 +1156,7 @@ private:
     bool _skipQueue;
     uint32 _accountId;
     std::string _accountName;
+    MetricSeriesId _updateMetricSeries{};
     uint8 m_expansion;
     uint32 m_total_time;
 
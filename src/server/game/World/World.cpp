@@ -37,6 +37,7 @@
 #include "CalendarMgr.h"
 #include "Channel.h"
 #include "ChannelMgr.h"
+#include "CharacterCache.h"
 #include "CharacterDatabaseCleaner.h"
 #include "Chat.h"
 #include "ChatPackets.h"
@@ -92,6 +93,7 @@
 #include "SmartAI.h"
 #include "SpellMgr.h"
 #include "StopWatch.h"
+#include "TaskGraph.h"
 #include "TaskScheduler.h"
 #include "TicketMgr.h"
 #include "Tokenize.h"
@@ -105,15 +107,37 @@
 #include "WardenCheckMgr.h"
 #include "WaypointMovementGenerator.h"
 #include "WeatherMgr.h"
-#include "WhoListCacheMgr.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #include <boost/asio/ip/address.hpp>
 #include <cmath>
+#include <thread>
 
 namespace
 {
     TaskScheduler playersSaveScheduler;
+
+    void RunLoadGraph(Warhead::TaskGraph& loadGraph)
+    {
+        StopWatch sw;
+
+        std::size_t threads = CONF_GET_UINT("DBCache.LoadThreads");
+        if (!threads)
+            threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+        loadGraph.Run(threads);
+
+        // slowest tasks first
+        auto timings = loadGraph.GetTimings();
+        std::sort(timings.begin(), timings.end(), [](auto const& left, auto const& right) { return left.Elapsed > right.Elapsed; });
+
+        LOG_INFO("server.loading", "Loaded {} world data tasks with {} threads in {}", loadGraph.GetSize(), threads, sw);
+
+        for (auto const& [name, elapsed] : timings)
+            LOG_INFO("server.loading", ">> {:<28} {}", name, Warhead::Time::ToTimeString(elapsed));
+
+        LOG_INFO("server.loading", "");
+    }
 }
 
 std::atomic_long World::_stopEvent = false;
@@ -686,350 +710,689 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server.loading", "Loading Instances...");
     sInstanceSaveMgr->LoadInstances();
 
-    LOG_INFO("server.loading", "Loading Game locale texts...");
-    sGameLocale->LoadAllLocales();
+    ///- Load world tables. Every task lists tasks it needs data of, barriers change data other tasks read.
+    ///- Tasks are executed in order written here if DBCache.LoadThreads = 1
+    Warhead::TaskGraph loadGraph;
 
-    LOG_INFO("server", "Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
+    loadGraph.AddTask("GameLocale", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Game locale texts...");
+        sGameLocale->LoadAllLocales();
+    });
 
-    LOG_INFO("server.loading", "Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
+    loadGraph.AddTask("PageTexts", {}, []()
+    {
+        LOG_INFO("server", "Loading Page Texts...");
+        sObjectMgr->LoadPageTexts();
+    });
 
-    LOG_INFO("server.loading", "Loading Game Object Template Addons...");
-    sObjectMgr->LoadGameObjectTemplateAddons();
+    loadGraph.AddTask("GameObjectTemplates", { "PageTexts" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Game Object Templates...");
+        sObjectMgr->LoadGameObjectTemplate();
+    });
 
-    LOG_INFO("server.loading", "Loading Transport Templates...");
-    sTransportMgr->LoadTransportTemplates();
+    loadGraph.AddTask("GameObjectTemplateAddons", { "GameObjectTemplates" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Game Object Template Addons...");
+        sObjectMgr->LoadGameObjectTemplateAddons();
+    });
 
-    LOG_INFO("server.loading", "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
+    loadGraph.AddTask("TransportTemplates", { "GameObjectTemplates" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Transport Templates...");
+        sTransportMgr->LoadTransportTemplates();
+    });
 
-    LOG_INFO("server.loading", "Loading Spell Group Types...");
-    sSpellMgr->LoadSpellGroups();
+    loadGraph.AddTask("SpellRequired", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Spell Required Data...");
+        sSpellMgr->LoadSpellRequired();
+    });
 
-    LOG_INFO("server.loading", "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
+    loadGraph.AddTask("SpellGroups", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Spell Group Types...");
+        sSpellMgr->LoadSpellGroups();
+    });
 
-    LOG_INFO("server.loading", "Loading Spell Proc Event Conditions...");
-    sSpellMgr->LoadSpellProcEvents();
+    loadGraph.AddTask("SpellLearnSkills", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Spell Learn Skills...");
+        sSpellMgr->LoadSpellLearnSkills();
+    });
 
-    LOG_INFO("server.loading", "Loading Spell Proc Conditions and Data...");
-    sSpellMgr->LoadSpellProcs();
+    loadGraph.AddTask("SpellProcEvents", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Spell Proc Event Conditions...");
+        sSpellMgr->LoadSpellProcEvents();
+    });
 
-    LOG_INFO("server.loading", "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonuses();
+    loadGraph.AddTask("SpellProcs", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Spell Proc Conditions and Data...");
+        sSpellMgr->LoadSpellProcs();
+    });
 
-    LOG_INFO("server.loading", "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
+    loadGraph.AddTask("SpellBonuses", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Spell Bonus Data...");
+        sSpellMgr->LoadSpellBonuses();
+    });
 
-    LOG_INFO("server.loading", "Loading Mixology Bonuses...");
-    sSpellMgr->LoadSpellMixology();
+    loadGraph.AddTask("SpellThreats", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Aggro Spells Definitions...");
+        sSpellMgr->LoadSpellThreats();
+    });
 
-    LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
+    loadGraph.AddTask("SpellMixology", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Mixology Bonuses...");
+        sSpellMgr->LoadSpellMixology();
+    });
 
-    LOG_INFO("server.loading", "Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
+    loadGraph.AddTask("SpellGroupStackRules", { "SpellGroups" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
+        sSpellMgr->LoadSpellGroupStackRules();
+    });
 
-    LOG_INFO("server.loading", "Loading Enchant Spells Proc Datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
+    loadGraph.AddTask("GossipText", { "GameLocale" }, []()
+    {
+        LOG_INFO("server.loading", "Loading NPC Texts...");
+        sObjectMgr->LoadGossipText();
+    });
 
-    LOG_INFO("server.loading", "Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+    loadGraph.AddTask("SpellEnchantProcData", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Enchant Spells Proc Datas...");
+        sSpellMgr->LoadSpellEnchantProcData();
+    });
 
-    LOG_INFO("server.loading", "Loading Disables");
-    DisableMgr::LoadDisables();                                  // must be before loading quests and items
+    loadGraph.AddTask("RandomEnchantments", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Item Random Enchantments Table...");
+        LoadRandomEnchantmentsTable();
+    });
 
-    LOG_INFO("server.loading", "Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr->LoadItemTemplates();
+    loadGraph.AddBarrier("Disables", []()
+    {
+        LOG_INFO("server.loading", "Loading Disables");
+        DisableMgr::LoadDisables(); // must be before loading quests and items
+    });
 
-    LOG_INFO("server.loading", "Loading Item Set Names...");                // must be after LoadItemPrototypes
-    sObjectMgr->LoadItemSetNames();
+    loadGraph.AddTask("ItemTemplates", { "RandomEnchantments", "PageTexts" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Items...");
+        sObjectMgr->LoadItemTemplates();
+    });
 
-    LOG_INFO("server.loading", "Loading Creature Model Based Info Data...");
-    sObjectMgr->LoadCreatureModelInfo();
+    loadGraph.AddTask("ItemSetNames", { "ItemTemplates" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Item Set Names...");
+        sObjectMgr->LoadItemSetNames();
+    });
 
-    LOG_INFO("server.loading", "Loading Creature Custom IDs Config...");
-    sObjectMgr->LoadCreatureCustomIDs();
+    loadGraph.AddTask("CreatureModelInfo", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Creature Model Based Info Data...");
+        sObjectMgr->LoadCreatureModelInfo();
+    });
 
-    LOG_INFO("server.loading", "Loading Creature Templates...");
-    sObjectMgr->LoadCreatureTemplates();
+    loadGraph.AddTask("CreatureCustomIDs", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Creature Custom IDs Config...");
+        sObjectMgr->LoadCreatureCustomIDs();
+    });
 
-    LOG_INFO("server.loading", "Loading Equipment Templates...");           // must be after LoadCreatureTemplates
-    sObjectMgr->LoadEquipmentTemplates();
+    loadGraph.AddTask("CreatureTemplates", { "CreatureModelInfo", "CreatureCustomIDs" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Creature Templates...");
+        sObjectMgr->LoadCreatureTemplates();
+    });
 
-    LOG_INFO("server.loading", "Loading Creature Template Addons...");
-    sObjectMgr->LoadCreatureTemplateAddons();
+    loadGraph.AddTask("EquipmentTemplates", { "CreatureTemplates", "ItemTemplates" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Equipment Templates...");
+        sObjectMgr->LoadEquipmentTemplates();
+    });
 
-    LOG_INFO("server.loading", "Loading Reputation Reward Rates...");
-    sObjectMgr->LoadReputationRewardRate();
+    loadGraph.AddTask("CreatureTemplateAddons", { "CreatureTemplates" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Creature Template Addons...");
+        sObjectMgr->LoadCreatureTemplateAddons();
+    });
 
-    LOG_INFO("server.loading", "Loading Creature Reputation OnKill Data...");
-    sObjectMgr->LoadReputationOnKill();
+    loadGraph.AddTask("ReputationRewardRate", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Reputation Reward Rates...");
+        sObjectMgr->LoadReputationRewardRate();
+    });
 
-    LOG_INFO("server.loading", "Loading Reputation Spillover Data..." );
-    sObjectMgr->LoadReputationSpilloverTemplate();
+    loadGraph.AddTask("ReputationOnKill", { "CreatureTemplates" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Creature Reputation OnKill Data...");
+        sObjectMgr->LoadReputationOnKill();
+    });
 
-    LOG_INFO("server.loading", "Loading Points Of Interest Data...");
-    sObjectMgr->LoadPointsOfInterest();
+    loadGraph.AddTask("ReputationSpilloverTemplate", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Reputation Spillover Data...");
+        sObjectMgr->LoadReputationSpilloverTemplate();
+    });
 
-    LOG_INFO("server.loading", "Loading Creature Base Stats...");
-    sObjectMgr->LoadCreatureClassLevelStats();
+    loadGraph.AddTask("PointsOfInterest", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Points Of Interest Data...");
+        sObjectMgr->LoadPointsOfInterest();
+    });
 
-    LOG_INFO("server.loading", "Loading Creature Data...");
-    sObjectMgr->LoadCreatures();
+    loadGraph.AddTask("CreatureClassLevelStats", { "CreatureTemplates" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Creature Base Stats...");
+        sObjectMgr->LoadCreatureClassLevelStats();
+    });
 
-    LOG_INFO("server.loading", "Loading Temporary Summon Data...");
-    sObjectMgr->LoadTempSummons();                               // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
+    loadGraph.AddTask("Creatures", { "CreatureTemplates", "EquipmentTemplates", "CreatureTemplateAddons" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Creature Data...");
+        sObjectMgr->LoadCreatures();
+    });
 
-    LOG_INFO("server.loading", "Loading Pet Levelup Spells...");
-    sSpellMgr->LoadPetLevelupSpellMap();
+    loadGraph.AddTask("TempSummons", { "CreatureTemplates", "GameObjectTemplates" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Temporary Summon Data...");
+        sObjectMgr->LoadTempSummons();
+    });
 
-    LOG_INFO("server.loading", "Loading Pet default Spells additional to Levelup Spells...");
-    sSpellMgr->LoadPetDefaultSpells();
+    loadGraph.AddTask("PetLevelupSpells", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Pet Levelup Spells...");
+        sSpellMgr->LoadPetLevelupSpellMap();
+    });
 
-    LOG_INFO("server.loading", "Loading Creature Addon Data...");
-    sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
+    loadGraph.AddTask("PetDefaultSpells", { "CreatureTemplates", "PetLevelupSpells" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Pet default Spells additional to Levelup Spells...");
+        sSpellMgr->LoadPetDefaultSpells();
+    });
 
-    LOG_INFO("server.loading", "Loading Creature Movement Overrides...");
-    sObjectMgr->LoadCreatureMovementOverrides(); // must be after LoadCreatures()
+    loadGraph.AddTask("CreatureAddons", { "Creatures" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Creature Addon Data...");
+        sObjectMgr->LoadCreatureAddons(); // changes creature data
+    });
 
-    LOG_INFO("server.loading", "Loading Gameobject Data...");
-    sObjectMgr->LoadGameobjects();
+    loadGraph.AddTask("CreatureMovementOverrides", { "CreatureAddons" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Creature Movement Overrides...");
+        sObjectMgr->LoadCreatureMovementOverrides();
+    });
 
-    LOG_INFO("server.loading", "Loading GameObject Addon Data...");
-    sObjectMgr->LoadGameObjectAddons();                          // must be after LoadGameObjectTemplate() and LoadGameobjects()
+    loadGraph.AddTask("Gameobjects", { "Creatures", "GameObjectTemplateAddons" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Gameobject Data...");
+        sObjectMgr->LoadGameobjects(); // same grid store as creatures
+    });
 
-    LOG_INFO("server.loading", "Loading GameObject Quest Items...");
-    sObjectMgr->LoadGameObjectQuestItems();
+    loadGraph.AddTask("GameObjectAddons", { "Gameobjects" }, []()
+    {
+        LOG_INFO("server.loading", "Loading GameObject Addon Data...");
+        sObjectMgr->LoadGameObjectAddons();
+    });
 
-    LOG_INFO("server.loading", "Loading Creature Quest Items...");
-    sObjectMgr->LoadCreatureQuestItems();
+    loadGraph.AddTask("GameObjectQuestItems", { "GameObjectTemplates", "ItemTemplates" }, []()
+    {
+        LOG_INFO("server.loading", "Loading GameObject Quest Items...");
+        sObjectMgr->LoadGameObjectQuestItems();
+    });
 
-    LOG_INFO("server.loading", "Loading Creature Linked Respawn...");
-    sObjectMgr->LoadLinkedRespawn();                             // must be after LoadCreatures(), LoadGameObjects()
+    loadGraph.AddTask("CreatureQuestItems", { "CreatureTemplates", "ItemTemplates" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Creature Quest Items...");
+        sObjectMgr->LoadCreatureQuestItems();
+    });
 
-    LOG_INFO("server.loading", "Loading Weather Data...");
-    WeatherMgr::LoadWeatherData();
+    loadGraph.AddTask("LinkedRespawn", { "CreatureAddons", "GameObjectAddons" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Creature Linked Respawn...");
+        sObjectMgr->LoadLinkedRespawn();
+    });
 
-    LOG_INFO("server.loading", "Loading Quests...");
-    sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
+    loadGraph.AddTask("WeatherData", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Weather Data...");
+        WeatherMgr::LoadWeatherData();
+    });
+
+    loadGraph.AddTask("Quests", { "ItemTemplates", "CreatureTemplates", "Gameobjects" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Quests...");
+        sObjectMgr->LoadQuests();
+    });
 
-    LOG_INFO("server.loading", "Checking Quest Disables");
-    DisableMgr::CheckQuestDisables();                           // must be after loading quests
+    loadGraph.AddBarrier("QuestDisables", []()
+    {
+        LOG_INFO("server.loading", "Checking Quest Disables");
+        DisableMgr::CheckQuestDisables(); // changes disables
+    });
 
-    LOG_INFO("server.loading", "Loading Quest POI");
-    sObjectMgr->LoadQuestPOI();
+    loadGraph.AddTask("QuestPOI", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Quest POI");
+        sObjectMgr->LoadQuestPOI();
+    });
 
-    // Loading Quests Starters and Enders
-    sObjectMgr->LoadQuestStartersAndEnders();                    // must be after quest load
+    loadGraph.AddTask("QuestStartersAndEnders", {}, []()
+    {
+        sObjectMgr->LoadQuestStartersAndEnders();
+    });
 
-    LOG_INFO("server.loading", "Loading Quest Greetings...");
-    sObjectMgr->LoadQuestGreetings();                               // must be loaded after creature_template, gameobject_template tables
+    loadGraph.AddTask("QuestGreetings", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Quest Greetings...");
+        sObjectMgr->LoadQuestGreetings();
+    });
 
-    //LOG_INFO("server.loading", "Loading Quest Greeting Locales...");
-    //sObjectMgr->LoadQuestGreetingsLocales();                        // must be loaded after creature_template, gameobject_template tables
+    loadGraph.AddTask("QuestMoneyRewards", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Quest Money Rewards...");
+        sObjectMgr->LoadQuestMoneyRewards();
+    });
 
-    LOG_INFO("server.loading", "Loading Quest Money Rewards...");
-    sObjectMgr->LoadQuestMoneyRewards();
+    loadGraph.AddBarrier("Pools", []()
+    {
+        LOG_INFO("server.loading", "Loading Objects Pooling Data...");
+        sPoolMgr->LoadFromDB();
+    });
 
-    LOG_INFO("server.loading", "Loading Objects Pooling Data...");
-    sPoolMgr->LoadFromDB();
+    loadGraph.AddBarrier("GameEvents", []()
+    {
+        LOG_INFO("server.loading", "Loading Game Event Data...");
+        sGameEventMgr->LoadHolidayDates(); // Must be after loading DBC
+        sGameEventMgr->LoadFromDB();       // Must be after loading holiday dates, changes quests
+    });
 
-    LOG_INFO("server.loading", "Loading Game Event Data...");               // must be after loading pools fully
-    sGameEventMgr->LoadHolidayDates();                           // Must be after loading DBC
-    sGameEventMgr->LoadFromDB();                                 // Must be after loading holiday dates
+    loadGraph.AddBarrier("NPCSpellClickSpells", []()
+    {
+        LOG_INFO("server.loading", "Loading UNIT_NPC_FLAG_SPELLCLICK Data...");
+        sObjectMgr->LoadNPCSpellClickSpells(); // changes creature templates
+    });
 
-    LOG_INFO("server.loading", "Loading UNIT_NPC_FLAG_SPELLCLICK Data..."); // must be after LoadQuests
-    sObjectMgr->LoadNPCSpellClickSpells();
+    loadGraph.AddTask("VehicleTemplateAccessories", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Vehicle Template Accessories...");
+        sObjectMgr->LoadVehicleTemplateAccessories();
+    });
 
-    LOG_INFO("server.loading", "Loading Vehicle Template Accessories...");
-    sObjectMgr->LoadVehicleTemplateAccessories();                // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
+    loadGraph.AddTask("VehicleAccessories", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Vehicle Accessories...");
+        sObjectMgr->LoadVehicleAccessories();
+    });
 
-    LOG_INFO("server.loading", "Loading Vehicle Accessories...");
-    sObjectMgr->LoadVehicleAccessories();                       // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
+    loadGraph.AddBarrier("SpellAreas", []()
+    {
+        LOG_INFO("server.loading", "Loading SpellArea Data...");
+        sSpellMgr->LoadSpellAreas(); // changes spell infos
+    });
 
-    LOG_INFO("server.loading", "Loading SpellArea Data...");                // must be after quest load
-    sSpellMgr->LoadSpellAreas();
+    loadGraph.AddTask("AreaTriggers", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Area Trigger Definitions");
+        sObjectMgr->LoadAreaTriggers();
+    });
 
-    LOG_INFO("server.loading", "Loading Area Trigger Definitions");
-    sObjectMgr->LoadAreaTriggers();
+    loadGraph.AddTask("AreaTriggerTeleports", { "AreaTriggers" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Area Trigger Teleport Definitions...");
+        sObjectMgr->LoadAreaTriggerTeleports();
+    });
 
-    LOG_INFO("server.loading", "Loading Area Trigger Teleport Definitions...");
-    sObjectMgr->LoadAreaTriggerTeleports();
+    loadGraph.AddTask("AccessRequirements", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Access Requirements...");
+        sObjectMgr->LoadAccessRequirements();
+    });
 
-    LOG_INFO("server.loading", "Loading Access Requirements...");
-    sObjectMgr->LoadAccessRequirements();                        // must be after item template load
+    loadGraph.AddTask("QuestAreaTriggers", { "AreaTriggers" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Quest Area Triggers...");
+        sObjectMgr->LoadQuestAreaTriggers();
+    });
 
-    LOG_INFO("server.loading", "Loading Quest Area Triggers...");
-    sObjectMgr->LoadQuestAreaTriggers();                         // must be after LoadQuests
+    loadGraph.AddTask("TavernAreaTriggers", { "AreaTriggers" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Tavern Area Triggers...");
+        sObjectMgr->LoadTavernAreaTriggers();
+    });
 
-    LOG_INFO("server.loading", "Loading Tavern Area Triggers...");
-    sObjectMgr->LoadTavernAreaTriggers();
+    loadGraph.AddTask("AreaTriggerScripts", { "AreaTriggers" }, []()
+    {
+        LOG_INFO("server.loading", "Loading AreaTrigger Script Names...");
+        sObjectMgr->LoadAreaTriggerScripts();
+    });
 
-    LOG_INFO("server.loading", "Loading AreaTrigger Script Names...");
-    sObjectMgr->LoadAreaTriggerScripts();
+    loadGraph.AddTask("LFGDungeons", { "AreaTriggerTeleports", "AccessRequirements" }, []()
+    {
+        LOG_INFO("server.loading", "Loading LFG Entrance Positions...");
+        sLFGMgr->LoadLFGDungeons();
+    });
 
-    LOG_INFO("server.loading", "Loading LFG Entrance Positions..."); // Must be after areatriggers
-    sLFGMgr->LoadLFGDungeons();
+    loadGraph.AddBarrier("InstanceEncounters", []()
+    {
+        LOG_INFO("server.loading", "Loading Dungeon Boss Data...");
+        sObjectMgr->LoadInstanceEncounters(); // changes creature templates and spell infos
+    });
 
-    LOG_INFO("server.loading", "Loading Dungeon Boss Data...");
-    sObjectMgr->LoadInstanceEncounters();
+    loadGraph.AddTask("LFGRewards", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading LFG Rewards...");
+        sLFGMgr->LoadRewards();
+    });
 
-    LOG_INFO("server.loading", "Loading LFG Rewards...");
-    sLFGMgr->LoadRewards();
+    loadGraph.AddTask("GraveyardZones", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Graveyard-Zone Links...");
+        sGraveyard->LoadGraveyardZones();
+    });
 
-    LOG_INFO("server.loading", "Loading Graveyard-Zone Links...");
-    sGraveyard->LoadGraveyardZones();
+    loadGraph.AddTask("SpellPetAuras", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Spell Pet Auras...");
+        sSpellMgr->LoadSpellPetAuras();
+    });
 
-    LOG_INFO("server.loading", "Loading Spell Pet Auras...");
-    sSpellMgr->LoadSpellPetAuras();
+    loadGraph.AddTask("SpellTargetPositions", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Spell Target Coordinates...");
+        sSpellMgr->LoadSpellTargetPositions();
+    });
 
-    LOG_INFO("server.loading", "Loading Spell Target Coordinates...");
-    sSpellMgr->LoadSpellTargetPositions();
+    loadGraph.AddTask("EnchantCustomAttributes", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Enchant Custom Attributes...");
+        sSpellMgr->LoadEnchantCustomAttr();
+    });
 
-    LOG_INFO("server.loading", "Loading Enchant Custom Attributes...");
-    sSpellMgr->LoadEnchantCustomAttr();
+    loadGraph.AddTask("SpellLinked", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading linked Spells...");
+        sSpellMgr->LoadSpellLinked();
+    });
 
-    LOG_INFO("server.loading", "Loading linked Spells...");
-    sSpellMgr->LoadSpellLinked();
+    loadGraph.AddTask("PlayerInfo", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Player Create Data...");
+        sObjectMgr->LoadPlayerInfo();
+    });
 
-    LOG_INFO("server.loading", "Loading Player Create Data...");
-    sObjectMgr->LoadPlayerInfo();
+    loadGraph.AddTask("ExplorationBaseXP", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Exploration BaseXP Data...");
+        sObjectMgr->LoadExplorationBaseXP();
+    });
 
-    LOG_INFO("server.loading", "Loading Exploration BaseXP Data...");
-    sObjectMgr->LoadExplorationBaseXP();
+    loadGraph.AddTask("PetNames", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Pet Name Parts...");
+        sObjectMgr->LoadPetNames();
+    });
 
-    LOG_INFO("server.loading", "Loading Pet Name Parts...");
-    sObjectMgr->LoadPetNames();
+    loadGraph.AddTask("CharacterDatabaseCleaner", {}, []()
+    {
+        CharacterDatabaseCleaner::CleanDatabase();
+    });
 
-    CharacterDatabaseCleaner::CleanDatabase();
+    loadGraph.AddTask("PetNumber", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading The Max Pet Number...");
+        sObjectMgr->LoadPetNumber();
+    });
 
-    LOG_INFO("server.loading", "Loading The Max Pet Number...");
-    sObjectMgr->LoadPetNumber();
+    loadGraph.AddTask("PetLevelInfo", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Pet Level Stats...");
+        sObjectMgr->LoadPetLevelInfo();
+    });
 
-    LOG_INFO("server.loading", "Loading Pet Level Stats...");
-    sObjectMgr->LoadPetLevelInfo();
+    loadGraph.AddTask("MailLevelRewards", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Player Level Dependent Mail Rewards...");
+        sObjectMgr->LoadMailLevelRewards();
+    });
 
-    LOG_INFO("server.loading", "Loading Player Level Dependent Mail Rewards...");
-    sObjectMgr->LoadMailLevelRewards();
+    loadGraph.AddTask("MailServerTemplates", {}, []()
+    {
+        LOG_INFO("server.loading", "Load Mail Server Template...");
+        sObjectMgr->LoadMailServerTemplates();
+    });
 
-    LOG_INFO("server.loading", "Load Mail Server Template...");
-    sObjectMgr->LoadMailServerTemplates();
+    loadGraph.AddTask("LootTables", {}, []()
+    {
+        LoadLootTables();
+    });
 
-    // Loot tables
-    LoadLootTables();
+    loadGraph.AddTask("SkillDiscovery", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Skill Discovery Table...");
+        LoadSkillDiscoveryTable();
+    });
 
-    LOG_INFO("server.loading", "Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
+    loadGraph.AddTask("SkillExtraItems", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
+        LoadSkillExtraItemTable();
+    });
 
-    LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
+    loadGraph.AddTask("SkillPerfectItems", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Skill Perfection Data Table...");
+        LoadSkillPerfectItemTable();
+    });
 
-    LOG_INFO("server.loading", "Loading Skill Perfection Data Table...");
-    LoadSkillPerfectItemTable();
+    loadGraph.AddTask("FishingBaseSkillLevel", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Skill Fishing Base Level Requirements...");
+        sObjectMgr->LoadFishingBaseSkillLevel();
+    });
 
-    LOG_INFO("server.loading", "Loading Skill Fishing Base Level Requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
+    loadGraph.AddTask("AchievementReferenceList", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Achievements...");
+        sAchievementMgr->LoadAchievementReferenceList();
+    });
 
-    LOG_INFO("server.loading", "Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
+    loadGraph.AddTask("AchievementCriteriaList", { "AchievementReferenceList" }, []()
+    {
+        LOG_INFO("server", "Loading Achievement Criteria Lists...");
+        sAchievementMgr->LoadAchievementCriteriaList();
+    });
 
-    LOG_INFO("server", "Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
+    loadGraph.AddTask("AchievementCriteriaData", { "AchievementCriteriaList" }, []()
+    {
+        LOG_INFO("server", "Loading Achievement Criteria Data...");
+        sAchievementMgr->LoadAchievementCriteriaData();
+    });
 
-    LOG_INFO("server", "Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
+    loadGraph.AddTask("AchievementRewards", { "AchievementReferenceList" }, []()
+    {
+        LOG_INFO("server", "Loading Achievement Rewards...");
+        sAchievementMgr->LoadRewards();
+    });
 
-    LOG_INFO("server", "Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
+    loadGraph.AddTask("CompletedAchievements", { "AchievementReferenceList" }, []()
+    {
+        LOG_INFO("server", "Loading Completed Achievements...");
+        sAchievementMgr->LoadCompletedAchievements();
+    });
 
-    LOG_INFO("server", "Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    loadGraph.AddBarrier("Auctions", []()
+    {
+        LOG_INFO("server.loading", "Loading Item Auctions...");
+        sAuctionMgr->LoadAuctionItems();
 
-    ///- Load dynamic data tables from the database
-    LOG_INFO("server.loading", "Loading Item Auctions...");
-    sAuctionMgr->LoadAuctionItems();
+        LOG_INFO("server", "Loading Auctions...");
+        sAuctionMgr->LoadAuctions();
+    });
 
-    LOG_INFO("server", "Loading Auctions...");
-    sAuctionMgr->LoadAuctions();
+    loadGraph.AddBarrier("Guilds", []()
+    {
+        sGuildMgr->LoadGuilds();
+    });
 
-    sGuildMgr->LoadGuilds();
+    loadGraph.AddBarrier("ArenaTeams", []()
+    {
+        LOG_INFO("server.loading", "Loading ArenaTeams...");
+        sArenaTeamMgr->LoadArenaTeams();
+    });
 
-    LOG_INFO("server.loading", "Loading ArenaTeams...");
-    sArenaTeamMgr->LoadArenaTeams();
+    loadGraph.AddBarrier("Groups", []()
+    {
+        LOG_INFO("server.loading", "Loading Groups...");
+        sGroupMgr->LoadGroups();
+    });
 
-    LOG_INFO("server.loading", "Loading Groups...");
-    sGroupMgr->LoadGroups();
+    loadGraph.AddTask("ReservedPlayersNames", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Reserved Names...");
+        sObjectMgr->LoadReservedPlayersNames();
+    });
 
-    LOG_INFO("server.loading", "Loading Reserved Names...");
-    sObjectMgr->LoadReservedPlayersNames();
+    loadGraph.AddTask("ProfanityPlayersNames", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Profanity Names...");
+        sObjectMgr->LoadProfanityPlayersNames();
+    });
 
-    LOG_INFO("server.loading", "Loading Profanity Names...");
-    sObjectMgr->LoadProfanityPlayersNames();
+    loadGraph.AddBarrier("GameObjectForQuests", []()
+    {
+        LOG_INFO("server.loading", "Loading GameObjects for Quests...");
+        sObjectMgr->LoadGameObjectForQuests(); // changes gameobject templates
+    });
 
-    LOG_INFO("server.loading", "Loading GameObjects for Quests...");
-    sObjectMgr->LoadGameObjectForQuests();
+    loadGraph.AddBarrier("BattleMasters", []()
+    {
+        LOG_INFO("server.loading", "Loading BattleMasters...");
+        sBattlegroundMgr->LoadBattleMastersEntry(); // changes creature templates
+    });
 
-    LOG_INFO("server.loading", "Loading BattleMasters...");
-    sBattlegroundMgr->LoadBattleMastersEntry();
+    loadGraph.AddTask("GameTele", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading GameTeleports...");
+        sObjectMgr->LoadGameTele();
+    });
 
-    LOG_INFO("server.loading", "Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
+    loadGraph.AddTask("GossipMenu", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Gossip Menu...");
+        sObjectMgr->LoadGossipMenu();
+    });
 
-    LOG_INFO("server.loading", "Loading Gossip Menu...");
-    sObjectMgr->LoadGossipMenu();
+    loadGraph.AddTask("GossipMenuItems", { "GossipMenu" }, []()
+    {
+        LOG_INFO("server.loading", "Loading Gossip Menu Options...");
+        sObjectMgr->LoadGossipMenuItems();
+    });
 
-    LOG_INFO("server.loading", "Loading Gossip Menu Options...");
-    sObjectMgr->LoadGossipMenuItems();
+    loadGraph.AddTask("Vendors", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Vendors...");
+        sObjectMgr->LoadVendors();
+    });
 
-    LOG_INFO("server.loading", "Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
+    loadGraph.AddTask("TrainerSpell", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Trainers...");
+        sObjectMgr->LoadTrainerSpell();
+    });
 
-    LOG_INFO("server.loading", "Loading Trainers...");
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
+    loadGraph.AddTask("Waypoints", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Waypoints...");
+        sWaypointMgr->Load();
+    });
 
-    LOG_INFO("server.loading", "Loading Waypoints...");
-    sWaypointMgr->Load();
+    loadGraph.AddTask("SmartWaypoints", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
+        sSmartWaypointMgr->LoadFromDB();
+    });
 
-    LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
+    loadGraph.AddTask("CreatureFormations", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Creature Formations...");
+        sFormationMgr->LoadCreatureFormations();
+    });
 
-    LOG_INFO("server.loading", "Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
+    loadGraph.AddTask("WorldStates", { "CharacterDatabaseCleaner" }, [this]()
+    {
+        LOG_INFO("server.loading", "Loading World States...");
+        LoadWorldStates(); // must be loaded before battleground, outdoor PvP and conditions, after cleaning flags are saved
+    });
 
-    LOG_INFO("server.loading", "Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
-    LoadWorldStates();
+    loadGraph.AddBarrier("Conditions", []()
+    {
+        LOG_INFO("server.loading", "Loading Conditions...");
+        sConditionMgr->LoadConditions(); // changes loot, gossip, vendor and spell data
+    });
 
-    LOG_INFO("server.loading", "Loading Conditions...");
-    sConditionMgr->LoadConditions();
+    loadGraph.AddTask("FactionChangeAchievements", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Faction Change Achievement Pairs...");
+        sObjectMgr->LoadFactionChangeAchievements();
+    });
 
-    LOG_INFO("server.loading", "Loading Faction Change Achievement Pairs...");
-    sObjectMgr->LoadFactionChangeAchievements();
+    loadGraph.AddTask("FactionChangeSpells", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Faction Change Spell Pairs...");
+        sObjectMgr->LoadFactionChangeSpells();
+    });
 
-    LOG_INFO("server.loading", "Loading Faction Change Spell Pairs...");
-    sObjectMgr->LoadFactionChangeSpells();
+    loadGraph.AddTask("FactionChangeItems", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Faction Change Item Pairs...");
+        sObjectMgr->LoadFactionChangeItems();
+    });
 
-    LOG_INFO("server.loading", "Loading Faction Change Item Pairs...");
-    sObjectMgr->LoadFactionChangeItems();
+    loadGraph.AddTask("FactionChangeReputations", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Faction Change Reputation Pairs...");
+        sObjectMgr->LoadFactionChangeReputations();
+    });
 
-    LOG_INFO("server.loading", "Loading Faction Change Reputation Pairs...");
-    sObjectMgr->LoadFactionChangeReputations();
+    loadGraph.AddTask("FactionChangeTitles", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Faction Change Title Pairs...");
+        sObjectMgr->LoadFactionChangeTitles();
+    });
 
-    LOG_INFO("server.loading", "Loading Faction Change Title Pairs...");
-    sObjectMgr->LoadFactionChangeTitles();
+    loadGraph.AddTask("FactionChangeQuests", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Faction Change Quest Pairs...");
+        sObjectMgr->LoadFactionChangeQuests();
+    });
 
-    LOG_INFO("server.loading", "Loading Faction Change Quest Pairs...");
-    sObjectMgr->LoadFactionChangeQuests();
+    loadGraph.AddTask("Tickets", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading GM Tickets...");
+        sTicketMgr->LoadTickets();
+    });
 
-    LOG_INFO("server.loading", "Loading GM Tickets...");
-    sTicketMgr->LoadTickets();
+    loadGraph.AddTask("Surveys", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading GM Surveys...");
+        sTicketMgr->LoadSurveys();
+    });
 
-    LOG_INFO("server.loading", "Loading GM Surveys...");
-    sTicketMgr->LoadSurveys();
+    loadGraph.AddTask("ClientAddons", {}, []()
+    {
+        LOG_INFO("server.loading", "Loading Client Addons...");
+        AddonMgr::LoadFromDB();
+    });
 
-    LOG_INFO("server.loading", "Loading Client Addons...");
-    AddonMgr::LoadFromDB();
+    RunLoadGraph(loadGraph);
 
     // pussywizard:
     LOG_INFO("server.loading", "Deleting Invalid Mail Items...");
@@ -1113,8 +1476,6 @@ void World::SetInitialWorldSettings()
     // our speed up
     _timers[WUPDATE_5_SECS].SetInterval(5 * IN_MILLISECONDS);
 
-    _timers[WUPDATE_WHO_LIST].SetInterval(5 * IN_MILLISECONDS); // update who list cache every 5 seconds
-
     _mail_expire_check_timer = GameTime::GetGameTime() + 6h;
 
     ///- Initialize MapMgr
@@ -1316,14 +1677,6 @@ void World::Update(uint32 diff)
         CharacterDatabase.Execute(stmt);
     }
 
-    ///- Update Who List Cache
-    if (_timers[WUPDATE_WHO_LIST].Passed())
-    {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update who list"));
-        _timers[WUPDATE_WHO_LIST].Reset();
-        sWhoListCacheMgr->Update();
-    }
-
     {
         METRIC_TIMER("world_update_time", METRIC_TAG("type", "Check quest reset times"));
 
@@ -1520,6 +1873,11 @@ void World::Update(uint32 diff)
         playersSaveScheduler.Update(diff);
     }
 
+    {
+        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update character cache"));
+        sCharacterCache->Update();
+    }
+
     {
         METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update external mail system"));
         sExternalMail->Update(diff);
@@ -1554,6 +1912,7 @@ void World::ForceGameEventUpdate()
 /// Send a packet to all players (except self if mentioned)
 void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, TeamId teamId)
 {
+    SharedWorldPacket sharedPacket;
     SessionMap::const_iterator itr;
     for (itr = _sessions.begin(); itr != _sessions.end(); ++itr)
     {
@@ -1563,7 +1922,7 @@ void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, Tea
                 itr->second != self &&
                 (teamId == TEAM_NEUTRAL || itr->second->GetPlayer()->GetTeamId() == teamId))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(packet, sharedPacket);
         }
     }
 }
@@ -1571,6 +1930,7 @@ void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, Tea
 /// Send a packet to all GMs (except self if mentioned)
 void World::SendGlobalGMMessage(WorldPacket const* packet, WorldSession* self, TeamId teamId)
 {
+    SharedWorldPacket sharedPacket;
     SessionMap::iterator itr;
     for (itr = _sessions.begin(); itr != _sessions.end(); ++itr)
     {
@@ -1581,7 +1941,7 @@ void World::SendGlobalGMMessage(WorldPacket const* packet, WorldSession* self, T
                 !AccountMgr::IsPlayerAccount(itr->second->GetSecurity()) &&
                 (teamId == TEAM_NEUTRAL || itr->second->GetPlayer()->GetTeamId() == teamId))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(packet, sharedPacket);
         }
     }
 }
@@ -1601,6 +1961,7 @@ void World::SendGlobalText(std::string_view text, WorldSession* self)
 /// Send a packet to all players (or players selected team) in the zone (except self if mentioned)
 bool World::SendZoneMessage(uint32 zone, WorldPacket const* packet, WorldSession* self, TeamId teamId)
 {
+    SharedWorldPacket sharedPacket;
     bool foundPlayerToSend = false;
     SessionMap::const_iterator itr;
 
@@ -1613,7 +1974,7 @@ bool World::SendZoneMessage(uint32 zone, WorldPacket const* packet, WorldSession
                 itr->second != self &&
                 (teamId == TEAM_NEUTRAL || itr->second->GetPlayer()->GetTeamId() == teamId))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(packet, sharedPacket);
             foundPlayerToSend = true;
         }
     }
@@ -1880,10 +2241,15 @@ void World::UpdateSessions(uint32 diff)
             continue;
         }
 
-        [[maybe_unused]] uint32 currentSessionId = itr->first;
-        METRIC_DETAILED_TIMER("world_update_sessions_time", METRIC_TAG("account_id", std::to_string(currentSessionId)));
+        bool updated;
+
+        {
+            // Timer must log before the session is deleted
+            METRIC_DETAILED_SERIES_TIMER(pSession->GetUpdateMetricSeries(), "world_update_sessions_time", METRIC_TAG("account_id", std::to_string(pSession->GetAccountId())));
+            updated = pSession->Update(diff, updater);
+        }
 
-        if (!pSession->Update(diff, updater))
+        if (!updated)
         {
             if (!RemoveQueuedPlayer(pSession) && CONF_GET_INT("DisconnectToleranceInterval"))
                 _disconnects[pSession->GetAccountId()] = GameTime::GetGameTime().count();
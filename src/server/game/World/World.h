@@ -95,7 +95,6 @@ enum WorldTimers
     WUPDATE_EVENTS,
     WUPDATE_AUTOBROADCAST,
     WUPDATE_5_SECS,
-    WUPDATE_WHO_LIST,
     WUPDATE_CHECK_FILECHANGES,
     WUPDATE_COUNT
 };
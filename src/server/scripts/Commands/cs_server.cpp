@@ -34,6 +34,7 @@
 #include "ModuleMgr.h"
 #include "MotdMgr.h"
 #include "Player.h"
+#include "PlayerSaveStats.h"
 #include "Realm.h"
 #include "ScriptObject.h"
 #include "StringConvert.h"
@@ -97,6 +98,7 @@ public:
             { "info",         HandleServerInfoCommand,           SEC_PLAYER,        Console::Yes },
             { "motd",         HandleServerMotdCommand,           SEC_PLAYER,        Console::Yes },
             { "restart",      serverRestartCommandTable },
+            { "savestats",    HandleServerSaveStatsCommand,      SEC_ADMINISTRATOR, Console::Yes },
             { "shutdown",     serverShutdownCommandTable },
             { "set",          serverSetCommandTable }
         };
@@ -260,6 +262,22 @@ public:
 
         return true;
     }
+    // Display player save counters of each save section
+    static bool HandleServerSaveStatsCommand(ChatHandler* handler)
+    {
+        handler->PSendSysMessage("Player save sections (saves / skipped as unchanged / statements):");
+
+        for (uint8 i = 0; i < MAX_PLAYER_SAVE_SECTIONS; ++i)
+        {
+            PlayerSaveSection section = PlayerSaveSection(i);
+            PlayerSaveStats::SectionCounters counters = sPlayerSaveStats->GetCounters(section);
+
+            handler->PSendSysMessage("{}: {} / {} / {}", PlayerSaveStats::GetSectionName(section), counters.Saves, counters.Skipped, counters.Statements);
+        }
+
+        return true;
+    }
+
     // Display the 'Message of the day' for the realm
     static bool HandleServerMotdCommand(ChatHandler* handler)
     {
@@ -37,5 +37,5 @@ public:
 // Group all
 void AddSC_Discord()
 {
-    new Discord_Player();
+    RegisterHookedScript<Discord_Player>();
 }
@@ -131,8 +131,10 @@ public:
                         std::list<Unit*> meleeRangeTargets;
                         Unit* finalTarget = nullptr;
                         uint8 counter = 0;
-                        auto i = me->GetThreatMgr().GetThreatList().begin();
-                        for (; i != me->GetThreatMgr().GetThreatList().end(); ++i, ++counter)
+                        // adding threat may add pet owners to the threat list, iterate a copy
+                        ThreatContainer::StorageType threatList = me->GetThreatMgr().GetThreatList();
+                        auto i = threatList.begin();
+                        for (; i != threatList.end(); ++i, ++counter)
                         {
                             // Gather all units with melee range
                             Unit* target = (*i)->getTarget();
@@ -664,10 +664,10 @@ public:
             // some code to cast spell Mana Burn on random target which has mana
             if (ManaBurnTimer <= diff)
             {
-                std::list<HostileReference*> AggroList = me->GetThreatMgr().GetThreatList();
+                ThreatContainer::StorageType const& AggroList = me->GetThreatMgr().GetThreatList();
                 std::list<Unit*> UnitsWithMana;
 
-                for (std::list<HostileReference*>::const_iterator itr = AggroList.begin(); itr != AggroList.end(); ++itr)
+                for (ThreatContainer::StorageType::const_iterator itr = AggroList.begin(); itr != AggroList.end(); ++itr)
                 {
                     if (Unit* unit = ObjectAccessor::GetUnit(*me, (*itr)->getUnitGuid()))
                     {
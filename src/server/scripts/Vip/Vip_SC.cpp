@@ -138,6 +138,6 @@ public:
 void AddSC_Vip()
 {
     new Vip_World();
-    new Vip_Player();
+    RegisterHookedScript<Vip_Player>();
     new Vip_AllCreature();
 }
\ No newline at end of file
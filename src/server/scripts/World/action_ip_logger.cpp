@@ -321,6 +321,6 @@ public:
 void AddSC_action_ip_logger()
 {
     new AccountActionIpLogger();
-    new CharacterActionIpLogger();
-    new CharacterDeleteActionIpLogger();
+    RegisterHookedScript<CharacterActionIpLogger>();
+    RegisterHookedScript<CharacterDeleteActionIpLogger>();
 }
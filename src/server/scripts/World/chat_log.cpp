@@ -143,5 +143,5 @@ public:
 
 void AddSC_chat_log()
 {
-    new ChatLogScript();
+    RegisterHookedScript<ChatLogScript>();
 }
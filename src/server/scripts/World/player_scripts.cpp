@@ -71,5 +71,5 @@ public:
 
 void AddSC_player_scripts()
 {
-    new QuestApprenticeAnglerPlayerScript();
+    RegisterHookedScript<QuestApprenticeAnglerPlayerScript>();
 }
@@ -50,5 +50,5 @@ public:
 
 void AddSC_server_mail()
 {
-    new ServerMailReward();
+    RegisterHookedScript<ServerMailReward>();
 }
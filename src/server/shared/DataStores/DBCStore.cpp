@@ -17,6 +17,7 @@
 
 #include "DBCStore.h"
 #include "DBCDatabaseLoader.h"
+#include <cstdio>
 
 DBCStorageBase::DBCStorageBase(char const* fmt) : _fieldCount(0), _fileFormat(fmt), _dataTable(nullptr), _indexTableSize(0)
 {
@@ -29,45 +30,70 @@ DBCStorageBase::~DBCStorageBase()
         delete[] strings;
 }
 
-bool DBCStorageBase::Load(char const* path, char**& indexTable)
+bool DBCStorageBase::Load(char const* path, char**& indexTable, bool memoryMapped)
 {
     indexTable = nullptr;
 
-    DBCFileLoader dbc;
+    auto dbc = std::make_unique<DBCFileLoader>();
 
     // Check if load was sucessful, only then continue
-    if (!dbc.Load(path, _fileFormat))
+    if (!dbc->Load(path, _fileFormat, memoryMapped))
         return false;
 
-    _fieldCount = dbc.GetCols();
+    _fieldCount = dbc->GetCols();
 
-    // load raw non-string data
-    _dataTable = dbc.AutoProduceData(_fileFormat, _indexTableSize, indexTable);
+    if (dbc->CanUseRecordsInPlace(_fileFormat))
+    {
+        // records without strings are used straight from mapped file, only index is allocated
+        dbc->AutoProduceIndex(_fileFormat, _indexTableSize, indexTable);
+    }
+    else
+    {
+        // load raw non-string data
+        _dataTable = dbc->AutoProduceData(_fileFormat, _indexTableSize, indexTable);
 
-    // load strings from dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
-        _stringPool.push_back(stringBlock);
+        // load strings from dbc data
+        if (char* stringBlock = dbc->AutoProduceStrings(_fileFormat, _dataTable))
+            _stringPool.push_back(stringBlock);
+    }
+
+    if (dbc->IsMemoryMapped())
+        _mappedFiles.push_back(std::move(dbc));
 
     // error in dbc file at loading if nullptr
     return indexTable != nullptr;
 }
 
-bool DBCStorageBase::LoadStringsFrom(char const* path, char** indexTable)
+bool DBCStorageBase::LoadStringsFrom(char const* path, char** indexTable, bool memoryMapped)
 {
     // DBC must be already loaded using Load
     if (!indexTable)
         return false;
 
-    DBCFileLoader dbc;
+    // records used in place have no strings, locale file still must exist
+    if (!_dataTable)
+    {
+        FILE* f = fopen(path, "rb");
+        if (!f)
+            return false;
+
+        fclose(f);
+        return true;
+    }
+
+    auto dbc = std::make_unique<DBCFileLoader>();
 
     // Check if load was successful, only then continue
-    if (!dbc.Load(path, _fileFormat))
+    if (!dbc->Load(path, _fileFormat, memoryMapped))
         return false;
 
     // load strings from another locale dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
+    if (char* stringBlock = dbc->AutoProduceStrings(_fileFormat, _dataTable))
         _stringPool.push_back(stringBlock);
 
+    if (dbc->IsMemoryMapped())
+        _mappedFiles.push_back(std::move(dbc));
+
     return true;
 }
 
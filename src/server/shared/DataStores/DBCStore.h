@@ -21,8 +21,11 @@
 #include "DBCStorageIterator.h"
 #include "Errors.h"
 #include <cstring>
+#include <memory>
 #include <vector>
 
+class DBCFileLoader;
+
 /// Interface class for common access
 class WH_SHARED_API DBCStorageBase
 {
@@ -33,19 +36,20 @@ public:
     [[nodiscard]] char const* GetFormat() const { return _fileFormat; }
     [[nodiscard]] uint32 GetFieldCount() const { return _fieldCount; }
 
-    virtual bool Load(char const* path) = 0;
-    virtual bool LoadStringsFrom(char const* path) = 0;
+    virtual bool Load(char const* path, bool memoryMapped) = 0;
+    virtual bool LoadStringsFrom(char const* path, bool memoryMapped) = 0;
     virtual void LoadFromDB(char const* table, char const* format) = 0;
 
 protected:
-    bool Load(char const* path, char**& indexTable);
-    bool LoadStringsFrom(char const* path, char** indexTable);
+    bool Load(char const* path, char**& indexTable, bool memoryMapped);
+    bool LoadStringsFrom(char const* path, char** indexTable, bool memoryMapped);
     void LoadFromDB(char const* table, char const* format, char**& indexTable);
 
     uint32 _fieldCount;
     char const* _fileFormat;
     char* _dataTable;
     std::vector<char*> _stringPool;
+    std::vector<std::unique_ptr<DBCFileLoader>> _mappedFiles;   // records or strings used in place
     uint32 _indexTableSize;
 };
 
@@ -89,14 +93,14 @@ public:
 
     [[nodiscard]] uint32 GetNumRows() const { return _indexTableSize; }
 
-    bool Load(char const* path) override
+    bool Load(char const* path, bool memoryMapped) override
     {
-        return DBCStorageBase::Load(path, _indexTable.AsChar);
+        return DBCStorageBase::Load(path, _indexTable.AsChar, memoryMapped);
     }
 
-    bool LoadStringsFrom(char const* path) override
+    bool LoadStringsFrom(char const* path, bool memoryMapped) override
     {
-        return DBCStorageBase::LoadStringsFrom(path, _indexTable.AsChar);
+        return DBCStorageBase::LoadStringsFrom(path, _indexTable.AsChar, memoryMapped);
     }
 
     void LoadFromDB(char const* table, char const* format) override
@@ -20,10 +20,14 @@
 #include "DeadlineTimer.h"
 #include "IoContext.h"
 #include "IoContextMgr.h"
+#include "IpNetwork.h"
 #include "Log.h"
 #include "Resolver.h"
 #include "Util.h"
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/lexical_cast.hpp>
+
+RealmList::RealmList() : _realms(std::make_shared<RealmMap const>()) { }
 
 RealmList* RealmList::Instance()
 {
@@ -79,12 +83,12 @@ void RealmList::LoadBuildInfo()
     }
 }
 
-void RealmList::UpdateRealm(RealmHandle const& id, uint32 build, std::string const& name,
+void RealmList::UpdateRealm(RealmMap& realms, RealmHandle const& id, uint32 build, std::string const& name,
     boost::asio::ip::address&& address, boost::asio::ip::address&& localAddr, boost::asio::ip::address&& localSubmask,
     uint16 port, uint8 icon, RealmFlags flag, uint8 timezone, AccountTypes allowedSecurityLevel, float population)
 {
     // Create new if not exist or update existed
-    Realm& realm = _realms[id];
+    Realm& realm = realms[id];
 
     realm.Id = id;
     realm.Build = build;
@@ -118,10 +122,12 @@ void RealmList::UpdateRealms(boost::system::error_code const& error)
     auto result = AuthDatabase.Query(stmt);
 
     std::map<RealmHandle, std::string> existingRealms;
-    for (auto const& p : _realms)
+    // Realm list is replaced only by this timer
+    for (auto const& p : *_realms)
         existingRealms[p.first] = p.second.Name;
 
-    _realms.clear();
+    // Realms are resolved without lock, sessions keep using old realm list packets meanwhile
+    RealmMap realms;
 
     // Circle through results and add them to the realm map
     if (result)
@@ -174,7 +180,7 @@ void RealmList::UpdateRealms(boost::system::error_code const& error)
 
                 RealmHandle id{ realmId };
 
-                UpdateRealm(id, build, name, externalAddress->address(), localAddress->address(), localSubmask->address(), port, icon, flag,
+                UpdateRealm(realms, id, build, name, externalAddress->address(), localAddress->address(), localSubmask->address(), port, icon, flag,
                             timezone, (allowedSecurityLevel <= SEC_ADMINISTRATOR ? AccountTypes(allowedSecurityLevel) : SEC_ADMINISTRATOR), pop);
 
                 if (!existingRealms.count(id))
@@ -195,6 +201,16 @@ void RealmList::UpdateRealms(boost::system::error_code const& error)
     for (auto itr = existingRealms.begin(); itr != existingRealms.end(); ++itr)
         LOG_INFO("server.authserver", "Removed realm \"{}\".", itr->second);
 
+    {
+        std::lock_guard<std::mutex> guard(_realmsLock);
+
+        _realms = std::make_shared<RealmMap const>(std::move(realms));
+
+        // Rebuild packets of builds which were requested, others are built on first request
+        for (auto& [build, packet] : _realmListPackets)
+            packet = BuildRealmListPacket(build, packet->PostBC);
+    }
+
     if (_updateInterval)
     {
         _updateTimer->expires_from_now(boost::posix_time::seconds(_updateInterval));
@@ -202,11 +218,19 @@ void RealmList::UpdateRealms(boost::system::error_code const& error)
     }
 }
 
-Realm const* RealmList::GetRealm(RealmHandle const& id) const
+std::shared_ptr<RealmList::RealmMap const> RealmList::GetRealms() const
 {
-    auto itr = _realms.find(id);
-    if (itr != _realms.end())
-        return &itr->second;
+    std::lock_guard<std::mutex> guard(_realmsLock);
+    return _realms;
+}
+
+std::shared_ptr<Realm const> RealmList::GetRealm(RealmHandle const& id) const
+{
+    std::shared_ptr<RealmMap const> realms = GetRealms();
+
+    auto itr = realms->find(id);
+    if (itr != realms->end())
+        return { realms, &itr->second }; // keeps whole snapshot alive
 
     return nullptr;
 }
@@ -219,3 +243,98 @@ RealmBuildInfo const* RealmList::GetBuildInfo(uint32 build) const
 
     return nullptr;
 }
+
+std::shared_ptr<RealmListPacket const> RealmList::GetRealmListPacket(uint32 build, bool postBC)
+{
+    std::lock_guard<std::mutex> guard(_realmsLock);
+
+    auto& packet = _realmListPackets[build];
+    if (!packet)
+        packet = BuildRealmListPacket(build, postBC);
+
+    return packet;
+}
+
+std::shared_ptr<RealmListPacket const> RealmList::BuildRealmListPacket(uint32 build, bool postBC) const
+{
+    auto packet = std::make_shared<RealmListPacket>();
+    packet->Build = build;
+    packet->PostBC = postBC;
+
+    for (auto const& [realmHandle, realm] : *_realms)
+    {
+        // don't work with realms which not compatible with the client
+        bool okBuild = postBC ? realm.Build == build : (realm.Build > MAX_PRE_BC_CLIENT_BUILD || !GetBuildInfo(realm.Build));
+
+        uint32 flag = realm.Flags;
+        RealmBuildInfo const* buildInfo = GetBuildInfo(realm.Build);
+        if (!okBuild)
+        {
+            if (!buildInfo)
+                continue;
+
+            flag |= REALM_FLAG_OFFLINE | REALM_FLAG_SPECIFYBUILD;   // tell the client what build the realm is for
+        }
+
+        if (!buildInfo)
+            flag &= ~REALM_FLAG_SPECIFYBUILD;
+
+        std::string name = realm.Name;
+        if (!postBC && flag & REALM_FLAG_SPECIFYBUILD)
+            name = Warhead::StringFormat("{} ({}.{}.{})", name, buildInfo->MajorVersion, buildInfo->MinorVersion, buildInfo->BugfixVersion);
+
+        RealmListPacketEntry& entry = packet->Realms.emplace_back();
+        entry.Id = realm.Id;
+        entry.Type = realm.Type;
+        entry.AllowedSecurityLevel = realm.AllowedSecurityLevel;
+
+        entry.FlagsAndName << uint8(flag);
+        entry.FlagsAndName << name;
+
+        entry.Population << float(realm.PopulationLevel);
+
+        entry.Tail << uint8(realm.Timezone);                // realm category
+
+        if (postBC)                                         // 2.x and 3.x clients
+            entry.Tail << uint8(realm.Id.Realm);
+        else
+            entry.Tail << uint8(0x0);                       // 1.12.1 and 1.12.2 clients
+
+        if (postBC && flag & REALM_FLAG_SPECIFYBUILD)
+        {
+            entry.Tail << uint8(buildInfo->MajorVersion);
+            entry.Tail << uint8(buildInfo->MinorVersion);
+            entry.Tail << uint8(buildInfo->BugfixVersion);
+            entry.Tail << uint16(buildInfo->Build);
+        }
+
+        entry.ExternalAddress = boost::lexical_cast<std::string>(boost::asio::ip::tcp_endpoint(*realm.ExternalAddress, realm.Port));
+        entry.LocalAddress = boost::lexical_cast<std::string>(boost::asio::ip::tcp_endpoint(*realm.LocalAddress, realm.Port));
+        entry.LocalNetwork = realm.LocalAddress->to_v4().to_uint();
+        entry.LocalSubnetMask = realm.LocalSubnetMask->to_v4().to_uint();
+        entry.IsLoopback = realm.LocalAddress->is_loopback() || realm.ExternalAddress->is_loopback();
+        entry.Port = realm.Port;
+    }
+
+    return packet;
+}
+
+std::string RealmListPacketEntry::GetAddressForClient(boost::asio::ip::address const& clientAddr) const
+{
+    // Attempt to send best address for client
+    if (clientAddr.is_loopback())
+    {
+        // Try guessing if realm is also connected locally
+        if (IsLoopback)
+            return boost::lexical_cast<std::string>(boost::asio::ip::tcp_endpoint(clientAddr, Port));
+
+        // Assume that user connecting from the machine that authserver is located on
+        // has all realms available in his local network
+        return LocalAddress;
+    }
+
+    if (clientAddr.is_v4() && Warhead::Net::IsInNetwork(boost::asio::ip::address_v4(LocalNetwork), boost::asio::ip::address_v4(LocalSubnetMask), clientAddr.to_v4()))
+        return LocalAddress;
+
+    return ExternalAddress;
+}
@@ -18,10 +18,13 @@
 #ifndef _REALMLIST_H
 #define _REALMLIST_H
 
+#include "ByteBuffer.h"
 #include "Define.h"
 #include "Realm.h"
 #include <array>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 struct RealmBuildInfo
@@ -35,6 +38,35 @@ struct RealmBuildInfo
     std::array<uint8, 20> MacHash;
 };
 
+/// Realm of realm list packet, session writes lock byte, address and character count between serialized parts
+struct WH_SHARED_API RealmListPacketEntry
+{
+    RealmHandle Id;
+    uint8 Type{};
+    AccountTypes AllowedSecurityLevel{};
+    ByteBuffer FlagsAndName;
+    ByteBuffer Population;
+    ByteBuffer Tail;            // category, realm id and build info
+
+    // "ip:port" strings, chosen like Realm::GetAddressForClient
+    std::string ExternalAddress;
+    std::string LocalAddress;
+    uint32 LocalNetwork{};
+    uint32 LocalSubnetMask{};
+    bool IsLoopback{};
+    uint16 Port{};
+
+    [[nodiscard]] std::string GetAddressForClient(boost::asio::ip::address const& clientAddr) const;
+};
+
+/// Parts of realm list packet which are same for all clients of one build
+struct RealmListPacket
+{
+    uint32 Build{};
+    bool PostBC{};
+    std::vector<RealmListPacketEntry> Realms;
+};
+
 namespace boost::system
 {
     class error_code;
@@ -46,27 +78,36 @@ class WH_SHARED_API RealmList
 public:
     typedef std::map<RealmHandle, Realm> RealmMap;
 
+    static constexpr uint32 MAX_PRE_BC_CLIENT_BUILD = 6141;
+
     static RealmList* Instance();
 
     void Initialize(uint32 updateInterval);
     void Close();
 
-    [[nodiscard]] RealmMap const& GetRealms() const { return _realms; }
-    [[nodiscard]] Realm const* GetRealm(RealmHandle const& id) const;
+    // Snapshots of realm list, realms are replaced by update timer while snapshot stays valid
+    [[nodiscard]] std::shared_ptr<RealmMap const> GetRealms() const;
+    [[nodiscard]] std::shared_ptr<Realm const> GetRealm(RealmHandle const& id) const;
     [[nodiscard]] RealmBuildInfo const* GetBuildInfo(uint32 build) const;
 
+    // Realm list for client build, built on first request and rebuilt when realms are updated
+    [[nodiscard]] std::shared_ptr<RealmListPacket const> GetRealmListPacket(uint32 build, bool postBC);
+
 private:
-    RealmList() = default;
+    RealmList();
     ~RealmList() = default;
 
     void LoadBuildInfo();
     void UpdateRealms(boost::system::error_code const& error);
-    void UpdateRealm(RealmHandle const& id, uint32 build, std::string const& name,
+    [[nodiscard]] std::shared_ptr<RealmListPacket const> BuildRealmListPacket(uint32 build, bool postBC) const;
+    void UpdateRealm(RealmMap& realms, RealmHandle const& id, uint32 build, std::string const& name,
         boost::asio::ip::address&& address, boost::asio::ip::address&& localAddr, boost::asio::ip::address&& localSubmask,
         uint16 port, uint8 icon, RealmFlags flag, uint8 timezone, AccountTypes allowedSecurityLevel, float population);
 
     std::vector<RealmBuildInfo> _builds;
-    RealmMap _realms;
+    std::shared_ptr<RealmMap const> _realms;
+    std::map<uint32, std::shared_ptr<RealmListPacket const>> _realmListPackets;
+    mutable std::mutex _realmsLock;
     uint32 _updateInterval{};
     std::unique_ptr<Warhead::Asio::DeadlineTimer> _updateTimer;
     std::unique_ptr<Warhead::Asio::Resolver> _resolver;
@@ -0,0 +1,149 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Config.h"
+#include "Log.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <spdlog/spdlog.h>
+#include <thread>
+
+class LogTest : public testing::Test {
+protected:
+    void SetUp() override {
+        auto tempFile = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("log-%%%%.conf");
+        confFilePath = tempFile.native();
+
+        // LoadAppConfigs requires .dist file, .conf is optional
+        std::ofstream iniStream(confFilePath + ".dist");
+
+        iniStream << "[worldserver]\n";
+        iniStream << "Sink.Console = 1,2,%v\n";
+        iniStream << "Logger.root = 2,Console\n";
+        iniStream << "Logger.entities = 3,Console\n";
+        iniStream << "Logger.network = 1,Console\n";
+        iniStream.close();
+
+        sConfigMgr->Configure(confFilePath, std::vector<std::string>());
+        sConfigMgr->LoadAppConfigs();
+        sLog->LoadFromConfig();
+    }
+
+    void TearDown() override {
+        sLog->Clear();
+        std::remove((confFilePath + ".dist").c_str());
+    }
+
+    std::string confFilePath;
+};
+
+TEST_F(LogTest, CachedFilterResolvesParentLogger)
+{
+    EXPECT_TRUE(sLog->ShouldLog("server.loading", spdlog::level::info));
+    EXPECT_FALSE(sLog->ShouldLog("server.loading", spdlog::level::debug));
+
+    // "entities.unit" -> "entities"
+    EXPECT_FALSE(sLog->ShouldLog("entities.unit", spdlog::level::info));
+    EXPECT_TRUE(sLog->ShouldLog("entities.unit", spdlog::level::warn));
+
+    // Level change of resolved logger is visible without cache reset
+    sLog->SetLoggerLevel("entities", spdlog::level::debug);
+    EXPECT_TRUE(sLog->ShouldLog("entities.unit", spdlog::level::debug));
+}
+
+TEST_F(LogTest, CachedFilterMatchesLoggerFromThreads)
+{
+    constexpr uint32 threadsCount = 8;
+    constexpr uint32 iterations = 1000;
+
+    std::atomic<uint32> mismatches{ 0 };
+    std::vector<std::thread> threads;
+
+    for (uint32 i = 0; i < threadsCount; ++i)
+    {
+        threads.emplace_back([&]()
+        {
+            for (uint32 j = 0; j < iterations; ++j)
+            {
+                for (auto level : { spdlog::level::debug, spdlog::level::warn })
+                {
+                    auto logger = sLog->GetLoggerByType("entities.unit.ai");
+                    bool resolved = logger && logger->should_log(level);
+
+                    if (sLog->ShouldLog("entities.unit.ai", level) != resolved)
+                        ++mismatches;
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(mismatches, 0u);
+    EXPECT_FALSE(sLog->ShouldLog("entities.unit.ai", spdlog::level::debug));
+    EXPECT_TRUE(sLog->ShouldLog("entities.unit.ai", spdlog::level::warn));
+}
+
+// Benchmark: 8 threads checking disabled level, cached filter vs full logger resolve, prints time for both.
+// Disabled by default, run with --gtest_also_run_disabled_tests
+TEST_F(LogTest, DISABLED_DisabledLevelBenchmark)
+{
+    constexpr uint32 threadsCount = 8;
+    constexpr uint32 iterations = 100000;
+
+    auto Measure = [](auto&& func)
+    {
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+
+        for (uint32 i = 0; i < threadsCount; ++i)
+            threads.emplace_back(func);
+
+        for (auto& thread : threads)
+            thread.join();
+
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    std::atomic<uint32> resolvedLogs{ 0 };
+    std::atomic<uint32> cachedLogs{ 0 };
+
+    auto resolveTime = Measure([&]()
+    {
+        for (uint32 i = 0; i < iterations; ++i)
+            if (auto logger = sLog->GetLoggerByType("entities.unit.ai"); logger && logger->should_log(spdlog::level::debug))
+                ++resolvedLogs;
+    });
+
+    auto cachedTime = Measure([&]()
+    {
+        for (uint32 i = 0; i < iterations; ++i)
+            if (sLog->ShouldLog("entities.unit.ai", spdlog::level::debug))
+                ++cachedLogs;
+    });
+
+    std::printf("[ BENCH    ] %u threads, logger resolve: %lld us, cached filter: %lld us (%u checks per thread)\n",
+        threadsCount, static_cast<long long>(resolveTime), static_cast<long long>(cachedTime), iterations);
+
+    EXPECT_EQ(resolvedLogs, 0u);
+    EXPECT_EQ(cachedLogs, 0u);
+}
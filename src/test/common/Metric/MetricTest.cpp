@@ -0,0 +1,55 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Metric.h"
+#include "gtest/gtest.h"
+
+TEST(MetricTest, SeriesAreInterned)
+{
+    MetricSeriesId first = sMetric->RegisterSeries("test_series", { METRIC_TAG("map_id", "1") });
+    MetricSeriesId second = sMetric->RegisterSeries("test_series", { METRIC_TAG("map_id", "2") });
+
+    EXPECT_NE(first, 0u);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(first, sMetric->RegisterSeries("test_series", { METRIC_TAG("map_id", "1") }));
+    EXPECT_NE(first, sMetric->RegisterSeries("test_series", {}));
+}
+
+TEST(MetricTest, ReleasedSeriesAreNotShared)
+{
+    MetricSeriesId first = sMetric->RegisterSeries("test_release", { METRIC_TAG("map_instanceid", "1") });
+    MetricSeriesId second = sMetric->RegisterSeries("test_release", { METRIC_TAG("map_instanceid", "1") });
+    EXPECT_EQ(first, second);
+
+    // Series stays registered while any owner keeps it
+    sMetric->ReleaseSeries(second);
+    EXPECT_EQ(second, 0u);
+    MetricSeriesId third = sMetric->RegisterSeries("test_release", { METRIC_TAG("map_instanceid", "1") });
+    EXPECT_EQ(first, third);
+
+    MetricSeriesId const released = first;
+    sMetric->ReleaseSeries(first);
+    sMetric->ReleaseSeries(third);
+    EXPECT_EQ(first, 0u);
+
+    // Samples of released series may still be buffered, id isn't reused before they are sent
+    MetricSeriesId other = sMetric->RegisterSeries("test_release", { METRIC_TAG("map_instanceid", "1") });
+    EXPECT_NE(other, 0u);
+    EXPECT_NE(other, released);
+
+    sMetric->ReleaseSeries(other);
+}
@@ -0,0 +1,144 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskGraph.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace
+{
+    struct TaskOrder
+    {
+        Warhead::TaskGraph::Task Add(std::string name)
+        {
+            return [this, name]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+                std::lock_guard<std::mutex> guard(Lock);
+                Order.emplace_back(name);
+            };
+        }
+
+        [[nodiscard]] std::size_t IndexOf(std::string const& name) const
+        {
+            return std::find(Order.begin(), Order.end(), name) - Order.begin();
+        }
+
+        std::vector<std::string> Order;
+        std::mutex Lock;
+    };
+}
+
+TEST(TaskGraphTest, SingleThreadKeepsAddedOrder)
+{
+    TaskOrder order;
+    Warhead::TaskGraph graph;
+    graph.AddTask("CreatureTemplate", {}, order.Add("CreatureTemplate"));
+    graph.AddTask("SpellInfo", {}, order.Add("SpellInfo"));
+    graph.AddBarrier("Disables", order.Add("Disables"));
+    graph.AddTask("Creature", { "CreatureTemplate" }, order.Add("Creature"));
+    graph.AddTask("SpellProc", { "SpellInfo" }, order.Add("SpellProc"));
+
+    graph.Run(1);
+
+    EXPECT_EQ(order.Order, std::vector<std::string>({ "CreatureTemplate", "SpellInfo", "Disables", "Creature", "SpellProc" }));
+    ASSERT_EQ(graph.GetTimings().size(), 5u);
+    EXPECT_EQ(graph.GetTimings()[3].Name, "Creature");
+    EXPECT_GE(graph.GetTimings()[3].Elapsed, std::chrono::milliseconds(2));
+}
+
+TEST(TaskGraphTest, ParallelRespectsDependencies)
+{
+    TaskOrder order;
+    Warhead::TaskGraph graph;
+
+    for (uint32 i = 0; i < 8; ++i)
+    {
+        std::string name = "Template" + std::to_string(i);
+        graph.AddTask(name, {}, order.Add(name));
+        graph.AddTask("Data" + std::to_string(i), { name }, order.Add("Data" + std::to_string(i)));
+    }
+
+    graph.AddBarrier("Conditions", order.Add("Conditions"));
+    graph.AddTask("Tickets", {}, order.Add("Tickets"));
+    graph.AddTask("Addons", {}, order.Add("Addons"));
+
+    graph.Run(4);
+
+    ASSERT_EQ(order.Order.size(), 19u);
+
+    for (uint32 i = 0; i < 8; ++i)
+    {
+        EXPECT_LT(order.IndexOf("Template" + std::to_string(i)), order.IndexOf("Data" + std::to_string(i)));
+        EXPECT_LT(order.IndexOf("Data" + std::to_string(i)), order.IndexOf("Conditions"));
+    }
+
+    EXPECT_LT(order.IndexOf("Conditions"), order.IndexOf("Tickets"));
+    EXPECT_LT(order.IndexOf("Conditions"), order.IndexOf("Addons"));
+}
+
+TEST(TaskGraphTest, ParallelRunsIndependentTasksAtSameTime)
+{
+    constexpr uint32 threadsCount = 4;
+
+    // every task waits until all of them are started, it's possible only if they run at same time
+    std::mutex lock;
+    std::condition_variable allStarted;
+    uint32 started = 0;
+    std::atomic<uint32> met{ 0 };
+
+    Warhead::TaskGraph graph;
+
+    for (uint32 i = 0; i < threadsCount; ++i)
+    {
+        graph.AddTask("Task" + std::to_string(i), {}, [&]()
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            ++started;
+            allStarted.notify_all();
+
+            // timeout only keeps failing test from hanging
+            if (allStarted.wait_for(guard, std::chrono::seconds(30), [&started]() { return started == threadsCount; }))
+                ++met;
+        });
+    }
+
+    graph.Run(threadsCount);
+
+    EXPECT_EQ(met.load(), threadsCount);
+}
+
+TEST(TaskGraphTest, ExceptionStopsDependents)
+{
+    bool dependentExecuted = false;
+
+    Warhead::TaskGraph graph;
+    graph.AddTask("Broken", {}, []() { throw std::runtime_error("broken table"); });
+    graph.AddTask("Other", {}, []() { });
+    graph.AddTask("Dependent", { "Broken" }, [&dependentExecuted]() { dependentExecuted = true; });
+
+    EXPECT_THROW(graph.Run(2), std::runtime_error);
+    EXPECT_FALSE(dependentExecuted);
+}
@@ -0,0 +1,145 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventMap.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+    std::vector<uint32> ExecuteAll(EventMap& events)
+    {
+        std::vector<uint32> executed;
+        while (uint32 eventId = events.ExecuteEvent())
+            executed.emplace_back(eventId);
+
+        return executed;
+    }
+}
+
+TEST(EventMapTest, ExecutesInTimeAndScheduleOrder)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 300ms);
+    events.ScheduleEvent(2, 100ms);
+    events.ScheduleEvent(3, 200ms);
+    events.ScheduleEvent(4, 100ms);
+    events.ScheduleEvent(5, 100ms);
+
+    events.Update(50);
+    EXPECT_EQ(events.ExecuteEvent(), 0u);
+
+    events.Update(150);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 2, 4, 5, 3 }));
+    EXPECT_FALSE(events.Empty());
+
+    events.Repeat(0ms);
+    EXPECT_EQ(events.ExecuteEvent(), 3u);
+
+    events.Update(100);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 1 }));
+    EXPECT_TRUE(events.Empty());
+}
+
+TEST(EventMapTest, PhasesAndGroups)
+{
+    EventMap events;
+    events.SetPhase(1);
+    events.ScheduleEvent(1, 100ms, 0, 1);
+    events.ScheduleEvent(2, 100ms, 0, 2);
+    events.ScheduleEvent(3, 100ms, 1);
+    events.ScheduleEvent(4, 100ms, 2);
+    events.ScheduleEvent(5, 100ms, 1);
+
+    events.CancelEventGroup(1);
+
+    events.Update(100);
+    // event of other phase is dropped
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 1, 4 }));
+    EXPECT_TRUE(events.Empty());
+}
+
+TEST(EventMapTest, CancelRescheduleAndDelay)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 100ms, 1);
+    events.ScheduleEvent(2, 200ms);
+    events.ScheduleEvent(1, 300ms, 1);
+    events.ScheduleEvent(3, 250ms, 2);
+
+    EXPECT_EQ(events.GetNextEventTime(1), 100u);
+    EXPECT_EQ(events.GetNextEventTime(), 100u);
+    EXPECT_EQ(events.GetTimeUntilEvent(2), 200ms);
+    EXPECT_EQ(events.GetTimeUntilEvent(7), Milliseconds::max());
+
+    events.CancelEvent(1);
+    EXPECT_EQ(events.GetNextEventTime(1), 0u);
+
+    events.RescheduleEvent(2, 400ms);
+    events.ScheduleEvent(4, 400ms, 2);
+
+    // group 2 delayed, moved after events already scheduled at same time
+    events.DelayEvents(150, 2);
+    EXPECT_EQ(events.GetNextEventTime(3), 400u);
+    EXPECT_EQ(events.GetNextEventTime(4), 550u);
+
+    events.Update(400);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 2, 3 }));
+
+    events.ScheduleEvent(5, 50ms);
+    events.DelayEventsToMax(100, 0);
+    EXPECT_EQ(events.GetNextEventTime(5), 500u);
+    EXPECT_EQ(events.GetNextEventTime(4), 550u);
+
+    events.DelayEvents(100);
+    EXPECT_EQ(events.GetTimer(), 300u);
+
+    events.Reset();
+    EXPECT_TRUE(events.Empty());
+    EXPECT_EQ(events.GetTimer(), 0u);
+}
+
+// Benchmark: boss script like usage, every event is repeated after execution.
+// Disabled by default, run with --gtest_also_run_disabled_tests
+TEST(EventMapTest, DISABLED_ScheduleExecuteBenchmark)
+{
+    constexpr uint32 iterations = 1000000;
+
+    EventMap events;
+    for (uint32 i = 1; i <= 8; ++i)
+        events.ScheduleEvent(i, Milliseconds(i * 1000), i % 3);
+
+    uint32 executed = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    while (executed < iterations)
+    {
+        events.Update(100);
+
+        while (uint32 eventId = events.ExecuteEvent())
+        {
+            events.ScheduleEvent(eventId, Milliseconds(eventId * 1000), eventId % 3);
+            ++executed;
+        }
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start);
+
+    EXPECT_FALSE(events.Empty());
+    std::cout << "[ BENCH    ] EventMap schedule + execute: " << uint64(executed / elapsed.count()) << " ops/sec" << std::endl;
+}
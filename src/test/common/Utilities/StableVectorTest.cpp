@@ -0,0 +1,194 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StableVector.h"
+#include "Define.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <vector>
+
+namespace
+{
+    struct TestEffect
+    {
+        int32 Amount;
+    };
+
+    template<class List>
+    std::vector<int32> Amounts(List const& list)
+    {
+        std::vector<int32> amounts;
+        for (TestEffect* effect : list)
+            amounts.push_back(effect->Amount);
+
+        return amounts;
+    }
+}
+
+TEST(StableVectorTest, RemoveWhileIterating)
+{
+    TestEffect effects[5] = { { 1 }, { 2 }, { 3 }, { 4 }, { 5 } };
+    Warhead::StableVector<TestEffect*> list;
+    for (TestEffect& effect : effects)
+        list.push_back(&effect);
+
+    // remove current and next element, iterator of current one still advances
+    std::vector<int32> visited;
+    for (auto itr = list.begin(); itr != list.end(); ++itr)
+    {
+        visited.push_back((*itr)->Amount);
+        if ((*itr)->Amount == 2)
+        {
+            list.remove(&effects[1]);
+            list.remove(&effects[2]);
+        }
+    }
+
+    EXPECT_EQ(visited, std::vector<int32>({ 1, 2, 4, 5 }));
+    EXPECT_EQ(list.size(), 3u);
+    EXPECT_EQ(list.front()->Amount, 1);
+    EXPECT_EQ(list.back()->Amount, 5);
+
+    // elements added during iteration are visited, same as std::list
+    visited.clear();
+    for (auto itr = list.begin(); itr != list.end(); ++itr)
+    {
+        visited.push_back((*itr)->Amount);
+        if ((*itr)->Amount == 5)
+            list.push_back(&effects[2]);
+    }
+
+    EXPECT_EQ(visited, std::vector<int32>({ 1, 4, 5, 3 }));
+
+    list.Compact();
+    EXPECT_EQ(Amounts(list), std::vector<int32>({ 1, 4, 5, 3 }));
+
+    std::vector<int32> reversed;
+    for (auto itr = list.rbegin(); itr != list.rend(); ++itr)
+        reversed.push_back((*itr)->Amount);
+
+    EXPECT_EQ(reversed, std::vector<int32>({ 3, 5, 4, 1 }));
+}
+
+TEST(StableVectorTest, CopyAndSort)
+{
+    TestEffect effects[4] = { { 3 }, { 1 }, { 2 }, { 1 } };
+    Warhead::StableVector<TestEffect*> list;
+    for (TestEffect& effect : effects)
+        list.push_back(&effect);
+
+    list.remove(&effects[2]);
+
+    Warhead::StableVector<TestEffect*> copy(list);
+    copy.sort([](TestEffect const* left, TestEffect const* right) { return left->Amount < right->Amount; });
+
+    EXPECT_EQ(Amounts(copy), std::vector<int32>({ 1, 1, 3 }));
+    EXPECT_EQ(copy.size(), 3u);
+    EXPECT_EQ(*copy.begin(), &effects[1]);          // stable as std::list::sort
+    EXPECT_EQ(Amounts(list), std::vector<int32>({ 3, 1, 1 }));
+
+    list.remove(&effects[0]);
+    list.remove(&effects[1]);
+    list.remove(&effects[3]);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.size(), 0u);
+    EXPECT_TRUE(list.begin() == list.end());
+
+    Warhead::StableVector<TestEffect*> moved(std::move(copy));
+    EXPECT_EQ(moved.size(), 3u);
+    EXPECT_TRUE(copy.empty());
+
+    moved.remove(&effects[1]);
+    list = moved;
+    EXPECT_EQ(list.size(), 2u);
+    EXPECT_EQ(Amounts(list), std::vector<int32>({ 1, 3 }));
+}
+
+// Benchmark: 200 raids of 25 members, every pass 40 auras are applied to each member,
+// modifiers of all aura types are summed for stat recalculation and auras expire again.
+// Disabled by default, run with --gtest_also_run_disabled_tests
+TEST(StableVectorTest, DISABLED_AuraApplyRecalcExpireBenchmark)
+{
+    constexpr uint32 unitsCount = 25 * 200;
+    constexpr uint32 aurasPerUnit = 40;
+    constexpr uint32 auraTypes = 20;
+    constexpr uint32 passes = 10;
+
+    std::vector<TestEffect> effects(unitsCount * aurasPerUnit);
+    for (uint32 i = 0; i < effects.size(); ++i)
+        effects[i].Amount = int32(i % 100);
+
+    auto effectOf = [&](uint32 unit, uint32 aura) { return &effects[unit * aurasPerUnit + aura]; };
+    auto typeOf = [](uint32 unit, uint32 aura) { return (unit + aura * 7) % auraTypes; };
+
+    std::vector<std::vector<std::list<TestEffect*>>> oldUnits(unitsCount, std::vector<std::list<TestEffect*>>(auraTypes));
+    std::vector<std::vector<Warhead::StableVector<TestEffect*>>> newUnits(unitsCount, std::vector<Warhead::StableVector<TestEffect*>>(auraTypes));
+
+    int64 oldSum = 0;
+    auto oldStart = std::chrono::steady_clock::now();
+
+    for (uint32 pass = 0; pass < passes; ++pass)
+    {
+        for (uint32 aura = 0; aura < aurasPerUnit; ++aura)
+            for (uint32 unit = 0; unit < unitsCount; ++unit)
+                oldUnits[unit][typeOf(unit, aura)].push_back(effectOf(unit, aura));
+
+        for (auto const& unit : oldUnits)
+            for (auto const& list : unit)
+                for (TestEffect* effect : list)
+                    oldSum += effect->Amount;
+
+        for (uint32 unit = 0; unit < unitsCount; ++unit)
+            for (uint32 aura = 0; aura < aurasPerUnit; ++aura)
+                oldUnits[unit][typeOf(unit, aura)].remove(effectOf(unit, aura));
+    }
+
+    auto middle = std::chrono::steady_clock::now();
+    int64 newSum = 0;
+
+    for (uint32 pass = 0; pass < passes; ++pass)
+    {
+        for (uint32 aura = 0; aura < aurasPerUnit; ++aura)
+            for (uint32 unit = 0; unit < unitsCount; ++unit)
+                newUnits[unit][typeOf(unit, aura)].push_back(effectOf(unit, aura));
+
+        for (auto const& unit : newUnits)
+            for (auto const& list : unit)
+                for (TestEffect* effect : list)
+                    newSum += effect->Amount;
+
+        for (uint32 unit = 0; unit < unitsCount; ++unit)
+        {
+            for (uint32 aura = 0; aura < aurasPerUnit; ++aura)
+                newUnits[unit][typeOf(unit, aura)].remove(effectOf(unit, aura));
+
+            // Unit::_UpdateSpells
+            for (auto& list : newUnits[unit])
+                list.Compact();
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(oldSum, newSum);
+
+    std::cout << "[ BENCH    ] " << unitsCount << " units, " << passes << " passes: std::list "
+        << std::chrono::duration_cast<std::chrono::microseconds>(middle - oldStart).count() << " us, StableVector "
+        << std::chrono::duration_cast<std::chrono::microseconds>(end - middle).count() << " us" << std::endl;
+}
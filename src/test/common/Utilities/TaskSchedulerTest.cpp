@@ -0,0 +1,198 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskScheduler.h"
+#include "Duration.h"
+#include "gtest/gtest.h"
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+TEST(TaskSchedulerTest, ExecutesInTimeAndScheduleOrder)
+{
+    std::string order;
+
+    TaskScheduler scheduler;
+    scheduler.Schedule(300ms, [&order](TaskContext) { order += 'a'; });
+    scheduler.Schedule(100ms, [&order](TaskContext) { order += 'b'; });
+    scheduler.Schedule(200ms, [&order](TaskContext) { order += 'c'; });
+    scheduler.Schedule(100ms, [&order](TaskContext) { order += 'd'; });
+
+    scheduler.Update(50ms);
+    EXPECT_EQ(order, "");
+
+    scheduler.Update(150ms);
+    EXPECT_EQ(order, "bdc");
+
+    scheduler.Update(100ms);
+    EXPECT_EQ(order, "bdca");
+}
+
+TEST(TaskSchedulerTest, RepeatAndContext)
+{
+    std::vector<uint32> repeats;
+
+    TaskScheduler scheduler;
+    scheduler.Schedule(100ms, 1, [&repeats](TaskContext context)
+    {
+        repeats.emplace_back(context.GetRepeatCounter());
+        EXPECT_TRUE(context.IsInGroup(1));
+
+        if (context.GetRepeatCounter() < 3)
+            context.Repeat();
+    });
+
+    scheduler.Update(1s);
+    EXPECT_EQ(repeats, std::vector<uint32>({ 0, 1, 2, 3 }));
+    EXPECT_FALSE(scheduler.IsGroupScheduled(1));
+
+    // task scheduled from context is timed from end of current task
+    std::string order;
+    scheduler.Schedule(100ms, [&order](TaskContext context)
+    {
+        order += 'a';
+        context.Schedule(50ms, [&order](TaskContext) { order += 'b'; });
+    });
+
+    scheduler.Update(160ms);
+    EXPECT_EQ(order, "ab");
+}
+
+TEST(TaskSchedulerTest, CancelDelayAndReschedule)
+{
+    std::string order;
+
+    TaskScheduler scheduler;
+    scheduler.Schedule(100ms, 1, [&order](TaskContext) { order += 'a'; });
+    scheduler.Schedule(200ms, 2, [&order](TaskContext) { order += 'b'; });
+    scheduler.Schedule(300ms, 1, [&order](TaskContext) { order += 'c'; });
+    scheduler.Schedule(300ms, 3, [&order](TaskContext) { order += 'd'; });
+
+    EXPECT_TRUE(scheduler.IsGroupScheduled(2));
+    scheduler.CancelGroup(2);
+    EXPECT_FALSE(scheduler.IsGroupScheduled(2));
+
+    // delayed task is executed after tasks already scheduled at same time
+    scheduler.DelayGroup(1, 200ms);
+    scheduler.Schedule(300ms, [&order](TaskContext) { order += 'e'; });
+
+    scheduler.Update(300ms);
+    EXPECT_EQ(order, "dae");
+
+    scheduler.RescheduleGroup(1, 50ms);
+    scheduler.Update(50ms);
+    EXPECT_EQ(order, "daec");
+
+    scheduler.Schedule(100ms, [&order](TaskContext) { order += 'f'; });
+    scheduler.DelayAll(100ms);
+    scheduler.Update(100ms);
+    EXPECT_EQ(order, "daec");
+
+    scheduler.CancelAll();
+    scheduler.Update(1s);
+    EXPECT_EQ(order, "daec");
+}
+
+TEST(TaskSchedulerTest, ContextOutlivesScheduler)
+{
+    TaskContext stored;
+    bool executed = false;
+
+    {
+        TaskScheduler scheduler;
+        scheduler.Schedule(100ms, [&stored, &executed](TaskContext context)
+        {
+            executed = true;
+            stored = context;
+        });
+
+        scheduler.Update(100ms);
+    }
+
+    EXPECT_TRUE(executed);
+    EXPECT_TRUE(stored.IsExpired());
+
+    // owner is gone, repeat is dropped
+    stored.Repeat(100ms);
+}
+
+TEST(TaskSchedulerTest, LargeCallable)
+{
+    std::array<uint64, 16> values{};
+    values.fill(3);
+    uint64 sum = 0;
+
+    TaskScheduler scheduler;
+    scheduler.Schedule(100ms, [values, &sum](TaskContext context)
+    {
+        for (uint64 value : values)
+            sum += value;
+
+        if (context.GetRepeatCounter() < 1)
+            context.Repeat();
+    });
+
+    scheduler.Update(1s);
+    EXPECT_EQ(sum, 96u);
+}
+
+// Benchmark: boss script like usage, every task repeats itself.
+// Disabled by default, run with --gtest_also_run_disabled_tests
+TEST(TaskSchedulerTest, DISABLED_ScheduleRepeatBenchmark)
+{
+    constexpr uint32 iterations = 1000000;
+
+    uint32 executed = 0;
+
+    TaskScheduler scheduler;
+    for (uint32 i = 1; i <= 8; ++i)
+    {
+        scheduler.Schedule(Milliseconds(i * 1000), i % 3, [&executed, i](TaskContext context)
+        {
+            ++executed;
+            context.Repeat(Milliseconds(i * 1000));
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (executed < iterations)
+        scheduler.Update(100ms);
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "[ BENCH    ] TaskScheduler execute + repeat: " << uint64(executed / elapsed.count()) << " ops/sec" << std::endl;
+
+    executed = 0;
+    start = std::chrono::steady_clock::now();
+
+    // schedule from outside of context, the way most scripts start their tasks
+    while (executed < iterations)
+    {
+        scheduler.CancelAll();
+        for (uint32 i = 1; i <= 8; ++i)
+            scheduler.Schedule(Milliseconds(i * 10), [&executed](TaskContext) { ++executed; });
+
+        scheduler.Update(100ms);
+    }
+
+    elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "[ BENCH    ] TaskScheduler schedule + execute: " << uint64(executed / elapsed.count()) << " ops/sec" << std::endl;
+}
@@ -0,0 +1,146 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThreadLocalPool.h"
+#include "Define.h"
+#include "gtest/gtest.h"
+#include <thread>
+
+namespace
+{
+    // Heap allocations made by current thread through CountingAllocator
+    thread_local uint64 _heapAllocations = 0;
+
+    template<class T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+
+        CountingAllocator() = default;
+        template<class U> CountingAllocator(CountingAllocator<U> const&) { }
+
+        T* allocate(std::size_t n)
+        {
+            ++_heapAllocations;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* ptr, std::size_t n) { std::allocator<T>().deallocate(ptr, n); }
+
+        template<class U> bool operator==(CountingAllocator<U> const&) const { return true; }
+        template<class U> bool operator!=(CountingAllocator<U> const&) const { return false; }
+    };
+
+    template<class T>
+    using CountedScratchVector = Warhead::ScratchVector<T, 1024, CountingAllocator<T>>;
+
+    struct TestSpell
+    {
+        uint32 Id;
+        uint8 Data[1500];
+    };
+
+    struct PooledTestSpell : TestSpell
+    {
+        static void* operator new(std::size_t size) { return Warhead::ThreadLocalPool<PooledTestSpell>::Allocate(size); }
+        static void operator delete(void* ptr, std::size_t size) { Warhead::ThreadLocalPool<PooledTestSpell>::Deallocate(ptr, size); }
+    };
+
+    struct DerivedPooledTestSpell : PooledTestSpell
+    {
+        uint32 Extra;
+    };
+}
+
+TEST(ThreadLocalPoolTest, BlocksAreReused)
+{
+    PooledTestSpell* first = new PooledTestSpell();
+    delete first;
+    EXPECT_EQ(Warhead::ThreadLocalPool<PooledTestSpell>::GetCachedBlocks(), 1u);
+
+    PooledTestSpell* second = new PooledTestSpell();
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(Warhead::ThreadLocalPool<PooledTestSpell>::GetCachedBlocks(), 0u);
+
+    // other sizes never take pooled blocks
+    PooledTestSpell* cached = new PooledTestSpell();
+    delete cached;
+
+    DerivedPooledTestSpell* derived = new DerivedPooledTestSpell();
+    EXPECT_NE(static_cast<PooledTestSpell*>(derived), cached);
+    EXPECT_EQ(Warhead::ThreadLocalPool<PooledTestSpell>::GetCachedBlocks(), 1u);
+    delete derived;
+    EXPECT_EQ(Warhead::ThreadLocalPool<PooledTestSpell>::GetCachedBlocks(), 1u);
+
+    // block freed by other thread stays in cache of that thread
+    std::thread([second]() { delete second; }).join();
+    EXPECT_EQ(Warhead::ThreadLocalPool<PooledTestSpell>::GetCachedBlocks(), 1u);
+}
+
+TEST(ThreadLocalPoolTest, ScratchVectorsAreReentrant)
+{
+    int32 values[3] = { 1, 2, 3 };
+    int32* const* outerData = nullptr;
+
+    {
+        CountedScratchVector<int32*> outer;
+        outer->push_back(&values[0]);
+        outerData = outer->data();
+
+        CountedScratchVector<int32*> inner;
+        EXPECT_TRUE(inner->empty());
+        inner->push_back(&values[1]);
+        EXPECT_NE(inner->data(), outerData);
+        EXPECT_EQ(outer->size(), 1u);
+    }
+
+    // returned vectors come back empty with their memory
+    uint64 allocations = _heapAllocations;
+    CountedScratchVector<int32*> reused;
+    EXPECT_TRUE(reused->empty());
+    reused->push_back(&values[2]);
+    EXPECT_EQ(_heapAllocations, allocations);
+}
+
+TEST(ThreadLocalPoolTest, RepeatedCastsDoNotAllocate)
+{
+    constexpr uint32 targetsPerCast = 40;
+
+    std::vector<uint32> objects(targetsPerCast);
+
+    auto cast = [&](uint32 id)
+    {
+        PooledTestSpell* spell = new PooledTestSpell();
+        spell->Id = id;
+
+        CountedScratchVector<uint32*> targets;
+        for (uint32& object : objects)
+            targets->push_back(&object);
+
+        EXPECT_EQ(targets->size(), targetsPerCast);
+        delete spell;
+    };
+
+    // first cast of thread grows the scratch vector
+    cast(0);
+
+    uint64 allocations = _heapAllocations;
+    for (uint32 id = 1; id < 100; ++id)
+        cast(id);
+
+    EXPECT_EQ(_heapAllocations, allocations);
+}
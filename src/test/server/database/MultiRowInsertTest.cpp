@@ -0,0 +1,73 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MultiRowInsert.h"
+#include "Transaction.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::vector<std::string> GetRawQueries(SQLTransaction const& trans)
+    {
+        std::vector<std::string> queries;
+        for (SQLElementData const& data : *trans->GetQueries())
+            queries.emplace_back(data.type == SQL_ELEMENT_RAW ? std::get<std::string>(data.element) : "<prepared>");
+
+        return queries;
+    }
+}
+
+TEST(MultiRowInsertTest, CoalescesRows)
+{
+    SQLTransaction trans = std::make_shared<Transaction>();
+
+    {
+        MultiRowInsert insert(trans, "INSERT INTO character_spell (guid, spell, specMask)");
+        insert.AddRow(uint32(1), uint32(133), uint8(255));
+        insert.AddRow(uint32(1), uint32(168), uint8(1));
+
+        // nothing is appended before flush
+        EXPECT_EQ(trans->GetSize(), 0u);
+    }
+
+    EXPECT_EQ(GetRawQueries(trans), std::vector<std::string>({
+        "INSERT INTO character_spell (guid, spell, specMask) VALUES (1,133,255),(1,168,1)" }));
+}
+
+TEST(MultiRowInsertTest, SplitsByRowLimitAndKeepsOrder)
+{
+    SQLTransaction trans = std::make_shared<Transaction>();
+    trans->Append("DELETE FROM character_aura WHERE guid = 5");
+
+    MultiRowInsert insert(trans, "REPLACE INTO t (a, b, c)", 2);
+    insert.AddRow(int32(-1), true, 0.5f);
+    insert.AddRow(uint64(18446744073709551615ull), false, 2.0);
+    insert.AddRow(uint16(3), uint8(0), int8(-4));
+    insert.Flush();
+    insert.Flush();
+
+    trans->Append("DELETE FROM t WHERE a = 3");
+
+    EXPECT_EQ(insert.GetQueryCount(), 2u);
+    EXPECT_EQ(GetRawQueries(trans), std::vector<std::string>({
+        "DELETE FROM character_aura WHERE guid = 5",
+        "REPLACE INTO t (a, b, c) VALUES (-1,1,0.5),(18446744073709551615,0,2)",
+        "REPLACE INTO t (a, b, c) VALUES (3,0,-4)",
+        "DELETE FROM t WHERE a = 3" }));
+}
@@ -0,0 +1,217 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Creature.h"
+#include "DBCStores.h"
+#include "Map.h"
+#include "SmartScript.h"
+#include "gtest/gtest.h"
+#include <memory>
+
+namespace
+{
+    // Map without grids, only needed for invoker lookups of the script
+    class TestMap : public Map
+    {
+    public:
+        explicit TestMap(uint32 id) : Map(AddMapEntry(id), 0, REGULAR_DIFFICULTY) { }
+
+    private:
+        // DBC files are not loaded by unit tests
+        static uint32 AddMapEntry(uint32 id)
+        {
+            if (!sMapStore.LookupEntry(id))
+            {
+                MapEntry* entry = new MapEntry();
+                entry->MapID = id;
+                sMapStore.SetEntry(id, entry);
+            }
+
+            return id;
+        }
+    };
+
+    // Creature out of world running the script, combat and cast state are set by the test
+    class SmartScriptTest : public ::testing::Test
+    {
+    protected:
+        SmartScriptTest() : _map(1001)
+        {
+            _creature._Create(1, HighGuid::Unit, PHASEMASK_NORMAL);
+            _creature.SetMap(&_map);
+        }
+
+        ~SmartScriptTest() override
+        {
+            _creature.ResetMap();
+        }
+
+        static SmartScriptDefinition CreateEvent(uint32 eventId, SMART_EVENT type, uint32 flags, uint32 initialMin, uint32 initialMax, uint32 repeatMin, uint32 repeatMax,
+            SMART_ACTION action, uint32 actionParam1, uint32 actionParam2, uint32 actionParam3, uint32 link = 0)
+        {
+            SmartScriptDefinition definition = SmartScript::CreateSmartEvent(type, flags, initialMin, initialMax, repeatMin, repeatMax, 0, 0,
+                action, actionParam1, actionParam2, actionParam3, 0, 0, 0, SMART_TARGET_NONE, 0, 0, 0, 0, 0);
+
+            definition.event_id = eventId;
+            definition.link = link;
+            return definition;
+        }
+
+        // Counter action: counter id, value, reset (1 - set value, 0 - add value)
+        static SmartScriptDefinition CreateCounterEvent(uint32 eventId, SMART_EVENT type, uint32 flags, uint32 initial, uint32 repeat, uint32 counterId, uint32 value, uint32 reset)
+        {
+            return CreateEvent(eventId, type, flags, initial, initial, repeat, repeat, SMART_ACTION_SET_COUNTER, counterId, value, reset);
+        }
+
+        // Same order as SmartAI: script of the creature, then reset calculating the first timers
+        void Start(SmartScriptProgram program)
+        {
+            _script.OnInitialize(&_creature);
+            _script.FillScript(std::make_shared<SmartScriptProgram const>(std::move(program)), &_creature, nullptr);
+            _script.OnReset();
+        }
+
+        TestMap _map;
+        Creature _creature;
+        SmartScript _script;
+    };
+}
+
+// Timers due at different updates fire in order of their due time, timers due at the same update in order of events
+TEST_F(SmartScriptTest, TimersFireInDueAndEventOrder)
+{
+    Start({
+        // counter 1 is set to 1, then 10 is added
+        CreateCounterEvent(1, SMART_EVENT_UPDATE, SMART_EVENT_FLAG_NOT_REPEATABLE, 1000, 0, 1, 1, 1),
+        CreateCounterEvent(2, SMART_EVENT_UPDATE, SMART_EVENT_FLAG_NOT_REPEATABLE, 500, 0, 1, 10, 0),
+        CreateCounterEvent(3, SMART_EVENT_UPDATE, SMART_EVENT_FLAG_NOT_REPEATABLE, 300, 0, 2, 1, 0),
+    });
+
+    _script.OnUpdate(200);
+    EXPECT_EQ(_script.GetCounterValue(1), 0u);
+    EXPECT_EQ(_script.GetCounterValue(2), 0u);
+
+    _script.OnUpdate(200);
+    EXPECT_EQ(_script.GetCounterValue(1), 0u);
+    EXPECT_EQ(_script.GetCounterValue(2), 1u);
+
+    // event 2 is due before event 1, both are processed in the same update
+    _script.OnUpdate(1000);
+    EXPECT_EQ(_script.GetCounterValue(1), 11u);
+    EXPECT_EQ(_script.GetCounterValue(2), 1u);
+}
+
+TEST_F(SmartScriptTest, RepeatReschedulesTimer)
+{
+    Start({
+        CreateCounterEvent(1, SMART_EVENT_UPDATE, 0, 1000, 2000, 1, 1, 0),
+        CreateCounterEvent(2, SMART_EVENT_UPDATE, SMART_EVENT_FLAG_NOT_REPEATABLE, 1000, 2000, 2, 1, 0),
+    });
+
+    _script.OnUpdate(1000);
+    EXPECT_EQ(_script.GetCounterValue(1), 0u);
+
+    _script.OnUpdate(1);
+    EXPECT_EQ(_script.GetCounterValue(1), 1u);
+    EXPECT_EQ(_script.GetCounterValue(2), 1u);
+
+    _script.OnUpdate(2000);
+    EXPECT_EQ(_script.GetCounterValue(1), 1u);
+
+    _script.OnUpdate(1);
+    EXPECT_EQ(_script.GetCounterValue(1), 2u);
+
+    _script.OnUpdate(10000);
+    EXPECT_EQ(_script.GetCounterValue(1), 3u);
+    EXPECT_EQ(_script.GetCounterValue(2), 1u);
+
+    // reset starts the initial timer again, also for not repeatable events
+    _script.OnReset();
+    _script.OnUpdate(1001);
+    EXPECT_EQ(_script.GetCounterValue(1), 1u);
+    EXPECT_EQ(_script.GetCounterValue(2), 1u);
+}
+
+// Cast is delayed by 1200 ms while another spell is being cast, linked counter shows when cast action is processed
+TEST_F(SmartScriptTest, CastWaitsForCurrentCast)
+{
+    Start({
+        CreateEvent(1, SMART_EVENT_UPDATE, SMART_EVENT_FLAG_NOT_REPEATABLE, 1000, 1000, 0, 0, SMART_ACTION_CAST, 1, 0, 0, 2),
+        CreateEvent(2, SMART_EVENT_LINK, 0, 0, 0, 0, 0, SMART_ACTION_SET_COUNTER, 1, 1, 0),
+        CreateEvent(3, SMART_EVENT_UPDATE, SMART_EVENT_FLAG_NOT_REPEATABLE, 1000, 1000, 0, 0, SMART_ACTION_CAST, 1, SMARTCAST_INTERRUPT_PREVIOUS, 0, 4),
+        CreateEvent(4, SMART_EVENT_LINK, 0, 0, 0, 0, 0, SMART_ACTION_SET_COUNTER, 2, 1, 0),
+    });
+
+    _creature.AddUnitState(UNIT_STATE_CASTING);
+
+    _script.OnUpdate(1001);
+    EXPECT_EQ(_script.GetCounterValue(1), 0u);
+    EXPECT_EQ(_script.GetCounterValue(2), 1u);
+
+    _creature.ClearUnitState(UNIT_STATE_CASTING);
+
+    _script.OnUpdate(1200);
+    EXPECT_EQ(_script.GetCounterValue(1), 0u);
+
+    _script.OnUpdate(1);
+    EXPECT_EQ(_script.GetCounterValue(1), 1u);
+    EXPECT_EQ(_script.GetCounterValue(2), 1u);
+}
+
+// Update ooc and update ic timers keep their remaining time while paused by combat state
+TEST_F(SmartScriptTest, CombatStatePausesTimers)
+{
+    Start({
+        CreateCounterEvent(1, SMART_EVENT_UPDATE_OOC, 0, 1000, 1000, 1, 1, 0),
+        CreateCounterEvent(2, SMART_EVENT_UPDATE_IC, 0, 1000, 1000, 2, 1, 0),
+    });
+
+    _script.OnUpdate(500);
+    EXPECT_EQ(_script.GetCounterValue(1), 0u);
+
+    // engage, ooc timer has 500 ms left
+    _creature.SetUnitFlag(UNIT_FLAG_IN_COMBAT);
+
+    _script.OnUpdate(999);
+    EXPECT_EQ(_script.GetCounterValue(1), 0u);
+    EXPECT_EQ(_script.GetCounterValue(2), 0u);
+
+    _script.OnUpdate(2);
+    EXPECT_EQ(_script.GetCounterValue(1), 0u);
+    EXPECT_EQ(_script.GetCounterValue(2), 1u);
+
+    // evade, ic timer has 1000 ms left
+    _creature.RemoveUnitFlag(UNIT_FLAG_IN_COMBAT);
+
+    _script.OnUpdate(500);
+    EXPECT_EQ(_script.GetCounterValue(1), 0u);
+
+    _script.OnUpdate(1);
+    EXPECT_EQ(_script.GetCounterValue(1), 1u);
+    EXPECT_EQ(_script.GetCounterValue(2), 1u);
+
+    _creature.SetUnitFlag(UNIT_FLAG_IN_COMBAT);
+
+    _script.OnUpdate(1000);
+    EXPECT_EQ(_script.GetCounterValue(2), 1u);
+
+    _script.OnUpdate(1);
+    EXPECT_EQ(_script.GetCounterValue(1), 1u);
+    EXPECT_EQ(_script.GetCounterValue(2), 2u);
+
+    _creature.RemoveUnitFlag(UNIT_FLAG_IN_COMBAT);
+}
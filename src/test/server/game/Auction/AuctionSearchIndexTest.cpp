@@ -0,0 +1,270 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuctionHouseMgr.h"
+#include "AuctionSearchIndex.h"
+#include "ItemTemplate.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+    std::array<std::wstring, 6> const NameWords = { L"shiny", L"iron", L"sword", L"cloak", L"ring", L"bear" };
+    std::array<std::wstring, 4> const SuffixWords = { L"", L" of the monkey", L" of the bear", L" of stamina" };
+
+    std::wstring BuildName(uint32 itemId, int32 randomPropertyId)
+    {
+        return NameWords[itemId % NameWords.size()] + L" " + NameWords[(itemId / 7) % NameWords.size()] + L" " + std::to_wstring(itemId) +
+            SuffixWords[std::abs(randomPropertyId) % SuffixWords.size()];
+    }
+
+    AuctionListItems NoFilter()
+    {
+        AuctionListItems filter;
+        filter.InventoryType = 0xffffffff;
+        filter.ItemClass = 0xffffffff;
+        filter.ItemSubClass = 0xffffffff;
+        filter.Quality = 0xffffffff;
+        return filter;
+    }
+
+    class AuctionSearchIndexTest : public testing::Test
+    {
+    protected:
+        void Add(uint32 id, AuctionSearchItemInfo const& info)
+        {
+            auto& auction = _auctions[id];
+            auction = std::make_unique<AuctionEntry>();
+            auction->Id = id;
+            auction->ItemID = info.ItemId;
+
+            _infos[id] = info;
+            _index.Insert(auction.get(), info);
+        }
+
+        void Remove(uint32 id)
+        {
+            _index.Remove(_auctions[id].get());
+            _auctions.erase(id);
+            _infos.erase(id);
+        }
+
+        std::vector<uint32> Search(AuctionListItems const& filter, std::wstring const& name)
+        {
+            std::vector<AuctionEntry*> auctions;
+            _index.Search(filter, name, 0, BuildName, auctions);
+
+            std::vector<uint32> ids;
+            for (AuctionEntry const* auction : auctions)
+                ids.emplace_back(auction->Id);
+
+            std::sort(ids.begin(), ids.end());
+            return ids;
+        }
+
+        // Same checks as linear search of AuctionHouseObject::BuildListAuctionItems
+        std::vector<uint32> Scan(AuctionListItems const& filter, std::wstring const& name)
+        {
+            std::vector<uint32> ids;
+
+            for (auto const& [id, info] : _infos)
+            {
+                if (filter.ItemClass != 0xffffffff && info.ItemClass != filter.ItemClass)
+                    continue;
+
+                if (filter.ItemSubClass != 0xffffffff && info.ItemSubClass != filter.ItemSubClass)
+                    continue;
+
+                if (filter.InventoryType != 0xffffffff && info.InventoryType != filter.InventoryType &&
+                    (filter.InventoryType != INVTYPE_CHEST || info.InventoryType != INVTYPE_ROBE))
+                    continue;
+
+                if (filter.Quality != 0xffffffff && info.Quality < filter.Quality)
+                    continue;
+
+                if (filter.LevelMin != 0x00 && (info.RequiredLevel < filter.LevelMin || (filter.LevelMax != 0x00 && info.RequiredLevel > filter.LevelMax)))
+                    continue;
+
+                if (!name.empty() && BuildName(info.ItemId, info.RandomPropertyId).find(name) == std::wstring::npos)
+                    continue;
+
+                ids.emplace_back(id);
+            }
+
+            std::sort(ids.begin(), ids.end());
+            return ids;
+        }
+
+        using Searches = std::vector<std::pair<AuctionListItems, std::wstring>>;
+
+        // Random auctions, some of them expired and replaced, and random searches of these
+        Searches FillRandomAuctionHouse(uint32 auctionsCount)
+        {
+            uint32 seed = 12345;
+            auto next = [&seed](uint32 max)
+            {
+                seed = seed * 1103515245 + 12345;
+                return (seed >> 8) % max;
+            };
+
+            for (uint32 id = 1; id <= auctionsCount; ++id)
+            {
+                AuctionSearchItemInfo info;
+                info.ItemId = 1000 + next(5000);
+                info.RandomPropertyId = next(4) ? 0 : int32(next(4)) - 2;
+                info.ItemClass = uint8(next(MAX_ITEM_CLASS));
+                info.ItemSubClass = uint8(next(16));
+                info.InventoryType = uint8(next(MAX_INVTYPE));
+                info.Quality = uint8(next(MAX_ITEM_QUALITY));
+                info.RequiredLevel = uint8(next(81));
+                Add(id, info);
+            }
+
+            // expire some auctions, their slots are reused
+            for (uint32 id = 1; id <= auctionsCount; id += 10)
+                Remove(id);
+
+            for (uint32 id = auctionsCount + 1; id <= auctionsCount + auctionsCount / 10; ++id)
+                Add(id, { 1000 + next(5000), 0, uint8(next(MAX_ITEM_CLASS)), uint8(next(16)), uint8(next(MAX_INVTYPE)), uint8(next(MAX_ITEM_QUALITY)), uint8(next(81)) });
+
+            Searches searches;
+
+            for (uint32 i = 0; i < 100; ++i)
+            {
+                AuctionListItems filter = NoFilter();
+
+                switch (i % 5)
+                {
+                    case 0:
+                        filter.ItemClass = ITEM_CLASS_WEAPON;
+                        filter.ItemSubClass = next(16);
+                        break;
+                    case 1:
+                        filter.InventoryType = INVTYPE_CHEST;
+                        filter.Quality = ITEM_QUALITY_RARE;
+                        break;
+                    case 2:
+                        filter.LevelMin = uint8(next(70) + 1);
+                        filter.LevelMax = filter.LevelMin + 10;
+                        break;
+                    case 3:
+                        filter.ItemClass = ITEM_CLASS_ARMOR;
+                        filter.LevelMin = 70;
+                        break;
+                    default:
+                        break;
+                }
+
+                std::wstring name;
+                if (i % 3 == 0)
+                    name = std::to_wstring(1000 + next(5000));
+                else if (i % 3 == 1)
+                    name = NameWords[next(NameWords.size())];
+
+                if (filter.ItemClass == 0xffffffff && filter.InventoryType == 0xffffffff && filter.LevelMin == 0x00 && name.empty())
+                    name = L"monkey";
+
+                searches.emplace_back(filter, name);
+            }
+
+            return searches;
+        }
+
+        AuctionSearchIndex _index;
+        std::unordered_map<uint32, std::unique_ptr<AuctionEntry>> _auctions;
+        std::unordered_map<uint32, AuctionSearchItemInfo> _infos;
+    };
+}
+
+TEST_F(AuctionSearchIndexTest, FiltersMatchLinearSearch)
+{
+    Add(1, { 100, 0, ITEM_CLASS_ARMOR, 1, INVTYPE_CHEST, ITEM_QUALITY_UNCOMMON, 20 });
+    Add(2, { 101, 5, ITEM_CLASS_ARMOR, 1, INVTYPE_ROBE, ITEM_QUALITY_RARE, 30 });
+    Add(3, { 102, 0, ITEM_CLASS_WEAPON, 7, INVTYPE_WEAPON, ITEM_QUALITY_EPIC, 60 });
+    Add(4, { 100, 0, ITEM_CLASS_ARMOR, 1, INVTYPE_CHEST, ITEM_QUALITY_UNCOMMON, 20 });
+
+    AuctionListItems filter = NoFilter();
+    filter.InventoryType = INVTYPE_CHEST;
+    EXPECT_EQ(Search(filter, L""), std::vector<uint32>({ 1, 2, 4 }));
+
+    filter = NoFilter();
+    filter.Quality = ITEM_QUALITY_RARE;
+    EXPECT_EQ(Search(filter, L""), std::vector<uint32>({ 2, 3 }));
+
+    filter = NoFilter();
+    filter.LevelMin = 25;
+    EXPECT_EQ(Search(filter, L""), std::vector<uint32>({ 2, 3 }));
+    filter.LevelMax = 40;
+    EXPECT_EQ(Search(filter, L""), std::vector<uint32>({ 2 }));
+
+    // subclass is checked without class too
+    filter = NoFilter();
+    filter.ItemSubClass = 7;
+    EXPECT_EQ(Search(filter, L""), std::vector<uint32>({ 3 }));
+
+    filter = NoFilter();
+    filter.ItemClass = ITEM_CLASS_ARMOR;
+    EXPECT_EQ(Search(filter, L"100"), std::vector<uint32>({ 1, 4 }));
+    EXPECT_EQ(Search(filter, L"of the"), std::vector<uint32>({ 2 }));
+    EXPECT_EQ(Search(filter, L"10"), std::vector<uint32>({ 1, 2, 4 }));
+
+    // name stays indexed while an auction of it exists
+    Remove(1);
+    EXPECT_EQ(Search(NoFilter(), L"100"), std::vector<uint32>({ 4 }));
+    Remove(4);
+    EXPECT_TRUE(Search(NoFilter(), L"100").empty());
+
+    // names added after locale is built
+    Add(5, { 100, 0, ITEM_CLASS_ARMOR, 1, INVTYPE_CHEST, ITEM_QUALITY_UNCOMMON, 20 });
+    EXPECT_EQ(Search(NoFilter(), L"100"), std::vector<uint32>({ 5 }));
+}
+
+TEST_F(AuctionSearchIndexTest, RandomAuctionHouseMatchesLinearSearch)
+{
+    for (auto const& [filter, name] : FillRandomAuctionHouse(10000))
+        ASSERT_EQ(Search(filter, name), Scan(filter, name));
+}
+
+// Benchmark: 100k auctions, indexed search vs linear scan, prints time per search for both.
+// Disabled by default, run with --gtest_also_run_disabled_tests
+TEST_F(AuctionSearchIndexTest, DISABLED_Synthetic100kAuctionHouse)
+{
+    Searches searches = FillRandomAuctionHouse(100000);
+
+    std::chrono::nanoseconds indexTime{};
+    std::chrono::nanoseconds scanTime{};
+
+    for (auto const& [filter, name] : searches)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<uint32> indexed = Search(filter, name);
+        auto middle = std::chrono::steady_clock::now();
+        std::vector<uint32> scanned = Scan(filter, name);
+        auto end = std::chrono::steady_clock::now();
+
+        indexTime += middle - start;
+        scanTime += end - middle;
+
+        ASSERT_EQ(indexed, scanned);
+    }
+
+    std::cout << "[ BENCH    ] " << _index.GetSize() << " auctions, " << searches.size() << " searches: index "
+        << std::chrono::duration_cast<std::chrono::microseconds>(indexTime).count() / searches.size() << " us/search, linear "
+        << std::chrono::duration_cast<std::chrono::microseconds>(scanTime).count() / searches.size() << " us/search" << std::endl;
+}
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterCacheStore.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <unordered_map>
+
+TEST(CharacterCacheStoreTest, FindByGuidAndName)
+{
+    CharacterCacheStore store;
+
+    uint32 row = store.Add(10, "Arthas", 1, 0, 1, 6, 80);
+    store.Add(20, "Jaina", 2, 1, 1, 8, 70);
+
+    EXPECT_EQ(store.size(), 2u);
+    EXPECT_EQ(store.Find(10), row);
+    EXPECT_EQ(store.Find(30), CharacterCacheStore::NOT_FOUND);
+    EXPECT_EQ(store.FindByName("arthas"), row);
+    EXPECT_EQ(store.FindByName("ARTHAS"), row);
+    EXPECT_EQ(store.FindByName("Arthass"), CharacterCacheStore::NOT_FOUND);
+
+    CharacterCacheEntry entry = store.GetEntry(store.FindByName("Jaina"));
+    EXPECT_EQ(entry.Guid.GetCounter(), 20u);
+    EXPECT_EQ(entry.Name, "Jaina");
+    EXPECT_EQ(entry.AccountId, 2u);
+    EXPECT_EQ(entry.Sex, 1);
+    EXPECT_EQ(entry.Class, 8);
+    EXPECT_EQ(entry.Level, 70);
+    EXPECT_TRUE(entry.GroupGuid.IsEmpty());
+}
+
+TEST(CharacterCacheStoreTest, NonAsciiNameIgnoresCase)
+{
+    CharacterCacheStore store;
+
+    uint32 row = store.Add(1, "Артас", 1, 0, 1, 6, 80);
+
+    EXPECT_EQ(store.FindByName("артас"), row);
+    EXPECT_EQ(store.FindByName("АРТАС"), row);
+}
+
+TEST(CharacterCacheStoreTest, RenameAndRemove)
+{
+    CharacterCacheStore store;
+
+    store.Add(1, "First", 1, 0, 1, 1, 1);
+    store.Add(2, "Second", 1, 0, 1, 1, 1);
+    store.Add(3, "Third", 1, 0, 1, 1, 1);
+
+    store.Rename(store.Find(2), "Renamed");
+    EXPECT_EQ(store.FindByName("Second"), CharacterCacheStore::NOT_FOUND);
+    EXPECT_EQ(store.GetGuid(store.FindByName("renamed")), 2u);
+
+    // last row is moved to removed one
+    store.Remove(store.Find(1));
+    EXPECT_EQ(store.size(), 2u);
+    EXPECT_EQ(store.Find(1), CharacterCacheStore::NOT_FOUND);
+    EXPECT_EQ(store.FindByName("First"), CharacterCacheStore::NOT_FOUND);
+    EXPECT_EQ(store.GetName(store.Find(3)), "Third");
+    EXPECT_EQ(store.GetGuid(store.FindByName("Third")), 3u);
+}
+
+TEST(CharacterCacheStoreTest, MatchesUnorderedMap)
+{
+    CharacterCacheStore store;
+    std::unordered_map<ObjectGuid::LowType, std::string> expected;
+
+    uint32 seed = 12345;
+    for (uint32 i = 0; i < 100000; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        ObjectGuid::LowType guid = (seed >> 8) % 5000 + 1;
+        std::string name = "Name" + std::to_string(guid) + "x" + std::to_string((seed >> 4) % 7);
+
+        switch ((seed >> 2) % 4)
+        {
+            case 0:
+            case 1:
+            {
+                // names are unique in characters table, replaced character keeps only guid
+                uint32 row = store.Find(guid);
+                if (row != CharacterCacheStore::NOT_FOUND)
+                    store.Remove(row);
+
+                store.Add(guid, name, guid, 0, 1, 1, 1);
+                expected[guid] = name;
+                break;
+            }
+            case 2:
+            {
+                uint32 row = store.Find(guid);
+                if (row != CharacterCacheStore::NOT_FOUND)
+                    store.Remove(row);
+
+                expected.erase(guid);
+                break;
+            }
+            default:
+            {
+                uint32 row = store.Find(guid);
+                if (row != CharacterCacheStore::NOT_FOUND)
+                {
+                    store.Rename(row, name);
+                    expected[guid] = name;
+                }
+                break;
+            }
+        }
+    }
+
+    ASSERT_EQ(store.size(), expected.size());
+
+    for (auto const& [guid, name] : expected)
+    {
+        uint32 row = store.Find(guid);
+        ASSERT_NE(row, CharacterCacheStore::NOT_FOUND);
+        EXPECT_EQ(store.GetName(row), name);
+        EXPECT_EQ(store.GetAccountId(row), guid);
+        EXPECT_EQ(store.FindByName(name), row);
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Config.h"
+#include "GameConfig.h"
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+class GameConfigTest : public testing::Test {
+protected:
+    void SetUp() override {
+        auto tempFile = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("gameconfig-%%%%.conf");
+
+        // LoadAppConfigs requires .dist file, .conf is optional
+        confFilePath = tempFile.native();
+        std::ofstream iniStream(confFilePath + ".dist");
+
+        iniStream << "[worldserver]\n";
+        iniStream << "Test.Typed.Bool = 1\n";
+        iniStream << "Test.Typed.Int = -42\n";
+        iniStream << "Test.Typed.UInt = 4242\n";
+        iniStream << "Test.Typed.Float = 2.5\n";
+        iniStream.close();
+
+        sConfigMgr->Configure(confFilePath, std::vector<std::string>());
+        sConfigMgr->LoadAppConfigs();
+    }
+
+    void TearDown() override {
+        std::remove((confFilePath + ".dist").c_str());
+    }
+
+    std::string confFilePath;
+};
+
+TEST_F(GameConfigTest, TypedOptionsMatchStringLookup)
+{
+    EXPECT_EQ(CONF_GET_BOOL("Test.Typed.Bool"), sGameConfig->GetOption<bool>("Test.Typed.Bool"));
+    EXPECT_EQ(CONF_GET_INT("Test.Typed.Int"), -42);
+    EXPECT_EQ(CONF_GET_UINT("Test.Typed.UInt"), 4242u);
+    EXPECT_FLOAT_EQ(CONF_GET_FLOAT("Test.Typed.Float"), 2.5f);
+
+    // Not existing option use type default
+    EXPECT_EQ(CONF_GET_INT("Test.Typed.NotExist"), 0);
+    EXPECT_FLOAT_EQ(CONF_GET_FLOAT("Test.Typed.NotExistFloat"), 1.0f);
+}
+
+TEST_F(GameConfigTest, TypedOptionsFollowSetOption)
+{
+    EXPECT_EQ(CONF_GET_INT("Test.Typed.Int"), -42);
+
+    sGameConfig->SetOption<int32>("Test.Typed.Int", 100);
+    EXPECT_EQ(CONF_GET_INT("Test.Typed.Int"), 100);
+
+    sGameConfig->SetOption<int32>("Test.Typed.Int", -42);
+    EXPECT_EQ(CONF_GET_INT("Test.Typed.Int"), -42);
+}
+
+TEST_F(GameConfigTest, TypedOptionsKeepZeroValues)
+{
+    // SetOption changes only options known to GameConfig, don't depend on other tests using them first
+    sGameConfig->RegisterOption<bool>("Test.Typed.Bool");
+    sGameConfig->RegisterOption<float>("Test.Typed.Float");
+
+    // Zero values are published with parsed flag and don't fall back to string lookup
+    sGameConfig->SetOption<bool>("Test.Typed.Bool", false);
+    sGameConfig->SetOption<float>("Test.Typed.Float", 0.0f);
+    EXPECT_FALSE(CONF_GET_BOOL("Test.Typed.Bool"));
+    EXPECT_FLOAT_EQ(CONF_GET_FLOAT("Test.Typed.Float"), 0.0f);
+    EXPECT_EQ(CONF_GET_UINT("Test.Typed.Float"), sGameConfig->GetOption<uint32>("Test.Typed.Float"));
+
+    sGameConfig->SetOption<bool>("Test.Typed.Bool", true);
+    sGameConfig->SetOption<float>("Test.Typed.Float", 2.5f);
+    EXPECT_TRUE(CONF_GET_BOOL("Test.Typed.Bool"));
+    EXPECT_FLOAT_EQ(CONF_GET_FLOAT("Test.Typed.Float"), 2.5f);
+}
+
+// Microbenchmark: typed id lookup vs string lookup, prints time for both.
+// Disabled by default, run with --gtest_also_run_disabled_tests
+TEST_F(GameConfigTest, DISABLED_TypedOptionsBenchmark)
+{
+    constexpr uint32 iterations = 1000000;
+
+    auto Measure = [](auto&& func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    float stringSum = 0.0f;
+    float typedSum = 0.0f;
+
+    auto stringTime = Measure([&]()
+    {
+        for (uint32 i = 0; i < iterations; ++i)
+            stringSum += sGameConfig->GetOption<float>("Test.Typed.Float");
+    });
+
+    auto typedTime = Measure([&]()
+    {
+        for (uint32 i = 0; i < iterations; ++i)
+            typedSum += CONF_GET_FLOAT("Test.Typed.Float");
+    });
+
+    std::printf("[ BENCH    ] GetOption<float>(name): %lld us, CONF_GET_FLOAT: %lld us (%u iterations)\n",
+        static_cast<long long>(stringTime), static_cast<long long>(typedTime), iterations);
+
+    EXPECT_FLOAT_EQ(stringSum, typedSum);
+}
@@ -0,0 +1,202 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ClientGuidSet.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <iostream>
+#include <set>
+
+namespace
+{
+    std::set<ObjectGuid> ToSet(ClientGuidSet const& guids)
+    {
+        return { guids.begin(), guids.end() };
+    }
+
+    ObjectGuid MakeGuid(uint32 index)
+    {
+        switch (index % 3)
+        {
+            case 0:
+                return ObjectGuid::Create<HighGuid::Player>(index + 1);
+            case 1:
+                return ObjectGuid::Create<HighGuid::Unit>(1000 + index % 50, index);
+            default:
+                return ObjectGuid::Create<HighGuid::GameObject>(2000 + index % 50, index);
+        }
+    }
+}
+
+TEST(ClientGuidSetTest, MatchesUnorderedSet)
+{
+    ClientGuidSet guids;
+    GuidUnorderedSet expected;
+
+    uint32 seed = 12345;
+    for (uint32 i = 0; i < 100000; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        ObjectGuid guid = MakeGuid((seed >> 8) % 3000);
+
+        if ((seed >> 4) % 3)
+            EXPECT_EQ(guids.insert(guid), expected.insert(guid).second);
+        else
+            EXPECT_EQ(guids.erase(guid), expected.erase(guid) != 0);
+
+        ASSERT_EQ(guids.size(), expected.size());
+    }
+
+    EXPECT_EQ(ToSet(guids), std::set<ObjectGuid>(expected.begin(), expected.end()));
+
+    for (uint32 i = 0; i < 3000; ++i)
+        EXPECT_EQ(guids.contains(MakeGuid(i)), expected.contains(MakeGuid(i)));
+
+    EXPECT_FALSE(guids.insert(ObjectGuid::Empty));
+    EXPECT_FALSE(guids.contains(ObjectGuid::Empty));
+
+    guids.clear();
+    EXPECT_TRUE(guids.empty());
+    EXPECT_EQ(guids.begin(), guids.end());
+}
+
+TEST(ClientGuidSetTest, EraseIfVisitsEveryGuidOnce)
+{
+    ClientGuidSet guids;
+    for (uint32 i = 0; i < 1000; ++i)
+        guids.insert(MakeGuid(i));
+
+    std::set<ObjectGuid> visited;
+    guids.EraseIf([&visited](ObjectGuid guid)
+    {
+        EXPECT_TRUE(visited.insert(guid).second);
+        return !guid.IsPlayer();
+    });
+
+    EXPECT_EQ(visited.size(), 1000u);
+    EXPECT_EQ(guids.size(), 334u);
+
+    for (ObjectGuid const& guid : guids)
+        EXPECT_TRUE(guid.IsPlayer());
+}
+
+TEST(ClientGuidSetTest, NotMarkedGuidsLeftRange)
+{
+    ClientGuidSet guids;
+    for (uint32 i = 0; i < 10; ++i)
+        guids.insert(MakeGuid(i));
+
+    guids.BeginVisibilityPass();
+
+    for (uint32 i = 0; i < 5; ++i)
+        guids.MarkVisible(MakeGuid(i));
+
+    // added during pass, it's visible
+    guids.insert(MakeGuid(20));
+    guids.MarkVisible(MakeGuid(30));
+
+    EXPECT_TRUE(guids.IsMarkedVisible(MakeGuid(3)));
+    EXPECT_TRUE(guids.IsMarkedVisible(MakeGuid(20)));
+    EXPECT_FALSE(guids.IsMarkedVisible(MakeGuid(7)));
+    EXPECT_FALSE(guids.IsMarkedVisible(MakeGuid(30)));
+
+    std::set<ObjectGuid> outOfRange;
+    guids.EraseIfNotMarked([&outOfRange](ObjectGuid guid)
+    {
+        outOfRange.insert(guid);
+        return guid != MakeGuid(9); // kept, like visible static transport
+    });
+
+    EXPECT_EQ(outOfRange, std::set<ObjectGuid>({ MakeGuid(5), MakeGuid(6), MakeGuid(7), MakeGuid(8), MakeGuid(9) }));
+    EXPECT_EQ(ToSet(guids), std::set<ObjectGuid>({ MakeGuid(0), MakeGuid(1), MakeGuid(2), MakeGuid(3), MakeGuid(4), MakeGuid(9), MakeGuid(20) }));
+
+    // next pass doesn't see marks of previous one
+    guids.BeginVisibilityPass();
+    EXPECT_FALSE(guids.IsMarkedVisible(MakeGuid(0)));
+}
+
+// Benchmark: 500 players in one cell, every player sees all others and 300 creatures, 2% of objects leave range every pass.
+// Disabled by default, run with --gtest_also_run_disabled_tests
+TEST(ClientGuidSetTest, DISABLED_VisibilityPassBenchmark)
+{
+    constexpr uint32 playersCount = 500;
+    constexpr uint32 objectsCount = playersCount + 300;
+    constexpr uint32 passes = 20;
+
+    std::vector<ObjectGuid> objects;
+    for (uint32 i = 0; i < objectsCount; ++i)
+        objects.emplace_back(i < playersCount ? ObjectGuid::Create<HighGuid::Player>(i + 1) : ObjectGuid::Create<HighGuid::Unit>(1000, i));
+
+    std::vector<GuidUnorderedSet> oldSets(playersCount, GuidUnorderedSet(objects.begin(), objects.end()));
+    std::vector<ClientGuidSet> newSets(playersCount);
+    for (ClientGuidSet& guids : newSets)
+        for (ObjectGuid const& guid : objects)
+            guids.insert(guid);
+
+    auto inRange = [](uint32 pass, uint32 object) { return (object + pass) % 50 != 0; };
+
+    std::size_t oldLeft = 0;
+    auto oldStart = std::chrono::steady_clock::now();
+
+    for (uint32 pass = 0; pass < passes; ++pass)
+    {
+        for (GuidUnorderedSet& clientGuids : oldSets)
+        {
+            // old VisibleNotifier
+            GuidUnorderedSet visGuids(clientGuids);
+
+            for (uint32 i = 0; i < objectsCount; ++i)
+                if (inRange(pass, i))
+                    visGuids.erase(objects[i]);
+
+            for (ObjectGuid const& guid : visGuids)
+                if (guid.IsPlayer())
+                    ++oldLeft;
+        }
+    }
+
+    auto middle = std::chrono::steady_clock::now();
+    std::size_t newLeft = 0;
+
+    for (uint32 pass = 0; pass < passes; ++pass)
+    {
+        for (ClientGuidSet& clientGuids : newSets)
+        {
+            clientGuids.BeginVisibilityPass();
+
+            for (uint32 i = 0; i < objectsCount; ++i)
+                if (inRange(pass, i))
+                    clientGuids.MarkVisible(objects[i]);
+
+            clientGuids.EraseIfNotMarked([&newLeft](ObjectGuid guid)
+            {
+                if (guid.IsPlayer())
+                    ++newLeft;
+
+                return false;
+            });
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(oldLeft, newLeft);
+
+    std::cout << "[ BENCH    ] " << playersCount << " players, " << passes << " passes: copied set "
+        << std::chrono::duration_cast<std::chrono::microseconds>(middle - oldStart).count() << " us, generation marks "
+        << std::chrono::duration_cast<std::chrono::microseconds>(end - middle).count() << " us" << std::endl;
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Opcodes.h"
+#include "UpdateData.h"
+#include "WorldPacket.h"
+#include "gtest/gtest.h"
+#include <zlib.h>
+
+namespace
+{
+    ByteBuffer MakeBlock(uint32 size, bool compressible)
+    {
+        ByteBuffer block;
+        uint32 seed = 12345;
+
+        for (uint32 i = 0; i < size; ++i)
+        {
+            seed = seed * 1103515245 + 12345;
+            block << uint8(compressible ? i % 7 : seed >> 16);
+        }
+
+        return block;
+    }
+
+    std::vector<uint8> Uncompress(WorldPacket const& packet)
+    {
+        uLongf size = packet.read<uint32>(0);
+        std::vector<uint8> result(size);
+
+        EXPECT_EQ(uncompress(result.data(), &size, packet.contents() + sizeof(uint32), uLong(packet.size() - sizeof(uint32))), Z_OK);
+        EXPECT_EQ(size, result.size());
+        return result;
+    }
+}
+
+TEST(UpdateDataTest, LargePacketIsCompressed)
+{
+    // Several packets, persistent stream must be reset between them
+    for (uint32 i = 0; i < 3; ++i)
+    {
+        UpdateData data;
+        data.AddOutOfRangeGUID(ObjectGuid::Create<HighGuid::Player>(i + 1));
+        data.AddUpdateBlock(MakeBlock(2000, true));
+
+        WorldPacket packet;
+        ASSERT_TRUE(data.BuildPacket(&packet));
+        EXPECT_EQ(packet.GetOpcode(), SMSG_COMPRESSED_UPDATE_OBJECT);
+
+        std::vector<uint8> uncompressed = Uncompress(packet);
+        ASSERT_EQ(uncompressed.size(), 4 + 1 + 4 + ObjectGuid::Create<HighGuid::Player>(i + 1).WriteAsPacked().size() + 2000);
+        EXPECT_EQ(uncompressed[0], 2); // block count, 1 + out of range block
+        EXPECT_EQ(uncompressed.back(), 1999 % 7);
+    }
+}
+
+TEST(UpdateDataTest, SmallAndIncompressiblePacketsAreSentRaw)
+{
+    UpdateData small;
+    small.AddUpdateBlock(MakeBlock(50, true));
+
+    WorldPacket smallPacket;
+    ASSERT_TRUE(small.BuildPacket(&smallPacket));
+    EXPECT_EQ(smallPacket.GetOpcode(), SMSG_UPDATE_OBJECT);
+    EXPECT_EQ(smallPacket.size(), 4u + 50u);
+
+    UpdateData random;
+    random.AddUpdateBlock(MakeBlock(2000, false));
+
+    WorldPacket randomPacket;
+    ASSERT_TRUE(random.BuildPacket(&randomPacket));
+    EXPECT_EQ(randomPacket.GetOpcode(), SMSG_UPDATE_OBJECT);
+    EXPECT_EQ(randomPacket.size(), 4u + 2000u);
+}
@@ -0,0 +1,96 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "UpdateMask.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+namespace
+{
+    std::vector<uint32> ReadBlocks(ByteBuffer& data)
+    {
+        std::vector<uint32> blocks;
+        while (data.rpos() < data.wpos())
+            blocks.push_back(data.read<uint32>());
+
+        return blocks;
+    }
+}
+
+TEST(UpdateMaskTest, BlocksMatchFieldBits)
+{
+    UpdateMask mask;
+    mask.SetCount(100); // 4 blocks, last one partial
+
+    EXPECT_FALSE(mask.HasBitInBlock(0));
+    EXPECT_FALSE(mask.HasBitInBlock(3));
+
+    mask.SetBit(0);
+    mask.SetBit(31);
+    mask.SetBit(70);
+    mask.SetBit(99);
+
+    EXPECT_TRUE(mask.HasBitInBlock(0));
+    EXPECT_FALSE(mask.HasBitInBlock(1));
+    EXPECT_TRUE(mask.HasBitInBlock(2));
+    EXPECT_TRUE(mask.HasBitInBlock(3));
+
+    ByteBuffer data;
+    mask.AppendToPacket(&data);
+    EXPECT_EQ(ReadBlocks(data), std::vector<uint32>({ 0x80000001, 0, 1u << 6, 1u << 3 }));
+
+    mask.UnsetBit(70);
+    EXPECT_FALSE(mask.HasBitInBlock(2));
+
+    mask.Clear();
+    for (uint32 i = 0; i < mask.GetBlockCount(); ++i)
+        EXPECT_FALSE(mask.HasBitInBlock(i));
+}
+
+// Values update of player sized object, skipping empty blocks finds the same fields as checking every field
+TEST(UpdateMaskTest, BlockSkipFindsChangedFields)
+{
+    constexpr uint32 fields = 1326;
+
+    UpdateMask mask;
+    mask.SetCount(fields);
+    mask.SetBit(22);
+    mask.SetBit(400);
+    mask.SetBit(1100);
+    mask.SetBit(fields - 1);
+
+    std::vector<uint32> perField;
+    for (uint32 index = 0; index < fields; ++index)
+        if (mask.GetBit(index))
+            perField.push_back(index);
+
+    std::vector<uint32> perBlock;
+    for (uint32 index = 0; index < fields; ++index)
+    {
+        if (!(index % UpdateMask::CLIENT_UPDATE_MASK_BITS) && !mask.HasBitInBlock(index / UpdateMask::CLIENT_UPDATE_MASK_BITS))
+        {
+            index += UpdateMask::CLIENT_UPDATE_MASK_BITS - 1;
+            continue;
+        }
+
+        if (mask.GetBit(index))
+            perBlock.push_back(index);
+    }
+
+    EXPECT_EQ(perField, std::vector<uint32>({ 22, 400, 1100, fields - 1 }));
+    EXPECT_EQ(perBlock, perField);
+}
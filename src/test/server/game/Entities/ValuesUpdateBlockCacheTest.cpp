@@ -0,0 +1,98 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Player.h"
+#include "UpdateData.h"
+#include "UpdateFieldFlags.h"
+#include "UpdateMask.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <vector>
+
+namespace
+{
+    // Player out of world, only used as viewer of update fields
+    struct Viewer
+    {
+        Viewer(uint32 accountId, AccountTypes security) :
+            Session(std::make_unique<WorldSession>(accountId, "viewer", nullptr, security, 2, LOCALE_enUS, 0, false, false, 0)),
+            Character(std::make_unique<Player>(Session.get()))
+        {
+            Character->_Create(accountId, HighGuid::Player, PHASEMASK_NORMAL);
+        }
+
+        std::unique_ptr<WorldSession> Session;
+        std::unique_ptr<Player> Character;
+    };
+
+    std::vector<uint8> BuildPacket(UpdateDataMapType& updates, Player* viewer)
+    {
+        WorldPacket packet;
+        EXPECT_TRUE(updates[viewer].BuildPacket(&packet));
+        return std::vector<uint8>(packet.contents(), packet.contents() + packet.size());
+    }
+}
+
+// Viewers with the same visibility share one values block, fields depending on viewer are patched in a copy
+TEST(ValuesUpdateBlockCacheTest, ViewersShareBlockWithPatchedFields)
+{
+    Viewer player(1, SEC_PLAYER);
+    Viewer gameMaster(2, SEC_GAMEMASTER);
+    gameMaster.Character->SetGameMaster(true);
+
+    Viewer observed(3, SEC_PLAYER);
+    Unit* unit = observed.Character.get();
+    unit->SetUnitFlag(UNIT_FLAG_NOT_SELECTABLE | UNIT_FLAG_PACIFIED);
+
+    ValuesUpdateBlockCache cache;
+    UpdateDataMapType sharedUpdates;
+    unit->BuildFieldsUpdate(player.Character.get(), sharedUpdates, &cache);
+    unit->BuildFieldsUpdate(gameMaster.Character.get(), sharedUpdates, &cache);
+
+    // both are public viewers of the unit
+    ValuesUpdateBlockCache::Block* block = cache.Find(UF_FLAG_PUBLIC);
+    ASSERT_NE(block, nullptr);
+
+    bool flagsPatched = false;
+    for (auto const& [index, pos] : block->ViewerDependentFields)
+    {
+        if (index != UNIT_FIELD_FLAGS)
+            continue;
+
+        flagsPatched = true;
+        // block was built for the first viewer
+        EXPECT_EQ(block->Data.read<uint32>(pos), uint32(UNIT_FLAG_NOT_SELECTABLE | UNIT_FLAG_PACIFIED));
+    }
+
+    EXPECT_TRUE(flagsPatched);
+
+    // blocks built for each viewer alone
+    UpdateDataMapType updates;
+    unit->BuildFieldsUpdate(player.Character.get(), updates);
+    unit->BuildFieldsUpdate(gameMaster.Character.get(), updates);
+
+    std::vector<uint8> playerPacket = BuildPacket(sharedUpdates, player.Character.get());
+    std::vector<uint8> gameMasterPacket = BuildPacket(sharedUpdates, gameMaster.Character.get());
+
+    EXPECT_EQ(playerPacket, BuildPacket(updates, player.Character.get()));
+    EXPECT_EQ(gameMasterPacket, BuildPacket(updates, gameMaster.Character.get()));
+
+    // game master can select the unit
+    EXPECT_NE(playerPacket, gameMasterPacket);
+}
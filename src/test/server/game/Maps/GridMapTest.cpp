@@ -0,0 +1,96 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Map.h"
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <fstream>
+
+class GridMapTest : public testing::Test {
+protected:
+    void SetUp() override {
+        auto tempFile = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("gridmap-%%%%.map");
+        std::ofstream mapStream(tempFile.c_str(), std::ios::binary);
+
+        auto Write = [&](auto const& value) { mapStream.write(reinterpret_cast<char const*>(&value), sizeof(value)); };
+        auto Magic = [](char const* magic) { uint32 value; std::memcpy(&value, magic, sizeof(value)); return value; };
+
+        // Odd padding before height data, arrays are then not aligned in file
+        uint32 areaOffset = sizeof(map_fileheader);
+        uint32 heightOffset = areaOffset + sizeof(map_areaHeader) + 16 * 16 * sizeof(uint16) + 1;
+
+        map_fileheader header{};
+        header.mapMagic = Magic("MAPS");
+        header.versionMagic = 9;
+        header.areaMapOffset = areaOffset;
+        header.areaMapSize = sizeof(map_areaHeader) + 16 * 16 * sizeof(uint16);
+        header.heightMapOffset = heightOffset;
+        header.heightMapSize = sizeof(map_heightHeader) + (129 * 129 + 128 * 128) * sizeof(float);
+        Write(header);
+
+        map_areaHeader areaHeader{};
+        areaHeader.fourcc = Magic("AREA");
+        areaHeader.gridArea = 5;
+        Write(areaHeader);
+
+        for (uint32 i = 0; i < 16 * 16; ++i)
+            Write(uint16(7));
+
+        Write(uint8(0));
+
+        map_heightHeader heightHeader{};
+        heightHeader.fourcc = Magic("MHGT");
+        heightHeader.gridHeight = 10.0f;
+        Write(heightHeader);
+
+        for (uint32 i = 0; i < 129 * 129 + 128 * 128; ++i)
+            Write(25.0f);
+
+        mapStream.close();
+        mapFilePath = tempFile.native();
+    }
+
+    void TearDown() override {
+        std::remove(mapFilePath.c_str());
+    }
+
+    std::string mapFilePath;
+};
+
+TEST_F(GridMapTest, PrivateAndMemoryMappedLoadMatch)
+{
+    for (bool memoryMapped : { false, true })
+    {
+        GridMap gridMap;
+        ASSERT_TRUE(gridMap.LoadData(mapFilePath, memoryMapped));
+
+        EXPECT_EQ(gridMap.GetArea(10.0f, 10.0f), 7);
+        EXPECT_FLOAT_EQ(gridMap.GetHeight(10.0f, 10.0f), 25.0f);
+        EXPECT_FLOAT_EQ(gridMap.GetHeight(-300.0f, 150.0f), 25.0f);
+
+        gridMap.UnloadData();
+        EXPECT_FLOAT_EQ(gridMap.GetHeight(10.0f, 10.0f), INVALID_HEIGHT);
+    }
+}
+
+TEST_F(GridMapTest, MissingFileIsNotError)
+{
+    GridMap gridMap;
+    GridMap::Prefetch(mapFilePath + ".missing");
+    EXPECT_TRUE(gridMap.LoadData(mapFilePath + ".missing", true));
+}
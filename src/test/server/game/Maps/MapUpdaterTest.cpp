@@ -0,0 +1,205 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DBCStores.h"
+#include "Map.h"
+#include "MapUpdater.h"
+#include "Opcodes.h"
+#include "UpdateData.h"
+#include "WorldPacket.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <zlib.h>
+
+namespace
+{
+    // Map without grids or objects, the test decides what its update does
+    class TestMap : public Map
+    {
+    public:
+        explicit TestMap(uint32 id) : Map(AddMapEntry(id), 0, REGULAR_DIFFICULTY) { }
+
+        void Update(uint32 /*diff*/, uint32 /*s_diff*/, bool /*thread*/ = true) override
+        {
+            if (OnUpdate)
+                OnUpdate();
+        }
+
+        std::function<void()> OnUpdate;
+
+    private:
+        // DBC files are not loaded by unit tests
+        static uint32 AddMapEntry(uint32 id)
+        {
+            if (!sMapStore.LookupEntry(id))
+            {
+                MapEntry* entry = new MapEntry();
+                entry->MapID = id;
+                sMapStore.SetEntry(id, entry);
+            }
+
+            return id;
+        }
+    };
+
+    std::vector<uint8> Uncompress(WorldPacket const& packet)
+    {
+        uLongf size = packet.read<uint32>(0);
+        std::vector<uint8> result(size);
+
+        EXPECT_EQ(uncompress(result.data(), &size, packet.contents() + sizeof(uint32), uLong(packet.size() - sizeof(uint32))), Z_OK);
+        return result;
+    }
+}
+
+TEST(MapUpdaterTest, ExecuteParallelOutsideWorkersRunsInPlace)
+{
+    MapUpdater updater;
+    updater.InitThreads(2);
+
+    std::vector<std::thread::id> threads(5);
+    updater.ExecuteParallel(threads.size(), [&threads](uint32 index) { threads[index] = std::this_thread::get_id(); });
+
+    for (std::thread::id const& thread : threads)
+        EXPECT_EQ(thread, std::this_thread::get_id());
+
+    updater.Stop();
+}
+
+// Update packets built by tasks of a map update, like Map::SendObjectUpdatesInParallel
+TEST(MapUpdaterTest, MapUpdateBuildsPacketsInParallel)
+{
+    constexpr uint32 players = 40;
+    constexpr uint32 packetsPerTask = 4;
+
+    std::vector<UpdateData> updates(players);
+    for (uint32 i = 0; i < players; ++i)
+    {
+        for (uint32 j = 0; j < 20; ++j)
+        {
+            ByteBuffer block;
+            for (uint32 k = 0; k < 400 + i * 10 + j; ++k)
+                block << uint8(k % 7);
+
+            updates[i].AddUpdateBlock(block);
+        }
+    }
+
+    std::vector<WorldPacket> serialPackets(players);
+    for (uint32 i = 0; i < players; ++i)
+        updates[i].BuildPacket(&serialPackets[i]);
+
+    MapUpdater updater;
+    updater.InitThreads(3);
+
+    std::vector<WorldPacket> packets(players);
+    std::vector<std::atomic<uint32>> taskRuns(players / packetsPerTask);
+
+    TestMap map(1000);
+    map.OnUpdate = [&]()
+    {
+        updater.ExecuteParallel(taskRuns.size(), [&](uint32 index)
+        {
+            ++taskRuns[index];
+            for (uint32 i = index * packetsPerTask; i < (index + 1) * packetsPerTask; ++i)
+                updates[i].BuildPacket(&packets[i]);
+        });
+    };
+
+    updater.ScheduleUpdate(map, 0, 0);
+    updater.WaitThreads();
+    updater.Stop();
+
+    for (std::atomic<uint32> const& runs : taskRuns)
+        EXPECT_EQ(runs, 1u);
+
+    for (uint32 i = 0; i < players; ++i)
+    {
+        EXPECT_EQ(packets[i].GetOpcode(), SMSG_COMPRESSED_UPDATE_OBJECT);
+        EXPECT_EQ(Uncompress(packets[i]), Uncompress(serialPackets[i]));
+    }
+}
+
+// Worker waiting for its tasks must not pick up an unrelated map update, it would run nested in the waiting one
+TEST(MapUpdaterTest, WaitingWorkerRunsOnlyOwnTasks)
+{
+    MapUpdater updater;
+    updater.InitThreads(2);
+
+    TestMap waitingMap(1000);
+    TestMap otherMap(1001);
+
+    std::atomic<bool> waiting{ false };
+    std::thread::id waitingThread;
+    std::atomic<bool> nested{ false };
+
+    std::mutex lock;
+    std::condition_variable condition;
+    bool taskStolen = false;
+    bool otherUpdated = false;
+
+    otherMap.OnUpdate = [&]()
+    {
+        nested = waiting && std::this_thread::get_id() == waitingThread;
+
+        std::lock_guard<std::mutex> guard(lock);
+        otherUpdated = true;
+        condition.notify_all();
+    };
+
+    waitingMap.OnUpdate = [&]()
+    {
+        waitingThread = std::this_thread::get_id();
+        waiting = true;
+
+        updater.ExecuteParallel(2, [&](uint32 /*index*/)
+        {
+            std::unique_lock<std::mutex> guard(lock);
+
+            // Task taken first by the waiting worker lets the other worker steal the second one
+            if (std::this_thread::get_id() == waitingThread)
+            {
+                condition.wait_for(guard, std::chrono::seconds(5), [&taskStolen]() { return taskStolen; });
+                return;
+            }
+
+            taskStolen = true;
+            condition.notify_all();
+            guard.unlock();
+
+            // Queue other map while the waiting worker has nothing left but to wait, give it a chance to take it
+            updater.ScheduleUpdate(otherMap, 0, 0);
+
+            guard.lock();
+            condition.wait_for(guard, std::chrono::milliseconds(100), [&otherUpdated]() { return otherUpdated; });
+        });
+
+        waiting = false;
+    };
+
+    updater.ScheduleUpdate(waitingMap, 0, 0);
+    updater.WaitThreads();
+    updater.Stop();
+
+    EXPECT_TRUE(taskStolen);
+    EXPECT_TRUE(otherUpdated);
+    EXPECT_FALSE(nested);
+}
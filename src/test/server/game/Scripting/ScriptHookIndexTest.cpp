@@ -0,0 +1,274 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ScriptMgr.h"
+#include "ScriptObject.h"
+#include "ScriptRegistry.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+    constexpr std::string_view TestScriptContext = "ScriptHookIndexTest";
+
+    // Calls base class hook from its override, as modules often do
+    class LoginScript : public PlayerScript
+    {
+    public:
+        explicit LoginScript(uint32& logins) : PlayerScript("ScriptHookIndexTest_LoginScript"), _logins(logins) { }
+
+        void OnLogin(Player* player) override
+        {
+            ++_logins;
+            PlayerScript::OnLogin(player);
+        }
+
+    private:
+        uint32& _logins;
+    };
+
+    class ReputationScript : public PlayerScript
+    {
+    public:
+        explicit ReputationScript(uint32 lockedFaction) : PlayerScript("ScriptHookIndexTest_ReputationScript"), _lockedFaction(lockedFaction) { }
+
+        bool OnReputationChange(Player* /*player*/, uint32 factionID, int32& /*standing*/, bool /*incremental*/) override
+        {
+            return factionID != _lockedFaction;
+        }
+
+    private:
+        uint32 _lockedFaction;
+    };
+
+    // Overrides one of overloaded OnChat hooks
+    class ChatScript : public PlayerScript
+    {
+    public:
+        ChatScript() : PlayerScript("ScriptHookIndexTest_ChatScript") { }
+
+        using PlayerScript::OnChat;
+
+        void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/) override { }
+    };
+
+    class EmptyScript : public PlayerScript
+    {
+    public:
+        EmptyScript() : PlayerScript("ScriptHookIndexTest_EmptyScript") { }
+    };
+
+    // Module overriding a couple of hooks which are called rarely
+    class DummyModuleScript : public PlayerScript
+    {
+    public:
+        explicit DummyModuleScript(uint32 id) : PlayerScript("ScriptHookIndexTest_ModuleScript" + std::to_string(id)) { }
+
+        void OnCreate(Player* /*player*/) override { }
+        void OnDelete(ObjectGuid /*guid*/, uint32 /*accountId*/) override { }
+    };
+
+    class UpdateScript : public DummyModuleScript
+    {
+    public:
+        UpdateScript(uint32 id, uint32& updates) : DummyModuleScript(id), _updates(updates) { }
+
+        void OnUpdate(Player* /*player*/, uint32 /*diff*/) override { ++_updates; }
+
+    private:
+        uint32& _updates;
+    };
+
+    class ScriptHookIndexTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            sScriptMgr->SetScriptContext(TestScriptContext);
+        }
+
+        void TearDown() override
+        {
+            sScriptMgr->ReleaseScriptContext(TestScriptContext);
+            sScriptMgr->SwapScriptContext();
+        }
+
+        static ScriptHookIndex<PlayerScript>& GetHooks() { return ScriptRegistry<PlayerScript>::Instance()->GetHooks(); }
+        static void CompactHooks() { ScriptRegistry<PlayerScript>::Instance()->CompactHooks(); }
+    };
+}
+
+TEST_F(ScriptHookIndexTest, OverriddenHooksAreKnownAtRegistration)
+{
+    uint32 logins = 0;
+    LoginScript* loginScript = RegisterHookedScript<LoginScript>(logins);
+    ChatScript* chatScript = RegisterHookedScript<ChatScript>();
+
+    EXPECT_TRUE(loginScript->AreOverriddenHooksKnown());
+    EXPECT_FALSE(loginScript->IsHookUnused(PLAYERHOOK_ON_LOGIN));
+    EXPECT_TRUE(loginScript->IsHookUnused(PLAYERHOOK_ON_LOGOUT));
+    EXPECT_TRUE(loginScript->IsHookUnused(PLAYERHOOK_ON_CHAT));
+
+    // overloaded hooks are checked one by one
+    EXPECT_FALSE(chatScript->IsHookUnused(PLAYERHOOK_ON_CHAT));
+    EXPECT_TRUE(chatScript->IsHookUnused(PLAYERHOOK_ON_CHAT_RECEIVER));
+    EXPECT_TRUE(chatScript->IsHookUnused(PLAYERHOOK_ON_LOGIN));
+
+    EXPECT_FALSE(GetHooks().HasSubscribers(PLAYERHOOK_ON_LOGOUT));
+
+    CompactHooks();
+    EXPECT_EQ(GetHooks().GetSubscribers(PLAYERHOOK_ON_LOGIN).size(), 1u);
+    EXPECT_EQ(GetHooks().GetSubscribers(PLAYERHOOK_ON_CHAT).size(), 1u);
+}
+
+TEST_F(ScriptHookIndexTest, OverrideCallingBaseHookStaysSubscribed)
+{
+    uint32 logins = 0;
+    LoginScript* script = RegisterHookedScript<LoginScript>(logins);
+
+    for (uint32 i = 0; i < 3; ++i)
+        sScriptMgr->OnPlayerLogin(nullptr);
+
+    EXPECT_EQ(logins, 3u);
+    EXPECT_FALSE(script->IsHookUnused(PLAYERHOOK_ON_LOGIN));
+    EXPECT_TRUE(GetHooks().HasSubscribers(PLAYERHOOK_ON_LOGIN));
+}
+
+TEST_F(ScriptHookIndexTest, UnknownOverridesStaySubscribed)
+{
+    uint32 logins = 0;
+    auto* loginScript = new LoginScript(logins);
+    new EmptyScript();
+
+    EXPECT_FALSE(loginScript->AreOverriddenHooksKnown());
+    EXPECT_EQ(GetHooks().GetSubscribers(PLAYERHOOK_ON_LOGOUT).size(), 2u);
+
+    // default hook implementations don't unsubscribe scripts created with plain new
+    sScriptMgr->OnPlayerLogout(nullptr);
+    EXPECT_TRUE(GetHooks().HasSubscribers(PLAYERHOOK_ON_LOGOUT));
+
+    // neither does base class hook called from override
+    sScriptMgr->OnPlayerLogin(nullptr);
+    sScriptMgr->OnPlayerLogin(nullptr);
+    EXPECT_EQ(logins, 2u);
+    EXPECT_FALSE(loginScript->IsHookUnused(PLAYERHOOK_ON_LOGIN));
+
+    CompactHooks();
+    EXPECT_EQ(GetHooks().GetSubscribers(PLAYERHOOK_ON_LOGOUT).size(), 2u);
+    EXPECT_EQ(GetHooks().GetSubscribers(PLAYERHOOK_ON_LOGIN).size(), 2u);
+}
+
+TEST_F(ScriptHookIndexTest, BoolHooksAskOverridingScripts)
+{
+    constexpr uint32 lockedFaction = 17;
+
+    RegisterHookedScript<ReputationScript>(lockedFaction);
+    new EmptyScript();
+
+    int32 standing = 100;
+    for (uint32 i = 0; i < 2; ++i)
+    {
+        EXPECT_FALSE(sScriptMgr->OnPlayerReputationChange(nullptr, lockedFaction, standing, false));
+        EXPECT_TRUE(sScriptMgr->OnPlayerReputationChange(nullptr, lockedFaction + 1, standing, false));
+    }
+
+    // script created with plain new stays subscribed
+    CompactHooks();
+    EXPECT_EQ(GetHooks().GetSubscribers(PLAYERHOOK_ON_REPUTATION_CHANGE).size(), 2u);
+}
+
+TEST_F(ScriptHookIndexTest, ReleasedContextLeavesIndex)
+{
+    uint32 logins = 0;
+    RegisterHookedScript<LoginScript>(logins);
+
+    sScriptMgr->ReleaseScriptContext(TestScriptContext);
+    EXPECT_FALSE(GetHooks().HasSubscribers(PLAYERHOOK_ON_LOGIN));
+
+    sScriptMgr->OnPlayerLogin(nullptr);
+    EXPECT_EQ(logins, 0u);
+}
+
+// Benchmark: 30 module scripts, only 2 of them override OnUpdate and none the other hooks,
+// every player update calls all three hooks. Disabled by default, run with --gtest_also_run_disabled_tests
+TEST_F(ScriptHookIndexTest, DISABLED_PlayerHookDispatchBenchmark)
+{
+    constexpr uint32 scriptsCount = 30;
+    constexpr uint32 calls = 500000;
+
+    uint32 updates = 0;
+
+    std::vector<PlayerScript*> scripts;
+    for (uint32 i = 0; i < scriptsCount; ++i)
+    {
+        if (i % 15 == 7)
+            scripts.emplace_back(RegisterHookedScript<UpdateScript>(i, updates));
+        else
+            scripts.emplace_back(RegisterHookedScript<DummyModuleScript>(i));
+    }
+
+    CompactHooks();
+
+    // old dispatch, std::function called for every script
+    auto executeAll = [&scripts](std::function<void(PlayerScript*)> executeHook)
+    {
+        for (PlayerScript* script : scripts)
+            executeHook(script);
+    };
+
+    uint32 oldAllowed = 0;
+    InventoryResult result{};
+    auto oldStart = std::chrono::steady_clock::now();
+
+    for (uint32 i = 0; i < calls; ++i)
+    {
+        executeAll([](PlayerScript* script) { script->OnUpdate(nullptr, 100); });
+        executeAll([](PlayerScript* script) { script->OnLogin(nullptr); });
+
+        bool allowed = true;
+        executeAll([&](PlayerScript* script) { allowed = script->CanUseItem(nullptr, nullptr, result) && allowed; });
+        oldAllowed += allowed;
+    }
+
+    auto middle = std::chrono::steady_clock::now();
+    uint32 oldUpdates = std::exchange(updates, 0);
+
+    uint32 newAllowed = 0;
+
+    for (uint32 i = 0; i < calls; ++i)
+    {
+        sScriptMgr->OnPlayerUpdate(nullptr, 100);
+        sScriptMgr->OnPlayerLogin(nullptr);
+        newAllowed += sScriptMgr->CanUseItem(nullptr, nullptr, result);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(oldUpdates, updates);
+    EXPECT_EQ(oldAllowed, newAllowed);
+    EXPECT_EQ(GetHooks().GetSubscribers(PLAYERHOOK_ON_UPDATE).size(), 2u);
+    EXPECT_FALSE(GetHooks().HasSubscribers(PLAYERHOOK_CAN_USE_ITEM));
+
+    std::cout << "[ BENCH    ] " << scriptsCount << " scripts, " << calls << " x 3 hooks: all scripts "
+        << std::chrono::duration_cast<std::chrono::microseconds>(middle - oldStart).count() << " us, hook index "
+        << std::chrono::duration_cast<std::chrono::microseconds>(end - middle).count() << " us" << std::endl;
+}
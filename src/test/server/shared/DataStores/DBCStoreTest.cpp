@@ -0,0 +1,154 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DBCFileLoader.h"
+#include "DBCStore.h"
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    #pragma pack(push, 1)
+    struct TestNumberEntry
+    {
+        uint32 ID;
+        uint32 Value;
+        float Scale;
+        uint8 Flags;
+    };
+
+    struct TestStringEntry
+    {
+        uint32 ID;
+        char const* Name;
+        uint32 Value;
+    };
+    #pragma pack(pop)
+
+    char constexpr TestNumberEntryfmt[] = "nifb";
+    char constexpr TestStringEntryfmt[] = "nsxi";
+
+    // Writes WDBC file, records are given as raw bytes
+    std::string WriteDBC(uint32 fieldCount, uint32 recordSize, std::vector<std::vector<uint8>> const& records, std::string const& strings)
+    {
+        auto tempFile = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("dbcstore-%%%%.dbc");
+        std::ofstream dbcStream(tempFile.c_str(), std::ios::binary);
+
+        auto Write = [&](uint32 value) { dbcStream.write(reinterpret_cast<char const*>(&value), sizeof(value)); };
+
+        Write(0x43424457);                                  // 'WDBC'
+        Write(uint32(records.size()));
+        Write(fieldCount);
+        Write(recordSize);
+        Write(uint32(strings.size()));
+
+        for (auto const& record : records)
+            dbcStream.write(reinterpret_cast<char const*>(record.data()), record.size());
+
+        dbcStream.write(strings.data(), strings.size());
+        dbcStream.close();
+        return tempFile.native();
+    }
+
+    template<typename... Fields>
+    std::vector<uint8> Record(Fields... fields)
+    {
+        std::vector<uint8> record;
+        auto Append = [&](auto value)
+        {
+            uint8 const* bytes = reinterpret_cast<uint8 const*>(&value);
+            record.insert(record.end(), bytes, bytes + sizeof(value));
+        };
+
+        (Append(fields), ...);
+        return record;
+    }
+}
+
+TEST(DBCStoreTest, NumberRecordsUsedInPlaceWhenMapped)
+{
+    std::string path = WriteDBC(4, 13, { Record(uint32(3), uint32(30), 1.5f, uint8(1)), Record(uint32(7), uint32(70), 2.5f, uint8(2)) }, std::string(1, '\0'));
+
+    for (bool memoryMapped : { false, true })
+    {
+        DBCFileLoader dbc;
+        ASSERT_TRUE(dbc.Load(path.c_str(), TestNumberEntryfmt, memoryMapped));
+        EXPECT_EQ(dbc.CanUseRecordsInPlace(TestNumberEntryfmt), memoryMapped);
+
+        DBCStorage<TestNumberEntry> store(TestNumberEntryfmt);
+        ASSERT_TRUE(store.Load(path.c_str(), memoryMapped));
+
+        EXPECT_EQ(store.GetNumRows(), 8u);
+        EXPECT_EQ(store.LookupEntry(5), nullptr);
+        EXPECT_EQ(store.LookupEntry(100), nullptr);
+
+        TestNumberEntry const* entry = store.LookupEntry(7);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->Value, 70u);
+        EXPECT_FLOAT_EQ(entry->Scale, 2.5f);
+        EXPECT_EQ(entry->Flags, 2);
+
+        // Corrections of loaded records must not change the file
+        const_cast<TestNumberEntry*>(entry)->Value = 71;
+        EXPECT_EQ(store.LookupEntry(7)->Value, 71u);
+    }
+
+    DBCFileLoader dbc;
+    ASSERT_TRUE(dbc.Load(path.c_str(), TestNumberEntryfmt));
+    EXPECT_EQ(dbc.getRecord(1).getUInt(1), 70u);
+
+    std::remove(path.c_str());
+}
+
+TEST(DBCStoreTest, StringRecordsAreCopiedWhenMapped)
+{
+    std::string strings("\0First\0Second\0", 14);
+    std::string path = WriteDBC(4, 16, { Record(uint32(1), uint32(1), uint32(0), uint32(10)), Record(uint32(2), uint32(7), uint32(0), uint32(20)) }, strings);
+
+    for (bool memoryMapped : { false, true })
+    {
+        DBCFileLoader dbc;
+        ASSERT_TRUE(dbc.Load(path.c_str(), TestStringEntryfmt, memoryMapped));
+        EXPECT_FALSE(dbc.CanUseRecordsInPlace(TestStringEntryfmt));
+
+        DBCStorage<TestStringEntry> store(TestStringEntryfmt);
+        ASSERT_TRUE(store.Load(path.c_str(), memoryMapped));
+
+        ASSERT_NE(store.LookupEntry(1), nullptr);
+        ASSERT_NE(store.LookupEntry(2), nullptr);
+        EXPECT_STREQ(store.LookupEntry(1)->Name, "First");
+        EXPECT_STREQ(store.LookupEntry(2)->Name, "Second");
+        EXPECT_EQ(store.LookupEntry(2)->Value, 20u);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(DBCStoreTest, TruncatedFileIsNotMapped)
+{
+    std::string path = WriteDBC(4, 13, { Record(uint32(3), uint32(30), 1.5f, uint8(1)) }, std::string(1, '\0'));
+    boost::filesystem::resize_file(path, 20 + 5);
+
+    DBCFileLoader dbc;
+    EXPECT_FALSE(dbc.Load(path.c_str(), TestNumberEntryfmt, true));
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,390 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+* @file main.cpp
+* @brief Authserver load generator
+*
+* Logs in with one account from many connections at once (challenge, proof and realm list)
+* and prints latency of whole logons, used to measure authserver under login storms.
+*/
+
+#include "BigNumber.h"
+#include "ByteConverter.h"
+#include "CryptoHash.h"
+#include "CryptoRandom.h"
+#include "SRP6.h"
+#include "Util.h"
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace boost::program_options;
+using boost::asio::ip::tcp;
+using SHA1 = Warhead::Crypto::SHA1;
+using SRP6 = Warhead::Crypto::SRP6;
+
+namespace
+{
+    struct LoadTestConfig
+    {
+        std::string Host;
+        std::string Port;
+        std::string Account;
+        std::string Password;
+        uint16 Build = 12340;
+        uint32 Logins = 1000;
+        uint32 Concurrency = 50;
+    };
+
+    enum class LogonResult
+    {
+        Success,
+        ChallengeFailed,
+        ProofFailed,
+        RealmListFailed
+    };
+
+    void Append(std::vector<uint8>& buffer, void const* data, size_t size)
+    {
+        uint8 const* bytes = reinterpret_cast<uint8 const*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    template<typename T>
+    void AppendValue(std::vector<uint8>& buffer, T value)
+    {
+        EndianConvert(value);
+        Append(buffer, &value, sizeof(value));
+    }
+
+    std::vector<uint8> BuildLogonChallenge(LoadTestConfig const& config)
+    {
+        std::vector<uint8> packet;
+        AppendValue<uint8>(packet, 0x00);                               // AUTH_LOGON_CHALLENGE
+        AppendValue<uint8>(packet, 0x08);                               // error
+        AppendValue<uint16>(packet, uint16(30 + config.Account.size()));
+        Append(packet, "WoW", 4);                                       // game name
+        AppendValue<uint8>(packet, 3);                                  // version
+        AppendValue<uint8>(packet, 3);
+        AppendValue<uint8>(packet, 5);
+        AppendValue<uint16>(packet, config.Build);
+        Append(packet, "68x", 4);                                       // platform, reversed
+        Append(packet, "niW", 4);                                       // os, reversed
+        Append(packet, "SUne", 4);                                      // country, reversed
+        AppendValue<uint32>(packet, 0);                                 // timezone bias
+        AppendValue<uint32>(packet, 0x0100007F);                        // ip
+        AppendValue<uint8>(packet, uint8(config.Account.size()));
+        Append(packet, config.Account.data(), config.Account.size());
+        return packet;
+    }
+
+    // Client part of SRP6, server part is Warhead::Crypto::SRP6
+    class ClientSRP6
+    {
+    public:
+        ClientSRP6(std::string const& username, std::string const& password) :
+            _I(SHA1::GetDigestOf(username)), _P(SHA1::GetDigestOf(username, ":", password)) { }
+
+        bool CalculateProof(SRP6::EphemeralKey const& B, SRP6::Salt const& salt)
+        {
+            BigNumber const N(SRP6::N);
+            BigNumber const g(SRP6::g);
+            BigNumber const bigB(B);
+
+            if ((bigB % N).IsZero())
+                return false;
+
+            BigNumber const a(Warhead::Crypto::GetRandomBytes<19>());
+            A = g.ModExp(a, N).ToByteArray<SRP6::EPHEMERAL_KEY_LENGTH>();
+
+            BigNumber const x(SHA1::GetDigestOf(salt, _P));
+            BigNumber const u(SHA1::GetDigestOf(A, B));
+
+            // S = (B - 3 * g^x) ^ (a + u * x), 3 * N keeps base positive
+            BigNumber const base = (bigB + N * 3u - g.ModExp(x, N) * 3u) % N;
+            SRP6::EphemeralKey const S = base.ModExp(a + u * x, N).ToByteArray<SRP6::EPHEMERAL_KEY_LENGTH>();
+
+            K = Interleave(S);
+
+            SHA1::Digest const NHash = SHA1::GetDigestOf(SRP6::N);
+            SHA1::Digest const gHash = SHA1::GetDigestOf(SRP6::g);
+            SHA1::Digest NgHash;
+            std::transform(NHash.begin(), NHash.end(), gHash.begin(), NgHash.begin(), std::bit_xor<>());
+
+            M = SHA1::GetDigestOf(NgHash, _I, salt, A, B, K);
+            return true;
+        }
+
+        SRP6::EphemeralKey A{};
+        SHA1::Digest M{};
+        SessionKey K{};
+
+    private:
+        // Same as SRP6::SHA1Interleave
+        static SessionKey Interleave(SRP6::EphemeralKey const& S)
+        {
+            std::array<uint8, SRP6::EPHEMERAL_KEY_LENGTH / 2> buf0{}, buf1{};
+            for (size_t i = 0; i < SRP6::EPHEMERAL_KEY_LENGTH / 2; ++i)
+            {
+                buf0[i] = S[2 * i + 0];
+                buf1[i] = S[2 * i + 1];
+            }
+
+            size_t p = 0;
+            while (p < SRP6::EPHEMERAL_KEY_LENGTH && !S[p])
+                ++p;
+
+            if (p & 1)
+                ++p;
+
+            p /= 2;
+
+            SHA1::Digest const hash0 = SHA1::GetDigestOf(buf0.data() + p, SRP6::EPHEMERAL_KEY_LENGTH / 2 - p);
+            SHA1::Digest const hash1 = SHA1::GetDigestOf(buf1.data() + p, SRP6::EPHEMERAL_KEY_LENGTH / 2 - p);
+
+            SessionKey K;
+            for (size_t i = 0; i < SHA1::DIGEST_LENGTH; ++i)
+            {
+                K[2 * i + 0] = hash0[i];
+                K[2 * i + 1] = hash1[i];
+            }
+
+            return K;
+        }
+
+        SHA1::Digest const _I;
+        SHA1::Digest const _P;
+    };
+
+    LogonResult DoLogon(LoadTestConfig const& config, tcp::resolver::results_type const& endpoints)
+    {
+        boost::asio::io_context ioContext;
+        tcp::socket socket(ioContext);
+        boost::asio::connect(socket, endpoints);
+
+        // Challenge
+        boost::asio::write(socket, boost::asio::buffer(BuildLogonChallenge(config)));
+
+        std::array<uint8, 3> challengeHeader{};
+        boost::asio::read(socket, boost::asio::buffer(challengeHeader));
+        if (challengeHeader[2] != 0)
+            return LogonResult::ChallengeFailed;
+
+        // B, g length, g, N length, N, s, version challenge, security flags
+        std::array<uint8, 32 + 1 + 1 + 1 + 32 + 32 + 16 + 1> challenge{};
+        boost::asio::read(socket, boost::asio::buffer(challenge));
+
+        SRP6::EphemeralKey B{};
+        SRP6::Salt salt{};
+        std::memcpy(B.data(), challenge.data(), B.size());
+        std::memcpy(salt.data(), challenge.data() + 32 + 1 + 1 + 1 + 32, salt.size());
+
+        // Accounts with security token are not supported
+        if (challenge.back() != 0)
+            return LogonResult::ChallengeFailed;
+
+        ClientSRP6 srp(config.Account, config.Password);
+        if (!srp.CalculateProof(B, salt))
+            return LogonResult::ChallengeFailed;
+
+        // Proof
+        std::vector<uint8> proof;
+        AppendValue<uint8>(proof, 0x01);                                // AUTH_LOGON_PROOF
+        Append(proof, srp.A.data(), srp.A.size());
+        Append(proof, srp.M.data(), srp.M.size());
+        Append(proof, std::array<uint8, SHA1::DIGEST_LENGTH>{}.data(), SHA1::DIGEST_LENGTH);  // crc hash
+        AppendValue<uint8>(proof, 0);                                   // number of keys
+        AppendValue<uint8>(proof, 0);                                   // security flags
+        boost::asio::write(socket, boost::asio::buffer(proof));
+
+        std::array<uint8, 2> proofHeader{};
+        boost::asio::read(socket, boost::asio::buffer(proofHeader));
+        if (proofHeader[1] != 0)
+            return LogonResult::ProofFailed;
+
+        // M2, account flags, survey id, login flags
+        std::array<uint8, 20 + 4 + 4 + 2> proofResponse{};
+        boost::asio::read(socket, boost::asio::buffer(proofResponse));
+
+        SHA1::Digest const M2 = SRP6::GetSessionVerifier(srp.A, srp.M, srp.K);
+        if (!std::equal(M2.begin(), M2.end(), proofResponse.begin()))
+            return LogonResult::ProofFailed;
+
+        // Realm list
+        std::vector<uint8> realmListRequest;
+        AppendValue<uint8>(realmListRequest, 0x10);                     // REALM_LIST
+        AppendValue<uint32>(realmListRequest, 0);
+        boost::asio::write(socket, boost::asio::buffer(realmListRequest));
+
+        std::array<uint8, 3> realmListHeader{};
+        boost::asio::read(socket, boost::asio::buffer(realmListHeader));
+        if (realmListHeader[0] != 0x10)
+            return LogonResult::RealmListFailed;
+
+        std::vector<uint8> realmList(realmListHeader[1] | (realmListHeader[2] << 8));
+        boost::asio::read(socket, boost::asio::buffer(realmList));
+        return LogonResult::Success;
+    }
+
+    variables_map GetConsoleArguments(int argc, char** argv, LoadTestConfig& config)
+    {
+        options_description all("Allowed options");
+        all.add_options()
+            ("help,h", "print usage message")
+            ("host", value<std::string>(&config.Host)->default_value("127.0.0.1"), "authserver address")
+            ("port", value<std::string>(&config.Port)->default_value("3724"), "authserver port")
+            ("account,a", value<std::string>(&config.Account)->required(), "account name")
+            ("password,p", value<std::string>(&config.Password)->required(), "account password")
+            ("build", value<uint16>(&config.Build)->default_value(12340), "client build")
+            ("logins,n", value<uint32>(&config.Logins)->default_value(1000), "number of logons")
+            ("concurrency,c", value<uint32>(&config.Concurrency)->default_value(50), "number of logons at once");
+
+        variables_map vm;
+
+        try
+        {
+            store(command_line_parser(argc, argv).options(all).run(), vm);
+
+            if (vm.count("help"))
+            {
+                std::cout << all << "\n";
+                return vm;
+            }
+
+            notify(vm);
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << e.what() << "\n";
+            std::cout << all << "\n";
+            vm.insert({ "help", {} });
+        }
+
+        return vm;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    LoadTestConfig config;
+    auto vm = GetConsoleArguments(argc, argv, config);
+
+    // exit if help is enabled or arguments are invalid
+    if (vm.count("help"))
+        return 0;
+
+    if (!Utf8ToUpperOnlyLatin(config.Account) || !Utf8ToUpperOnlyLatin(config.Password))
+    {
+        std::cerr << "Account name or password is not valid utf8\n";
+        return 1;
+    }
+
+    boost::asio::io_context ioContext;
+    tcp::resolver resolver(ioContext);
+    tcp::resolver::results_type endpoints;
+
+    try
+    {
+        endpoints = resolver.resolve(config.Host, config.Port);
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Could not resolve " << config.Host << ": " << e.what() << "\n";
+        return 1;
+    }
+
+    std::atomic<uint32> nextLogon{};
+    std::array<std::atomic<uint32>, 4> results{};
+    std::atomic<uint32> networkErrors{};
+
+    std::mutex latenciesLock;
+    std::vector<double> latencies;
+    latencies.reserve(config.Logins);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (uint32 i = 0; i < std::max<uint32>(config.Concurrency, 1); ++i)
+    {
+        threads.emplace_back([&]()
+        {
+            while (nextLogon.fetch_add(1) < config.Logins)
+            {
+                auto logonStart = std::chrono::steady_clock::now();
+
+                try
+                {
+                    LogonResult result = DoLogon(config, endpoints);
+                    ++results[std::size_t(result)];
+
+                    if (result != LogonResult::Success)
+                        continue;
+                }
+                catch (std::exception const&)
+                {
+                    ++networkErrors;
+                    continue;
+                }
+
+                double latency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - logonStart).count();
+
+                std::lock_guard<std::mutex> guard(latenciesLock);
+                latencies.push_back(latency);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Logons:           " << config.Logins << " (" << config.Concurrency << " at once) in " << elapsed << " s\n";
+    std::cout << "Succeeded:        " << results[std::size_t(LogonResult::Success)] << "\n";
+    std::cout << "Challenge failed: " << results[std::size_t(LogonResult::ChallengeFailed)] << "\n";
+    std::cout << "Proof failed:     " << results[std::size_t(LogonResult::ProofFailed)] << "\n";
+    std::cout << "Realm list fail:  " << results[std::size_t(LogonResult::RealmListFailed)] << "\n";
+    std::cout << "Network errors:   " << networkErrors << "\n";
+
+    if (latencies.empty())
+        return 1;
+
+    std::sort(latencies.begin(), latencies.end());
+
+    auto percentile = [&latencies](double p)
+    {
+        return latencies[std::min<std::size_t>(latencies.size() - 1, std::size_t(p * latencies.size()))];
+    };
+
+    std::cout << "Logons/s:         " << latencies.size() / elapsed << "\n";
+    std::cout << "Latency p50:      " << percentile(0.50) << " ms\n";
+    std::cout << "Latency p99:      " << percentile(0.99) << " ms\n";
+    std::cout << "Latency max:      " << latencies.back() << " ms\n";
+    return 0;
+}